@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunaySpatialSorting.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that spatially sorted point insertion produces the same Delaunay
+// triangulation as insertion in input order.
+
+#include <vtkCellArray.h>
+#include <vtkDelaunay2D.h>
+#include <vtkDelaunay3D.h>
+#include <vtkIdList.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace
+{
+typedef std::set<std::vector<vtkIdType> > CellSet;
+
+vtkSmartPointer<vtkPolyData> RandomPoints(vtkIdType numPts, bool planar)
+{
+  vtkSmartPointer<vtkMinimalStandardRandomSequence> randomSequence
+    = vtkSmartPointer<vtkMinimalStandardRandomSequence>::New();
+  randomSequence->SetSeed(1);
+
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      randomSequence->Next();
+      x[j] = randomSequence->GetValue();
+    }
+    if (planar)
+    {
+      x[2] = 0.0;
+    }
+    points->InsertNextPoint(x);
+  }
+
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  return polyData;
+}
+
+void InsertCell(CellSet& cells, vtkIdType npts, const vtkIdType *pts)
+{
+  std::vector<vtkIdType> cell(pts, pts + npts);
+  std::sort(cell.begin(), cell.end());
+  cells.insert(cell);
+}
+
+CellSet Triangulate2D(vtkPolyData *input, bool spatialSorting)
+{
+  vtkSmartPointer<vtkDelaunay2D> delaunay
+    = vtkSmartPointer<vtkDelaunay2D>::New();
+  delaunay->SetInputData(input);
+  delaunay->SetSpatialSorting(spatialSorting);
+  delaunay->Update();
+
+  CellSet cells;
+  vtkCellArray *polys = delaunay->GetOutput()->GetPolys();
+  vtkIdType npts, *pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); )
+  {
+    InsertCell(cells, npts, pts);
+  }
+  return cells;
+}
+
+CellSet Triangulate3D(vtkPolyData *input, bool spatialSorting)
+{
+  vtkSmartPointer<vtkDelaunay3D> delaunay
+    = vtkSmartPointer<vtkDelaunay3D>::New();
+  delaunay->SetInputData(input);
+  delaunay->SetSpatialSorting(spatialSorting);
+  delaunay->Update();
+
+  CellSet cells;
+  vtkUnstructuredGrid *output = delaunay->GetOutput();
+  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, ptIds);
+    InsertCell(cells, ptIds->GetNumberOfIds(), ptIds->GetPointer(0));
+  }
+  return cells;
+}
+}
+
+int TestDelaunaySpatialSorting(int vtkNotUsed(argc), char *vtkNotUsed(argv)[])
+{
+  vtkSmartPointer<vtkPolyData> planar = RandomPoints(5000, true);
+  CellSet inputOrder = Triangulate2D(planar, false);
+  CellSet sorted = Triangulate2D(planar, true);
+  if (inputOrder.empty() || inputOrder != sorted)
+  {
+    std::cerr << "vtkDelaunay2D: " << inputOrder.size() << " triangles in input order, "
+              << sorted.size() << " with spatial sorting" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkPolyData> cloud = RandomPoints(2000, false);
+  inputOrder = Triangulate3D(cloud, false);
+  sorted = Triangulate3D(cloud, true);
+  if (inputOrder.empty() || inputOrder != sorted)
+  {
+    std::cerr << "vtkDelaunay3D: " << inputOrder.size() << " tetras in input order, "
+              << sorted.size() << " with spatial sorting" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
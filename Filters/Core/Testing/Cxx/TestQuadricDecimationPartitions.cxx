@@ -0,0 +1,88 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricDecimationPartitions.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the partitioned (parallel) mode of vtkQuadricDecimation
+// produces a watertight mesh with about the requested number of triangles.
+
+#include <vtkFeatureEdges.h>
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkQuadricDecimation.h>
+#include <vtkSphereSource.h>
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+bool CheckDecimation(vtkPolyData *input, int numberOfPartitions)
+{
+  const double targetReduction = 0.9;
+
+  vtkNew<vtkQuadricDecimation> decimate;
+  decimate->SetInputData(input);
+  decimate->SetTargetReduction(targetReduction);
+  decimate->SetNumberOfPartitions(numberOfPartitions);
+  decimate->Update();
+
+  vtkPolyData *output = decimate->GetOutput();
+  vtkIdType numInputTris = input->GetNumberOfPolys();
+  vtkIdType numOutputTris = output->GetNumberOfPolys();
+  std::cout << numberOfPartitions << " partition(s): " << numInputTris
+            << " -> " << numOutputTris << " triangles, actual reduction "
+            << decimate->GetActualReduction() << std::endl;
+
+  double reduction = 1.0 - static_cast<double>(numOutputTris) / numInputTris;
+  if (std::abs(reduction - targetReduction) > 0.02)
+  {
+    std::cerr << "Expected a reduction of about " << targetReduction
+              << " but got " << reduction << std::endl;
+    return false;
+  }
+  if (std::abs(reduction - decimate->GetActualReduction()) > 1e-3)
+  {
+    std::cerr << "ActualReduction does not match the output" << std::endl;
+    return false;
+  }
+
+  // The input is closed; the partition seams must not open it up.
+  vtkNew<vtkFeatureEdges> edges;
+  edges->SetInputData(output);
+  edges->BoundaryEdgesOn();
+  edges->NonManifoldEdgesOn();
+  edges->FeatureEdgesOff();
+  edges->ManifoldEdgesOff();
+  edges->Update();
+  if (edges->GetOutput()->GetNumberOfLines() != 0)
+  {
+    std::cerr << "Decimated mesh has " << edges->GetOutput()->GetNumberOfLines()
+              << " boundary or non-manifold edges" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestQuadricDecimationPartitions(int, char *[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(200);
+  sphere->Update();
+
+  bool success = CheckDecimation(sphere->GetOutput(), 1);
+  success = CheckDecimation(sphere->GetOutput(), 8) && success;
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
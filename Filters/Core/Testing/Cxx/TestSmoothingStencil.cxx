@@ -0,0 +1,670 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSmoothingStencil.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares vtkSmoothPolyDataFilter and vtkWindowedSincPolyDataFilter, whose
+// connectivity analysis and sinc iterations are threaded, with a serial
+// reference that classifies the vertices by searching the cell neighbors
+// through the links, one polygon at a time. The meshes have boundaries,
+// feature edges, non-manifold edges, lines, vertices and triangle strips,
+// and one of them is smoothed on the surface of a source mesh.
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkCellLocator.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolygon.h"
+#include "vtkSmartPointer.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkTriangleFilter.h"
+#include "vtkWindowedSincPolyDataFilter.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+enum { SIMPLE = 0, FIXED = 1, FEATURE_EDGE = 2, BOUNDARY_EDGE = 3 };
+
+struct ReferenceVertex
+{
+  int Type;
+  std::vector<vtkIdType> Edges;
+};
+
+struct ReferenceOptions
+{
+  bool FeatureEdgeSmoothing;
+  double FeatureAngle;
+  double EdgeAngle;
+  bool BoundarySmoothing;
+  bool NonManifoldSmoothing;
+  bool ClosedLoops;
+};
+
+// Add an edge to a vertex, special edges replacing the simple ones.
+void AddReferenceEdge(ReferenceVertex& v, vtkIdType nei, int edge)
+{
+  if (edge != SIMPLE && v.Type == SIMPLE)
+  {
+    v.Edges.clear();
+    v.Edges.push_back(nei);
+    v.Type = edge;
+  }
+  else if ((edge != SIMPLE && v.Type != FIXED) || (edge == SIMPLE && v.Type == SIMPLE))
+  {
+    v.Edges.push_back(nei);
+    if (v.Type != SIMPLE && edge == BOUNDARY_EDGE)
+    {
+      v.Type = BOUNDARY_EDGE;
+    }
+  }
+}
+
+// The serial connectivity analysis of the smoothing filters.
+std::vector<ReferenceVertex> ReferenceAnalysis(vtkPolyData* input, const ReferenceOptions& opts)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPoints* inPts = input->GetPoints();
+  std::vector<ReferenceVertex> verts(numPts);
+  for (ReferenceVertex& v : verts)
+  {
+    v.Type = SIMPLE;
+  }
+
+  vtkIdType npts, *pts;
+  vtkCellArray* inVerts = input->GetVerts();
+  for (inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts);)
+  {
+    for (vtkIdType j = 0; j < npts; j++)
+    {
+      verts[pts[j]].Type = FIXED;
+    }
+  }
+
+  vtkCellArray* inLines = input->GetLines();
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts);)
+  {
+    bool closedLoop = (opts.ClosedLoops && pts[0] == pts[npts - 1] && npts > 3);
+    for (vtkIdType j = 0; j < npts; j++)
+    {
+      ReferenceVertex& v = verts[pts[j]];
+      if (v.Type == SIMPLE)
+      {
+        if ((j == 0 || j == npts - 1) && !closedLoop)
+        {
+          v.Type = FIXED;
+        }
+        else if (j == 0)
+        {
+          v.Type = FEATURE_EDGE;
+          v.Edges.assign({ pts[npts - 2], pts[1] });
+        }
+        else if (j < npts - 1)
+        {
+          v.Type = FEATURE_EDGE;
+          v.Edges.assign({ pts[j - 1], pts[(closedLoop && j == npts - 2) ? 0 : j + 1] });
+        }
+      }
+      else if (v.Type == FEATURE_EDGE && !(closedLoop && j == npts - 1))
+      {
+        v.Type = FIXED;
+        v.Edges.clear();
+      }
+    }
+  }
+
+  vtkNew<vtkPolyData> mesh;
+  mesh->SetPoints(inPts);
+  mesh->SetPolys(input->GetPolys());
+  vtkSmartPointer<vtkPolyData> triMesh = mesh.GetPointer();
+  if (input->GetStrips()->GetNumberOfCells() > 0)
+  {
+    mesh->SetStrips(input->GetStrips());
+    vtkNew<vtkTriangleFilter> toTris;
+    toTris->SetInputData(mesh);
+    toTris->Update();
+    triMesh = toTris->GetOutput();
+  }
+  triMesh->BuildLinks();
+
+  double cosFeatureAngle = cos(vtkMath::RadiansFromDegrees(opts.FeatureAngle));
+  vtkNew<vtkIdList> neighbors;
+  vtkCellArray* polys = triMesh->GetPolys();
+  vtkIdType cellId = 0;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); cellId++)
+  {
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      vtkIdType p1 = pts[i];
+      vtkIdType p2 = pts[(i + 1) % npts];
+      triMesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
+      vtkIdType numNei = neighbors->GetNumberOfIds();
+
+      int edge = SIMPLE;
+      if (numNei == 0)
+      {
+        edge = BOUNDARY_EDGE;
+      }
+      else if (numNei >= 2)
+      {
+        if (!opts.NonManifoldSmoothing)
+        {
+          bool first = true;
+          for (vtkIdType j = 0; j < numNei; j++)
+          {
+            first = first && neighbors->GetId(j) > cellId;
+          }
+          if (first)
+          {
+            edge = FEATURE_EDGE;
+          }
+        }
+      }
+      else if (neighbors->GetId(0) > cellId)
+      {
+        if (opts.FeatureEdgeSmoothing)
+        {
+          double normal[3], neiNormal[3];
+          vtkIdType numNeiPts, *neiPts;
+          vtkPolygon::ComputeNormal(inPts, npts, pts, normal);
+          triMesh->GetCellPoints(neighbors->GetId(0), numNeiPts, neiPts);
+          vtkPolygon::ComputeNormal(inPts, numNeiPts, neiPts, neiNormal);
+          if (vtkMath::Dot(normal, neiNormal) <= cosFeatureAngle)
+          {
+            edge = FEATURE_EDGE;
+          }
+        }
+      }
+      else
+      {
+        continue;
+      }
+
+      AddReferenceEdge(verts[p1], p2, edge);
+      AddReferenceEdge(verts[p2], p1, edge);
+    }
+  }
+
+  double cosEdgeAngle = cos(vtkMath::RadiansFromDegrees(opts.EdgeAngle));
+  for (vtkIdType i = 0; i < numPts; i++)
+  {
+    ReferenceVertex& v = verts[i];
+    if (v.Type != FEATURE_EDGE && v.Type != BOUNDARY_EDGE)
+    {
+      continue;
+    }
+    if ((!opts.BoundarySmoothing && v.Type == BOUNDARY_EDGE) || v.Edges.size() != 2)
+    {
+      v.Type = FIXED;
+      continue;
+    }
+    double x1[3], x2[3], x3[3], l1[3], l2[3];
+    inPts->GetPoint(v.Edges[0], x1);
+    inPts->GetPoint(i, x2);
+    inPts->GetPoint(v.Edges[1], x3);
+    for (int k = 0; k < 3; k++)
+    {
+      l1[k] = x2[k] - x1[k];
+      l2[k] = x3[k] - x2[k];
+    }
+    if (vtkMath::Normalize(l1) >= 0.0 && vtkMath::Normalize(l2) >= 0.0 &&
+      vtkMath::Dot(l1, l2) < cosEdgeAngle)
+    {
+      v.Type = FIXED;
+    }
+  }
+  return verts;
+}
+
+// Serial Laplacian smoothing, with the points moved in place.
+std::vector<float> ReferenceLaplacian(vtkPolyData* input, vtkPolyData* source,
+  const std::vector<ReferenceVertex>& verts, int numberOfIterations, float factor, bool jacobi)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  std::vector<float> x(3 * numPts);
+  std::vector<vtkIdType> cellIds(numPts);
+  std::vector<int> subIds(numPts);
+  std::vector<double> pcoords(3 * numPts);
+  std::vector<double> weights(source ? source->GetMaxCellSize() : 0);
+  vtkNew<vtkCellLocator> locator;
+  double closestPt[3], dist2;
+  if (source)
+  {
+    locator->SetDataSet(source);
+    locator->BuildLocator();
+  }
+  for (vtkIdType i = 0; i < numPts; i++)
+  {
+    double p[3];
+    input->GetPoint(i, p);
+    if (source)
+    {
+      locator->FindClosestPoint(p, closestPt, cellIds[i], subIds[i], dist2);
+      p[0] = closestPt[0];
+      p[1] = closestPt[1];
+      p[2] = closestPt[2];
+    }
+    for (int k = 0; k < 3; k++)
+    {
+      x[3 * i + k] = static_cast<float>(p[k]);
+    }
+  }
+
+  for (int iter = 0; iter < numberOfIterations; iter++)
+  {
+    // Jacobi updates read the positions of the previous iteration,
+    // Gauss-Seidel updates read the positions as they are updated
+    const std::vector<float> previous = (jacobi ? x : std::vector<float>());
+    const std::vector<float>& y = (jacobi ? previous : x);
+    for (vtkIdType i = 0; i < numPts; i++)
+    {
+      const ReferenceVertex& v = verts[i];
+      vtkIdType npts = static_cast<vtkIdType>(v.Edges.size());
+      if (v.Type == FIXED || npts == 0)
+      {
+        continue;
+      }
+      float deltaX[3] = { 0.0f, 0.0f, 0.0f };
+      for (vtkIdType nei : v.Edges)
+      {
+        for (int k = 0; k < 3; k++)
+        {
+          deltaX[k] += y[3 * nei + k];
+        }
+      }
+      double xNew[3];
+      for (int k = 0; k < 3; k++)
+      {
+        x[3 * i + k] = y[3 * i + k] + factor * (deltaX[k] / npts - y[3 * i + k]);
+        xNew[k] = x[3 * i + k];
+      }
+      if (source)
+      {
+        vtkCell* cell = (cellIds[i] >= 0 ? source->GetCell(cellIds[i]) : nullptr);
+        if (!cell ||
+          cell->EvaluatePosition(
+            xNew, closestPt, subIds[i], &pcoords[3 * i], dist2, weights.data()) == 0)
+        {
+          locator->FindClosestPoint(xNew, closestPt, cellIds[i], subIds[i], dist2);
+        }
+        for (int k = 0; k < 3; k++)
+        {
+          x[3 * i + k] = static_cast<float>(closestPt[k]);
+        }
+      }
+    }
+  }
+  return x;
+}
+
+// Serial windowed sinc smoothing, following Taubin.
+std::vector<float> ReferenceWindowedSinc(
+  vtkPolyData* input, const std::vector<ReferenceVertex>& verts, int n, double passBand)
+{
+  // Hamming window and Chebyshev coefficients, with the offset found by
+  // Newton-Raphson iterations
+  double thetaPB = acos(1.0 - 0.5 * passBand);
+  std::vector<double> w(n + 1), c(n + 1), cprime(n + 1);
+  for (int i = 0; i <= n; i++)
+  {
+    w[i] = 0.54 + 0.46 * cos(i * vtkMath::Pi() / (n + 1));
+  }
+  double sigma = 0.0;
+  for (int iter = 0; iter < 500; iter++)
+  {
+    c[0] = w[0] * (thetaPB + sigma) / vtkMath::Pi();
+    for (int i = 1; i <= n; i++)
+    {
+      c[i] = 2.0 * w[i] * sin(i * (thetaPB + sigma)) / (i * vtkMath::Pi());
+    }
+    cprime[n] = 0.0;
+    cprime[n - 1] = 0.0;
+    if (n > 1)
+    {
+      cprime[n - 2] = 2.0 * (n - 1) * c[n - 1];
+    }
+    for (int i = n - 3; i >= 0; i--)
+    {
+      cprime[i] = cprime[i + 2] + 2.0 * (i + 1) * c[i + 1];
+    }
+    double f = c[0], fprime = cprime[0];
+    for (int i = 1; i <= n; i++)
+    {
+      double t = (i == 1 ? 1.0 - 0.5 * passBand : cos(i * acos(1.0 - 0.5 * passBand)));
+      f += c[i] * t;
+      fprime += cprime[i] * t;
+    }
+    if (fabs(f - 1.0) < 1e-3)
+    {
+      break;
+    }
+    sigma -= (f - 1.0) / fprime;
+  }
+
+  vtkIdType numPts = input->GetNumberOfPoints();
+  std::vector<float> x[4];
+  for (int j = 0; j < 4; j++)
+  {
+    x[j].assign(3 * numPts, 0.0f);
+  }
+  for (vtkIdType i = 0; i < numPts; i++)
+  {
+    double p[3];
+    input->GetPoint(i, p);
+    for (int k = 0; k < 3; k++)
+    {
+      x[0][3 * i + k] = static_cast<float>(p[k]);
+    }
+  }
+
+  int zero = 0, one = 1, two = 2;
+  const int three = 3;
+  for (vtkIdType i = 0; i < numPts; i++)
+  {
+    const ReferenceVertex& v = verts[i];
+    double npts = static_cast<double>(v.Edges.size());
+    for (int k = 0; k < 3; k++)
+    {
+      double x0 = x[zero][3 * i + k];
+      x[three][3 * i + k] = static_cast<float>(x0);
+      if (v.Edges.empty())
+      {
+        continue;
+      }
+      double delta = 0.0;
+      for (vtkIdType nei : v.Edges)
+      {
+        delta += (x0 - x[zero][3 * nei + k]) / npts;
+      }
+      double x1 = static_cast<float>(x0 - 0.5 * delta);
+      x[one][3 * i + k] = static_cast<float>(x1);
+      if (v.Type != FIXED)
+      {
+        x[three][3 * i + k] = static_cast<float>(c[0] * x0 + c[1] * (x0 - 0.5 * delta));
+      }
+    }
+  }
+  for (int iter = 2; iter <= n; iter++)
+  {
+    for (vtkIdType i = 0; i < numPts; i++)
+    {
+      const ReferenceVertex& v = verts[i];
+      double npts = static_cast<double>(v.Edges.size());
+      for (int k = 0; k < 3; k++)
+      {
+        if (v.Edges.empty())
+        {
+          x[two][3 * i + k] = 0.0f;
+          continue;
+        }
+        double x0 = x[zero][3 * i + k];
+        double x1 = x[one][3 * i + k];
+        double delta = 0.0;
+        for (vtkIdType nei : v.Edges)
+        {
+          delta += (x1 - x[one][3 * nei + k]) / npts;
+        }
+        delta = x1 - x0 + x1 - delta;
+        x[two][3 * i + k] = static_cast<float>(delta);
+        if (v.Type != FIXED)
+        {
+          x[three][3 * i + k] = static_cast<float>(x[three][3 * i + k] + c[iter] * delta);
+        }
+      }
+    }
+    zero = (zero + 1) % 3;
+    one = (one + 1) % 3;
+    two = (two + 1) % 3;
+  }
+  return x[three];
+}
+
+// A jittered height field over the unit square, with a crease along
+// x = 0.5 and a fin of two triangles standing on one of its edges. A
+// polyline, a closed loop and a few vertices are added, and the last rows
+// are stored as triangle strips.
+vtkSmartPointer<vtkPolyData> MakeCreasedSheet(vtkMinimalStandardRandomSequence* random)
+{
+  const int n = 24;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= n; j++)
+  {
+    for (int i = 0; i <= n; i++)
+    {
+      double x = static_cast<double>(i) / n;
+      double y = static_cast<double>(j) / n;
+      double z = 0.5 - fabs(x - 0.5) + random->GetRangeValue(-0.01, 0.01);
+      random->Next();
+      points->InsertNextPoint(x + random->GetRangeValue(-0.005, 0.005), y, z);
+      random->Next();
+    }
+  }
+  vtkIdType fin0 = points->InsertNextPoint(0.25, 0.5, 0.6);
+  vtkIdType fin1 = points->InsertNextPoint(0.3, 0.55, 0.65);
+
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> strips;
+  for (int j = 0; j < n; j++)
+  {
+    if (j >= n - 3)
+    {
+      strips->InsertNextCell(2 * (n + 1));
+      for (int i = 0; i <= n; i++)
+      {
+        strips->InsertCellPoint(j * (n + 1) + i);
+        strips->InsertCellPoint((j + 1) * (n + 1) + i);
+      }
+      continue;
+    }
+    for (int i = 0; i < n; i++)
+    {
+      vtkIdType p0 = j * (n + 1) + i;
+      vtkIdType quad[4] = { p0, p0 + 1, p0 + n + 2, p0 + n + 1 };
+      if ((i + j) % 3 == 0)
+      {
+        polys->InsertNextCell(4, quad);
+      }
+      else
+      {
+        vtkIdType tri0[3] = { quad[0], quad[1], quad[2] };
+        vtkIdType tri1[3] = { quad[0], quad[2], quad[3] };
+        polys->InsertNextCell(3, tri0);
+        polys->InsertNextCell(3, tri1);
+      }
+    }
+  }
+  vtkIdType e0 = (n / 2) * (n + 1) + n / 4;
+  vtkIdType fin[2][3] = { { e0, e0 + 1, fin0 }, { e0 + 1, fin1, fin0 } };
+  polys->InsertNextCell(3, fin[0]);
+  polys->InsertNextCell(3, fin[1]);
+
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell(n / 2);
+  for (int j = 2; j < n / 2 + 2; j++)
+  {
+    lines->InsertCellPoint(j * (n + 1) + 3 * n / 4);
+  }
+  lines->InsertNextCell(9);
+  for (vtkIdType p : { 5, 6, 7, 7 + n + 1, 7 + 2 * (n + 1), 6 + 2 * (n + 1), 5 + 2 * (n + 1),
+         5 + n + 1, 5 })
+  {
+    lines->InsertCellPoint(5 * (n + 1) + p);
+  }
+
+  vtkNew<vtkCellArray> verts;
+  vtkIdType vertIds[3] = { 3 * (n + 1) + 2, 10 * (n + 1) + 14, 17 * (n + 1) + 8 };
+  verts->InsertNextCell(3, vertIds);
+
+  vtkSmartPointer<vtkPolyData> sheet = vtkSmartPointer<vtkPolyData>::New();
+  sheet->SetPoints(points);
+  sheet->SetPolys(polys);
+  sheet->SetStrips(strips);
+  sheet->SetLines(lines);
+  sheet->SetVerts(verts);
+  return sheet;
+}
+
+// A closed latitude/longitude sphere, optionally with jittered points.
+vtkSmartPointer<vtkPolyData> MakeSphere(
+  int resolution, vtkMinimalStandardRandomSequence* random, double jitter)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  int numTheta = 2 * resolution;
+  points->InsertNextPoint(0.0, 0.0, 1.0);
+  for (int j = 1; j < resolution; j++)
+  {
+    double phi = vtkMath::Pi() * j / resolution;
+    for (int i = 0; i < numTheta; i++)
+    {
+      double theta = 2.0 * vtkMath::Pi() * i / numTheta;
+      double r = 1.0;
+      if (random)
+      {
+        r += random->GetRangeValue(-jitter, jitter);
+        random->Next();
+      }
+      points->InsertNextPoint(r * sin(phi) * cos(theta), r * sin(phi) * sin(theta), r * cos(phi));
+    }
+  }
+  vtkIdType south = points->InsertNextPoint(0.0, 0.0, -1.0);
+  for (int i = 0; i < numTheta; i++)
+  {
+    int i1 = (i + 1) % numTheta;
+    vtkIdType top[3] = { 0, 1 + i, 1 + i1 };
+    polys->InsertNextCell(3, top);
+    vtkIdType last = 1 + (resolution - 2) * numTheta;
+    vtkIdType bottom[3] = { south, last + i1, last + i };
+    polys->InsertNextCell(3, bottom);
+    for (int j = 0; j < resolution - 2; j++)
+    {
+      vtkIdType p0 = 1 + j * numTheta;
+      vtkIdType quad[4] = { p0 + i, p0 + numTheta + i, p0 + numTheta + i1, p0 + i1 };
+      polys->InsertNextCell(4, quad);
+    }
+  }
+  vtkSmartPointer<vtkPolyData> sphere = vtkSmartPointer<vtkPolyData>::New();
+  sphere->SetPoints(points);
+  sphere->SetPolys(polys);
+  return sphere;
+}
+
+bool ComparePoints(vtkPolyData* output, const std::vector<float>& reference, const char* name)
+{
+  double tol = 1e-5 * output->GetLength();
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); i++)
+  {
+    double p[3];
+    output->GetPoint(i, p);
+    for (int k = 0; k < 3; k++)
+    {
+      if (fabs(p[k] - reference[3 * i + k]) > tol)
+      {
+        cerr << name << ": point " << i << " is (" << p[0] << ", " << p[1] << ", " << p[2]
+             << ") but the serial reference gives (" << reference[3 * i] << ", "
+             << reference[3 * i + 1] << ", " << reference[3 * i + 2] << ")." << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TestLaplacian(vtkPolyData* input, vtkPolyData* source, bool featureEdgeSmoothing,
+  bool boundarySmoothing, bool jacobi, const char* name)
+{
+  vtkNew<vtkSmoothPolyDataFilter> smoother;
+  smoother->SetInputData(input);
+  if (source)
+  {
+    smoother->SetSourceData(source);
+  }
+  smoother->SetNumberOfIterations(30);
+  smoother->SetRelaxationFactor(0.2);
+  smoother->SetFeatureEdgeSmoothing(featureEdgeSmoothing);
+  smoother->SetFeatureAngle(30.0);
+  smoother->SetEdgeAngle(40.0);
+  smoother->SetBoundarySmoothing(boundarySmoothing);
+  smoother->SetJacobiSmoothing(jacobi);
+  smoother->Update();
+
+  ReferenceOptions opts = { featureEdgeSmoothing, 30.0, 40.0, boundarySmoothing, false, false };
+  std::vector<ReferenceVertex> verts = ReferenceAnalysis(input, opts);
+  return ComparePoints(
+    smoother->GetOutput(), ReferenceLaplacian(input, source, verts, 30, 0.2f, jacobi), name);
+}
+
+bool TestWindowedSinc(vtkPolyData* input, bool featureEdgeSmoothing, bool boundarySmoothing,
+  bool nonManifoldSmoothing, const char* name)
+{
+  vtkNew<vtkWindowedSincPolyDataFilter> smoother;
+  smoother->SetInputData(input);
+  smoother->SetNumberOfIterations(15);
+  smoother->SetPassBand(0.05);
+  smoother->SetFeatureEdgeSmoothing(featureEdgeSmoothing);
+  smoother->SetFeatureAngle(30.0);
+  smoother->SetEdgeAngle(40.0);
+  smoother->SetBoundarySmoothing(boundarySmoothing);
+  smoother->SetNonManifoldSmoothing(nonManifoldSmoothing);
+  smoother->Update();
+
+  ReferenceOptions opts = { featureEdgeSmoothing, 30.0, 40.0, boundarySmoothing,
+    nonManifoldSmoothing, true };
+  std::vector<ReferenceVertex> verts = ReferenceAnalysis(input, opts);
+  return ComparePoints(
+    smoother->GetOutput(), ReferenceWindowedSinc(input, verts, 15, 0.05), name);
+}
+
+} // anonymous namespace
+
+int TestSmoothingStencil(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkSmartPointer<vtkPolyData> sheet = MakeCreasedSheet(random);
+  vtkSmartPointer<vtkPolyData> sphere = MakeSphere(8, random, 0.05);
+  vtkSmartPointer<vtkPolyData> source = MakeSphere(24, nullptr, 0.0);
+
+  bool valid = true;
+  for (int boundary = 0; boundary < 2; boundary++)
+  {
+    for (int feature = 0; feature < 2; feature++)
+    {
+      valid &= TestLaplacian(sheet, nullptr, feature != 0, boundary != 0, false,
+        "vtkSmoothPolyDataFilter");
+      valid &= TestLaplacian(sheet, nullptr, feature != 0, boundary != 0, true,
+        "vtkSmoothPolyDataFilter with Jacobi updates");
+      for (int nonManifold = 0; nonManifold < 2; nonManifold++)
+      {
+        valid &= TestWindowedSinc(sheet, feature != 0, boundary != 0, nonManifold != 0,
+          "vtkWindowedSincPolyDataFilter");
+      }
+    }
+  }
+  valid &= TestLaplacian(
+    sphere, source, false, true, false, "vtkSmoothPolyDataFilter with source");
+  valid &= TestLaplacian(
+    sphere, source, false, true, true, "vtkSmoothPolyDataFilter with source and Jacobi updates");
+  valid &= TestLaplacian(
+    sphere, nullptr, false, true, true, "vtkSmoothPolyDataFilter with Jacobi updates");
+  valid &= TestWindowedSinc(sphere, true, true, false, "vtkWindowedSincPolyDataFilter");
+
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
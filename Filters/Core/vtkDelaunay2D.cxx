@@ -16,6 +16,7 @@
 
 #include "vtkAbstractTransform.h"
 #include "vtkCellArray.h"
+#include "vtkDelaunaySpatialSort.h"
 #include "vtkDoubleArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -45,6 +46,7 @@ vtkDelaunay2D::vtkDelaunay2D()
   this->Offset = 1.0;
   this->Transform = nullptr;
   this->ProjectionPlaneMode = VTK_DELAUNAY_XY_PLANE;
+  this->SpatialSorting = 0;
 
   // optional 2nd input
   this->SetNumberOfInputPorts(2);
@@ -403,7 +405,8 @@ int vtkDelaunay2D::RequestData(
     tPoints = nullptr;
   }
 
-  const double *bounds = points->GetBounds();
+  double bounds[6];
+  points->GetBounds(bounds);
   center[0] = (bounds[0]+bounds[1])/2.0;
   center[1] = (bounds[2]+bounds[3])/2.0;
   center[2] = (bounds[4]+bounds[5])/2.0;
@@ -446,13 +449,21 @@ int vtkDelaunay2D::RequestData(
   this->Mesh->SetPolys(triangles);
   this->Mesh->BuildLinks(); //build cell structure
 
+  // Optionally insert the points in a spatially coherent order.
+  std::vector<vtkIdType> order;
+  if ( this->SpatialSorting )
+  {
+    vtkDelaunaySpatialSort::Sort(points, numPoints, bounds, 2, order);
+  }
+
   // For each point; find triangle containing point. Then evaluate three
   // neighboring triangles for Delaunay criterion. Triangles that do not
   // satisfy criterion have their edges swapped. This continues recursively
   // until all triangles have been shown to be Delaunay.
   //
-  for (ptId=0; ptId < numPoints; ptId++)
+  for (vtkIdType insertId=0; insertId < numPoints; insertId++)
   {
+    ptId = ( order.empty() ? insertId : order[insertId] );
     this->GetPoint(ptId,x);
     nei[0] = (-1); //where we are coming from...nowhere initially
 
@@ -533,10 +544,10 @@ int vtkDelaunay2D::RequestData(
       tri[0] = 0; //no triangle found
     }
 
-    if ( ! (ptId % 1000) )
+    if ( ! (insertId % 1000) )
     {
       vtkDebugMacro(<<"point #" << ptId);
-      this->UpdateProgress (static_cast<double>(ptId)/numPoints);
+      this->UpdateProgress (static_cast<double>(insertId)/numPoints);
       if (this->GetAbortExecute())
       {
         break;
@@ -1593,4 +1604,6 @@ void vtkDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: "
      << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Spatial Sorting: "
+     << (this->SpatialSorting ? "On\n" : "Off\n");
 }
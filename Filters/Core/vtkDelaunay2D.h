@@ -217,6 +217,25 @@ public:
   vtkBooleanMacro(BoundingTriangulation,vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Boolean controls the order in which points are inserted into the
+   * triangulation. When off (the default), points are inserted in input
+   * order. When on, points are inserted in a biased randomized order whose
+   * rounds are sorted along a Hilbert curve. This keeps point location
+   * local and makes large, spatially incoherent inputs (e.g., scanned
+   * point clouds) much faster to triangulate. The resulting triangulation
+   * is the same up to degenerate (cocircular) configurations and the
+   * order of the output triangles. Only the computation and sorting of the
+   * insertion order are threaded: the points are still inserted one at a
+   * time into a single triangulation, and no partitioned (parallel)
+   * triangulation is performed.
+   */
+  vtkSetMacro(SpatialSorting,vtkTypeBool);
+  vtkGetMacro(SpatialSorting,vtkTypeBool);
+  vtkBooleanMacro(SpatialSorting,vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Set / get the transform which is applied to points to generate a
@@ -269,6 +288,8 @@ protected:
 
   int ProjectionPlaneMode; //selects the plane in 3D where the Delaunay triangulation will be computed.
 
+  vtkTypeBool SpatialSorting;
+
 private:
   vtkPolyData *Mesh; //the created mesh
   double *Points;    //the raw points in double precision
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkDelaunay3D.h"
 
+#include "vtkDelaunaySpatialSort.h"
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
 #include "vtkInformation.h"
@@ -28,6 +29,8 @@
 #include "vtkUnstructuredGrid.h"
 #include "vtkIncrementalPointLocator.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkDelaunay3D);
 
 //--------------------------------------------------------------------------
@@ -141,6 +144,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->AlphaVerts = 1;
   this->Tolerance = 0.001;
   this->BoundingTriangulation = 0;
+  this->SpatialSorting = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
   this->Locator = nullptr;
@@ -484,20 +488,29 @@ int vtkDelaunay3D::RequestData(
   Mesh = this->InitPointInsertion(center, this->Offset*tol,
                                   numPoints, points);
 
+  // Optionally insert the points in a spatially coherent order.
+  std::vector<vtkIdType> order;
+  if ( this->SpatialSorting )
+  {
+    vtkDelaunaySpatialSort::Sort(inPoints, numPoints, inPoints->GetBounds(), 3,
+                                 order);
+  }
+
   // Insert each point into triangulation. Points laying "inside"
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
   // tetrahedra.
-  for (ptId=0; ptId < numPoints; ptId++)
+  for (vtkIdType insertId=0; insertId < numPoints; insertId++)
   {
+    ptId = ( order.empty() ? insertId : order[insertId] );
     inPoints->GetPoint(ptId,x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if ( ! (ptId % 250) )
+    if ( ! (insertId % 250) )
     {
       vtkDebugMacro(<<"point #" << ptId);
-      this->UpdateProgress (static_cast<double>(ptId)/numPoints);
+      this->UpdateProgress (static_cast<double>(insertId)/numPoints);
       if (this->GetAbortExecute())
       {
         break;
@@ -1037,6 +1050,8 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: "
      << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Spatial Sorting: "
+     << (this->SpatialSorting ? "On\n" : "Off\n");
 
   if ( this->Locator )
   {
@@ -197,6 +197,25 @@ public:
   vtkBooleanMacro(BoundingTriangulation,vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Boolean controls the order in which points are inserted into the
+   * triangulation. When off (the default), points are inserted in input
+   * order. When on, points are inserted in a biased randomized order whose
+   * rounds are sorted along a Hilbert curve. This keeps point location
+   * local and makes large, spatially incoherent inputs much faster to
+   * triangulate. The resulting triangulation is the same up to degenerate
+   * (cospherical) configurations and the order of the output tetrahedra.
+   * Only the computation and sorting of the insertion order are threaded:
+   * the points are still inserted one at a time into a single
+   * triangulation, and no partitioned (parallel) triangulation is
+   * performed.
+   */
+  vtkSetMacro(SpatialSorting,vtkTypeBool);
+  vtkGetMacro(SpatialSorting,vtkTypeBool);
+  vtkBooleanMacro(SpatialSorting,vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Set / get a spatial locator for merging points. By default,
@@ -278,6 +297,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  vtkTypeBool SpatialSorting;
 
   vtkIncrementalPointLocator *Locator;  //help locate points faster
 
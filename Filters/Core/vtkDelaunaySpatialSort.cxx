@@ -0,0 +1,176 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDelaunaySpatialSort.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDelaunaySpatialSort.h"
+
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+namespace {
+
+// The round is kept in the high bits of the key, above the Hilbert index
+// of dimension*HilbertBits bits.
+const int VTK_DELAUNAY_MAX_ROUND = 15;
+
+int vtkDelaunayHilbertBits(int dimension)
+{
+  return ( dimension == 2 ? 16 : 18 );
+}
+
+struct vtkDelaunayInsertionKey
+{
+  vtkTypeUInt64 Key;
+  vtkIdType PtId;
+
+  bool operator<(const vtkDelaunayInsertionKey& k) const
+  {
+    return ( this->Key < k.Key || (this->Key == k.Key && this->PtId < k.PtId) );
+  }
+};
+
+// Distance along a Hilbert curve of the given order in two or three
+// dimensions (J. Skilling, "Programming the Hilbert curve", 2004). The
+// coordinates in X are modified.
+vtkTypeUInt64 vtkDelaunayHilbertIndex(vtkTypeUInt32 *X, int dimension, int bits)
+{
+  const vtkTypeUInt32 M = 1u << (bits - 1);
+  vtkTypeUInt32 P, Q, t;
+  int i;
+
+  // Inverse undo
+  for (Q = M; Q > 1; Q >>= 1)
+  {
+    P = Q - 1;
+    for (i = 0; i < dimension; i++)
+    {
+      if ( X[i] & Q )
+      {
+        X[0] ^= P;
+      }
+      else
+      {
+        t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (i = 1; i < dimension; i++)
+  {
+    X[i] ^= X[i-1];
+  }
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1)
+  {
+    if ( X[dimension-1] & Q )
+    {
+      t ^= Q - 1;
+    }
+  }
+  for (i = 0; i < dimension; i++)
+  {
+    X[i] ^= t;
+  }
+
+  // Interleave the transposed bits
+  vtkTypeUInt64 d = 0;
+  for (int b = bits - 1; b >= 0; b--)
+  {
+    for (i = 0; i < dimension; i++)
+    {
+      d = (d << 1) | ((X[i] >> b) & 1);
+    }
+  }
+  return d;
+}
+
+// The BRIO round of a point: the number of trailing zero bits of a hash of
+// its id, so that each round holds about twice the points of the previous.
+int vtkDelaunayInsertionRound(vtkIdType ptId)
+{
+  vtkTypeUInt64 h = static_cast<vtkTypeUInt64>(ptId) + 0x9E3779B97F4A7C15ULL;
+  h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+  h = h ^ (h >> 31);
+  int round = 0;
+  while ( round < VTK_DELAUNAY_MAX_ROUND && !(h & 1) )
+  {
+    h >>= 1;
+    round++;
+  }
+  return round;
+}
+
+struct vtkDelaunayComputeKeys
+{
+  vtkPoints *Points;
+  int Dimension;
+  int Bits;
+  double Origin[3];
+  double Scale[3];
+  vtkDelaunayInsertionKey *Keys;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    const double maxCoord = static_cast<double>((1u << this->Bits) - 1);
+    double x[3];
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      vtkTypeUInt32 q[3];
+      for (int i=0; i < this->Dimension; i++)
+      {
+        double t = (x[i] - this->Origin[i]) * this->Scale[i];
+        t = ( t < 0.0 ? 0.0 : (t > maxCoord ? maxCoord : t) );
+        q[i] = static_cast<vtkTypeUInt32>(t);
+      }
+      vtkTypeUInt64 round = VTK_DELAUNAY_MAX_ROUND - vtkDelaunayInsertionRound(ptId);
+      this->Keys[ptId].Key = (round << (this->Dimension*this->Bits)) |
+        vtkDelaunayHilbertIndex(q, this->Dimension, this->Bits);
+      this->Keys[ptId].PtId = ptId;
+    }
+  }
+};
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+void vtkDelaunaySpatialSort::Sort(vtkPoints *points, vtkIdType numPts,
+                                  const double bounds[6], int dimension,
+                                  std::vector<vtkIdType>& order)
+{
+  vtkDelaunayComputeKeys computeKeys;
+  computeKeys.Points = points;
+  computeKeys.Dimension = dimension;
+  computeKeys.Bits = vtkDelaunayHilbertBits(dimension);
+  for (int i=0; i < dimension; i++)
+  {
+    double length = bounds[2*i+1] - bounds[2*i];
+    computeKeys.Origin[i] = bounds[2*i];
+    computeKeys.Scale[i] = ( length > 0.0 ?
+      ((1u << computeKeys.Bits) - 1) / length : 0.0 );
+  }
+  std::vector<vtkDelaunayInsertionKey> keys(numPts);
+  computeKeys.Keys = keys.data();
+  vtkSMPTools::For(0, numPts, computeKeys);
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  order.resize(numPts);
+  for (vtkIdType i=0; i < numPts; i++)
+  {
+    order[i] = keys[i].PtId;
+  }
+}
@@ -0,0 +1,56 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDelaunaySpatialSort.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDelaunaySpatialSort
+ * @brief   spatially coherent point insertion order for Delaunay filters
+ *
+ * vtkDelaunaySpatialSort is a private helper class shared by vtkDelaunay2D
+ * and vtkDelaunay3D when their SpatialSorting option is on. The points are
+ * split into the rounds of a biased randomized insertion order (BRIO):
+ * about half of the points go in the last round, a quarter in the one
+ * before, and so on. Within a round the points are ordered along a
+ * Hilbert curve in two or three dimensions, so that consecutive points are
+ * close and the point location walks of the filters stay short. The sort
+ * keys are computed and sorted with vtkSMPTools.
+ *
+ * @sa
+ * vtkDelaunay2D vtkDelaunay3D
+*/
+
+#ifndef vtkDelaunaySpatialSort_h
+#define vtkDelaunaySpatialSort_h
+
+#include "vtkType.h"
+
+#include <vector> // For the insertion order
+
+class vtkPoints;
+
+class vtkDelaunaySpatialSort
+{
+public:
+  /**
+   * Compute the insertion order of the first numPts points. Only the
+   * first dimension (2 or 3) coordinates of the points are used, and they
+   * are quantized within the given bounds. The order is deterministic: it
+   * only depends on the point ids and coordinates.
+   */
+  static void Sort(vtkPoints *points, vtkIdType numPts,
+                   const double bounds[6], int dimension,
+                   std::vector<vtkIdType>& order);
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkDelaunaySpatialSort.h
@@ -34,6 +34,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 vtkStandardNewMacro(vtkProbeFilter);
@@ -366,45 +367,157 @@ void vtkProbeFilter::Probe(vtkDataSet *input, vtkDataSet *source,
 }
 
 //----------------------------------------------------------------------------
-void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
-  int srcIdx,
-  vtkDataSet *source, vtkDataSet *output)
+// Probes a range of the input points. Each thread gets its own generic cell
+// and weights buffer; the (static) cell locator and the source dataset are
+// shared read-only. Every input point is written by exactly one thread and the
+// output arrays are allocated up front, so no locking is needed when writing
+// the interpolated values.
+class vtkProbeFilter::ProbeEmptyPointsWorklet
 {
-  vtkIdType ptId, numPts;
-  double x[3], tol2;
-  vtkPointData *pd, *outPD;
-  vtkCellData* cd;
-  int subId;
-  double pcoords[3], *weights;
-  double fastweights[256];
-
-  vtkDebugMacro(<<"Probing data");
+public:
+  ProbeEmptyPointsWorklet(vtkProbeFilter *probeFilter, vtkDataSet *input,
+                          vtkDataSet *source, int srcIdx,
+                          vtkAbstractCellLocator *cellLocator,
+                          vtkPointData *outPD, char *maskArray,
+                          double tol2, int maxCellSize)
+    : ProbeFilter(probeFilter), Input(input), Source(source), SrcIdx(srcIdx),
+      CellLocator(cellLocator), OutPointData(outPD), MaskArray(maskArray),
+      Tol2(tol2), MaxCellSize(maxCellSize)
+  {
+    // Resolve the cell data arrays once rather than by name for every point.
+    vtkCellData *cd = source->GetCellData();
+    vtkVectorOfArrays::iterator iter;
+    for (iter = probeFilter->CellArrays->begin();
+         iter != probeFilter->CellArrays->end(); ++iter)
+    {
+      vtkDataArray* inArray = cd->GetArray((*iter)->GetName());
+      if (inArray)
+      {
+        this->CellArrayPairs.push_back(std::make_pair(inArray, *iter));
+      }
+    }
+  }
 
-  pd = source->GetPointData();
-  cd = source->GetCellData();
+  void Initialize()
+  {
+    this->WeightsBuffer.Local().resize(
+      std::max(this->MaxCellSize, 1));
+    vtkSmartPointer<vtkGenericCell> &gcell = this->Cell.Local();
+    gcell = vtkSmartPointer<vtkGenericCell>::New();
+  }
 
-  // lets use a stack allocated array if possible for performance reasons
-  int mcs = source->GetMaxCellSize();
-  if (mcs<=256)
+  void operator()(vtkIdType ptBegin, vtkIdType ptEnd)
   {
-    weights = fastweights;
+    double *weights = &this->WeightsBuffer.Local()[0];
+    vtkGenericCell *gcell = this->Cell.Local();
+    vtkPointData *pd = this->Source->GetPointData();
+    const bool computeTolerance = this->ProbeFilter->ComputeTolerance;
+
+    double x[3], pcoords[3];
+    int subId;
+    for (vtkIdType ptId = ptBegin; ptId < ptEnd; ++ptId)
+    {
+      if (this->MaskArray[ptId] == static_cast<char>(1))
+      {
+        // skip points which have already been probed with success.
+        // This is helpful for multiblock dataset probing.
+        continue;
+      }
+
+      // Get the xyz coordinate of the point in the input dataset
+      this->Input->GetPoint(ptId, x);
+
+      // Find the cell that contains xyz and get it
+      vtkIdType cellId;
+      if (this->CellLocator)
+      {
+        cellId = this->CellLocator->FindCell(x, this->Tol2, gcell, pcoords,
+                                             weights);
+      }
+      else
+      {
+        cellId = this->Source->FindCell(x, nullptr, gcell, -1, this->Tol2,
+                                        subId, pcoords, weights);
+        if (cellId >= 0)
+        {
+          this->Source->GetCell(cellId, gcell);
+        }
+      }
+
+      if (cellId < 0)
+      {
+        continue;
+      }
+
+      if (computeTolerance)
+      {
+        // If ComputeTolerance is set, compute a tolerance proportional to the
+        // cell length.
+        double dist2;
+        double closestPoint[3];
+        gcell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2,
+                                weights);
+        if (dist2 > (gcell->GetLength2() * CELL_TOLERANCE_FACTOR_SQR))
+        {
+          continue;
+        }
+      }
+
+      // Interpolate the point data
+      this->OutPointData->InterpolatePoint((*this->ProbeFilter->PointList),
+        pd, this->SrcIdx, ptId, gcell->PointIds, weights);
+      std::vector<std::pair<vtkDataArray*, vtkDataArray*> >::iterator iter;
+      for (iter = this->CellArrayPairs.begin();
+           iter != this->CellArrayPairs.end(); ++iter)
+      {
+        this->OutPointData->CopyTuple(iter->first, iter->second, cellId, ptId);
+      }
+      this->MaskArray[ptId] = static_cast<char>(1);
+    }
   }
-  else
+
+  void Reduce()
   {
-    weights = new double[mcs];
   }
 
-  numPts = input->GetNumberOfPoints();
-  outPD = output->GetPointData();
+private:
+  vtkProbeFilter *ProbeFilter;
+  vtkDataSet *Input;
+  vtkDataSet *Source;
+  int SrcIdx;
+  vtkAbstractCellLocator *CellLocator;
+  vtkPointData *OutPointData;
+  char *MaskArray;
+  double Tol2;
+  int MaxCellSize;
+  std::vector<std::pair<vtkDataArray*, vtkDataArray*> > CellArrayPairs;
 
+  vtkSMPThreadLocal<std::vector<double> > WeightsBuffer;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkGenericCell> > Cell;
+};
+
+//----------------------------------------------------------------------------
+void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
+  int srcIdx,
+  vtkDataSet *source, vtkDataSet *output)
+{
+  vtkDebugMacro(<<"Probing data");
+
+  vtkIdType numPts = input->GetNumberOfPoints();
+  if (numPts < 1)
+  {
+    return;
+  }
+  vtkPointData *outPD = output->GetPointData();
   char* maskArray = this->MaskPoints->GetPointer(0);
 
-  tol2 = this->ComputeTolerance ? VTK_DOUBLE_MAX :
-         (this->Tolerance * this->Tolerance);
+  double tol2 = this->ComputeTolerance ? VTK_DOUBLE_MAX :
+                (this->Tolerance * this->Tolerance);
 
   // vtkPointSet based datasets do not have an implicit structure to their
   // points. A cell locator performs better here than using the dataset's
-  // FindCell function.
+  // FindCell function. The locator is built once, up front, and then shared
+  // by all threads.
   vtkSmartPointer<vtkAbstractCellLocator> cellLocator;
   if (vtkPointSet::SafeDownCast(source) != nullptr)
   {
@@ -415,76 +528,42 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
     cellLocator->Update();
   }
 
-  // Loop over all input points, interpolating source data
-  //
-  vtkNew<vtkGenericCell> gcell;
-  int abort=0;
-  vtkIdType progressInterval=numPts/20 + 1;
-  for (ptId=0; ptId < numPts && !abort; ptId++)
-  {
-    if ( !(ptId % progressInterval) )
-    {
-      this->UpdateProgress(static_cast<double>(ptId)/numPts);
-      abort = GetAbortExecute();
-    }
+  // Only vtkStaticCellLocator guarantees a thread-safe FindCell(); any other
+  // locator prototype is queried from a single thread.
+  bool threaded = (cellLocator.Get() == nullptr ||
+                   vtkStaticCellLocator::SafeDownCast(cellLocator) != nullptr);
 
-    if (maskArray[ptId] == static_cast<char>(1))
-    {
-      // skip points which have already been probed with success.
-      // This is helpful for multiblock dataset probing.
-      continue;
-    }
+  // dummy calls required before multithreaded calls: they build the lazily
+  // initialized cell structures (e.g. vtkPolyData cells, dataset bounds).
+  int maxCellSize = source->GetMaxCellSize();
+  static_cast<void>(source->GetCellType(0));
+  static_cast<void>(source->GetBounds());
+  static_cast<void>(input->GetBounds());
 
-    // Get the xyz coordinate of the point in the input dataset
-    input->GetPoint(ptId, x);
+  ProbeEmptyPointsWorklet worklet(this, input, source, srcIdx, cellLocator,
+                                  outPD, maskArray, tol2, maxCellSize);
 
-    // Find the cell that contains xyz and get it
-    vtkIdType cellId = (cellLocator.Get() != nullptr) ?
-      cellLocator->FindCell(x, tol2, gcell.GetPointer(), pcoords, weights) :
-      source->FindCell(x, nullptr, -1, tol2, subId, pcoords, weights);
+  // Process the points in batches so that progress can be reported and the
+  // execution aborted between batches.
+  int abort = 0;
+  vtkIdType batchSize = numPts/20 + 1;
+  for (vtkIdType ptId = 0; ptId < numPts && !abort; ptId += batchSize)
+  {
+    this->UpdateProgress(static_cast<double>(ptId)/numPts);
+    abort = this->GetAbortExecute();
 
-    vtkCell* cell = nullptr;
-    if (cellId >= 0)
+    vtkIdType ptEnd = std::min(ptId + batchSize, numPts);
+    if (threaded)
     {
-      cell = source->GetCell(cellId);
-      if (this->ComputeTolerance)
-      {
-        // If ComputeTolerance is set, compute a tolerance proportional to the
-        // cell length.
-        double dist2;
-        double closestPoint[3];
-        cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights);
-        if (dist2 > (cell->GetLength2() * CELL_TOLERANCE_FACTOR_SQR))
-        {
-          continue;
-        }
-      }
+      vtkSMPTools::For(ptId, ptEnd, worklet);
     }
-
-    if (cell)
+    else
     {
-      // Interpolate the point data
-      outPD->InterpolatePoint((*this->PointList), pd, srcIdx, ptId,
-        cell->PointIds, weights);
-      vtkVectorOfArrays::iterator iter;
-      for (iter = this->CellArrays->begin(); iter != this->CellArrays->end();
-        ++iter)
-      {
-        vtkDataArray* inArray = cd->GetArray((*iter)->GetName());
-        if (inArray)
-        {
-          outPD->CopyTuple(inArray, *iter, cellId, ptId);
-        }
-      }
-      maskArray[ptId] = static_cast<char>(1);
+      vtkSMPTools::For(ptId, ptEnd, ptEnd - ptId, worklet);
     }
   }
 
   this->MaskPoints->Modified();
-  if (mcs>256)
-  {
-    delete [] weights;
-  }
 }
 
 //---------------------------------------------------------------------------
@@ -33,6 +33,11 @@
  * rendering techniques can be used to visualize the results. Another example:
  * a line or curve can be used to probe data to produce x-y plots along
  * that line or curve.
+ *
+ * Probing is multithreaded via vtkSMPTools for all dataset types. When the
+ * source is a vtkPointSet, a cell locator is built once and shared by all
+ * threads; note that only vtkStaticCellLocator (the default) supports
+ * concurrent queries, so other locator prototypes are queried serially.
 */
 
 #ifndef vtkProbeFilter_h
@@ -175,7 +180,8 @@ public:
   //@{
   /**
    * Set/Get the prototype cell locator to use for probing the source dataset.
-   * By default, vtkStaticCellLocator will be used.
+   * By default, vtkStaticCellLocator will be used. Locators other than
+   * vtkStaticCellLocator are not thread-safe, so probing with them is serial.
    */
    virtual void SetCellLocatorPrototype(vtkAbstractCellLocator*);
    vtkGetObjectMacro(CellLocatorPrototype, vtkAbstractCellLocator);
@@ -259,6 +265,7 @@ private:
     const int dim[3], vtkPointData *outPD, char *maskArray, double *wtsBuff);
 
   class ProbeImageDataWorklet;
+  class ProbeEmptyPointsWorklet;
 
   class vtkVectorOfArrays;
   vtkVectorOfArrays* CellArrays;
@@ -24,10 +24,16 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <unordered_map> // per-thread sparse bins
 #include <unordered_set> // keep track of inserted triangles
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkQuadricClustering);
 
@@ -370,43 +376,231 @@ void vtkQuadricClustering::Append(vtkPolyData *pd)
 }
 
 //----------------------------------------------------------------------------
+namespace
+{
+// Sparse, per-thread accumulation of the quadrics of a set of bins.
+struct BinQuadric
+{
+  BinQuadric()
+  {
+    std::fill(this->Quadric, this->Quadric + 9, 0.0);
+  }
+  double Quadric[9];
+};
+typedef std::unordered_map<vtkIdType, BinQuadric,
+                           vtkQuadricClusteringIdTypeHash> BinQuadricMap;
+typedef std::vector<std::pair<vtkIdType, BinQuadric> > BinQuadricVector;
+
+bool BinLess(const std::pair<vtkIdType, BinQuadric> &a,
+             const std::pair<vtkIdType, BinQuadric> &b)
+{
+  return a.first < b.first;
+}
+}
+
+//----------------------------------------------------------------------------
+// Hashes the (fan) triangles of a range of polygons into bins and
+// accumulates their quadrics into thread-local bin maps. The bins of every
+// triangle are recorded so that the output triangles can be generated later
+// without touching the points again.
+class vtkQuadricClustering::BinPolygonsWorklet
+{
+public:
+  BinPolygonsWorklet(vtkQuadricClustering *self, vtkPoints *points,
+                     const vtkIdType *connectivity,
+                     const vtkIdType *cellOffsets,
+                     const vtkIdType *triOffsets, vtkIdType *triBins)
+    : Self(self), Points(points), Connectivity(connectivity),
+      CellOffsets(cellOffsets), TriOffsets(triOffsets), TriBins(triBins)
+  {
+  }
+
+  void operator()(vtkIdType cellBegin, vtkIdType cellEnd)
+  {
+    BinQuadricMap &bins = this->Bins.Local();
+    double pts0[3], pts1[3], pts2[3];
+    double quadric4x4[4][4];
+    for (vtkIdType cellId = cellBegin; cellId < cellEnd; ++cellId)
+    {
+      const vtkIdType *cell = this->Connectivity + this->CellOffsets[cellId];
+      vtkIdType numPts = cell[0];
+      const vtkIdType *ptIds = cell + 1;
+      vtkIdType *binIds = this->TriBins + 3 * this->TriOffsets[cellId];
+      if (numPts < 3)
+      {
+        continue;
+      }
+
+      this->Points->GetPoint(ptIds[0], pts0);
+      vtkIdType bin0 = this->Self->HashPoint(pts0);
+      for (vtkIdType j = 0; j < numPts - 2; ++j, binIds += 3)
+      {
+        this->Points->GetPoint(ptIds[j+1], pts1);
+        this->Points->GetPoint(ptIds[j+2], pts2);
+        binIds[0] = bin0;
+        binIds[1] = this->Self->HashPoint(pts1);
+        binIds[2] = this->Self->HashPoint(pts2);
+
+        // Same condition as in AddTriangle().
+        if (this->Self->UseInternalTriangles == 0 &&
+            (binIds[0] == binIds[1] || binIds[0] == binIds[2] ||
+             binIds[1] == binIds[2]))
+        {
+          continue;
+        }
+
+        vtkTriangle::ComputeQuadric(pts0, pts1, pts2, quadric4x4);
+        const double quadric[9] = {
+          quadric4x4[0][0], quadric4x4[0][1], quadric4x4[0][2],
+          quadric4x4[0][3], quadric4x4[1][1], quadric4x4[1][2],
+          quadric4x4[1][3], quadric4x4[2][2], quadric4x4[2][3] };
+        for (int i = 0; i < 3; ++i)
+        {
+          double *q = bins[binIds[i]].Quadric;
+          for (int k = 0; k < 9; ++k)
+          {
+            q[k] += quadric[k];
+          }
+        }
+      }
+    }
+  }
+
+  vtkQuadricClustering *Self;
+  vtkPoints *Points;
+  const vtkIdType *Connectivity;
+  const vtkIdType *CellOffsets;
+  const vtkIdType *TriOffsets;
+  vtkIdType *TriBins;
+  vtkSMPThreadLocal<BinQuadricMap> Bins;
+};
+
+//----------------------------------------------------------------------------
+// Adds the per-thread quadrics of a range of bins into the quadric array.
+// Every bin is owned by exactly one range, so no locking is needed.
+class vtkQuadricClustering::ReduceQuadricsWorklet
+{
+public:
+  ReduceQuadricsWorklet(vtkQuadricClustering *self,
+                        std::vector<BinQuadricVector> &threadBins)
+    : Self(self), ThreadBins(threadBins)
+  {
+  }
+
+  void operator()(vtkIdType binBegin, vtkIdType binEnd)
+  {
+    std::pair<vtkIdType, BinQuadric> key;
+    key.first = binBegin;
+    std::vector<BinQuadricVector>::iterator tIter;
+    for (tIter = this->ThreadBins.begin(); tIter != this->ThreadBins.end();
+         ++tIter)
+    {
+      BinQuadricVector::iterator iter =
+        std::lower_bound(tIter->begin(), tIter->end(), key, BinLess);
+      for (; iter != tIter->end() && iter->first < binEnd; ++iter)
+      {
+        vtkQuadricClustering::PointQuadric &bin =
+          this->Self->QuadricArray[iter->first];
+        // Same logic as in AddTriangle(): points and segments supersede
+        // triangles.
+        if (bin.Dimension > 2)
+        {
+          bin.Dimension = 2;
+          this->Self->InitializeQuadric(bin.Quadric);
+        }
+        if (bin.Dimension == 2)
+        {
+          this->Self->AddQuadric(iter->first, iter->second.Quadric);
+        }
+      }
+    }
+  }
+
+  vtkQuadricClustering *Self;
+  std::vector<BinQuadricVector> &ThreadBins;
+};
+
+//----------------------------------------------------------------------------
+// Polygons are processed in three passes: the triangles are binned and
+// their quadrics accumulated in parallel, the per-thread quadrics are
+// reduced in parallel, and the output triangles are then generated in input
+// order (which only involves bin lookups).
 void vtkQuadricClustering::AddPolygons(vtkCellArray *polys, vtkPoints *points,
                                        int geometryFlag,
                                        vtkPolyData *input, vtkPolyData *output)
 {
-  vtkIdType *ptIds = nullptr;
-  vtkIdType numPts = 0;
-  double pts0[3], pts1[3], pts2[3];
-  vtkIdType binIds[3];
-
-  double total = polys->GetNumberOfCells();
-  double curr = 0;
-  double step = total / 10;
-  if (step < 1000.0)
+  vtkIdType numCells = polys->GetNumberOfCells();
+  if (numCells < 1)
   {
-    step = 1000.0;
+    return;
   }
-  double cstep = step;
 
-  for ( polys->InitTraversal(); polys->GetNextCell(numPts, ptIds); )
+  // Build the offsets needed for random access into the cells, and the
+  // offset of each polygon's first fan triangle.
+  const vtkIdType *connectivity = polys->GetPointer();
+  std::vector<vtkIdType> cellOffsets(numCells);
+  std::vector<vtkIdType> triOffsets(numCells + 1);
+  vtkIdType offset = 0, numTris = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    vtkIdType numPts = connectivity[offset];
+    cellOffsets[cellId] = offset;
+    triOffsets[cellId] = numTris;
+    numTris += (numPts > 2 ? numPts - 2 : 0);
+    offset += numPts + 1;
+  }
+  triOffsets[numCells] = numTris;
+
+  std::vector<vtkIdType> triBins(3 * numTris + 1);
+  BinPolygonsWorklet binner(this, points, connectivity, &cellOffsets[0],
+                            &triOffsets[0], &triBins[0]);
+  vtkSMPTools::For(0, numCells, binner);
+  this->UpdateProgress(.65);
+
+  // Sort each thread's bins so that the bin range of each reduction task
+  // can be located quickly.
+  std::vector<BinQuadricVector> threadBins;
+  vtkSMPThreadLocal<BinQuadricMap>::iterator tIter;
+  for (tIter = binner.Bins.begin(); tIter != binner.Bins.end(); ++tIter)
+  {
+    threadBins.push_back(BinQuadricVector(tIter->begin(), tIter->end()));
+    tIter->clear();
+    vtkSMPTools::Sort(threadBins.back().begin(), threadBins.back().end(),
+                      BinLess);
+  }
+  ReduceQuadricsWorklet reducer(this, threadBins);
+  vtkSMPTools::For(0, this->NumberOfDivisions[0] *
+                   this->NumberOfDivisions[1] *
+                   this->NumberOfDivisions[2], reducer);
+  threadBins.clear();
+  this->UpdateProgress(.7);
+
+  if (!geometryFlag)
+  {
+    this->InCellCount += numCells;
+    return;
+  }
+
+  vtkIdType step = numCells / 10 + 1;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
   {
-    points->GetPoint(ptIds[0],pts0);
-    binIds[0] = this->HashPoint(pts0);
-    for (vtkIdType j=0; j < numPts-2; j++)//creates triangles; assumes poly is convex
+    vtkIdType *binIds = &triBins[3 * triOffsets[cellId]];
+    for (vtkIdType triId = triOffsets[cellId]; triId < triOffsets[cellId + 1];
+         ++triId, binIds += 3)
     {
-      points->GetPoint(ptIds[j+1],pts1);
-      binIds[1] = this->HashPoint(pts1);
-      points->GetPoint(ptIds[j+2],pts2);
-      binIds[2] = this->HashPoint(pts2);
-      this->AddTriangle(binIds, pts0, pts1, pts2, geometryFlag, input, output);
+      if (this->UseInternalTriangles == 0 &&
+          (binIds[0] == binIds[1] || binIds[0] == binIds[2] ||
+           binIds[1] == binIds[2]))
+      {
+        continue;
+      }
+      this->AddTriangleGeometry(binIds, input, output);
     }
     ++this->InCellCount;
-    if ( curr > cstep )
+    if (!(cellId % step))
     {
-      this->UpdateProgress(.6 + .2 * curr / total);
-      cstep += step;
+      this->UpdateProgress(.7 + .1 * cellId / numCells);
     }
-    curr += 1;
   }//for all polygons
 }
 
@@ -512,92 +706,100 @@ void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *p
 
   if (geometryFlag)
   {
-    vtkIdType triPtIds[3];
-    // Now add the triangle to the geometry.
-    for (int i = 0; i < 3; i++)
+    this->AddTriangleGeometry(binIds, input, output);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricClustering::AddTriangleGeometry(vtkIdType *binIds,
+                                               vtkPolyData *input,
+                                               vtkPolyData *output)
+{
+  vtkIdType triPtIds[3];
+  // Now add the triangle to the geometry.
+  for (int i = 0; i < 3; i++)
+  {
+    // Get the vertex from each bin.
+    if (this->QuadricArray[binIds[i]].VertexId == -1)
     {
-      // Get the vertex from each bin.
-      if (this->QuadricArray[binIds[i]].VertexId == -1)
-      {
-        this->QuadricArray[binIds[i]].VertexId = this->NumberOfBinsUsed;
-        this->NumberOfBinsUsed++;
-      }
-      triPtIds[i] = this->QuadricArray[binIds[i]].VertexId;
+      this->QuadricArray[binIds[i]].VertexId = this->NumberOfBinsUsed;
+      this->NumberOfBinsUsed++;
     }
-    // This comparison could just as well be on triPtIds.
-    if (binIds[0] != binIds[1] && binIds[0] != binIds[2] &&
-        binIds[1] != binIds[2])
+    triPtIds[i] = this->QuadricArray[binIds[i]].VertexId;
+  }
+  // This comparison could just as well be on triPtIds.
+  if (binIds[0] != binIds[1] && binIds[0] != binIds[2] &&
+      binIds[1] != binIds[2])
+  {
+    if ( this->PreventDuplicateCells )
     {
-      if ( this->PreventDuplicateCells )
+      vtkIdType minIdx = ( binIds[0]<binIds[1] ? (binIds[0]<binIds[2] ? 0 : 2) :
+                           (binIds[1]<binIds[2] ? 1 : 2) );
+      vtkIdType midIdx = 0;
+      vtkIdType maxIdx = 0;
+      switch ( minIdx )
       {
-        vtkIdType minIdx = ( binIds[0]<binIds[1] ? (binIds[0]<binIds[2] ? 0 : 2) :
-                             (binIds[1]<binIds[2] ? 1 : 2) );
-        vtkIdType midIdx = 0;
-        vtkIdType maxIdx = 0;
-        switch ( minIdx )
-        {
-          case 0:
-            if ( binIds[1] > binIds[2] )
-            {
-              maxIdx = 1;
-              midIdx = 2;
-            }
-            else
-            {
-              maxIdx = 2;
-              midIdx = 1;
-            }
-            break;
-          case 1:
-            if ( binIds[0] > binIds[2] )
-            {
-              maxIdx = 0;
-              midIdx = 2;
-            }
-            else
-            {
-              maxIdx = 2;
-              midIdx = 0;
-            }
-            break;
-          case 2:
-            if ( binIds[0] > binIds[1] )
-            {
-              maxIdx = 0;
-              midIdx = 1;
-            }
-            else
-            {
-              maxIdx = 1;
-              midIdx = 0;
-            }
-            break;
-        }
-        // TODO: this arithmetic overflows with the TestQuadricLODActor test.
-        vtkIdType idx = binIds[minIdx] + this->NumberOfBins*binIds[midIdx] +
-                        this->NumberOfBins*this->NumberOfBins*binIds[maxIdx];
-        if ( this->CellSet->find(idx) == this->CellSet->end() )
-        {
-          this->CellSet->insert(idx);
-          this->OutputTriangleArray->InsertNextCell(3, triPtIds);
-          if (this->CopyCellData && input)
+        case 0:
+          if ( binIds[1] > binIds[2] )
+          {
+            maxIdx = 1;
+            midIdx = 2;
+          }
+          else
+          {
+            maxIdx = 2;
+            midIdx = 1;
+          }
+          break;
+        case 1:
+          if ( binIds[0] > binIds[2] )
+          {
+            maxIdx = 0;
+            midIdx = 2;
+          }
+          else
+          {
+            maxIdx = 2;
+            midIdx = 0;
+          }
+          break;
+        case 2:
+          if ( binIds[0] > binIds[1] )
+          {
+            maxIdx = 0;
+            midIdx = 1;
+          }
+          else
           {
-            output->GetCellData()->
-              CopyData(input->GetCellData(), this->InCellCount,this->OutCellCount++);
-          }//if cell data
-        }//if not a duplicate
+            maxIdx = 1;
+            midIdx = 0;
+          }
+          break;
       }
-      else //don't check for duplicates
+      // TODO: this arithmetic overflows with the TestQuadricLODActor test.
+      vtkIdType idx = binIds[minIdx] + this->NumberOfBins*binIds[midIdx] +
+                      this->NumberOfBins*this->NumberOfBins*binIds[maxIdx];
+      if ( this->CellSet->find(idx) == this->CellSet->end() )
       {
+        this->CellSet->insert(idx);
         this->OutputTriangleArray->InsertNextCell(3, triPtIds);
         if (this->CopyCellData && input)
         {
           output->GetCellData()->
             CopyData(input->GetCellData(), this->InCellCount,this->OutCellCount++);
         }//if cell data
-      }//don't check for duplicates
-    }//if not duplicate vertices
-  }//if this should be inserted
+      }//if not a duplicate
+    }
+    else //don't check for duplicates
+    {
+      this->OutputTriangleArray->InsertNextCell(3, triPtIds);
+      if (this->CopyCellData && input)
+      {
+        output->GetCellData()->
+          CopyData(input->GetCellData(), this->InCellCount,this->OutCellCount++);
+      }//if cell data
+    }//don't check for duplicates
+  }//if not duplicate vertices
 }
 
 //----------------------------------------------------------------------------
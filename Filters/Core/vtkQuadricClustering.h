@@ -59,6 +59,14 @@
  * manual control, it has the advantage that extremely large data can be
  * processed in pieces and appended to the filter piece-by-piece.
  *
+ * Polygons, which usually make up most of the input, are processed in
+ * parallel (via vtkSMPTools): each thread accumulates the triangle quadrics
+ * into its own sparse set of bins, the per-thread bins are then reduced
+ * concurrently into the bin array, and finally the output triangles are
+ * generated in input order, so the output has the same topology as that of
+ * the serial algorithm; point positions may differ by rounding, since the
+ * quadrics are summed in a different order.
+ *
  * @warning
  * This filter can drastically affect topology, i.e., topology is not
  * preserved.
@@ -286,6 +294,13 @@ protected:
                    int geometeryFlag, vtkPolyData *input, vtkPolyData *output);
   //@}
 
+  /**
+   * Add a triangle, whose quadric has already been accumulated, to the
+   * output triangles (assigning the bin vertex ids as needed).
+   */
+  void AddTriangleGeometry(vtkIdType *binIds, vtkPolyData *input,
+                           vtkPolyData *output);
+
   //@{
   /**
    * Add edges to the quadric array.  If geometry flag is on then
@@ -410,6 +425,9 @@ protected:
 private:
   vtkQuadricClustering(const vtkQuadricClustering&) = delete;
   void operator=(const vtkQuadricClustering&) = delete;
+
+  class BinPolygonsWorklet;
+  class ReduceQuadricsWorklet;
 };
 
 #endif
@@ -49,12 +49,18 @@
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPointData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
 
@@ -70,6 +76,7 @@ vtkQuadricDecimation::vtkQuadricDecimation()
   this->TargetPoints = vtkDoubleArray::New();
 
   this->TargetReduction = 0.9;
+  this->NumberOfPartitions = 1;
   this->NumberOfEdgeCollapses = 0;
   this->NumberOfComponents = 0;
 
@@ -88,6 +95,7 @@ vtkQuadricDecimation::vtkQuadricDecimation()
   this->TensorsWeight = 0.1;
 
   this->ActualReduction = 0.0;
+  this->LockedPoints = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -187,20 +195,9 @@ int vtkQuadricDecimation::RequestData(
   vtkPolyData *output = vtkPolyData::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts = input->GetNumberOfPoints();
-  vtkIdType numTris = input->GetNumberOfPolys();
-  vtkIdType edgeId, i;
-  int j;
-  double cost;
-  double *x;
-  vtkCellArray *polys;
+  vtkIdType i;
   vtkDataArray *attrib;
-  vtkPoints *points;
-  vtkPointData *pointData;
-  vtkIdType endPtIds[2];
   vtkIdList *outputCellList;
-  vtkIdType npts, *pts;
-  vtkIdType numDeletedTris=0;
 
   // check some assumptions about the data
   if (input->GetPolys() == nullptr || input->GetPoints() == nullptr ||
@@ -216,10 +213,68 @@ int vtkQuadricDecimation::RequestData(
     return 1;
   }
 
+  if (this->NumberOfPartitions < 2 ||
+      input->GetNumberOfPolys() < 2 * this->NumberOfPartitions ||
+      !this->DecimatePartitions(input))
+  {
+    this->DecimateMesh(input);
+  }
+
+  outputCellList = vtkIdList::New();
+
+  // copy the simplified mesh from the working mesh to the output mesh
+  for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
+  {
+    if (this->Mesh->GetCell(i)->GetCellType() != VTK_EMPTY_CELL)
+    {
+      outputCellList->InsertNextId(i);
+    }
+  }
+
+  output->Reset();
+  output->Allocate(this->Mesh, outputCellList->GetNumberOfIds());
+  output->GetPointData()->CopyAllocate(this->Mesh->GetPointData(),1);
+  output->CopyCells(this->Mesh, outputCellList);
+
+  this->Mesh->DeleteLinks();
+  this->Mesh->Delete();
+  outputCellList->Delete();
+
+  // renormalize, clamp attributes
+  if (this->AttributeErrorMetric)
+  {
+    if (nullptr != (attrib = output->GetPointData()->GetNormals()))
+    {
+      for (i = 0; i < attrib->GetNumberOfTuples(); i++)
+      {
+        vtkMath::Normalize(attrib->GetTuple3(i));
+      }
+    }
+    // might want to add clamping texture coordinates??
+  }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricDecimation::DecimateMesh(vtkPolyData *input)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numTris = input->GetNumberOfPolys();
+  vtkIdType edgeId, i;
+  int j;
+  double cost;
+  double *x;
+  vtkCellArray *polys;
+  vtkPoints *points;
+  vtkPointData *pointData;
+  vtkIdType endPtIds[2];
+  vtkIdType npts, *pts;
+  vtkIdType numDeletedTris=0;
+
   polys = vtkCellArray::New();
   points = vtkPoints::New();
   pointData = vtkPointData::New();
-  outputCellList = vtkIdList::New();
 
   // copy the input (only polys) to our working mesh
   this->Mesh = vtkPolyData::New();
@@ -386,38 +441,341 @@ int vtkQuadricDecimation::RequestData(
   delete [] this->TempA;
   delete [] this->TempData;
 
-  // copy the simplified mesh from the working mesh to the output mesh
-  for (i = 0; i < this->Mesh->GetNumberOfCells(); i++)
+}
+
+//----------------------------------------------------------------------------
+// Decimates a range of partitions. Each partition is extracted into its own
+// small polydata and decimated by its own vtkQuadricDecimation instance, so
+// partitions do not share any mutable state.
+class vtkQuadricDecimation::PartitionWorklet
+{
+public:
+  PartitionWorklet(vtkPolyData *input, const vtkIdType *tris,
+                   const vtkIdType *sortedTris, const vtkIdType *offsets,
+                   const unsigned char *locked,
+                   std::vector<vtkSmartPointer<vtkQuadricDecimation> > &parts,
+                   std::vector<std::vector<vtkIdType> > &partPointIds)
+    : Input(input), Tris(tris), SortedTris(sortedTris), Offsets(offsets),
+      Locked(locked), Parts(parts), PartPointIds(partPointIds)
   {
-    if (this->Mesh->GetCell(i)->GetCellType() != VTK_EMPTY_CELL)
+  }
+
+  void operator()(vtkIdType partBegin, vtkIdType partEnd)
+  {
+    for (vtkIdType partId = partBegin; partId < partEnd; ++partId)
     {
-      outputCellList->InsertNextId(i);
+      this->DecimatePartition(partId);
     }
   }
 
-  output->Reset();
-  output->Allocate(this->Mesh, outputCellList->GetNumberOfIds());
-  output->GetPointData()->CopyAllocate(this->Mesh->GetPointData(),1);
-  output->CopyCells(this->Mesh, outputCellList);
+  void DecimatePartition(vtkIdType partId)
+  {
+    vtkQuadricDecimation *part = this->Parts[partId];
+    const vtkIdType *triIds = this->SortedTris + this->Offsets[partId];
+    vtkIdType numTris = this->Offsets[partId + 1] - this->Offsets[partId];
+
+    // Gather the (sorted, unique) points of this partition. The position of
+    // a global point id in this list is its local id.
+    std::vector<vtkIdType> &ptIds = this->PartPointIds[partId];
+    ptIds.resize(3 * numTris);
+    vtkIdType i;
+    int j;
+    for (i = 0; i < numTris; ++i)
+    {
+      const vtkIdType *tri = this->Tris + 3 * triIds[i];
+      for (j = 0; j < 3; ++j)
+      {
+        ptIds[3 * i + j] = tri[j];
+      }
+    }
+    std::sort(ptIds.begin(), ptIds.end());
+    ptIds.erase(std::unique(ptIds.begin(), ptIds.end()), ptIds.end());
+    vtkIdType numPts = static_cast<vtkIdType>(ptIds.size());
+
+    vtkPoints *inPts = this->Input->GetPoints();
+    vtkNew<vtkPoints> points;
+    points->SetDataType(inPts->GetDataType());
+    points->SetNumberOfPoints(numPts);
+    std::vector<unsigned char> locked(numPts);
+    double x[3];
+    for (i = 0; i < numPts; ++i)
+    {
+      inPts->GetPoint(ptIds[i], x);
+      points->SetPoint(i, x);
+      locked[i] = this->Locked[ptIds[i]];
+    }
 
-  this->Mesh->DeleteLinks();
-  this->Mesh->Delete();
-  outputCellList->Delete();
+    vtkNew<vtkCellArray> polys;
+    polys->Allocate(4 * numTris);
+    vtkIdType localTri[3];
+    for (i = 0; i < numTris; ++i)
+    {
+      const vtkIdType *tri = this->Tris + 3 * triIds[i];
+      for (j = 0; j < 3; ++j)
+      {
+        localTri[j] = static_cast<vtkIdType>(
+          std::lower_bound(ptIds.begin(), ptIds.end(), tri[j]) - ptIds.begin());
+      }
+      polys->InsertNextCell(3, localTri);
+    }
 
-  // renormalize, clamp attributes
+    vtkNew<vtkPolyData> mesh;
+    mesh->SetPoints(points);
+    mesh->SetPolys(polys);
+    if (part->AttributeErrorMetric)
+    {
+      vtkPointData *inPD = this->Input->GetPointData();
+      vtkPointData *outPD = mesh->GetPointData();
+      outPD->CopyAllOn();
+      outPD->CopyAllocate(inPD, numPts);
+      for (i = 0; i < numPts; ++i)
+      {
+        outPD->CopyData(inPD, ptIds[i], i);
+      }
+    }
+
+    part->LockedPoints = &locked[0];
+    part->DecimateMesh(mesh);
+    part->LockedPoints = nullptr;
+  }
+
+private:
+  vtkPolyData *Input;
+  const vtkIdType *Tris;
+  const vtkIdType *SortedTris;
+  const vtkIdType *Offsets;
+  const unsigned char *Locked;
+  std::vector<vtkSmartPointer<vtkQuadricDecimation> > &Parts;
+  std::vector<std::vector<vtkIdType> > &PartPointIds;
+};
+
+namespace
+{
+// Sort key used to order the triangles along an axis.
+struct TriangleKey
+{
+  double Coordinate;
+  vtkIdType TriId;
+
+  bool operator<(const TriangleKey &other) const
+  {
+    return this->Coordinate < other.Coordinate;
+  }
+};
+
+// Computes the centroid coordinate of the triangles along the given axis.
+struct ComputeTriangleKeys
+{
+  vtkPoints *Points;
+  const vtkIdType *Tris;
+  int Axis;
+  TriangleKey *Keys;
+
+  void operator()(vtkIdType triBegin, vtkIdType triEnd)
+  {
+    double x[3];
+    for (vtkIdType triId = triBegin; triId < triEnd; ++triId)
+    {
+      const vtkIdType *tri = this->Tris + 3 * triId;
+      double sum = 0.0;
+      for (int j = 0; j < 3; ++j)
+      {
+        this->Points->GetPoint(tri[j], x);
+        sum += x[this->Axis];
+      }
+      this->Keys[triId].Coordinate = sum;
+      this->Keys[triId].TriId = triId;
+    }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+bool vtkQuadricDecimation::DecimatePartitions(vtkPolyData *input)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numTris = input->GetNumberOfPolys();
+  vtkIdType i, npts, *pts;
+  int j;
+
+  // Gather the triangles; bail out to the serial path on anything else.
+  std::vector<vtkIdType> tris(3 * numTris);
+  vtkCellArray *inPolys = input->GetPolys();
+  vtkIdType triId = 0;
+  for (inPolys->InitTraversal(); inPolys->GetNextCell(npts, pts); ++triId)
+  {
+    if (npts != 3)
+    {
+      return false;
+    }
+    std::copy(pts, pts + 3, &tris[3 * triId]);
+  }
+
+  vtkDebugMacro(<<"Partitioning " << numTris << " triangles into "
+                << this->NumberOfPartitions << " partitions");
+
+  // Sort the triangles along the longest axis of the bounding box and cut
+  // the sorted list into partitions with equal numbers of triangles.
+  double bounds[6];
+  input->GetPoints()->GetBounds(bounds);
+  int axis = 0;
+  for (j = 1; j < 3; ++j)
+  {
+    if ((bounds[2 * j + 1] - bounds[2 * j]) >
+        (bounds[2 * axis + 1] - bounds[2 * axis]))
+    {
+      axis = j;
+    }
+  }
+  std::vector<TriangleKey> keys(numTris);
+  ComputeTriangleKeys computeKeys = { input->GetPoints(), &tris[0], axis,
+                                      &keys[0] };
+  vtkSMPTools::For(0, numTris, computeKeys);
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  int numParts = this->NumberOfPartitions;
+  std::vector<vtkIdType> sortedTris(numTris);
+  for (i = 0; i < numTris; ++i)
+  {
+    sortedTris[i] = keys[i].TriId;
+  }
+  keys.clear();
+  std::vector<vtkIdType> offsets(numParts + 1);
+  for (j = 0; j <= numParts; ++j)
+  {
+    offsets[j] = numTris * j / numParts;
+  }
+
+  // Points used by more than one partition are locked so that the
+  // partitions still match along their common boundaries.
+  std::vector<int> owner(numPts, -1);
+  std::vector<unsigned char> locked(numPts, 0);
+  for (j = 0; j < numParts; ++j)
+  {
+    for (i = offsets[j]; i < offsets[j + 1]; ++i)
+    {
+      const vtkIdType *tri = &tris[3 * sortedTris[i]];
+      for (int k = 0; k < 3; ++k)
+      {
+        if (owner[tri[k]] < 0)
+        {
+          owner[tri[k]] = j;
+        }
+        else if (owner[tri[k]] != j)
+        {
+          locked[tri[k]] = 1;
+        }
+      }
+    }
+  }
+  owner.clear();
+  this->UpdateProgress(0.05);
+
+  // Decimate the partitions concurrently. The instances are created up front
+  // so that only the decimation itself runs in the worker threads.
+  std::vector<vtkSmartPointer<vtkQuadricDecimation> > parts(numParts);
+  for (j = 0; j < numParts; ++j)
+  {
+    vtkQuadricDecimation *part = vtkQuadricDecimation::New();
+    part->TargetReduction = this->TargetReduction;
+    part->AttributeErrorMetric = this->AttributeErrorMetric;
+    part->VolumePreservation = this->VolumePreservation;
+    part->ScalarsAttribute = this->ScalarsAttribute;
+    part->VectorsAttribute = this->VectorsAttribute;
+    part->NormalsAttribute = this->NormalsAttribute;
+    part->TCoordsAttribute = this->TCoordsAttribute;
+    part->TensorsAttribute = this->TensorsAttribute;
+    part->ScalarsWeight = this->ScalarsWeight;
+    part->VectorsWeight = this->VectorsWeight;
+    part->NormalsWeight = this->NormalsWeight;
+    part->TCoordsWeight = this->TCoordsWeight;
+    part->TensorsWeight = this->TensorsWeight;
+    parts[j].TakeReference(part);
+  }
+  std::vector<std::vector<vtkIdType> > partPointIds(numParts);
+  PartitionWorklet worklet(input, &tris[0], &sortedTris[0], &offsets[0],
+                           &locked[0], parts, partPointIds);
+  vtkSMPTools::For(0, numParts, 1, worklet);
+  this->UpdateProgress(0.6);
+
+  // Merge the decimated partitions. Locked points are shared, every other
+  // point belongs to exactly one partition.
+  vtkNew<vtkPoints> points;
+  points->SetDataType(input->GetPoints()->GetDataType());
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkPolyData> merged;
+  vtkPointData *mergedPD = merged->GetPointData();
   if (this->AttributeErrorMetric)
   {
-    if (nullptr != (attrib = output->GetPointData()->GetNormals()))
+    mergedPD->CopyAllOn();
+    mergedPD->CopyAllocate(parts[0]->Mesh->GetPointData());
+  }
+  std::vector<vtkIdType> lockedMap(numPts, -1);
+  std::vector<vtkIdType> localMap;
+  vtkIdType mergedTri[3];
+  for (j = 0; j < numParts; ++j)
+  {
+    vtkPolyData *mesh = parts[j]->Mesh;
+    const std::vector<vtkIdType> &ptIds = partPointIds[j];
+    localMap.assign(ptIds.size(), -1);
+
+    vtkCellArray *meshPolys = mesh->GetPolys();
+    vtkIdType cellId = 0;
+    for (meshPolys->InitTraversal(); meshPolys->GetNextCell(npts, pts);
+         ++cellId)
     {
-      for (i = 0; i < attrib->GetNumberOfTuples(); i++)
+      if (mesh->GetCellType(cellId) == VTK_EMPTY_CELL)
       {
-        vtkMath::Normalize(attrib->GetTuple3(i));
+        continue;
       }
+      for (int k = 0; k < 3; ++k)
+      {
+        vtkIdType globalId = ptIds[pts[k]];
+        vtkIdType &mergedId = locked[globalId] ? lockedMap[globalId] :
+                                                 localMap[pts[k]];
+        if (mergedId < 0)
+        {
+          mergedId = points->InsertNextPoint(mesh->GetPoint(pts[k]));
+          if (this->AttributeErrorMetric)
+          {
+            mergedPD->CopyData(mesh->GetPointData(), pts[k], mergedId);
+          }
+        }
+        mergedTri[k] = mergedId;
+      }
+      polys->InsertNextCell(3, mergedTri);
     }
-    // might want to add clamping texture coordinates??
+
+    mesh->DeleteLinks();
+    mesh->Delete();
+    parts[j]->Mesh = nullptr;
+  }
+  merged->SetPoints(points);
+  merged->SetPolys(polys);
+  merged->GetFieldData()->PassData(input->GetFieldData());
+  parts.clear();
+  partPointIds.clear();
+
+  // The seam pass: collapse the remaining edges (mostly those along the
+  // partition boundaries) until the overall target reduction is met.
+  vtkIdType numMergedTris = polys->GetNumberOfCells();
+  double targetReduction = this->TargetReduction;
+  double seamReduction = 0.0;
+  if (numMergedTris > 0)
+  {
+    seamReduction = 1.0 - (1.0 - targetReduction) * numTris / numMergedTris;
+    seamReduction = std::max(0.0, seamReduction);
   }
+  vtkDebugMacro(<<"Seam pass on " << numMergedTris << " triangles");
+  this->TargetReduction = seamReduction;
+  this->DecimateMesh(merged);
+  this->TargetReduction = targetReduction;
 
-  return 1;
+  vtkIdType numRemainingTris = static_cast<vtkIdType>(
+    (1.0 - this->ActualReduction) * numMergedTris + 0.5);
+  this->ActualReduction = 1.0 - static_cast<double>(numRemainingTris) / numTris;
+
+  return true;
 }
 
 //----------------------------------------------------------------------------
@@ -916,6 +1274,13 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double *x)
     }
   }
 
+  // Edges touching a locked point must not be collapsed.
+  if (this->LockedPoints && (this->LockedPoints[pointIds[0]] ||
+                             this->LockedPoints[pointIds[1]]))
+  {
+    cost = VTK_DOUBLE_MAX;
+  }
+
   return cost;
 }
 
@@ -1159,6 +1524,13 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
 
   cost += this->TempQuad[9];
 
+  // Edges touching a locked point must not be collapsed.
+  if (this->LockedPoints && (this->LockedPoints[pointIds[0]] ||
+                             this->LockedPoints[pointIds[1]]))
+  {
+    cost = VTK_DOUBLE_MAX;
+  }
+
   return cost;
 }
 
@@ -1433,6 +1805,7 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Target Reduction: " << this->TargetReduction << "\n";
   os << indent << "Actual Reduction: " << this->ActualReduction << "\n";
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
 
   os << indent << "Attribute Error Metric: "
      << (this->AttributeErrorMetric ? "On\n" : "Off\n");
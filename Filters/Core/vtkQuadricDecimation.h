@@ -48,6 +48,15 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * For large meshes a parallel mode is available (see NumberOfPartitions).
+ * The triangles are split into spatially coherent partitions which are
+ * decimated concurrently (via vtkSMPTools). Points shared between partitions
+ * are locked so that the partitions stay watertight along their seams. The
+ * partial results are then merged and a final serial pass collapses the
+ * remaining edges (including those along the seams) until the requested
+ * reduction is reached. The result is close to, but not identical to, the
+ * output of the serial algorithm.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -148,6 +157,18 @@ public:
   vtkGetMacro(TensorsWeight, double);
   //@}
 
+  //@{
+  /**
+   * Set/Get the number of spatial partitions used to decimate the mesh in
+   * parallel. A value of 1 (the default) selects the serial algorithm. Larger
+   * values split the mesh into that many partitions which are decimated
+   * concurrently before a final seam-collapsing pass; a small multiple of the
+   * number of threads is a good choice.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  //@}
+
   //@{
   /**
    * Get the actual reduction. This value is only valid after the
@@ -162,6 +183,21 @@ protected:
 
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *) override;
 
+  /**
+   * Run the serial decimation algorithm on the triangles of input. The
+   * result is left in the working mesh (Mesh), in which collapsed triangles
+   * are marked as empty cells.
+   */
+  void DecimateMesh(vtkPolyData *input);
+
+  /**
+   * Decimate the partitions of input concurrently, merge them and run the
+   * seam-collapsing pass. As with DecimateMesh() the result is left in
+   * Mesh. Returns false (and does nothing) if the input contains
+   * non-triangular polygons.
+   */
+  bool DecimatePartitions(vtkPolyData *input);
+
   /**
    * Do the dirty work of eliminating the edge; return the number of
    * triangles deleted.
@@ -232,6 +268,7 @@ protected:
 
   double TargetReduction;
   double ActualReduction;
+  int NumberOfPartitions;
   vtkTypeBool   AttributeErrorMetric;
   vtkTypeBool   VolumePreservation;
 
@@ -278,9 +315,15 @@ protected:
   double **TempA;
   double *TempData;
 
+  // Optional per-point flags; edges touching a locked point are never
+  // collapsed. Used when decimating partitions.
+  const unsigned char *LockedPoints;
+
 private:
   vtkQuadricDecimation(const vtkQuadricDecimation&) = delete;
   void operator=(const vtkQuadricDecimation&) = delete;
+
+  class PartitionWorklet;
 };
 
 #endif
@@ -21,14 +21,20 @@
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmoothingStencil.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
 
@@ -130,6 +136,8 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 
+  this->JacobiSmoothing = 0;
+
   this->SmoothPoints = nullptr;
 
   // optional second input
@@ -151,25 +159,8 @@ vtkPolyData *vtkSmoothPolyDataFilter::GetSource()
     this->GetExecutive()->GetInputData(1, 0));
 }
 
-#define VTK_SIMPLE_VERTEX 0
-#define VTK_FIXED_VERTEX 1
-#define VTK_FEATURE_EDGE_VERTEX 2
-#define VTK_BOUNDARY_EDGE_VERTEX 3
-
 namespace {
 
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
-{
-  char      type;
-  vtkIdList *edges; // connected edges (list of connected point ids)
-  _vtkMeshVertex()
-  {
-    type = VTK_SIMPLE_VERTEX; //can smooth
-    edges = nullptr;
-  }
-} vtkMeshVertex, *vtkMeshVertexPtr;
-
 template<typename T> struct vtkSPDF_InternalParams
 {
   vtkSmoothPolyDataFilter* spdf;
@@ -178,15 +169,137 @@ template<typename T> struct vtkSPDF_InternalParams
   T factor;
   T conv;
   vtkIdType numPts;
-  vtkMeshVertexPtr vertexPtr;
+  const vtkSmoothingStencil *stencil;
   vtkPolyData *source;
   vtkSmoothPoints *SmoothPoints;
   double *w;
   vtkCellLocator *cellLocator;
 };
 
-template<typename T> void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
+// Move point i toward the mean position of its connected neighbors, read
+// from positions, and write its new position to x. Returns the norm of the
+// cumulated neighbor positions, which is used for the convergence test.
+template<typename T> T vtkSPDF_MovePoint(vtkSPDF_InternalParams<T>& params, vtkIdType i,
+                                         const T *positions, T *x)
 {
+  const vtkSmoothingStencil *stencil = params.stencil;
+  vtkIdType npts = stencil->GetNumberOfEdges(i);
+  const T *xOld = positions + 3*i;
+  if (stencil->Types[i] == VTK_FIXED_VERTEX || npts <= 0)
+  {
+    x[0] = xOld[0];
+    x[1] = xOld[1];
+    x[2] = xOld[2];
+    return 0.0;
+  }
+
+  // Compute the mean (cumulated) direction vector
+  T deltaX[3] = { 0.0, 0.0, 0.0 };
+  const vtkIdType *edgeIdPtr = stencil->GetEdges(i);
+  for (vtkIdType j = 0; j < npts; ++j)
+  {
+    const T *y = positions + 3*edgeIdPtr[j];
+    deltaX[0] += y[0];
+    deltaX[1] += y[1];
+    deltaX[2] += y[2];
+  }
+
+  // Move the point
+  double xNew[3];
+  for (int k = 0; k < 3; ++k)
+  {
+    x[k] = xOld[k] + params.factor * (deltaX[k] / npts - xOld[k]);
+    xNew[k] = x[k];
+  }
+
+  // Constrain point to surface
+  if (params.source)
+  {
+    vtkSmoothPoint *sPtr = params.SmoothPoints->GetSmoothPoint(i);
+    vtkCell *cell = nullptr;
+    double dist2, closestPt[3];
+
+    if (sPtr->cellId >= 0) //in cell
+    {
+      cell = params.source->GetCell(sPtr->cellId);
+    }
+
+    if (!cell || cell->EvaluatePosition(xNew, closestPt,
+        sPtr->subId, sPtr->p, dist2, params.w) == 0)
+    { // not in cell anymore
+      params.cellLocator->FindClosestPoint(xNew, closestPt, sPtr->cellId,
+                                           sPtr->subId, dist2);
+    }
+    for (int k = 0; k < 3; ++k)
+    {
+      x[k] = static_cast<T>(closestPt[k]);
+    }
+  }
+
+  return vtkMath::Norm(deltaX);
+}
+
+// One Jacobi pass: every point is moved using the positions of the previous
+// pass, so the points can be moved in parallel.
+template<typename T> struct vtkSPDF_JacobiPass
+{
+  vtkSPDF_InternalParams<T> *Params;
+  const T *Positions;
+  T *NewPositions;
+  vtkSMPThreadLocal<T> LocalMaxDist;
+  T MaxDist;
+
+  void Initialize()
+  {
+    this->LocalMaxDist.Local() = 0.0;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    T &maxDist = this->LocalMaxDist.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      T dist = vtkSPDF_MovePoint(*this->Params, i, this->Positions,
+                                 this->NewPositions + 3*i);
+      if (dist > maxDist)
+      {
+        maxDist = dist;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->MaxDist = 0.0;
+    for (typename vtkSMPThreadLocal<T>::iterator iter = this->LocalMaxDist.begin();
+         iter != this->LocalMaxDist.end(); ++iter)
+    {
+      if (*iter > this->MaxDist)
+      {
+        this->MaxDist = *iter;
+      }
+    }
+  }
+};
+
+// By default the points are updated in place (Gauss-Seidel: each point is
+// moved using the new positions of the points that precede it), so the
+// iterations are serial. With Jacobi updates the iterations alternate
+// between two buffers and each one runs in parallel, unless the points are
+// constrained to a source, since the cell locator is not thread safe.
+template<typename T> void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params,
+                                             bool jacobi)
+{
+  T *start = static_cast<T*>(params.newPts->GetVoidPointer(0));
+  std::vector<T> buffer;
+  T *positions = start;
+  T *newPositions = start;
+  if (jacobi)
+  {
+    buffer.resize(3*params.numPts);
+    newPositions = buffer.data();
+  }
+
   int iterationNumber = 0;
   for (T maxDist = std::numeric_limits<T>::max();
        maxDist > params.conv && iterationNumber < params.numberOfIterations;
@@ -201,81 +314,45 @@ template<typename T> void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
       }
     }
 
-    maxDist = 0.0;
-    T* newPtsCoords = static_cast<T*>(params.newPts->GetVoidPointer(0));
-    T* start = newPtsCoords;
-    vtkMeshVertexPtr vertsPtr = params.vertexPtr;
-    vtkIdType npts, *edgeIdPtr;
-    T dist, deltaX[3];
-    double dist2, xNew[3], closestPt[3];
+    if (jacobi)
+    {
+      vtkSPDF_JacobiPass<T> pass;
+      pass.Params = &params;
+      pass.Positions = positions;
+      pass.NewPositions = newPositions;
+      if (params.source)
+      {
+        pass.Initialize();
+        pass(0, params.numPts);
+        pass.Reduce();
+      }
+      else
+      {
+        vtkSMPTools::For(0, params.numPts, pass);
+      }
+      maxDist = pass.MaxDist;
+      std::swap(positions, newPositions);
+      continue;
+    }
 
     // For each non-fixed vertex of the mesh, move the point toward the mean
     // position of its connected neighbors using the relaxation factor.
+    maxDist = 0.0;
     for (vtkIdType i = 0; i < params.numPts; ++i)
     {
-      if (vertsPtr->type != VTK_FIXED_VERTEX && vertsPtr->edges != nullptr &&
-         (npts = vertsPtr->edges->GetNumberOfIds()) > 0)
+      T dist = vtkSPDF_MovePoint(params, i, start, start + 3*i);
+      if (dist > maxDist)
       {
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-        edgeIdPtr = vertsPtr->edges->GetPointer(0);
-        // Compute the mean (cumulated) direction vector
-        for (vtkIdType j = 0; j < npts; ++j)
-        {
-          for (unsigned short k = 0; k < 3; ++k)
-          {
-            deltaX[k] += *(start + 3 * (*edgeIdPtr) + k);
-          }
-          ++edgeIdPtr;
-        }//for all connected points
-
-        // Move the point
-        *newPtsCoords += params.factor * (deltaX[0] / npts - (*newPtsCoords));
-        xNew[0] = *newPtsCoords;
-        ++newPtsCoords;
-        *newPtsCoords += params.factor * (deltaX[1] / npts - (*newPtsCoords));
-        xNew[1] = *newPtsCoords;
-        ++newPtsCoords;
-        *newPtsCoords += params.factor * (deltaX[2] / npts - (*newPtsCoords));
-        xNew[2] = *newPtsCoords;
-        ++newPtsCoords;
-
-        // Constrain point to surface
-        if (params.source)
-        {
-          vtkSmoothPoint *sPtr = params.SmoothPoints->GetSmoothPoint(i);
-          vtkCell *cell = nullptr;
-
-          if (sPtr->cellId >= 0) //in cell
-          {
-            cell = params.source->GetCell(sPtr->cellId);
-          }
-
-          if (!cell || cell->EvaluatePosition(xNew, closestPt,
-              sPtr->subId, sPtr->p, dist2, params.w) == 0)
-          { // not in cell anymore
-            params.cellLocator->FindClosestPoint(xNew, closestPt, sPtr->cellId,
-                                                 sPtr->subId, dist2);
-          }
-          for (int k = 0; k < 3; ++k)
-          {
-            xNew[k] = closestPt[k];
-          }
-          params.newPts->SetPoint(i, xNew);
-        }
-
-        if ((dist = vtkMath::Norm(deltaX)) > maxDist)
-        {
-          maxDist = dist;
-        }
-      }//if can move point
-      else
-      {
-        newPtsCoords += 3;
+        maxDist = dist;
       }
-      ++vertsPtr;
     }//for all points
   }//for not converged or within iteration count
 
+  if (positions != start)
+  {
+    std::copy(positions, positions + 3*params.numPts, start);
+  }
+
   vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
 }
 
@@ -303,23 +380,19 @@ int vtkSmoothPolyDataFilter::RequestData(
   vtkPolyData *output = vtkPolyData::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts, numCells, i, numPolys, numStrips;
+  vtkIdType numPts, numCells, i, numStrips;
   int j, k;
   vtkIdType npts = 0;
   vtkIdType *pts = nullptr;
-  vtkIdType p1, p2;
   double conv;
   double x1[3], x2[3], x3[3], l1[3], l2[3];
   double CosFeatureAngle; //Cosine of angle between adjacent polys
   double CosEdgeAngle; // Cosine of angle between adjacent edges
   double closestPt[3], dist2, *w = nullptr;
   vtkIdType numSimple=0, numBEdges=0, numFixed=0, numFEdges=0;
-  vtkPolyData *inMesh, *Mesh;
   vtkPoints *inPts;
-  vtkTriangleFilter *toTris=nullptr;
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints *newPts;
-  vtkMeshVertexPtr Verts;
   vtkCellLocator *cellLocator=nullptr;
 
   // Check input
@@ -362,7 +435,9 @@ int vtkSmoothPolyDataFilter::RequestData(
   // using a subset of the attached vertices.
   //
   vtkDebugMacro(<<"Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
+  std::vector<char> lineTypes(numPts, VTK_SIMPLE_VERTEX);
+  std::vector<vtkIdType> lineEdges;
+  vtkSmoothingStencil stencil;
 
   inPts = input->GetPoints();
   conv = this->Convergence * input->GetLength();
@@ -373,44 +448,38 @@ int vtkSmoothPolyDataFilter::RequestData(
   {
     for (j=0; j<npts; j++)
     {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      lineTypes[pts[j]] = VTK_FIXED_VERTEX;
     }
   }
   this->UpdateProgress(0.10);
 
   // now check lines. Only manifold lines can be smoothed------------
-  for (inLines=input->GetLines(), inLines->InitTraversal();
-  inLines->GetNextCell(npts,pts); )
+  inLines=input->GetLines();
+  if ( inLines->GetNumberOfCells() > 0 )
+  {
+    lineEdges.resize(2*numPts);
+  }
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts,pts); )
   {
     for (j=0; j<npts; j++)
     {
-      if ( Verts[pts[j]].type == VTK_SIMPLE_VERTEX )
+      if ( lineTypes[pts[j]] == VTK_SIMPLE_VERTEX )
       {
-        if ( j == (npts-1) ) //end-of-line marked FIXED
+        if ( j == (npts-1) || j == 0 ) //end-of-line marked FIXED
         {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        }
-        else if ( j == 0 ) //beginning-of-line marked FIXED
-        {
-          Verts[pts[0]].type = VTK_FIXED_VERTEX;
-          inPts->GetPoint(pts[0],x2);
-          inPts->GetPoint(pts[1],x3);
+          lineTypes[pts[j]] = VTK_FIXED_VERTEX;
         }
         else //is edge vertex (unless already edge vertex!)
         {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          Verts[pts[j]].edges->SetId(0,pts[j-1]);
-          Verts[pts[j]].edges->SetId(1,pts[j+1]);
+          lineTypes[pts[j]] = VTK_FEATURE_EDGE_VERTEX;
+          lineEdges[2*pts[j]] = pts[j-1];
+          lineEdges[2*pts[j]+1] = pts[j+1];
         }
       } //if simple vertex
 
-      else if ( Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX )
+      else if ( lineTypes[pts[j]] == VTK_FEATURE_EDGE_VERTEX )
       { //multiply connected, becomes fixed!
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = nullptr;
+        lineTypes[pts[j]] = VTK_FIXED_VERTEX;
       }
 
     } //for all points in this line
@@ -419,183 +488,65 @@ int vtkSmoothPolyDataFilter::RequestData(
 
   // now polygons and triangle strips-------------------------------
   inPolys=input->GetPolys();
-  numPolys = inPolys->GetNumberOfCells();
   inStrips=input->GetStrips();
   numStrips = inStrips->GetNumberOfCells();
 
-  if ( numPolys > 0 || numStrips > 0 )
-  { //build cell structure
-    vtkCellArray *polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    vtkIdType *neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList *neighbors;
-
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
-
-    inMesh = vtkPolyData::New();
-    inMesh->SetPoints(inPts);
-    inMesh->SetPolys(inPolys);
-    Mesh = inMesh;
-
-    if ( (numStrips = inStrips->GetNumberOfCells()) > 0 )
-    { // convert data to triangles
-      inMesh->SetStrips(inStrips);
-      toTris = vtkTriangleFilter::New();
-      toTris->SetInputData(inMesh);
-      toTris->Update();
-      Mesh = toTris->GetOutput();
-    }
-
-    Mesh->BuildLinks(); //to do neighborhood searching
-    polys = Mesh->GetPolys();
-    this->UpdateProgress(0.375);
-
-    for (cellId=0, polys->InitTraversal(); polys->GetNextCell(npts,pts);
-    cellId++)
-    {
-      for (i=0; i < npts; i++)
-      {
-        p1 = pts[i];
-        p2 = pts[(i+1)%npts];
-
-        if ( Verts[p1].edges == nullptr )
-        {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16,6);
-        }
-        if ( Verts[p2].edges == nullptr )
-        {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16,6);
-        }
-
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if ( numNei == 0 )
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if ( numNei >= 2 )
-        {
-          // check to make sure that this edge hasn't been marked already
-          for (j=0; j < numNei; j++)
-          {
-            if ( neighbors->GetId(j) < cellId )
-            {
-              break;
-            }
-          }
-          if ( j >= numNei )
-          {
-            edge = VTK_FEATURE_EDGE_VERTEX;
-          }
-        }
-
-        else if ( numNei == 1 && (nei=neighbors->GetId(0)) > cellId )
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts,npts,pts,normal);
-            Mesh->GetCellPoints(nei,numNeiPts,neiPts);
-            vtkPolygon::ComputeNormal(inPts,numNeiPts,neiPts,neiNormal);
-
-            if (vtkMath::Dot(normal,neiNormal) <= CosFeatureAngle)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
-        {
-          continue;
-        }
-
-        if ( edge && Verts[p1].type == VTK_SIMPLE_VERTEX )
-        {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-        }
-        else if ( (edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-        (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX ) )
-        {
-          Verts[p1].edges->InsertNextId(p2);
-          if ( Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
-          {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-
-        if ( edge && Verts[p2].type == VTK_SIMPLE_VERTEX )
-        {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-        }
-        else if ( (edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX ) ||
-        (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX ) )
-        {
-          Verts[p2].edges->InsertNextId(p1);
-          if ( Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
-          {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-      }
-    }
-
-    inMesh->Delete();
-    if (toTris) {toTris->Delete();}
-
-    neighbors->Delete();
-  }//if strips or polys
+  // Polygon edges are classified in parallel by sorting the edge uses,
+  // rather than by searching cell neighbors through the links.
+  vtkNew<vtkPolyData> inMesh;
+  inMesh->SetPoints(inPts);
+  inMesh->SetPolys(inPolys);
+  vtkPolyData *Mesh = inMesh.GetPointer();
+  vtkNew<vtkTriangleFilter> toTris;
+  if ( numStrips > 0 )
+  { // convert data to triangles
+    inMesh->SetStrips(inStrips);
+    toTris->SetInputData(inMesh.GetPointer());
+    toTris->Update();
+    Mesh = toTris->GetOutput();
+  }
+  this->UpdateProgress(0.375);
 
+  stencil.Build(Mesh, numPts, lineTypes, lineEdges,
+                this->FeatureEdgeSmoothing != 0, CosFeatureAngle, false);
   this->UpdateProgress(0.50);
 
   //post-process edge vertices to make sure we can smooth them
   for (i=0; i<numPts; i++)
   {
-    if ( Verts[i].type == VTK_SIMPLE_VERTEX )
+    char& type = stencil.Types[i];
+    if ( type == VTK_SIMPLE_VERTEX )
     {
       numSimple++;
     }
 
-    else if ( Verts[i].type == VTK_FIXED_VERTEX )
+    else if ( type == VTK_FIXED_VERTEX )
     {
       numFixed++;
     }
 
-    else if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX ||
-    Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
+    else if ( type == VTK_FEATURE_EDGE_VERTEX ||
+    type == VTK_BOUNDARY_EDGE_VERTEX )
     { //see how many edges; if two, what the angle is
 
       if ( !this->BoundarySmoothing &&
-      Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
+      type == VTK_BOUNDARY_EDGE_VERTEX )
       {
-        Verts[i].type = VTK_FIXED_VERTEX;
+        type = VTK_FIXED_VERTEX;
         numBEdges++;
       }
 
-      else if ( (npts = Verts[i].edges->GetNumberOfIds()) != 2 )
+      else if ( stencil.GetNumberOfEdges(i) != 2 )
       {
-        Verts[i].type = VTK_FIXED_VERTEX;
+        type = VTK_FIXED_VERTEX;
         numFixed++;
       }
 
       else //check angle between edges
       {
-        inPts->GetPoint(Verts[i].edges->GetId(0),x1);
+        inPts->GetPoint(stencil.GetEdges(i)[0],x1);
         inPts->GetPoint(i,x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1),x3);
+        inPts->GetPoint(stencil.GetEdges(i)[1],x3);
 
         for (k=0; k<3; k++)
         {
@@ -607,11 +558,11 @@ int vtkSmoothPolyDataFilter::RequestData(
              vtkMath::Dot(l1,l2) < CosEdgeAngle)
         {
           numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
+          type = VTK_FIXED_VERTEX;
         }
         else
         {
-          if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX )
+          if ( type == VTK_FEATURE_EDGE_VERTEX )
           {
             numFEdges++;
           }
@@ -683,19 +634,19 @@ int vtkSmoothPolyDataFilter::RequestData(
   {
     vtkSPDF_InternalParams<double> params = { this, this->NumberOfIterations, newPts,
                                               this->RelaxationFactor, conv, numPts,
-                                              Verts, source, this->SmoothPoints,
+                                              &stencil, source, this->SmoothPoints,
                                               w, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    vtkSPDF_MovePoints(params, this->JacobiSmoothing != 0);
   }
   else
   {
     vtkSPDF_InternalParams<float> params = { this, this->NumberOfIterations, newPts,
                                              static_cast<float>(this->RelaxationFactor),
-                                             static_cast<float>(conv), numPts, Verts,
+                                             static_cast<float>(conv), numPts, &stencil,
                                              source, this->SmoothPoints, w, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    vtkSPDF_MovePoints(params, this->JacobiSmoothing != 0);
   }
 
   if ( source )
@@ -753,17 +704,6 @@ int vtkSmoothPolyDataFilter::RequestData(
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  //free up connectivity storage
-  for (i=0; i<numPts; i++)
-  {
-    if ( Verts[i].edges != nullptr )
-    {
-      Verts[i].edges->Delete();
-      Verts[i].edges = nullptr;
-    }
-  }
-  delete [] Verts;
-
   return 1;
 }
 
@@ -805,4 +745,5 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Jacobi Smoothing: " << (this->JacobiSmoothing ? "On\n" : "Off\n");
 }
@@ -32,7 +32,9 @@
  * relaxation factor is available to control the amount of displacement of
  * v).  The process repeats for each vertex. This pass over the list of
  * vertices is a single iteration. Many iterations (generally around 20 or
- * so) are repeated until the desired result is obtained.
+ * so) are repeated until the desired result is obtained. (The analysis
+ * of the mesh connectivity is threaded with vtkSMPTools. The iterations
+ * move the vertices in place and are serial, unless JacobiSmoothing is on.)
  *
  * There are some special instance variables used to control the execution
  * of this filter. (These ivars basically control what vertices can be
@@ -215,6 +217,21 @@ public:
   vtkGetMacro(OutputPointsPrecision,int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off Jacobi updates. When on, each iteration moves every vertex
+   * using the positions of the previous iteration, which are kept in a
+   * second buffer, so the vertices are moved in parallel with vtkSMPTools
+   * (serially if a Source is set). When off (the default), the vertices are
+   * moved in place one after the other, so each one sees the new positions
+   * of the vertices before it; this converges a little faster, but cannot
+   * be threaded. The two give slightly different results.
+   */
+  vtkSetMacro(JacobiSmoothing,vtkTypeBool);
+  vtkGetMacro(JacobiSmoothing,vtkTypeBool);
+  vtkBooleanMacro(JacobiSmoothing,vtkTypeBool);
+  //@}
+
 protected:
   vtkSmoothPolyDataFilter();
   ~vtkSmoothPolyDataFilter() override {}
@@ -232,6 +249,7 @@ protected:
   vtkTypeBool GenerateErrorScalars;
   vtkTypeBool GenerateErrorVectors;
   int OutputPointsPrecision;
+  vtkTypeBool JacobiSmoothing;
 
   vtkSmoothPoints *SmoothPoints;
 private:
@@ -0,0 +1,355 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSmoothingStencil.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSmoothingStencil.h"
+
+#include "vtkCellArray.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+
+namespace {
+
+// A polygon edge (V0,V1), V0 < V1, used by cell CellId at local position
+// Pos. Sorting brings all uses of an edge together, ordered by cell id.
+struct EdgeUse
+{
+  vtkIdType V0;
+  vtkIdType V1;
+  vtkIdType CellId;
+  vtkIdType Pos;
+
+  bool operator<(const EdgeUse& e) const
+  {
+    if ( this->V0 != e.V0 )
+    {
+      return this->V0 < e.V0;
+    }
+    if ( this->V1 != e.V1 )
+    {
+      return this->V1 < e.V1;
+    }
+    if ( this->CellId != e.CellId )
+    {
+      return this->CellId < e.CellId;
+    }
+    return this->Pos < e.Pos;
+  }
+};
+
+// A connection from a point to Nei contributed by the classified edge at
+// (CellId,Pos). Links are sorted per point in cell traversal order.
+struct VertexLink
+{
+  vtkIdType Nei;
+  vtkIdType CellId;
+  vtkIdType Pos;
+  char Type;
+
+  bool operator<(const VertexLink& l) const
+  {
+    return ( this->CellId < l.CellId ||
+             (this->CellId == l.CellId && this->Pos < l.Pos) );
+  }
+};
+
+// Generate the edge uses of each polygon.
+struct GenerateEdgeUses
+{
+  const vtkIdType *Conn;
+  const vtkIdType *CellLoc;
+  EdgeUse *Uses;
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    for ( ; cellId < endCellId; ++cellId)
+    {
+      vtkIdType loc = this->CellLoc[cellId];
+      vtkIdType npts = this->Conn[loc];
+      const vtkIdType *pts = this->Conn + loc + 1;
+      // Each cell stores its size ahead of its point ids
+      EdgeUse *use = this->Uses + (loc - cellId);
+      for (vtkIdType i=0; i < npts; ++i, ++use)
+      {
+        vtkIdType p1 = pts[i];
+        vtkIdType p2 = pts[(i+1)%npts];
+        use->V0 = (p1 < p2 ? p1 : p2);
+        use->V1 = (p1 < p2 ? p2 : p1);
+        use->CellId = cellId;
+        use->Pos = i;
+      }
+    }
+  }
+};
+
+// Compute polygon normals for the feature angle test.
+struct ComputeNormals
+{
+  vtkPoints *Points;
+  vtkIdType *Conn;
+  const vtkIdType *CellLoc;
+  double *Normals;
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    for ( ; cellId < endCellId; ++cellId)
+    {
+      vtkIdType loc = this->CellLoc[cellId];
+      vtkPolygon::ComputeNormal(this->Points, static_cast<int>(this->Conn[loc]),
+                                this->Conn + loc + 1, this->Normals + 3*cellId);
+    }
+  }
+};
+
+// Classify each edge from its uses. Only the use from the lowest cell id
+// contributes to the stencil (-1 marks the others), matching a serial
+// traversal that skips edges already visited from a neighboring cell.
+// With non-manifold smoothing, every use of a non-manifold edge
+// contributes as a simple edge.
+struct ClassifyEdges
+{
+  const EdgeUse *Uses;
+  const vtkIdType *EdgeStart;
+  const double *Normals;
+  double CosFeatureAngle;
+  bool NonManifoldSmoothing;
+  char *UseType;
+
+  void operator()(vtkIdType edgeId, vtkIdType endEdgeId)
+  {
+    for ( ; edgeId < endEdgeId; ++edgeId)
+    {
+      vtkIdType first = this->EdgeStart[edgeId];
+      vtkIdType last = this->EdgeStart[edgeId+1];
+      vtkIdType numCells = 1;
+      for (vtkIdType u=first+1; u < last; ++u)
+      {
+        this->UseType[u] = -1;
+        if ( this->Uses[u].CellId != this->Uses[u-1].CellId )
+        {
+          numCells++;
+        }
+      }
+
+      char edge = VTK_SIMPLE_VERTEX;
+      if ( numCells == 1 )
+      {
+        edge = VTK_BOUNDARY_EDGE_VERTEX;
+      }
+      else if ( numCells > 2 )
+      {
+        if ( this->NonManifoldSmoothing )
+        {
+          std::fill(this->UseType + first, this->UseType + last,
+                    static_cast<char>(VTK_SIMPLE_VERTEX));
+          continue;
+        }
+        edge = VTK_FEATURE_EDGE_VERTEX;
+      }
+      else if ( this->Normals )
+      {
+        const double *n0 = this->Normals + 3*this->Uses[first].CellId;
+        const double *n1 = this->Normals + 3*this->Uses[last-1].CellId;
+        if ( vtkMath::Dot(n0,n1) <= this->CosFeatureAngle )
+        {
+          edge = VTK_FEATURE_EDGE_VERTEX;
+        }
+      }
+      this->UseType[first] = edge;
+    }
+  }
+};
+
+// Resolve the type and smoothing neighbors of each point from its links.
+// Special (feature or boundary) edges take precedence over simple ones;
+// the first pass counts, the second fills the stencil.
+struct ResolveVertices
+{
+  const char *LineTypes;
+  const vtkIdType *LineEdges;
+  const vtkIdType *LinkOffsets;
+  VertexLink *Links;
+  vtkSmoothingStencil *Stencil;
+  bool Fill;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkSmoothingStencil *stencil = this->Stencil;
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      char type = this->LineTypes[ptId];
+      VertexLink *links = this->Links + this->LinkOffsets[ptId];
+      VertexLink *linksEnd = this->Links + this->LinkOffsets[ptId+1];
+      if ( !this->Fill )
+      {
+        std::sort(links, linksEnd);
+      }
+
+      vtkIdType numSpecial=0;
+      bool boundary = false;
+      for (VertexLink *l=links; l != linksEnd; ++l)
+      {
+        if ( l->Type != VTK_SIMPLE_VERTEX )
+        {
+          numSpecial++;
+          boundary = boundary || l->Type == VTK_BOUNDARY_EDGE_VERTEX;
+        }
+      }
+
+      vtkIdType numLineEdges = ( type == VTK_FEATURE_EDGE_VERTEX ? 2 : 0 );
+      bool special = ( numLineEdges > 0 || numSpecial > 0 );
+      if ( type == VTK_FIXED_VERTEX )
+      {
+        links = linksEnd;
+      }
+      else if ( numSpecial > 0 || numLineEdges > 0 )
+      {
+        type = ( boundary ? VTK_BOUNDARY_EDGE_VERTEX : VTK_FEATURE_EDGE_VERTEX );
+      }
+
+      if ( !this->Fill )
+      {
+        stencil->Types[ptId] = type;
+        stencil->Offsets[ptId] = ( type == VTK_FIXED_VERTEX ? 0 :
+          (special ? numLineEdges + numSpecial : linksEnd - links) );
+        continue;
+      }
+
+      vtkIdType *edges = stencil->Conn.data() + stencil->Offsets[ptId];
+      if ( numLineEdges > 0 )
+      {
+        *edges++ = this->LineEdges[2*ptId];
+        *edges++ = this->LineEdges[2*ptId+1];
+      }
+      for (VertexLink *l=links; l != linksEnd; ++l)
+      {
+        if ( !special || l->Type != VTK_SIMPLE_VERTEX )
+        {
+          *edges++ = l->Nei;
+        }
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+void vtkSmoothingStencil::Build(vtkPolyData *mesh, vtkIdType numPts,
+                                const std::vector<char>& lineTypes,
+                                const std::vector<vtkIdType>& lineEdges,
+                                bool featureEdgeSmoothing, double cosFeatureAngle,
+                                bool nonManifoldSmoothing)
+{
+  vtkCellArray *polys = mesh->GetPolys();
+  vtkIdType numPolys = polys->GetNumberOfCells();
+  vtkIdType *conn = polys->GetPointer();
+
+  // Random access into the polygon connectivity
+  std::vector<vtkIdType> cellLoc(numPolys);
+  vtkIdType loc = 0;
+  for (vtkIdType cellId=0; cellId < numPolys; ++cellId)
+  {
+    cellLoc[cellId] = loc;
+    loc += conn[loc] + 1;
+  }
+  vtkIdType numUses = loc - numPolys;
+
+  // Sort the edge uses so that the uses of each edge are contiguous
+  std::vector<EdgeUse> uses(numUses);
+  GenerateEdgeUses generate = { conn, cellLoc.data(), uses.data() };
+  vtkSMPTools::For(0, numPolys, generate);
+  vtkSMPTools::Sort(uses.begin(), uses.end());
+
+  std::vector<vtkIdType> edgeStart;
+  edgeStart.reserve(numUses/2 + 1);
+  for (vtkIdType u=0; u < numUses; ++u)
+  {
+    if ( u == 0 || uses[u].V0 != uses[u-1].V0 || uses[u].V1 != uses[u-1].V1 )
+    {
+      edgeStart.push_back(u);
+    }
+  }
+  vtkIdType numEdges = static_cast<vtkIdType>(edgeStart.size());
+  edgeStart.push_back(numUses);
+
+  std::vector<double> normals;
+  if ( featureEdgeSmoothing )
+  {
+    normals.resize(3*numPolys);
+    ComputeNormals computeNormals =
+      { mesh->GetPoints(), conn, cellLoc.data(), normals.data() };
+    vtkSMPTools::For(0, numPolys, computeNormals);
+  }
+
+  std::vector<char> useType(numUses);
+  ClassifyEdges classify = { uses.data(), edgeStart.data(),
+    (featureEdgeSmoothing ? normals.data() : nullptr), cosFeatureAngle,
+    nonManifoldSmoothing, useType.data() };
+  vtkSMPTools::For(0, numEdges, classify);
+
+  // Bucket the classified edges by point (a counting sort)
+  std::vector<vtkIdType> linkOffsets(numPts+1, 0);
+  for (vtkIdType u=0; u < numUses; ++u)
+  {
+    if ( useType[u] >= 0 )
+    {
+      linkOffsets[uses[u].V0]++;
+      linkOffsets[uses[u].V1]++;
+    }
+  }
+  vtkIdType numLinks = 0;
+  for (vtkIdType ptId=0; ptId <= numPts; ++ptId)
+  {
+    vtkIdType count = linkOffsets[ptId];
+    linkOffsets[ptId] = numLinks;
+    numLinks += count;
+  }
+  std::vector<VertexLink> links(numLinks);
+  std::vector<vtkIdType> linkLoc(linkOffsets.begin(), linkOffsets.end()-1);
+  for (vtkIdType u=0; u < numUses; ++u)
+  {
+    if ( useType[u] >= 0 )
+    {
+      const EdgeUse& use = uses[u];
+      VertexLink link = { use.V1, use.CellId, use.Pos, useType[u] };
+      links[linkLoc[use.V0]++] = link;
+      link.Nei = use.V0;
+      links[linkLoc[use.V1]++] = link;
+    }
+  }
+
+  // Now resolve each point: count, prefix sum, fill
+  this->Types.resize(numPts);
+  this->Offsets.resize(numPts+1);
+  ResolveVertices resolve = { lineTypes.data(),
+    (lineEdges.empty() ? nullptr : lineEdges.data()), linkOffsets.data(),
+    links.data(), this, false };
+  vtkSMPTools::For(0, numPts, resolve);
+
+  vtkIdType numConn = 0;
+  for (vtkIdType ptId=0; ptId <= numPts; ++ptId)
+  {
+    vtkIdType count = ( ptId < numPts ? this->Offsets[ptId] : 0 );
+    this->Offsets[ptId] = numConn;
+    numConn += count;
+  }
+  this->Conn.resize(numConn);
+  resolve.Fill = true;
+  vtkSMPTools::For(0, numPts, resolve);
+}
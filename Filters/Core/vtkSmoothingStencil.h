@@ -0,0 +1,87 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSmoothingStencil.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSmoothingStencil
+ * @brief   connectivity of the vertices of a mesh for smoothing filters
+ *
+ * vtkSmoothingStencil is a private helper class shared by
+ * vtkSmoothPolyDataFilter and vtkWindowedSincPolyDataFilter. It classifies
+ * the vertices of a mesh as simple, fixed, feature edge or boundary edge
+ * vertices, and stores the vertices each one is smoothed with in
+ * compressed row form: the vertices connected to point i are
+ * Conn[Offsets[i]] through Conn[Offsets[i+1]-1].
+ *
+ * Polygon edges are classified by sorting their uses rather than by
+ * searching cell neighbors through the links, so that the whole stencil
+ * is built in parallel with vtkSMPTools.
+ *
+ * @sa
+ * vtkSmoothPolyDataFilter vtkWindowedSincPolyDataFilter
+*/
+
+#ifndef vtkSmoothingStencil_h
+#define vtkSmoothingStencil_h
+
+#include "vtkType.h"
+
+#include <vector> // For the stencil arrays
+
+class vtkPolyData;
+
+#define VTK_SIMPLE_VERTEX 0
+#define VTK_FIXED_VERTEX 1
+#define VTK_FEATURE_EDGE_VERTEX 2
+#define VTK_BOUNDARY_EDGE_VERTEX 3
+
+class vtkSmoothingStencil
+{
+public:
+  /**
+   * Build the stencil from the polygons of mesh, which must not contain
+   * triangle strips. On entry lineTypes and lineEdges hold the
+   * classification made from the verts and lines of the input (lineEdges
+   * may be empty if there are no lines): the type of each point, and the
+   * two neighbors of the points that are feature edge vertices of a line.
+   * Edges used by more than two polygons are feature edges unless
+   * nonManifoldSmoothing is set. On return the stencil is complete except
+   * for the edge angle test.
+   */
+  void Build(vtkPolyData *mesh, vtkIdType numPts,
+             const std::vector<char>& lineTypes,
+             const std::vector<vtkIdType>& lineEdges,
+             bool featureEdgeSmoothing, double cosFeatureAngle,
+             bool nonManifoldSmoothing);
+
+  //@{
+  /**
+   * Get the vertices that a point is smoothed with.
+   */
+  vtkIdType GetNumberOfEdges(vtkIdType ptId) const
+  {
+    return this->Offsets[ptId+1] - this->Offsets[ptId];
+  }
+  const vtkIdType *GetEdges(vtkIdType ptId) const
+  {
+    return this->Conn.data() + this->Offsets[ptId];
+  }
+  //@}
+
+  std::vector<char> Types;
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Conn;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSmoothingStencil.h
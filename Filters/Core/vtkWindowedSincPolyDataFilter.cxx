@@ -20,13 +20,18 @@
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+#include "vtkSmoothingStencil.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkWindowedSincPolyDataFilter);
 
 //-----------------------------------------------------------------------------
@@ -52,17 +57,136 @@ vtkWindowedSincPolyDataFilter::vtkWindowedSincPolyDataFilter()
   this->NormalizeCoordinates = 0;
 }
 
-#define VTK_SIMPLE_VERTEX 0
-#define VTK_FIXED_VERTEX 1
-#define VTK_FEATURE_EDGE_VERTEX 2
-#define VTK_BOUNDARY_EDGE_VERTEX 3
+namespace {
 
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
+// First windowed sinc iteration. Each pass only reads positions computed
+// by the previous passes, so points are updated independently.
+struct vtkWSPDF_FirstIteration
 {
-  char      type;
-  vtkIdList *edges; // connected edges (list of connected point ids)
-} vtkMeshVertex, *vtkMeshVertexPtr;
+  const vtkSmoothingStencil *Stencil;
+  const float *X0;
+  float *X1;
+  float *X3;
+  const double *C;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double deltaX[3];
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      const float *x = this->X0 + 3*ptId;
+      float *x1 = this->X1 + 3*ptId;
+      float *x3 = this->X3 + 3*ptId;
+      vtkIdType npts = this->Stencil->GetNumberOfEdges(ptId);
+      if ( npts > 0 )
+      {
+        // point is allowed to move
+        const vtkIdType *edges = this->Stencil->GetEdges(ptId);
+        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+
+        // calculate the negative of the laplacian
+        for (vtkIdType j=0; j<npts; j++) //for all connected points
+        {
+          const float *y = this->X0 + 3*edges[j];
+          for (int k=0; k<3; k++)
+          {
+            deltaX[k] += (static_cast<double>(x[k]) - y[k]) / npts;
+          }
+        }
+        // newPts[one] = newPts[zero] - 0.5 newPts[one]
+        for (int k=0; k<3; k++)
+        {
+          deltaX[k] = x[k] - 0.5*deltaX[k];
+          x1[k] = static_cast<float>(deltaX[k]);
+        }
+
+        // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
+        for (int k=0; k<3; k++)
+        {
+          deltaX[k] = this->C[0]*x[k] + this->C[1]*deltaX[k];
+          x3[k] = ( this->Stencil->Types[ptId] == VTK_FIXED_VERTEX ?
+                    x[k] : static_cast<float>(deltaX[k]) );
+        }
+      }//if can move point
+      else
+      {
+        // point is not allowed to move, just use the old point...
+        // (zero out the Laplacian)
+        for (int k=0; k<3; k++)
+        {
+          x1[k] = 0.0f;
+          x3[k] = x[k];
+        }
+      }
+    }//for all points
+  }
+};
+
+// Remaining windowed sinc iterations.
+struct vtkWSPDF_Iteration
+{
+  const vtkSmoothingStencil *Stencil;
+  const float *X0;
+  const float *X1;
+  float *X2;
+  float *X3;
+  double C;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double deltaX[3];
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      float *x2 = this->X2 + 3*ptId;
+      vtkIdType npts = this->Stencil->GetNumberOfEdges(ptId);
+      if ( npts > 0 )
+      {
+        // point is allowed to move
+        const float *p_x0 = this->X0 + 3*ptId; //use current points
+        const float *p_x1 = this->X1 + 3*ptId;
+        const vtkIdType *edges = this->Stencil->GetEdges(ptId);
+
+        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+
+        // calculate the negative laplacian of x1
+        for (vtkIdType j=0; j<npts; j++)
+        {
+          const float *y = this->X1 + 3*edges[j];
+          for (int k=0; k<3; k++)
+          {
+            deltaX[k] += (static_cast<double>(p_x1[k]) - y[k]) / npts;
+          }
+        }//for all connected points
+
+        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
+        for (int k=0; k<3; k++)
+        {
+          deltaX[k] = static_cast<double>(p_x1[k]) - p_x0[k] + p_x1[k] - deltaX[k];
+          x2[k] = static_cast<float>(deltaX[k]);
+        }
+
+        // smooth the vertex (x3 = x3 + cj x2)
+        if (this->Stencil->Types[ptId] != VTK_FIXED_VERTEX)
+        {
+          float *p_x3 = this->X3 + 3*ptId;
+          for (int k=0;k<3;k++)
+          {
+            p_x3[k] = static_cast<float>(p_x3[k] + this->C * deltaX[k]);
+          }
+        }
+      }//if can move point
+      else
+      {
+        // point is not allowed to move (zero out the Laplacian). Its entry
+        // in newPts[one] is already zero from the previous pass, and may
+        // be read concurrently by its neighbors, so it is not rewritten.
+        x2[0] = x2[1] = x2[2] = 0.0f;
+      }
+    }//for all points
+  }
+};
+
+} // anonymous namespace
 
 //-----------------------------------------------------------------------------
 int vtkWindowedSincPolyDataFilter::RequestData(
@@ -80,26 +204,21 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   vtkPolyData *output = vtkPolyData::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType numPts, numCells, numPolys, numStrips, i;
+  vtkIdType numPts, numCells, numStrips, i;
   int j, k;
   vtkIdType npts = 0;
   vtkIdType *pts = nullptr;
-  vtkIdType p1, p2;
-  double x[3], y[3], deltaX[3], xNew[3];
   double x1[3], x2[3], x3[3], l1[3], l2[3];
   double CosFeatureAngle; //Cosine of angle between adjacent polys
   double CosEdgeAngle; // Cosine of angle between adjacent edges
   int iterationNumber;
   vtkIdType numSimple=0, numBEdges=0, numFixed=0, numFEdges=0;
-  vtkPolyData *inMesh = nullptr, *Mesh;
   vtkPoints *inPts;
-  vtkTriangleFilter *toTris=nullptr;
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints *newPts[4];
-  vtkMeshVertexPtr Verts;
 
   // variables specific to windowed sinc interpolation
-  double theta_pb, k_pb, sigma, p_x0[3], p_x1[3], p_x3[3];
+  double theta_pb, k_pb, sigma;
   double *w, *c, *cprime;
   int zero, one, two, three;
 
@@ -148,12 +267,9 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   // vertices. FIXED vertices are never smoothed. Edge vertices are smoothed
   // using a subset of the attached vertices.
   vtkDebugMacro(<<"Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
-  for (i=0; i<numPts; i++)
-  {
-    Verts[i].type = VTK_SIMPLE_VERTEX; //can smooth
-    Verts[i].edges = nullptr;
-  }
+  std::vector<char> lineTypes(numPts, VTK_SIMPLE_VERTEX);
+  std::vector<vtkIdType> lineEdges;
+  vtkSmoothingStencil stencil;
 
   inPts = input->GetPoints();
 
@@ -163,15 +279,19 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   {
     for (j=0; j<npts; j++)
     {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      lineTypes[pts[j]] = VTK_FIXED_VERTEX;
     }
   }
 
   this->UpdateProgress(0.10);
 
   // now check lines. Only manifold lines can be smoothed------------
-  for (inLines=input->GetLines(), inLines->InitTraversal();
-  inLines->GetNextCell(npts,pts); )
+  inLines=input->GetLines();
+  if ( inLines->GetNumberOfCells() > 0 )
+  {
+    lineEdges.resize(2*numPts);
+  }
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts,pts); )
   {
     // Check for closed loop which are treated specially. Basically the
     // last point is ignored (set to fixed).
@@ -179,48 +299,42 @@ int vtkWindowedSincPolyDataFilter::RequestData(
 
     for (j=0; j<npts; j++)
     {
-      if ( Verts[pts[j]].type == VTK_SIMPLE_VERTEX )
+      if ( lineTypes[pts[j]] == VTK_SIMPLE_VERTEX )
       {
         // First point
         if ( j == 0 )
         {
           if ( !closedLoop )
           {
-            Verts[pts[0]].type = VTK_FIXED_VERTEX;
+            lineTypes[pts[0]] = VTK_FIXED_VERTEX;
           }
           else
           {
-            Verts[pts[0]].type = VTK_FEATURE_EDGE_VERTEX;
-            Verts[pts[0]].edges = vtkIdList::New();
-            Verts[pts[0]].edges->SetNumberOfIds(2);
-            Verts[pts[0]].edges->SetId(0,pts[npts-2]);
-            Verts[pts[0]].edges->SetId(1,pts[1]);
+            lineTypes[pts[0]] = VTK_FEATURE_EDGE_VERTEX;
+            lineEdges[2*pts[0]] = pts[npts-2];
+            lineEdges[2*pts[0]+1] = pts[1];
           }
         }
         // Last point
         else if ( j == (npts-1) && !closedLoop )
         {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
+          lineTypes[pts[j]] = VTK_FIXED_VERTEX;
         }
         // In between point
         else //is edge vertex (unless already edge vertex!)
         {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          Verts[pts[j]].edges->SetId(0,pts[j-1]);
-          Verts[pts[j]].edges->SetId(1,pts[(closedLoop && j==(npts-2) ? 0 : (j+1))]);
+          lineTypes[pts[j]] = VTK_FEATURE_EDGE_VERTEX;
+          lineEdges[2*pts[j]] = pts[j-1];
+          lineEdges[2*pts[j]+1] = pts[(closedLoop && j==(npts-2) ? 0 : (j+1))];
         }
       } //if simple vertex
 
       // Vertex has been visited before, need to fix it. Special case
       // when working on closed loop.
-      else if ( Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX &&
+      else if ( lineTypes[pts[j]] == VTK_FEATURE_EDGE_VERTEX &&
                 ! (closedLoop && j == (npts-1)) )
       {
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = nullptr;
+        lineTypes[pts[j]] = VTK_FIXED_VERTEX;
       }
     } //for all points in this line
   } //for all lines
@@ -229,190 +343,67 @@ int vtkWindowedSincPolyDataFilter::RequestData(
 
   // now polygons and triangle strips-------------------------------
   inPolys=input->GetPolys();
-  numPolys = inPolys->GetNumberOfCells();
   inStrips=input->GetStrips();
   numStrips = inStrips->GetNumberOfCells();
 
-  if ( numPolys > 0 || numStrips > 0 )
-  { //build cell structure
-    vtkCellArray *polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    vtkIdType *neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList *neighbors;
-
-    inMesh = vtkPolyData::New();
-    inMesh->SetPoints(inPts);
-    inMesh->SetPolys(inPolys);
-    Mesh = inMesh;
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
-
-    if ( (numStrips = inStrips->GetNumberOfCells()) > 0 )
-    { // convert data to triangles
-      inMesh->SetStrips(inStrips);
-      toTris = vtkTriangleFilter::New();
-      toTris->SetInputData(inMesh);
-      toTris->Update();
-      Mesh = toTris->GetOutput();
-    }
-
-    Mesh->BuildLinks(); //to do neighborhood searching
-    polys = Mesh->GetPolys();
-
-    for (cellId=0, polys->InitTraversal(); polys->GetNextCell(npts,pts);
-         cellId++)
-    {
-      for (i=0; i < npts; i++)
-      {
-        p1 = pts[i];
-        p2 = pts[(i+1)%npts];
-
-        if ( Verts[p1].edges == nullptr )
-        {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16,6);
-          // Verts[p1].edges = new vtkIdList(6,6);
-        }
-        if ( Verts[p2].edges == nullptr )
-        {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16,6);
-          // Verts[p2].edges = new vtkIdList(6,6);
-        }
-
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if ( numNei == 0 )
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if ( numNei >= 2 )
-        {
-          // non-manifold case, check nonmanifold smoothing state
-          if (!this->NonManifoldSmoothing)
-          {
-            // check to make sure that this edge hasn't been marked already
-            for (j=0; j < numNei; j++)
-            {
-              if ( neighbors->GetId(j) < cellId )
-              {
-                break;
-              }
-            }
-            if ( j >= numNei )
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-
-        else if ( numNei == 1 && (nei=neighbors->GetId(0)) > cellId )
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts,npts,pts,normal);
-            Mesh->GetCellPoints(nei,numNeiPts,neiPts);
-            vtkPolygon::ComputeNormal(inPts,numNeiPts,neiPts,neiNormal);
-
-            if ( vtkMath::Dot(normal,neiNormal) <= CosFeatureAngle )
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
-        {
-          continue;
-        }
-
-        if ( edge && Verts[p1].type == VTK_SIMPLE_VERTEX )
-        {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-        }
-        else if ( (edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-        (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX ) )
-        {
-          Verts[p1].edges->InsertNextId(p2);
-          if ( Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
-          {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-
-        if ( edge && Verts[p2].type == VTK_SIMPLE_VERTEX )
-        {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-        }
-        else if ( (edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX ) ||
-        (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX ) )
-        {
-          Verts[p2].edges->InsertNextId(p1);
-          if ( Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
-          {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-      }
-    }
+  // Polygon edges are classified in parallel by sorting the edge uses,
+  // rather than by searching cell neighbors through the links.
+  vtkNew<vtkPolyData> inMesh;
+  inMesh->SetPoints(inPts);
+  inMesh->SetPolys(inPolys);
+  vtkPolyData *Mesh = inMesh.GetPointer();
+  vtkNew<vtkTriangleFilter> toTris;
+  if ( numStrips > 0 )
+  { // convert data to triangles
+    inMesh->SetStrips(inStrips);
+    toTris->SetInputData(inMesh.GetPointer());
+    toTris->Update();
+    Mesh = toTris->GetOutput();
+  }
 
-    //    delete inMesh; // delete this later, windowed sinc smoothing needs it
-    if (toTris)
-    {
-      toTris->Delete();
-    }
-    neighbors->Delete();
-  }//if strips or polys
+  stencil.Build(Mesh, numPts, lineTypes, lineEdges,
+                this->FeatureEdgeSmoothing != 0, CosFeatureAngle,
+                this->NonManifoldSmoothing != 0);
 
   this->UpdateProgress(0.50);
 
   //post-process edge vertices to make sure we can smooth them
   for (i=0; i<numPts; i++)
   {
-    if ( Verts[i].type == VTK_SIMPLE_VERTEX )
+    char& type = stencil.Types[i];
+    if ( type == VTK_SIMPLE_VERTEX )
     {
       numSimple++;
     }
 
-    else if ( Verts[i].type == VTK_FIXED_VERTEX )
+    else if ( type == VTK_FIXED_VERTEX )
     {
       numFixed++;
     }
 
-    else if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX ||
-              Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
+    else if ( type == VTK_FEATURE_EDGE_VERTEX ||
+              type == VTK_BOUNDARY_EDGE_VERTEX )
     { //see how many edges; if two, what the angle is
 
       if ( !this->BoundarySmoothing &&
-      Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
+      type == VTK_BOUNDARY_EDGE_VERTEX )
       {
-        Verts[i].type = VTK_FIXED_VERTEX;
+        type = VTK_FIXED_VERTEX;
         numBEdges++;
       }
 
-      else if ( (npts = Verts[i].edges->GetNumberOfIds()) != 2 )
+      else if ( stencil.GetNumberOfEdges(i) != 2 )
       {
         // can only smooth edges on 2-manifold surfaces
-        Verts[i].type = VTK_FIXED_VERTEX;
+        type = VTK_FIXED_VERTEX;
         numFixed++;
       }
 
       else //check angle between edges
       {
-        inPts->GetPoint(Verts[i].edges->GetId(0),x1);
+        inPts->GetPoint(stencil.GetEdges(i)[0],x1);
         inPts->GetPoint(i,x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1),x3);
+        inPts->GetPoint(stencil.GetEdges(i)[1],x3);
 
         for (k=0; k<3; k++)
         {
@@ -423,11 +414,11 @@ int vtkWindowedSincPolyDataFilter::RequestData(
             && (vtkMath::Dot(l1,l2) < CosEdgeAngle))
         {
           numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
+          type = VTK_FIXED_VERTEX;
         }
         else
         {
-          if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX )
+          if ( type == VTK_FEATURE_EDGE_VERTEX )
           {
             numFEdges++;
           }
@@ -506,9 +497,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   c = new double[this->NumberOfIterations+1];
   cprime = new double[this->NumberOfIterations+1];
 
-  double zerovector[3];
-  zerovector[0] = zerovector[1] = zerovector[2] = 0.0;
-
   // Calculate the weights and the Chebychev coefficients c.
   //
 
@@ -593,54 +581,16 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     vtkErrorMacro(<< "An optimal offset for the smoothing filter could not be found.  Unpredictable smoothing/shrinkage may result.");
   }
 
-  // first iteration
-  for (i=0; i<numPts; i++)
+  float *coords[4];
+  for (i=0; i < 4; i++)
   {
-    if ( Verts[i].edges != nullptr &&
-         (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-    {
-      // point is allowed to move
-      newPts[zero]->GetPoint(i, x); //use current points
-      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-      // calculate the negative of the laplacian
-      for (j=0; j<npts; j++) //for all connected points
-      {
-        newPts[zero]->GetPoint(Verts[i].edges->GetId(j), y);
-        for (k=0; k<3; k++)
-        {
-          deltaX[k] += (x[k] - y[k]) / npts;
-        }
-      }
-      // newPts[one] = newPts[zero] - 0.5 newPts[one]
-      for (k=0; k<3; k++)
-      {
-        deltaX[k] = x[k] - 0.5*deltaX[k];
-      }
-      newPts[one]->SetPoint(i, deltaX);
+    coords[i] = static_cast<float*>(newPts[i]->GetVoidPointer(0));
+  }
 
-      // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
-      for (k=0; k < 3; k++)
-      {
-        deltaX[k] = c[0]*x[k] + c[1]*deltaX[k];
-      }
-      if (Verts[i].type == VTK_FIXED_VERTEX)
-      {
-        newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-      }
-      else
-      {
-        newPts[three]->SetPoint(i, deltaX);
-      }
-    }//if can move point
-    else
-    {
-      // point is not allowed to move, just use the old point...
-      // (zero out the Laplacian)
-      newPts[one]->SetPoint(i, zerovector);
-      newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-    }
-  }//for all points
+  // first iteration
+  vtkWSPDF_FirstIteration first =
+    { &stencil, coords[zero], coords[one], coords[three], c };
+  vtkSMPTools::For(0, numPts, first);
 
   // for the rest of the iterations
   for ( iterationNumber=2;
@@ -656,53 +606,9 @@ int vtkWindowedSincPolyDataFilter::RequestData(
       }
     }
 
-    for (i=0; i<numPts; i++)
-    {
-      if ( Verts[i].edges != nullptr &&
-           (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-      {
-        // point is allowed to move
-        newPts[zero]->GetPoint(i, p_x0); //use current points
-        newPts[one]->GetPoint(i, p_x1);
-
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-        // calculate the negative laplacian of x1
-        for (j=0; j<npts; j++)
-        {
-          newPts[one]->GetPoint(Verts[i].edges->GetId(j), y);
-          for (k=0; k<3; k++)
-          {
-            deltaX[k] += (p_x1[k] - y[k]) / npts;
-          }
-        }//for all connected points
-
-        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
-        for (k=0; k<3; k++)
-        {
-          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
-        }
-        newPts[two]->SetPoint(i, deltaX);
-
-        // smooth the vertex (x3 = x3 + cj x2)
-        newPts[three]->GetPoint(i, p_x3);
-        for (k=0;k<3;k++)
-        {
-          xNew[k] = p_x3[k] + c[iterationNumber] * deltaX[k];
-        }
-        if (Verts[i].type != VTK_FIXED_VERTEX)
-        {
-          newPts[three]->SetPoint(i,xNew);
-        }
-      }//if can move point
-      else
-      {
-        // point is not allowed to move, just use the old point...
-        // (zero out the Laplacian)
-        newPts[one]->SetPoint(i, zerovector);
-        newPts[two]->SetPoint(i, zerovector);
-      }
-    }//for all points
+    vtkWSPDF_Iteration iteration = { &stencil, coords[zero], coords[one],
+      coords[two], coords[three], c[iterationNumber] };
+    vtkSMPTools::For(0, numPts, iteration);
 
     // update the pointers. three is always three. all other pointers
     // shift by one and wrap.
@@ -793,22 +699,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  // finally delete the constructed (local) mesh
-  if ( inMesh != nullptr )
-  {
-    inMesh->Delete();
-  }
-
-  //free up connectivity storage
-  for (i=0; i<numPts; i++)
-  {
-    if ( Verts[i].edges != nullptr )
-    {
-      Verts[i].edges->Delete();
-    }
-  }
-  delete [] Verts;
-
   return 1;
 }
 
@@ -33,7 +33,8 @@
  * Taubin describes this methodology is the IBM tech report RC-20404
  * (#90237, dated 3/12/96) "Optimal Surface Smoothing as Filter Design"
  * G. Taubin, T. Zhang and G. Golub. (Zhang and Golub are at Stanford
- * University).
+ * University). Both the connectivity analysis and the iterations are
+ * threaded with vtkSMPTools.
  *
  * This report discusses using standard signal processing low-pass filters
  * (in particular windowed sinc functions) to smooth polyhedra. The
@@ -0,0 +1,179 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPrefetchingTimeSeriesReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkPrefetchingTimeSeriesReader serves the requested time steps
+// and loads the following ones in the background.
+
+#include "vtkDataArray.h"
+#include "vtkImageAlgorithm.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPrefetchingTimeSeriesReader.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <atomic>
+
+namespace
+{
+const int NumberOfTimeSteps = 10;
+
+// Produces an image filled with the requested time and counts how often it
+// executes.
+class vtkTimeStepSource : public vtkImageAlgorithm
+{
+public:
+  static vtkTimeStepSource* New();
+  vtkTypeMacro(vtkTimeStepSource, vtkImageAlgorithm);
+
+  std::atomic<int> NumberOfExecutions;
+  std::atomic<int> LastTimeStep;
+
+protected:
+  vtkTimeStepSource()
+  {
+    this->NumberOfExecutions = 0;
+    this->LastTimeStep = -1;
+    this->SetNumberOfInputPorts(0);
+  }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    int extent[6] = { 0, 4, 0, 4, 0, 0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+    double times[NumberOfTimeSteps];
+    for (int i = 0; i < NumberOfTimeSteps; ++i)
+    {
+      times[i] = i;
+    }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), times, NumberOfTimeSteps);
+    double range[2] = { times[0], times[NumberOfTimeSteps - 1] };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkImageData* image = vtkImageData::GetData(outInfo);
+    double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    image->SetExtent(outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()));
+    image->AllocateScalars(VTK_DOUBLE, 1);
+    image->GetPointData()->GetScalars()->Fill(time);
+    ++this->NumberOfExecutions;
+    this->LastTimeStep = static_cast<int>(time);
+    return 1;
+  }
+
+private:
+  vtkTimeStepSource(const vtkTimeStepSource&) = delete;
+  void operator=(const vtkTimeStepSource&) = delete;
+};
+vtkStandardNewMacro(vtkTimeStepSource);
+
+bool CheckTimeStep(vtkPrefetchingTimeSeriesReader* reader, int step)
+{
+  reader->UpdateTimeStep(step);
+  vtkImageData* image = vtkImageData::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!image || image->GetNumberOfPoints() != 25 ||
+    image->GetPointData()->GetScalars()->GetTuple1(12) != step ||
+    image->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != step)
+  {
+    cerr << "Wrong output for time step " << step << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPrefetchingTimeSeriesReader(int, char*[])
+{
+  vtkNew<vtkTimeStepSource> source;
+  vtkNew<vtkPrefetchingTimeSeriesReader> reader;
+  reader->SetReader(source);
+  reader->SetCacheSize(4);
+  reader->SetNumberOfStepsToPrefetch(2);
+
+  // Play forward, loop around, and play backward.
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+  {
+    if (!CheckTimeStep(reader, step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  for (int step = 0; step < 3; ++step)
+  {
+    if (!CheckTimeStep(reader, step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  for (int step = NumberOfTimeSteps - 1; step >= 0; --step)
+  {
+    if (!CheckTimeStep(reader, step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Moving forward from step 4 prefetches steps 6 and 7.
+  if (!CheckTimeStep(reader, 4) || !CheckTimeStep(reader, 5))
+  {
+    return EXIT_FAILURE;
+  }
+  for (int i = 0; i < 1000 && source->LastTimeStep != 7; ++i)
+  {
+    vtksys::SystemTools::Delay(10);
+  }
+  reader->Finalize();
+  reader->SetNumberOfStepsToPrefetch(0);
+  int numberOfExecutions = source->NumberOfExecutions;
+  if (!CheckTimeStep(reader, 6) || !CheckTimeStep(reader, 7))
+  {
+    return EXIT_FAILURE;
+  }
+  if (source->NumberOfExecutions != numberOfExecutions)
+  {
+    cerr << "Prefetched time steps were read again" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Requests for a time between time steps are served the previous step.
+  reader->UpdateTimeStep(2.5);
+  if (reader->GetOutputDataObject(0)->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != 2)
+  {
+    cerr << "Time 2.5 was not snapped to time step 2" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the reader invalidates the cache.
+  numberOfExecutions = source->NumberOfExecutions;
+  source->Modified();
+  if (!CheckTimeStep(reader, 7) || source->NumberOfExecutions == numberOfExecutions)
+  {
+    cerr << "The cache was not invalidated" << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkThreadedWriter writes every queued step, in the background,
+// and counts the writes that fail.
+
+#include "vtkCellType.h"
+#include "vtkExecutive.h"
+#include "vtkFloatArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkThreadedWriter.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLMultiBlockDataReader.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+const int NumberOfSteps = 8;
+
+std::string StepFileName(const std::string& dir, const char* prefix, int step,
+  const char* extension)
+{
+  std::ostringstream name;
+  name << dir << "/" << prefix << step << extension;
+  return name.str();
+}
+
+// Move the points of a single hexahedron to the given step. The arrays are
+// replaced rather than modified, so shallow copies are enough.
+void SetStep(vtkUnstructuredGrid* grid, int step)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> stepArray;
+  stepArray->SetName("Step");
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 2; ++i)
+      {
+        points->InsertNextPoint(i + step, j, k);
+        stepArray->InsertNextValue(static_cast<float>(step));
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(stepArray);
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> NewHexahedron()
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkIdType hex[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+  grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+  return grid;
+}
+
+bool IsStep(vtkDataObject* data, int step)
+{
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(data);
+  double x[3];
+  return grid && grid->GetNumberOfCells() == 1 && grid->GetNumberOfPoints() == 8 &&
+    (grid->GetPoint(7, x), x[0] == step + 1) &&
+    grid->GetPointData()->GetScalars()->GetTuple1(0) == step;
+}
+
+// The leaves of a multiblock dataset are moved to the next step as soon as
+// Write() returns, while the workers may still be writing the previous one.
+bool TestMultiBlock(vtkThreadedWriter* threadedWriter, const std::string& dir)
+{
+  vtkSmartPointer<vtkUnstructuredGrid> leaf = NewHexahedron();
+  vtkSmartPointer<vtkUnstructuredGrid> nestedLeaf = NewHexahedron();
+  vtkNew<vtkMultiBlockDataSet> nested;
+  nested->SetBlock(0, nestedLeaf);
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetBlock(0, leaf);
+  blocks->SetBlock(1, nested);
+
+  SetStep(leaf, 0);
+  SetStep(nestedLeaf, 0);
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    vtkSmartPointer<vtkXMLMultiBlockDataWriter> writer =
+      vtkSmartPointer<vtkXMLMultiBlockDataWriter>::New();
+    writer->SetFileName(StepFileName(dir, "ThreadedWriterBlocks_", step, ".vtm").c_str());
+    threadedWriter->Write(blocks, writer);
+    SetStep(leaf, step + 1);
+    SetStep(nestedLeaf, step + 1);
+  }
+  threadedWriter->Flush();
+
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    vtkNew<vtkXMLMultiBlockDataReader> reader;
+    reader->SetFileName(StepFileName(dir, "ThreadedWriterBlocks_", step, ".vtm").c_str());
+    reader->Update();
+    vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput());
+    vtkMultiBlockDataSet* nestedOutput =
+      output ? vtkMultiBlockDataSet::SafeDownCast(output->GetBlock(1)) : nullptr;
+    if (!nestedOutput || !IsStep(output->GetBlock(0), step) ||
+      !IsStep(nestedOutput->GetBlock(0), step))
+    {
+      cerr << "Multiblock step " << step << " was not written correctly" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestThreadedWriter(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string dir = tempDir;
+  delete[] tempDir;
+
+  vtkNew<vtkThreadedWriter> threadedWriter;
+  threadedWriter->SetMaxThreads(2);
+  threadedWriter->SetMaxQueueSize(1);
+
+  // A single hexahedron whose points are moved by each step.
+  vtkSmartPointer<vtkUnstructuredGrid> grid = NewHexahedron();
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    SetStep(grid, step);
+
+    vtkSmartPointer<vtkXMLUnstructuredGridWriter> writer =
+      vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+    writer->SetFileName(StepFileName(dir, "ThreadedWriter_", step, ".vtu").c_str());
+    threadedWriter->Write(grid, writer);
+  }
+
+  // A write into a missing directory fails without stopping the others.
+  vtkSmartPointer<vtkXMLUnstructuredGridWriter> badWriter =
+    vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+  badWriter->SetFileName((dir + "/missing/directory/ThreadedWriter.vtu").c_str());
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  badWriter->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  badWriter->GetExecutive()->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  threadedWriter->Write(grid, badWriter);
+  threadedWriter->Flush();
+
+  if (!errorObserver->GetError() || threadedWriter->GetNumberOfFailedWrites() != 1)
+  {
+    cerr << "Expected 1 failed write, got " << threadedWriter->GetNumberOfFailedWrites() << endl;
+    return EXIT_FAILURE;
+  }
+
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    vtkNew<vtkXMLUnstructuredGridReader> reader;
+    reader->SetFileName(StepFileName(dir, "ThreadedWriter_", step, ".vtu").c_str());
+    reader->Update();
+    if (!IsStep(reader->GetOutput(), step))
+    {
+      cerr << "Step " << step << " was not written correctly" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!TestMultiBlock(threadedWriter, dir))
+  {
+    return EXIT_FAILURE;
+  }
+
+  threadedWriter->Finalize();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,629 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPrefetchingTimeSeriesReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPrefetchingTimeSeriesReader.h"
+
+#include "vtkConditionVariable.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+//****************************************************************************
+namespace
+{
+// Identifies one output of the reader: a time step of a piece and extent.
+struct vtkPrefetchKey
+{
+  double Time;
+  int Piece;
+  int NumberOfPieces;
+  int GhostLevel;
+  bool HasExtent;
+  int Extent[6];
+
+  vtkPrefetchKey()
+    : Time(0.0)
+    , Piece(0)
+    , NumberOfPieces(1)
+    , GhostLevel(0)
+    , HasExtent(false)
+  {
+    std::fill(this->Extent, this->Extent + 6, 0);
+  }
+
+  bool operator<(const vtkPrefetchKey& other) const
+  {
+    if (this->Time != other.Time)
+    {
+      return this->Time < other.Time;
+    }
+    if (this->Piece != other.Piece)
+    {
+      return this->Piece < other.Piece;
+    }
+    if (this->NumberOfPieces != other.NumberOfPieces)
+    {
+      return this->NumberOfPieces < other.NumberOfPieces;
+    }
+    if (this->GhostLevel != other.GhostLevel)
+    {
+      return this->GhostLevel < other.GhostLevel;
+    }
+    if (this->HasExtent != other.HasExtent)
+    {
+      return other.HasExtent;
+    }
+    return std::lexicographical_compare(
+      this->Extent, this->Extent + 6, other.Extent, other.Extent + 6);
+  }
+};
+}
+
+//****************************************************************************
+class vtkPrefetchingTimeSeriesReader::vtkInternals
+{
+public:
+  // Maps each loaded output to the stamp of its last use and the data.
+  typedef std::map<vtkPrefetchKey, std::pair<vtkTypeUInt64, vtkSmartPointer<vtkDataObject> > >
+    CacheType;
+
+  vtkNew<vtkMultiThreader> Threader;
+  int ThreadId;
+
+  // Held by whichever thread is updating the reader. It must never be
+  // acquired while holding StateLock.
+  vtkSimpleMutexLock ReaderLock;
+  vtkAlgorithm* Reader;
+
+  //------------------------------------------------------------------------
+  // StateLock must be held before accessing any of the following members.
+  vtkSimpleMutexLock StateLock;
+  vtkSimpleConditionVariable PrefetchAvailable;
+  std::deque<vtkPrefetchKey> Pending;
+  CacheType Cache;
+  vtkTypeUInt64 Counter;
+  std::size_t CacheSize;
+  bool Done;
+
+  //------------------------------------------------------------------------
+  // Only used by the main thread.
+  std::vector<double> TimeSteps;
+  vtkMTimeType ReaderMTime;
+  int LastIndex;
+  int Stride;
+
+  vtkInternals()
+    : ThreadId(-1)
+    , Reader(nullptr)
+    , Counter(0)
+    , CacheSize(0)
+    , Done(false)
+    , ReaderMTime(0)
+    , LastIndex(-1)
+    , Stride(1)
+  {
+  }
+
+  //------------------------------------------------------------------------
+  // Update the reader for the given key and return a shallow copy of its
+  // output. ReaderLock must be held.
+  vtkSmartPointer<vtkDataObject> Load(const vtkPrefetchKey& key)
+  {
+    if (!this->Reader ||
+      !this->Reader->UpdateTimeStep(key.Time, key.Piece, key.NumberOfPieces, key.GhostLevel,
+        key.HasExtent ? key.Extent : nullptr))
+    {
+      return nullptr;
+    }
+    vtkDataObject* output = this->Reader->GetOutputDataObject(0);
+    if (!output)
+    {
+      return nullptr;
+    }
+    vtkSmartPointer<vtkDataObject> copy;
+    copy.TakeReference(output->NewInstance());
+    copy->ShallowCopy(output);
+    return copy;
+  }
+
+  //------------------------------------------------------------------------
+  vtkSmartPointer<vtkDataObject> Find(const vtkPrefetchKey& key)
+  {
+    vtkSmartPointer<vtkDataObject> data;
+    this->StateLock.Lock();
+    CacheType::iterator pos = this->Cache.find(key);
+    if (pos != this->Cache.end())
+    {
+      pos->second.first = ++this->Counter;
+      data = pos->second.second;
+    }
+    this->StateLock.Unlock();
+    return data;
+  }
+
+  //------------------------------------------------------------------------
+  // Add data to the cache, evicting the least recently used entries.
+  void Insert(const vtkPrefetchKey& key, vtkDataObject* data)
+  {
+    this->StateLock.Lock();
+    if (this->Cache.find(key) == this->Cache.end())
+    {
+      this->Evict(this->CacheSize - 1);
+      this->Cache[key] = std::make_pair(++this->Counter, vtkSmartPointer<vtkDataObject>(data));
+    }
+    this->StateLock.Unlock();
+  }
+
+  //------------------------------------------------------------------------
+  // StateLock must be held.
+  void Evict(std::size_t size)
+  {
+    while (this->Cache.size() > size)
+    {
+      CacheType::iterator oldest = this->Cache.begin();
+      for (CacheType::iterator pos = this->Cache.begin(); pos != this->Cache.end(); ++pos)
+      {
+        if (pos->second.first < oldest->second.first)
+        {
+          oldest = pos;
+        }
+      }
+      this->Cache.erase(oldest);
+    }
+  }
+
+  //------------------------------------------------------------------------
+  void Clear()
+  {
+    this->StateLock.Lock();
+    this->Pending.clear();
+    this->Cache.clear();
+    this->StateLock.Unlock();
+    this->LastIndex = -1;
+    this->Stride = 1;
+  }
+
+  //------------------------------------------------------------------------
+  // Replace the queued prefetches, skipping the ones already cached.
+  void SetPending(const std::vector<vtkPrefetchKey>& keys)
+  {
+    this->StateLock.Lock();
+    this->Pending.clear();
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      if (this->Cache.find(keys[i]) == this->Cache.end())
+      {
+        this->Pending.push_back(keys[i]);
+      }
+    }
+    bool available = !this->Pending.empty();
+    this->StateLock.Unlock();
+
+    if (available)
+    {
+      if (this->ThreadId < 0)
+      {
+        this->ThreadId = this->Threader->SpawnThread(&vtkInternals::Worker, this);
+      }
+      this->PrefetchAvailable.Signal();
+    }
+  }
+
+  //------------------------------------------------------------------------
+  // NOTE: This method may suspend the calling thread until a prefetch is
+  // requested. It returns false when the worker should end.
+  bool GetNextPrefetch(vtkPrefetchKey& key)
+  {
+    this->StateLock.Lock();
+    while (this->Pending.empty() && !this->Done)
+    {
+      this->PrefetchAvailable.Wait(this->StateLock);
+    }
+    bool done = this->Done;
+    if (!done)
+    {
+      key = this->Pending.front();
+      this->Pending.pop_front();
+    }
+    this->StateLock.Unlock();
+    return !done;
+  }
+
+  //------------------------------------------------------------------------
+  // Wait for the worker to finish the step it is loading and end it.
+  void TerminateWorker()
+  {
+    if (this->ThreadId < 0)
+    {
+      return;
+    }
+    this->StateLock.Lock();
+    this->Done = true;
+    this->Pending.clear();
+    this->StateLock.Unlock();
+    this->PrefetchAvailable.Broadcast();
+
+    this->Threader->TerminateThread(this->ThreadId);
+    this->ThreadId = -1;
+    this->StateLock.Lock();
+    this->Done = false;
+    this->StateLock.Unlock();
+  }
+
+  //------------------------------------------------------------------------
+  static VTK_THREAD_RETURN_TYPE Worker(void* calldata)
+  {
+    vtkMultiThreader::ThreadInfo* info = reinterpret_cast<vtkMultiThreader::ThreadInfo*>(calldata);
+    vtkInternals* self = reinterpret_cast<vtkInternals*>(info->UserData);
+
+    vtkPrefetchKey key;
+    while (self->GetNextPrefetch(key))
+    {
+      self->ReaderLock.Lock();
+      self->StateLock.Lock();
+      bool cached = self->Cache.find(key) != self->Cache.end();
+      self->StateLock.Unlock();
+      if (!cached)
+      {
+        // A failed read is not cached; RequestData reports it if the step
+        // is actually requested.
+        vtkSmartPointer<vtkDataObject> data = self->Load(key);
+        if (data)
+        {
+          self->Insert(key, data);
+        }
+      }
+      self->ReaderLock.Unlock();
+    }
+    return VTK_THREAD_RETURN_VALUE;
+  }
+};
+
+vtkStandardNewMacro(vtkPrefetchingTimeSeriesReader);
+//----------------------------------------------------------------------------
+vtkPrefetchingTimeSeriesReader::vtkPrefetchingTimeSeriesReader()
+  : Internals(new vtkInternals())
+{
+  this->Reader = nullptr;
+  this->CacheSize = 4;
+  this->NumberOfStepsToPrefetch = 2;
+  this->Loop = 1;
+  this->Internals->CacheSize = this->CacheSize;
+
+  this->SetNumberOfInputPorts(0);
+  this->SetNumberOfOutputPorts(1);
+}
+
+//----------------------------------------------------------------------------
+vtkPrefetchingTimeSeriesReader::~vtkPrefetchingTimeSeriesReader()
+{
+  this->Internals->TerminateWorker();
+  delete this->Internals;
+  this->Internals = nullptr;
+  if (this->Reader)
+  {
+    this->Reader->UnRegister(this);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPrefetchingTimeSeriesReader::SetReader(vtkAlgorithm* reader)
+{
+  if (this->Reader == reader)
+  {
+    return;
+  }
+  this->Internals->TerminateWorker();
+  this->Internals->Clear();
+
+  vtkAlgorithm* previous = this->Reader;
+  this->Reader = reader;
+  this->Internals->Reader = reader;
+  if (reader)
+  {
+    reader->Register(this);
+  }
+  if (previous)
+  {
+    previous->UnRegister(this);
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPrefetchingTimeSeriesReader::SetCacheSize(int size)
+{
+  if (size < 2)
+  {
+    vtkErrorMacro("Attempt to set cache size to less than 2");
+    return;
+  }
+  if (this->CacheSize == size)
+  {
+    return;
+  }
+  this->CacheSize = size;
+
+  this->Internals->StateLock.Lock();
+  this->Internals->CacheSize = size;
+  this->Internals->Evict(size);
+  this->Internals->StateLock.Unlock();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPrefetchingTimeSeriesReader::Finalize()
+{
+  this->Internals->TerminateWorker();
+}
+
+//----------------------------------------------------------------------------
+vtkMTimeType vtkPrefetchingTimeSeriesReader::GetMTime()
+{
+  vtkMTimeType mtime = this->Superclass::GetMTime();
+  if (this->Reader)
+  {
+    mtime = std::max(mtime, this->Reader->GetMTime());
+  }
+  return mtime;
+}
+
+//----------------------------------------------------------------------------
+int vtkPrefetchingTimeSeriesReader::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // create the output
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+  {
+    return this->RequestDataObject(request, inputVector, outputVector);
+  }
+
+  // forward the reader's meta-data
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+  {
+    return this->RequestInformation(request, inputVector, outputVector);
+  }
+
+  // generate the data
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    return this->RequestData(request, inputVector, outputVector);
+  }
+
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkPrefetchingTimeSeriesReader::FillOutputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataObject");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPrefetchingTimeSeriesReader::RequestDataObject(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  if (!this->Reader)
+  {
+    vtkErrorMacro("No reader has been set.");
+    return 0;
+  }
+
+  this->Internals->ReaderLock.Lock();
+  this->Reader->UpdateDataObject();
+  vtkDataObject* readerOutput = this->Reader->GetOutputDataObject(0);
+  vtkInformation* info = outputVector->GetInformationObject(0);
+  vtkDataObject* output = info->Get(vtkDataObject::DATA_OBJECT());
+  if (readerOutput && (!output || !output->IsA(readerOutput->GetClassName())))
+  {
+    vtkDataObject* newOutput = readerOutput->NewInstance();
+    info->Set(vtkDataObject::DATA_OBJECT(), newOutput);
+    newOutput->Delete();
+  }
+  this->Internals->ReaderLock.Unlock();
+  return readerOutput != nullptr;
+}
+
+//----------------------------------------------------------------------------
+int vtkPrefetchingTimeSeriesReader::RequestInformation(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+
+  if (!this->Reader)
+  {
+    vtkErrorMacro("No reader has been set.");
+    return 0;
+  }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  std::vector<double>& timeSteps = this->Internals->TimeSteps;
+
+  this->Internals->ReaderLock.Lock();
+  this->Reader->UpdateInformation();
+  vtkInformation* readerInfo = this->Reader->GetOutputInformation(0);
+  outInfo->CopyEntry(readerInfo, vtkSDDP::TIME_STEPS());
+  outInfo->CopyEntry(readerInfo, vtkSDDP::TIME_RANGE());
+  outInfo->CopyEntry(readerInfo, vtkSDDP::WHOLE_EXTENT());
+  outInfo->CopyEntry(readerInfo, vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST());
+  outInfo->CopyEntry(readerInfo, vtkAlgorithm::CAN_PRODUCE_SUB_EXTENT());
+  timeSteps.clear();
+  if (readerInfo->Has(vtkSDDP::TIME_STEPS()))
+  {
+    timeSteps.resize(readerInfo->Length(vtkSDDP::TIME_STEPS()));
+    readerInfo->Get(vtkSDDP::TIME_STEPS(), timeSteps.data());
+  }
+  vtkMTimeType readerMTime = this->Reader->GetMTime();
+  this->Internals->ReaderLock.Unlock();
+
+  // Anything loaded before the reader was modified is out of date.
+  if (readerMTime != this->Internals->ReaderMTime)
+  {
+    this->Internals->TerminateWorker();
+    this->Internals->Clear();
+    this->Internals->ReaderMTime = readerMTime;
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPrefetchingTimeSeriesReader::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  vtkInternals* internals = this->Internals;
+  const std::vector<double>& timeSteps = internals->TimeSteps;
+
+  vtkPrefetchKey key;
+  if (outInfo->Has(vtkSDDP::UPDATE_PIECE_NUMBER()))
+  {
+    key.Piece = outInfo->Get(vtkSDDP::UPDATE_PIECE_NUMBER());
+    key.NumberOfPieces = outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_PIECES());
+    key.GhostLevel = outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+  }
+  if (outInfo->Has(vtkSDDP::WHOLE_EXTENT()) && outInfo->Has(vtkSDDP::UPDATE_EXTENT()))
+  {
+    key.HasExtent = true;
+    outInfo->Get(vtkSDDP::UPDATE_EXTENT(), key.Extent);
+  }
+
+  // Snap the requested time to the time step that contains it.
+  int index = -1;
+  if (!timeSteps.empty())
+  {
+    double time = outInfo->Has(vtkSDDP::UPDATE_TIME_STEP())
+      ? outInfo->Get(vtkSDDP::UPDATE_TIME_STEP())
+      : timeSteps[0];
+    index = static_cast<int>(
+      std::upper_bound(timeSteps.begin(), timeSteps.end(), time) - timeSteps.begin()) - 1;
+    index = std::max(index, 0);
+    key.Time = timeSteps[index];
+  }
+
+  // Stale guesses should not delay this request any further.
+  internals->SetPending(std::vector<vtkPrefetchKey>());
+
+  vtkSmartPointer<vtkDataObject> data = internals->Find(key);
+  if (!data)
+  {
+    internals->ReaderLock.Lock();
+    // The worker may have been loading this very step.
+    data = internals->Find(key);
+    if (!data)
+    {
+      data = internals->Load(key);
+      if (data)
+      {
+        internals->Insert(key, data);
+      }
+    }
+    internals->ReaderLock.Unlock();
+  }
+  if (!data)
+  {
+    vtkErrorMacro("The reader failed to produce time " << key.Time << ".");
+    return 0;
+  }
+
+  output->ShallowCopy(data);
+  if (index >= 0)
+  {
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), key.Time);
+  }
+
+  if (index < 0)
+  {
+    return 1;
+  }
+
+  // Guess the next requests from the step between the last two.
+  int numberOfSteps = static_cast<int>(timeSteps.size());
+  if (internals->LastIndex >= 0 && internals->LastIndex != index)
+  {
+    int stride = index - internals->LastIndex;
+    if (this->Loop)
+    {
+      // Going from the last step to the first one is a step forward.
+      stride = ((stride % numberOfSteps) + numberOfSteps) % numberOfSteps;
+      if (stride > numberOfSteps / 2)
+      {
+        stride -= numberOfSteps;
+      }
+    }
+    internals->Stride = stride;
+  }
+  internals->LastIndex = index;
+
+  int count = std::min(this->NumberOfStepsToPrefetch, this->CacheSize - 1);
+  std::vector<vtkPrefetchKey> keys;
+  vtkPrefetchKey next = key;
+  for (int k = 1; k <= count; ++k)
+  {
+    int nextIndex = index + k * internals->Stride;
+    if (this->Loop)
+    {
+      nextIndex = ((nextIndex % numberOfSteps) + numberOfSteps) % numberOfSteps;
+    }
+    else if (nextIndex < 0 || nextIndex >= numberOfSteps)
+    {
+      break;
+    }
+    if (nextIndex == index)
+    {
+      // Looped around the whole series.
+      break;
+    }
+    next.Time = timeSteps[nextIndex];
+    keys.push_back(next);
+  }
+  internals->SetPending(keys);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPrefetchingTimeSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Reader: ";
+  if (this->Reader)
+  {
+    os << endl;
+    this->Reader->PrintSelf(os, indent.GetNextIndent());
+  }
+  else
+  {
+    os << "(none)" << endl;
+  }
+  os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "NumberOfStepsToPrefetch: " << this->NumberOfStepsToPrefetch << endl;
+  os << indent << "Loop: " << this->Loop << endl;
+}
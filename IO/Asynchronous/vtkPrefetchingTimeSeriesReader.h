@@ -0,0 +1,128 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPrefetchingTimeSeriesReader.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class    vtkPrefetchingTimeSeriesReader
+ * @brief    meta-reader that loads the next time steps of a reader on a
+ *           background thread.
+ *
+ * @details  vtkPrefetchingTimeSeriesReader wraps any reader that reports
+ *           TIME_STEPS and forwards its meta-data downstream. Each time a
+ *           time step is requested, it guesses the following requests from
+ *           the direction and stride of the previous ones (forward, backward,
+ *           and looping around the end of the series) and has a worker thread
+ *           update the reader for them while the caller processes the current
+ *           step. The loaded outputs are kept in a cache bounded by CacheSize
+ *           and keyed by time step, piece and extent, and RequestData simply
+ *           shallow copies the cached output when the guess was right.
+ *
+ *           The reader is only ever updated by one thread at a time. Since
+ *           the worker updates it in the background, the reader must not be
+ *           modified or updated directly while prefetching; call Finalize()
+ *           first. Observers of the reader may be invoked from the worker
+ *           thread.
+ */
+
+#ifndef vtkPrefetchingTimeSeriesReader_h
+#define vtkPrefetchingTimeSeriesReader_h
+
+#include "vtkAlgorithm.h"
+#include "vtkIOAsynchronousModule.h" // For export macro
+
+class VTKIOASYNCHRONOUS_EXPORT vtkPrefetchingTimeSeriesReader : public vtkAlgorithm
+{
+public:
+  static vtkPrefetchingTimeSeriesReader* New();
+  vtkTypeMacro(vtkPrefetchingTimeSeriesReader, vtkAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * The reader that actually loads the time steps. It must produce its
+   * data on output port 0 and report TIME_STEPS for prefetching to happen.
+   */
+  virtual void SetReader(vtkAlgorithm*);
+  vtkGetObjectMacro(Reader, vtkAlgorithm);
+  //@}
+
+  //@{
+  /**
+   * The maximum number of time steps (per piece) kept in memory, including
+   * the one currently being served. Defaults to 4, and must be at least 2.
+   */
+  void SetCacheSize(int size);
+  vtkGetMacro(CacheSize, int);
+  //@}
+
+  //@{
+  /**
+   * How many of the predicted time steps to load in the background after
+   * each request. It is limited to CacheSize - 1. Defaults to 2.
+   */
+  vtkSetClampMacro(NumberOfStepsToPrefetch, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfStepsToPrefetch, int);
+  //@}
+
+  //@{
+  /**
+   * When on, predictions past the last time step continue from the first
+   * one (and before the first one from the last one), as when an animation
+   * loops. Defaults to on.
+   */
+  vtkSetMacro(Loop, vtkTypeBool);
+  vtkGetMacro(Loop, vtkTypeBool);
+  vtkBooleanMacro(Loop, vtkTypeBool);
+  //@}
+
+  /**
+   * Wait for the worker thread to finish the time step it is loading and
+   * stop it. It is restarted by the next request.
+   */
+  void Finalize();
+
+  /**
+   * Include the reader's modification time.
+   */
+  vtkMTimeType GetMTime() override;
+
+  /**
+   * See vtkAlgorithm for details.
+   */
+  int ProcessRequest(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+protected:
+  vtkPrefetchingTimeSeriesReader();
+  ~vtkPrefetchingTimeSeriesReader() override;
+
+  int FillOutputPortInformation(int port, vtkInformation* info) override;
+
+  virtual int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+  virtual int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+
+  vtkAlgorithm* Reader;
+  int CacheSize;
+  int NumberOfStepsToPrefetch;
+  vtkTypeBool Loop;
+
+private:
+  vtkPrefetchingTimeSeriesReader(const vtkPrefetchingTimeSeriesReader&) = delete;
+  void operator=(const vtkPrefetchingTimeSeriesReader&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -0,0 +1,329 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkThreadedWriter.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkConditionVariable.h"
+#include "vtkDataObject.h"
+#include "vtkDataObjectTree.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <queue>
+#include <vector>
+
+#define MAX_NUMBER_OF_THREADS_IN_POOL 32
+//****************************************************************************
+namespace
+{
+class vtkSharedData
+{
+public:
+  struct JobType
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    vtkSmartPointer<vtkAlgorithm> Writer;
+  };
+
+private:
+  //------------------------------------------------------------------------
+  // Constructs used to synchronization.
+  vtkSimpleMutexLock JobsLock;
+  vtkSimpleConditionVariable JobsAvailable;
+  vtkSimpleConditionVariable JobsTaken;
+  vtkSimpleConditionVariable JobsDone;
+
+  //------------------------------------------------------------------------
+  // JobsLock must be held before accessing any of the following members.
+  std::queue<JobType> Jobs;
+  int ActiveJobCount;
+  int FailedJobCount;
+  bool Done;
+
+public:
+  //------------------------------------------------------------------------
+  vtkSharedData()
+    : ActiveJobCount(0)
+    , FailedJobCount(0)
+    , Done(false)
+  {
+  }
+
+  //------------------------------------------------------------------------
+  // NOTE: This method suspends the calling thread while the queue is full.
+  void PushJob(const JobType& job, std::size_t maxQueueSize)
+  {
+    this->JobsLock.Lock();
+    while (this->Jobs.size() >= maxQueueSize)
+    {
+      this->JobsTaken.Wait(this->JobsLock);
+    }
+    this->Jobs.push(job);
+    this->JobsLock.Unlock();
+    this->JobsAvailable.Signal();
+  }
+
+  //------------------------------------------------------------------------
+  // NOTE: This method may suspend the calling thread until a job becomes
+  // available. It returns false when the worker should end.
+  bool GetNextJob(JobType& job)
+  {
+    this->JobsLock.Lock();
+    while (this->Jobs.empty() && !this->Done)
+    {
+      this->JobsAvailable.Wait(this->JobsLock);
+    }
+    bool available = !this->Jobs.empty();
+    if (available)
+    {
+      job = this->Jobs.front();
+      this->Jobs.pop();
+      this->ActiveJobCount++;
+    }
+    this->JobsLock.Unlock();
+    if (available)
+    {
+      this->JobsTaken.Broadcast();
+    }
+    return available;
+  }
+
+  //------------------------------------------------------------------------
+  void EndJob(bool failed)
+  {
+    this->JobsLock.Lock();
+    this->ActiveJobCount--;
+    if (failed)
+    {
+      this->FailedJobCount++;
+    }
+    bool idle = this->Jobs.empty() && this->ActiveJobCount == 0;
+    this->JobsLock.Unlock();
+    if (idle)
+    {
+      this->JobsDone.Broadcast();
+    }
+  }
+
+  //------------------------------------------------------------------------
+  // Wait until the queue is empty and no job is running.
+  void WaitForJobs()
+  {
+    this->JobsLock.Lock();
+    while (!this->Jobs.empty() || this->ActiveJobCount != 0)
+    {
+      this->JobsDone.Wait(this->JobsLock);
+    }
+    this->JobsLock.Unlock();
+  }
+
+  //------------------------------------------------------------------------
+  // Workers finish the queued jobs before they end.
+  void RequestWorkersToEnd()
+  {
+    this->JobsLock.Lock();
+    this->Done = true;
+    this->JobsLock.Unlock();
+    this->JobsAvailable.Broadcast();
+  }
+
+  //------------------------------------------------------------------------
+  void Reset()
+  {
+    this->JobsLock.Lock();
+    this->Done = false;
+    this->JobsLock.Unlock();
+  }
+
+  //------------------------------------------------------------------------
+  int GetFailedJobCount()
+  {
+    this->JobsLock.Lock();
+    int count = this->FailedJobCount;
+    this->JobsLock.Unlock();
+    return count;
+  }
+};
+
+VTK_THREAD_RETURN_TYPE Worker(void* calldata)
+{
+  vtkMultiThreader::ThreadInfo* info = reinterpret_cast<vtkMultiThreader::ThreadInfo*>(calldata);
+  vtkSharedData* sharedData = reinterpret_cast<vtkSharedData*>(info->UserData);
+
+  vtkSharedData::JobType job;
+  while (sharedData->GetNextJob(job))
+  {
+    job.Writer->SetInputDataObject(0, job.Data);
+    job.Writer->Modified();
+    job.Writer->Update();
+    bool failed = job.Writer->GetErrorCode() != 0;
+
+    // Release the data as soon as it is written.
+    job.Writer->SetInputDataObject(0, nullptr);
+    job.Writer = nullptr;
+    job.Data = nullptr;
+    sharedData->EndJob(failed);
+  }
+  return VTK_THREAD_RETURN_VALUE;
+}
+}
+
+//****************************************************************************
+class vtkThreadedWriter::vtkInternals
+{
+private:
+  std::vector<int> RunningThreadIds;
+
+public:
+  vtkNew<vtkMultiThreader> Threader;
+  vtkSharedData SharedData;
+
+  bool HasWorkers() const { return !this->RunningThreadIds.empty(); }
+
+  void TerminateAllWorkers()
+  {
+    if (this->RunningThreadIds.empty())
+    {
+      return;
+    }
+    this->SharedData.RequestWorkersToEnd();
+    while (!this->RunningThreadIds.empty())
+    {
+      this->Threader->TerminateThread(this->RunningThreadIds.back());
+      this->RunningThreadIds.pop_back();
+    }
+    this->SharedData.Reset();
+  }
+
+  void SpawnWorkers(vtkTypeUInt32 numberOfThreads)
+  {
+    for (vtkTypeUInt32 cc = 0; cc < numberOfThreads; cc++)
+    {
+      this->RunningThreadIds.push_back(this->Threader->SpawnThread(&Worker, &this->SharedData));
+    }
+  }
+};
+
+vtkStandardNewMacro(vtkThreadedWriter);
+//----------------------------------------------------------------------------
+vtkThreadedWriter::vtkThreadedWriter()
+  : Internals(new vtkInternals())
+{
+  this->MaxThreads = 1;
+  this->MaxQueueSize = 2;
+  this->DeepCopyInput = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkThreadedWriter::~vtkThreadedWriter()
+{
+  this->Internals->TerminateAllWorkers();
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedWriter::SetMaxThreads(vtkTypeUInt32 maxThreads)
+{
+  if (maxThreads < MAX_NUMBER_OF_THREADS_IN_POOL && maxThreads > 0 &&
+    this->MaxThreads != maxThreads)
+  {
+    this->MaxThreads = maxThreads;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadedWriter::Write(vtkDataObject* data, vtkAlgorithm* writer)
+{
+  // Error checking
+  if (data == nullptr || writer == nullptr)
+  {
+    vtkErrorMacro(<< "Write:Please specify both the data and its writer!");
+    return 0;
+  }
+
+  vtkSharedData::JobType job;
+  job.Data.TakeReference(data->NewInstance());
+  if (this->DeepCopyInput)
+  {
+    job.Data->DeepCopy(data);
+  }
+  else
+  {
+    job.Data->ShallowCopy(data);
+
+    // The shallow copy of a tree shares its leaves with the caller, who
+    // may modify them while a worker writes, so give it its own leaves.
+    vtkDataObjectTree* tree = vtkDataObjectTree::SafeDownCast(data);
+    if (tree)
+    {
+      vtkDataObjectTree* copy = vtkDataObjectTree::SafeDownCast(job.Data);
+      vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+      iter.TakeReference(tree->NewTreeIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        vtkDataObject* leaf = iter->GetCurrentDataObject();
+        vtkSmartPointer<vtkDataObject> leafCopy;
+        leafCopy.TakeReference(leaf->NewInstance());
+        leafCopy->ShallowCopy(leaf);
+        copy->SetDataSetFrom(iter, leafCopy);
+      }
+    }
+  }
+  job.Writer = writer;
+
+  if (!this->Internals->HasWorkers())
+  {
+    this->Internals->SpawnWorkers(this->MaxThreads);
+  }
+  this->Internals->SharedData.PushJob(job, static_cast<std::size_t>(this->MaxQueueSize));
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedWriter::Flush()
+{
+  if (this->Internals->HasWorkers())
+  {
+    this->Internals->SharedData.WaitForJobs();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedWriter::Finalize()
+{
+  this->Internals->TerminateAllWorkers();
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadedWriter::GetNumberOfFailedWrites()
+{
+  return this->Internals->SharedData.GetFailedJobCount();
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "MaxThreads: " << this->MaxThreads << endl;
+  os << indent << "MaxQueueSize: " << this->MaxQueueSize << endl;
+  os << indent << "DeepCopyInput: " << this->DeepCopyInput << endl;
+}
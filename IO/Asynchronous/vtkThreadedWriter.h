@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class    vtkThreadedWriter
+ * @brief    class used to run any writer on worker threads so that the
+ *           caller does not wait for the data to be encoded and written.
+ *
+ * @details  Each call to Write() copies the given data object and queues it
+ *           with the writer that should write it, for instance a
+ *           vtkXMLPUnstructuredGridWriter or a vtkXMLMultiBlockDataWriter
+ *           with its file name already set. A pool of worker threads then
+ *           updates the queued writers. The writes start in the order of the
+ *           calls to Write(), but with more than one thread they may complete
+ *           in any order. When MaxQueueSize writes are waiting, Write()
+ *           blocks until a worker takes one, so that a fast producer cannot
+ *           exhaust the memory. Flush() waits for all the queued writes to
+ *           complete.
+ *
+ *           The writer given to Write() is used by a worker thread until the
+ *           write completes, so it must not be modified or given to Write()
+ *           again before Flush() returns; use a new writer for each write
+ *           instead.
+ *
+ * @sa vtkThreadedImageWriter
+ */
+
+#ifndef vtkThreadedWriter_h
+#define vtkThreadedWriter_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkDataObject;
+
+class VTKIOASYNCHRONOUS_EXPORT vtkThreadedWriter : public vtkObject
+{
+public:
+  static vtkThreadedWriter* New();
+  vtkTypeMacro(vtkThreadedWriter, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Queue the writing of data with the given writer, which is connected to
+   * a copy of data on input port 0. The worker threads are started by the
+   * first call. Returns 0 if data or writer is missing.
+   */
+  int Write(vtkDataObject* data, vtkAlgorithm* writer);
+
+  /**
+   * Wait until all the queued writes have completed.
+   */
+  void Flush();
+
+  /**
+   * Wait for the queued writes to complete and stop the worker threads.
+   * They are started again by the next Write().
+   */
+  void Finalize();
+
+  /**
+   * Define the number of worker threads to use. It takes effect the next
+   * time the workers are started. Defaults to 1.
+   */
+  void SetMaxThreads(vtkTypeUInt32);
+  vtkGetMacro(MaxThreads, vtkTypeUInt32);
+
+  //@{
+  /**
+   * The number of writes that can wait in the queue before Write() blocks.
+   * Defaults to 2.
+   */
+  vtkSetClampMacro(MaxQueueSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaxQueueSize, int);
+  //@}
+
+  //@{
+  /**
+   * By default Write() makes a shallow copy of the data, and of each leaf
+   * of a composite dataset, which is enough when the caller replaces its
+   * arrays rather than modifying them in place. Turn this on to make a
+   * deep copy otherwise.
+   */
+  vtkSetMacro(DeepCopyInput, vtkTypeBool);
+  vtkGetMacro(DeepCopyInput, vtkTypeBool);
+  vtkBooleanMacro(DeepCopyInput, vtkTypeBool);
+  //@}
+
+  /**
+   * The number of writers that reported an error since this object was
+   * created.
+   */
+  int GetNumberOfFailedWrites();
+
+protected:
+  vtkThreadedWriter();
+  ~vtkThreadedWriter() override;
+
+private:
+  vtkThreadedWriter(const vtkThreadedWriter&) = delete;
+  void operator=(const vtkThreadedWriter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+  vtkTypeUInt32 MaxThreads;
+  int MaxQueueSize;
+  vtkTypeBool DeepCopyInput;
+};
+
+#endif
@@ -105,6 +105,15 @@ public:
   virtual void SetCompressionLevel(int compressionLevel) = 0;
   virtual int GetCompressionLevel() = 0;
 
+  /**
+   * Return true if Compress and Uncompress may be called concurrently
+   * from several threads on independent buffers.  The XML readers and
+   * writers then process several blocks at once on the SMP backend.
+   * Subclasses that keep any state between calls must leave this
+   * returning false, the default.
+   */
+  virtual bool IsThreadSafe() { return false; }
+
 protected:
   vtkDataCompressor();
   ~vtkDataCompressor() override;
@@ -54,6 +54,12 @@ public:
   vtkSetClampMacro(AccelerationLevel, int, 1, VTK_INT_MAX);
   vtkGetMacro(AccelerationLevel, int);
 
+  /**
+   * Returns true; the LZ4 one-shot functions allocate their state on
+   * the stack.
+   */
+  bool IsThreadSafe() override { return true; }
+
 protected:
   vtkLZ4DataCompressor();
   ~vtkLZ4DataCompressor() override;
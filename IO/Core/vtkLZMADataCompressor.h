@@ -57,6 +57,11 @@ public:
   // Compression level getter required by vtkDataCompressor.
   int  GetCompressionLevel() override;
 
+  /**
+   * Returns true.  Each call uses its own lzma buffer coder.
+   */
+  bool IsThreadSafe() override { return true; }
+
 protected:
   vtkLZMADataCompressor();
   ~vtkLZMADataCompressor() override;
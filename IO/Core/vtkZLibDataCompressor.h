@@ -52,6 +52,11 @@ public:
   void SetCompressionLevel(int compressionLevel) override;
   //@}
 
+  /**
+   * compress2 and uncompress work only on the given buffers.
+   */
+  bool IsThreadSafe() override { return true; }
+
 protected:
   vtkZLibDataCompressor();
   ~vtkZLibDataCompressor() override;
@@ -0,0 +1,210 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusParallelAssembly.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkExodusIIReader produces the same blocks whether they are
+// assembled serially or in parallel.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkExodusIIReader.h"
+#include "vtkExodusIIWriter.h"
+#include "vtkIdList.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+
+namespace
+{
+
+// A row of hexahedra along x, shifted along y by the block index, whose
+// middle points are shared by two cells.
+vtkSmartPointer<vtkUnstructuredGrid> MakeBlock(int block)
+{
+  const int numberOfCells = 4 + 3 * block;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> temperature;
+  temperature->SetName("Temperature");
+  for (int i = 0; i <= numberOfCells; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      points->InsertNextPoint(i, 2 * block + (j & 1), j >> 1);
+      temperature->InsertNextValue(1000. * block + points->GetNumberOfPoints());
+    }
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(temperature);
+
+  vtkNew<vtkDoubleArray> pressure;
+  pressure->SetName("Pressure");
+  grid->Allocate(numberOfCells);
+  for (int i = 0; i < numberOfCells; ++i)
+  {
+    vtkIdType ids[8] = { 4 * i, 4 * i + 4, 4 * i + 5, 4 * i + 1, 4 * i + 2, 4 * i + 6, 4 * i + 7,
+      4 * i + 3 };
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+    pressure->InsertNextValue(100. * block + i);
+  }
+  grid->GetCellData()->AddArray(pressure);
+  return grid;
+}
+
+vtkMultiBlockDataSet* Read(const std::string& fileName, bool parallel)
+{
+  vtkExodusIIReader* reader = vtkExodusIIReader::New();
+  reader->SetFileName(fileName.c_str());
+  reader->SetParallelAssembly(parallel);
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+  reader->GenerateGlobalNodeIdArrayOn();
+  reader->Update();
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  if (output)
+  {
+    output->Register(nullptr);
+  }
+  reader->Delete();
+  return output;
+}
+
+bool SameArrays(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* x = a->GetArray(i);
+    vtkDataArray* y = x ? b->GetArray(x->GetName()) : nullptr;
+    if (!x || !y || x->GetNumberOfTuples() != y->GetNumberOfTuples() ||
+      x->GetNumberOfComponents() != y->GetNumberOfComponents())
+    {
+      return false;
+    }
+    for (vtkIdType t = 0; t < x->GetNumberOfTuples(); ++t)
+    {
+      for (int c = 0; c < x->GetNumberOfComponents(); ++c)
+      {
+        if (x->GetComponent(t, c) != y->GetComponent(t, c))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool SameBlocks(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  if (!a || !b || a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    a->GetPoint(i, x);
+    b->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> x;
+  vtkNew<vtkIdList> y;
+  for (vtkIdType i = 0; i < a->GetNumberOfCells(); ++i)
+  {
+    a->GetCellPoints(i, x);
+    b->GetCellPoints(i, y);
+    if (a->GetCellType(i) != b->GetCellType(i) || x->GetNumberOfIds() != y->GetNumberOfIds())
+    {
+      return false;
+    }
+    for (vtkIdType j = 0; j < x->GetNumberOfIds(); ++j)
+    {
+      if (x->GetId(j) != y->GetId(j))
+      {
+        return false;
+      }
+    }
+  }
+  return SameArrays(a->GetPointData(), b->GetPointData()) &&
+    SameArrays(a->GetCellData(), b->GetCellData());
+}
+
+} // anonymous namespace
+
+int TestExodusParallelAssembly(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestExodusParallelAssembly.exo";
+  delete[] tempDir;
+
+  const int numberOfBlocks = 6;
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(numberOfBlocks);
+  for (int b = 0; b < numberOfBlocks; ++b)
+  {
+    input->SetBlock(b, MakeBlock(b));
+  }
+  vtkNew<vtkExodusIIWriter> writer;
+  writer->SetInputData(input);
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+
+  vtkMultiBlockDataSet* serial = Read(fileName, false);
+  vtkMultiBlockDataSet* parallel = Read(fileName, true);
+  int status = EXIT_SUCCESS;
+  if (!serial || !parallel || serial->GetNumberOfBlocks() != numberOfBlocks ||
+    parallel->GetNumberOfBlocks() != numberOfBlocks)
+  {
+    cerr << "Expected " << numberOfBlocks << " element blocks." << endl;
+    status = EXIT_FAILURE;
+  }
+  for (int b = 0; status == EXIT_SUCCESS && b < numberOfBlocks; ++b)
+  {
+    vtkUnstructuredGrid* a = vtkUnstructuredGrid::SafeDownCast(serial->GetBlock(b));
+    vtkUnstructuredGrid* p = vtkUnstructuredGrid::SafeDownCast(parallel->GetBlock(b));
+    if (!SameBlocks(a, p) || !a->GetPointData()->GetArray("Temperature") ||
+      a->GetNumberOfCells() != 4 + 3 * b)
+    {
+      cerr << "Block " << b << " differs when assembled in parallel." << endl;
+      status = EXIT_FAILURE;
+    }
+  }
+  if (serial)
+  {
+    serial->UnRegister(nullptr);
+  }
+  if (parallel)
+  {
+    parallel->UnRegister(nullptr);
+  }
+  return status;
+}
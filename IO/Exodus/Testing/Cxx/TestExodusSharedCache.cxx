@@ -0,0 +1,264 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusSharedCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the compression of vtkExodusIICache, and the shared cache and the
+// prefetching of vtkExodusIIReader on a file written with vtkExodusIIWriter.
+
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkExodusIICache.h"
+#include "vtkExodusIIReader.h"
+#include "vtkExodusIIWriter.h"
+#include "vtkHexahedron.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridAlgorithm.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+
+// A row of hexahedra whose point and cell values change with the time step.
+class vtkExodusTimeSource : public vtkUnstructuredGridAlgorithm
+{
+public:
+  static vtkExodusTimeSource* New();
+  vtkTypeMacro(vtkExodusTimeSource, vtkUnstructuredGridAlgorithm);
+
+protected:
+  vtkExodusTimeSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double times[] = { 0., 1., 2., 3. };
+    double range[] = { 0., 3. };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), times, 4);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkUnstructuredGrid* output = vtkUnstructuredGrid::GetData(outInfo);
+    double time = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      : 0.;
+    time = std::floor(time + 0.5);
+
+    const int numberOfCells = 8;
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkDoubleArray> temperature;
+    temperature->SetName("Temperature");
+    for (int i = 0; i <= numberOfCells; ++i)
+    {
+      for (int j = 0; j < 4; ++j)
+      {
+        points->InsertNextPoint(i, j & 1, j >> 1);
+        temperature->InsertNextValue(100. * time + points->GetNumberOfPoints());
+      }
+    }
+    output->SetPoints(points);
+    output->GetPointData()->AddArray(temperature);
+
+    vtkNew<vtkDoubleArray> pressure;
+    pressure->SetName("Pressure");
+    output->Allocate(numberOfCells);
+    for (int i = 0; i < numberOfCells; ++i)
+    {
+      vtkIdType ids[8] = { 4 * i, 4 * i + 4, 4 * i + 5, 4 * i + 1, 4 * i + 2, 4 * i + 6,
+        4 * i + 7, 4 * i + 3 };
+      output->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+      pressure->InsertNextValue(10. * time + i);
+    }
+    output->GetCellData()->AddArray(pressure);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+
+private:
+  vtkExodusTimeSource(const vtkExodusTimeSource&) = delete;
+  void operator=(const vtkExodusTimeSource&) = delete;
+};
+
+vtkStandardNewMacro(vtkExodusTimeSource);
+
+vtkDataArray* GetElementArray(vtkExodusIIReader* reader, const char* name)
+{
+  vtkMultiBlockDataSet* blocks =
+    vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  vtkDataSet* block = blocks ? vtkDataSet::SafeDownCast(blocks->GetBlock(0)) : nullptr;
+  return block ? block->GetCellData()->GetArray(name) : nullptr;
+}
+
+vtkExodusIIReader* NewReader(const std::string& fileName)
+{
+  vtkExodusIIReader* reader = vtkExodusIIReader::New();
+  reader->SetFileName(fileName.c_str());
+  reader->SetCacheSize(16.);
+  reader->UseSharedCacheOn();
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+  return reader;
+}
+
+bool TestCompression()
+{
+  vtkNew<vtkExodusIICache> cache;
+  cache->SetCacheCapacity(1.);
+  cache->SetCompressColdEntries(true);
+
+  // Four arrays of 0.5 MiB only fit in 1 MiB when compressed.
+  const vtkIdType numberOfValues = 65536;
+  for (int a = 0; a < 4; ++a)
+  {
+    vtkDoubleArray* array = vtkDoubleArray::New();
+    array->SetNumberOfValues(numberOfValues);
+    for (vtkIdType i = 0; i < numberOfValues; ++i)
+    {
+      array->SetValue(i, a + (i % 16));
+    }
+    vtkExodusIICacheKey key(0, vtkExodusIIReader::NODAL, 0, a);
+    cache->Insert(key, array);
+    array->FastDelete();
+  }
+
+  for (int a = 0; a < 4; ++a)
+  {
+    vtkExodusIICacheKey key(0, vtkExodusIIReader::NODAL, 0, a);
+    if (!cache->Contains(key))
+    {
+      cerr << "Array " << a << " was dropped instead of compressed." << endl;
+      return false;
+    }
+    vtkDataArray* array = cache->Lookup(key);
+    bool valid = array && array->GetNumberOfTuples() == numberOfValues;
+    for (vtkIdType i = 0; valid && i < numberOfValues; ++i)
+    {
+      valid = array->GetTuple1(i) == a + (i % 16);
+    }
+    if (array)
+    {
+      array->Delete();
+    }
+    if (!valid)
+    {
+      cerr << "Array " << a << " was not restored from its compressed values." << endl;
+      return false;
+    }
+    // Restored arrays still count against the capacity.
+    if (cache->GetSpaceLeft() < 0.)
+    {
+      cerr << "Restoring array " << a << " exceeded the cache capacity." << endl;
+      return false;
+    }
+  }
+
+  vtkExodusIICache* shared = vtkExodusIICache::AcquireSharedCache("shared.exo");
+  vtkExodusIICache* again = vtkExodusIICache::AcquireSharedCache("shared.exo");
+  vtkExodusIICache* other = vtkExodusIICache::AcquireSharedCache("other.exo");
+  bool valid = shared == again && shared != other;
+  vtkExodusIICache::ReleaseSharedCache(shared);
+  vtkExodusIICache::ReleaseSharedCache(again);
+  vtkExodusIICache::ReleaseSharedCache(other);
+  if (!valid)
+  {
+    cerr << "The shared caches do not match the file names." << endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestSharedCache(const std::string& fileName)
+{
+  vtkNew<vtkExodusTimeSource> source;
+  vtkNew<vtkExodusIIWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->WriteAllTimeStepsOn();
+  writer->Write();
+
+  vtkExodusIIReader* first = NewReader(fileName);
+  vtkExodusIIReader* second = NewReader(fileName);
+  first->UpdateTimeStep(1.);
+  second->UpdateTimeStep(1.);
+
+  vtkDataArray* pressure = GetElementArray(first, "Pressure");
+  bool valid = pressure && pressure == GetElementArray(second, "Pressure") &&
+    pressure->GetTuple1(3) == 13.;
+  if (!valid)
+  {
+    cerr << "The readers did not share the array of time step 1." << endl;
+  }
+
+  // The arrays of time step 2 are read in the background, into the shared cache.
+  first->PrefetchNextTimeStepOn();
+  first->Modified();
+  first->UpdateTimeStep(1.);
+  first->WaitForPrefetch();
+  vtkExodusIICache* cache = vtkExodusIICache::AcquireSharedCache(fileName.c_str());
+  vtkExodusIICacheKey key(2, vtkExodusIIReader::ELEM_BLOCK, 0, 0);
+  if (valid && !cache->Contains(key))
+  {
+    cerr << "The array of time step 2 was not prefetched." << endl;
+    valid = false;
+  }
+  vtkDataArray* prefetched = cache->Lookup(key);
+  second->UpdateTimeStep(2.);
+  pressure = GetElementArray(second, "Pressure");
+  if (valid && (!pressure || pressure != prefetched || pressure->GetTuple1(3) != 23.))
+  {
+    cerr << "The prefetched array of time step 2 was not used." << endl;
+    valid = false;
+  }
+  if (prefetched)
+  {
+    prefetched->Delete();
+  }
+  vtkExodusIICache::ReleaseSharedCache(cache);
+
+  first->Delete();
+  second->Delete();
+  return valid;
+}
+
+} // anonymous namespace
+
+int TestExodusSharedCache(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestExodusSharedCache.exo";
+  delete[] tempDir;
+
+  if (!TestCompression() || !TestSharedCache(fileName))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
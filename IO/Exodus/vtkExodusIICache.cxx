@@ -2,6 +2,13 @@
 
 #include "vtkDataArray.h"
 #include "vtkObjectFactory.h"
+#include "vtk_lz4.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <iterator>
+#include <mutex>
+#include <sstream>
 
 // Define VTK_EXO_DBG_CACHE to print cache adds, drops, and replacements.
 //#undef VTK_EXO_DBG_CACHE
@@ -31,15 +38,44 @@ static void printCache( vtkExodusIICacheSet& cache, vtkExodusIICacheLRU& lru )
 }
 #endif // 0
 
+// ============================================================================
+namespace
+{
+// The caches shared by the readers of each file.
+struct vtkExodusIISharedCaches
+{
+  std::mutex Mutex;
+  std::map<std::string,vtkExodusIICache*> Caches;
+};
+
+vtkExodusIISharedCaches& GetSharedCaches()
+{
+  static vtkExodusIISharedCaches caches;
+  return caches;
+}
+
+// Locks a vtkSimpleMutexLock for the lifetime of the guard.
+class vtkExodusIICacheGuard
+{
+public:
+  vtkExodusIICacheGuard( vtkSimpleMutexLock& lock ) : Lock( lock ) { this->Lock.Lock(); }
+  ~vtkExodusIICacheGuard() { this->Lock.Unlock(); }
+private:
+  vtkSimpleMutexLock& Lock;
+};
+}
+
 // ============================================================================
 vtkExodusIICacheEntry::vtkExodusIICacheEntry()
 {
   this->Value = nullptr;
+  this->NumberOfTuples = 0;
 }
 
 vtkExodusIICacheEntry::vtkExodusIICacheEntry( vtkDataArray* arr )
 {
   this->Value = arr;
+  this->NumberOfTuples = 0;
   if ( arr )
     this->Value->Register( nullptr );
 }
@@ -52,10 +88,18 @@ vtkExodusIICacheEntry::~vtkExodusIICacheEntry()
 vtkExodusIICacheEntry::vtkExodusIICacheEntry( const vtkExodusIICacheEntry& other )
 {
   this->Value = other.Value;
+  this->Compressed = other.Compressed;
+  this->NumberOfTuples = other.NumberOfTuples;
   if ( this->Value )
     this->Value->Register( nullptr );
 }
 
+double vtkExodusIICacheEntry::GetSize() const
+{
+  double size = this->Value ? this->Value->GetActualMemorySize() / 1024. : 0.;
+  return size + this->Compressed.size() / ( 1024. * 1024. );
+}
+
 #if 0
 void printLRUBack( vtkExodusIICacheRef& cit )
 {
@@ -71,20 +115,80 @@ vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
   this->Capacity = 2.;
+  this->CompressColdEntries = false;
 }
 
 vtkExodusIICache::~vtkExodusIICache()
 {
-  this->ReduceToSize( 0. );
+  this->ReduceToSizeInternal( 0. );
 }
 
 void vtkExodusIICache::PrintSelf( ostream& os, vtkIndent indent )
 {
   this->Superclass::PrintSelf( os, indent );
+  vtkExodusIICacheGuard guard( this->Lock );
   os << indent << "Capacity: " << this->Capacity << " MiB\n";
   os << indent << "Size: " << this->Size << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "CompressColdEntries: " << this->CompressColdEntries << "\n";
+  os << indent << "Shared: " << ( this->SharedKey.empty() ? "no" : this->SharedKey.c_str() ) << "\n";
+}
+
+vtkExodusIICache* vtkExodusIICache::AcquireSharedCache( const char* fileName )
+{
+  if ( ! fileName )
+    return nullptr;
+
+  std::string path = vtksys::SystemTools::CollapseFullPath( fileName );
+  std::ostringstream key;
+  key << path << ":" << vtksys::SystemTools::ModifiedTime( path );
+
+  vtkExodusIISharedCaches& shared = GetSharedCaches();
+  std::lock_guard<std::mutex> lock( shared.Mutex );
+  vtkExodusIICache*& cache = shared.Caches[key.str()];
+  if ( ! cache )
+  {
+    // The list holds one reference and the caller another.
+    cache = vtkExodusIICache::New();
+    cache->SharedKey = key.str();
+  }
+  cache->Register( nullptr );
+  return cache;
+}
+
+void vtkExodusIICache::ReleaseSharedCache( vtkExodusIICache* cache )
+{
+  if ( ! cache )
+    return;
+
+  vtkExodusIISharedCaches& shared = GetSharedCaches();
+  std::lock_guard<std::mutex> lock( shared.Mutex );
+  std::map<std::string,vtkExodusIICache*>::iterator it = shared.Caches.find( cache->SharedKey );
+  if ( it != shared.Caches.end() && it->second == cache && cache->GetReferenceCount() == 2 )
+  {
+    shared.Caches.erase( it );
+    cache->UnRegister( nullptr );
+  }
+  cache->UnRegister( nullptr );
+}
+
+void vtkExodusIICache::SetCompressColdEntries( bool compress )
+{
+  vtkExodusIICacheGuard guard( this->Lock );
+  this->CompressColdEntries = compress;
+}
+
+bool vtkExodusIICache::GetCompressColdEntries()
+{
+  vtkExodusIICacheGuard guard( this->Lock );
+  return this->CompressColdEntries;
+}
+
+double vtkExodusIICache::GetSpaceLeft()
+{
+  vtkExodusIICacheGuard guard( this->Lock );
+  return this->Capacity - this->Size;
 }
 
 void vtkExodusIICache::Clear()
@@ -95,50 +199,54 @@ void vtkExodusIICache::Clear()
 
 void vtkExodusIICache::SetCacheCapacity( double sizeInMiB )
 {
+  vtkExodusIICacheGuard guard( this->Lock );
   if ( sizeInMiB == this->Capacity )
     return;
 
   if ( this->Size > sizeInMiB )
   {
-    this->ReduceToSize( sizeInMiB );
+    this->ReduceToSizeInternal( sizeInMiB );
   }
 
   this->Capacity =  sizeInMiB < 0 ? 0 : sizeInMiB;
 }
 
 int vtkExodusIICache::ReduceToSize( double newSize )
+{
+  vtkExodusIICacheGuard guard( this->Lock );
+  return this->ReduceToSizeInternal( newSize );
+}
+
+int vtkExodusIICache::ReduceToSizeInternal( double newSize, size_t keep )
 {
   int deletedSomething = 0;
-  while ( this->Size > newSize && ! this->LRU.empty() )
+
+  // Compress the coldest arrays first, and only drop them if that is not enough.
+  if ( this->CompressColdEntries && newSize > 0 && this->LRU.size() > keep )
   {
-    vtkExodusIICacheRef cit( this->LRU.back() );
-    vtkDataArray* arr = cit->second->Value;
-    if ( arr )
+    vtkExodusIICacheLRU::reverse_iterator rit;
+    vtkExodusIICacheLRU::reverse_iterator rend = this->LRU.rend();
+    std::advance( rend, -static_cast<std::ptrdiff_t>( keep ) );
+    for ( rit = this->LRU.rbegin(); rit != rend && this->Size > newSize; ++rit )
     {
-      deletedSomething = 1;
-      double arrSz = (double) arr->GetActualMemorySize() / 1024.;
-      this->Size -= arrSz;
-#ifdef VTK_EXO_DBG_CACHE
-      cout << "Dropping " << VTK_EXO_PRT_KEY( cit->first ) << VTK_EXO_PRT_ARR( arr ) << "\n";
-#endif // VTK_EXO_DBG_CACHE
-      if ( this->Size <= 0 )
+      if ( ! (*rit)->second->IsCompressed() && this->Compress( (*rit)->second ) )
       {
-        if ( this->Cache.empty() )
-          this->Size = 0.;
-        else
-          this->RecomputeSize(); // oops, FP roundoff
+        deletedSomething = 1;
       }
     }
-    else
+  }
+
+  while ( this->Size > newSize && this->LRU.size() > keep )
+  {
+    vtkExodusIICacheRef cit( this->LRU.back() );
+    if ( cit->second->Value )
     {
+      deletedSomething = 1;
+    }
 #ifdef VTK_EXO_DBG_CACHE
-      cout << "Dropping " << VTK_EXO_PRT_KEY( cit->first ) << VTK_EXO_PRT_ARR( arr ) << "\n";
+    cout << "Dropping " << VTK_EXO_PRT_KEY( cit->first ) << VTK_EXO_PRT_ARR( cit->second->Value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    }
-
-    delete cit->second;
-    this->Cache.erase( cit );
-    this->LRU.pop_back();
+    this->Drop( cit );
   }
 
   if ( this->Cache.empty() )
@@ -151,6 +259,7 @@ int vtkExodusIICache::ReduceToSize( double newSize )
 
 void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
 {
+  vtkExodusIICacheGuard guard( this->Lock );
   double vsize = value ? value->GetActualMemorySize() / 1024. : 0.;
 
   vtkExodusIICacheRef it = this->Cache.find( key );
@@ -160,25 +269,33 @@ void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
       return;
 
     // Remove existing array and put in our new one.
-    this->Size -= vsize;
+    this->Size -= it->second->GetSize();
     if ( this->Size <= 0 )
     {
       this->RecomputeSize();
     }
-    this->ReduceToSize( this->Capacity - vsize );
-    it->second->Value->Delete();
+    // Keep the entry out of the LRU list while making space so it is not dropped.
+    this->LRU.erase( it->second->LRUEntry );
+    this->ReduceToSizeInternal( this->Capacity - vsize );
+    if ( it->second->Value )
+    {
+      it->second->Value->Delete();
+    }
     it->second->Value = value;
-    it->second->Value->Register( nullptr ); // Since we re-use the cache entry, the constructor's Register won't get called.
+    it->second->Compressed.clear();
+    if ( value )
+    {
+      value->Register( nullptr ); // Since we re-use the cache entry, the constructor's Register won't get called.
+    }
     this->Size += vsize;
 #ifdef VTK_EXO_DBG_CACHE
     cout << "Replacing " << VTK_EXO_PRT_KEY( it->first ) << VTK_EXO_PRT_ARR( value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    this->LRU.erase( it->second->LRUEntry );
     it->second->LRUEntry = this->LRU.insert( this->LRU.begin(), it );
   }
   else
   {
-    this->ReduceToSize( this->Capacity - vsize );
+    this->ReduceToSizeInternal( this->Capacity - vsize );
     std::pair<const vtkExodusIICacheKey,vtkExodusIICacheEntry*> entry( key, new vtkExodusIICacheEntry(value) );
     std::pair<vtkExodusIICacheSet::iterator, bool> iret = this->Cache.insert( entry );
     this->Size += vsize;
@@ -191,14 +308,35 @@ void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
 }
 
 vtkDataArray*& vtkExodusIICache::Find( const vtkExodusIICacheKey& key )
+{
+  vtkExodusIICacheGuard guard( this->Lock );
+  return this->FindInternal( key );
+}
+
+vtkDataArray*& vtkExodusIICache::FindInternal( const vtkExodusIICacheKey& key )
 {
   static vtkDataArray* dummy = nullptr;
 
   vtkExodusIICacheRef it = this->Cache.find( key );
+  bool decompressed = false;
+  if ( it != this->Cache.end() && it->second->IsCompressed() )
+  {
+    decompressed = this->Decompress( it->second );
+    if ( ! decompressed )
+    {
+      this->Drop( it );
+      it = this->Cache.end();
+    }
+  }
   if ( it != this->Cache.end() )
   {
     this->LRU.erase( it->second->LRUEntry );
     it->second->LRUEntry = this->LRU.insert( this->LRU.begin(), it );
+    // The decompressed values may not fit; make room for them with the other entries.
+    if ( decompressed && this->Size > this->Capacity )
+    {
+      this->ReduceToSizeInternal( this->Capacity, 1 );
+    }
     return it->second->Value;
   }
 
@@ -206,30 +344,33 @@ vtkDataArray*& vtkExodusIICache::Find( const vtkExodusIICacheKey& key )
   return dummy;
 }
 
+vtkDataArray* vtkExodusIICache::Lookup( const vtkExodusIICacheKey& key )
+{
+  vtkExodusIICacheGuard guard( this->Lock );
+  vtkDataArray* arr = this->FindInternal( key );
+  if ( arr )
+  {
+    arr->Register( nullptr );
+  }
+  return arr;
+}
+
+bool vtkExodusIICache::Contains( const vtkExodusIICacheKey& key )
+{
+  vtkExodusIICacheGuard guard( this->Lock );
+  return this->Cache.find( key ) != this->Cache.end();
+}
+
 int vtkExodusIICache::Invalidate( const vtkExodusIICacheKey& key )
 {
+  vtkExodusIICacheGuard guard( this->Lock );
   vtkExodusIICacheRef it = this->Cache.find( key );
   if ( it != this->Cache.end() )
   {
 #ifdef VTK_EXO_DBG_CACHE
     cout << "Dropping " << VTK_EXO_PRT_KEY( it->first ) << VTK_EXO_PRT_ARR( it->second->Value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    this->LRU.erase( it->second->LRUEntry );
-    if ( it->second->Value )
-    {
-      this->Size -= it->second->Value->GetActualMemorySize() / 1024.;
-    }
-    delete it->second;
-    this->Cache.erase( it );
-
-    if ( this->Size <= 0 )
-    {
-      if ( this->Cache.empty() )
-        this->Size = 0.;
-      else
-        this->RecomputeSize(); // oops, FP roundoff
-    }
-
+    this->Drop( it );
     return 1;
   }
   return 0;
@@ -237,6 +378,7 @@ int vtkExodusIICache::Invalidate( const vtkExodusIICacheKey& key )
 
 int vtkExodusIICache::Invalidate( const vtkExodusIICacheKey& key, const vtkExodusIICacheKey& pattern )
 {
+  vtkExodusIICacheGuard guard( this->Lock );
   vtkExodusIICacheRef it;
   int nDropped = 0;
   it = this->Cache.begin();
@@ -251,37 +393,90 @@ int vtkExodusIICache::Invalidate( const vtkExodusIICacheKey& key, const vtkExodu
 #ifdef VTK_EXO_DBG_CACHE
     cout << "Dropping " << VTK_EXO_PRT_KEY( it->first ) << VTK_EXO_PRT_ARR( it->second->Value ) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    this->LRU.erase( it->second->LRUEntry );
-    if ( it->second->Value )
-    {
-      this->Size -= it->second->Value->GetActualMemorySize() / 1024.;
-    }
     vtkExodusIICacheRef tmpIt = it++;
-    delete tmpIt->second;
-    this->Cache.erase( tmpIt );
-
-    if ( this->Size <= 0 )
-    {
-      if ( this->Cache.empty() )
-        this->Size = 0.;
-      else
-        this->RecomputeSize(); // oops, FP roundoff
-    }
-
+    this->Drop( tmpIt );
     ++nDropped;
   }
   return nDropped;
 }
 
+void vtkExodusIICache::Drop( vtkExodusIICacheRef it )
+{
+  this->LRU.erase( it->second->LRUEntry );
+  this->Size -= it->second->GetSize();
+  delete it->second;
+  this->Cache.erase( it );
+
+  if ( this->Size <= 0 )
+  {
+    if ( this->Cache.empty() )
+      this->Size = 0.;
+    else
+      this->RecomputeSize(); // oops, FP roundoff
+  }
+}
+
+bool vtkExodusIICache::Compress( vtkExodusIICacheEntry* entry )
+{
+  vtkDataArray* arr = entry->Value;
+  if ( ! arr || ! arr->HasStandardMemoryLayout() || arr->GetNumberOfTuples() == 0 )
+  {
+    return false;
+  }
+  vtkIdType rawSize = arr->GetNumberOfValues() * arr->GetDataTypeSize();
+  if ( rawSize > LZ4_MAX_INPUT_SIZE )
+  {
+    return false;
+  }
+  std::vector<char> compressed( LZ4_compressBound( static_cast<int>( rawSize ) ) );
+  int size = LZ4_compress_default( static_cast<const char*>( arr->GetVoidPointer( 0 ) ),
+    compressed.data(), static_cast<int>( rawSize ), static_cast<int>( compressed.size() ) );
+  // Not worth it unless the values shrink noticeably.
+  if ( size <= 0 || size > rawSize - rawSize / 8 )
+  {
+    return false;
+  }
+  compressed.resize( size );
+  compressed.shrink_to_fit();
+
+  // Readers may still use the array, so keep its values intact and replace it
+  // with an empty array of the same kind.
+  double oldSize = entry->GetSize();
+  vtkDataArray* shell = arr->NewInstance();
+  shell->SetName( arr->GetName() );
+  shell->SetNumberOfComponents( arr->GetNumberOfComponents() );
+  shell->Squeeze();
+  entry->NumberOfTuples = arr->GetNumberOfTuples();
+  entry->Compressed.swap( compressed );
+  entry->Value = shell;
+  arr->Delete();
+  this->Size += entry->GetSize() - oldSize;
+  return true;
+}
+
+bool vtkExodusIICache::Decompress( vtkExodusIICacheEntry* entry )
+{
+  vtkDataArray* arr = entry->Value;
+  double oldSize = entry->GetSize();
+  arr->SetNumberOfTuples( entry->NumberOfTuples );
+  int rawSize = static_cast<int>( arr->GetNumberOfValues() * arr->GetDataTypeSize() );
+  if ( LZ4_decompress_safe( entry->Compressed.data(), static_cast<char*>( arr->GetVoidPointer( 0 ) ),
+      static_cast<int>( entry->Compressed.size() ), rawSize ) != rawSize )
+  {
+    arr->Initialize();
+    return false;
+  }
+  std::vector<char>().swap( entry->Compressed );
+  this->Size += entry->GetSize() - oldSize;
+  return true;
+}
+
 void vtkExodusIICache::RecomputeSize()
 {
   this->Size = 0.;
   vtkExodusIICacheRef it;
   for ( it = this->Cache.begin(); it != this->Cache.end(); ++it )
   {
-    if ( it->second->Value )
-    {
-      this->Size += (double)it->second->Value->GetActualMemorySize() / 1024.;
-    }
+    this->Size += it->second->GetSize();
   }
 }
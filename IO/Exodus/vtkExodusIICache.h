@@ -22,12 +22,22 @@
 // entries O(1). Each cache entry stores an iterator into
 // the list of references so that it can be located quickly for
 // removal.
+//
+// The cache is thread-safe. AcquireSharedCache() returns a cache
+// shared by everyone reading the same file, so that readers of the
+// same file in different views read each array only once.
+// When CompressColdEntries is on, the least recently used arrays are
+// kept LZ4-compressed rather than dropped when the cache is full; they
+// are only dropped if the cache is still too large once compressed.
 
 #include "vtkIOExodusModule.h" // For export macro
+#include "vtkMutexLock.h" // For vtkSimpleMutexLock
 #include "vtkObject.h"
 
 #include <map> // used for cache storage
 #include <list> // use for LRU ordering
+#include <string> // used for the shared cache key
+#include <vector> // used for compressed values
 
 class VTKIOEXODUS_EXPORT vtkExodusIICacheKey
 {
@@ -117,10 +127,23 @@ public:
 
   vtkDataArray* GetValue() { return this->Value; }
 
+  /// Return whether the values of the array are compressed.
+  bool IsCompressed() const { return !this->Compressed.empty(); }
+
+  /// Return the size of the entry in MiB.
+  double GetSize() const;
+
 protected:
   vtkDataArray* Value;
   vtkExodusIICacheLRURef LRUEntry;
 
+  /** When the entry is compressed, Value is an empty array of the same type,
+    * name and number of components, and Compressed holds the LZ4-compressed
+    * values of its NumberOfTuples tuples.
+    */
+  std::vector<char> Compressed;
+  vtkIdType NumberOfTuples;
+
   friend class vtkExodusIICache;
 };
 
@@ -131,6 +154,22 @@ public:
   vtkTypeMacro(vtkExodusIICache,vtkObject);
   void PrintSelf( ostream& os, vtkIndent indent ) override;
 
+  /** Return the cache shared by everyone reading the given file in this process,
+    * creating it if needed. The file is identified by its full path and
+    * modification time, so a rewritten file gets a new cache.
+    * Each call must be matched by a call to ReleaseSharedCache().
+    */
+  static vtkExodusIICache* AcquireSharedCache( const char* fileName );
+
+  /// Release a cache returned by AcquireSharedCache(), deleting it once unused.
+  static void ReleaseSharedCache( vtkExodusIICache* cache );
+
+  /** Keep the least recently used arrays LZ4-compressed instead of dropping
+    * them when the cache is full. Off by default.
+    */
+  void SetCompressColdEntries( bool compress );
+  bool GetCompressColdEntries();
+
   /// Empty the cache
   void Clear();
 
@@ -141,8 +180,7 @@ public:
     * This is the difference between the capacity and the size of the cache.
     * The result is in MiB.
     */
-  double GetSpaceLeft()
-    { return this->Capacity - this->Size; }
+  double GetSpaceLeft();
 
   /** Remove cache entries until the size of the cache is at or below the given size.
     * Returns a nonzero value if deletions were required.
@@ -154,9 +192,20 @@ public:
 
   /** Determine whether a cache entry exists. If it does, return it -- otherwise return nullptr.
     * If a cache entry exists, it is marked as most recently used.
+    * The returned array may be dropped by other users of a shared cache at any time;
+    * use Lookup() instead for shared caches.
     */
   vtkDataArray*& Find( const vtkExodusIICacheKey& );
 
+  /** Like Find(), but return a new reference to the array that the caller must
+    * release with Delete(), so that the array stays valid while other threads
+    * use the cache.
+    */
+  vtkDataArray* Lookup( const vtkExodusIICacheKey& key );
+
+  /// Determine whether a cache entry exists without marking it as used.
+  bool Contains( const vtkExodusIICacheKey& key );
+
   /** Invalidate a cache entry (drop it from the cache) if the key exists.
     * This does nothing if the cache entry does not exist.
     * Returns 1 if the cache entry existed prior to this call and 0 otherwise.
@@ -185,6 +234,19 @@ protected:
   /// Avoid (some) FP problems
   void RecomputeSize();
 
+  /** The unlocked implementations of ReduceToSize and Find.
+    * ReduceToSizeInternal never drops or compresses the keep most recently used entries.
+    */
+  int ReduceToSizeInternal( double newSize, size_t keep = 0 );
+  vtkDataArray*& FindInternal( const vtkExodusIICacheKey& key );
+
+  /// Compress or decompress the values of an entry, updating the size of the cache.
+  bool Compress( vtkExodusIICacheEntry* entry );
+  bool Decompress( vtkExodusIICacheEntry* entry );
+
+  /// Drop an entry, updating the size of the cache.
+  void Drop( vtkExodusIICacheRef it );
+
   /// The capacity of the cache (i.e., the maximum size of all arrays it contains) in MiB.
   double Capacity;
 
@@ -202,6 +264,14 @@ protected:
   /// The actual LRU list (indices into the cache ordered least to most recently used).
   vtkExodusIICacheLRU LRU;
 
+  bool CompressColdEntries;
+
+  /// Protects all of the above.
+  vtkSimpleMutexLock Lock;
+
+  /// The key of a shared cache in the list of shared caches, empty otherwise.
+  std::string SharedKey;
+
 private:
   vtkExodusIICache( const vtkExodusIICache& ) = delete;
   void operator = ( const vtkExodusIICache& ) = delete;
@@ -23,6 +23,7 @@
 #include "vtkCellData.h"
 #include "vtkCellType.h"
 #include "vtkCharArray.h"
+#include "vtkConditionVariable.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdTypeArray.h"
@@ -32,11 +33,13 @@
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMutableDirectedGraph.h"
+#include "vtkMutexLock.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -54,6 +57,7 @@
 #include <map>
 #include <set>
 #include <deque>
+#include <mutex>
 #include <string>
 #include "vtksys/SystemTools.hxx"
 
@@ -80,6 +84,29 @@
       return 1; \
   }
 
+// netCDF is not thread-safe, so the readers of this process (and their
+// prefetching threads) serialize their calls to the exodus library with this
+// mutex. It is only held for the duration of each call.
+static std::mutex& vtkExodusIIFileMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Call an exodus library function with the file mutex held.
+template <typename Function, typename... Args>
+static auto vtkExodusIICall( Function function, Args... args ) -> decltype( function( args... ) )
+{
+  std::lock_guard<std::mutex> fileLock( vtkExodusIIFileMutex() );
+  return function( args... );
+}
+
+// ex_open is a macro, so it cannot be passed to vtkExodusIICall itself.
+static int vtkExodusIIOpen( const char* path, int mode, int* compWordSize, int* ioWordSize, float* version )
+{
+  return ex_open( path, mode, compWordSize, ioWordSize, version );
+}
+
 // ------------------------------------------------------------------- CONSTANTS
 static int obj_types[] = {
   EX_EDGE_BLOCK,
@@ -371,6 +398,58 @@ void vtkExodusIIReaderPrivate::ArrayInfoType::Reset()
 // ------------------------------------------------------- PRIVATE CLASS MEMBERS
 vtkStandardNewMacro(vtkExodusIIReaderPrivate);
 
+//-----------------------------------------------------------------------------
+struct vtkExodusIIReaderPrivate::AssembleObjectsFunctor
+{
+  struct Object
+  {
+    int ObjectType;
+    int ObjectIndex;
+    int ConnTypeIndex;
+    BlockSetInfoType* Info;
+    vtkUnstructuredGrid* Output;
+  };
+
+  vtkExodusIIReaderPrivate* Self;
+  vtkIdType TimeStep;
+  const std::vector<Object>& Objects;
+
+  AssembleObjectsFunctor( vtkExodusIIReaderPrivate* self, vtkIdType timeStep,
+    const std::vector<Object>& objects )
+    : Self( self ), TimeStep( timeStep ), Objects( objects )
+  {
+  }
+
+  void operator()( vtkIdType begin, vtkIdType end )
+  {
+    for ( vtkIdType i = begin; i < end; ++i )
+    {
+      const Object& object = this->Objects[i];
+      this->Self->AssembleOutputObject( this->TimeStep, object.ObjectType,
+        object.ObjectIndex, object.ConnTypeIndex, object.Info, object.Output );
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+struct vtkExodusIIReaderPrivate::PrefetchState
+{
+  vtkNew<vtkMultiThreader> Threader;
+  int ThreadId = -1;
+  // Held by the prefetching thread while it reads a key, and by the reader
+  // while it requests information or data or resets.
+  std::recursive_mutex ReaderMutex;
+  // Protects the members below and signals their changes.
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable Changed;
+  std::deque<vtkExodusIICacheKey> Pending;
+  // Incremented whenever the queue is replaced or cleared, so that a key taken
+  // from an older queue is not read.
+  unsigned long Generation = 0;
+  bool Busy = false;
+  bool Stop = false;
+};
+
 //-----------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 {
@@ -382,6 +461,13 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
+  this->SharedCache = nullptr;
+  this->UseSharedCache = 0;
+  this->CompressCache = 0;
+  this->HoldArrays = false;
+  this->PrefetchNextTimeStep = 0;
+  this->Prefetch = new PrefetchState;
+  this->ParallelAssembly = 0;
 
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
@@ -413,7 +499,10 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 //-----------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
+  this->StopPrefetch();
+  delete this->Prefetch;
   this->CloseFile();
+  this->UpdateSharedCache( nullptr );
   this->Cache->Delete();
   this->CacheSize = 0;
   this->ClearConnectivityCaches();
@@ -617,9 +706,12 @@ int vtkExodusIIReaderPrivate::AssembleOutputPoints(
   {
     pts->SetNumberOfPoints( bsinfop->NextSqueezePoint );
     std::map<vtkIdType,vtkIdType>::iterator it;
+    double coords[3];
     for ( it = bsinfop->PointMap.begin(); it != bsinfop->PointMap.end(); ++ it )
     {
-      pts->SetPoint( it->second, arr->GetTuple( it->first ) );
+      // GetTuple( i ) is not thread-safe, and arr is shared by all the blocks.
+      arr->GetTuple( it->first, coords );
+      pts->SetPoint( it->second, coords );
     }
   }
   else
@@ -1706,23 +1798,87 @@ void vtkExodusIIReaderPrivate::InsertSetSides(
 //-----------------------------------------------------------------------------
 vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key )
 {
-  vtkDataArray* arr;
-  // Never cache points deflected for a mode shape animation... doubles don't make good keys.
-  if ( this->HasModeShapes && key.ObjectType == vtkExodusIIReader::NODAL_COORDS )
+  if ( this->HoldArrays && key.Time >= 0 && key.ObjectType != vtkExodusIIReader::NODAL_COORDS )
   {
-    arr = nullptr;
+    std::lock_guard<std::mutex> holdLock( this->HoldMutex );
+    this->RequestedKeys.insert( key );
   }
-  else
+
+  vtkDataArray* arr = this->FindArray( key );
+  if ( arr )
   {
-    arr = this->Cache->Find( key );
+    return arr;
   }
 
+  // Only one thread reads the file at a time. Another one may have read the
+  // array while this one was waiting.
+  std::lock_guard<std::recursive_mutex> readLock( this->ReadMutex );
+  arr = this->FindArray( key );
   if ( arr )
   {
-    //
     return arr;
   }
 
+  arr = this->ReadArray( key );
+
+  // Even if the array is larger than the allowable cache size, it will keep the most recent insertion.
+  // So, we delete our reference knowing that the Cache will keep the object "alive" until whatever
+  // called GetCacheOrRead() references the array. But, once you get an array from GetCacheOrRead(),
+  // you better start running!
+  if ( arr )
+  {
+    this->GetCacheForKey( key )->Insert( key, arr );
+    this->HoldArray( key, arr );
+    arr->FastDelete();
+  }
+  return arr;
+}
+
+//-----------------------------------------------------------------------------
+vtkDataArray* vtkExodusIIReaderPrivate::FindArray( const vtkExodusIICacheKey& key )
+{
+  if ( this->HoldArrays )
+  {
+    std::lock_guard<std::mutex> holdLock( this->HoldMutex );
+    std::map<vtkExodusIICacheKey, vtkSmartPointer<vtkDataArray> >::iterator it =
+      this->HeldArrays.find( key );
+    if ( it != this->HeldArrays.end() )
+    {
+      return it->second;
+    }
+  }
+
+  // Never cache points deflected for a mode shape animation... doubles don't make good keys.
+  if ( this->HasModeShapes && key.ObjectType == vtkExodusIIReader::NODAL_COORDS )
+  {
+    return nullptr;
+  }
+
+  // Lookup() returns a new reference, so that an array of the shared cache
+  // cannot be dropped by another reader or thread before it is held.
+  vtkDataArray* arr = this->GetCacheForKey( key )->Lookup( key );
+  if ( arr )
+  {
+    this->HoldArray( key, arr );
+    arr->Delete();
+  }
+  return arr;
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::HoldArray( const vtkExodusIICacheKey& key, vtkDataArray* arr )
+{
+  if ( this->HoldArrays )
+  {
+    std::lock_guard<std::mutex> holdLock( this->HoldMutex );
+    this->HeldArrays[key] = arr;
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkDataArray* vtkExodusIIReaderPrivate::ReadArray( vtkExodusIICacheKey key )
+{
+  vtkDataArray* arr = nullptr;
   int exoid = this->Exoid;
   int maxNameLength = this->Parent->GetMaxNameLength();
 
@@ -1741,7 +1897,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       static_cast<vtkIdType>(
         this->ArrayInfo[ vtkExodusIIReader::GLOBAL ].size()));
 
-    if ( ex_get_glob_vars( exoid, key.Time + 1, arr->GetNumberOfTuples(),
+    if ( vtkExodusIICall( ex_get_glob_vars, exoid, key.Time + 1, arr->GetNumberOfTuples(),
         arr->GetVoidPointer( 0 ) ) < 0 )
     {
       vtkErrorMacro( "Could not read global variable " << this->GetGlobalVariableValuesArrayName() << "." );
@@ -1764,7 +1920,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     }
     if ( ncomps == 1 )
     {
-      if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
+      if ( vtkExodusIICall( ex_get_var, exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
           ainfop->OriginalIndices[0], 0, arr->GetNumberOfTuples(),
           arr->GetVoidPointer( 0 ) ) < 0 )
       {
@@ -1783,7 +1939,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       {
         vtkIdType N = this->ModelParameters.num_nodes;
         tmpVal[c].resize( N );
-        if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
+        if ( vtkExodusIICall( ex_get_var, exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
             ainfop->OriginalIndices[c], 0, arr->GetNumberOfTuples(),
             &tmpVal[c][0] ) < 0)
         {
@@ -1844,7 +2000,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       {
         vtkIdType N = this->GetNumberOfTimeSteps();
         tmpVal[c].resize( N );
-        if ( ex_get_var_time( exoid, EX_GLOBAL,
+        if ( vtkExodusIICall( ex_get_var_time, exoid, EX_GLOBAL,
             ainfop->OriginalIndices[c], key.ObjectId,
             1, this->GetNumberOfTimeSteps(), &tmpVal[c][0] ) < 0 )
         {
@@ -1868,7 +2024,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         arr->SetTuple( t, &tmpTuple[0] );
       }
     }
-    else if ( ex_get_var_time( exoid, EX_GLOBAL,
+    else if ( vtkExodusIICall( ex_get_var_time, exoid, EX_GLOBAL,
         ainfop->OriginalIndices[0], key.ObjectId,
         1, this->GetNumberOfTimeSteps(), arr->GetVoidPointer( 0 ) ) < 0 )
     {
@@ -1890,7 +2046,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     arr->SetNumberOfTuples( this->GetNumberOfTimeSteps() );
     if ( ainfop->Components == 1 )
     {
-      if ( ex_get_var_time( exoid, EX_NODAL,
+      if ( vtkExodusIICall( ex_get_var_time, exoid, EX_NODAL,
           ainfop->OriginalIndices[0], key.ObjectId,
           1, this->GetNumberOfTimeSteps(), arr->GetVoidPointer( 0 ) ) < 0 )
       {
@@ -1909,7 +2065,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       {
         vtkIdType N = this->GetNumberOfTimeSteps();
         tmpVal[c].resize( N );
-        if ( ex_get_var_time( exoid, EX_NODAL,
+        if ( vtkExodusIICall( ex_get_var_time, exoid, EX_NODAL,
             ainfop->OriginalIndices[c], key.ObjectId,
             1, this->GetNumberOfTimeSteps(), &tmpVal[c][0] ) < 0 )
         {
@@ -1943,7 +2099,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     arr->SetNumberOfTuples( this->GetNumberOfTimeSteps() );
     if ( ainfop->Components == 1 )
     {
-      if ( ex_get_var_time( exoid, EX_ELEM_BLOCK,
+      if ( vtkExodusIICall( ex_get_var_time, exoid, EX_ELEM_BLOCK,
           ainfop->OriginalIndices[0], key.ObjectId,
           1, this->GetNumberOfTimeSteps(), arr->GetVoidPointer( 0 ) ) < 0 )
       {
@@ -1962,7 +2118,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       {
         vtkIdType N = this->GetNumberOfTimeSteps();
         tmpVal[c].resize( N );
-        if ( ex_get_var_time( exoid, EX_ELEM_BLOCK,
+        if ( vtkExodusIICall( ex_get_var_time, exoid, EX_ELEM_BLOCK,
             ainfop->OriginalIndices[c], key.ObjectId,
             1, this->GetNumberOfTimeSteps(), &tmpVal[c][0] ) < 0 )
         {
@@ -2014,7 +2170,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     arr->SetNumberOfTuples( oinfop->Size );
     if ( ainfop->Components == 1 )
     {
-      if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
+      if ( vtkExodusIICall( ex_get_var, exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
           ainfop->OriginalIndices[0], oinfop->Id, arr->GetNumberOfTuples(),
           arr->GetVoidPointer( 0 ) ) < 0)
       {
@@ -2035,7 +2191,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         vtkIdType N = arr->GetNumberOfTuples();
         tmpVal[c].resize( N+1 ); // + 1 to avoid errors when N == 0.
                                  // BUG #8746.
-        if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
+        if ( vtkExodusIICall( ex_get_var, exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
             ainfop->OriginalIndices[c], oinfop->Id, arr->GetNumberOfTuples(),
             &tmpVal[c][0] ) < 0)
         {
@@ -2088,7 +2244,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       arr->SetNumberOfTuples( this->ModelParameters.num_elem );
       break;
     }
-    if ( ex_get_num_map( exoid, static_cast<ex_entity_type>( key.ObjectType ), minfop->Id, (vtkIdType*)arr->GetVoidPointer( 0 ) ) < 0 )
+    if ( vtkExodusIICall( ex_get_num_map, exoid, static_cast<ex_entity_type>( key.ObjectType ), minfop->Id, (vtkIdType*)arr->GetVoidPointer( 0 ) ) < 0 )
     {
       vtkErrorMacro( "Could not read nodal map variable " << minfop->Name.c_str() << "." );
       arr->Delete();
@@ -2169,7 +2325,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     src->SetNumberOfTuples( mapSize );
     if (nMaps > 0) // FIXME correctly detect parallel
     {
-        if ( ex_get_id_map( exoid, static_cast<ex_entity_type>( ckey.ObjectType ), (vtkIdType*)src->GetPointer( 0 ) ) < 0 )
+        if ( vtkExodusIICall( ex_get_id_map, exoid, static_cast<ex_entity_type>( ckey.ObjectType ), (vtkIdType*)src->GetPointer( 0 ) ) < 0 )
         {
           vtkErrorMacro( "Could not read elem num map for global implicit id" );
           src->Delete();
@@ -2236,7 +2392,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     src->SetNumberOfTuples( this->ModelParameters.num_nodes );
     if (this->ModelParameters.num_node_maps > 0) // FIXME correctly detect parallel
     {
-        if ( ex_get_id_map( exoid, (ex_entity_type)( vtkExodusIIReader::NODE_MAP ), (vtkIdType*)src->GetPointer( 0 ) ) < 0 )
+        if ( vtkExodusIICall( ex_get_id_map, exoid, (ex_entity_type)( vtkExodusIIReader::NODE_MAP ), (vtkIdType*)src->GetPointer( 0 ) ) < 0 )
         {
           vtkErrorMacro( "Could not node node num map for global implicit id" );
           src->Delete();
@@ -2314,7 +2470,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       iarr->SetNumberOfTuples( mapSize );
       if ( mapSize )
       {
-        if ( ex_get_id_map( exoid, static_cast<ex_entity_type>( ktmp.ObjectType ), (vtkIdType*)iarr->GetPointer( 0 ) ) < 0 )
+        if ( vtkExodusIICall( ex_get_id_map, exoid, static_cast<ex_entity_type>( ktmp.ObjectType ), (vtkIdType*)iarr->GetPointer( 0 ) ) < 0 )
         {
           vtkErrorMacro( "Could not read old-style node or element map." );
           iarr->Delete();
@@ -2346,7 +2502,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     vtkIntArray* iarr = vtkIntArray::New();
     iarr->SetNumberOfComponents (1);
     iarr->SetNumberOfTuples (binfop->Size);
-    if ( ex_get_entity_count_per_polyhedra ( exoid, static_cast<ex_entity_type>( otyp ), binfop->Id,
+    if ( vtkExodusIICall( ex_get_entity_count_per_polyhedra, exoid, static_cast<ex_entity_type>( otyp ), binfop->Id,
                                              iarr->GetPointer(0)) < 0 )
     {
       vtkErrorMacro( "Unable to read " << binfop->Id << " (index " << key.ObjectId <<
@@ -2382,7 +2538,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       iarr->SetNumberOfTuples( binfop->Size );
     }
 
-    if ( ex_get_conn( exoid, static_cast<ex_entity_type>( otyp ), binfop->Id, iarr->GetPointer(0), nullptr, nullptr ) < 0 )
+    if ( vtkExodusIICall( ex_get_conn, exoid, static_cast<ex_entity_type>( otyp ), binfop->Id, iarr->GetPointer(0), nullptr, nullptr ) < 0 )
     {
       vtkErrorMacro( "Unable to read " << objtype_names[otypidx] << " " << binfop->Id << " (index " << key.ObjectId <<
         ") nodal connectivity." );
@@ -2553,7 +2709,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       iarr->SetNumberOfValues (binfop->BdsPerEntry[2]);
 
       if (
-        ex_get_conn(
+        vtkExodusIICall( ex_get_conn,
           exoid,
           static_cast<ex_entity_type>( otyp ),
           binfop->Id,
@@ -2594,7 +2750,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     iarr->SetNumberOfTuples( sinfop->Size );
     auto iptr = iarr->GetPointer( 0 );
 
-    if ( ex_get_set( exoid, static_cast<ex_entity_type>( otyp ), sinfop->Id, iptr, nullptr ) < 0 )
+    if ( vtkExodusIICall( ex_get_set, exoid, static_cast<ex_entity_type>( otyp ), sinfop->Id, iptr, nullptr ) < 0 )
     {
       vtkErrorMacro( "Unable to read " << objtype_names[otypidx] << " " << sinfop->Id << " (index " << key.ObjectId <<
         ") nodal connectivity." );
@@ -2622,7 +2778,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     std::vector<int> tmpOrient; // hold the edge/face orientation information until we can interleave it.
     tmpOrient.resize( sinfop->Size );
 
-    if ( ex_get_set( exoid, static_cast<ex_entity_type>( otyp ), sinfop->Id, iarr->GetPointer(0), &tmpOrient[0] ) < 0 )
+    if ( vtkExodusIICall( ex_get_set, exoid, static_cast<ex_entity_type>( otyp ), sinfop->Id, iarr->GetPointer(0), &tmpOrient[0] ) < 0 )
     {
       vtkErrorMacro( "Unable to read " << objtype_names[otypidx] << " " << sinfop->Id << " (index " << key.ObjectId <<
         ") nodal connectivity." );
@@ -2649,7 +2805,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       // let InsertSetSides() figure it all out. Except for 0-based indexing
       SetInfoType* sinfop = &this->SetInfo[vtkExodusIIReader::SIDE_SET][key.ObjectId];
       vtkIdType ssnllen; // side set node list length
-      if ( ex_get_side_set_node_list_len( exoid, sinfop->Id, &ssnllen ) < 0 )
+      if ( vtkExodusIICall( ex_get_side_set_node_list_len, exoid, sinfop->Id, &ssnllen ) < 0 )
       {
         vtkErrorMacro( "Unable to fetch side set \"" << sinfop->Name.c_str() << "\" (" << sinfop->Id << ") node list length" );
         arr = nullptr;
@@ -2660,7 +2816,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       iarr->SetNumberOfComponents( 1 );
       iarr->SetNumberOfTuples( ilen );
       auto* dat = iarr->GetPointer( 0 );
-      if ( ex_get_side_set_node_list( exoid, sinfop->Id, dat, dat + sinfop->Size ) < 0 )
+      if ( vtkExodusIICall( ex_get_side_set_node_list, exoid, sinfop->Id, dat, dat + sinfop->Size ) < 0 )
       {
         vtkErrorMacro( "Unable to fetch side set \"" << sinfop->Name.c_str() << "\" (" << sinfop->Id << ") node list" );
         iarr->Delete();
@@ -2681,7 +2837,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
       SetInfoType* sinfop = &this->SetInfo[vtkExodusIIReader::SIDE_SET][key.ObjectId];
       std::vector<vtkIdType> side_set_elem_list(sinfop->Size);
       std::vector<vtkIdType> side_set_side_list(sinfop->Size);
-      if ( ex_get_side_set( exoid, sinfop->Id, &side_set_elem_list[0], &side_set_side_list[0]) < 0 )
+      if ( vtkExodusIICall( ex_get_side_set, exoid, sinfop->Id, &side_set_elem_list[0], &side_set_side_list[0]) < 0 )
       {
         vtkErrorMacro( "Unable to fetch side set \"" << sinfop->Name.c_str() << "\" (" << sinfop->Id << ") node list" );
         arr = nullptr;
@@ -2711,6 +2867,9 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     std::vector<double> coordTmp;
     vtkDoubleArray* darr = vtkDoubleArray::New();
     arr = darr;
+    // Name the array as vtkPoints::SetData() would, since the blocks may use
+    // it concurrently.
+    arr->SetName( "Points" );
     arr->SetNumberOfComponents( 3 );
     arr->SetNumberOfTuples( this->ModelParameters.num_nodes );
     int dim = this->ModelParameters.num_dim;
@@ -2739,7 +2898,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         vtkErrorMacro( "Bad coordinate index " << c << " when reading point coordinates." );
         xc = yc = zc = nullptr;
       }
-      if ( ex_get_coord( exoid, xc, yc, zc ) < 0 )
+      if ( vtkExodusIICall( ex_get_coord, exoid, xc, yc, zc ) < 0 )
       {
         vtkErrorMacro( "Unable to read node coordinates for index " << c << "." );
         arr->Delete();
@@ -2875,7 +3034,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     darr->SetName( binfop->AttributeNames[key.ArrayId].c_str() );
     darr->SetNumberOfComponents( 1 );
     darr->SetNumberOfTuples( binfop->Size );
-    if ( ex_get_one_attr(
+    if ( vtkExodusIICall( ex_get_one_attr, 
         exoid, static_cast<ex_entity_type>(blkType), binfop->Id, key.ArrayId + 1, darr->GetVoidPointer( 0 ) ) < 0 )
     { // NB: The error message references the file-order object id, not the numerically sorted index presented to users.
       vtkErrorMacro( "Unable to read attribute " << key.ArrayId
@@ -2896,7 +3055,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     carr->SetName("Info_Records");
     carr->SetNumberOfComponents( MAX_LINE_LENGTH+1 );
 
-    if( ex_inquire( exoid, EX_INQ_INFO, &num_info, &fdum, cdum ) < 0 )
+    if( vtkExodusIICall( ex_inquire, exoid, EX_INQ_INFO, &num_info, &fdum, cdum ) < 0 )
     {
       vtkErrorMacro( "Unable to get number of INFO records from ex_inquire" );
       carr->Delete();
@@ -2912,7 +3071,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
         for ( i = 0; i < num_info; ++i )
           info[i] = (char *) calloc ( ( MAX_LINE_LENGTH + 1 ), sizeof(char) );
 
-        if ( ex_get_info( exoid, info ) < 0 )
+        if ( vtkExodusIICall( ex_get_info, exoid, info ) < 0 )
         {
           vtkErrorMacro( "Unable to read INFO records from ex_get_info");
           carr->Delete();
@@ -2952,7 +3111,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     carr->SetName( "QA_Records" );
     carr->SetNumberOfComponents( maxNameLength + 1 );
 
-    if ( ex_inquire( exoid, EX_INQ_QA, &num_qa_rec, &fdum, cdum ) < 0 )
+    if ( vtkExodusIICall( ex_inquire, exoid, EX_INQ_QA, &num_qa_rec, &fdum, cdum ) < 0 )
     {
       vtkErrorMacro( "Unable to get number of QA records from ex_inquire" );
       carr->Delete();
@@ -2973,7 +3132,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
           }
         }
 
-        if ( ex_get_qa( exoid, qa_record ) < 0 )
+        if ( vtkExodusIICall( ex_get_qa, exoid, qa_record ) < 0 )
         {
           vtkErrorMacro( "Unable to read QA records from ex_get_qa");
           carr->Delete();
@@ -3014,16 +3173,39 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     arr = nullptr;
   }
 
-  // Even if the array is larger than the allowable cache size, it will keep the most recent insertion.
-  // So, we delete our reference knowing that the Cache will keep the object "alive" until whatever
-  // called GetCacheOrRead() references the array. But, once you get an array from GetCacheOrRead(),
-  // you better start running!
-  if ( arr )
+  return arr;
+}
+
+//-----------------------------------------------------------------------------
+vtkExodusIICache* vtkExodusIIReaderPrivate::GetCacheForKey( const vtkExodusIICacheKey& key )
+{
+  // Coordinates read for a time step are displaced according to the settings of
+  // this reader, so they cannot be shared with other readers.
+  if ( ! this->SharedCache ||
+    ( key.ObjectType == vtkExodusIIReader::NODAL_COORDS && key.Time >= 0 ) )
   {
-    this->Cache->Insert( key, arr );
-    arr->FastDelete();
+    return this->Cache;
   }
-  return arr;
+  return this->SharedCache;
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::UpdateSharedCache( const char* filename )
+{
+  vtkExodusIICache* cache = nullptr;
+  if ( filename && this->UseSharedCache )
+  {
+    // The shared cache is acquired again at each opening, so that a file
+    // modified since is given a new one.
+    cache = vtkExodusIICache::AcquireSharedCache( filename );
+    cache->SetCacheCapacity( this->CacheSize );
+    cache->SetCompressColdEntries( this->CompressCache != 0 );
+  }
+  if ( this->SharedCache )
+  {
+    vtkExodusIICache::ReleaseSharedCache( this->SharedCache );
+  }
+  this->SharedCache = cache;
 }
 
 //-----------------------------------------------------------------------------
@@ -3823,6 +4005,11 @@ void vtkExodusIIReaderPrivate::PrintData( ostream& os, vtkIndent indent )
 
   os << indent << "Array Cache:\n";
   this->Cache->PrintSelf( os, inden2 );
+  os << indent << "SharedCache: " << this->SharedCache << "\n";
+  os << indent << "UseSharedCache: " << this->UseSharedCache << "\n";
+  os << indent << "CompressCache: " << this->CompressCache << "\n";
+  os << indent << "PrefetchNextTimeStep: " << this->PrefetchNextTimeStep << "\n";
+  os << indent << "ParallelAssembly: " << this->ParallelAssembly << "\n";
 
   os << indent << "SqueezePoints: " << this->SqueezePoints << "\n";
   os << indent << "ApplyDisplacements: " << this->ApplyDisplacements << "\n";
@@ -3845,7 +4032,7 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
     this->CloseFile();
   }
 
-  this->Exoid = ex_open( filename, EX_READ,
+  this->Exoid = vtkExodusIICall( vtkExodusIIOpen, filename, EX_READ,
     &this->AppWordSize, &this->DiskWordSize, &this->ExodusVersion );
   if ( this->Exoid <= 0 )
   {
@@ -3864,12 +4051,14 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
   // is updated so we don't have to worry about setting the global max_name_length variable.
   // this is because in our current version of the ExodusII libraries the exo Id isn't used
   // in the ex_set_max_name_length() function.
-  ex_set_max_name_length(this->Exoid, this->Parent->GetMaxNameLength());
+  vtkExodusIICall( ex_set_max_name_length, this->Exoid, this->Parent->GetMaxNameLength());
 
   vtkIdType numNodesInFile;
   char dummyChar;
   float dummyFloat;
-  ex_inquire(this->Exoid, EX_INQ_NODES, &numNodesInFile, &dummyFloat, &dummyChar);
+  vtkExodusIICall( ex_inquire, this->Exoid, EX_INQ_NODES, &numNodesInFile, &dummyFloat, &dummyChar);
+
+  this->UpdateSharedCache( filename );
 
   return 1;
 }
@@ -3878,7 +4067,7 @@ int vtkExodusIIReaderPrivate::CloseFile()
 {
   if ( this->Exoid >= 0 )
   {
-    VTK_EXO_FUNC( ex_close( this->Exoid ), "Could not close an open file (" << this->Exoid << ")" );
+    VTK_EXO_FUNC( vtkExodusIICall( ex_close, this->Exoid ), "Could not close an open file (" << this->Exoid << ")" );
     this->Exoid = -1;
   }
   return 0;
@@ -3901,7 +4090,7 @@ int vtkExodusIIReaderPrivate::UpdateTimeInformation()
   int num_timesteps;
   int i;
 
-  VTK_EXO_FUNC( ex_inquire( exoid, EX_INQ_TIME, itmp, nullptr, nullptr ), "Inquire for EX_INQ_TIME failed" );
+  VTK_EXO_FUNC( vtkExodusIICall( ex_inquire, exoid, EX_INQ_TIME, itmp, nullptr, nullptr ), "Inquire for EX_INQ_TIME failed" );
   num_timesteps = itmp[0];
 
   this->Times.clear();
@@ -3909,7 +4098,7 @@ int vtkExodusIIReaderPrivate::UpdateTimeInformation()
   {
     this->Times.resize( num_timesteps );
 
-    int exo_err = ex_get_all_times( this->Exoid, &this->Times[0] );
+    int exo_err = vtkExodusIICall( ex_get_all_times, this->Exoid, &this->Times[0] );
     if ( exo_err < 0 || this->IgnoreFileTime)
     {
       for ( i = 0; i < num_timesteps; ++i )
@@ -4016,7 +4205,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
 
   this->InformationTimeStamp.Modified(); // Update MTime so that it will be newer than parent's FileNameMTime
 
-  VTK_EXO_FUNC( ex_get_init_ext( exoid, &this->ModelParameters ),
+  VTK_EXO_FUNC( vtkExodusIICall( ex_get_init_ext, exoid, &this->ModelParameters ),
     "Unable to read database parameters." );
 
   VTK_EXO_FUNC( this->UpdateTimeInformation(), "" );
@@ -4030,7 +4219,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
   if ( num_timesteps > 0 )
     {
     this->Times.resize( num_timesteps );
-    VTK_EXO_FUNC( ex_get_all_times( this->Exoid, &this->Times[0] ), "Could not retrieve time values." );
+    VTK_EXO_FUNC( vtkExodusIICall( ex_get_all_times, this->Exoid, &this->Times[0] ), "Could not retrieve time values." );
     }
 */
   for ( i = 0; i < num_obj_types; ++i )
@@ -4048,7 +4237,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
     int* truth_tab = nullptr;
     have_var_names = 0;
 
-    VTK_EXO_FUNC( ex_inquire( exoid, obj_sizes[i], &nids, nullptr, nullptr ), "Object ID list size could not be determined." );
+    VTK_EXO_FUNC( vtkExodusIICall( ex_inquire, exoid, obj_sizes[i], &nids, nullptr, nullptr ), "Object ID list size could not be determined." );
 
     if ( nids )
     {
@@ -4080,9 +4269,9 @@ int vtkExodusIIReaderPrivate::RequestInformation()
 
     if ( nids )
     {
-      VTK_EXO_FUNC( ex_get_ids( exoid, static_cast<ex_entity_type>( obj_types[i] ), ids ),
+      VTK_EXO_FUNC( vtkExodusIICall( ex_get_ids, exoid, static_cast<ex_entity_type>( obj_types[i] ), ids ),
         "Could not read object ids for i=" << i << " and otyp=" << obj_types[i] << "." );
-      VTK_EXO_FUNC( ex_get_names( exoid, static_cast<ex_entity_type>( obj_types[i] ), obj_names ),
+      VTK_EXO_FUNC( vtkExodusIICall( ex_get_names, exoid, static_cast<ex_entity_type>( obj_types[i] ), obj_names ),
         "Could not read object names." );
     }
 
@@ -4108,18 +4297,18 @@ int vtkExodusIIReaderPrivate::RequestInformation()
 
     if ( (OBJTYPE_IS_BLOCK(i)) || (OBJTYPE_IS_SET(i)))
     {
-      VTK_EXO_FUNC( ex_get_var_param( exoid, obj_typestr[i], &num_vars ), "Could not read number of variables." );
+      VTK_EXO_FUNC( vtkExodusIICall( ex_get_var_param, exoid, obj_typestr[i], &num_vars ), "Could not read number of variables." );
 
       if (num_vars && num_timesteps > 0)
       {
         truth_tab = (int*) malloc(num_vars * nids * sizeof(int));
-        VTK_EXO_FUNC( ex_get_var_tab( exoid, obj_typestr[i], nids, num_vars, truth_tab ), "Could not read truth table." );
+        VTK_EXO_FUNC( vtkExodusIICall( ex_get_var_tab, exoid, obj_typestr[i], nids, num_vars, truth_tab ), "Could not read truth table." );
 
         var_names = (char**) malloc(num_vars * sizeof(char*));
         for (j = 0; j < num_vars; ++j)
           var_names[j] = (char*) malloc( (maxNameLength + 1) * sizeof(char));
 
-        VTK_EXO_FUNC( ex_get_var_names( exoid, obj_typestr[i], num_vars, var_names ), "Could not read variable names." );
+        VTK_EXO_FUNC( vtkExodusIICall( ex_get_var_names, exoid, obj_typestr[i], num_vars, var_names ), "Could not read variable names." );
         this->RemoveBeginningAndTrailingSpaces(num_vars, var_names, maxNameLength);
         have_var_names = 1;
       }
@@ -4140,7 +4329,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
         binfo.NextSqueezePoint = 0;
         if (obj_types[i] == vtkExodusIIReader::ELEM_BLOCK)
         {
-          VTK_EXO_FUNC( ex_get_block( exoid, static_cast<ex_entity_type>( obj_types[i] ), ids[obj], obj_typenames[obj],
+          VTK_EXO_FUNC( vtkExodusIICall( ex_get_block, exoid, static_cast<ex_entity_type>( obj_types[i] ), ids[obj], obj_typenames[obj],
                   &binfo.Size, &binfo.BdsPerEntry[0], &binfo.BdsPerEntry[1], &binfo.BdsPerEntry[2], &binfo.AttributesPerEntry ),
               "Could not read block params." );
           binfo.Status = 1; // load element blocks by default
@@ -4148,7 +4337,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
         }
         else
         {
-          VTK_EXO_FUNC( ex_get_block( exoid, static_cast<ex_entity_type>( obj_types[i] ), ids[obj], obj_typenames[obj],
+          VTK_EXO_FUNC( vtkExodusIICall( ex_get_block, exoid, static_cast<ex_entity_type>( obj_types[i] ), ids[obj], obj_typenames[obj],
                   &binfo.Size, &binfo.BdsPerEntry[0], &binfo.BdsPerEntry[1], &binfo.BdsPerEntry[2], &binfo.AttributesPerEntry ),
               "Could not read block params." );
           binfo.Status = 0; // don't load edge/face blocks by default
@@ -4182,7 +4371,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
             attr_names[j]
                 = (char*) malloc( (maxNameLength + 1) * sizeof(char));
 
-          VTK_EXO_FUNC( ex_get_attr_names( exoid, static_cast<ex_entity_type>( obj_types[i] ), ids[obj], attr_names ),
+          VTK_EXO_FUNC( vtkExodusIICall( ex_get_attr_names, exoid, static_cast<ex_entity_type>( obj_types[i] ), ids[obj], attr_names ),
             "Could not read attributes names." );
 
           for (j = 0; j < binfo.AttributesPerEntry; ++j)
@@ -4288,7 +4477,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
         sinfo.CachedConnectivity = nullptr;
         sinfo.NextSqueezePoint = 0;
 
-        VTK_EXO_FUNC( ex_get_set_param( exoid, static_cast<ex_entity_type>( obj_types[i] ), ids[obj], &sinfo.Size, &sinfo.DistFact),
+        VTK_EXO_FUNC( vtkExodusIICall( ex_get_set_param, exoid, static_cast<ex_entity_type>( obj_types[i] ), ids[obj], &sinfo.Size, &sinfo.DistFact),
             "Could not read set parameters." );
         //num_entries = sinfo.Size;
         sinfo.FileOffset = setEntryFileOffset;
@@ -4395,7 +4584,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
   //this->ComputeGridOffsets();
 
   // Now read information for nodal arrays
-  VTK_EXO_FUNC( ex_get_var_param( exoid, "n", &num_vars ), "Unable to read number of nodal variables." );
+  VTK_EXO_FUNC( vtkExodusIICall( ex_get_var_param, exoid, "n", &num_vars ), "Unable to read number of nodal variables." );
   if ( num_vars > 0 )
   {
     var_names = (char**) malloc( num_vars * sizeof(char*) );
@@ -4404,7 +4593,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
       var_names[j] = (char*) malloc( (maxNameLength + 1) * sizeof(char) );
     }
 
-    VTK_EXO_FUNC( ex_get_var_names( exoid, "n", num_vars, var_names ), "Could not read nodal variable names." );
+    VTK_EXO_FUNC( vtkExodusIICall( ex_get_var_names, exoid, "n", num_vars, var_names ), "Could not read nodal variable names." );
     this->RemoveBeginningAndTrailingSpaces( num_vars, var_names, maxNameLength );
 
     nids = 1;
@@ -4426,7 +4615,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
   }
 
   // Now read information for global variables
-  VTK_EXO_FUNC( ex_get_var_param( exoid, "g", &num_vars ), "Unable to read number of global variables." );
+  VTK_EXO_FUNC( vtkExodusIICall( ex_get_var_param, exoid, "g", &num_vars ), "Unable to read number of global variables." );
   if ( num_vars > 0 )
   {
     var_names = (char**) malloc( num_vars * sizeof(char*) );
@@ -4435,7 +4624,7 @@ int vtkExodusIIReaderPrivate::RequestInformation()
       var_names[j] = (char*) malloc( (maxNameLength + 1) * sizeof(char) );
     }
 
-    VTK_EXO_FUNC( ex_get_var_names( exoid, "g", num_vars, var_names ), "Could not read global variable names." );
+    VTK_EXO_FUNC( vtkExodusIICall( ex_get_var_names, exoid, "g", num_vars, var_names ), "Could not read global variable names." );
     this->RemoveBeginningAndTrailingSpaces( num_vars, var_names, maxNameLength );
 
     nids = 1;
@@ -4493,6 +4682,24 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
     vtkErrorMacro( "You must specify an output mesh" );
   }
 
+  // Hold the arrays used by the output until it is assembled, and record the
+  // time-varying ones for prefetching.
+  this->HeldArrays.clear();
+  this->RequestedKeys.clear();
+  this->HoldArrays = true;
+
+  // Blocks and sets that are assembled concurrently once the loop below has
+  // created the output grids of all the objects.
+  std::vector<AssembleObjectsFunctor::Object> parallelObjects;
+  if ( this->ParallelAssembly )
+  {
+    // The assembly functions look these up with operator[]; create them now
+    // rather than concurrently.
+    this->ArrayInfo[vtkExodusIIReader::NODAL];
+    this->ArrayInfo[vtkExodusIIReader::GLOBAL];
+    this->MapInfo[vtkExodusIIReader::NODE_MAP];
+  }
+
   // Iterate over all block and set types, creating a
   // multiblock dataset to hold objects of each type.
   int conntypidx;
@@ -4540,47 +4747,83 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
       ug->FastDelete();
       //cout << " Grid: " << ug << "\n";
 
-      // Connectivity first. Either from the cache in bsinfop or read from disk.
-      // Connectivity isn't allowed to change with time.
-      this->AssembleOutputConnectivity( timeStep, otyp, obj, conntypidx, bsinfop, ug );
-
-      // Now prepare points.
-      // These shouldn't change unless the connectivity has changed.
-      this->AssembleOutputPoints( timeStep, bsinfop, ug );
-
-      // Then, add the desired arrays from cache (or disk)
-      // Point and cell arrays are handled differently because they
-      // have different problems to solve.
-      // Point arrays must use the PointMap index to subset values.
-      // Cell arrays may be used as-is.
-      this->AssembleOutputPointArrays( timeStep, bsinfop, ug );
-      this->AssembleOutputCellArrays( timeStep, otyp, obj, bsinfop, ug );
-
-      // Some arrays may be procedurally generated (e.g., the ObjectId
-      // array, global element and node number arrays). This constructs
-      // them as required.
-      this->AssembleOutputProceduralArrays( timeStep, otyp, obj, ug );
-
-      // QA and informational records in the ExodusII file are appended
-      // to each and every output unstructured grid.
-      this->AssembleOutputGlobalArrays( timeStep, otyp, obj, bsinfop, ug );
-
-      // Maps (as distinct from the global element and node arrays above)
-      // are per-cell or per-node integers. As with point arrays, the
-      // PointMap is used to subset node maps. Cell arrays are stored in
-      // ExodusII files for all elements (across all blocks of a given type)
-      // and thus must be subset for the unstructured grid of interest.
-      this->AssembleOutputPointMaps( timeStep, bsinfop, ug );
-      this->AssembleOutputCellMaps( timeStep, otyp, obj, bsinfop, ug );
+      if ( this->ParallelAssembly && this->CanAssembleInParallel( conntypidx, bsinfop ) )
+      {
+        AssembleObjectsFunctor::Object object = { otyp, obj, conntypidx, bsinfop, ug };
+        parallelObjects.push_back( object );
+      }
+      else
+      {
+        this->AssembleOutputObject( timeStep, otyp, obj, conntypidx, bsinfop, ug );
+      }
       ++nbl;
     }
   }
 
+  if ( ! parallelObjects.empty() )
+  {
+    AssembleObjectsFunctor functor( this, timeStep, parallelObjects );
+    vtkSMPTools::For( 0, static_cast<vtkIdType>( parallelObjects.size() ), 1, functor );
+  }
+
+  this->HoldArrays = false;
+  this->HeldArrays.clear();
+  this->QueuePrefetch( static_cast<int>( timeStep ) );
+
   this->CloseFile();
 
   return 0;
 }
 
+void vtkExodusIIReaderPrivate::AssembleOutputObject( vtkIdType timeStep, int otyp, int oidx,
+  int conntypidx, BlockSetInfoType* bsinfop, vtkUnstructuredGrid* output )
+{
+  // Connectivity first. Either from the cache in bsinfop or read from disk.
+  // Connectivity isn't allowed to change with time.
+  this->AssembleOutputConnectivity( timeStep, otyp, oidx, conntypidx, bsinfop, output );
+
+  // Now prepare points.
+  // These shouldn't change unless the connectivity has changed.
+  this->AssembleOutputPoints( timeStep, bsinfop, output );
+
+  // Then, add the desired arrays from cache (or disk)
+  // Point and cell arrays are handled differently because they
+  // have different problems to solve.
+  // Point arrays must use the PointMap index to subset values.
+  // Cell arrays may be used as-is.
+  this->AssembleOutputPointArrays( timeStep, bsinfop, output );
+  this->AssembleOutputCellArrays( timeStep, otyp, oidx, bsinfop, output );
+
+  // Some arrays may be procedurally generated (e.g., the ObjectId
+  // array, global element and node number arrays). This constructs
+  // them as required.
+  this->AssembleOutputProceduralArrays( timeStep, otyp, oidx, output );
+
+  // QA and informational records in the ExodusII file are appended
+  // to each and every output unstructured grid.
+  this->AssembleOutputGlobalArrays( timeStep, otyp, oidx, bsinfop, output );
+
+  // Maps (as distinct from the global element and node arrays above)
+  // are per-cell or per-node integers. As with point arrays, the
+  // PointMap is used to subset node maps. Cell arrays are stored in
+  // ExodusII files for all elements (across all blocks of a given type)
+  // and thus must be subset for the unstructured grid of interest.
+  this->AssembleOutputPointMaps( timeStep, bsinfop, output );
+  this->AssembleOutputCellMaps( timeStep, otyp, oidx, bsinfop, output );
+}
+
+bool vtkExodusIIReaderPrivate::CanAssembleInParallel( int conntypidx, BlockSetInfoType* bsinfop )
+{
+  if ( CONNTYPE_IS_BLOCK(conntypidx) )
+  {
+    // Polyhedra share the face connectivity cached by GetPolyhedronFaceConnectivity().
+    return static_cast<BlockInfoType*>( bsinfop )->CellType != VTK_POLYHEDRON;
+  }
+  // The other sets sort their cached references in place or look up the
+  // blocks they refer to.
+  return conn_types[conntypidx] == vtkExodusIIReader::NODE_SET_CONN;
+}
+
 int vtkExodusIIReaderPrivate::SetUpEmptyGrid( vtkMultiBlockDataSet* output )
 {
   if ( ! output )
@@ -4715,7 +4958,12 @@ int vtkExodusIIReaderPrivate::SetUpEmptyGrid( vtkMultiBlockDataSet* output )
 
 void vtkExodusIIReaderPrivate::Reset()
 {
+  // The prefetching thread reads the metadata cleared below.
+  std::lock_guard<std::recursive_mutex> readerLock( this->Prefetch->ReaderMutex );
+  this->CancelPrefetch();
   this->CloseFile();
+  // Other readers may still use the shared cache, so only our own is cleared.
+  this->UpdateSharedCache( nullptr );
   this->ResetCache(); // must come before BlockInfo and SetInfo are cleared.
   this->BlockInfo.clear();
   this->SetInfo.clear();
@@ -4764,6 +5012,10 @@ void vtkExodusIIReaderPrivate::ResetCache()
 {
   this->Cache->Clear();
   this->Cache->SetCacheCapacity(this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
+  if ( this->SharedCache )
+  {
+    this->SharedCache->Clear();
+  }
   this->ClearConnectivityCaches();
 }
 
@@ -4773,10 +5025,170 @@ void vtkExodusIIReaderPrivate::SetCacheSize( double size )
   {
     this->CacheSize = size;
     this->Cache->SetCacheCapacity(this->CacheSize);
+    if ( this->SharedCache )
+    {
+      this->SharedCache->SetCacheCapacity(this->CacheSize);
+    }
     this->Modified();
   }
 }
 
+void vtkExodusIIReaderPrivate::SetUseSharedCache( vtkTypeBool use )
+{
+  this->UseSharedCache = use;
+}
+
+void vtkExodusIIReaderPrivate::SetCompressCache( vtkTypeBool compress )
+{
+  this->CompressCache = compress;
+  this->Cache->SetCompressColdEntries( compress != 0 );
+  if ( this->SharedCache )
+  {
+    this->SharedCache->SetCompressColdEntries( compress != 0 );
+  }
+}
+
+void vtkExodusIIReaderPrivate::SetPrefetchNextTimeStep( vtkTypeBool prefetch )
+{
+  this->PrefetchNextTimeStep = prefetch;
+  if ( ! prefetch )
+  {
+    this->CancelPrefetch();
+  }
+}
+
+void vtkExodusIIReaderPrivate::QueuePrefetch( int timeStep )
+{
+  int next = timeStep + 1;
+  if ( ! this->PrefetchNextTimeStep || next >= static_cast<int>( this->Times.size() ) )
+  {
+    this->RequestedKeys.clear();
+    return;
+  }
+
+  PrefetchState* state = this->Prefetch;
+  state->Lock.Lock();
+  state->Pending.clear();
+  for ( std::set<vtkExodusIICacheKey>::const_iterator it = this->RequestedKeys.begin();
+    it != this->RequestedKeys.end(); ++it )
+  {
+    vtkExodusIICacheKey key( *it );
+    key.Time = next;
+    state->Pending.push_back( key );
+  }
+  ++state->Generation;
+  if ( state->ThreadId < 0 )
+  {
+    state->ThreadId = state->Threader->SpawnThread(
+      &vtkExodusIIReaderPrivate::PrefetchWorker, this );
+  }
+  state->Changed.Broadcast();
+  state->Lock.Unlock();
+  this->RequestedKeys.clear();
+}
+
+void vtkExodusIIReaderPrivate::CancelPrefetch()
+{
+  PrefetchState* state = this->Prefetch;
+  state->Lock.Lock();
+  state->Pending.clear();
+  ++state->Generation;
+  state->Changed.Broadcast();
+  state->Lock.Unlock();
+}
+
+void vtkExodusIIReaderPrivate::WaitForPrefetch()
+{
+  PrefetchState* state = this->Prefetch;
+  state->Lock.Lock();
+  while ( state->Busy || ( state->ThreadId >= 0 && ! state->Pending.empty() ) )
+  {
+    state->Changed.Wait( state->Lock );
+  }
+  state->Lock.Unlock();
+}
+
+void vtkExodusIIReaderPrivate::StopPrefetch()
+{
+  PrefetchState* state = this->Prefetch;
+  state->Lock.Lock();
+  state->Stop = true;
+  state->Pending.clear();
+  state->Changed.Broadcast();
+  int threadId = state->ThreadId;
+  state->Lock.Unlock();
+  if ( threadId >= 0 )
+  {
+    state->Threader->TerminateThread( threadId );
+  }
+  state->ThreadId = -1;
+  state->Stop = false;
+}
+
+VTK_THREAD_RETURN_TYPE vtkExodusIIReaderPrivate::PrefetchWorker( void* arg )
+{
+  vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>( arg );
+  vtkExodusIIReaderPrivate* self = static_cast<vtkExodusIIReaderPrivate*>( info->UserData );
+  PrefetchState* state = self->Prefetch;
+
+  state->Lock.Lock();
+  for ( ;; )
+  {
+    while ( ! state->Stop && state->Pending.empty() )
+    {
+      state->Changed.Wait( state->Lock );
+    }
+    if ( state->Stop )
+    {
+      break;
+    }
+    vtkExodusIICacheKey key = state->Pending.front();
+    state->Pending.pop_front();
+    unsigned long generation = state->Generation;
+    state->Busy = true;
+    state->Lock.Unlock();
+
+    {
+      std::lock_guard<std::recursive_mutex> readerLock( state->ReaderMutex );
+      self->PrefetchKey( key, generation );
+    }
+
+    state->Lock.Lock();
+    state->Busy = false;
+    state->Changed.Broadcast();
+  }
+  state->Lock.Unlock();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+void vtkExodusIIReaderPrivate::PrefetchKey( const vtkExodusIICacheKey& key, unsigned long generation )
+{
+  PrefetchState* state = this->Prefetch;
+  state->Lock.Lock();
+  bool current = ( generation == state->Generation );
+  state->Lock.Unlock();
+
+  // With a shared cache, another reader may have read the key meanwhile.
+  if ( current && ! this->GetCacheForKey( key )->Contains( key ) )
+  {
+    const char* filename = this->Parent->GetFileName();
+    if ( this->Exoid >= 0 || ( filename && this->OpenFile( filename ) ) )
+    {
+      this->GetCacheOrRead( key );
+    }
+  }
+
+  // The file stays open between the keys of a time step; the main thread
+  // reopens it anyway for its next request.
+  state->Lock.Lock();
+  bool done = state->Pending.empty();
+  state->Lock.Unlock();
+  if ( done )
+  {
+    this->CloseFile();
+  }
+}
+
 bool vtkExodusIIReaderPrivate::IsXMLMetadataValid()
 {
   // Make sure that each block id referred to in the metadata arrays exist
@@ -5303,11 +5715,11 @@ int vtkExodusIIReader::CanReadFile( const char* fname )
   int diskWordSize = 8;
   float version;
 
-  if ( (exoid = ex_open( fname, EX_READ, &appWordSize, &diskWordSize, &version )) < 0 )
+  if ( (exoid = vtkExodusIICall( vtkExodusIIOpen, fname, EX_READ, &appWordSize, &diskWordSize, &version )) < 0 )
   {
     return 0;
   }
-  if ( ex_close( exoid ) != 0 )
+  if ( vtkExodusIICall( ex_close, exoid ) != 0 )
   {
     vtkWarningMacro( "Unable to close \"" << fname << "\" opened for testing." );
     return 0;
@@ -5423,6 +5835,7 @@ int vtkExodusIIReader::RequestInformation(
   int newMetadata = 0;
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
+  std::lock_guard<std::recursive_mutex> readerLock( this->Metadata->Prefetch->ReaderMutex );
   // If the metadata is older than the filename
   if ( this->GetMetadataMTime() < this->FileNameMTime )
   {
@@ -5490,6 +5903,9 @@ int vtkExodusIIReader::RequestData(
   vtkInformationVector** vtkNotUsed(inputVector),
   vtkInformationVector* outputVector )
 {
+  // The file is only locked by the calls to the exodus library, so that other
+  // readers can read while this one assembles its output.
+  std::lock_guard<std::recursive_mutex> readerLock( this->Metadata->Prefetch->ReaderMutex );
   if ( ! this->FileName || ! this->Metadata->OpenFile( this->FileName ) )
   {
     vtkErrorMacro( "Unable to open file \"" << (this->FileName ? this->FileName : "(null)") << "\" to read data" );
@@ -5554,7 +5970,7 @@ int vtkExodusIIReader::RequestData(
 
 int vtkExodusIIReader::GetMaxNameLength()
 {
-  return ex_inquire_int(this->Metadata->Exoid, EX_INQ_DB_MAX_USED_NAME_LENGTH);
+  return vtkExodusIICall( ex_inquire_int, this->Metadata->Exoid, EX_INQ_DB_MAX_USED_NAME_LENGTH);
 }
 
 void vtkExodusIIReader::SetGenerateObjectIdCellArray( vtkTypeBool x ) { this->Metadata->SetGenerateObjectIdArray( x ); }
@@ -6491,6 +6907,51 @@ double vtkExodusIIReader::GetCacheSize()
   return this->Metadata->GetCacheSize();
 }
 
+void vtkExodusIIReader::SetUseSharedCache(vtkTypeBool use)
+{
+  this->Metadata->SetUseSharedCache(use);
+}
+
+vtkTypeBool vtkExodusIIReader::GetUseSharedCache()
+{
+  return this->Metadata->GetUseSharedCache();
+}
+
+void vtkExodusIIReader::SetCompressCache(vtkTypeBool compress)
+{
+  this->Metadata->SetCompressCache(compress);
+}
+
+vtkTypeBool vtkExodusIIReader::GetCompressCache()
+{
+  return this->Metadata->GetCompressCache();
+}
+
+void vtkExodusIIReader::SetPrefetchNextTimeStep(vtkTypeBool prefetch)
+{
+  this->Metadata->SetPrefetchNextTimeStep(prefetch);
+}
+
+vtkTypeBool vtkExodusIIReader::GetPrefetchNextTimeStep()
+{
+  return this->Metadata->GetPrefetchNextTimeStep();
+}
+
+void vtkExodusIIReader::WaitForPrefetch()
+{
+  this->Metadata->WaitForPrefetch();
+}
+
+void vtkExodusIIReader::SetParallelAssembly(vtkTypeBool parallel)
+{
+  this->Metadata->SetParallelAssembly(parallel);
+}
+
+vtkTypeBool vtkExodusIIReader::GetParallelAssembly()
+{
+  return this->Metadata->GetParallelAssembly();
+}
+
 void vtkExodusIIReader::SetSqueezePoints(bool sp)
 {
   this->Metadata->SetSqueezePoints(sp ? 1 : 0);
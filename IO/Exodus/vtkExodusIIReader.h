@@ -751,6 +751,64 @@ public:
    */
   double GetCacheSize();
 
+  //@{
+  /**
+   * When on, the arrays that do not depend on the settings of this reader
+   * are kept in a cache shared by all the readers of the same file in this
+   * process, so that readers of the same file, e.g. in several views, read
+   * each array from the file only once. Its size is the cache size of the
+   * last reader opening the file. Displaced coordinates stay in the cache of
+   * each reader. Takes effect the next time the file is opened. Off by
+   * default.
+   */
+  void SetUseSharedCache(vtkTypeBool use);
+  vtkTypeBool GetUseSharedCache();
+  vtkBooleanMacro(UseSharedCache, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * When on, the least recently used arrays are LZ4-compressed inside the
+   * cache when it is full, before any is dropped. Off by default.
+   */
+  void SetCompressCache(vtkTypeBool compress);
+  vtkTypeBool GetCompressCache();
+  vtkBooleanMacro(CompressCache, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * When on, the time-varying arrays read for a time step are read for the
+   * next time step by a background thread, so that playing forward finds
+   * them in the cache. The cache must be large enough to hold both time
+   * steps. The calls to the exodus library of all the readers are
+   * serialized since the netCDF library is not thread-safe, but a reader
+   * assembling its output does not block the others. Off by default.
+   */
+  void SetPrefetchNextTimeStep(vtkTypeBool prefetch);
+  vtkTypeBool GetPrefetchNextTimeStep();
+  vtkBooleanMacro(PrefetchNextTimeStep, vtkTypeBool);
+  //@}
+
+  /**
+   * Wait until the arrays being prefetched are in the cache.
+   */
+  void WaitForPrefetch();
+
+  //@{
+  /**
+   * When on, the element, face and edge blocks and the node sets are
+   * assembled concurrently with vtkSMPTools: the conversion of their
+   * connectivity, the squeezing of their points and the extraction of their
+   * point arrays. Reads from the file stay serialized since the netCDF
+   * library is not thread-safe, and polyhedral blocks and the other sets are
+   * assembled serially. Off by default.
+   */
+  void SetParallelAssembly(vtkTypeBool parallel);
+  vtkTypeBool GetParallelAssembly();
+  vtkBooleanMacro(ParallelAssembly, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Should the reader output only points used by elements in the output mesh,
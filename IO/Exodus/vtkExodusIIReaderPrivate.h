@@ -8,9 +8,13 @@
 
 #include "vtkToolkits.h" // make sure VTK_USE_PARALLEL is properly set
 #include "vtkExodusIICache.h"
+#include "vtkMultiThreader.h"
+#include "vtkSmartPointer.h"
 #include "vtksys/RegularExpression.hxx"
 
 #include <map>
+#include <mutex>
+#include <set>
 #include <vector>
 
 #include "vtk_exodusII.h"
@@ -80,6 +84,26 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /** Set whether arrays that do not depend on the settings of this reader are
+    * kept in the cache shared by the readers of the same file.
+    * This takes effect the next time the file is opened.
+    */
+  void SetUseSharedCache( vtkTypeBool use );
+  vtkGetMacro(UseSharedCache, vtkTypeBool);
+
+  /// Set whether the least recently used arrays of the caches are kept compressed.
+  void SetCompressCache( vtkTypeBool compress );
+  vtkGetMacro(CompressCache, vtkTypeBool);
+
+  /** Set whether RequestData() reads the arrays of the next time step in the
+    * background once it is done.
+    */
+  void SetPrefetchNextTimeStep( vtkTypeBool prefetch );
+  vtkGetMacro(PrefetchNextTimeStep, vtkTypeBool);
+
+  /// Wait until the arrays being prefetched are in the cache.
+  void WaitForPrefetch();
+
   /** Return the number of time steps in the open file.
     * You must have called RequestInformation() before
     * invoking this member function.
@@ -265,6 +289,12 @@ public:
   vtkSetMacro(IgnoreFileTime, bool);
   vtkGetMacro(IgnoreFileTime, bool);
 
+  /** Should RequestData() assemble the blocks and node sets concurrently?
+    * Reads from the file are serialized either way.
+    */
+  vtkSetMacro(ParallelAssembly, vtkTypeBool);
+  vtkGetMacro(ParallelAssembly, vtkTypeBool);
+
   vtkDataArray* FindDisplacementVectors( int timeStep );
 
   const struct ex_init_params* GetModelParams() const
@@ -576,6 +606,18 @@ protected:
     BlockSetInfoType* bsinfop, vtkUnstructuredGrid* output );
   int AssembleOutputCellMaps( vtkIdType timeStep,
     int otyp, int oidx, BlockSetInfoType* bsinfop, vtkUnstructuredGrid* output );
+  /** Assemble the connectivity, points and arrays of one block or set.
+    * This calls the AssembleOutput functions above in order.
+    */
+  void AssembleOutputObject( vtkIdType timeStep, int otyp, int oidx,
+    int conntypidx, BlockSetInfoType* bsinfop, vtkUnstructuredGrid* output );
+  /** Return whether AssembleOutputObject() may run concurrently for objects
+    * of the given connectivity type, i.e. whether it only modifies bsinfop
+    * and output besides calling GetCacheOrRead().
+    */
+  bool CanAssembleInParallel( int conntypidx, BlockSetInfoType* bsinfop );
+  /// Calls AssembleOutputObject() for a range of objects from vtkSMPTools::For().
+  struct AssembleObjectsFunctor;
   /** Add fast-path time-varying data to field data of an output block or set.
     */
   int AssembleArraysOverTime(vtkMultiBlockDataSet* output);
@@ -640,6 +682,17 @@ protected:
     */
   vtkDataArray* GetCacheOrRead( vtkExodusIICacheKey );
 
+  /// Return the held or cached array for a key without reading the file.
+  vtkDataArray* FindArray( const vtkExodusIICacheKey& key );
+
+  /** Read the array for a key from the file and return a new reference, or
+    * nullptr. ReadMutex must be held.
+    */
+  vtkDataArray* ReadArray( vtkExodusIICacheKey key );
+
+  /// Add an array to HeldArrays if HoldArrays is set.
+  void HoldArray( const vtkExodusIICacheKey& key, vtkDataArray* arr );
+
   /** Return the index of an object type (in a private list of all object types).
     * This returns a 0-based index if the object type was found and -1 if it
     * was not.
@@ -826,6 +879,55 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /** The cache shared by the readers of the open file, used for the arrays that
+    * do not depend on the settings of this reader, or nullptr.
+    */
+  vtkExodusIICache* SharedCache;
+  vtkTypeBool UseSharedCache;
+  vtkTypeBool CompressCache;
+
+  /// Return the cache holding the array for a key.
+  vtkExodusIICache* GetCacheForKey( const vtkExodusIICacheKey& key );
+
+  /// Acquire the shared cache of a file, or release it when filename is nullptr.
+  void UpdateSharedCache( const char* filename );
+
+  /** Arrays returned by GetCacheOrRead() while HoldArrays is set, kept alive until
+    * RequestData() is done even if they are dropped from the caches meanwhile,
+    * so that each array is read at most once per request.
+    */
+  std::map<vtkExodusIICacheKey, vtkSmartPointer<vtkDataArray> > HeldArrays;
+  bool HoldArrays;
+  /// Protects HeldArrays and RequestedKeys when objects are assembled in parallel.
+  std::mutex HoldMutex;
+  /// Serializes the reads of GetCacheOrRead(), so that each array is read once.
+  std::recursive_mutex ReadMutex;
+  vtkTypeBool ParallelAssembly;
+
+  /** The time-varying cache keys read by RequestData(), which are prefetched
+    * for the next time step when PrefetchNextTimeStep is set.
+    */
+  std::set<vtkExodusIICacheKey> RequestedKeys;
+  vtkTypeBool PrefetchNextTimeStep;
+
+  /// The state of the thread prefetching cache keys.
+  struct PrefetchState;
+  PrefetchState* Prefetch;
+
+  /// Queue the keys of RequestedKeys for the given time step.
+  void QueuePrefetch( int timeStep );
+
+  /// Drop the queued keys; the key being read, if any, is still read.
+  void CancelPrefetch();
+
+  /// Stop the prefetching thread.
+  void StopPrefetch();
+
+  /// Read a queued key unless the queue was changed since. ReaderMutex must be held.
+  void PrefetchKey( const vtkExodusIICacheKey& key, unsigned long generation );
+
+  static VTK_THREAD_RETURN_TYPE PrefetchWorker( void* arg );
+
   vtkTypeBool ApplyDisplacements;
   float DisplacementMagnitude;
   vtkTypeBool HasModeShapes;
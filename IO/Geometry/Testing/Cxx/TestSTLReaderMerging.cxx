@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSTLReaderMerging.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the default point merging of vtkSTLReader gives the same
+// points, triangles and solid labels (ASCII only) as merging with
+// vtkMergePoints, for both binary and ASCII files.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkMergePoints.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkSTLWriter.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> Read(const std::string& fileName, bool merging,
+                                  bool locator)
+{
+  vtkSmartPointer<vtkSTLReader> reader = vtkSmartPointer<vtkSTLReader>::New();
+  reader->SetFileName(fileName.c_str());
+  reader->SetMerging(merging);
+  reader->ScalarTagsOn();
+  if (locator)
+  {
+    vtkSmartPointer<vtkMergePoints> mergePoints =
+      vtkSmartPointer<vtkMergePoints>::New();
+    reader->SetLocator(mergePoints);
+  }
+  reader->Update();
+
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(reader->GetOutput());
+  return output;
+}
+
+bool SameOutput(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    std::cerr << a->GetNumberOfPoints() << " and " << b->GetNumberOfPoints()
+              << " points, " << a->GetNumberOfPolys() << " and "
+              << b->GetNumberOfPolys() << " triangles" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    a->GetPoint(i, x);
+    b->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+
+  vtkIdTypeArray* cellsA = a->GetPolys()->GetData();
+  vtkIdTypeArray* cellsB = b->GetPolys()->GetData();
+  vtkDataArray* scalarsA = a->GetCellData()->GetScalars();
+  vtkDataArray* scalarsB = b->GetCellData()->GetScalars();
+  for (vtkIdType i = 0; i < cellsA->GetNumberOfValues(); ++i)
+  {
+    if (cellsA->GetValue(i) != cellsB->GetValue(i))
+    {
+      std::cerr << "Triangle " << i / 4 << " differs" << std::endl;
+      return false;
+    }
+  }
+  if (!scalarsA != !scalarsB)
+  {
+    std::cerr << "Solid labels missing" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; scalarsA && i < a->GetNumberOfPolys(); ++i)
+  {
+    if (scalarsA->GetTuple1(i) != scalarsB->GetTuple1(i))
+    {
+      std::cerr << "Solid label of triangle " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestFile(const std::string& fileName, vtkIdType numTriangles)
+{
+  vtkSmartPointer<vtkPolyData> unmerged = Read(fileName, false, false);
+  if (unmerged->GetNumberOfPolys() != numTriangles ||
+      unmerged->GetNumberOfPoints() != 3 * numTriangles)
+  {
+    std::cerr << fileName << ": expected " << numTriangles
+              << " unmerged triangles, got " << unmerged->GetNumberOfPolys()
+              << " with " << unmerged->GetNumberOfPoints() << " points"
+              << std::endl;
+    return false;
+  }
+
+  vtkSmartPointer<vtkPolyData> sorted = Read(fileName, true, false);
+  vtkSmartPointer<vtkPolyData> located = Read(fileName, true, true);
+  if (!SameOutput(sorted, located))
+  {
+    std::cerr << fileName << ": merged outputs differ" << std::endl;
+    return false;
+  }
+  if (sorted->GetNumberOfPoints() >= unmerged->GetNumberOfPoints())
+  {
+    std::cerr << fileName << ": no points were merged" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestSTLReaderMerging(int argc, char *argv[])
+{
+  char *tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cout << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  std::string testDirectory = tempDir;
+  delete [] tempDir;
+
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+
+  // Add a triangle that collapses when its points are merged.
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->DeepCopy(sphere->GetOutput());
+  vtkIdType degenerate[3] = { 0, 0, 1 };
+  polyData->GetPolys()->InsertNextCell(3, degenerate);
+  const vtkIdType numTriangles = polyData->GetNumberOfPolys();
+
+  vtkSmartPointer<vtkSTLWriter> writer = vtkSmartPointer<vtkSTLWriter>::New();
+  writer->SetInputData(polyData);
+
+  std::string binaryName = testDirectory + "/STLReaderMerging.stl";
+  writer->SetFileName(binaryName.c_str());
+  writer->SetFileTypeToBinary();
+  writer->Write();
+
+  std::string asciiName = testDirectory + "/STLReaderMergingASCII.stl";
+  writer->SetFileName(asciiName.c_str());
+  writer->SetFileTypeToASCII();
+  writer->Write();
+
+  if (!TestFile(binaryName, numTriangles) || !TestFile(asciiName, numTriangles))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
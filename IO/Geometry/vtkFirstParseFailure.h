@@ -0,0 +1,93 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFirstParseFailure.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkFirstParseFailure
+ * @brief   parse items in parallel and find the first one that fails
+ *
+ * vtkFirstParseFailure is a private helper of the text readers of this
+ * module. It calls a functor bool(vtkIdType) for each item with
+ * vtkSMPTools and returns the index of the first item for which the
+ * functor returned false, so that the error reported is the one a serial
+ * parse would have stopped at.
+ *
+ * @sa
+ * vtkOBJReader vtkSTLReader
+*/
+
+#ifndef vtkFirstParseFailure_h
+#define vtkFirstParseFailure_h
+
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm> // For std::min
+
+template <typename ParseFunctor>
+class vtkFirstParseFailure
+{
+public:
+  /**
+   * Parse items 0 to numItems-1. Returns the index of the first item that
+   * failed to parse, or numItems if all of them parsed.
+   */
+  static vtkIdType Find(ParseFunctor& parse, vtkIdType numItems)
+  {
+    vtkFirstParseFailure<ParseFunctor> worker(parse, numItems);
+    vtkSMPTools::For(0, numItems, worker);
+    return worker.FirstFailure;
+  }
+
+  vtkFirstParseFailure(ParseFunctor& parse, vtkIdType numItems)
+    : Parse(parse), NumberOfItems(numItems), FirstFailure(numItems)
+  {
+  }
+
+  void Initialize()
+  {
+    this->LocalFirstFailure.Local() = this->NumberOfItems;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType &firstFailure = this->LocalFirstFailure.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (!this->Parse(i) && i < firstFailure)
+      {
+        firstFailure = i;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->FirstFailure = this->NumberOfItems;
+    for (typename vtkSMPThreadLocal<vtkIdType>::iterator iter =
+           this->LocalFirstFailure.begin();
+         iter != this->LocalFirstFailure.end(); ++iter)
+    {
+      this->FirstFailure = std::min(this->FirstFailure, *iter);
+    }
+  }
+
+private:
+  ParseFunctor &Parse;
+  vtkIdType NumberOfItems;
+  vtkIdType FirstFailure;
+  vtkSMPThreadLocal<vtkIdType> LocalFirstFailure;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkFirstParseFailure.h
@@ -15,20 +15,148 @@
 #include "vtkOBJReader.h"
 
 #include "vtkCellArray.h"
+#include "vtkFirstParseFailure.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include <algorithm>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <unordered_map>
+#include <vector>
 
 #include "vtkCellData.h"
 #include "vtkStringArray.h"
 
 vtkStandardNewMacro(vtkOBJReader);
 
+namespace
+{
+//----------------------------------------------------------------------------
+// The contents of the file, read in one go, with fgets() like access to its
+// lines.
+class vtkOBJReaderBuffer
+{
+public:
+  vtkOBJReaderBuffer() : Position(0), LineStart(0) {}
+
+  void Read(FILE *in)
+  {
+    char chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), in)) > 0)
+    {
+      this->Data.insert(this->Data.end(), chunk, chunk + n);
+    }
+    this->Data.push_back('\0');
+  }
+
+  void Rewind()
+  {
+    this->Position = 0;
+  }
+
+  bool AtEnd() const
+  {
+    return this->Position + 1 >= this->Data.size();
+  }
+
+  // Copy the next line, or as much of it as fits, into line.
+  bool GetLine(char *line, int maxLine)
+  {
+    if (this->AtEnd())
+    {
+      return false;
+    }
+    const char *begin = this->Data.data() + this->Position;
+    size_t n = std::min(this->Data.size() - 1 - this->Position,
+                        static_cast<size_t>(maxLine - 1));
+    const char *eol = static_cast<const char*>(memchr(begin, '\n', n));
+    if (eol)
+    {
+      n = eol - begin + 1;
+    }
+    memcpy(line, begin, n);
+    line[n] = '\0';
+    this->LineStart = this->Position;
+    this->Position += n;
+    return true;
+  }
+
+  // Offset in the file of p, which points into the last line read.
+  size_t GetOffset(const char *line, const char *p) const
+  {
+    return this->LineStart + (p - line);
+  }
+
+  int GetLineNumber(size_t offset) const
+  {
+    return 1 + static_cast<int>(std::count(
+      this->Data.begin(), this->Data.begin() + offset, '\n'));
+  }
+
+  std::vector<char> Data;
+  size_t Position;
+  size_t LineStart;
+};
+
+//----------------------------------------------------------------------------
+// Convert the three floats of 'v' and 'vn' lines, the way sscanf("%f %f %f")
+// would.
+class vtkOBJReaderParseTriples
+{
+public:
+  const char *Data;
+  const size_t *Offsets;
+  float *Values;
+
+  static bool ParseTriple(const char *p, float *x)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      // do not skip past the end of the line
+      while (*p != '\n' && isspace(static_cast<unsigned char>(*p)))
+      {
+        p++;
+      }
+      if (*p == '\n')
+      {
+        return false;
+      }
+      char *end;
+      x[k] = strtof(p, &end);
+      if (end == p)
+      {
+        return false;
+      }
+      p = end;
+    }
+    return true;
+  }
+
+  bool operator()(vtkIdType i)
+  {
+    return ParseTriple(this->Data + this->Offsets[i], this->Values + 3 * i);
+  }
+
+  // Returns the index of the first triple that failed to parse, or
+  // the number of triples if all of them parsed.
+  vtkIdType Execute(const vtkOBJReaderBuffer &buffer,
+                    const std::vector<size_t> &offsets, float *values)
+  {
+    this->Data = buffer.Data.data();
+    this->Offsets = offsets.data();
+    this->Values = values;
+    return vtkFirstParseFailure<vtkOBJReaderParseTriples>::Find(
+      *this, static_cast<vtkIdType>(offsets.size()));
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 vtkOBJReader::vtkOBJReader()
 {
@@ -133,6 +261,13 @@ int vtkOBJReader::RequestData(
 
   vtkDebugMacro(<<"Reading file");
 
+  // The file is read once and then scanned twice from memory. The floats of
+  // 'v' and 'vn' lines, which make up most of a typical file, are only
+  // located while scanning and are converted in parallel afterwards.
+  vtkOBJReaderBuffer buffer;
+  buffer.Read(in);
+  fclose(in);
+
   // initialize some structures to store the file contents in
   vtkPoints *points = vtkPoints::New();
   std::unordered_map<std::string, vtkFloatArray*> tcoords_map;
@@ -183,18 +318,20 @@ int vtkOBJReader::RequestData(
   int numPoints = 0;
   int numTCoords = 0;
   int numNormals = 0;
+  std::vector<size_t> pointOffsets;
+  std::vector<size_t> normalOffsets;
 
   // First loop to initialize the data arrays for the different set of texture coordinates
   bool readingFirstComment = true;
   std::string firstComment;
   int lineNr = 0;
-  while (everything_ok && fgets(rawLine, MAX_LINE, in) != nullptr)
+  while (everything_ok && buffer.GetLine(rawLine, MAX_LINE))
   {
     ++lineNr;
     char *pLine = rawLine;
     char *pEnd = rawLine + strlen(rawLine);
 
-    if (*(pEnd-1) != '\n' && ! feof(in))
+    if (*(pEnd-1) != '\n' && !buffer.AtEnd())
     {
       vtkErrorMacro(<< "Line longer than " << MAX_LINE << ": " <<  pLine);
       everything_ok = false;
@@ -299,8 +436,8 @@ int vtkOBJReader::RequestData(
 
   // Second loop to parse points, faces, texture coordinates, normals...
   lineNr = 0;
-  fseek(in, 0, SEEK_SET);
-  while (everything_ok && fgets(rawLine, MAX_LINE, in) != nullptr)
+  buffer.Rewind();
+  while (everything_ok && buffer.GetLine(rawLine, MAX_LINE))
   {
     ++lineNr;
     char *pLine = rawLine;
@@ -330,17 +467,11 @@ int vtkOBJReader::RequestData(
     }
     else if (strcmp(cmd, "v") == 0)
     {
-      // vertex definition, expect three floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f %f", xyz, xyz+1, xyz+2) == 3)
-      {
-        points->InsertNextPoint(xyz);
-        numPoints++;
-      }
-      else
-      {
-        vtkErrorMacro(<<"Error reading 'v' at line " << lineNr);
-        everything_ok = false;
-      }
+      // vertex definition, expect three floats, separated by whitespace,
+      // these are converted after the loop. (start from the character that
+      // ended the command, so that a line without floats is not read past)
+      pointOffsets.push_back(buffer.GetOffset(rawLine, pLine - 1));
+      numPoints++;
     }
     else if (strcmp(cmd, "usemtl") == 0)
     {
@@ -366,18 +497,11 @@ int vtkOBJReader::RequestData(
     }
     else if (strcmp(cmd, "vn") == 0)
     {
-      // vertex normal, expect three floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f %f", xyz, xyz+1, xyz+2) == 3)
-      {
-        normals->InsertNextTuple(xyz);
-        hasNormals = true;
-        numNormals++;
-      }
-      else
-      {
-        vtkErrorMacro(<<"Error reading 'vn' at line " << lineNr);
-        everything_ok = false;
-      }
+      // vertex normal, expect three floats, separated by whitespace,
+      // these are converted after the loop:
+      normalOffsets.push_back(buffer.GetOffset(rawLine, pLine - 1));
+      hasNormals = true;
+      numNormals++;
     }
     else if (strcmp(cmd, "p") == 0)
     {
@@ -409,7 +533,7 @@ int vtkOBJReader::RequestData(
           else if (strcmp(pLine, "\\\n") == 0)
           {
             // handle backslash-newline continuation
-            if (fgets(rawLine, MAX_LINE, in) != nullptr)
+            if (buffer.GetLine(rawLine, MAX_LINE))
             {
               lineNr++;
               pLine = rawLine;
@@ -489,7 +613,7 @@ int vtkOBJReader::RequestData(
           else if (strcmp(pLine, "\\\n") == 0)
           {
             // handle backslash-newline continuation
-            if (fgets(rawLine, MAX_LINE, in) != nullptr)
+            if (buffer.GetLine(rawLine, MAX_LINE))
             {
               lineNr++;
               pLine = rawLine;
@@ -657,7 +781,7 @@ int vtkOBJReader::RequestData(
           else if (strcmp(pLine, "\\\n") == 0)
           {
             // handle backslash-newline continuation
-            if (fgets(rawLine, MAX_LINE, in) != nullptr)
+            if (buffer.GetLine(rawLine, MAX_LINE))
             {
               lineNr++;
               pLine = rawLine;
@@ -722,10 +846,33 @@ int vtkOBJReader::RequestData(
 
   } // (end of while loop)
 
-  } // (end of local scope section)
+  // convert the vertices and vertex normals
+  if (everything_ok)
+  {
+    vtkOBJReaderParseTriples parsePoints;
+    points->SetNumberOfPoints(numPoints);
+    vtkIdType failure = parsePoints.Execute(buffer, pointOffsets,
+      static_cast<float*>(points->GetVoidPointer(0)));
+    if (failure < numPoints)
+    {
+      vtkErrorMacro(<<"Error reading 'v' at line "
+        << buffer.GetLineNumber(pointOffsets[failure]));
+      everything_ok = false;
+    }
 
-  // we have finished with the file
-  fclose(in);
+    vtkOBJReaderParseTriples parseNormals;
+    normals->SetNumberOfTuples(numNormals);
+    failure = parseNormals.Execute(buffer, normalOffsets,
+      normals->GetPointer(0));
+    if (everything_ok && failure < numNormals)
+    {
+      vtkErrorMacro(<<"Error reading 'vn' at line "
+        << buffer.GetLineNumber(normalOffsets[failure]));
+      everything_ok = false;
+    }
+  }
+
+  } // (end of local scope section)
 
   const bool hasGroups = (groupId >= 0);
   const bool hasMaterials = (matcnt > 0);
@@ -18,7 +18,9 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkErrorCode.h"
+#include "vtkFirstParseFailure.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -26,13 +28,17 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -43,6 +49,228 @@ vtkStandardNewMacro(vtkSTLReader);
 vtkCxxSetObjectMacro(vtkSTLReader, Locator, vtkIncrementalPointLocator);
 vtkCxxSetObjectMacro(vtkSTLReader, BinaryHeader, vtkUnsignedCharArray);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Fill in triangle i as points 3i, 3i+1 and 3i+2.
+void stlFillTriangles(vtkIdType *cells, vtkIdType begin, vtkIdType end)
+{
+  for (vtkIdType i = begin; i < end; ++i)
+  {
+    vtkIdType *cell = cells + 4 * i;
+    cell[0] = 3;
+    cell[1] = 3 * i;
+    cell[2] = 3 * i + 1;
+    cell[3] = 3 * i + 2;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Copy the vertices of binary facet records into points and triangles.
+class vtkSTLReaderCopyFacets
+{
+public:
+  const unsigned char *Facets;
+  float *Points;
+  vtkIdType *Cells;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      // Each record is a normal and three vertices stored as twelve
+      // little-endian floats, followed by a 2 byte attribute count.
+      float *x = this->Points + 9 * i;
+      memcpy(x, this->Facets + 50 * i + 12, 9 * sizeof(float));
+      vtkByteSwap::Swap4LERange(x, 9);
+    }
+    stlFillTriangles(this->Cells, begin, end);
+  }
+};
+
+//------------------------------------------------------------------------------
+// Orders point ids by their coordinates and then by id, so coincident points
+// end up next to each other with the first occurrence leading.
+class vtkSTLReaderPointLess
+{
+public:
+  const float *X;
+
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    const float *p = this->X + 3 * a;
+    const float *q = this->X + 3 * b;
+    for (int k = 0; k < 3; ++k)
+    {
+      if (p[k] < q[k])
+      {
+        return true;
+      }
+      if (q[k] < p[k])
+      {
+        return false;
+      }
+    }
+    return a < b;
+  }
+};
+
+//------------------------------------------------------------------------------
+class vtkSTLReaderCopyMergedPoints
+{
+public:
+  const float *X;
+  const vtkIdType *UniqueIds;
+  float *MergedX;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      memcpy(this->MergedX + 3 * i, this->X + 3 * this->UniqueIds[i],
+             3 * sizeof(float));
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+class vtkSTLReaderRemapTriangles
+{
+public:
+  const vtkIdType *PointMap;
+  vtkIdType *Cells;
+  unsigned char *Keep;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType *cell = this->Cells + 4 * i;
+      cell[1] = this->PointMap[cell[1]];
+      cell[2] = this->PointMap[cell[2]];
+      cell[3] = this->PointMap[cell[3]];
+      this->Keep[i] = cell[1] != cell[2] && cell[1] != cell[3] &&
+        cell[2] != cell[3];
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Merge coincident points of the triangles read from the file. This gives
+// the same result as inserting the points into a vtkMergePoints locator one
+// triangle at a time: merged points keep the order of their first
+// occurrence and triangles that collapse are dropped along with their
+// scalars. The points are sorted in parallel instead of being hashed one
+// by one.
+void stlMergePoints(vtkPoints *pts, vtkCellArray *polys, vtkFloatArray *scalars,
+                    vtkPoints *mergedPts, vtkCellArray *mergedPolys,
+                    vtkFloatArray *mergedScalars)
+{
+  const vtkIdType numPts = pts->GetNumberOfPoints();
+  const vtkIdType numTris = polys->GetNumberOfCells();
+  const float *x = static_cast<const float*>(pts->GetVoidPointer(0));
+
+  // Points with NaN coordinates never compare equal, so they are left out
+  // of the sort and are never merged.
+  std::vector<vtkIdType> pointMap(numPts);
+  std::vector<vtkIdType> order;
+  order.reserve(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    const float *p = x + 3 * i;
+    pointMap[i] = i;
+    if (!std::isnan(p[0]) && !std::isnan(p[1]) && !std::isnan(p[2]))
+    {
+      order.push_back(i);
+    }
+  }
+
+  vtkSTLReaderPointLess less;
+  less.X = x;
+  vtkSMPTools::Sort(order.begin(), order.end(), less);
+
+  // Map every point to the first point of its group of coincident points.
+  vtkIdType first = 0;
+  for (size_t j = 0; j < order.size(); ++j)
+  {
+    const float *p = x + 3 * order[j];
+    const float *q = x + 3 * first;
+    if (j == 0 || p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+    {
+      first = order[j];
+    }
+    pointMap[order[j]] = first;
+  }
+
+  // Number the remaining points in order of first occurrence. Since a
+  // group starts with its smallest id, its new id is known by the time any
+  // of its other points is reached.
+  std::vector<vtkIdType> uniqueIds;
+  uniqueIds.reserve(numPts / 2);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    if (pointMap[i] == i)
+    {
+      pointMap[i] = static_cast<vtkIdType>(uniqueIds.size());
+      uniqueIds.push_back(i);
+    }
+    else
+    {
+      pointMap[i] = pointMap[pointMap[i]];
+    }
+  }
+
+  const vtkIdType numMergedPts = static_cast<vtkIdType>(uniqueIds.size());
+  mergedPts->SetDataTypeToFloat();
+  mergedPts->SetNumberOfPoints(numMergedPts);
+  vtkSTLReaderCopyMergedPoints copyPoints;
+  copyPoints.X = x;
+  copyPoints.UniqueIds = uniqueIds.data();
+  copyPoints.MergedX = static_cast<float*>(mergedPts->GetVoidPointer(0));
+  vtkSMPTools::For(0, numMergedPts, copyPoints);
+
+  // Renumber the triangles in parallel, then squeeze out the degenerate
+  // ones.
+  std::vector<unsigned char> keep(numTris);
+  vtkNew<vtkIdTypeArray> cellArray;
+  cellArray->SetNumberOfValues(4 * numTris);
+  vtkIdType *cells = cellArray->GetPointer(0);
+  memcpy(cells, polys->GetPointer(), 4 * numTris * sizeof(vtkIdType));
+  vtkSTLReaderRemapTriangles remap;
+  remap.PointMap = pointMap.data();
+  remap.Cells = cells;
+  remap.Keep = keep.data();
+  vtkSMPTools::For(0, numTris, remap);
+
+  vtkIdType numMergedTris = 0;
+  if (mergedScalars)
+  {
+    mergedScalars->SetNumberOfValues(numTris);
+  }
+  for (vtkIdType i = 0; i < numTris; ++i)
+  {
+    if (keep[i])
+    {
+      if (numMergedTris != i)
+      {
+        memcpy(cells + 4 * numMergedTris, cells + 4 * i, 4 * sizeof(vtkIdType));
+      }
+      if (mergedScalars)
+      {
+        mergedScalars->SetValue(numMergedTris, scalars->GetValue(i));
+      }
+      ++numMergedTris;
+    }
+  }
+  if (mergedScalars)
+  {
+    mergedScalars->SetNumberOfValues(numMergedTris);
+  }
+  cellArray->SetNumberOfValues(4 * numMergedTris);
+  mergedPolys->SetCells(numMergedTris, cellArray);
+}
+} // end of anonymous namespace
+
 //------------------------------------------------------------------------------
 // Construct object with merging set to true.
 vtkSTLReader::vtkSTLReader()
@@ -117,8 +345,6 @@ int vtkSTLReader::RequestData(
   // Depending upon file type, read differently
   if (this->GetSTLFileType(this->FileName) == VTK_ASCII)
   {
-    newPts->Allocate(5000);
-    newPolys->Allocate(10000);
     if (this->ScalarTags)
     {
       newScalars = vtkFloatArray::New();
@@ -167,53 +393,61 @@ int vtkSTLReader::RequestData(
 
   fclose(fp);
 
-  // If merging is on, create hash table and merge points/triangles.
-  vtkPoints *mergedPts = newPts.Get();
-  vtkCellArray *mergedPolys = newPolys.Get();
+  // If merging is on, merge points/triangles.
+  vtkSmartPointer<vtkPoints> mergedPts = newPts.Get();
+  vtkSmartPointer<vtkCellArray> mergedPolys = newPolys.Get();
   vtkFloatArray *mergedScalars = newScalars;
   if (this->Merging)
   {
-    mergedPts = vtkPoints::New();
-    mergedPts->Allocate(newPts->GetNumberOfPoints() /2);
-    mergedPolys = vtkCellArray::New();
-    mergedPolys->Allocate(newPolys->GetSize());
+    mergedPts = vtkSmartPointer<vtkPoints>::New();
+    mergedPolys = vtkSmartPointer<vtkCellArray>::New();
     if (newScalars)
     {
       mergedScalars = vtkFloatArray::New();
-      mergedScalars->Allocate(newPolys->GetSize());
     }
 
-    vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
     if (this->Locator == nullptr)
     {
-      locator.TakeReference(this->NewDefaultLocator());
+      stlMergePoints(newPts, newPolys, newScalars,
+                     mergedPts, mergedPolys, mergedScalars);
     }
-    locator->InitPointInsertion(mergedPts, newPts->GetBounds());
-
-    int nextCell = 0;
-    vtkIdType *pts = nullptr;
-    vtkIdType npts;
-    for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
+    else
     {
-      vtkIdType nodes[3];
-      for (int i = 0; i < 3; i++)
+      mergedPts->Allocate(newPts->GetNumberOfPoints() /2);
+      mergedPolys->Allocate(newPolys->GetSize());
+      if (newScalars)
       {
-        double x[3];
-        newPts->GetPoint(pts[i], x);
-        locator->InsertUniquePoint(x, nodes[i]);
+        mergedScalars->Allocate(newPolys->GetSize());
       }
 
-      if (nodes[0] != nodes[1] &&
-        nodes[0] != nodes[2] &&
-        nodes[1] != nodes[2])
+      vtkIncrementalPointLocator *locator = this->Locator;
+      locator->InitPointInsertion(mergedPts, newPts->GetBounds());
+
+      int nextCell = 0;
+      vtkIdType *pts = nullptr;
+      vtkIdType npts;
+      for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
       {
-        mergedPolys->InsertNextCell(3, nodes);
-        if (newScalars)
+        vtkIdType nodes[3];
+        for (int i = 0; i < 3; i++)
+        {
+          double x[3];
+          newPts->GetPoint(pts[i], x);
+          locator->InsertUniquePoint(x, nodes[i]);
+        }
+
+        if (nodes[0] != nodes[1] &&
+          nodes[0] != nodes[2] &&
+          nodes[1] != nodes[2])
         {
-          mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          mergedPolys->InsertNextCell(3, nodes);
+          if (newScalars)
+          {
+            mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          }
         }
+        nextCell++;
       }
-      nextCell++;
     }
 
     if (newScalars)
@@ -227,10 +461,7 @@ int vtkSTLReader::RequestData(
   }
 
   output->SetPoints(mergedPts);
-  mergedPts->Delete();
-
   output->SetPolys(mergedPolys);
-  mergedPolys->Delete();
 
   if (mergedScalars)
   {
@@ -296,60 +527,31 @@ bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
       << numTris << ")");
   }
 
-  // Verify the numTris with the length of the file
+  // Read all facets in one go. The header count is not trusted, the file
+  // is read until its end instead.
   unsigned long ulFileLength = vtksys::SystemTools::FileLength(this->FileName);
-  ulFileLength -= (80 + 4); // 80 byte - header, 4 byte - tringle count
-  ulFileLength /= 50;       // 50 byte - twelve 32-bit-floating point numbers + 2 byte for attribute byte count
+  size_t facetBytes = ulFileLength > 84 ? ulFileLength - 84 : 0;
+  std::vector<unsigned char> facets(facetBytes);
+  facetBytes = facetBytes ? fread(facets.data(), 1, facetBytes, fp) : 0;
 
-  if (numTris < static_cast<int>(ulFileLength))
+  // 50 byte - twelve 32-bit-floating point numbers + 2 byte for attribute byte count
+  const size_t facetSize = 50;
+  if (facetBytes % facetSize >= 48)
   {
-    numTris = static_cast<int>(ulFileLength);
+    vtkErrorMacro("STLReader error reading file: " << this->FileName
+      << " Premature EOF while reading extra junk.");
+    return false;
   }
+  numTris = static_cast<int>(facetBytes / facetSize);
 
-  // now we can allocate the memory we need for this STL file
-  newPts->Allocate(numTris * 3);
-  newPolys->Allocate(numTris);
-
-  facet_t facet;
-  for (int i = 0; fread(&facet, 48, 1, fp) > 0; i++)
-  {
-    unsigned short ibuff2;
-    if (fread(&ibuff2, 2, 1, fp) != 1) //read extra junk
-    {
-      vtkErrorMacro("STLReader error reading file: " << this->FileName
-        << " Premature EOF while reading extra junk.");
-      return false;
-    }
-
-    vtkByteSwap::Swap4LE(facet.n);
-    vtkByteSwap::Swap4LE(facet.n+1);
-    vtkByteSwap::Swap4LE(facet.n+2);
-
-    vtkByteSwap::Swap4LE(facet.v1);
-    vtkByteSwap::Swap4LE(facet.v1+1);
-    vtkByteSwap::Swap4LE(facet.v1+2);
-
-    vtkByteSwap::Swap4LE(facet.v2);
-    vtkByteSwap::Swap4LE(facet.v2+1);
-    vtkByteSwap::Swap4LE(facet.v2+2);
-
-    vtkByteSwap::Swap4LE(facet.v3);
-    vtkByteSwap::Swap4LE(facet.v3+1);
-    vtkByteSwap::Swap4LE(facet.v3+2);
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(3 * static_cast<vtkIdType>(numTris));
 
-    vtkIdType pts[3];
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3, pts);
-
-    if ((i % 5000) == 0 && i != 0)
-    {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i) / numTris);
-    }
-  }
+  vtkSTLReaderCopyFacets copyFacets;
+  copyFacets.Facets = facets.data();
+  copyFacets.Points = static_cast<float*>(newPts->GetVoidPointer(0));
+  copyFacets.Cells = newPolys->WritePointer(numTris, 4 * static_cast<vtkIdType>(numTris));
+  vtkSMPTools::For(0, numTris, copyFacets);
 
   return true;
 }
@@ -394,6 +596,25 @@ bool stlReadVertex(char* buf, float vertCoord[3])
   return true;
 }
 
+// The arguments of a "vertex" line, and the line number for error reporting.
+struct stlVertexLine
+{
+  char *Arg;
+  int LineNum;
+};
+
+// Convert the coordinates of vertex lines.
+struct vtkSTLReaderParseVertices
+{
+  const stlVertexLine *Vertices;
+  float *Points;
+
+  bool operator()(vtkIdType i)
+  {
+    return stlReadVertex(this->Vertices[i].Arg, this->Points + 3 * i);
+  }
+};
+
 } // end of anonymous namespace
 
 
@@ -430,9 +651,24 @@ bool vtkSTLReader::ReadASCIISTL(FILE *fp, vtkPoints *newPts,
   this->SetBinaryHeader(nullptr);
   std::string header;
 
-  char line[256];         // line buffer
-  float vertCoord[3];     // scratch space when parsing "vertex %f %f %f"
-  vtkIdType pts[3];       // point ids for building triangles
+  // Read the rest of the file into memory. Lines are scanned in order, but
+  // the vertex coordinates, which make up most of the file, are converted
+  // in parallel once all lines have been scanned.
+  std::vector<char> buffer;
+  buffer.reserve(vtksys::SystemTools::FileLength(this->FileName) + 1);
+  {
+    char chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+    {
+      buffer.insert(buffer.end(), chunk, chunk + n);
+    }
+  }
+  buffer.push_back('\0');
+  char *next = buffer.data();
+  char *const bufferEnd = next + buffer.size() - 1;
+
+  std::vector<stlVertexLine> vertices;
   int vertOff = 0;
 
   int solidId = -1;
@@ -453,11 +689,22 @@ bool vtkSTLReader::ReadASCIISTL(FILE *fp, vtkPoints *newPts,
 
   for (StlAsciiScanState state = scanSolid; errorMessage.empty() == true; /*nil*/)
   {
-    char *cmd = fgets(line, 255, fp);
+    char *cmd = nullptr;
+    if (next < bufferEnd)
+    {
+      // Take the next line and terminate it in place.
+      cmd = next;
+      char *eol = static_cast<char*>(memchr(next, '\n', bufferEnd - next));
+      next = eol ? eol + 1 : bufferEnd;
+      if (eol)
+      {
+        *eol = '\0';
+      }
+    }
 
     if (!cmd)
     {
-      // fgets() failed (eg EOF).
+      // No more lines (EOF).
       // If scanning for the next "solid" this is a valid way to exit,
       // but is an error if scanning for the initial "solid" or any other token
 
@@ -584,34 +831,22 @@ bool vtkSTLReader::ReadASCIISTL(FILE *fp, vtkPoints *newPts,
       {
         if (!strcmp(cmd, "vertex"))
         {
-          if (stlReadVertex(arg, vertCoord))
+          // Keep the arguments, they are converted below
+          stlVertexLine vertex = { arg, lineNum };
+          vertices.push_back(vertex);
+          ++vertOff;  // Next vertex
+
+          if (vertOff >= 3)
           {
-            pts[vertOff] = newPts->InsertNextPoint(vertCoord);
-            ++vertOff;  // Next vertex
+            // Finished this triangle.
+            vertOff = 0;
+            state = scanEndLoop;  // Next state
 
-            if (vertOff >= 3)
+            if (scalars)
             {
-              // Finished this triangle.
-              vertOff = 0;
-              state = scanEndLoop;  // Next state
-
-              // Save as cell
-              newPolys->InsertNextCell(3, pts);
-              if (scalars)
-              {
-                scalars->InsertNextValue(solidId);
-              }
-
-              if ((newPolys->GetNumberOfCells() % 5000) == 0)
-              {
-                this->UpdateProgress((newPolys->GetNumberOfCells()%50000) / 50000.0);
-              }
+              scalars->InsertNextValue(solidId);
             }
           }
-          else
-          {
-            errorMessage = "Parse error reading STL vertex";
-          }
         }
         else
         {
@@ -660,6 +895,28 @@ bool vtkSTLReader::ReadASCIISTL(FILE *fp, vtkPoints *newPts,
 
   this->SetHeader(header.c_str());
 
+  // Convert the vertex coordinates. A bad vertex is reported rather than
+  // any error found on a later line, since it would have stopped a line by
+  // line parse.
+  const vtkIdType numVerts = static_cast<vtkIdType>(vertices.size());
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(numVerts);
+  vtkSTLReaderParseVertices parseVertices;
+  parseVertices.Vertices = vertices.data();
+  parseVertices.Points = static_cast<float*>(newPts->GetVoidPointer(0));
+  vtkIdType failure =
+    vtkFirstParseFailure<vtkSTLReaderParseVertices>::Find(parseVertices,
+                                                          numVerts);
+  if (failure < numVerts)
+  {
+    errorMessage = "Parse error reading STL vertex";
+    lineNum = vertices[failure].LineNum;
+  }
+
+  // Save the triangles as cells
+  const vtkIdType numTris = numVerts / 3;
+  stlFillTriangles(newPolys->WritePointer(numTris, 4 * numTris), 0, numTris);
+
   if (!errorMessage.empty())
   {
     vtkErrorMacro("STLReader: error while reading file "
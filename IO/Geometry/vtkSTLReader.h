@@ -23,9 +23,10 @@
  *
  * .stl files are quite inefficient since they duplicate vertex
  * definitions. By setting the Merging boolean you can control whether the
- * point data is merged after reading. Merging is performed by default,
- * however, merging requires a large amount of temporary storage since a
- * 3D hash table must be constructed.
+ * point data is merged after reading. Merging is performed by default.
+ * Unless a Locator is specified, coincident points are found by sorting
+ * the points in parallel, which needs a few ids of temporary storage per
+ * point; a user specified locator is used serially instead.
  *
  * @warning
  * Binary files written on one system may not be readable on other systems.
@@ -62,7 +63,9 @@ public:
 
   //@{
   /**
-   * Turn on/off merging of points/triangles.
+   * Turn on/off merging of points/triangles. With merging off every
+   * triangle keeps its own three points and no merging pass is made, which
+   * is the fastest way to read a file that is only going to be rendered.
    */
   vtkSetMacro(Merging,vtkTypeBool);
   vtkGetMacro(Merging,vtkTypeBool);
@@ -80,8 +83,9 @@ public:
 
   //@{
   /**
-   * Specify a spatial locator for merging points. By
-   * default an instance of vtkMergePoints is used.
+   * Specify a spatial locator for merging points. By default no locator
+   * is used and points are merged by sorting them, which gives the same
+   * result as an instance of vtkMergePoints.
    */
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
@@ -111,7 +115,7 @@ protected:
   ~vtkSTLReader() override;
 
   /**
-   * Create default locator. Used to create one when none is specified.
+   * Create default locator, an instance of vtkMergePoints.
    */
   vtkIncrementalPointLocator* NewDefaultLocator();
 
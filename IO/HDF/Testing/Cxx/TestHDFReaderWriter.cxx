@@ -0,0 +1,572 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHDFReaderWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write images, polydata, unstructured grids and multiblock datasets with
+// vtkHDFWriter and check that vtkHDFReader reads back the requested pieces,
+// extents, time steps and arrays.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArraySelection.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtk_hdf5.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace
+{
+const int NumberOfSegments = 10;
+
+// Produces NumberOfSegments segments, each made of a vertex, a line and a
+// triangle with their own points, split among the requested pieces. The
+// values of the arrays depend on the time step containing the requested time.
+class vtkSegmentSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkSegmentSource* New();
+  vtkTypeMacro(vtkSegmentSource, vtkPolyDataAlgorithm);
+
+protected:
+  vtkSegmentSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double times[3] = { 0, 1, 2 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), times, 3);
+    double range[2] = { 0, 2 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    int numberOfPieces = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    double time = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      : 0.0;
+    time = std::max(0.0, std::min(std::floor(time), 2.0));
+    int first = piece * NumberOfSegments / numberOfPieces;
+    int last = (piece + 1) * NumberOfSegments / numberOfPieces;
+
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    vtkNew<vtkCellArray> lines;
+    vtkNew<vtkCellArray> polys;
+    vtkNew<vtkFloatArray> pointValues;
+    pointValues->SetName("pointValues");
+    vtkNew<vtkIntArray> cellValues;
+    cellValues->SetName("cellValues");
+    cellValues->SetNumberOfComponents(2);
+    for (int segment = first; segment < last; ++segment)
+    {
+      vtkIdType ids[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        ids[i] = points->InsertNextPoint(segment, i, time);
+        pointValues->InsertNextValue(100 * time + 3 * segment + i);
+      }
+      verts->InsertNextCell(1, ids);
+      lines->InsertNextCell(2, ids);
+      polys->InsertNextCell(3, ids);
+    }
+    // The cell data is ordered by cell kind, like the cells of polydata.
+    for (int kind = 0; kind < 3; ++kind)
+    {
+      for (int segment = first; segment < last; ++segment)
+      {
+        int value[2] = { kind, segment + 10 * static_cast<int>(time) };
+        cellValues->InsertNextTypedTuple(value);
+      }
+    }
+    output->SetPoints(points);
+    output->SetVerts(verts);
+    output->SetLines(lines);
+    output->SetPolys(polys);
+    output->GetPointData()->SetScalars(pointValues);
+    output->GetCellData()->AddArray(cellValues);
+    return 1;
+  }
+
+private:
+  vtkSegmentSource(const vtkSegmentSource&) = delete;
+  void operator=(const vtkSegmentSource&) = delete;
+};
+vtkStandardNewMacro(vtkSegmentSource);
+
+//----------------------------------------------------------------------------
+bool CompareArrays(vtkFieldData* expected, vtkFieldData* actual)
+{
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+  {
+    vtkDataArray* expectedArray = expected->GetArray(a);
+    vtkDataArray* actualArray = actual->GetArray(expectedArray->GetName());
+    if (!actualArray || actualArray->GetDataType() != expectedArray->GetDataType() ||
+      actualArray->GetNumberOfComponents() != expectedArray->GetNumberOfComponents() ||
+      actualArray->GetNumberOfTuples() != expectedArray->GetNumberOfTuples())
+    {
+      cerr << "Array " << expectedArray->GetName() << " differs" << endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < expectedArray->GetNumberOfValues(); ++i)
+    {
+      if (actualArray->GetComponent(i / expectedArray->GetNumberOfComponents(),
+            i % expectedArray->GetNumberOfComponents()) !=
+        expectedArray->GetComponent(i / expectedArray->GetNumberOfComponents(),
+          i % expectedArray->GetNumberOfComponents()))
+      {
+        cerr << "Value " << i << " of array " << expectedArray->GetName() << " differs" << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool CompareDataSets(vtkDataSet* expected, vtkDataObject* actualObject)
+{
+  vtkDataSet* actual = vtkDataSet::SafeDownCast(actualObject);
+  if (!actual || !actual->IsA(expected->GetClassName()) ||
+    actual->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    actual->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    cerr << "Expected a " << expected->GetClassName() << " with "
+         << expected->GetNumberOfPoints() << " points and " << expected->GetNumberOfCells()
+         << " cells" << endl;
+    return false;
+  }
+  vtkNew<vtkIdList> expectedIds;
+  vtkNew<vtkIdList> actualIds;
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+  {
+    double p[3];
+    double q[3];
+    expected->GetPoint(i, p);
+    actual->GetPoint(i, q);
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+    {
+      cerr << "Point " << i << " differs" << endl;
+      return false;
+    }
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfCells(); ++i)
+  {
+    expected->GetCellPoints(i, expectedIds);
+    actual->GetCellPoints(i, actualIds);
+    bool same = expected->GetCellType(i) == actual->GetCellType(i) &&
+      expectedIds->GetNumberOfIds() == actualIds->GetNumberOfIds();
+    for (vtkIdType j = 0; same && j < expectedIds->GetNumberOfIds(); ++j)
+    {
+      same = expectedIds->GetId(j) == actualIds->GetId(j);
+    }
+    if (!same)
+    {
+      cerr << "Cell " << i << " differs" << endl;
+      return false;
+    }
+  }
+  return CompareArrays(expected->GetPointData(), actual->GetPointData()) &&
+    CompareArrays(expected->GetCellData(), actual->GetCellData()) &&
+    CompareArrays(expected->GetFieldData(), actual->GetFieldData());
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> MakeImage()
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, 9, -2, 5, 0, 4);
+  image->SetOrigin(1, 2, 3);
+  image->SetSpacing(0.5, 1, 2);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfValues(image->GetNumberOfPoints());
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    scalars->SetValue(i, i);
+    vectors->SetTuple3(i, i, -i, 0.5 * i);
+  }
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("cellIds");
+  cellIds->SetNumberOfValues(image->GetNumberOfCells());
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+  {
+    cellIds->SetValue(i, static_cast<int>(i));
+  }
+  vtkNew<vtkDoubleArray> fieldValues;
+  fieldValues->SetName("fieldValues");
+  fieldValues->InsertNextValue(42);
+  image->GetPointData()->SetScalars(scalars);
+  image->GetPointData()->SetVectors(vectors);
+  image->GetCellData()->AddArray(cellIds);
+  image->GetFieldData()->AddArray(fieldValues);
+  return image;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->Allocate(3);
+  vtkIdType hexahedron[8] = { 0, 1, 4, 3, 6, 7, 10, 9 };
+  grid->InsertNextCell(VTK_HEXAHEDRON, 8, hexahedron);
+  vtkIdType tetra[4] = { 1, 2, 5, 8 };
+  grid->InsertNextCell(VTK_TETRA, 4, tetra);
+  vtkIdType pyramid[5] = { 1, 4, 10, 7, 2 };
+  vtkIdType faces[] = { 4, 1, 4, 10, 7, 3, 1, 4, 2, 3, 4, 10, 2, 3, 10, 7, 2, 3, 7, 1, 2 };
+  grid->InsertNextCell(VTK_POLYHEDRON, 5, pyramid, 5, faces);
+
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("pointValues");
+  vtkNew<vtkIntArray> cellValues;
+  cellValues->SetName("cellValues");
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+  {
+    pointValues->InsertNextValue(0.25 * i);
+  }
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    cellValues->InsertNextValue(static_cast<int>(7 * i));
+  }
+  grid->GetPointData()->AddArray(pointValues);
+  grid->GetCellData()->SetScalars(cellValues);
+  return grid;
+}
+
+//----------------------------------------------------------------------------
+bool TestImage(const std::string& fileName)
+{
+  vtkSmartPointer<vtkImageData> image = MakeImage();
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetNumberOfPieces(3);
+  writer->SetChunkSize(64);
+  writer->SetCompressionLevel(4);
+  writer->SetArrayCompressionLevel("vectors", 0);
+  if (!writer->Write())
+  {
+    cerr << "Could not write " << fileName << endl;
+    return false;
+  }
+
+  vtkNew<vtkHDFReader> reader;
+  if (!reader->CanReadFile(fileName.c_str()))
+  {
+    cerr << "Cannot read " << fileName << endl;
+    return false;
+  }
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkImageData* output = vtkImageData::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!CompareDataSets(image, output) || output->GetOrigin()[1] != 2 ||
+    output->GetSpacing()[2] != 2 || output->GetPointData()->GetVectors() == nullptr ||
+    reader->GetNumberOfPointArrays() != 2 || reader->GetNumberOfCellArrays() != 1)
+  {
+    cerr << "Wrong image read from " << fileName << endl;
+    return false;
+  }
+
+  // Read a sub-extent crossing the pieces, without the vectors.
+  int extent[6] = { 2, 7, -1, 4, 1, 3 };
+  reader->SetPointArrayStatus("vectors", 0);
+  reader->UpdateExtent(extent);
+  output = vtkImageData::SafeDownCast(reader->GetOutputDataObject(0));
+  int* outputExtent = output->GetExtent();
+  for (int i = 0; i < 6; ++i)
+  {
+    if (outputExtent[i] != extent[i])
+    {
+      cerr << "Wrong extent read from " << fileName << endl;
+      return false;
+    }
+  }
+  if (output->GetPointData()->GetArray("vectors") != nullptr)
+  {
+    cerr << "A disabled array was read" << endl;
+    return false;
+  }
+  vtkDataArray* scalars = output->GetPointData()->GetScalars();
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("cellIds");
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        int ijk[3] = { i, j, k };
+        vtkIdType outputId = output->ComputePointId(ijk);
+        if (scalars->GetTuple1(outputId) != image->ComputePointId(ijk))
+        {
+          cerr << "Wrong point value at " << i << " " << j << " " << k << endl;
+          return false;
+        }
+        if (i < extent[1] && j < extent[3] && k < extent[5] &&
+          cellIds->GetTuple1(output->ComputeCellId(ijk)) != image->ComputeCellId(ijk))
+        {
+          cerr << "Wrong cell value at " << i << " " << j << " " << k << endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestPolyData(const std::string& fileName)
+{
+  vtkNew<vtkSegmentSource> source;
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->SetNumberOfPieces(4);
+  writer->WriteAllTimeStepsOn();
+  writer->SetCompressionLevel(1);
+  if (!writer->Write())
+  {
+    cerr << "Could not write " << fileName << endl;
+    return false;
+  }
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  vtkInformation* outInfo = reader->GetOutputInformation(0);
+  if (outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()) != 3)
+  {
+    cerr << "Wrong time steps in " << fileName << endl;
+    return false;
+  }
+
+  // The whole dataset, then pieces made of several pieces of the file.
+  int pieces[3][2] = { { 0, 1 }, { 1, 2 }, { 3, 4 } };
+  double times[3] = { 1.5, 0, 2 };
+  for (int i = 0; i < 3; ++i)
+  {
+    source->UpdateTimeStep(times[i], pieces[i][0], pieces[i][1]);
+    reader->UpdateTimeStep(times[i], pieces[i][0], pieces[i][1]);
+    vtkDataObject* output = reader->GetOutputDataObject(0);
+    if (!CompareDataSets(vtkPolyData::SafeDownCast(source->GetOutputDataObject(0)), output) ||
+      output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) !=
+        static_cast<int>(times[i]))
+    {
+      cerr << "Wrong piece " << pieces[i][0] << " of " << pieces[i][1] << " at time " << times[i]
+           << " read from " << fileName << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestUnstructuredGrid(const std::string& fileName)
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(grid);
+  writer->SetFileName(fileName.c_str());
+  writer->SetChunkSize(0);
+  if (!writer->Write())
+  {
+    cerr << "Could not write " << fileName << endl;
+    return false;
+  }
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!CompareDataSets(grid, output) || !output->GetCellData()->GetScalars())
+  {
+    cerr << "Wrong grid read from " << fileName << endl;
+    return false;
+  }
+  vtkNew<vtkIdList> expectedFaces;
+  vtkNew<vtkIdList> actualFaces;
+  grid->GetFaceStream(2, expectedFaces);
+  output->GetFaceStream(2, actualFaces);
+  bool same = expectedFaces->GetNumberOfIds() == actualFaces->GetNumberOfIds();
+  for (vtkIdType i = 0; same && i < expectedFaces->GetNumberOfIds(); ++i)
+  {
+    same = expectedFaces->GetId(i) == actualFaces->GetId(i);
+  }
+  if (!same)
+  {
+    cerr << "Wrong polyhedron faces read from " << fileName << endl;
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Overwrite the cell offsets of a grid file, which must then be rejected
+// rather than used to index the connectivity.
+bool TestInvalidOffsets(const std::string& fileName)
+{
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(MakeGrid());
+  writer->SetFileName(fileName.c_str());
+  if (!writer->Write())
+  {
+    cerr << "Could not write " << fileName << endl;
+    return false;
+  }
+
+  // the offsets of the grid are { 0, 8, 12, 17 }
+  const long long invalidOffsets[][4] = { { 0, 12, 8, 17 }, { 5, 8, 12, 17 }, { 0, 8, 12, 40 } };
+  for (const auto& offsets : invalidOffsets)
+  {
+    hid_t file = H5Fopen(fileName.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+    hid_t dataset = H5Dopen2(file, "VTKHDF/Step0/Piece0/Offsets", H5P_DEFAULT);
+    herr_t status =
+      H5Dwrite(dataset, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, offsets);
+    H5Dclose(dataset);
+    H5Fclose(file);
+    if (status < 0)
+    {
+      cerr << "Could not overwrite the offsets of " << fileName << endl;
+      return false;
+    }
+
+    vtkNew<vtkTest::ErrorObserver> errorObserver;
+    vtkNew<vtkHDFReader> reader;
+    reader->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    if (!errorObserver->GetError())
+    {
+      cerr << "Offsets " << offsets[0] << ", " << offsets[1] << ", " << offsets[2] << ", "
+           << offsets[3] << " were not rejected" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestMultiBlock(const std::string& fileName)
+{
+  vtkSmartPointer<vtkImageData> image = MakeImage();
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  vtkNew<vtkMultiBlockDataSet> inner;
+  inner->SetNumberOfBlocks(2);
+  inner->SetBlock(0, grid);
+  inner->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "grid");
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetNumberOfBlocks(2);
+  blocks->SetBlock(0, image);
+  blocks->SetBlock(1, inner);
+  blocks->GetMetaData(1u)->Set(vtkCompositeDataSet::NAME(), "inner");
+
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(blocks);
+  writer->SetFileName(fileName.c_str());
+  writer->SetCompressionLevel(6);
+  if (!writer->Write())
+  {
+    cerr << "Could not write " << fileName << endl;
+    return false;
+  }
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkMultiBlockDataSet* output =
+    vtkMultiBlockDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+  vtkMultiBlockDataSet* outputInner =
+    output ? vtkMultiBlockDataSet::SafeDownCast(output->GetBlock(1)) : nullptr;
+  if (!outputInner || output->GetNumberOfBlocks() != 2 || outputInner->GetNumberOfBlocks() != 2 ||
+    outputInner->GetBlock(1) != nullptr ||
+    std::string(output->GetMetaData(1u)->Get(vtkCompositeDataSet::NAME())) != "inner" ||
+    std::string(outputInner->GetMetaData(0u)->Get(vtkCompositeDataSet::NAME())) != "grid" ||
+    !CompareDataSets(image, output->GetBlock(0)) ||
+    !CompareDataSets(grid, outputInner->GetBlock(0)))
+  {
+    cerr << "Wrong blocks read from " << fileName << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestHDFReaderWriter(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string dir = tempDir;
+  delete[] tempDir;
+
+  vtkNew<vtkHDFReader> reader;
+  if (reader->CanReadFile((dir + "/HDFReaderWriter_missing.hdf").c_str()))
+  {
+    cerr << "A missing file can be read" << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!TestImage(dir + "/HDFReaderWriter_image.hdf") ||
+    !TestPolyData(dir + "/HDFReaderWriter_polydata.hdf") ||
+    !TestUnstructuredGrid(dir + "/HDFReaderWriter_grid.hdf") ||
+    !TestInvalidOffsets(dir + "/HDFReaderWriter_offsets.hdf") ||
+    !TestMultiBlock(dir + "/HDFReaderWriter_blocks.hdf"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
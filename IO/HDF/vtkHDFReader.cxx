@@ -0,0 +1,1303 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkHDFReader.h"
+
+#include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataArraySelection.h"
+#include "vtkHDFUtilities.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using vtkHDFUtilities::Handle;
+
+namespace
+{
+// Rows of a dataset in the file copied to rows of an output array.
+struct vtkHDFRows
+{
+  hsize_t FileStart;
+  hsize_t Count;
+  hsize_t OutputStart;
+};
+
+// An array found in the file.
+struct vtkHDFArrayInfo
+{
+  std::string Name;
+  int Type;
+  int NumberOfComponents;
+};
+
+// Groups opened for one read, closed when it is done.
+struct vtkHDFGroups
+{
+  std::vector<hid_t> Ids;
+
+  vtkHDFGroups() = default;
+  vtkHDFGroups(const vtkHDFGroups&) = delete;
+  void operator=(const vtkHDFGroups&) = delete;
+  ~vtkHDFGroups()
+  {
+    for (size_t i = 0; i < this->Ids.size(); ++i)
+    {
+      H5Gclose(this->Ids[i]);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+std::vector<hsize_t> GetDimensions(hid_t dataset)
+{
+  Handle space(H5Dget_space(dataset), H5Sclose);
+  int rank = H5Sget_simple_extent_ndims(space);
+  std::vector<hsize_t> dims(std::max(rank, 0));
+  if (rank > 0)
+  {
+    H5Sget_simple_extent_dims(space, dims.data(), nullptr);
+  }
+  return dims;
+}
+
+//----------------------------------------------------------------------------
+hsize_t GetNumberOfRows(hid_t group, const char* name)
+{
+  if (!vtkHDFUtilities::Exists(group, name))
+  {
+    return 0;
+  }
+  Handle dataset(H5Dopen2(group, name, H5P_DEFAULT), H5Dclose);
+  std::vector<hsize_t> dims = GetDimensions(dataset);
+  return dims.empty() ? 0 : dims[0];
+}
+
+//----------------------------------------------------------------------------
+int GetVTKType(hid_t dataset)
+{
+  int type = VTK_DOUBLE;
+  if (!vtkHDFUtilities::ReadAttribute(dataset, "VTKType", &type, 1) ||
+    vtkHDFUtilities::GetNativeType(type) < 0)
+  {
+    type = VTK_DOUBLE;
+  }
+  return type;
+}
+
+//----------------------------------------------------------------------------
+bool ReadIds(hid_t group, const char* name, std::vector<vtkIdType>& ids)
+{
+  ids.clear();
+  if (!vtkHDFUtilities::Exists(group, name))
+  {
+    return false;
+  }
+  Handle dataset(H5Dopen2(group, name, H5P_DEFAULT), H5Dclose);
+  std::vector<hsize_t> dims = GetDimensions(dataset);
+  if (dims.size() != 1)
+  {
+    return false;
+  }
+  ids.resize(dims[0]);
+  return dims[0] == 0 ||
+    H5Dread(dataset, vtkHDFUtilities::GetNativeType(VTK_ID_TYPE), H5S_ALL, H5S_ALL, H5P_DEFAULT,
+      ids.data()) >= 0;
+}
+
+//----------------------------------------------------------------------------
+// Copy rows of a [rows] or [rows, components] dataset into an array.
+bool ReadRows(hid_t dataset, vtkDataArray* array, const vtkHDFRows& rows)
+{
+  if (rows.Count == 0)
+  {
+    return true;
+  }
+  std::vector<hsize_t> dims = GetDimensions(dataset);
+  hsize_t components = dims.size() > 1 ? dims[1] : 1;
+  if (dims.empty() || dims.size() > 2 ||
+    components != static_cast<hsize_t>(array->GetNumberOfComponents()) ||
+    rows.FileStart + rows.Count > dims[0])
+  {
+    return false;
+  }
+  int rank = static_cast<int>(dims.size());
+  hsize_t fileStart[2] = { rows.FileStart, 0 };
+  hsize_t count[2] = { rows.Count, components };
+  Handle fileSpace(H5Dget_space(dataset), H5Sclose);
+  H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, fileStart, nullptr, count, nullptr);
+
+  hsize_t memoryDims[2] = { static_cast<hsize_t>(array->GetNumberOfTuples()), components };
+  hsize_t memoryStart[2] = { rows.OutputStart, 0 };
+  Handle memorySpace(H5Screate_simple(rank, memoryDims, nullptr), H5Sclose);
+  H5Sselect_hyperslab(memorySpace, H5S_SELECT_SET, memoryStart, nullptr, count, nullptr);
+  return H5Dread(dataset, vtkHDFUtilities::GetNativeType(array->GetDataType()), memorySpace,
+           fileSpace, H5P_DEFAULT, array->GetVoidPointer(0)) >= 0;
+}
+
+//----------------------------------------------------------------------------
+// Copy the box of a [z, y, x] or [z, y, x, components] dataset covering
+// fileExtent into an array covering outputExtent.
+bool ReadBox(hid_t dataset, vtkDataArray* array, const int fileExtent[6],
+  const int outputExtent[6], const int box[6])
+{
+  std::vector<hsize_t> dims = GetDimensions(dataset);
+  hsize_t components = dims.size() > 3 ? dims[3] : 1;
+  if (dims.size() < 3 || dims.size() > 4 ||
+    components != static_cast<hsize_t>(array->GetNumberOfComponents()))
+  {
+    return false;
+  }
+  int rank = static_cast<int>(dims.size());
+  hsize_t fileStart[4] = { 0, 0, 0, 0 };
+  hsize_t memoryStart[4] = { 0, 0, 0, 0 };
+  hsize_t memoryDims[4] = { 1, 1, 1, components };
+  hsize_t count[4] = { 1, 1, 1, components };
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    int i = 2 - axis;
+    fileStart[i] = static_cast<hsize_t>(box[2 * axis] - fileExtent[2 * axis]);
+    memoryStart[i] = static_cast<hsize_t>(box[2 * axis] - outputExtent[2 * axis]);
+    memoryDims[i] = static_cast<hsize_t>(outputExtent[2 * axis + 1] - outputExtent[2 * axis] + 1);
+    count[i] = static_cast<hsize_t>(box[2 * axis + 1] - box[2 * axis] + 1);
+    if (fileStart[i] + count[i] > dims[i])
+    {
+      return false;
+    }
+  }
+  Handle fileSpace(H5Dget_space(dataset), H5Sclose);
+  H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, fileStart, nullptr, count, nullptr);
+  Handle memorySpace(H5Screate_simple(rank, memoryDims, nullptr), H5Sclose);
+  H5Sselect_hyperslab(memorySpace, H5S_SELECT_SET, memoryStart, nullptr, count, nullptr);
+  return H5Dread(dataset, vtkHDFUtilities::GetNativeType(array->GetDataType()), memorySpace,
+           fileSpace, H5P_DEFAULT, array->GetVoidPointer(0)) >= 0;
+}
+
+//----------------------------------------------------------------------------
+bool Intersect(const int a[6], const int b[6], int result[6])
+{
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    result[2 * axis] = std::max(a[2 * axis], b[2 * axis]);
+    result[2 * axis + 1] = std::min(a[2 * axis + 1], b[2 * axis + 1]);
+    if (result[2 * axis] > result[2 * axis + 1])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Check that cell offsets start at zero, never decrease and stay within the
+// connectivity, so that they can be used to index it.
+bool ValidOffsets(const std::vector<vtkIdType>& offsets, size_t connectivitySize)
+{
+  if (offsets.empty() || offsets[0] != 0 ||
+    offsets.back() > static_cast<vtkIdType>(connectivitySize))
+  {
+    return false;
+  }
+  for (size_t i = 1; i < offsets.size(); ++i)
+  {
+    if (offsets[i] < offsets[i - 1])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Append cells read as offsets and connectivity to a legacy cell array
+// ([n, ids...] per cell), shifting the point ids. The offsets must be valid.
+vtkIdType AppendCells(const std::vector<vtkIdType>& offsets,
+  const std::vector<vtkIdType>& connectivity, vtkIdType pointOffset, vtkIdType* legacy)
+{
+  vtkIdType position = 0;
+  for (size_t cell = 0; cell + 1 < offsets.size(); ++cell)
+  {
+    vtkIdType npts = offsets[cell + 1] - offsets[cell];
+    legacy[position++] = npts;
+    for (vtkIdType i = offsets[cell]; i < offsets[cell + 1]; ++i)
+    {
+      legacy[position++] = connectivity[i] + pointOffset;
+    }
+  }
+  return position;
+}
+}
+
+//----------------------------------------------------------------------------
+class vtkHDFReader::vtkInternals
+{
+public:
+  vtkHDFReader* Reader;
+  hid_t File;
+  std::string Type;
+  int NumberOfPieces;
+  int WholeExtent[6];
+  std::vector<double> TimeValues;
+
+  vtkInternals(vtkHDFReader* reader)
+    : Reader(reader)
+    , File(-1)
+    , NumberOfPieces(1)
+  {
+    std::fill(this->WholeExtent, this->WholeExtent + 6, 0);
+  }
+
+  ~vtkInternals() { this->Close(); }
+
+  //--------------------------------------------------------------------------
+  // Open the file and read the attributes of the root group.
+  bool Open(const char* fileName)
+  {
+    this->Close();
+    if (!fileName)
+    {
+      return false;
+    }
+    H5E_BEGIN_TRY
+    {
+      if (H5Fis_hdf5(fileName) > 0)
+      {
+        this->File = H5Fopen(fileName, H5F_ACC_RDONLY, H5P_DEFAULT);
+      }
+    }
+    H5E_END_TRY;
+    if (this->File < 0 || !vtkHDFUtilities::Exists(this->File, vtkHDFUtilities::RootName))
+    {
+      this->Close();
+      return false;
+    }
+
+    Handle root(H5Gopen2(this->File, vtkHDFUtilities::RootName, H5P_DEFAULT), H5Gclose);
+    int version[2] = { 0, 0 };
+    if (!vtkHDFUtilities::ReadAttribute(root, "Version", version, 2) ||
+      version[0] != vtkHDFUtilities::Version[0] ||
+      !vtkHDFUtilities::ReadAttribute(root, "Type", this->Type))
+    {
+      this->Close();
+      return false;
+    }
+    this->NumberOfPieces = 1;
+    vtkHDFUtilities::ReadAttribute(root, "NumberOfPieces", &this->NumberOfPieces, 1);
+    this->NumberOfPieces = std::max(this->NumberOfPieces, 1);
+    vtkHDFUtilities::ReadAttribute(root, "WholeExtent", this->WholeExtent, 6);
+
+    this->TimeValues.clear();
+    std::vector<hsize_t> dims;
+    if (vtkHDFUtilities::Exists(root, "TimeValues"))
+    {
+      Handle times(H5Dopen2(root, "TimeValues", H5P_DEFAULT), H5Dclose);
+      dims = GetDimensions(times);
+      if (dims.size() == 1 && dims[0] > 0)
+      {
+        this->TimeValues.resize(dims[0]);
+        H5Dread(times, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, this->TimeValues.data());
+      }
+    }
+    if (this->TimeValues.empty())
+    {
+      this->TimeValues.push_back(0.0);
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  void Close()
+  {
+    if (this->File >= 0)
+    {
+      H5Fclose(this->File);
+      this->File = -1;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  hid_t OpenStep(int step)
+  {
+    std::ostringstream name;
+    name << "/" << vtkHDFUtilities::RootName << "/Step" << step;
+    if (!vtkHDFUtilities::Exists(this->File, name.str().c_str()))
+    {
+      return -1;
+    }
+    return H5Gopen2(this->File, name.str().c_str(), H5P_DEFAULT);
+  }
+
+  //--------------------------------------------------------------------------
+  // Open the Piece<p> groups of a step.
+  bool OpenPieces(hid_t step, int first, int last, vtkHDFGroups& pieces)
+  {
+    for (int p = first; p < last; ++p)
+    {
+      std::ostringstream name;
+      name << "Piece" << p;
+      if (!vtkHDFUtilities::Exists(step, name.str().c_str()))
+      {
+        return false;
+      }
+      pieces.Ids.push_back(H5Gopen2(step, name.str().c_str(), H5P_DEFAULT));
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  // The arrays of the attributes group that are present in every dataset
+  // group and enabled in the selection.
+  std::vector<vtkHDFArrayInfo> GetArrays(const std::vector<hid_t>& groups,
+    const char* attributesName, vtkDataArraySelection* selection)
+  {
+    std::vector<vtkHDFArrayInfo> arrays;
+    if (groups.empty() || !vtkHDFUtilities::Exists(groups[0], attributesName))
+    {
+      return arrays;
+    }
+    Handle first(H5Gopen2(groups[0], attributesName, H5P_DEFAULT), H5Gclose);
+    std::vector<std::string> names = vtkHDFUtilities::GetLinkNames(first);
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+      if (selection && !selection->ArrayIsEnabled(names[i].c_str()))
+      {
+        continue;
+      }
+      Handle dataset(H5Dopen2(first, names[i].c_str(), H5P_DEFAULT), H5Dclose);
+      std::vector<hsize_t> dims = GetDimensions(dataset);
+      vtkHDFArrayInfo info;
+      info.Name = names[i];
+      info.Type = GetVTKType(dataset);
+      // Image arrays have three dimensions before the components.
+      size_t tupleRank = dims.size() > 2 ? 3 : 1;
+      info.NumberOfComponents = dims.size() > tupleRank ? static_cast<int>(dims[tupleRank]) : 1;
+
+      bool everywhere = true;
+      for (size_t g = 1; g < groups.size() && everywhere; ++g)
+      {
+        std::string path = std::string(attributesName) + "/" + names[i];
+        everywhere = vtkHDFUtilities::Exists(groups[g], attributesName) &&
+          vtkHDFUtilities::Exists(groups[g], path.c_str());
+      }
+      if (everywhere)
+      {
+        arrays.push_back(info);
+      }
+      else
+      {
+        vtkWarningWithObjectMacro(
+          this->Reader, "Skipping array " << names[i] << " that is missing from some pieces.");
+      }
+    }
+    return arrays;
+  }
+
+  //--------------------------------------------------------------------------
+  static vtkSmartPointer<vtkDataArray> NewArray(const vtkHDFArrayInfo& info, vtkIdType tuples)
+  {
+    vtkSmartPointer<vtkDataArray> array;
+    array.TakeReference(vtkDataArray::CreateDataArray(info.Type));
+    array->SetName(info.Name.c_str());
+    array->SetNumberOfComponents(info.NumberOfComponents);
+    array->SetNumberOfTuples(tuples);
+    return array;
+  }
+
+  //--------------------------------------------------------------------------
+  // Set the active attributes named by the attributes group.
+  static void ReadActiveAttributes(hid_t group, const char* attributesName,
+    vtkDataSetAttributes* attributes)
+  {
+    if (!vtkHDFUtilities::Exists(group, attributesName))
+    {
+      return;
+    }
+    Handle attributesGroup(H5Gopen2(group, attributesName, H5P_DEFAULT), H5Gclose);
+    const char* names[5] = { "Scalars", "Vectors", "Normals", "TCoords", "Tensors" };
+    int types[5] = { vtkDataSetAttributes::SCALARS, vtkDataSetAttributes::VECTORS,
+      vtkDataSetAttributes::NORMALS, vtkDataSetAttributes::TCOORDS,
+      vtkDataSetAttributes::TENSORS };
+    for (int i = 0; i < 5; ++i)
+    {
+      std::string name;
+      if (vtkHDFUtilities::ReadAttribute(attributesGroup, names[i], name) &&
+        attributes->GetArray(name.c_str()))
+      {
+        attributes->SetActiveAttribute(name.c_str(), types[i]);
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Read the selected arrays of an attributes group, copying the given rows
+  // of each dataset group.
+  bool ReadArrays(const std::vector<hid_t>& groups, const char* attributesName,
+    const std::vector<std::vector<vtkHDFRows> >& rows, vtkIdType numberOfTuples,
+    vtkDataArraySelection* selection, vtkFieldData* output)
+  {
+    std::vector<vtkHDFArrayInfo> arrays = this->GetArrays(groups, attributesName, selection);
+    for (size_t i = 0; i < arrays.size(); ++i)
+    {
+      vtkSmartPointer<vtkDataArray> array = NewArray(arrays[i], numberOfTuples);
+      std::string path = std::string(attributesName) + "/" + arrays[i].Name;
+      for (size_t g = 0; g < groups.size(); ++g)
+      {
+        Handle dataset(H5Dopen2(groups[g], path.c_str(), H5P_DEFAULT), H5Dclose);
+        for (size_t r = 0; r < rows[g].size(); ++r)
+        {
+          if (!ReadRows(dataset, array, rows[g][r]))
+          {
+            vtkErrorWithObjectMacro(this->Reader, "Could not read array " << arrays[i].Name);
+            return false;
+          }
+        }
+      }
+      output->AddArray(array);
+    }
+    vtkDataSetAttributes* attributes = vtkDataSetAttributes::SafeDownCast(output);
+    if (attributes && !groups.empty())
+    {
+      ReadActiveAttributes(groups[0], attributesName, attributes);
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  bool ReadFieldData(hid_t group, vtkFieldData* fieldData)
+  {
+    std::vector<hid_t> groups(1, group);
+    std::vector<vtkHDFArrayInfo> arrays = this->GetArrays(groups, "FieldData", nullptr);
+    for (size_t i = 0; i < arrays.size(); ++i)
+    {
+      std::string path = std::string("FieldData/") + arrays[i].Name;
+      Handle dataset(H5Dopen2(group, path.c_str(), H5P_DEFAULT), H5Dclose);
+      std::vector<hsize_t> dims = GetDimensions(dataset);
+      vtkSmartPointer<vtkDataArray> array = NewArray(arrays[i], dims.empty() ? 0 : dims[0]);
+      vtkHDFRows rows = { 0, dims.empty() ? 0 : dims[0], 0 };
+      if (!ReadRows(dataset, array, rows))
+      {
+        vtkErrorWithObjectMacro(this->Reader, "Could not read array " << arrays[i].Name);
+        return false;
+      }
+      fieldData->AddArray(array);
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  // Read the part of the image pieces inside the extent.
+  bool ReadImage(const std::vector<hid_t>& pieces, const int extent[6], vtkImageData* output)
+  {
+    output->Initialize();
+    output->SetExtent(const_cast<int*>(extent));
+
+    // Keep the pieces that overlap the extent.
+    std::vector<hid_t> groups;
+    std::vector<std::vector<int> > pieceExtents;
+    for (size_t p = 0; p < pieces.size(); ++p)
+    {
+      std::vector<int> pieceExtent(6);
+      int box[6];
+      if (vtkHDFUtilities::ReadAttribute(pieces[p], "Extent", pieceExtent.data(), 6) &&
+        Intersect(pieceExtent.data(), extent, box))
+      {
+        groups.push_back(pieces[p]);
+        pieceExtents.push_back(pieceExtent);
+      }
+    }
+    if (!pieces.empty())
+    {
+      double origin[3] = { 0, 0, 0 };
+      double spacing[3] = { 1, 1, 1 };
+      vtkHDFUtilities::ReadAttribute(pieces[0], "Origin", origin, 3);
+      vtkHDFUtilities::ReadAttribute(pieces[0], "Spacing", spacing, 3);
+      output->SetOrigin(origin);
+      output->SetSpacing(spacing);
+      if (!this->ReadFieldData(pieces[0], output->GetFieldData()))
+      {
+        return false;
+      }
+    }
+    if (groups.empty() || extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5])
+    {
+      return true;
+    }
+
+    int cellExtent[6];
+    vtkHDFUtilities::GetCellExtent(extent, cellExtent);
+    for (int attributes = 0; attributes < 2; ++attributes)
+    {
+      bool cells = attributes == 1;
+      const char* attributesName = cells ? "CellData" : "PointData";
+      vtkDataSetAttributes* outputAttributes =
+        cells ? static_cast<vtkDataSetAttributes*>(output->GetCellData())
+              : static_cast<vtkDataSetAttributes*>(output->GetPointData());
+      std::vector<vtkHDFArrayInfo> arrays = this->GetArrays(groups, attributesName,
+        cells ? this->Reader->CellDataArraySelection : this->Reader->PointDataArraySelection);
+      vtkIdType numberOfTuples = cells ? output->GetNumberOfCells() : output->GetNumberOfPoints();
+      const int* outputExtent = cells ? cellExtent : extent;
+
+      for (size_t i = 0; i < arrays.size(); ++i)
+      {
+        vtkSmartPointer<vtkDataArray> array = NewArray(arrays[i], numberOfTuples);
+        if (numberOfTuples > 0)
+        {
+          memset(array->GetVoidPointer(0), 0,
+            numberOfTuples * array->GetNumberOfComponents() * array->GetDataTypeSize());
+        }
+        std::string path = std::string(attributesName) + "/" + arrays[i].Name;
+        for (size_t g = 0; g < groups.size(); ++g)
+        {
+          int fileExtent[6];
+          int box[6];
+          if (cells)
+          {
+            vtkHDFUtilities::GetCellExtent(pieceExtents[g].data(), fileExtent);
+          }
+          else
+          {
+            std::copy(pieceExtents[g].begin(), pieceExtents[g].end(), fileExtent);
+          }
+          if (!Intersect(fileExtent, outputExtent, box))
+          {
+            continue;
+          }
+          Handle dataset(H5Dopen2(groups[g], path.c_str(), H5P_DEFAULT), H5Dclose);
+          if (!ReadBox(dataset, array, fileExtent, outputExtent, box))
+          {
+            vtkErrorWithObjectMacro(this->Reader, "Could not read array " << arrays[i].Name);
+            return false;
+          }
+        }
+        outputAttributes->AddArray(array);
+      }
+      ReadActiveAttributes(groups[0], attributesName, outputAttributes);
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  // Read cells stored as Offsets and Connectivity in each group, shifting
+  // the point ids of each group by the points of the groups before it.
+  bool ReadCells(const std::vector<hid_t>& groups, const char* cellsName,
+    const std::vector<vtkIdType>& pointOffsets, vtkCellArray* cells,
+    std::vector<vtkIdType>& numberOfCells)
+  {
+    numberOfCells.assign(groups.size(), 0);
+    vtkIdType size = 0;
+    vtkIdType total = 0;
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+      std::string path = std::string(cellsName) + "Offsets";
+      hsize_t offsets = GetNumberOfRows(groups[g], path.c_str());
+      path = std::string(cellsName) + "Connectivity";
+      numberOfCells[g] = offsets > 0 ? static_cast<vtkIdType>(offsets - 1) : 0;
+      total += numberOfCells[g];
+      size += numberOfCells[g] + static_cast<vtkIdType>(GetNumberOfRows(groups[g], path.c_str()));
+    }
+
+    vtkIdType* legacy = cells->WritePointer(total, size);
+    std::vector<vtkIdType> offsets;
+    std::vector<vtkIdType> connectivity;
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+      if (numberOfCells[g] == 0)
+      {
+        continue;
+      }
+      if (!ReadIds(groups[g], (std::string(cellsName) + "Offsets").c_str(), offsets) ||
+        !ReadIds(groups[g], (std::string(cellsName) + "Connectivity").c_str(), connectivity))
+      {
+        vtkErrorWithObjectMacro(this->Reader, "Could not read " << cellsName << "cells.");
+        return false;
+      }
+      if (static_cast<vtkIdType>(offsets.size()) != numberOfCells[g] + 1 ||
+        !ValidOffsets(offsets, connectivity.size()) ||
+        offsets.back() != static_cast<vtkIdType>(connectivity.size()))
+      {
+        vtkErrorWithObjectMacro(this->Reader, "Invalid " << cellsName << "Offsets.");
+        return false;
+      }
+      legacy += AppendCells(offsets, connectivity, pointOffsets[g], legacy);
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  // Read the points, cells and arrays of polydata or unstructured grid
+  // groups, appended in order.
+  bool ReadPointSet(const std::vector<hid_t>& groups, vtkPointSet* output)
+  {
+    output->Initialize();
+    if (groups.empty())
+    {
+      return true;
+    }
+
+    // Points
+    std::vector<vtkIdType> pointOffsets(groups.size() + 1, 0);
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+      pointOffsets[g + 1] =
+        pointOffsets[g] + static_cast<vtkIdType>(GetNumberOfRows(groups[g], "Points"));
+    }
+    vtkIdType numberOfPoints = pointOffsets.back();
+    std::vector<std::vector<vtkHDFRows> > pointRows(groups.size());
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+      vtkHDFRows rows = { 0, static_cast<hsize_t>(pointOffsets[g + 1] - pointOffsets[g]),
+        static_cast<hsize_t>(pointOffsets[g]) };
+      pointRows[g].push_back(rows);
+    }
+    if (!vtkHDFUtilities::Exists(groups[0], "Points"))
+    {
+      vtkErrorWithObjectMacro(this->Reader, "Points are missing.");
+      return false;
+    }
+    vtkHDFArrayInfo pointsInfo;
+    {
+      Handle dataset(H5Dopen2(groups[0], "Points", H5P_DEFAULT), H5Dclose);
+      pointsInfo.Type = GetVTKType(dataset);
+      pointsInfo.NumberOfComponents = 3;
+    }
+    vtkSmartPointer<vtkDataArray> coordinates = NewArray(pointsInfo, numberOfPoints);
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+      Handle dataset(H5Dopen2(groups[g], "Points", H5P_DEFAULT), H5Dclose);
+      if (!ReadRows(dataset, coordinates, pointRows[g][0]))
+      {
+        vtkErrorWithObjectMacro(this->Reader, "Could not read the points.");
+        return false;
+      }
+    }
+    vtkNew<vtkPoints> points;
+    points->SetData(coordinates);
+    output->SetPoints(points);
+
+    // Cells
+    std::vector<std::vector<vtkHDFRows> > cellRows(groups.size());
+    vtkIdType numberOfCells = 0;
+    if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(output))
+    {
+      std::vector<vtkIdType> cellCounts;
+      vtkNew<vtkCellArray> cells;
+      if (!this->ReadCells(groups, "", pointOffsets, cells, cellCounts) ||
+        !this->ReadGridCells(groups, pointOffsets, cellCounts, cells, grid))
+      {
+        return false;
+      }
+      for (size_t g = 0; g < groups.size(); ++g)
+      {
+        vtkHDFRows rows = { 0, static_cast<hsize_t>(cellCounts[g]),
+          static_cast<hsize_t>(numberOfCells) };
+        cellRows[g].push_back(rows);
+        numberOfCells += cellCounts[g];
+      }
+    }
+    else if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(output))
+    {
+      // The cell data of each group is ordered by cell kind, and so is the
+      // cell data of the output.
+      const char* names[4] = { "Verts/", "Lines/", "Polys/", "Strips/" };
+      std::vector<hsize_t> fileStarts(groups.size(), 0);
+      for (int kind = 0; kind < 4; ++kind)
+      {
+        std::vector<vtkIdType> cellCounts;
+        vtkNew<vtkCellArray> cells;
+        if (!this->ReadCells(groups, names[kind], pointOffsets, cells, cellCounts))
+        {
+          return false;
+        }
+        for (size_t g = 0; g < groups.size(); ++g)
+        {
+          vtkHDFRows rows = { fileStarts[g], static_cast<hsize_t>(cellCounts[g]),
+            static_cast<hsize_t>(numberOfCells) };
+          cellRows[g].push_back(rows);
+          fileStarts[g] += cellCounts[g];
+          numberOfCells += cellCounts[g];
+        }
+        switch (kind)
+        {
+          case 0:
+            polyData->SetVerts(cells);
+            break;
+          case 1:
+            polyData->SetLines(cells);
+            break;
+          case 2:
+            polyData->SetPolys(cells);
+            break;
+          default:
+            polyData->SetStrips(cells);
+            break;
+        }
+      }
+    }
+
+    return this->ReadArrays(groups, "PointData", pointRows, numberOfPoints,
+             this->Reader->PointDataArraySelection, output->GetPointData()) &&
+      this->ReadArrays(groups, "CellData", cellRows, numberOfCells,
+        this->Reader->CellDataArraySelection, output->GetCellData()) &&
+      this->ReadFieldData(groups[0], output->GetFieldData());
+  }
+
+  //--------------------------------------------------------------------------
+  // Read the cell types and polyhedron faces of unstructured grid groups
+  // and set the cells of the grid.
+  bool ReadGridCells(const std::vector<hid_t>& groups, const std::vector<vtkIdType>& pointOffsets,
+    const std::vector<vtkIdType>& cellCounts, vtkCellArray* cells, vtkUnstructuredGrid* grid)
+  {
+    vtkIdType numberOfCells = cells->GetNumberOfCells();
+    vtkNew<vtkUnsignedCharArray> types;
+    types->SetNumberOfValues(numberOfCells);
+    vtkNew<vtkIdTypeArray> locations;
+    locations->SetNumberOfValues(numberOfCells);
+
+    bool hasFaces = false;
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+      hasFaces = hasFaces || vtkHDFUtilities::Exists(groups[g], "Faces");
+    }
+    vtkNew<vtkIdTypeArray> faces;
+    vtkNew<vtkIdTypeArray> faceLocations;
+
+    vtkIdType cellStart = 0;
+    vtkIdType location = 0;
+    std::vector<vtkIdType> offsets;
+    std::vector<vtkIdType> pieceFaces;
+    std::vector<vtkIdType> pieceFaceLocations;
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+      if (cellCounts[g] == 0)
+      {
+        continue;
+      }
+      Handle dataset(H5Dopen2(groups[g], "Types", H5P_DEFAULT), H5Dclose);
+      vtkHDFRows rows = { 0, static_cast<hsize_t>(cellCounts[g]),
+        static_cast<hsize_t>(cellStart) };
+      if (!dataset.IsValid() || !ReadRows(dataset, types, rows) ||
+        !ReadIds(groups[g], "Offsets", offsets))
+      {
+        vtkErrorWithObjectMacro(this->Reader, "Could not read the cell types.");
+        return false;
+      }
+      for (vtkIdType cell = 0; cell < cellCounts[g]; ++cell)
+      {
+        locations->SetValue(cellStart + cell, location);
+        location += offsets[cell + 1] - offsets[cell] + 1;
+      }
+
+      if (hasFaces)
+      {
+        bool pieceHasFaces = vtkHDFUtilities::Exists(groups[g], "Faces");
+        if (pieceHasFaces &&
+          (!ReadIds(groups[g], "Faces", pieceFaces) ||
+            !ReadIds(groups[g], "FaceLocations", pieceFaceLocations) ||
+            static_cast<vtkIdType>(pieceFaceLocations.size()) != cellCounts[g]))
+        {
+          vtkErrorWithObjectMacro(this->Reader, "Could not read the polyhedron faces.");
+          return false;
+        }
+        for (vtkIdType cell = 0; cell < cellCounts[g]; ++cell)
+        {
+          vtkIdType faceLocation = pieceHasFaces ? pieceFaceLocations[cell] : -1;
+          if (faceLocation < 0)
+          {
+            faceLocations->InsertNextValue(-1);
+            continue;
+          }
+          // Copy the face stream of the cell, shifting its point ids.
+          faceLocations->InsertNextValue(faces->GetNumberOfValues());
+          vtkIdType position = faceLocation;
+          vtkIdType numberOfFaces = pieceFaces[position++];
+          faces->InsertNextValue(numberOfFaces);
+          for (vtkIdType face = 0; face < numberOfFaces; ++face)
+          {
+            vtkIdType npts = pieceFaces[position++];
+            faces->InsertNextValue(npts);
+            for (vtkIdType i = 0; i < npts; ++i)
+            {
+              faces->InsertNextValue(pieceFaces[position++] + pointOffsets[g]);
+            }
+          }
+        }
+      }
+      cellStart += cellCounts[g];
+    }
+
+    if (hasFaces)
+    {
+      grid->SetCells(types, locations, cells, faceLocations, faces);
+    }
+    else
+    {
+      grid->SetCells(types, locations, cells);
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  // Read a dataset group of the given type, such as a block.
+  vtkSmartPointer<vtkDataObject> ReadDataObject(hid_t group, const std::string& type)
+  {
+    vtkSmartPointer<vtkDataObject> data;
+    std::vector<hid_t> groups(1, group);
+    if (type == "ImageData")
+    {
+      vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+      int extent[6] = { 0, -1, 0, -1, 0, -1 };
+      vtkHDFUtilities::ReadAttribute(group, "Extent", extent, 6);
+      if (this->ReadImage(groups, extent, image))
+      {
+        data = image;
+      }
+    }
+    else if (type == "PolyData" || type == "UnstructuredGrid")
+    {
+      vtkSmartPointer<vtkPointSet> pointSet;
+      if (type == "PolyData")
+      {
+        pointSet = vtkSmartPointer<vtkPolyData>::New();
+      }
+      else
+      {
+        pointSet = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      }
+      if (this->ReadPointSet(groups, pointSet))
+      {
+        data = pointSet;
+      }
+    }
+    else if (type == "MultiBlockDataSet")
+    {
+      vtkSmartPointer<vtkMultiBlockDataSet> blocks = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+      if (this->ReadBlocks(group, blocks))
+      {
+        data = blocks;
+      }
+    }
+    return data;
+  }
+
+  //--------------------------------------------------------------------------
+  bool ReadBlocks(hid_t group, vtkMultiBlockDataSet* output)
+  {
+    std::vector<std::string> names = vtkHDFUtilities::GetLinkNames(group);
+    unsigned int numberOfBlocks = 0;
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+      numberOfBlocks += names[i].compare(0, 5, "Block") == 0 ? 1 : 0;
+    }
+    output->SetNumberOfBlocks(numberOfBlocks);
+    for (unsigned int b = 0; b < numberOfBlocks; ++b)
+    {
+      std::ostringstream name;
+      name << "Block" << b;
+      if (!vtkHDFUtilities::Exists(group, name.str().c_str()))
+      {
+        vtkErrorWithObjectMacro(this->Reader, "" << name.str() << " is missing.");
+        return false;
+      }
+      Handle blockGroup(H5Gopen2(group, name.str().c_str(), H5P_DEFAULT), H5Gclose);
+      std::string type;
+      vtkHDFUtilities::ReadAttribute(blockGroup, "Type", type);
+      std::string blockName;
+      if (vtkHDFUtilities::ReadAttribute(blockGroup, "Name", blockName))
+      {
+        output->GetMetaData(b)->Set(vtkCompositeDataSet::NAME(), blockName.c_str());
+      }
+      if (type.empty() || type == "None")
+      {
+        continue;
+      }
+      vtkSmartPointer<vtkDataObject> block = this->ReadDataObject(blockGroup, type);
+      if (!block)
+      {
+        return false;
+      }
+      output->SetBlock(b, block);
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  // Collect the names of the point and cell arrays of the dataset groups
+  // of a step, descending into blocks.
+  void CollectArrayNames(
+    hid_t group, const std::string& type, std::set<std::string>& seen, vtkHDFReader* reader)
+  {
+    if (type == "MultiBlockDataSet")
+    {
+      std::vector<std::string> names = vtkHDFUtilities::GetLinkNames(group);
+      for (size_t i = 0; i < names.size(); ++i)
+      {
+        Handle blockGroup(H5Gopen2(group, names[i].c_str(), H5P_DEFAULT), H5Gclose);
+        std::string blockType;
+        vtkHDFUtilities::ReadAttribute(blockGroup, "Type", blockType);
+        this->CollectArrayNames(blockGroup, blockType, seen, reader);
+      }
+      return;
+    }
+    const char* attributesNames[2] = { "PointData", "CellData" };
+    vtkDataArraySelection* selections[2] = { reader->PointDataArraySelection,
+      reader->CellDataArraySelection };
+    for (int i = 0; i < 2; ++i)
+    {
+      if (!vtkHDFUtilities::Exists(group, attributesNames[i]))
+      {
+        continue;
+      }
+      Handle attributes(H5Gopen2(group, attributesNames[i], H5P_DEFAULT), H5Gclose);
+      std::vector<std::string> names = vtkHDFUtilities::GetLinkNames(attributes);
+      for (size_t n = 0; n < names.size(); ++n)
+      {
+        if (seen.insert(attributesNames[i] + names[n]).second)
+        {
+          selections[i]->AddArray(names[n].c_str());
+        }
+      }
+    }
+  }
+};
+
+vtkStandardNewMacro(vtkHDFReader);
+
+//----------------------------------------------------------------------------
+vtkHDFReader::vtkHDFReader()
+{
+  this->FileName = nullptr;
+  this->Internals = new vtkInternals(this);
+
+  this->PointDataArraySelection = vtkDataArraySelection::New();
+  this->CellDataArraySelection = vtkDataArraySelection::New();
+  this->SelectionObserver = vtkCallbackCommand::New();
+  this->SelectionObserver->SetCallback(&vtkHDFReader::SelectionModifiedCallback);
+  this->SelectionObserver->SetClientData(this);
+  this->PointDataArraySelection->AddObserver(vtkCommand::ModifiedEvent, this->SelectionObserver);
+  this->CellDataArraySelection->AddObserver(vtkCommand::ModifiedEvent, this->SelectionObserver);
+
+  this->SetNumberOfInputPorts(0);
+  this->SetNumberOfOutputPorts(1);
+}
+
+//----------------------------------------------------------------------------
+vtkHDFReader::~vtkHDFReader()
+{
+  delete this->Internals;
+  this->SetFileName(nullptr);
+  this->CellDataArraySelection->RemoveObserver(this->SelectionObserver);
+  this->PointDataArraySelection->RemoveObserver(this->SelectionObserver);
+  this->SelectionObserver->Delete();
+  this->CellDataArraySelection->Delete();
+  this->PointDataArraySelection->Delete();
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFReader::CanReadFile(const char* name)
+{
+  vtkInternals internals(this);
+  return internals.Open(name) ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFReader::SelectionModifiedCallback(vtkObject*, unsigned long, void* clientdata, void*)
+{
+  static_cast<vtkHDFReader*>(clientdata)->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFReader::GetNumberOfPointArrays()
+{
+  return this->PointDataArraySelection->GetNumberOfArrays();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkHDFReader::GetPointArrayName(int index)
+{
+  return this->PointDataArraySelection->GetArrayName(index);
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFReader::GetPointArrayStatus(const char* name)
+{
+  return this->PointDataArraySelection->ArrayIsEnabled(name);
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFReader::SetPointArrayStatus(const char* name, int status)
+{
+  if (status)
+  {
+    this->PointDataArraySelection->EnableArray(name);
+  }
+  else
+  {
+    this->PointDataArraySelection->DisableArray(name);
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFReader::GetNumberOfCellArrays()
+{
+  return this->CellDataArraySelection->GetNumberOfArrays();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkHDFReader::GetCellArrayName(int index)
+{
+  return this->CellDataArraySelection->GetArrayName(index);
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFReader::GetCellArrayStatus(const char* name)
+{
+  return this->CellDataArraySelection->ArrayIsEnabled(name);
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFReader::SetCellArrayStatus(const char* name, int status)
+{
+  if (status)
+  {
+    this->CellDataArraySelection->EnableArray(name);
+  }
+  else
+  {
+    this->CellDataArraySelection->DisableArray(name);
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFReader::FillOutputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataObject");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFReader::RequestDataObject(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkInternals* internals = this->Internals;
+  if (!internals->Open(this->FileName))
+  {
+    vtkErrorMacro("Cannot read file " << (this->FileName ? this->FileName : "(none)"));
+    return 0;
+  }
+  internals->Close();
+
+  vtkSmartPointer<vtkDataObject> newOutput;
+  if (internals->Type == "ImageData")
+  {
+    newOutput = vtkSmartPointer<vtkImageData>::New();
+  }
+  else if (internals->Type == "PolyData")
+  {
+    newOutput = vtkSmartPointer<vtkPolyData>::New();
+  }
+  else if (internals->Type == "UnstructuredGrid")
+  {
+    newOutput = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  }
+  else if (internals->Type == "MultiBlockDataSet")
+  {
+    newOutput = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  }
+  else
+  {
+    vtkErrorMacro("Unknown data type " << internals->Type);
+    return 0;
+  }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output || !output->IsA(newOutput->GetClassName()))
+  {
+    outInfo->Set(vtkDataObject::DATA_OBJECT(), newOutput);
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFReader::RequestInformation(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+  vtkInternals* internals = this->Internals;
+  if (!internals->Open(this->FileName))
+  {
+    vtkErrorMacro("Cannot read file " << (this->FileName ? this->FileName : "(none)"));
+    return 0;
+  }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  const std::vector<double>& times = internals->TimeValues;
+  outInfo->Set(vtkSDDP::TIME_STEPS(), times.data(), static_cast<int>(times.size()));
+  double range[2] = { *std::min_element(times.begin(), times.end()),
+    *std::max_element(times.begin(), times.end()) };
+  outInfo->Set(vtkSDDP::TIME_RANGE(), range, 2);
+
+  Handle step(internals->OpenStep(0), H5Gclose);
+  std::set<std::string> seen;
+  if (internals->Type == "MultiBlockDataSet")
+  {
+    if (step.IsValid())
+    {
+      internals->CollectArrayNames(step, internals->Type, seen, this);
+    }
+  }
+  else
+  {
+    vtkHDFGroups pieces;
+    if (step.IsValid() && internals->OpenPieces(step, 0, 1, pieces))
+    {
+      internals->CollectArrayNames(pieces.Ids[0], internals->Type, seen, this);
+    }
+    if (internals->Type == "ImageData")
+    {
+      outInfo->Set(vtkSDDP::WHOLE_EXTENT(), internals->WholeExtent, 6);
+      outInfo->Set(CAN_PRODUCE_SUB_EXTENT(), 1);
+      double origin[3] = { 0, 0, 0 };
+      double spacing[3] = { 1, 1, 1 };
+      if (!pieces.Ids.empty())
+      {
+        vtkHDFUtilities::ReadAttribute(pieces.Ids[0], "Origin", origin, 3);
+        vtkHDFUtilities::ReadAttribute(pieces.Ids[0], "Spacing", spacing, 3);
+      }
+      outInfo->Set(vtkDataObject::ORIGIN(), origin, 3);
+      outInfo->Set(vtkDataObject::SPACING(), spacing, 3);
+    }
+    else
+    {
+      outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+    }
+  }
+  internals->Close();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFReader::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+  vtkInternals* internals = this->Internals;
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!internals->Open(this->FileName))
+  {
+    vtkErrorMacro("Cannot read file " << (this->FileName ? this->FileName : "(none)"));
+    return 0;
+  }
+
+  // Read the time step containing the requested time.
+  const std::vector<double>& times = internals->TimeValues;
+  int stepIndex = 0;
+  if (outInfo->Has(vtkSDDP::UPDATE_TIME_STEP()))
+  {
+    double time = outInfo->Get(vtkSDDP::UPDATE_TIME_STEP());
+    stepIndex = static_cast<int>(std::upper_bound(times.begin(), times.end(), time) -
+      times.begin()) - 1;
+    stepIndex = std::max(stepIndex, 0);
+  }
+  Handle step(internals->OpenStep(stepIndex), H5Gclose);
+  if (!step.IsValid())
+  {
+    vtkErrorMacro("Time step " << stepIndex << " is missing.");
+    internals->Close();
+    return 0;
+  }
+
+  bool success = true;
+  if (vtkMultiBlockDataSet* blocks = vtkMultiBlockDataSet::SafeDownCast(output))
+  {
+    blocks->Initialize();
+    success = internals->ReadBlocks(step, blocks);
+  }
+  else if (vtkImageData* image = vtkImageData::SafeDownCast(output))
+  {
+    int extent[6];
+    std::copy(internals->WholeExtent, internals->WholeExtent + 6, extent);
+    if (outInfo->Has(vtkSDDP::UPDATE_EXTENT()))
+    {
+      int* updateExtent = outInfo->Get(vtkSDDP::UPDATE_EXTENT());
+      if (!Intersect(updateExtent, internals->WholeExtent, extent))
+      {
+        int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+        std::copy(emptyExtent, emptyExtent + 6, extent);
+      }
+    }
+    vtkHDFGroups pieces;
+    success = internals->OpenPieces(step, 0, internals->NumberOfPieces, pieces) &&
+      internals->ReadImage(pieces.Ids, extent, image);
+  }
+  else if (vtkPointSet* pointSet = vtkPointSet::SafeDownCast(output))
+  {
+    // Read the pieces of the file making up the requested piece.
+    int piece = 0;
+    int numberOfPieces = 1;
+    if (outInfo->Has(vtkSDDP::UPDATE_PIECE_NUMBER()))
+    {
+      piece = outInfo->Get(vtkSDDP::UPDATE_PIECE_NUMBER());
+      numberOfPieces = std::max(outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_PIECES()), 1);
+    }
+    int first = static_cast<int>(
+      static_cast<long long>(piece) * internals->NumberOfPieces / numberOfPieces);
+    int last = static_cast<int>(
+      static_cast<long long>(piece + 1) * internals->NumberOfPieces / numberOfPieces);
+    vtkHDFGroups pieces;
+    success = internals->OpenPieces(step, first, last, pieces) &&
+      internals->ReadPointSet(pieces.Ids, pointSet);
+  }
+  internals->Close();
+
+  if (!success)
+  {
+    vtkErrorMacro("Error reading " << this->FileName);
+    return 0;
+  }
+  output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), times[stepIndex]);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFReader::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << endl;
+  os << indent << "PointDataArraySelection: " << this->PointDataArraySelection << endl;
+  os << indent << "CellDataArraySelection: " << this->CellDataArraySelection << endl;
+}
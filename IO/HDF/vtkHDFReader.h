@@ -0,0 +1,128 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFReader.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkHDFReader
+ * @brief   Read VTK data from an HDF5 file.
+ *
+ * vtkHDFReader reads the files written by vtkHDFWriter, whose layout is
+ * documented there. The output is a vtkImageData, vtkPolyData,
+ * vtkUnstructuredGrid or vtkMultiBlockDataSet depending on the file.
+ *
+ * Only what the pipeline requests is read from the file: the time step
+ * containing UPDATE_TIME_STEP, the pieces of the file making up the
+ * requested piece, and for images the part of each piece inside the update
+ * extent. The point and cell data arrays can be selected like with
+ * vtkXMLReader.
+ *
+ * @sa
+ * vtkHDFWriter
+ */
+
+#ifndef vtkHDFReader_h
+#define vtkHDFReader_h
+
+#include "vtkDataObjectAlgorithm.h"
+#include "vtkIOHDFModule.h" // For export macro
+
+class vtkCallbackCommand;
+class vtkDataArraySelection;
+
+class VTKIOHDF_EXPORT vtkHDFReader : public vtkDataObjectAlgorithm
+{
+public:
+  static vtkHDFReader* New();
+  vtkTypeMacro(vtkHDFReader, vtkDataObjectAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Get/Set the name of the input file.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  //@}
+
+  /**
+   * Test whether the file with the given name can be read by this reader.
+   */
+  virtual int CanReadFile(const char* name);
+
+  //@{
+  /**
+   * Get the data array selection tables used to configure which data
+   * arrays are loaded by the reader.
+   */
+  vtkGetObjectMacro(PointDataArraySelection, vtkDataArraySelection);
+  vtkGetObjectMacro(CellDataArraySelection, vtkDataArraySelection);
+  //@}
+
+  //@{
+  /**
+   * Get the number of point or cell arrays available in the input.
+   */
+  int GetNumberOfPointArrays();
+  int GetNumberOfCellArrays();
+  //@}
+
+  //@{
+  /**
+   * Get the name of the point or cell array with the given index in
+   * the input.
+   */
+  const char* GetPointArrayName(int index);
+  const char* GetCellArrayName(int index);
+  //@}
+
+  //@{
+  /**
+   * Get/Set whether the point or cell array with the given name is to
+   * be read.
+   */
+  int GetPointArrayStatus(const char* name);
+  int GetCellArrayStatus(const char* name);
+  void SetPointArrayStatus(const char* name, int status);
+  void SetCellArrayStatus(const char* name, int status);
+  //@}
+
+protected:
+  vtkHDFReader();
+  ~vtkHDFReader() override;
+
+  int FillOutputPortInformation(int port, vtkInformation* info) override;
+  int RequestDataObject(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  // Callback registered with the SelectionObserver.
+  static void SelectionModifiedCallback(
+    vtkObject* caller, unsigned long eid, void* clientdata, void* calldata);
+
+  char* FileName;
+  vtkDataArraySelection* PointDataArraySelection;
+  vtkDataArraySelection* CellDataArraySelection;
+  vtkCallbackCommand* SelectionObserver;
+
+private:
+  vtkHDFReader(const vtkHDFReader&) = delete;
+  void operator=(const vtkHDFReader&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
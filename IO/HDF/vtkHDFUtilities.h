@@ -0,0 +1,247 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFUtilities.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by vtkHDFReader and vtkHDFWriter: type mapping, attribute
+// access and handle management for the layout documented in vtkHDFWriter.
+
+#ifndef vtkHDFUtilities_h
+#define vtkHDFUtilities_h
+
+#include "vtkType.h"
+#include "vtk_hdf5.h"
+
+#include <string>
+#include <vector>
+
+namespace vtkHDFUtilities
+{
+// Name of the root group and version of the layout.
+const char* const RootName = "VTKHDF";
+const int Version[2] = { 1, 0 };
+
+//----------------------------------------------------------------------------
+// Closes an HDF5 identifier when it goes out of scope.
+class Handle
+{
+public:
+  typedef herr_t (*CloseFunction)(hid_t);
+
+  Handle(hid_t id, CloseFunction close)
+    : Id(id)
+    , Close(close)
+  {
+  }
+  ~Handle()
+  {
+    if (this->Id >= 0)
+    {
+      this->Close(this->Id);
+    }
+  }
+  operator hid_t() const { return this->Id; }
+  bool IsValid() const { return this->Id >= 0; }
+
+private:
+  Handle(const Handle&) = delete;
+  void operator=(const Handle&) = delete;
+
+  hid_t Id;
+  CloseFunction Close;
+};
+
+//----------------------------------------------------------------------------
+// The native HDF5 type matching a VTK scalar type, or -1.
+inline hid_t GetNativeType(int vtkType)
+{
+  switch (vtkType)
+  {
+    case VTK_CHAR:
+      return H5T_NATIVE_CHAR;
+    case VTK_SIGNED_CHAR:
+      return H5T_NATIVE_SCHAR;
+    case VTK_UNSIGNED_CHAR:
+      return H5T_NATIVE_UCHAR;
+    case VTK_SHORT:
+      return H5T_NATIVE_SHORT;
+    case VTK_UNSIGNED_SHORT:
+      return H5T_NATIVE_USHORT;
+    case VTK_INT:
+      return H5T_NATIVE_INT;
+    case VTK_UNSIGNED_INT:
+      return H5T_NATIVE_UINT;
+    case VTK_LONG:
+      return H5T_NATIVE_LONG;
+    case VTK_UNSIGNED_LONG:
+      return H5T_NATIVE_ULONG;
+    case VTK_LONG_LONG:
+      return H5T_NATIVE_LLONG;
+    case VTK_UNSIGNED_LONG_LONG:
+      return H5T_NATIVE_ULLONG;
+    case VTK_FLOAT:
+      return H5T_NATIVE_FLOAT;
+    case VTK_DOUBLE:
+      return H5T_NATIVE_DOUBLE;
+    case VTK_ID_TYPE:
+#if defined(VTK_USE_64BIT_IDS)
+      return H5T_NATIVE_LLONG;
+#else
+      return H5T_NATIVE_INT;
+#endif
+    default:
+      return -1;
+  }
+}
+
+//----------------------------------------------------------------------------
+inline bool Exists(hid_t location, const char* name)
+{
+  return H5Lexists(location, name, H5P_DEFAULT) > 0;
+}
+
+//----------------------------------------------------------------------------
+inline bool HasAttribute(hid_t object, const char* name)
+{
+  return H5Aexists(object, name) > 0;
+}
+
+//----------------------------------------------------------------------------
+inline bool WriteAttribute(
+  hid_t object, const char* name, hid_t type, const void* values, hsize_t size)
+{
+  Handle space(H5Screate_simple(1, &size, nullptr), H5Sclose);
+  Handle attribute(H5Acreate2(object, name, type, space, H5P_DEFAULT, H5P_DEFAULT), H5Aclose);
+  return attribute.IsValid() && H5Awrite(attribute, type, values) >= 0;
+}
+
+//----------------------------------------------------------------------------
+inline bool WriteAttribute(hid_t object, const char* name, const int* values, hsize_t size)
+{
+  return WriteAttribute(object, name, H5T_NATIVE_INT, values, size);
+}
+
+//----------------------------------------------------------------------------
+inline bool WriteAttribute(hid_t object, const char* name, const double* values, hsize_t size)
+{
+  return WriteAttribute(object, name, H5T_NATIVE_DOUBLE, values, size);
+}
+
+//----------------------------------------------------------------------------
+inline bool WriteAttribute(hid_t object, const char* name, const std::string& value)
+{
+  Handle type(H5Tcopy(H5T_C_S1), H5Tclose);
+  H5Tset_size(type, value.empty() ? 1 : value.size());
+  Handle space(H5Screate(H5S_SCALAR), H5Sclose);
+  Handle attribute(H5Acreate2(object, name, type, space, H5P_DEFAULT, H5P_DEFAULT), H5Aclose);
+  return attribute.IsValid() && H5Awrite(attribute, type, value.c_str()) >= 0;
+}
+
+//----------------------------------------------------------------------------
+// Read exactly size values, converting them to the given memory type.
+inline bool ReadAttribute(hid_t object, const char* name, hid_t type, void* values, hsize_t size)
+{
+  if (!HasAttribute(object, name))
+  {
+    return false;
+  }
+  Handle attribute(H5Aopen(object, name, H5P_DEFAULT), H5Aclose);
+  Handle space(H5Aget_space(attribute), H5Sclose);
+  return H5Sget_simple_extent_npoints(space) == static_cast<hssize_t>(size) &&
+    H5Aread(attribute, type, values) >= 0;
+}
+
+//----------------------------------------------------------------------------
+inline bool ReadAttribute(hid_t object, const char* name, int* values, hsize_t size)
+{
+  return ReadAttribute(object, name, H5T_NATIVE_INT, values, size);
+}
+
+//----------------------------------------------------------------------------
+inline bool ReadAttribute(hid_t object, const char* name, double* values, hsize_t size)
+{
+  return ReadAttribute(object, name, H5T_NATIVE_DOUBLE, values, size);
+}
+
+//----------------------------------------------------------------------------
+inline bool ReadAttribute(hid_t object, const char* name, std::string& value)
+{
+  if (!HasAttribute(object, name))
+  {
+    return false;
+  }
+  Handle attribute(H5Aopen(object, name, H5P_DEFAULT), H5Aclose);
+  Handle fileType(H5Aget_type(attribute), H5Tclose);
+  if (H5Tget_class(fileType) != H5T_STRING || H5Tis_variable_str(fileType) > 0)
+  {
+    return false;
+  }
+  std::vector<char> buffer(H5Tget_size(fileType) + 1, '\0');
+  Handle type(H5Tcopy(H5T_C_S1), H5Tclose);
+  H5Tset_size(type, buffer.size());
+  if (H5Aread(attribute, type, buffer.data()) < 0)
+  {
+    return false;
+  }
+  value = buffer.data();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// The names of the links in a group, in creation order when tracked and in
+// name order otherwise.
+inline std::vector<std::string> GetLinkNames(hid_t group)
+{
+  std::vector<std::string> names;
+  H5G_info_t info;
+  if (H5Gget_info(group, &info) < 0)
+  {
+    return names;
+  }
+  H5_index_t index = H5_INDEX_NAME;
+  Handle properties(H5Gget_create_plist(group), H5Pclose);
+  unsigned flags = 0;
+  if (H5Pget_link_creation_order(properties, &flags) >= 0 && (flags & H5P_CRT_ORDER_TRACKED))
+  {
+    index = H5_INDEX_CRT_ORDER;
+  }
+  for (hsize_t i = 0; i < info.nlinks; ++i)
+  {
+    ssize_t size =
+      H5Lget_name_by_idx(group, ".", index, H5_ITER_INC, i, nullptr, 0, H5P_DEFAULT);
+    if (size < 0)
+    {
+      continue;
+    }
+    std::vector<char> name(size + 1, '\0');
+    H5Lget_name_by_idx(group, ".", index, H5_ITER_INC, i, name.data(), name.size(), H5P_DEFAULT);
+    names.push_back(name.data());
+  }
+  return names;
+}
+
+//----------------------------------------------------------------------------
+// The cell extent of an image with the given point extent.
+inline void GetCellExtent(const int pointExtent[6], int cellExtent[6])
+{
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    cellExtent[2 * axis] = pointExtent[2 * axis];
+    cellExtent[2 * axis + 1] = pointExtent[2 * axis + 1] > pointExtent[2 * axis]
+      ? pointExtent[2 * axis + 1] - 1
+      : pointExtent[2 * axis];
+  }
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkHDFUtilities.h
@@ -0,0 +1,896 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkHDFWriter.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkErrorCode.h"
+#include "vtkExtentTranslator.h"
+#include "vtkFieldData.h"
+#include "vtkHDFUtilities.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using vtkHDFUtilities::Handle;
+
+//----------------------------------------------------------------------------
+class vtkHDFWriter::vtkInternals
+{
+public:
+  vtkHDFWriter* Writer;
+  hid_t File;
+  hid_t GroupCreation;
+  std::string Type;
+  std::vector<double> TimeValues;
+  std::map<std::string, int> ArrayCompressionLevels;
+
+  vtkInternals(vtkHDFWriter* writer)
+    : Writer(writer)
+    , File(-1)
+    , GroupCreation(-1)
+  {
+  }
+
+  ~vtkInternals() { this->Close(); }
+
+  //--------------------------------------------------------------------------
+  bool Open(const char* fileName)
+  {
+    this->Close();
+    this->File = H5Fcreate(fileName, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if (this->File < 0)
+    {
+      return false;
+    }
+    // Keep the arrays and blocks in the order they were written.
+    this->GroupCreation = H5Pcreate(H5P_GROUP_CREATE);
+    H5Pset_link_creation_order(
+      this->GroupCreation, H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED);
+    this->TimeValues.clear();
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  void Close()
+  {
+    if (this->GroupCreation >= 0)
+    {
+      H5Pclose(this->GroupCreation);
+      this->GroupCreation = -1;
+    }
+    if (this->File >= 0)
+    {
+      H5Fclose(this->File);
+      this->File = -1;
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  hid_t CreateGroup(hid_t parent, const std::string& name)
+  {
+    return H5Gcreate2(parent, name.c_str(), H5P_DEFAULT, this->GroupCreation, H5P_DEFAULT);
+  }
+
+  //--------------------------------------------------------------------------
+  int GetCompressionLevel(const std::string& name) const
+  {
+    std::map<std::string, int>::const_iterator pos = this->ArrayCompressionLevels.find(name);
+    return pos != this->ArrayCompressionLevels.end() ? pos->second
+                                                     : this->Writer->CompressionLevel;
+  }
+
+  //--------------------------------------------------------------------------
+  // Write a dataset of the given shape. When memoryDims is given, the data
+  // is a larger block of that shape from which the region starting at
+  // memoryOffset is written.
+  bool WriteDataset(hid_t group, const std::string& name, hid_t fileType, hid_t memoryType,
+    const void* data, int rank, const hsize_t* dims, const hsize_t* memoryDims = nullptr,
+    const hsize_t* memoryOffset = nullptr)
+  {
+    hsize_t numberOfValues = 1;
+    for (int i = 0; i < rank; ++i)
+    {
+      numberOfValues *= dims[i];
+    }
+
+    Handle creation(H5Pcreate(H5P_DATASET_CREATE), H5Pclose);
+    int level = this->GetCompressionLevel(name);
+    int chunkSize = this->Writer->ChunkSize;
+    if (level > 0 && chunkSize == 0)
+    {
+      chunkSize = 65536;
+    }
+    if (chunkSize > 0 && numberOfValues > 0)
+    {
+      // Chunks hold about chunkSize tuples, made of whole rows and slices
+      // of images when they fit.
+      hsize_t chunk[4];
+      hsize_t remaining = static_cast<hsize_t>(chunkSize);
+      int tupleRank = (rank == 2 || rank == 4) ? rank - 1 : rank;
+      for (int i = tupleRank - 1; i >= 0; --i)
+      {
+        chunk[i] = std::max<hsize_t>(1, std::min(dims[i], remaining));
+        remaining = std::max<hsize_t>(1, remaining / chunk[i]);
+      }
+      for (int i = tupleRank; i < rank; ++i)
+      {
+        chunk[i] = dims[i];
+      }
+      H5Pset_chunk(creation, rank, chunk);
+      if (level > 0)
+      {
+        H5Pset_shuffle(creation);
+        H5Pset_deflate(creation, static_cast<unsigned>(level));
+      }
+    }
+
+    Handle fileSpace(H5Screate_simple(rank, dims, nullptr), H5Sclose);
+    Handle dataset(
+      H5Dcreate2(group, name.c_str(), fileType, fileSpace, H5P_DEFAULT, creation, H5P_DEFAULT),
+      H5Dclose);
+    if (!dataset.IsValid())
+    {
+      return false;
+    }
+    if (numberOfValues == 0)
+    {
+      return true;
+    }
+    if (!memoryDims)
+    {
+      return H5Dwrite(dataset, memoryType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) >= 0;
+    }
+    Handle memorySpace(H5Screate_simple(rank, memoryDims, nullptr), H5Sclose);
+    H5Sselect_hyperslab(memorySpace, H5S_SELECT_SET, memoryOffset, nullptr, dims, nullptr);
+    return H5Dwrite(dataset, memoryType, memorySpace, H5S_ALL, H5P_DEFAULT, data) >= 0;
+  }
+
+  //--------------------------------------------------------------------------
+  // Write an array as [tuples, components], or as [z, y, x, components]
+  // cropped to the region of an image block when imageDims is given.
+  bool WriteArray(hid_t group, vtkDataArray* array, const std::string& name,
+    const int* imageDims = nullptr, const int* imageBlockDims = nullptr,
+    const int* imageOffset = nullptr)
+  {
+    hid_t type = vtkHDFUtilities::GetNativeType(array->GetDataType());
+    if (type < 0)
+    {
+      vtkWarningWithObjectMacro(
+        this->Writer, "Array " << name << " of type " << array->GetDataTypeAsString()
+                                << " is not written.");
+      return true;
+    }
+
+    int numberOfComponents = array->GetNumberOfComponents();
+    hsize_t dims[4];
+    hsize_t memoryDims[4];
+    hsize_t memoryOffset[4];
+    int rank = 0;
+    if (imageDims)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        dims[i] = static_cast<hsize_t>(imageDims[2 - i]);
+        memoryDims[i] = static_cast<hsize_t>(imageBlockDims[2 - i]);
+        memoryOffset[i] = static_cast<hsize_t>(imageOffset[2 - i]);
+      }
+      rank = 3;
+    }
+    else
+    {
+      dims[0] = memoryDims[0] = static_cast<hsize_t>(array->GetNumberOfTuples());
+      memoryOffset[0] = 0;
+      rank = 1;
+    }
+    if (numberOfComponents > 1)
+    {
+      dims[rank] = memoryDims[rank] = static_cast<hsize_t>(numberOfComponents);
+      memoryOffset[rank] = 0;
+      ++rank;
+    }
+
+    const void* data = array->GetNumberOfTuples() > 0 ? array->GetVoidPointer(0) : nullptr;
+    if (!this->WriteDataset(group, name, type, type, data, rank, dims,
+          imageDims ? memoryDims : nullptr, imageDims ? memoryOffset : nullptr))
+    {
+      vtkErrorWithObjectMacro(this->Writer, "Could not write array " << name << ".");
+      return false;
+    }
+    Handle dataset(H5Dopen2(group, name.c_str(), H5P_DEFAULT), H5Dclose);
+    int vtkType = array->GetDataType();
+    return vtkHDFUtilities::WriteAttribute(dataset, "VTKType", &vtkType, 1);
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteFieldData(hid_t parent, const char* groupName, vtkFieldData* fieldData,
+    const int* imageDims = nullptr, const int* imageBlockDims = nullptr,
+    const int* imageOffset = nullptr)
+  {
+    Handle group(this->CreateGroup(parent, groupName), H5Gclose);
+    if (!group.IsValid())
+    {
+      return false;
+    }
+    if (!fieldData)
+    {
+      return true;
+    }
+    for (int i = 0; i < fieldData->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* array = fieldData->GetArray(i);
+      if (!array)
+      {
+        continue;
+      }
+      std::string name;
+      if (array->GetName() && *array->GetName())
+      {
+        name = array->GetName();
+      }
+      else
+      {
+        std::ostringstream unnamed;
+        unnamed << "Array" << i;
+        name = unnamed.str();
+      }
+      if (vtkHDFUtilities::Exists(group, name.c_str()))
+      {
+        vtkWarningWithObjectMacro(
+          this->Writer, "Skipping array " << name << " that has the same name as another.");
+        continue;
+      }
+      if (!this->WriteArray(group, array, name, imageDims, imageBlockDims, imageOffset))
+      {
+        return false;
+      }
+    }
+
+    vtkDataSetAttributes* attributes = vtkDataSetAttributes::SafeDownCast(fieldData);
+    if (attributes)
+    {
+      const char* names[5] = { "Scalars", "Vectors", "Normals", "TCoords", "Tensors" };
+      int types[5] = { vtkDataSetAttributes::SCALARS, vtkDataSetAttributes::VECTORS,
+        vtkDataSetAttributes::NORMALS, vtkDataSetAttributes::TCOORDS,
+        vtkDataSetAttributes::TENSORS };
+      for (int i = 0; i < 5; ++i)
+      {
+        vtkAbstractArray* active = attributes->GetAbstractAttribute(types[i]);
+        if (active && active->GetName() && *active->GetName() &&
+          !vtkHDFUtilities::WriteAttribute(group, names[i], std::string(active->GetName())))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  bool WritePoints(hid_t group, vtkPoints* points)
+  {
+    if (points)
+    {
+      return this->WriteArray(group, points->GetData(), "Points");
+    }
+    hsize_t dims[2] = { 0, 3 };
+    return this->WriteDataset(group, "Points", H5T_NATIVE_FLOAT, H5T_NATIVE_FLOAT, nullptr, 2, dims);
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteIds(hid_t group, const char* name, const vtkIdType* ids, vtkIdType size)
+  {
+    hsize_t dims[1] = { static_cast<hsize_t>(size) };
+    return this->WriteDataset(group, name, H5T_STD_I64LE,
+      vtkHDFUtilities::GetNativeType(VTK_ID_TYPE), ids, 1, dims);
+  }
+
+  //--------------------------------------------------------------------------
+  // Write cells as Offsets and Connectivity.
+  bool WriteCells(hid_t group, vtkCellArray* cells)
+  {
+    vtkIdType numberOfCells = cells ? cells->GetNumberOfCells() : 0;
+    std::vector<vtkIdType> offsets(numberOfCells + 1, 0);
+    std::vector<vtkIdType> connectivity;
+    if (numberOfCells > 0)
+    {
+      const vtkIdType* legacy = cells->GetPointer();
+      connectivity.resize(cells->GetNumberOfConnectivityEntries() - numberOfCells);
+      vtkIdType position = 0;
+      for (vtkIdType cell = 0; cell < numberOfCells; ++cell)
+      {
+        vtkIdType npts = legacy[position];
+        std::copy(legacy + position + 1, legacy + position + 1 + npts,
+          connectivity.begin() + offsets[cell]);
+        offsets[cell + 1] = offsets[cell] + npts;
+        position += npts + 1;
+      }
+    }
+    return this->WriteIds(group, "Offsets", offsets.data(), numberOfCells + 1) &&
+      this->WriteIds(group, "Connectivity", connectivity.data(),
+        static_cast<vtkIdType>(connectivity.size()));
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteImage(hid_t group, vtkImageData* image, const int pieceExtent[6])
+  {
+    int extent[6];
+    image->GetExtent(extent);
+    int writeExtent[6];
+    bool empty = false;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      writeExtent[2 * axis] = std::max(extent[2 * axis], pieceExtent[2 * axis]);
+      writeExtent[2 * axis + 1] = std::min(extent[2 * axis + 1], pieceExtent[2 * axis + 1]);
+      empty = empty || writeExtent[2 * axis] > writeExtent[2 * axis + 1];
+    }
+    if (empty)
+    {
+      int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+      std::copy(emptyExtent, emptyExtent + 6, writeExtent);
+    }
+    if (!vtkHDFUtilities::WriteAttribute(group, "Extent", writeExtent, 6) ||
+      !vtkHDFUtilities::WriteAttribute(group, "Origin", image->GetOrigin(), 3) ||
+      !vtkHDFUtilities::WriteAttribute(group, "Spacing", image->GetSpacing(), 3))
+    {
+      return false;
+    }
+    if (empty)
+    {
+      return this->WriteFieldData(group, "PointData", nullptr) &&
+        this->WriteFieldData(group, "CellData", nullptr) &&
+        this->WriteFieldData(group, "FieldData", image->GetFieldData());
+    }
+
+    int dims[3];
+    int blockDims[3];
+    int offset[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      dims[axis] = writeExtent[2 * axis + 1] - writeExtent[2 * axis] + 1;
+      blockDims[axis] = extent[2 * axis + 1] - extent[2 * axis] + 1;
+      offset[axis] = writeExtent[2 * axis] - extent[2 * axis];
+    }
+    int cellExtent[6];
+    int writeCellExtent[6];
+    vtkHDFUtilities::GetCellExtent(extent, cellExtent);
+    vtkHDFUtilities::GetCellExtent(writeExtent, writeCellExtent);
+    int cellDims[3];
+    int cellBlockDims[3];
+    int cellOffset[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      cellDims[axis] = writeCellExtent[2 * axis + 1] - writeCellExtent[2 * axis] + 1;
+      cellBlockDims[axis] = cellExtent[2 * axis + 1] - cellExtent[2 * axis] + 1;
+      cellOffset[axis] = writeCellExtent[2 * axis] - cellExtent[2 * axis];
+    }
+    return this->WriteFieldData(group, "PointData", image->GetPointData(), dims, blockDims,
+             offset) &&
+      this->WriteFieldData(
+        group, "CellData", image->GetCellData(), cellDims, cellBlockDims, cellOffset) &&
+      this->WriteFieldData(group, "FieldData", image->GetFieldData());
+  }
+
+  //--------------------------------------------------------------------------
+  bool WritePolyData(hid_t group, vtkPolyData* polyData)
+  {
+    if (!this->WritePoints(group, polyData->GetPoints()))
+    {
+      return false;
+    }
+    const char* names[4] = { "Verts", "Lines", "Polys", "Strips" };
+    vtkCellArray* cells[4] = { polyData->GetVerts(), polyData->GetLines(), polyData->GetPolys(),
+      polyData->GetStrips() };
+    for (int i = 0; i < 4; ++i)
+    {
+      Handle cellGroup(this->CreateGroup(group, names[i]), H5Gclose);
+      if (!cellGroup.IsValid() || !this->WriteCells(cellGroup, cells[i]))
+      {
+        return false;
+      }
+    }
+    return this->WriteFieldData(group, "PointData", polyData->GetPointData()) &&
+      this->WriteFieldData(group, "CellData", polyData->GetCellData()) &&
+      this->WriteFieldData(group, "FieldData", polyData->GetFieldData());
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteUnstructuredGrid(hid_t group, vtkUnstructuredGrid* grid)
+  {
+    if (!this->WritePoints(group, grid->GetPoints()) ||
+      !this->WriteCells(group, grid->GetCells()))
+    {
+      return false;
+    }
+    vtkUnsignedCharArray* types = grid->GetCellTypesArray();
+    hsize_t numberOfCells[1] = { static_cast<hsize_t>(grid->GetNumberOfCells()) };
+    if (!this->WriteDataset(group, "Types", H5T_NATIVE_UCHAR, H5T_NATIVE_UCHAR,
+          numberOfCells[0] > 0 ? types->GetPointer(0) : nullptr, 1, numberOfCells))
+    {
+      return false;
+    }
+    vtkIdTypeArray* faces = grid->GetFaces();
+    vtkIdTypeArray* faceLocations = grid->GetFaceLocations();
+    if (faces && faceLocations &&
+      (!this->WriteIds(group, "FaceLocations", faceLocations->GetPointer(0),
+         faceLocations->GetNumberOfValues()) ||
+        !this->WriteIds(group, "Faces", faces->GetPointer(0), faces->GetNumberOfValues())))
+    {
+      return false;
+    }
+    return this->WriteFieldData(group, "PointData", grid->GetPointData()) &&
+      this->WriteFieldData(group, "CellData", grid->GetCellData()) &&
+      this->WriteFieldData(group, "FieldData", grid->GetFieldData());
+  }
+
+  //--------------------------------------------------------------------------
+  // Write the blocks of a multiblock dataset into Block<b> groups.
+  bool WriteBlocks(hid_t group, vtkMultiBlockDataSet* blocks)
+  {
+    for (unsigned int b = 0; b < blocks->GetNumberOfBlocks(); ++b)
+    {
+      std::ostringstream name;
+      name << "Block" << b;
+      Handle blockGroup(this->CreateGroup(group, name.str()), H5Gclose);
+      if (!blockGroup.IsValid())
+      {
+        return false;
+      }
+      if (blocks->HasMetaData(b) && blocks->GetMetaData(b)->Has(vtkCompositeDataSet::NAME()) &&
+        !vtkHDFUtilities::WriteAttribute(blockGroup, "Name",
+          std::string(blocks->GetMetaData(b)->Get(vtkCompositeDataSet::NAME()))))
+      {
+        return false;
+      }
+
+      vtkDataObject* block = blocks->GetBlock(b);
+      std::string type = GetTypeName(block);
+      if (type.empty())
+      {
+        vtkWarningWithObjectMacro(this->Writer,
+          "Block " << b << " of type " << block->GetClassName() << " is written as empty.");
+        type = "None";
+      }
+      if (!vtkHDFUtilities::WriteAttribute(blockGroup, "Type", type))
+      {
+        return false;
+      }
+      if (type != "None" && !this->WriteDataObject(blockGroup, block, nullptr))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  bool WriteDataObject(hid_t group, vtkDataObject* data, const int* pieceExtent)
+  {
+    if (vtkImageData* image = vtkImageData::SafeDownCast(data))
+    {
+      return this->WriteImage(group, image, pieceExtent ? pieceExtent : image->GetExtent());
+    }
+    if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(data))
+    {
+      return this->WritePolyData(group, polyData);
+    }
+    if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(data))
+    {
+      return this->WriteUnstructuredGrid(group, grid);
+    }
+    if (vtkMultiBlockDataSet* blocks = vtkMultiBlockDataSet::SafeDownCast(data))
+    {
+      return this->WriteBlocks(group, blocks);
+    }
+    return false;
+  }
+
+  //--------------------------------------------------------------------------
+  // The @Type of a data object in the file, empty when not supported.
+  static std::string GetTypeName(vtkDataObject* data)
+  {
+    if (!data)
+    {
+      return "None";
+    }
+    if (vtkImageData::SafeDownCast(data))
+    {
+      return "ImageData";
+    }
+    if (vtkPolyData::SafeDownCast(data))
+    {
+      return "PolyData";
+    }
+    if (vtkUnstructuredGrid::SafeDownCast(data))
+    {
+      return "UnstructuredGrid";
+    }
+    if (vtkMultiBlockDataSet::SafeDownCast(data))
+    {
+      return "MultiBlockDataSet";
+    }
+    return std::string();
+  }
+};
+
+vtkStandardNewMacro(vtkHDFWriter);
+
+//----------------------------------------------------------------------------
+vtkHDFWriter::vtkHDFWriter()
+{
+  this->FileName = nullptr;
+  this->NumberOfPieces = 1;
+  this->WriteAllTimeSteps = 0;
+  this->ChunkSize = 65536;
+  this->CompressionLevel = 0;
+  this->CurrentPiece = 0;
+  this->CurrentTimeIndex = 0;
+  this->NumberOfTimeSteps = 1;
+  this->Internals = new vtkInternals(this);
+
+  this->SetNumberOfInputPorts(1);
+  this->SetNumberOfOutputPorts(0);
+}
+
+//----------------------------------------------------------------------------
+vtkHDFWriter::~vtkHDFWriter()
+{
+  delete this->Internals;
+  this->SetFileName(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFWriter::SetArrayCompressionLevel(const char* name, int level)
+{
+  if (!name)
+  {
+    return;
+  }
+  level = std::min(std::max(level, 0), 9);
+  std::map<std::string, int>& levels = this->Internals->ArrayCompressionLevels;
+  std::map<std::string, int>::iterator pos = levels.find(name);
+  if (pos == levels.end() || pos->second != level)
+  {
+    levels[name] = level;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFWriter::GetArrayCompressionLevel(const char* name)
+{
+  return name ? this->Internals->GetCompressionLevel(name) : this->CompressionLevel;
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFWriter::RemoveAllArrayCompressionLevels()
+{
+  if (!this->Internals->ArrayCompressionLevels.empty())
+  {
+    this->Internals->ArrayCompressionLevels.clear();
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFWriter::SetInputData(vtkDataObject* input)
+{
+  this->SetInputData(0, input);
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFWriter::SetInputData(int index, vtkDataObject* input)
+{
+  this->SetInputDataInternal(index, input);
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkHDFWriter::GetInput()
+{
+  return this->GetInput(0);
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkHDFWriter::GetInput(int port)
+{
+  if (this->GetNumberOfInputConnections(port) < 1)
+  {
+    return nullptr;
+  }
+  return this->GetExecutive()->GetInputData(port, 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFWriter::Write()
+{
+  // Make sure we have input.
+  if (this->GetNumberOfInputConnections(0) < 1)
+  {
+    vtkErrorMacro("No input provided!");
+    return 0;
+  }
+
+  // always write even if the data hasn't changed
+  this->Modified();
+  this->Update();
+  return this->GetErrorCode() == vtkErrorCode::NoError;
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFWriter::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataObject");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFWriter::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+  {
+    return this->RequestInformation(request, inputVector, outputVector);
+  }
+  if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+  {
+    return this->RequestUpdateExtent(request, inputVector, outputVector);
+  }
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    return this->RequestData(request, inputVector, outputVector);
+  }
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFWriter::RequestInformation(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector*)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  this->NumberOfTimeSteps = 1;
+  if (this->WriteAllTimeSteps && inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    this->NumberOfTimeSteps =
+      std::max(1, inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()));
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFWriter::RequestUpdateExtent(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector*)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+
+  if (this->WriteAllTimeSteps && inInfo->Has(vtkSDDP::TIME_STEPS()))
+  {
+    const double* timeSteps = inInfo->Get(vtkSDDP::TIME_STEPS());
+    inInfo->Set(vtkSDDP::UPDATE_TIME_STEP(), timeSteps[this->CurrentTimeIndex]);
+  }
+
+  if (vtkCompositeDataSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT())))
+  {
+    // Multiblock datasets are written whole.
+    inInfo->Set(vtkSDDP::UPDATE_PIECE_NUMBER(), 0);
+    inInfo->Set(vtkSDDP::UPDATE_NUMBER_OF_PIECES(), 1);
+    inInfo->Set(vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS(), 0);
+  }
+  else if (inInfo->Has(vtkSDDP::WHOLE_EXTENT()))
+  {
+    // Structured pieces are cropped from the whole extent.
+    int extent[6];
+    vtkNew<vtkExtentTranslator> translator;
+    if (translator->PieceToExtentThreadSafe(this->CurrentPiece, this->NumberOfPieces, 0,
+          inInfo->Get(vtkSDDP::WHOLE_EXTENT()), extent, vtkExtentTranslator::BLOCK_MODE, 0))
+    {
+      inInfo->Set(vtkSDDP::UPDATE_EXTENT(), extent, 6);
+    }
+  }
+  else
+  {
+    inInfo->Set(vtkSDDP::UPDATE_PIECE_NUMBER(), this->CurrentPiece);
+    inInfo->Set(vtkSDDP::UPDATE_NUMBER_OF_PIECES(), this->NumberOfPieces);
+    inInfo->Set(vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS(), 0);
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkHDFWriter::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector*)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+  this->SetErrorCode(vtkErrorCode::NoError);
+
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  vtkInternals* internals = this->Internals;
+
+  if (this->CurrentPiece == 0 && this->CurrentTimeIndex == 0)
+  {
+    if (!this->FileName)
+    {
+      this->SetErrorCode(vtkErrorCode::NoFileNameError);
+      vtkErrorMacro("The FileName must be set first.");
+      return 0;
+    }
+    internals->Type = vtkInternals::GetTypeName(input);
+    if (internals->Type.empty() || internals->Type == "None")
+    {
+      vtkErrorMacro("Cannot write data of type " << (input ? input->GetClassName() : "(none)"));
+      return 0;
+    }
+    if (!internals->Open(this->FileName))
+    {
+      this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+      vtkErrorMacro("Cannot create file " << this->FileName);
+      return 0;
+    }
+    this->UpdateProgress(0.0);
+  }
+
+  // Multiblock datasets are not split.
+  bool composite = internals->Type == "MultiBlockDataSet";
+  int numberOfPieces = composite ? 1 : this->NumberOfPieces;
+
+  bool success = true;
+  Handle root(this->CurrentPiece == 0 && this->CurrentTimeIndex == 0
+      ? internals->CreateGroup(internals->File, vtkHDFUtilities::RootName)
+      : H5Gopen2(internals->File, vtkHDFUtilities::RootName, H5P_DEFAULT),
+    H5Gclose);
+  if (this->CurrentPiece == 0 && this->CurrentTimeIndex == 0)
+  {
+    success = root.IsValid() &&
+      vtkHDFUtilities::WriteAttribute(root, "Version", vtkHDFUtilities::Version, 2) &&
+      vtkHDFUtilities::WriteAttribute(root, "Type", internals->Type) &&
+      vtkHDFUtilities::WriteAttribute(root, "NumberOfPieces", &numberOfPieces, 1);
+    if (success && inInfo->Has(vtkSDDP::WHOLE_EXTENT()) && internals->Type == "ImageData")
+    {
+      success = vtkHDFUtilities::WriteAttribute(
+        root, "WholeExtent", inInfo->Get(vtkSDDP::WHOLE_EXTENT()), 6);
+    }
+  }
+
+  std::ostringstream stepName;
+  stepName << "Step" << this->CurrentTimeIndex;
+  if (success && this->CurrentPiece == 0)
+  {
+    double time = 0.0;
+    if (input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+    {
+      time = input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP());
+    }
+    else if (this->WriteAllTimeSteps && inInfo->Has(vtkSDDP::TIME_STEPS()))
+    {
+      time = inInfo->Get(vtkSDDP::TIME_STEPS())[this->CurrentTimeIndex];
+    }
+    internals->TimeValues.push_back(time);
+    Handle step(internals->CreateGroup(root, stepName.str()), H5Gclose);
+    success = step.IsValid();
+  }
+
+  if (success)
+  {
+    Handle step(H5Gopen2(root, stepName.str().c_str(), H5P_DEFAULT), H5Gclose);
+    if (composite)
+    {
+      success = internals->WriteDataObject(step, input, nullptr);
+    }
+    else
+    {
+      std::ostringstream pieceName;
+      pieceName << "Piece" << this->CurrentPiece;
+      Handle piece(internals->CreateGroup(step, pieceName.str()), H5Gclose);
+      int pieceExtent[6];
+      const int* extent = nullptr;
+      if (internals->Type == "ImageData" && inInfo->Has(vtkSDDP::WHOLE_EXTENT()))
+      {
+        vtkNew<vtkExtentTranslator> translator;
+        if (translator->PieceToExtentThreadSafe(this->CurrentPiece, numberOfPieces, 0,
+              inInfo->Get(vtkSDDP::WHOLE_EXTENT()), pieceExtent, vtkExtentTranslator::BLOCK_MODE,
+              0))
+        {
+          extent = pieceExtent;
+        }
+        else
+        {
+          int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+          std::copy(emptyExtent, emptyExtent + 6, pieceExtent);
+          extent = pieceExtent;
+        }
+      }
+      success = piece.IsValid() && internals->WriteDataObject(piece, input, extent);
+    }
+  }
+
+  if (!success)
+  {
+    vtkErrorMacro("Error writing " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+    internals->Close();
+    this->CurrentPiece = 0;
+    this->CurrentTimeIndex = 0;
+    request->Remove(vtkSDDP::CONTINUE_EXECUTING());
+    return 0;
+  }
+
+  this->UpdateProgress(static_cast<double>(this->CurrentTimeIndex * numberOfPieces +
+                         this->CurrentPiece + 1) /
+    (this->NumberOfTimeSteps * numberOfPieces));
+
+  // Loop over the pieces, then over the time steps.
+  if (++this->CurrentPiece < numberOfPieces)
+  {
+    request->Set(vtkSDDP::CONTINUE_EXECUTING(), 1);
+    return 1;
+  }
+  this->CurrentPiece = 0;
+  if (++this->CurrentTimeIndex < this->NumberOfTimeSteps)
+  {
+    request->Set(vtkSDDP::CONTINUE_EXECUTING(), 1);
+    return 1;
+  }
+  request->Remove(vtkSDDP::CONTINUE_EXECUTING());
+  this->CurrentTimeIndex = 0;
+
+  hsize_t numberOfTimeSteps[1] = { internals->TimeValues.size() };
+  success = internals->WriteDataset(root, "TimeValues", H5T_NATIVE_DOUBLE, H5T_NATIVE_DOUBLE,
+    internals->TimeValues.data(), 1, numberOfTimeSteps);
+  internals->Close();
+  if (!success)
+  {
+    vtkErrorMacro("Error writing " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+    return 0;
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkHDFWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << endl;
+  os << indent << "NumberOfPieces: " << this->NumberOfPieces << endl;
+  os << indent << "WriteAllTimeSteps: " << this->WriteAllTimeSteps << endl;
+  os << indent << "ChunkSize: " << this->ChunkSize << endl;
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+  for (std::map<std::string, int>::const_iterator pos =
+         this->Internals->ArrayCompressionLevels.begin();
+       pos != this->Internals->ArrayCompressionLevels.end(); ++pos)
+  {
+    os << indent << "ArrayCompressionLevel " << pos->first << ": " << pos->second << endl;
+  }
+}
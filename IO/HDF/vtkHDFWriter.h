@@ -0,0 +1,188 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkHDFWriter
+ * @brief   Write VTK data into an HDF5 file.
+ *
+ * vtkHDFWriter writes vtkImageData, vtkPolyData, vtkUnstructuredGrid and
+ * vtkMultiBlockDataSet into an HDF5 file. The input may be streamed in
+ * several pieces, and all its time steps may be written to the same file.
+ * Each array is stored in its own HDF5 dataset, which may be chunked and
+ * compressed so that vtkHDFReader can read back selected time steps,
+ * pieces, extents and arrays without going through the rest of the file.
+ *
+ * The file has the following layout, where attributes are prefixed by @:
+ *
+ * \verbatim
+ * /VTKHDF                   @Version int[2], @Type string,
+ *                           @NumberOfPieces int, @WholeExtent int[6] (image)
+ *   TimeValues              double[number of time steps]
+ *   Step<t>/                one group per time step
+ *     Piece<p>/             one dataset group per piece, or
+ *     Block<b>/             one group per block of a multiblock dataset,
+ *                           with @Type and an optional @Name
+ * \endverbatim
+ *
+ * @Type is ImageData, PolyData, UnstructuredGrid or MultiBlockDataSet. A
+ * block group of type MultiBlockDataSet contains Block<b> groups itself and
+ * an empty block has the type None. A dataset group contains:
+ *
+ * \verbatim
+ * image                     @Extent int[6], @Origin double[3],
+ *                           @Spacing double[3]
+ * polydata, grid            Points [points, 3]
+ * polydata                  Verts/, Lines/, Polys/, Strips/, each with
+ *                           Offsets int64[cells + 1], Connectivity int64[]
+ * grid                      Types uint8[cells], Offsets int64[cells + 1],
+ *                           Connectivity int64[], and for polyhedra
+ *                           FaceLocations int64[cells], Faces int64[]
+ * all                       PointData/, CellData/, FieldData/
+ * \endverbatim
+ *
+ * Each array of PointData/, CellData/ and FieldData/ is an HDF5 dataset of
+ * shape [tuples] or [tuples, components], or for the point and cell data of
+ * images [z, y, x] or [z, y, x, components]. Its @VTKType attribute holds
+ * the VTK data type, and the @Scalars, @Vectors, @Normals, @TCoords and
+ * @Tensors attributes of the group name the active attributes. Arrays that
+ * are not vtkDataArray are not written.
+ *
+ * Image pieces are split from the whole extent with vtkExtentTranslator and
+ * cropped from the input. The pieces of other datasets are requested from
+ * the pipeline. Multiblock datasets are written as a single piece.
+ *
+ * @sa
+ * vtkHDFReader
+ */
+
+#ifndef vtkHDFWriter_h
+#define vtkHDFWriter_h
+
+#include "vtkAlgorithm.h"
+#include "vtkIOHDFModule.h" // For export macro
+
+class VTKIOHDF_EXPORT vtkHDFWriter : public vtkAlgorithm
+{
+public:
+  static vtkHDFWriter* New();
+  vtkTypeMacro(vtkHDFWriter, vtkAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Get/Set the name of the output file.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the number of pieces into which the input is split. Defaults
+   * to 1.
+   */
+  vtkSetClampMacro(NumberOfPieces, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPieces, int);
+  //@}
+
+  //@{
+  /**
+   * When on, all the time steps reported by the input are written, one
+   * after another. Otherwise only the current one is. Defaults to off.
+   */
+  vtkSetMacro(WriteAllTimeSteps, vtkTypeBool);
+  vtkGetMacro(WriteAllTimeSteps, vtkTypeBool);
+  vtkBooleanMacro(WriteAllTimeSteps, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the number of tuples in each chunk of the datasets. Image
+   * arrays are chunked in whole rows and slices when possible. 0 stores
+   * uncompressed arrays contiguously. Defaults to 65536.
+   */
+  vtkSetClampMacro(ChunkSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(ChunkSize, int);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the deflate compression level, from 0 (no compression) to 9.
+   * Defaults to 0.
+   */
+  vtkSetClampMacro(CompressionLevel, int, 0, 9);
+  vtkGetMacro(CompressionLevel, int);
+  //@}
+
+  //@{
+  /**
+   * Override the compression level for the arrays of the given name. The
+   * name may also be one of Points, Connectivity, Offsets, Types, Faces
+   * and FaceLocations.
+   */
+  void SetArrayCompressionLevel(const char* name, int level);
+  int GetArrayCompressionLevel(const char* name);
+  void RemoveAllArrayCompressionLevels();
+  //@}
+
+  //@{
+  /**
+   * Assign a data object as input.
+   */
+  void SetInputData(vtkDataObject*);
+  void SetInputData(int, vtkDataObject*);
+  vtkDataObject* GetInput();
+  vtkDataObject* GetInput(int port);
+  //@}
+
+  /**
+   * Write the file. Returns 1 on success and 0 on failure.
+   */
+  int Write();
+
+  /**
+   * See vtkAlgorithm for details.
+   */
+  int ProcessRequest(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+protected:
+  vtkHDFWriter();
+  ~vtkHDFWriter() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+  virtual int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+  virtual int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
+
+  char* FileName;
+  int NumberOfPieces;
+  vtkTypeBool WriteAllTimeSteps;
+  int ChunkSize;
+  int CompressionLevel;
+
+  int CurrentPiece;
+  int CurrentTimeIndex;
+  int NumberOfTimeSteps;
+
+private:
+  vtkHDFWriter(const vtkHDFWriter&) = delete;
+  void operator=(const vtkHDFWriter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
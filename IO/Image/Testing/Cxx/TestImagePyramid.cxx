@@ -0,0 +1,279 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImagePyramid.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests vtkImagePyramidWriter and vtkImagePyramidReader: each level must
+// match the reduction of the previous level, and sub-extents must read just
+// the tiles they need.
+
+#include "vtkImageAppendComponents.h"
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkImageNoiseSource.h"
+#include "vtkImagePyramidReader.h"
+#include "vtkImagePyramidWriter.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+
+namespace
+{
+
+// Random values, with a fixed seed so that the test is repeatable.
+vtkSmartPointer<vtkImageData> MakeImage(int scalarType, int components, int range)
+{
+  vtkMath::RandomSeed(4567);
+  vtkNew<vtkImageAppendComponents> append;
+  for (int c = 0; c < components; c++)
+  {
+    vtkNew<vtkImageNoiseSource> noise;
+    noise->SetWholeExtent(-5, 31, 2, 24, 3, 13);
+    noise->SetMinimum(0.0);
+    noise->SetMaximum(range);
+    append->AddInputConnection(noise->GetOutputPort());
+  }
+
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputConnection(append->GetOutputPort());
+  cast->SetOutputScalarType(scalarType);
+  cast->Update();
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->ShallowCopy(cast->GetOutput());
+  image->SetSpacing(0.5, 0.75, 2.0);
+  image->SetOrigin(1.0, 2.0, -3.0);
+  return image;
+}
+
+// Reduce an image by brute force, as the writer should do.
+vtkSmartPointer<vtkImageData> Reduce(vtkImageData* image, int mode)
+{
+  int* inExt = image->GetExtent();
+  int ext[6];
+  for (int i = 0; i < 6; i += 2)
+  {
+    ext[i] = inExt[i];
+    ext[i + 1] = inExt[i] + (inExt[i + 1] - inExt[i]) / 2;
+  }
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->SetExtent(ext);
+  output->SetSpacing(image->GetSpacing()[0] * 2, image->GetSpacing()[1] * 2,
+    image->GetSpacing()[2] * 2);
+  output->AllocateScalars(image->GetScalarType(), image->GetNumberOfScalarComponents());
+  bool isInteger = (image->GetScalarType() != VTK_FLOAT && image->GetScalarType() != VTK_DOUBLE);
+
+  for (int z = ext[4]; z <= ext[5]; z++)
+  {
+    for (int y = ext[2]; y <= ext[3]; y++)
+    {
+      for (int x = ext[0]; x <= ext[1]; x++)
+      {
+        for (int c = 0; c < image->GetNumberOfScalarComponents(); c++)
+        {
+          double sum = 0.0;
+          double maximum = -VTK_DOUBLE_MAX;
+          std::map<double, int> counts;
+          int n = 0;
+          // voxel x covers voxels m + 2(x - m) and m + 2(x - m) + 1
+          int k0 = 2 * z - ext[4];
+          int j0 = 2 * y - ext[2];
+          int i0 = 2 * x - ext[0];
+          for (int k = k0; k <= std::min(k0 + 1, inExt[5]); k++)
+          {
+            for (int j = j0; j <= std::min(j0 + 1, inExt[3]); j++)
+            {
+              for (int i = i0; i <= std::min(i0 + 1, inExt[1]); i++)
+              {
+                double v = image->GetScalarComponentAsDouble(i, j, k, c);
+                sum += v;
+                maximum = std::max(maximum, v);
+                counts[v]++;
+                n++;
+              }
+            }
+          }
+          double value = sum / n;
+          if (isInteger)
+          {
+            value = std::floor(value + 0.5);
+          }
+          if (mode == vtkImagePyramidWriter::Maximum)
+          {
+            value = maximum;
+          }
+          else if (mode == vtkImagePyramidWriter::Mode)
+          {
+            int best = 0;
+            for (auto& count : counts)
+            {
+              if (count.second > best)
+              {
+                value = count.first;
+                best = count.second;
+              }
+            }
+          }
+          output->SetScalarComponentFromDouble(x, y, z, c, value);
+        }
+      }
+    }
+  }
+  return output;
+}
+
+bool SameVoxels(vtkImageData* a, vtkImageData* b, const int extent[6])
+{
+  for (int z = extent[4]; z <= extent[5]; z++)
+  {
+    for (int y = extent[2]; y <= extent[3]; y++)
+    {
+      for (int x = extent[0]; x <= extent[1]; x++)
+      {
+        for (int c = 0; c < a->GetNumberOfScalarComponents(); c++)
+        {
+          if (a->GetScalarComponentAsDouble(x, y, z, c) !=
+            b->GetScalarComponentAsDouble(x, y, z, c))
+          {
+            cerr << "Voxel (" << x << ", " << y << ", " << z << ") differs: "
+                 << a->GetScalarComponentAsDouble(x, y, z, c)
+                 << " != " << b->GetScalarComponentAsDouble(x, y, z, c) << endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Check every level of the pyramid against the brute force reduction.
+bool CheckLevels(vtkImageData* image, const std::string& fileName, int mode)
+{
+  vtkNew<vtkImagePyramidWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetTileSize(8, 8, 4);
+  writer->SetReductionMode(mode);
+  writer->Write();
+
+  vtkNew<vtkImagePyramidReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  int numLevels = reader->GetNumberOfLevels();
+  if (!reader->CanReadFile(fileName.c_str()) || numLevels < 2)
+  {
+    cerr << "Could not read the pyramid with " << writer->GetReductionModeAsString() << endl;
+    return false;
+  }
+
+  vtkSmartPointer<vtkImageData> expected = image;
+  for (int level = 0; level < numLevels; level++)
+  {
+    if (level > 0)
+    {
+      expected = Reduce(expected, mode);
+    }
+    reader->SetLevel(level);
+    reader->Update();
+    vtkImageData* output = reader->GetOutput();
+    int* ext = output->GetExtent();
+    int* expectedExt = expected->GetExtent();
+    double spacing = image->GetSpacing()[0] * (1 << level);
+    double origin = image->GetOrigin()[0] +
+      image->GetSpacing()[0] * ((1 << level) - 1) * (0.5 - image->GetExtent()[0]);
+    if (!std::equal(ext, ext + 6, expectedExt) || output->GetSpacing()[0] != spacing ||
+      std::fabs(output->GetOrigin()[0] - origin) > 1e-12 ||
+      output->GetScalarType() != image->GetScalarType() || !SameVoxels(output, expected, ext))
+    {
+      cerr << "Level " << level << " is wrong for " << writer->GetReductionModeAsString()
+           << endl;
+      return false;
+    }
+    // the coarsest level must fit in a single tile
+    if (level == numLevels - 1 &&
+      (ext[1] - ext[0] >= 8 || ext[3] - ext[2] >= 8 || ext[5] - ext[4] >= 4))
+    {
+      cerr << "The coarsest level spans several tiles." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Check that sub-extents only read the tiles they need.
+bool CheckTiles(vtkImageData* image, const std::string& fileName)
+{
+  vtkNew<vtkImagePyramidReader> reader;
+  reader->SetFileName(fileName.c_str());
+
+  // the tiles start at (-5, 2, 3), this extent needs tiles 0 and 1 along X,
+  // and tile 1 along Y and Z
+  int extent[6] = { 0, 9, 10, 15, 7, 10 };
+  reader->UpdateExtent(extent);
+  if (reader->GetNumberOfTilesRead() != 2 || !SameVoxels(reader->GetOutput(), image, extent))
+  {
+    cerr << "Wrong sub-extent, " << reader->GetNumberOfTilesRead() << " tiles read." << endl;
+    return false;
+  }
+
+  // one new tile along X, the other two tiles are cached
+  int extent2[6] = { -1, 17, 11, 12, 8, 8 };
+  reader->UpdateExtent(extent2);
+  if (reader->GetNumberOfTilesRead() != 3 || !SameVoxels(reader->GetOutput(), image, extent2))
+  {
+    cerr << "Wrong cached sub-extent, " << reader->GetNumberOfTilesRead() << " tiles read."
+         << endl;
+    return false;
+  }
+
+  // without a cache, all three tiles are read again
+  reader->SetTileCacheSize(0);
+  reader->ClearTileCache();
+  reader->Modified();
+  reader->UpdateExtent(extent2);
+  if (reader->GetNumberOfTilesRead() != 6 || !SameVoxels(reader->GetOutput(), image, extent2))
+  {
+    cerr << "Wrong uncached sub-extent, " << reader->GetNumberOfTilesRead() << " tiles read."
+         << endl;
+    return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int TestImagePyramid(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestImagePyramid.pyr";
+  delete[] tempDir;
+
+  vtkSmartPointer<vtkImageData> intensities = MakeImage(VTK_SHORT, 2, 1000);
+  vtkSmartPointer<vtkImageData> floats = MakeImage(VTK_FLOAT, 1, 1000);
+  vtkSmartPointer<vtkImageData> labels = MakeImage(VTK_UNSIGNED_CHAR, 1, 4);
+
+  bool valid = CheckLevels(intensities, fileName, vtkImagePyramidWriter::Mean);
+  valid &= CheckLevels(floats, fileName, vtkImagePyramidWriter::Mean);
+  valid &= CheckLevels(intensities, fileName, vtkImagePyramidWriter::Maximum);
+  valid &= CheckLevels(labels, fileName, vtkImagePyramidWriter::Mode);
+  valid &= CheckTiles(labels, fileName);
+
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,261 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImagePyramidPrivate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// The file layout shared by vtkImagePyramidWriter and vtkImagePyramidReader.
+//
+// A pyramid file starts with this header, in the byte order of the machine
+// that wrote it (the byte order field tells the reader whether to swap):
+//
+//   char[8]   "vtkpyr01"
+//   int32     byte order, always 1
+//   int32     scalar type, number of components
+//   int32     reduction mode, number of levels
+//   int32[6]  extent of level 0
+//   int32[3]  tile size
+//   int32[4]  reserved
+//   double[3] spacing of level 0
+//   double[3] origin of level 0
+//   uint64[]  file offset of each tile, level by level
+//
+// All levels start at the minimum index m of the extent of level 0.  The
+// voxels of level l+1 are computed from the blocks of 2x2x2 voxels of level
+// l (fewer at the edges), voxel i covering voxels m+2(i-m) and m+2(i-m)+1.
+// The tiles of each level start at m and are clipped to the extent of the
+// level.  Within a level the tiles are ordered with X varying fastest, and
+// the voxels of a tile are stored in the same order as in vtkImageData.
+
+#ifndef vtkImagePyramidPrivate_h
+#define vtkImagePyramidPrivate_h
+
+#include "vtkByteSwap.h"
+#include "vtkType.h"
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+struct vtkImagePyramidHeader
+{
+  int ScalarType;
+  int NumberOfComponents;
+  int ReductionMode;
+  int NumberOfLevels;
+  int Extent[6];
+  int TileSize[3];
+  double Spacing[3];
+  double Origin[3];
+  std::vector<vtkTypeUInt64> TileOffsets;
+
+  // The extent, spacing and origin of the given level.
+  void GetLevelExtent(int level, int extent[6]) const
+  {
+    for (int i = 0; i < 6; i += 2)
+    {
+      extent[i] = this->Extent[i];
+      extent[i + 1] = this->Extent[i] + ((this->Extent[i + 1] - this->Extent[i]) >> level);
+    }
+  }
+
+  void GetLevelSpacing(int level, double spacing[3]) const
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      spacing[i] = this->Spacing[i] * (1 << level);
+    }
+  }
+
+  void GetLevelOrigin(int level, double origin[3]) const
+  {
+    // each voxel lies at the center of the voxels it was computed from
+    for (int i = 0; i < 3; i++)
+    {
+      origin[i] =
+        this->Origin[i] + this->Spacing[i] * ((1 << level) - 1) * (0.5 - this->Extent[2 * i]);
+    }
+  }
+
+  // The range of tile indices that cover an extent of a level.
+  void GetTileRange(const int extent[6], int range[6]) const
+  {
+    for (int i = 0; i < 6; i++)
+    {
+      range[i] = (extent[i] - this->Extent[i & ~1]) / this->TileSize[i / 2];
+    }
+  }
+
+  void GetTileRange(int level, int range[6]) const
+  {
+    int extent[6];
+    this->GetLevelExtent(level, extent);
+    this->GetTileRange(extent, range);
+  }
+
+  // The extent of a tile, clipped to the extent of its level.
+  void GetTileExtent(int level, const int tile[3], int extent[6]) const
+  {
+    int levelExtent[6];
+    this->GetLevelExtent(level, levelExtent);
+    for (int i = 0; i < 3; i++)
+    {
+      int lo = this->Extent[2 * i] + tile[i] * this->TileSize[i];
+      int hi = lo + this->TileSize[i] - 1;
+      extent[2 * i] = (lo > levelExtent[2 * i] ? lo : levelExtent[2 * i]);
+      extent[2 * i + 1] = (hi < levelExtent[2 * i + 1] ? hi : levelExtent[2 * i + 1]);
+    }
+  }
+
+  vtkIdType GetNumberOfTiles(int level) const
+  {
+    int range[6];
+    this->GetTileRange(level, range);
+    return static_cast<vtkIdType>(range[1] - range[0] + 1) * (range[3] - range[2] + 1) *
+      (range[5] - range[4] + 1);
+  }
+
+  // The position of a tile in the table of offsets.
+  vtkIdType GetTileIndex(int level, const int tile[3]) const
+  {
+    vtkIdType index = 0;
+    for (int l = 0; l < level; l++)
+    {
+      index += this->GetNumberOfTiles(l);
+    }
+    int range[6];
+    this->GetTileRange(level, range);
+    vtkIdType nx = range[1] - range[0] + 1;
+    vtkIdType ny = range[3] - range[2] + 1;
+    return index + (tile[2] * ny + tile[1]) * nx + tile[0];
+  }
+
+  vtkIdType GetTotalNumberOfTiles() const
+  {
+    vtkIdType n = 0;
+    for (int l = 0; l < this->NumberOfLevels; l++)
+    {
+      n += this->GetNumberOfTiles(l);
+    }
+    return n;
+  }
+
+  // The size of the header, including the table of offsets.
+  vtkTypeUInt64 GetHeaderSize() const
+  {
+    return 8 + 4 * 18 + 8 * 6 + 8 * static_cast<vtkTypeUInt64>(this->GetTotalNumberOfTiles());
+  }
+
+  bool Write(std::ostream& os) const
+  {
+    int ints[18] = { 1, this->ScalarType, this->NumberOfComponents, this->ReductionMode,
+      this->NumberOfLevels };
+    for (int i = 0; i < 6; i++)
+    {
+      ints[5 + i] = this->Extent[i];
+    }
+    for (int i = 0; i < 3; i++)
+    {
+      ints[11 + i] = this->TileSize[i];
+    }
+    double doubles[6] = { this->Spacing[0], this->Spacing[1], this->Spacing[2],
+      this->Origin[0], this->Origin[1], this->Origin[2] };
+    os.write("vtkpyr01", 8);
+    os.write(reinterpret_cast<const char*>(ints), sizeof(ints));
+    os.write(reinterpret_cast<const char*>(doubles), sizeof(doubles));
+    if (!this->TileOffsets.empty())
+    {
+      os.write(reinterpret_cast<const char*>(this->TileOffsets.data()),
+        8 * this->TileOffsets.size());
+    }
+    return !os.fail();
+  }
+
+  // Read the header, and report whether the data must be byte swapped.
+  bool Read(std::istream& is, bool& swap)
+  {
+    char magic[8];
+    int ints[18];
+    double doubles[6];
+    is.read(magic, 8);
+    is.read(reinterpret_cast<char*>(ints), sizeof(ints));
+    is.read(reinterpret_cast<char*>(doubles), sizeof(doubles));
+    if (is.fail() || strncmp(magic, "vtkpyr01", 8) != 0)
+    {
+      return false;
+    }
+    swap = (ints[0] != 1);
+    if (swap)
+    {
+      vtkByteSwap::SwapVoidRange(ints, 18, 4);
+      vtkByteSwap::SwapVoidRange(doubles, 6, 8);
+      if (ints[0] != 1)
+      {
+        return false;
+      }
+    }
+    this->ScalarType = ints[1];
+    this->NumberOfComponents = ints[2];
+    this->ReductionMode = ints[3];
+    this->NumberOfLevels = ints[4];
+    for (int i = 0; i < 6; i++)
+    {
+      this->Extent[i] = ints[5 + i];
+    }
+    for (int i = 0; i < 3; i++)
+    {
+      this->TileSize[i] = ints[11 + i];
+      this->Spacing[i] = doubles[i];
+      this->Origin[i] = doubles[3 + i];
+    }
+    if (this->NumberOfComponents < 1 || this->NumberOfLevels < 1 ||
+      this->NumberOfLevels > 31 || this->TileSize[0] < 1 || this->TileSize[1] < 1 ||
+      this->TileSize[2] < 1 || this->Extent[0] > this->Extent[1] ||
+      this->Extent[2] > this->Extent[3] || this->Extent[4] > this->Extent[5])
+    {
+      return false;
+    }
+    this->TileOffsets.resize(this->GetTotalNumberOfTiles());
+    is.read(reinterpret_cast<char*>(this->TileOffsets.data()), 8 * this->TileOffsets.size());
+    if (swap)
+    {
+      vtkByteSwap::SwapVoidRange(this->TileOffsets.data(), this->TileOffsets.size(), 8);
+    }
+    return !is.fail();
+  }
+};
+
+// Copy the voxels of an extent from one block of voxels to another, where
+// each block covers the given extent and has voxels of the given size.
+inline void vtkImagePyramidCopyExtent(const char* src, const int srcExt[6], char* dst,
+  const int dstExt[6], const int extent[6], int voxelSize)
+{
+  size_t rowSize = static_cast<size_t>(extent[1] - extent[0] + 1) * voxelSize;
+  vtkIdType srcIncY = static_cast<vtkIdType>(srcExt[1] - srcExt[0] + 1) * voxelSize;
+  vtkIdType srcIncZ = srcIncY * (srcExt[3] - srcExt[2] + 1);
+  vtkIdType dstIncY = static_cast<vtkIdType>(dstExt[1] - dstExt[0] + 1) * voxelSize;
+  vtkIdType dstIncZ = dstIncY * (dstExt[3] - dstExt[2] + 1);
+  for (int z = extent[4]; z <= extent[5]; z++)
+  {
+    for (int y = extent[2]; y <= extent[3]; y++)
+    {
+      memcpy(dst + (z - dstExt[4]) * dstIncZ + (y - dstExt[2]) * dstIncY +
+          static_cast<vtkIdType>(extent[0] - dstExt[0]) * voxelSize,
+        src + (z - srcExt[4]) * srcIncZ + (y - srcExt[2]) * srcIncY +
+          static_cast<vtkIdType>(extent[0] - srcExt[0]) * voxelSize,
+        rowSize);
+    }
+  }
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImagePyramidPrivate.h
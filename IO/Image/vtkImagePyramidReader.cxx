@@ -0,0 +1,314 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImagePyramidReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImagePyramidReader.h"
+
+#include "vtkDataArray.h"
+#include "vtkErrorCode.h"
+#include "vtkImageData.h"
+#include "vtkImagePyramidPrivate.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <fstream>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkImagePyramidReader);
+
+//----------------------------------------------------------------------------
+// The open file, its header, and the cache of tiles.
+class vtkImagePyramidReaderInternals
+{
+public:
+  struct Tile
+  {
+    vtkIdType Index;
+    std::vector<char> Data;
+  };
+
+  vtkImagePyramidHeader Header;
+  bool Swap = false;
+  std::string FileName;
+  long ModifiedTime = 0;
+  std::ifstream File;
+
+  // the tiles, the most recently used first
+  std::list<Tile> Tiles;
+  std::map<vtkIdType, std::list<Tile>::iterator> TileMap;
+  size_t CacheSize = 0;
+
+  // Open the file and read its header, unless it is already open.
+  bool Open(const char* fileName);
+
+  // Get a tile, from the cache if possible. The returned data is only
+  // valid until the next call.
+  const std::vector<char>* GetTile(
+    int level, const int tile[3], size_t maxCacheSize, vtkIdType& numberOfReads);
+
+  void Close();
+  void Clear();
+};
+
+//----------------------------------------------------------------------------
+bool vtkImagePyramidReaderInternals::Open(const char* fileName)
+{
+  // the cache is kept unless the file has changed
+  long modifiedTime = vtksys::SystemTools::ModifiedTime(fileName);
+  if (this->File.is_open() && this->FileName == fileName && this->ModifiedTime == modifiedTime)
+  {
+    return true;
+  }
+
+  this->Close();
+  this->File.open(fileName, ios::in | ios::binary);
+  if (!this->File.is_open() || !this->Header.Read(this->File, this->Swap) ||
+    vtkDataArray::GetDataTypeSize(this->Header.ScalarType) == 0)
+  {
+    this->Close();
+    return false;
+  }
+  this->FileName = fileName;
+  this->ModifiedTime = modifiedTime;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+const std::vector<char>* vtkImagePyramidReaderInternals::GetTile(
+  int level, const int tile[3], size_t maxCacheSize, vtkIdType& numberOfReads)
+{
+  vtkIdType index = this->Header.GetTileIndex(level, tile);
+  auto found = this->TileMap.find(index);
+  if (found != this->TileMap.end())
+  {
+    this->Tiles.splice(this->Tiles.begin(), this->Tiles, found->second);
+    return &this->Tiles.front().Data;
+  }
+
+  int extent[6];
+  this->Header.GetTileExtent(level, tile, extent);
+  int wordSize = vtkDataArray::GetDataTypeSize(this->Header.ScalarType);
+  size_t numWords = static_cast<size_t>(extent[1] - extent[0] + 1) *
+    (extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1) * this->Header.NumberOfComponents;
+  size_t size = numWords * wordSize;
+
+  // drop the least recently used tiles to make room for the new tile
+  while (!this->Tiles.empty() && this->CacheSize + size > maxCacheSize)
+  {
+    this->CacheSize -= this->Tiles.back().Data.size();
+    this->TileMap.erase(this->Tiles.back().Index);
+    this->Tiles.pop_back();
+  }
+
+  this->Tiles.push_front(Tile());
+  Tile& newTile = this->Tiles.front();
+  newTile.Index = index;
+  newTile.Data.resize(size);
+  this->File.clear();
+  this->File.seekg(this->Header.TileOffsets[index]);
+  this->File.read(newTile.Data.data(), size);
+  if (this->File.fail())
+  {
+    this->Tiles.pop_front();
+    return nullptr;
+  }
+  if (this->Swap && wordSize > 1)
+  {
+    vtkByteSwap::SwapVoidRange(newTile.Data.data(), numWords, wordSize);
+  }
+  this->TileMap[index] = this->Tiles.begin();
+  this->CacheSize += size;
+  numberOfReads++;
+
+  return &newTile.Data;
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePyramidReaderInternals::Close()
+{
+  if (this->File.is_open())
+  {
+    this->File.close();
+  }
+  this->File.clear();
+  this->FileName.clear();
+  this->Clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePyramidReaderInternals::Clear()
+{
+  this->Tiles.clear();
+  this->TileMap.clear();
+  this->CacheSize = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkImagePyramidReader::vtkImagePyramidReader()
+{
+  this->FileName = nullptr;
+  this->Level = 0;
+  this->TileCacheSize = 262144;
+  this->NumberOfTilesRead = 0;
+  this->Internals = new vtkImagePyramidReaderInternals;
+  this->SetNumberOfInputPorts(0);
+}
+
+//----------------------------------------------------------------------------
+vtkImagePyramidReader::~vtkImagePyramidReader()
+{
+  this->SetFileName(nullptr);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePyramidReader::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "Level: " << this->Level << "\n";
+  os << indent << "TileCacheSize: " << this->TileCacheSize << "\n";
+  os << indent << "NumberOfTilesRead: " << this->NumberOfTilesRead << "\n";
+}
+
+//----------------------------------------------------------------------------
+int vtkImagePyramidReader::CanReadFile(const char* filename)
+{
+  std::ifstream file(filename, ios::in | ios::binary);
+  char magic[8];
+  file.read(magic, 8);
+  return (!file.fail() && strncmp(magic, "vtkpyr01", 8) == 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkImagePyramidReader::GetNumberOfLevels()
+{
+  return (this->Internals->File.is_open() ? this->Internals->Header.NumberOfLevels : 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePyramidReader::GetTileSize(int tileSize[3])
+{
+  for (int i = 0; i < 3; i++)
+  {
+    tileSize[i] = (this->Internals->File.is_open() ? this->Internals->Header.TileSize[i] : 0);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePyramidReader::ClearTileCache()
+{
+  this->Internals->Clear();
+}
+
+//----------------------------------------------------------------------------
+int vtkImagePyramidReader::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
+{
+  this->SetErrorCode(vtkErrorCode::NoError);
+
+  if (!this->FileName)
+  {
+    vtkErrorMacro("A FileName must be specified.");
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return 0;
+  }
+  if (!this->Internals->Open(this->FileName))
+  {
+    vtkErrorMacro("Could not read pyramid file " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::FileFormatError);
+    return 0;
+  }
+
+  const vtkImagePyramidHeader& header = this->Internals->Header;
+  int level = std::min(this->Level, header.NumberOfLevels - 1);
+  int extent[6];
+  double spacing[3];
+  double origin[3];
+  header.GetLevelExtent(level, extent);
+  header.GetLevelSpacing(level, spacing);
+  header.GetLevelOrigin(level, origin);
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+  outInfo->Set(vtkDataObject::SPACING(), spacing, 3);
+  outInfo->Set(vtkDataObject::ORIGIN(), origin, 3);
+  outInfo->Set(vtkAlgorithm::CAN_PRODUCE_SUB_EXTENT(), 1);
+  vtkDataObject::SetPointDataActiveScalarInfo(
+    outInfo, header.ScalarType, header.NumberOfComponents);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImagePyramidReader::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* output = vtkImageData::GetData(outInfo);
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  this->AllocateOutputData(output, outInfo, outExt);
+  if (outExt[0] > outExt[1] || outExt[2] > outExt[3] || outExt[4] > outExt[5])
+  {
+    return 1;
+  }
+
+  const vtkImagePyramidHeader& header = this->Internals->Header;
+  int level = std::min(this->Level, header.NumberOfLevels - 1);
+  int voxelSize = output->GetScalarSize() * header.NumberOfComponents;
+  size_t maxCacheSize = static_cast<size_t>(std::max(this->TileCacheSize, vtkIdType(0))) * 1024;
+  char* outPtr = static_cast<char*>(output->GetScalarPointer());
+
+  int tile[3];
+  int range[6];
+  header.GetTileRange(outExt, range);
+  for (tile[2] = range[4]; tile[2] <= range[5]; tile[2]++)
+  {
+    for (tile[1] = range[2]; tile[1] <= range[3]; tile[1]++)
+    {
+      for (tile[0] = range[0]; tile[0] <= range[1]; tile[0]++)
+      {
+        const std::vector<char>* data =
+          this->Internals->GetTile(level, tile, maxCacheSize, this->NumberOfTilesRead);
+        if (!data)
+        {
+          vtkErrorMacro("Could not read tile from " << this->FileName);
+          this->SetErrorCode(vtkErrorCode::PrematureEndOfFileError);
+          return 0;
+        }
+        int tileExt[6];
+        header.GetTileExtent(level, tile, tileExt);
+        int copyExt[6];
+        for (int i = 0; i < 3; i++)
+        {
+          copyExt[2 * i] = std::max(tileExt[2 * i], outExt[2 * i]);
+          copyExt[2 * i + 1] = std::min(tileExt[2 * i + 1], outExt[2 * i + 1]);
+        }
+        vtkImagePyramidCopyExtent(data->data(), tileExt, outPtr, outExt, copyExt, voxelSize);
+      }
+    }
+    this->UpdateProgress(static_cast<double>(tile[2] - range[4] + 1) / (range[5] - range[4] + 1));
+  }
+
+  return 1;
+}
@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImagePyramidReader.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImagePyramidReader
+ * @brief   Read one level of a tiled, multi-resolution pyramid.
+ *
+ * vtkImagePyramidReader reads the files written by vtkImagePyramidWriter.
+ * The output is the level chosen with SetLevel(), level 0 being the full
+ * resolution image and each following level having half the resolution
+ * (and twice the spacing) of the previous one. The reader can produce any
+ * sub-extent of the level, and reads only the tiles that intersect the
+ * update extent, so that images much larger than memory can be sliced
+ * interactively, or rendered from a coarse level while a finer one is
+ * loaded.
+ *
+ * The tiles that have been read are kept in a cache, and the least recently
+ * used tiles are dropped when the cache grows larger than TileCacheSize.
+ * Since the cache is kept when the level or the update extent changes,
+ * moving back and forth through a volume does not read the same tiles
+ * again.
+ *
+ * @sa
+ * vtkImagePyramidWriter
+ */
+
+#ifndef vtkImagePyramidReader_h
+#define vtkImagePyramidReader_h
+
+#include "vtkIOImageModule.h" // For export macro
+#include "vtkImageAlgorithm.h"
+
+class vtkImagePyramidReaderInternals;
+
+class VTKIOIMAGE_EXPORT vtkImagePyramidReader : public vtkImageAlgorithm
+{
+public:
+  static vtkImagePyramidReader* New();
+  vtkTypeMacro(vtkImagePyramidReader, vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Specify the name of the file to read.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  //@}
+
+  /**
+   * Return true if the file looks like a pyramid file.
+   */
+  virtual int CanReadFile(const char* filename);
+
+  //@{
+  /**
+   * Set/Get the level to read, zero for full resolution. Levels beyond the
+   * coarsest level of the file give the coarsest level.
+   */
+  vtkSetClampMacro(Level, int, 0, 30);
+  vtkGetMacro(Level, int);
+  //@}
+
+  /**
+   * Get the number of levels in the file. This is only valid after
+   * UpdateInformation() has been called.
+   */
+  int GetNumberOfLevels();
+
+  /**
+   * Get the size of the tiles of the file. This is only valid after
+   * UpdateInformation() has been called.
+   */
+  void GetTileSize(int tileSize[3]);
+
+  //@{
+  /**
+   * Set/Get the maximum size of the tile cache, in kibibytes. The tiles
+   * needed for the current update are always read, even if they do not fit
+   * within the cache. The default is 262144 (256 MiB).
+   */
+  vtkSetMacro(TileCacheSize, vtkIdType);
+  vtkGetMacro(TileCacheSize, vtkIdType);
+  //@}
+
+  /**
+   * Drop all the tiles from the cache.
+   */
+  void ClearTileCache();
+
+  /**
+   * Get the number of tiles that have been read from the file since the
+   * reader was created. This tells how effective the cache is.
+   */
+  vtkGetMacro(NumberOfTilesRead, vtkIdType);
+
+protected:
+  vtkImagePyramidReader();
+  ~vtkImagePyramidReader() override;
+
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  char* FileName;
+  int Level;
+  vtkIdType TileCacheSize;
+  vtkIdType NumberOfTilesRead;
+
+private:
+  vtkImagePyramidReader(const vtkImagePyramidReader&) = delete;
+  void operator=(const vtkImagePyramidReader&) = delete;
+
+  vtkImagePyramidReaderInternals* Internals;
+};
+
+#endif
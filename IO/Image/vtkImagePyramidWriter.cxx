@@ -0,0 +1,461 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImagePyramidWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImagePyramidWriter.h"
+
+#include "vtkCommand.h"
+#include "vtkErrorCode.h"
+#include "vtkImageData.h"
+#include "vtkImagePyramidPrivate.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+vtkStandardNewMacro(vtkImagePyramidWriter);
+
+//----------------------------------------------------------------------------
+vtkImagePyramidWriter::vtkImagePyramidWriter()
+{
+  this->FileName = nullptr;
+  this->TileSize[0] = 64;
+  this->TileSize[1] = 64;
+  this->TileSize[2] = 64;
+  this->NumberOfLevels = 0;
+  this->ReductionMode = Mean;
+  this->SetNumberOfOutputPorts(0);
+}
+
+//----------------------------------------------------------------------------
+vtkImagePyramidWriter::~vtkImagePyramidWriter()
+{
+  this->SetFileName(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePyramidWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "TileSize: " << this->TileSize[0] << " " << this->TileSize[1] << " "
+     << this->TileSize[2] << "\n";
+  os << indent << "NumberOfLevels: " << this->NumberOfLevels << "\n";
+  os << indent << "ReductionMode: " << this->GetReductionModeAsString() << "\n";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkImagePyramidWriter::GetReductionModeAsString()
+{
+  switch (this->ReductionMode)
+  {
+    case Mean:
+      return "Mean";
+    case Maximum:
+      return "Maximum";
+    case Mode:
+      return "Mode";
+  }
+  return "";
+}
+
+//----------------------------------------------------------------------------
+vtkImageData* vtkImagePyramidWriter::GetInput()
+{
+  if (this->GetNumberOfInputConnections(0) < 1)
+  {
+    return nullptr;
+  }
+  return vtkImageData::SafeDownCast(this->GetExecutive()->GetInputData(0, 0));
+}
+
+//----------------------------------------------------------------------------
+void vtkImagePyramidWriter::Write()
+{
+  // we always write, even if nothing has changed, so send a modified
+  this->Modified();
+  this->UpdateWholeExtent();
+}
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// The extent of one row of tiles of level 0, i.e. all the tiles with the
+// given Y and Z tile indices.
+void vtkImagePyramidRowExtent(const vtkImagePyramidHeader& header, int ty, int tz, int extent[6])
+{
+  int tile[3] = { 0, ty, tz };
+  header.GetTileExtent(0, tile, extent);
+  extent[0] = header.Extent[0];
+  extent[1] = header.Extent[1];
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+inline void vtkImagePyramidMean(const T* values, int n, T* outPtr)
+{
+  double sum = 0.0;
+  for (int i = 0; i < n; i++)
+  {
+    sum += values[i];
+  }
+  double mean = sum / n;
+  if (std::numeric_limits<T>::is_integer)
+  {
+    mean = std::floor(mean + 0.5);
+  }
+  *outPtr = static_cast<T>(mean);
+}
+
+template <class T>
+inline void vtkImagePyramidMaximum(const T* values, int n, T* outPtr)
+{
+  *outPtr = *std::max_element(values, values + n);
+}
+
+template <class T>
+inline void vtkImagePyramidMode(T* values, int n, T* outPtr)
+{
+  // after sorting, the first of the longest runs has the smallest value
+  std::sort(values, values + n);
+  T best = values[0];
+  int bestCount = 0;
+  for (int i = 0; i < n;)
+  {
+    int j = i + 1;
+    while (j < n && values[j] == values[i])
+    {
+      j++;
+    }
+    if (j - i > bestCount)
+    {
+      best = values[i];
+      bestCount = j - i;
+    }
+    i = j;
+  }
+  *outPtr = best;
+}
+
+//----------------------------------------------------------------------------
+// Compute the voxels of a tile from the voxels of the previous level, where
+// voxel i covers the voxels m+2(i-m) and m+2(i-m)+1 for the start index m.
+template <class T>
+void vtkImagePyramidReduce(const T* inPtr, const int inExt[6], T* outPtr, const int outExt[6],
+  const int start[3], int numComp, int mode)
+{
+  vtkIdType incY = static_cast<vtkIdType>(inExt[1] - inExt[0] + 1) * numComp;
+  vtkIdType incZ = incY * (inExt[3] - inExt[2] + 1);
+  T values[8];
+
+  for (int z = outExt[4]; z <= outExt[5]; z++)
+  {
+    int z0 = 2 * z - start[2];
+    int z1 = std::min(2 * z - start[2] + 1, inExt[5]);
+    for (int y = outExt[2]; y <= outExt[3]; y++)
+    {
+      int y0 = 2 * y - start[1];
+      int y1 = std::min(2 * y - start[1] + 1, inExt[3]);
+      for (int x = outExt[0]; x <= outExt[1]; x++)
+      {
+        int x0 = 2 * x - start[0];
+        int x1 = std::min(2 * x - start[0] + 1, inExt[1]);
+        for (int c = 0; c < numComp; c++)
+        {
+          int n = 0;
+          for (int k = z0; k <= z1; k++)
+          {
+            for (int j = y0; j <= y1; j++)
+            {
+              const T* ptr = inPtr + (k - inExt[4]) * incZ + (j - inExt[2]) * incY +
+                static_cast<vtkIdType>(x0 - inExt[0]) * numComp + c;
+              for (int i = x0; i <= x1; i++)
+              {
+                values[n++] = *ptr;
+                ptr += numComp;
+              }
+            }
+          }
+          switch (mode)
+          {
+            case vtkImagePyramidWriter::Maximum:
+              vtkImagePyramidMaximum(values, n, outPtr);
+              break;
+            case vtkImagePyramidWriter::Mode:
+              vtkImagePyramidMode(values, n, outPtr);
+              break;
+            default:
+              vtkImagePyramidMean(values, n, outPtr);
+              break;
+          }
+          outPtr++;
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkImagePyramidNumberOfVoxels(const int extent[6])
+{
+  return static_cast<vtkIdType>(extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1) *
+    (extent[5] - extent[4] + 1);
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+// Request the first row of tiles, the other rows are requested in RequestData
+int vtkImagePyramidWriter::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  int wholeExt[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  if (wholeExt[0] > wholeExt[1] || wholeExt[2] > wholeExt[3] || wholeExt[4] > wholeExt[5])
+  {
+    return 1;
+  }
+
+  vtkImagePyramidHeader header;
+  for (int i = 0; i < 3; i++)
+  {
+    header.Extent[2 * i] = wholeExt[2 * i];
+    header.Extent[2 * i + 1] = wholeExt[2 * i + 1];
+    header.TileSize[i] = std::max(this->TileSize[i], 1);
+  }
+  int extent[6];
+  vtkImagePyramidRowExtent(header, 0, 0, extent);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImagePyramidWriter::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
+{
+  this->SetErrorCode(vtkErrorCode::NoError);
+
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkImageData* input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  if (input == nullptr)
+  {
+    vtkErrorMacro("Write: Please specify an input!");
+    return 0;
+  }
+  if (!this->FileName)
+  {
+    vtkErrorMacro("Write: Please specify a FileName");
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return 0;
+  }
+
+  int wholeExt[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  if (wholeExt[0] > wholeExt[1] || wholeExt[2] > wholeExt[3] || wholeExt[4] > wholeExt[5] ||
+    input->GetNumberOfScalarComponents() < 1 || !input->GetPointData()->GetScalars())
+  {
+    vtkErrorMacro("Write: The input has no scalars.");
+    return 0;
+  }
+
+  vtkImagePyramidHeader header;
+  header.ScalarType = input->GetScalarType();
+  header.NumberOfComponents = input->GetNumberOfScalarComponents();
+  header.ReductionMode = this->ReductionMode;
+  input->GetSpacing(header.Spacing);
+  input->GetOrigin(header.Origin);
+  for (int i = 0; i < 3; i++)
+  {
+    header.Extent[2 * i] = wholeExt[2 * i];
+    header.Extent[2 * i + 1] = wholeExt[2 * i + 1];
+    header.TileSize[i] = std::max(this->TileSize[i], 1);
+  }
+
+  // add levels until the coarsest level fits within a single tile
+  header.NumberOfLevels = this->NumberOfLevels;
+  if (header.NumberOfLevels == 0)
+  {
+    int range[6];
+    do
+    {
+      header.GetTileRange(header.NumberOfLevels++, range);
+    } while (header.NumberOfLevels < 31 &&
+      (range[0] != range[1] || range[2] != range[3] || range[4] != range[5]));
+  }
+  header.TileOffsets.assign(header.GetTotalNumberOfTiles(), 0);
+
+  std::fstream file(this->FileName, ios::in | ios::out | ios::binary | ios::trunc);
+  if (file.fail())
+  {
+    vtkErrorMacro("Write: Could not open file " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+    return 0;
+  }
+
+  // the header is written again at the end, once the offsets are known
+  header.Write(file);
+  vtkTypeUInt64 offset = header.GetHeaderSize();
+
+  int voxelSize = input->GetScalarSize() * header.NumberOfComponents;
+  vtkIdType totalTiles = static_cast<vtkIdType>(header.TileOffsets.size());
+  vtkIdType tileCount = 0;
+  std::vector<char> tileBuffer;
+
+  this->InvokeEvent(vtkCommand::StartEvent);
+  this->UpdateProgress(0.0);
+
+  // write level 0, one row of tiles at a time
+  vtkStreamingDemandDrivenPipeline* inputExec = vtkStreamingDemandDrivenPipeline::SafeDownCast(
+    vtkExecutive::PRODUCER()->GetExecutive(inInfo));
+  int inputPort = vtkExecutive::PRODUCER()->GetPort(inInfo);
+  int range[6];
+  header.GetTileRange(0, range);
+  bool firstRow = true;
+  for (int tz = range[4]; tz <= range[5] && !file.fail(); tz++)
+  {
+    for (int ty = range[2]; ty <= range[3] && !file.fail(); ty++)
+    {
+      int rowExt[6];
+      vtkImagePyramidRowExtent(header, ty, tz, rowExt);
+      if (!firstRow)
+      {
+        inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), rowExt, 6);
+        inputExec->PropagateUpdateExtent(inputPort);
+        inputExec->Update(inputPort);
+        input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+      }
+      firstRow = false;
+
+      int* inExt = input->GetExtent();
+      if (inExt[0] > rowExt[0] || inExt[1] < rowExt[1] || inExt[2] > rowExt[2] ||
+        inExt[3] < rowExt[3] || inExt[4] > rowExt[4] || inExt[5] < rowExt[5] ||
+        input->GetScalarType() != header.ScalarType ||
+        input->GetNumberOfScalarComponents() != header.NumberOfComponents)
+      {
+        vtkErrorMacro("Write: The input did not provide the requested extent.");
+        return 0;
+      }
+
+      const char* inPtr = static_cast<const char*>(input->GetScalarPointer());
+      for (int tx = range[0]; tx <= range[1]; tx++)
+      {
+        int tile[3] = { tx, ty, tz };
+        int tileExt[6];
+        header.GetTileExtent(0, tile, tileExt);
+        tileBuffer.resize(vtkImagePyramidNumberOfVoxels(tileExt) * voxelSize);
+        vtkImagePyramidCopyExtent(inPtr, inExt, tileBuffer.data(), tileExt, tileExt, voxelSize);
+        file.write(tileBuffer.data(), tileBuffer.size());
+        header.TileOffsets[header.GetTileIndex(0, tile)] = offset;
+        offset += tileBuffer.size();
+      }
+      tileCount += range[1] - range[0] + 1;
+      this->UpdateProgress(static_cast<double>(tileCount) / totalTiles);
+    }
+  }
+
+  // compute each of the other levels from the tiles of the previous level
+  std::vector<char> blockBuffer;
+  std::vector<char> readBuffer;
+  int start[3] = { header.Extent[0], header.Extent[2], header.Extent[4] };
+  for (int level = 1; level < header.NumberOfLevels && !file.fail(); level++)
+  {
+    int prevRange[6];
+    header.GetTileRange(level - 1, prevRange);
+    int prevExt[6];
+    header.GetLevelExtent(level - 1, prevExt);
+    header.GetTileRange(level, range);
+    for (int tz = range[4]; tz <= range[5] && !file.fail(); tz++)
+    {
+      for (int ty = range[2]; ty <= range[3] && !file.fail(); ty++)
+      {
+        for (int tx = range[0]; tx <= range[1] && !file.fail(); tx++)
+        {
+          int tile[3] = { tx, ty, tz };
+          int tileExt[6];
+          header.GetTileExtent(level, tile, tileExt);
+
+          // gather the block of the previous level that covers this tile
+          int blockExt[6];
+          for (int i = 0; i < 3; i++)
+          {
+            blockExt[2 * i] = 2 * tileExt[2 * i] - start[i];
+            blockExt[2 * i + 1] =
+              std::min(2 * tileExt[2 * i + 1] - start[i] + 1, prevExt[2 * i + 1]);
+          }
+          blockBuffer.resize(vtkImagePyramidNumberOfVoxels(blockExt) * voxelSize);
+          int source[3];
+          for (source[2] = 2 * tz; source[2] <= std::min(2 * tz + 1, prevRange[5]); source[2]++)
+          {
+            for (source[1] = 2 * ty; source[1] <= std::min(2 * ty + 1, prevRange[3]); source[1]++)
+            {
+              for (source[0] = 2 * tx; source[0] <= std::min(2 * tx + 1, prevRange[1]);
+                   source[0]++)
+              {
+                int sourceExt[6];
+                header.GetTileExtent(level - 1, source, sourceExt);
+                readBuffer.resize(vtkImagePyramidNumberOfVoxels(sourceExt) * voxelSize);
+                file.seekg(header.TileOffsets[header.GetTileIndex(level - 1, source)]);
+                file.read(readBuffer.data(), readBuffer.size());
+                vtkImagePyramidCopyExtent(readBuffer.data(), sourceExt, blockBuffer.data(),
+                  blockExt, sourceExt, voxelSize);
+              }
+            }
+          }
+
+          tileBuffer.resize(vtkImagePyramidNumberOfVoxels(tileExt) * voxelSize);
+          switch (header.ScalarType)
+          {
+            vtkTemplateMacro(vtkImagePyramidReduce(
+              reinterpret_cast<const VTK_TT*>(blockBuffer.data()), blockExt,
+              reinterpret_cast<VTK_TT*>(tileBuffer.data()), tileExt, start,
+              header.NumberOfComponents, header.ReductionMode));
+          }
+          file.seekp(offset);
+          file.write(tileBuffer.data(), tileBuffer.size());
+          header.TileOffsets[header.GetTileIndex(level, tile)] = offset;
+          offset += tileBuffer.size();
+        }
+        tileCount += range[1] - range[0] + 1;
+        this->UpdateProgress(static_cast<double>(tileCount) / totalTiles);
+      }
+    }
+  }
+
+  file.seekp(0);
+  header.Write(file);
+  file.flush();
+  if (file.fail())
+  {
+    vtkErrorMacro("Write: Could not write file " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+  }
+  file.close();
+
+  this->UpdateProgress(1.0);
+  this->InvokeEvent(vtkCommand::EndEvent);
+
+  return 1;
+}
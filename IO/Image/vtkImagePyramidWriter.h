@@ -0,0 +1,127 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImagePyramidWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImagePyramidWriter
+ * @brief   Write an image as a tiled, multi-resolution pyramid.
+ *
+ * vtkImagePyramidWriter writes its input to a single file as a pyramid of
+ * levels, where each level has half the resolution of the previous one.
+ * Every level is split into tiles that can be read independently, so that
+ * vtkImagePyramidReader can load just the tiles that cover the requested
+ * extent, at the requested level.
+ *
+ * The writer never holds the whole image in memory. Level 0 is written by
+ * streaming the input one row of tiles at a time, and each of the other
+ * levels is computed tile by tile from the tiles of the previous level that
+ * have already been written to the file.  The reduction used to compute the
+ * coarser levels can be the mean (for intensities), the maximum (for
+ * maximum intensity projections) or the mode (for label images).
+ *
+ * @sa
+ * vtkImagePyramidReader
+ */
+
+#ifndef vtkImagePyramidWriter_h
+#define vtkImagePyramidWriter_h
+
+#include "vtkIOImageModule.h" // For export macro
+#include "vtkImageAlgorithm.h"
+
+class VTKIOIMAGE_EXPORT vtkImagePyramidWriter : public vtkImageAlgorithm
+{
+public:
+  static vtkImagePyramidWriter* New();
+  vtkTypeMacro(vtkImagePyramidWriter, vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum ReductionModes
+  {
+    Mean = 0,
+    Maximum = 1,
+    Mode = 2
+  };
+
+  //@{
+  /**
+   * Specify the name of the file to write.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the size of the tiles, in voxels. The input is requested one row
+   * of tiles at a time, so the row size bounds the memory used while writing.
+   * The default is 64x64x64.
+   */
+  vtkSetVector3Macro(TileSize, int);
+  vtkGetVector3Macro(TileSize, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of levels, including the full resolution level. The
+   * default, zero, adds levels until the coarsest level fits in one tile.
+   */
+  vtkSetClampMacro(NumberOfLevels, int, 0, 31);
+  vtkGetMacro(NumberOfLevels, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get how each voxel of a level is computed from the corresponding
+   * block of 2x2x2 voxels of the previous level. Mean rounds to the nearest
+   * integer for integer types, and Mode breaks ties in favor of the smallest
+   * value. The default is Mean.
+   */
+  vtkSetClampMacro(ReductionMode, int, Mean, Mode);
+  vtkGetMacro(ReductionMode, int);
+  void SetReductionModeToMean() { this->SetReductionMode(Mean); }
+  void SetReductionModeToMaximum() { this->SetReductionMode(Maximum); }
+  void SetReductionModeToMode() { this->SetReductionMode(Mode); }
+  const char* GetReductionModeAsString();
+  //@}
+
+  /**
+   * Write the file.
+   */
+  void Write();
+
+  /**
+   * Get the input to this writer.
+   */
+  vtkImageData* GetInput();
+
+protected:
+  vtkImagePyramidWriter();
+  ~vtkImagePyramidWriter() override;
+
+  int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  char* FileName;
+  int TileSize[3];
+  int NumberOfLevels;
+  int ReductionMode;
+
+private:
+  vtkImagePyramidWriter(const vtkImagePyramidWriter&) = delete;
+  void operator=(const vtkImagePyramidWriter&) = delete;
+};
+
+#endif
@@ -0,0 +1,246 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Roundtrip test for large arrays and cells in ASCII legacy files, which
+// are parsed in chunks.  The values are exactly representable with the
+// precision the writer uses.  vtkSimplePointsReader, which does not switch
+// to the classic locale itself, must also read decimal points when the C
+// locale of the application uses a decimal comma.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkShortArray.h"
+#include "vtkSimplePointsReader.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <clocale>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+template <typename ArrayT>
+ArrayT* AddArray(vtkPolyData* pd, const char* name, int numComps)
+{
+  vtkNew<ArrayT> array;
+  array->SetName(name);
+  array->SetNumberOfComponents(numComps);
+  array->SetNumberOfTuples(pd->GetNumberOfPoints());
+  pd->GetPointData()->AddArray(array);
+  return array;
+}
+
+bool CompareArrays(vtkDataArray* expect, vtkDataArray* actual)
+{
+  if (!actual || actual->GetDataType() != expect->GetDataType() ||
+      actual->GetNumberOfTuples() != expect->GetNumberOfTuples() ||
+      actual->GetNumberOfComponents() != expect->GetNumberOfComponents())
+  {
+    std::cerr << "Array " << expect->GetName() << " was not read back.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < expect->GetNumberOfValues(); ++i)
+  {
+    int comps = expect->GetNumberOfComponents();
+    if (actual->GetComponent(i / comps, i % comps) !=
+        expect->GetComponent(i / comps, i % comps))
+    {
+      std::cerr << "Array " << expect->GetName() << " differs at value "
+                << i << ".\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+// Switch LC_NUMERIC to a locale whose decimal separator is a comma.
+// Returns the previous locale, or an empty string if the system has no
+// such locale.
+std::string SetCommaLocale()
+{
+  const char* names[] = { "de_DE.UTF-8", "de_DE.utf8", "de_DE",
+    "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR", "German_Germany.1252",
+    "French_France.1252" };
+  std::string previous = setlocale(LC_NUMERIC, nullptr);
+  for (const char* name : names)
+  {
+    if (setlocale(LC_NUMERIC, name) && localeconv()->decimal_point[0] == ',')
+    {
+      return previous;
+    }
+  }
+  setlocale(LC_NUMERIC, previous.c_str());
+  return std::string();
+}
+
+bool TestSimplePointsCommaLocale(const std::string& fileName)
+{
+  const vtkIdType numPts = 100000;
+  {
+    std::ofstream file(fileName.c_str());
+    file.imbue(std::locale::classic());
+    file.precision(10);
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      file << 0.5 * i << " " << -0.25 * i << " " << 0.125 * (i % 1000)
+           << "\n";
+    }
+  }
+
+  std::string previousLocale = SetCommaLocale();
+  if (previousLocale.empty())
+  {
+    std::cout << "No locale with a decimal comma, skipping that part.\n";
+    return true;
+  }
+  vtkNew<vtkSimplePointsReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  setlocale(LC_NUMERIC, previousLocale.c_str());
+
+  vtkPolyData* output = reader->GetOutput();
+  if (output->GetNumberOfPoints() != numPts)
+  {
+    std::cerr << "Read " << output->GetNumberOfPoints()
+              << " simple points with a decimal comma locale.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    output->GetPoint(i, x);
+    if (x[0] != 0.5 * i || x[1] != -0.25 * i || x[2] != 0.125 * (i % 1000))
+    {
+      std::cerr << "Simple point " << i
+                << " differs with a decimal comma locale.\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestLegacyASCIIArrays(int argc, char *argv[])
+{
+  // Enough points for several chunks of several pieces.
+  const vtkIdType numPts = 300000;
+
+  vtkNew<vtkPolyData> pd;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkCellArray> lines;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    points->SetPoint(i, 0.5 * i, -0.25 * i, 0.125 * (i % 1000));
+    if (i % 3 == 2)
+    {
+      vtkIdType ids[3] = { i - 2, i - 1, i };
+      lines->InsertNextCell(3, ids);
+    }
+  }
+  pd->SetPoints(points);
+  pd->SetLines(lines);
+
+  vtkUnsignedCharArray* uchars =
+    AddArray<vtkUnsignedCharArray>(pd, "uchars", 1);
+  vtkShortArray* shorts = AddArray<vtkShortArray>(pd, "shorts", 1);
+  vtkIntArray* ints = AddArray<vtkIntArray>(pd, "ints", 2);
+  vtkIdTypeArray* ids = AddArray<vtkIdTypeArray>(pd, "ids", 1);
+  vtkFloatArray* floats = AddArray<vtkFloatArray>(pd, "floats", 3);
+  vtkDoubleArray* doubles = AddArray<vtkDoubleArray>(pd, "doubles", 1);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    uchars->SetValue(i, static_cast<unsigned char>(i % 256));
+    shorts->SetValue(i, static_cast<short>(i % 60000 - 30000));
+    ints->SetTypedComponent(i, 0, static_cast<int>(-7 * i));
+    ints->SetTypedComponent(i, 1, static_cast<int>(i * 1013));
+    ids->SetValue(i, numPts - i);
+    floats->SetTypedComponent(i, 0, 0.125f * (i % 1000));
+    floats->SetTypedComponent(i, 1, -1.5f);
+    floats->SetTypedComponent(i, 2, 0.25f * (i % 100));
+    doubles->SetValue(i, 0.5 * i - 1000.25);
+  }
+
+  vtkNew<vtkPolyDataWriter> writer;
+  writer->SetInputData(pd);
+  writer->SetFileTypeToASCII();
+  writer->WriteToOutputStringOn();
+  writer->Write();
+
+  vtkNew<vtkPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputStdString());
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+
+  if (output->GetNumberOfPoints() != numPts ||
+      output->GetNumberOfLines() != pd->GetNumberOfLines())
+  {
+    std::cerr << "Read " << output->GetNumberOfPoints() << " points and "
+              << output->GetNumberOfLines() << " lines.\n";
+    return EXIT_FAILURE;
+  }
+
+  if (!CompareArrays(points->GetData(), output->GetPoints()->GetData()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkIdType npts, *pts;
+  output->GetLines()->InitTraversal();
+  for (vtkIdType cell = 0; output->GetLines()->GetNextCell(npts, pts); ++cell)
+  {
+    if (npts != 3 || pts[0] != 3 * cell || pts[2] != 3 * cell + 2)
+    {
+      std::cerr << "Line " << cell << " differs.\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtkPointData* outPD = output->GetPointData();
+  for (int i = 0; i < pd->GetPointData()->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* expect = pd->GetPointData()->GetArray(i);
+    if (!CompareArrays(expect, outPD->GetArray(expect->GetName())))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string pointsFile = std::string(tempDir) + "/LegacyASCIIArrays.xyz";
+  delete[] tempDir;
+  if (!TestSimplePointsCommaLocale(pointsFile))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -36,6 +36,7 @@
 #include "vtkInformationUnsignedLongKey.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
+#include "vtkLegacyASCIIParserInternal.h"
 #include "vtkLegacyReaderVersion.h"
 #include "vtkLongArray.h"
 #include "vtkLookupTable.h"
@@ -1496,19 +1497,13 @@ int vtkReadBinaryData(istream *IS, T *data, vtkIdType numTuples, vtkIdType numCo
 template <class T>
 int vtkReadASCIIData(vtkDataReader *self, T *data, vtkIdType numTuples, vtkIdType numComp)
 {
-  vtkIdType i, j;
-
-  for (i=0; i<numTuples; i++)
+  vtkIdType numValues = numTuples*numComp;
+  if ( vtkLegacyASCIIParser::ReadValues(*self->GetIStream(), data, numValues)
+       != numValues )
   {
-    for (j=0; j<numComp; j++)
-    {
-      if ( !self->Read(data++) )
-      {
-        vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
-          "datasize with declaration.");
-        return 0;
-      }
-    }
+    vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
+      "datasize with declaration.");
+    return 0;
   }
   return 1;
 }
@@ -3154,7 +3149,6 @@ int vtkDataReader::ReadLutData(vtkDataSetAttributes *a)
 int vtkDataReader::ReadCells(vtkIdType size, int *data)
 {
   char line[256];
-  int i;
 
   if ( this->FileType == VTK_BINARY)
   {
@@ -3172,15 +3166,12 @@ int vtkDataReader::ReadCells(vtkIdType size, int *data)
   }
   else // ascii
   {
-    for (i=0; i<size; i++)
+    if (vtkLegacyASCIIParser::ReadValues(*this->IS, data, size) != size)
     {
-      if (!this->Read(data+i))
-      {
-        const char* fname = this->CurrentFileName.c_str();
-        vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
-                      << (fname?fname:"(Null FileName)"));
-        return 0;
-      }
+      const char* fname = this->CurrentFileName.c_str();
+      vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
+                    << (fname?fname:"(Null FileName)"));
+      return 0;
     }
   }
 
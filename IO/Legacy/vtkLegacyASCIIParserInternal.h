@@ -0,0 +1,574 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLegacyASCIIParserInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Bulk parsing of whitespace-separated numbers for the legacy ASCII
+// readers.  The stream is read in large chunks which are split into
+// pieces at whitespace, and the pieces are converted concurrently.
+// Each value is converted exactly as operator>> of a stream imbued with
+// the classic locale converts it: integers are range checked like
+// num_get does, and float and double values go through strtof_l and
+// strtod_l with the "C" locale, as libstdc++ does, so the values read
+// are bit-identical whatever the LC_NUMERIC of the global locale.
+//
+// This header is private to the IOLegacy module.
+
+#ifndef vtkLegacyASCIIParserInternal_h
+#define vtkLegacyASCIIParserInternal_h
+
+#include "vtkSMPTools.h"
+#include "vtkType.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <istream>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+# define VTK_LEGACY_ASCII_PARSER_MSVC_LOCALE
+#elif defined(__GLIBC__) || defined(__APPLE__)
+# define VTK_LEGACY_ASCII_PARSER_POSIX_LOCALE
+# if defined(__APPLE__)
+#  include <xlocale.h>
+# endif
+#endif
+
+namespace vtkLegacyASCIIParser
+{
+#if defined(VTK_LEGACY_ASCII_PARSER_MSVC_LOCALE) || \
+  defined(VTK_LEGACY_ASCII_PARSER_POSIX_LOCALE)
+//----------------------------------------------------------------------------
+// The "C" locale, created on first use and shared by all threads, so
+// that strtod does not expect a decimal comma when the application has
+// called setlocale.
+class CLocale
+{
+public:
+#if defined(VTK_LEGACY_ASCII_PARSER_MSVC_LOCALE)
+  typedef _locale_t LocaleType;
+#else
+  typedef locale_t LocaleType;
+#endif
+
+  static LocaleType Get()
+  {
+    static const CLocale instance;
+    return instance.Locale;
+  }
+
+private:
+#if defined(VTK_LEGACY_ASCII_PARSER_MSVC_LOCALE)
+  CLocale() : Locale(_create_locale(LC_NUMERIC, "C")) {}
+  ~CLocale() { _free_locale(this->Locale); }
+#else
+  CLocale() : Locale(newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0))) {}
+  ~CLocale() { freelocale(this->Locale); }
+#endif
+  CLocale(const CLocale&) = delete;
+  void operator=(const CLocale&) = delete;
+
+  LocaleType Locale;
+};
+
+//----------------------------------------------------------------------------
+// Convert the longest prefix of the token that forms a number.
+inline float StringToFloat(const char* begin, const char*, char** stop)
+{
+#if defined(VTK_LEGACY_ASCII_PARSER_MSVC_LOCALE)
+  return _strtof_l(begin, stop, CLocale::Get());
+#else
+  return strtof_l(begin, stop, CLocale::Get());
+#endif
+}
+
+inline double StringToDouble(const char* begin, const char*, char** stop)
+{
+#if defined(VTK_LEGACY_ASCII_PARSER_MSVC_LOCALE)
+  return _strtod_l(begin, stop, CLocale::Get());
+#else
+  return strtod_l(begin, stop, CLocale::Get());
+#endif
+}
+#else
+//----------------------------------------------------------------------------
+// Without locale-specific conversion functions, use a stream imbued
+// with the classic locale.
+template <class T>
+T StreamToReal(const char* begin, const char* end, char** stop)
+{
+  std::istringstream stream(std::string(begin, end));
+  stream.imbue(std::locale::classic());
+  T result = 0;
+  stream >> result;
+  // A token the stream does not consume entirely is rejected.
+  *stop = const_cast<char*>(!stream.fail() && stream.eof() ? end : begin);
+  return result;
+}
+
+inline float StringToFloat(const char* begin, const char* end, char** stop)
+{
+  return StreamToReal<float>(begin, end, stop);
+}
+
+inline double StringToDouble(const char* begin, const char* end, char** stop)
+{
+  return StreamToReal<double>(begin, end, stop);
+}
+#endif
+
+//----------------------------------------------------------------------------
+// Whitespace of the classic locale.
+inline bool IsSpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' ||
+    c == '\f';
+}
+
+//----------------------------------------------------------------------------
+// Convert a signed decimal integer that must fill the whole token.
+inline bool ParseSigned(const char* begin, const char* end,
+                        long long minimum, long long maximum, long long& value)
+{
+  char* stop;
+  errno = 0;
+  long long result = strtoll(begin, &stop, 10);
+  if (stop != end || errno == ERANGE || result < minimum || result > maximum)
+  {
+    return false;
+  }
+  value = result;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Convert an unsigned decimal integer that must fill the whole token.  As
+// with num_get, a leading minus sign negates the value modulo the range of
+// the type after checking its magnitude.
+inline bool ParseUnsigned(const char* begin, const char* end,
+                          unsigned long long maximum,
+                          unsigned long long& value)
+{
+  bool negative = (*begin == '-');
+  const char* digits = (negative || *begin == '+') ? begin + 1 : begin;
+  if (digits == end || *digits < '0' || *digits > '9')
+  {
+    return false;
+  }
+  char* stop;
+  errno = 0;
+  unsigned long long result = strtoull(digits, &stop, 10);
+  if (stop != end || errno == ERANGE || result > maximum)
+  {
+    return false;
+  }
+  value = negative ? 0ULL - result : result;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// num_get only accepts these characters in a floating point value, so
+// tokens such as "nan", "inf" or hexadecimal floats are rejected.
+inline bool IsFloatToken(const char* begin, const char* end)
+{
+  for (const char* c = begin; c != end; ++c)
+  {
+    if (!((*c >= '0' && *c <= '9') || *c == '.' || *c == 'e' || *c == 'E' ||
+          *c == '+' || *c == '-'))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+bool ParseSignedValue(const char* begin, const char* end, T& value)
+{
+  long long result;
+  if (!ParseSigned(begin, end, std::numeric_limits<T>::min(),
+                   std::numeric_limits<T>::max(), result))
+  {
+    return false;
+  }
+  value = static_cast<T>(result);
+  return true;
+}
+
+template <class T>
+bool ParseUnsignedValue(const char* begin, const char* end, T& value)
+{
+  unsigned long long result;
+  if (!ParseUnsigned(begin, end, std::numeric_limits<T>::max(), result))
+  {
+    return false;
+  }
+  value = static_cast<T>(result);
+  return true;
+}
+
+// vtkDataReader reads char and unsigned char values as int.
+inline bool ParseValue(const char* begin, const char* end, char& value)
+{
+  int result;
+  if (!ParseSignedValue(begin, end, result))
+  {
+    return false;
+  }
+  value = static_cast<char>(result);
+  return true;
+}
+
+inline bool ParseValue(const char* begin, const char* end,
+                       unsigned char& value)
+{
+  int result;
+  if (!ParseSignedValue(begin, end, result))
+  {
+    return false;
+  }
+  value = static_cast<unsigned char>(result);
+  return true;
+}
+
+inline bool ParseValue(const char* begin, const char* end, short& value)
+{
+  return ParseSignedValue(begin, end, value);
+}
+
+inline bool ParseValue(const char* begin, const char* end, int& value)
+{
+  return ParseSignedValue(begin, end, value);
+}
+
+inline bool ParseValue(const char* begin, const char* end, long& value)
+{
+  return ParseSignedValue(begin, end, value);
+}
+
+inline bool ParseValue(const char* begin, const char* end, long long& value)
+{
+  return ParseSignedValue(begin, end, value);
+}
+
+inline bool ParseValue(const char* begin, const char* end,
+                       unsigned short& value)
+{
+  return ParseUnsignedValue(begin, end, value);
+}
+
+inline bool ParseValue(const char* begin, const char* end,
+                       unsigned int& value)
+{
+  return ParseUnsignedValue(begin, end, value);
+}
+
+inline bool ParseValue(const char* begin, const char* end,
+                       unsigned long& value)
+{
+  return ParseUnsignedValue(begin, end, value);
+}
+
+inline bool ParseValue(const char* begin, const char* end,
+                       unsigned long long& value)
+{
+  return ParseUnsignedValue(begin, end, value);
+}
+
+inline bool ParseValue(const char* begin, const char* end, float& value)
+{
+  if (!IsFloatToken(begin, end))
+  {
+    return false;
+  }
+  char* stop;
+  float result = StringToFloat(begin, end, &stop);
+  if (stop != end || std::isinf(result))
+  {
+    return false;
+  }
+  value = result;
+  return true;
+}
+
+inline bool ParseValue(const char* begin, const char* end, double& value)
+{
+  if (!IsFloatToken(begin, end))
+  {
+    return false;
+  }
+  char* stop;
+  double result = StringToDouble(begin, end, &stop);
+  if (stop != end || std::isinf(result))
+  {
+    return false;
+  }
+  value = result;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Count the tokens of each piece of a chunk.
+class CountTokens
+{
+public:
+  CountTokens(const char* buffer, const std::vector<size_t>& bounds,
+              std::vector<vtkIdType>& counts)
+    : Buffer(buffer), Bounds(bounds), Counts(counts)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType piece = begin; piece < end; ++piece)
+    {
+      vtkIdType count = 0;
+      bool inToken = false;
+      for (size_t i = this->Bounds[piece]; i < this->Bounds[piece + 1]; ++i)
+      {
+        bool space = IsSpace(this->Buffer[i]);
+        count += (!space && !inToken) ? 1 : 0;
+        inToken = !space;
+      }
+      this->Counts[piece] = count;
+    }
+  }
+
+private:
+  const char* Buffer;
+  const std::vector<size_t>& Bounds;
+  std::vector<vtkIdType>& Counts;
+};
+
+//----------------------------------------------------------------------------
+// Convert the tokens of each piece of a chunk, up to a number of values.
+// For each piece, records the end of the last token converted and the
+// index and start of the first token that could not be converted.
+template <class T>
+class ConvertTokens
+{
+public:
+  ConvertTokens(const char* buffer, const std::vector<size_t>& bounds,
+                const std::vector<vtkIdType>& firstIndex, vtkIdType numValues,
+                T* data)
+    : Buffer(buffer), Bounds(bounds), FirstIndex(firstIndex),
+      NumberOfValues(numValues), Data(data)
+  {
+    size_t numPieces = bounds.size() - 1;
+    this->LastEnd.assign(numPieces, 0);
+    this->FailedIndex.assign(numPieces, numValues);
+    this->FailedStart.assign(numPieces, 0);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType piece = begin; piece < end; ++piece)
+    {
+      vtkIdType index = this->FirstIndex[piece];
+      size_t i = this->Bounds[piece];
+      size_t last = this->Bounds[piece + 1];
+      while (index < this->NumberOfValues)
+      {
+        while (i < last && IsSpace(this->Buffer[i]))
+        {
+          ++i;
+        }
+        if (i == last)
+        {
+          break;
+        }
+        size_t start = i;
+        while (i < last && !IsSpace(this->Buffer[i]))
+        {
+          ++i;
+        }
+        if (!ParseValue(this->Buffer + start, this->Buffer + i,
+                        this->Data[index]))
+        {
+          this->FailedIndex[piece] = index;
+          this->FailedStart[piece] = start;
+          break;
+        }
+        this->LastEnd[piece] = i;
+        ++index;
+      }
+    }
+  }
+
+  std::vector<size_t> LastEnd;
+  std::vector<vtkIdType> FailedIndex;
+  std::vector<size_t> FailedStart;
+
+private:
+  const char* Buffer;
+  const std::vector<size_t>& Bounds;
+  const std::vector<vtkIdType>& FirstIndex;
+  vtkIdType NumberOfValues;
+  T* Data;
+};
+
+//----------------------------------------------------------------------------
+// Run a functor over the pieces of a chunk, in parallel when there are
+// several pieces.
+template <class Functor>
+void ForEachPiece(vtkIdType numPieces, Functor& functor)
+{
+  if (numPieces == 1)
+  {
+    functor(0, 1);
+  }
+  else
+  {
+    vtkSMPTools::For(0, numPieces, 1, functor);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Read up to numValues whitespace-separated values from the stream into
+// data.  Returns the number of values read.  Reading stops early at the
+// end of the stream or at the first token that is not a valid value.
+// The stream is left right after the last value read, or at the token
+// that could not be read, as with operator>>.  The stream must support
+// seeking.
+template <class T>
+vtkIdType ReadValues(std::istream& is, T* data, vtkIdType numValues)
+{
+  // Bytes per piece converted by one task, and bounds on the chunk size.
+  const size_t pieceSize = 262144;
+  const size_t minimumChunkSize = 4096;
+  const size_t maximumChunkSize = 16777216;
+
+  std::vector<char> buffer;
+  std::vector<size_t> bounds;
+  std::vector<vtkIdType> counts;
+  std::vector<vtkIdType> firstIndex;
+
+  vtkIdType numRead = 0;
+  while (numRead < numValues)
+  {
+    std::streampos chunkStart = is.tellg();
+    if (chunkStart == std::streampos(-1))
+    {
+      return numRead;
+    }
+
+    // Values take a few characters each, so size the chunk after the
+    // number of values still needed.
+    vtkIdType remaining = numValues - numRead;
+    size_t chunkSize = maximumChunkSize;
+    if (remaining < static_cast<vtkIdType>(maximumChunkSize / 16))
+    {
+      chunkSize =
+        std::max(minimumChunkSize, static_cast<size_t>(remaining) * 16);
+    }
+
+    // Read the chunk, then complete its last token.
+    buffer.resize(chunkSize);
+    is.read(&buffer[0], static_cast<std::streamsize>(chunkSize));
+    size_t length = static_cast<size_t>(is.gcount());
+    if (length == chunkSize)
+    {
+      int c;
+      while ((c = is.get()) != EOF && !IsSpace(static_cast<char>(c)))
+      {
+        buffer.push_back(static_cast<char>(c));
+        ++length;
+      }
+    }
+    if (length == 0)
+    {
+      is.clear();
+      is.seekg(chunkStart);
+      return numRead;
+    }
+    // The conversion functions stop at the terminating whitespace.
+    buffer.resize(length + 1);
+    buffer[length] = ' ';
+    const char* chars = &buffer[0];
+
+    // Split the chunk into pieces at whitespace so no token is split.
+    vtkIdType numPieces =
+      static_cast<vtkIdType>(std::max<size_t>(1, length / pieceSize));
+    bounds.resize(numPieces + 1);
+    bounds[0] = 0;
+    for (vtkIdType piece = 1; piece < numPieces; ++piece)
+    {
+      size_t i = std::max(bounds[piece - 1],
+        length * static_cast<size_t>(piece) / static_cast<size_t>(numPieces));
+      while (i < length && !IsSpace(chars[i]))
+      {
+        ++i;
+      }
+      bounds[piece] = i;
+    }
+    bounds[numPieces] = length;
+
+    // Find where the values of each piece go.
+    counts.resize(numPieces);
+    CountTokens countTokens(chars, bounds, counts);
+    ForEachPiece(numPieces, countTokens);
+    firstIndex.resize(numPieces + 1);
+    firstIndex[0] = numRead;
+    for (vtkIdType piece = 0; piece < numPieces; ++piece)
+    {
+      firstIndex[piece + 1] = firstIndex[piece] + counts[piece];
+    }
+    vtkIdType chunkEnd = std::min(firstIndex[numPieces], numValues);
+
+    // Convert the values.
+    ConvertTokens<T> convertTokens(chars, bounds, firstIndex, chunkEnd, data);
+    ForEachPiece(numPieces, convertTokens);
+
+    // Leave the stream after the last value read or at the first invalid
+    // token.
+    is.clear();
+    for (vtkIdType piece = 0; piece < numPieces; ++piece)
+    {
+      if (convertTokens.FailedIndex[piece] < chunkEnd)
+      {
+        is.seekg(chunkStart +
+          static_cast<std::streamoff>(convertTokens.FailedStart[piece]));
+        return convertTokens.FailedIndex[piece];
+      }
+    }
+    if (chunkEnd > numRead)
+    {
+      vtkIdType piece = numPieces - 1;
+      while (firstIndex[piece] >= chunkEnd)
+      {
+        --piece;
+      }
+      is.seekg(chunkStart +
+        static_cast<std::streamoff>(convertTokens.LastEnd[piece]));
+    }
+    else if (length < chunkSize)
+    {
+      // Only whitespace was left in the stream.
+      return numRead;
+    }
+    numRead = chunkEnd;
+  }
+  return numRead;
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkLegacyASCIIParserInternal.h
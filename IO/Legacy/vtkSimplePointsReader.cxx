@@ -15,11 +15,15 @@
 #include "vtkSimplePointsReader.h"
 
 #include "vtkCellArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLegacyASCIIParserInternal.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkSmartPointer.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkSimplePointsReader);
 
 //----------------------------------------------------------------------------
@@ -57,25 +61,43 @@ int vtkSimplePointsReader::RequestData(vtkInformation*,
   }
 
   // Open the input file.
-  ifstream fin(this->FileName);
+  ifstream fin(this->FileName, ios::in | ios::binary);
   if(!fin)
   {
     vtkErrorMacro("Error opening file " << this->FileName);
     return 0;
   }
 
-  // Allocate objects to hold points and vertex cells.
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-  vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
-
-  // Read points from the file.
+  // Read the coordinates from the file, a block of points at a time.
   vtkDebugMacro("Reading points from file " << this->FileName);
-  double x[3];
-  while(fin >> x[0] >> x[1] >> x[2])
+  const vtkIdType blockSize = 3 * 262144;
+  std::vector<double> coordinates;
+  vtkIdType numRead;
+  do
   {
-    vtkIdType id = points->InsertNextPoint(x);
-    verts->InsertNextCell(1, &id);
+    size_t start = coordinates.size();
+    coordinates.resize(start + blockSize);
+    numRead = vtkLegacyASCIIParser::ReadValues(fin, &coordinates[start],
+                                               blockSize);
+    coordinates.resize(start + numRead);
   }
+  while(numRead == blockSize);
+
+  // Make points and vertex cells of the complete coordinate triples.
+  vtkIdType numPts = static_cast<vtkIdType>(coordinates.size() / 3);
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetNumberOfPoints(numPts);
+  vtkSmartPointer<vtkIdTypeArray> cells =
+    vtkSmartPointer<vtkIdTypeArray>::New();
+  cells->SetNumberOfValues(2 * numPts);
+  for(vtkIdType id = 0; id < numPts; ++id)
+  {
+    points->SetPoint(id, &coordinates[3 * id]);
+    cells->SetValue(2 * id, 1);
+    cells->SetValue(2 * id + 1, id);
+  }
+  vtkSmartPointer<vtkCellArray> verts = vtkSmartPointer<vtkCellArray>::New();
+  verts->SetCells(numPts, cells);
   vtkDebugMacro("Read " << points->GetNumberOfPoints() << " points.");
 
   // Store the points and cells in the output data object.
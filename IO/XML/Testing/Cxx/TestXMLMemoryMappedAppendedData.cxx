@@ -0,0 +1,216 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMemoryMappedAppendedData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkXMLReader::MemoryMapAppendedData
+// .SECTION Description
+// Write raw appended data in both byte orders, read it back through a
+// memory mapping, as a whole and for a sub-extent, and check the values,
+// and check that modifying the arrays read does not modify the file.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkShortArray.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <string>
+
+namespace
+{
+const int Dimension = 32;
+
+vtkSmartPointer<vtkImageData> ReadImage(const std::string& filename,
+                                        bool memoryMap)
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(filename.c_str());
+  reader->SetMemoryMapAppendedData(memoryMap);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+vtkSmartPointer<vtkImageData> ReadSubImage(const std::string& filename,
+                                           const int extent[6])
+{
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName(filename.c_str());
+  reader->MemoryMapAppendedDataOn();
+  reader->UpdateInformation();
+  reader->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool CheckSubImage(vtkImageData* imageData, const int extent[6])
+{
+  vtkPointData* pd = imageData->GetPointData();
+  vtkShortArray* shorts = vtkShortArray::SafeDownCast(pd->GetArray("shorts"));
+  vtkDoubleArray* doubles =
+    vtkDoubleArray::SafeDownCast(pd->GetArray("doubles"));
+  vtkIdType numPts = Dimension * Dimension * Dimension;
+  if (!shorts || !doubles ||
+      shorts->GetNumberOfTuples() != imageData->GetNumberOfPoints())
+  {
+    cerr << "Could not read sub-extent arrays." << endl;
+    return false;
+  }
+
+  vtkIdType j = 0;
+  for (int z = extent[4]; z <= extent[5]; z++)
+  {
+    for (int y = extent[2]; y <= extent[3]; y++)
+    {
+      for (int x = extent[0]; x <= extent[1]; x++, j++)
+      {
+        vtkIdType i = x + Dimension * (y + Dimension * z);
+        if (shorts->GetValue(j) != static_cast<short>(i - numPts / 2) ||
+            doubles->GetTypedComponent(j, 0) != 0.5 * i ||
+            doubles->GetTypedComponent(j, 2) != -0.25 * i)
+        {
+          cerr << "Incorrect sub-extent value at index " << i << "." << endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool CheckImage(vtkImageData* imageData)
+{
+  vtkPointData* pd = imageData->GetPointData();
+  vtkUnsignedCharArray* bytes =
+    vtkUnsignedCharArray::SafeDownCast(pd->GetArray("bytes"));
+  vtkShortArray* shorts = vtkShortArray::SafeDownCast(pd->GetArray("shorts"));
+  vtkDoubleArray* doubles =
+    vtkDoubleArray::SafeDownCast(pd->GetArray("doubles"));
+  vtkIdType numPts = Dimension * Dimension * Dimension;
+  if (!bytes || !shorts || !doubles ||
+      bytes->GetNumberOfTuples() != numPts ||
+      shorts->GetNumberOfTuples() != numPts ||
+      doubles->GetNumberOfTuples() != numPts ||
+      doubles->GetNumberOfComponents() != 3)
+  {
+    cerr << "Could not read data arrays." << endl;
+    return false;
+  }
+
+  for (vtkIdType i = 0; i < numPts; i++)
+  {
+    if (bytes->GetValue(i) != static_cast<unsigned char>(i % 251) ||
+        shorts->GetValue(i) != static_cast<short>(i - numPts / 2) ||
+        doubles->GetTypedComponent(i, 0) != 0.5 * i ||
+        doubles->GetTypedComponent(i, 2) != -0.25 * i)
+    {
+      cerr << "Incorrect value at index " << i << "." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLMemoryMappedAppendedData(int argc, char *argv[])
+{
+  char* temp_dir_c =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv,
+                                           "VTK_TEMP_DIR",
+                                           "Testing/Temporary");
+  std::string temp_dir = std::string(temp_dir_c);
+  delete [] temp_dir_c;
+
+  if (temp_dir.empty())
+  {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(Dimension, Dimension, Dimension);
+  vtkIdType numPts = imageData->GetNumberOfPoints();
+
+  vtkNew<vtkUnsignedCharArray> bytes;
+  bytes->SetName("bytes");
+  bytes->SetNumberOfTuples(numPts);
+  vtkNew<vtkShortArray> shorts;
+  shorts->SetName("shorts");
+  shorts->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("doubles");
+  doubles->SetNumberOfComponents(3);
+  doubles->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; i++)
+  {
+    bytes->SetValue(i, static_cast<unsigned char>(i % 251));
+    shorts->SetValue(i, static_cast<short>(i - numPts / 2));
+    doubles->SetTypedComponent(i, 0, 0.5 * i);
+    doubles->SetTypedComponent(i, 1, 1.0);
+    doubles->SetTypedComponent(i, 2, -0.25 * i);
+  }
+  imageData->GetPointData()->AddArray(bytes);
+  imageData->GetPointData()->AddArray(shorts);
+  imageData->GetPointData()->AddArray(doubles);
+
+  for (int byteOrder = 0; byteOrder < 2; ++byteOrder)
+  {
+    std::string filename = temp_dir + "/testXMLMemoryMappedAppendedData" +
+      (byteOrder ? "BE" : "LE") + ".vti";
+
+    vtkNew<vtkXMLImageDataWriter> writer;
+    writer->SetFileName(filename.c_str());
+    writer->SetInputData(imageData);
+    writer->SetDataModeToAppended();
+    writer->EncodeAppendedDataOff();
+    writer->SetCompressorTypeToNone();
+    writer->SetByteOrder(byteOrder ? vtkXMLWriter::BigEndian
+                                   : vtkXMLWriter::LittleEndian);
+    writer->Write();
+
+    vtkSmartPointer<vtkImageData> mapped = ReadImage(filename, true);
+    if (!CheckImage(mapped))
+    {
+      return EXIT_FAILURE;
+    }
+
+    // Sub-extents are copied row by row from the mapping.
+    const int extent[6] = { 3, 20, 5, 5, 7, 30 };
+    if (!CheckSubImage(ReadSubImage(filename, extent), extent))
+    {
+      return EXIT_FAILURE;
+    }
+
+    // The mapping is private: changing the arrays must not change the
+    // file read again below.
+    vtkPointData* pd = mapped->GetPointData();
+    pd->GetArray("bytes")->FillComponent(0, 0.0);
+    pd->GetArray("shorts")->FillComponent(0, 0.0);
+    pd->GetArray("doubles")->FillComponent(0, 0.0);
+
+    if (!CheckImage(ReadImage(filename, true)) ||
+        !CheckImage(ReadImage(filename, false)))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,212 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLReadPiecesInParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the partitioned XML readers produce the same output whether
+// they read their pieces one after another or concurrently.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkXMLPImageDataReader.h"
+#include "vtkXMLPUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+const int NumberOfPieces = 8;
+
+bool SameArray(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Write pieces of a column of hexahedra, each piece one layer thick.
+std::string WriteUnstructuredPieces(const std::string& dir)
+{
+  std::ostringstream summary;
+  summary << "<VTKFile type=\"PUnstructuredGrid\" version=\"0.1\">\n"
+          << " <PUnstructuredGrid GhostLevel=\"0\">\n"
+          << "  <PPointData Scalars=\"Height\">\n"
+          << "   <PDataArray type=\"Float32\" Name=\"Height\"/>\n"
+          << "  </PPointData>\n"
+          << "  <PPoints>\n"
+          << "   <PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n"
+          << "  </PPoints>\n";
+
+  for (int piece = 0; piece < NumberOfPieces; ++piece)
+  {
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkFloatArray> height;
+    height->SetName("Height");
+    for (int k = 0; k < 2; ++k)
+    {
+      for (int j = 0; j < 2; ++j)
+      {
+        for (int i = 0; i < 2; ++i)
+        {
+          points->InsertNextPoint(i, j, piece + k);
+          height->InsertNextValue(static_cast<float>(piece + k));
+        }
+      }
+    }
+    vtkNew<vtkUnstructuredGrid> grid;
+    grid->SetPoints(points);
+    grid->GetPointData()->SetScalars(height);
+    vtkIdType hex[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+
+    std::ostringstream name;
+    name << "ReadPiecesInParallel_" << piece << ".vtu";
+    vtkNew<vtkXMLUnstructuredGridWriter> writer;
+    writer->SetInputData(grid);
+    writer->SetFileName((dir + "/" + name.str()).c_str());
+    writer->Write();
+    summary << "  <Piece Source=\"" << name.str() << "\"/>\n";
+  }
+  summary << " </PUnstructuredGrid>\n</VTKFile>\n";
+
+  std::string fileName = dir + "/ReadPiecesInParallel.pvtu";
+  std::ofstream out(fileName.c_str());
+  out << summary.str();
+  return fileName;
+}
+
+// Write pieces of an image split along z, sharing their boundary slices.
+std::string WriteImagePieces(const std::string& dir)
+{
+  const int slices = 4;
+  std::ostringstream summary;
+  summary << "<VTKFile type=\"PImageData\" version=\"0.1\">\n"
+          << " <PImageData WholeExtent=\"0 9 0 9 0 " << NumberOfPieces * slices
+          << "\" GhostLevel=\"0\" Origin=\"0 0 0\" Spacing=\"1 1 1\">\n"
+          << "  <PPointData Scalars=\"Index\">\n"
+          << "   <PDataArray type=\"Float32\" Name=\"Index\"/>\n"
+          << "  </PPointData>\n";
+
+  for (int piece = 0; piece < NumberOfPieces; ++piece)
+  {
+    int extent[6] = { 0, 9, 0, 9, piece * slices, (piece + 1) * slices };
+    vtkNew<vtkImageData> image;
+    image->SetExtent(extent);
+    vtkNew<vtkFloatArray> index;
+    index->SetName("Index");
+    index->SetNumberOfTuples(image->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+      double x[3];
+      image->GetPoint(i, x);
+      index->SetValue(i, static_cast<float>(x[0] + 10 * x[1] + 100 * x[2]));
+    }
+    image->GetPointData()->SetScalars(index);
+
+    std::ostringstream name;
+    name << "ReadPiecesInParallel_" << piece << ".vti";
+    vtkNew<vtkXMLImageDataWriter> writer;
+    writer->SetInputData(image);
+    writer->SetFileName((dir + "/" + name.str()).c_str());
+    writer->Write();
+    summary << "  <Piece Extent=\"" << extent[0] << " " << extent[1] << " "
+            << extent[2] << " " << extent[3] << " " << extent[4] << " "
+            << extent[5] << "\" Source=\"" << name.str() << "\"/>\n";
+  }
+  summary << " </PImageData>\n</VTKFile>\n";
+
+  std::string fileName = dir + "/ReadPiecesInParallel.pvti";
+  std::ofstream out(fileName.c_str());
+  out << summary.str();
+  return fileName;
+}
+}
+
+int TestXMLReadPiecesInParallel(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string dir = tempDir;
+  delete[] tempDir;
+
+  std::string pvtu = WriteUnstructuredPieces(dir);
+  vtkNew<vtkXMLPUnstructuredGridReader> serialGridReader;
+  serialGridReader->SetFileName(pvtu.c_str());
+  serialGridReader->Update();
+  vtkNew<vtkXMLPUnstructuredGridReader> parallelGridReader;
+  parallelGridReader->SetFileName(pvtu.c_str());
+  parallelGridReader->ReadPiecesInParallelOn();
+  parallelGridReader->Update();
+
+  vtkUnstructuredGrid* serialGrid = serialGridReader->GetOutput();
+  vtkUnstructuredGrid* parallelGrid = parallelGridReader->GetOutput();
+  if (serialGrid->GetNumberOfCells() != NumberOfPieces ||
+    parallelGrid->GetNumberOfCells() != NumberOfPieces ||
+    !SameArray(serialGrid->GetPoints()->GetData(), parallelGrid->GetPoints()->GetData()) ||
+    !SameArray(serialGrid->GetPointData()->GetScalars(), parallelGrid->GetPointData()->GetScalars()))
+  {
+    cerr << "Unstructured grid pieces read in parallel differ" << endl;
+    return EXIT_FAILURE;
+  }
+  vtkIdTypeArray* serialCells = serialGrid->GetCells()->GetData();
+  vtkIdTypeArray* parallelCells = parallelGrid->GetCells()->GetData();
+  if (!SameArray(serialCells, parallelCells))
+  {
+    cerr << "Unstructured grid cells read in parallel differ" << endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string pvti = WriteImagePieces(dir);
+  vtkNew<vtkXMLPImageDataReader> serialImageReader;
+  serialImageReader->SetFileName(pvti.c_str());
+  serialImageReader->Update();
+  vtkNew<vtkXMLPImageDataReader> parallelImageReader;
+  parallelImageReader->SetFileName(pvti.c_str());
+  parallelImageReader->ReadPiecesInParallelOn();
+  parallelImageReader->Update();
+
+  vtkImageData* serialImage = serialImageReader->GetOutput();
+  vtkImageData* parallelImage = parallelImageReader->GetOutput();
+  if (serialImage->GetNumberOfPoints() != 10 * 10 * (NumberOfPieces * 4 + 1) ||
+    !SameArray(serialImage->GetPointData()->GetScalars(), parallelImage->GetPointData()->GetScalars()))
+  {
+    cerr << "Image pieces read in parallel differ" << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
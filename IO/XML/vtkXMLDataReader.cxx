@@ -249,6 +249,22 @@ void vtkXMLDataReader::DestroyPieces()
 }
 
 
+//----------------------------------------------------------------------------
+void vtkXMLDataReader::SetupOutputArray(vtkXMLDataElement* eNested,
+                                        vtkAbstractArray* array,
+                                        vtkIdType numTuples)
+{
+  // An array stored whole in a single piece can use the mapped file data
+  // instead of being allocated.  Time dependent arrays are allocated
+  // since the element of the time step read is not known yet.
+  vtkIdType numValues = numTuples * array->GetNumberOfComponents();
+  if (this->NumberOfPieces != 1 || eNested->GetAttribute("TimeStep") ||
+      !this->MapArrayValues(eNested, array, numValues))
+  {
+    array->SetNumberOfTuples(numTuples);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLDataReader::SetupOutputData()
 {
@@ -284,7 +300,7 @@ void vtkXMLDataReader::SetupOutputData()
         vtkAbstractArray* array = this->CreateArray(eNested);
         if (array)
         {
-          array->SetNumberOfTuples(pointTuples);
+          this->SetupOutputArray(eNested, array, pointTuples);
           pointData->AddArray(array);
           array->Delete();
         }
@@ -312,7 +328,7 @@ void vtkXMLDataReader::SetupOutputData()
         vtkAbstractArray* array = this->CreateArray(eNested);
         if (array)
         {
-          array->SetNumberOfTuples(cellTuples);
+          this->SetupOutputArray(eNested, array, cellTuples);
           cellData->AddArray(array);
           array->Delete();
         }
@@ -125,6 +125,10 @@ private:
   std::unique_ptr<MapStringToInt64> CellDataOffset;
   int CellDataNeedToReadTimeStep(vtkXMLDataElement *eNested);
 
+  // Allocate an output array, or map it if it is read whole.
+  void SetupOutputArray(vtkXMLDataElement* eNested, vtkAbstractArray* array,
+                        vtkIdType numTuples);
+
   vtkXMLDataReader(const vtkXMLDataReader&) = delete;
   void operator=(const vtkXMLDataReader&) = delete;
 
@@ -22,18 +22,39 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataReader.h"
 
 #include <cassert>
 #include <sstream>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// Updates the readers of several pieces at once.
+class vtkXMLPDataReaderUpdatePieces
+{
+public:
+  vtkXMLPDataReader* Reader;
+  const int* Pieces;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Reader->UpdatePieceReader(this->Pieces[i]);
+    }
+  }
+};
 
 //----------------------------------------------------------------------------
 vtkXMLPDataReader::vtkXMLPDataReader()
 {
   this->GhostLevel = 0;
   this->PieceReaders = nullptr;
+  this->ReadPiecesInParallel = 0;
+  this->UpdatingPiecesInParallel = false;
 }
 
 //----------------------------------------------------------------------------
@@ -50,6 +71,7 @@ void vtkXMLPDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "NumberOfPieces: " << this->NumberOfPieces << "\n";
+  os << indent << "ReadPiecesInParallel: " << this->ReadPiecesInParallel << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -317,14 +339,43 @@ int vtkXMLPDataReader::ReadPieceData(int index)
   }
 
   // Actually read the data.
-  this->PieceReaders[this->Piece]->SetAbortExecute(0);
-  vtkDataArraySelection* pds = this->PieceReaders[this->Piece]->GetPointDataArraySelection();
-  vtkDataArraySelection* cds = this->PieceReaders[this->Piece]->GetCellDataArraySelection();
-  pds->CopySelections(this->PointDataArraySelection);
-  cds->CopySelections(this->CellDataArraySelection);
+  this->SetupPieceReader(this->Piece);
   return this->ReadPieceData();
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLPDataReader::SetupPieceReader(int index)
+{
+  vtkXMLDataReader* reader = this->PieceReaders[index];
+  reader->SetAbortExecute(0);
+  reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
+  reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPDataReader::UpdatePieceReadersInParallel(int numberOfPieces, const int* pieces)
+{
+  // Everything that may modify this reader, like dropping pieces that
+  // cannot be read, happens here before the threads start.
+  std::vector<int> readablePieces;
+  for (int i = 0; i < numberOfPieces; ++i)
+  {
+    if (this->CanReadPiece(pieces[i]))
+    {
+      this->SetupPieceReader(pieces[i]);
+      readablePieces.push_back(pieces[i]);
+    }
+  }
+
+  // One piece per task, pieces can differ a lot in size.
+  vtkXMLPDataReaderUpdatePieces functor;
+  functor.Reader = this;
+  functor.Pieces = readablePieces.data();
+  this->UpdatingPiecesInParallel = true;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(readablePieces.size()), 1, functor);
+  this->UpdatingPiecesInParallel = false;
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLPDataReader::ReadPieceData()
 {
@@ -382,6 +433,10 @@ int vtkXMLPDataReader::CanReadPiece(int index)
 //----------------------------------------------------------------------------
 void vtkXMLPDataReader::PieceProgressCallback()
 {
+  if (this->UpdatingPiecesInParallel)
+  {
+    return;
+  }
   float width = this->ProgressRange[1] - this->ProgressRange[0];
   float pieceProgress = this->PieceReaders[this->Piece]->GetProgress();
   float progress = this->ProgressRange[0] + pieceProgress * width;
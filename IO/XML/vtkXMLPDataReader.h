@@ -33,6 +33,7 @@
 class vtkDataArray;
 class vtkDataSet;
 class vtkXMLDataReader;
+class vtkXMLPDataReaderUpdatePieces;
 
 class VTKIOXML_EXPORT vtkXMLPDataReader : public vtkXMLPDataObjectReader
 {
@@ -46,6 +47,18 @@ public:
   */
   void CopyOutputInformation(vtkInformation* outInfo, int port) override;
 
+  //@{
+  /**
+   * Read the pieces needed for a request concurrently, each with its own
+   * piece reader, instead of one after another. The pieces are still
+   * copied into the output in order once they have all been read. No
+   * progress is reported while the pieces are being read. Off by default.
+   */
+  vtkSetMacro(ReadPiecesInParallel, vtkTypeBool);
+  vtkGetMacro(ReadPiecesInParallel, vtkTypeBool);
+  vtkBooleanMacro(ReadPiecesInParallel, vtkTypeBool);
+  //@}
+
 protected:
   vtkXMLPDataReader();
   ~vtkXMLPDataReader() override;
@@ -107,6 +120,27 @@ protected:
    */
   virtual int ReadPieceData();
 
+  /**
+   * Pass the array selections on to the reader of the given piece.
+   */
+  void SetupPieceReader(int index);
+
+  /**
+   * Update the readers of the given pieces concurrently through
+   * UpdatePieceReader. A piece must not be listed twice. Reading the same
+   * piece again afterwards finds its data up to date, so the pieces can
+   * then be copied into the output as usual.
+   */
+  void UpdatePieceReadersInParallel(int numberOfPieces, const int* pieces);
+
+  /**
+   * Update the reader of the given piece with the request the current
+   * update needs from it. Called from several threads at once by
+   * UpdatePieceReadersInParallel, so it must not modify this reader. It
+   * needs to be overridden by subclasses that support ReadPiecesInParallel.
+   */
+  virtual void UpdatePieceReader(int vtkNotUsed(piece)) {}
+
   /**
    * Read the information relative to the dataset and allocate the needed structures according to it
    */
@@ -136,7 +170,17 @@ protected:
   vtkXMLDataElement* PPointDataElement;
   vtkXMLDataElement* PCellDataElement;
 
+  vtkTypeBool ReadPiecesInParallel;
+
+  /**
+  * Set while UpdatePieceReadersInParallel runs, when piece progress
+  * must not be forwarded.
+  */
+  bool UpdatingPiecesInParallel;
+
 private:
+  friend class vtkXMLPDataReaderUpdatePieces;
+
   vtkXMLPDataReader(const vtkXMLPDataReader&) = delete;
   void operator=(const vtkXMLPDataReader&) = delete;
 };
@@ -24,6 +24,7 @@
 #include "vtkXMLStructuredDataReader.h"
 
 #include <sstream>
+#include <vector>
 
 
 //----------------------------------------------------------------------------
@@ -136,6 +137,28 @@ void vtkXMLPStructuredDataReader::ReadXMLData()
     fractions[i] = fractions[i] / fractions[n];
   }
 
+  // Read all pieces at once if requested. The loop below then finds them
+  // up to date and only copies them into the output. A piece providing
+  // more than one sub-extent is left to the loop.
+  if (this->ReadPiecesInParallel)
+  {
+    std::vector<int> subExtentCount(this->NumberOfPieces, 0);
+    for (i = 0; i < n; ++i)
+    {
+      ++subExtentCount[this->ExtentSplitter->GetSubExtentSource(i)];
+    }
+    std::vector<int> pieces;
+    for (i = 0; i < n; ++i)
+    {
+      int piece = this->ExtentSplitter->GetSubExtentSource(i);
+      if (subExtentCount[piece] == 1)
+      {
+        pieces.push_back(piece);
+      }
+    }
+    this->UpdatePieceReadersInParallel(static_cast<int>(pieces.size()), pieces.data());
+  }
+
   // Read the data needed from each sub-extent.
   for(i=0;(i < n && !this->AbortExecute && !this->DataError);++i)
   {
@@ -302,6 +325,23 @@ int vtkXMLPStructuredDataReader::ReadPieceData()
   return this->Superclass::ReadPieceData();
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLPStructuredDataReader::UpdatePieceReader(int piece)
+{
+  // Request the sub-extent read from this piece, which is unique.
+  int n = this->ExtentSplitter->GetNumberOfSubExtents();
+  for (int i = 0; i < n; ++i)
+  {
+    if (this->ExtentSplitter->GetSubExtentSource(i) == piece)
+    {
+      int subExtent[6];
+      this->ExtentSplitter->GetSubExtent(i, subExtent);
+      this->PieceReaders[piece]->UpdateExtent(subExtent);
+      return;
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLPStructuredDataReader::CopyArrayForPoints(vtkDataArray* inArray,
                                                      vtkDataArray* outArray)
@@ -64,6 +64,7 @@ protected:
   void DestroyPieces() override;
   int ReadPiece(vtkXMLDataElement* ePiece) override;
   int ReadPieceData() override;
+  void UpdatePieceReader(int piece) override;
   void CopySubExtent(int* inExtent, int* inDimensions, vtkIdType* inIncrements,
                      int* outExtent,int* outDimensions,vtkIdType* outIncrements,
                      int* subExtent, int* subDimensions,
@@ -21,6 +21,7 @@
 #include "vtkInformationVector.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vector>
 
 //----------------------------------------------------------------------------
 vtkXMLPUnstructuredDataReader::vtkXMLPUnstructuredDataReader()
@@ -309,6 +310,18 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
       fractions[this->EndPiece-this->StartPiece];
   }
 
+  // Read all pieces at once if requested. The loop below then finds them
+  // up to date and only copies them into the output.
+  if (this->ReadPiecesInParallel)
+  {
+    std::vector<int> pieces;
+    for (int i = this->StartPiece; i < this->EndPiece; ++i)
+    {
+      pieces.push_back(i);
+    }
+    this->UpdatePieceReadersInParallel(static_cast<int>(pieces.size()), pieces.data());
+  }
+
   // Read the data needed from each piece.
   for(int i = this->StartPiece;
     (i < this->EndPiece && !this->AbortExecute && !this->DataError); ++i)
@@ -327,6 +340,12 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
   delete [] fractions;
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLPUnstructuredDataReader::UpdatePieceReader(int piece)
+{
+  this->PieceReaders[piece]->UpdatePiece(0, 1, this->UpdateGhostLevel);
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLPUnstructuredDataReader::ReadPieceData()
 {
@@ -75,6 +75,7 @@ protected:
   void SetupUpdateExtent(int piece, int numberOfPieces, int ghostLevel);
 
   int ReadPieceData() override;
+  void UpdatePieceReader(int piece) override;
   void CopyCellArray(vtkIdType totalNumberOfCells, vtkCellArray* inCells,
                      vtkCellArray* outCells);
 
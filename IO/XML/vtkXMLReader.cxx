@@ -15,6 +15,7 @@
 #include "vtkXMLReader.h"
 
 #include "vtkArrayIteratorIncludes.h"
+#include "vtkByteSwap.h"
 #include "vtkCallbackCommand.h"
 #include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
@@ -48,12 +49,23 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <functional>
 #include <locale> // C++ locale
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <vector>
 #include <cctype>
 
+#if !defined(_WIN32)
+#define VTK_XML_READER_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 vtkCxxSetObjectMacro(vtkXMLReader,ReaderErrorObserver,vtkCommand);
 vtkCxxSetObjectMacro(vtkXMLReader,ParserErrorObserver,vtkCommand);
 
@@ -126,8 +138,22 @@ static void ReadStringVersion(const char* version, int& major, int& minor)
     }
   }
 }
+//----------------------------------------------------------------------------
+// The appended data blocks mapped during the current read, by offset.
+struct vtkXMLReader::MappedBlock
+{
+  void* Data;
+  vtkIdType NumberOfValues;
+};
+
+class vtkXMLReader::MapOffsetToMappedBlock
+  : public std::map<vtkTypeInt64, vtkXMLReader::MappedBlock>
+{
+};
+
 //----------------------------------------------------------------------------
 vtkXMLReader::vtkXMLReader()
+  : MappedBlocks(new MapOffsetToMappedBlock)
 {
   this->FileName = nullptr;
   this->Stream = nullptr;
@@ -135,6 +161,7 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->MemoryMapAppendedData = 0;
   this->XMLParser = nullptr;
   this->ReaderErrorObserver = nullptr;
   this->ParserErrorObserver = nullptr;
@@ -192,6 +219,7 @@ vtkXMLReader::~vtkXMLReader()
     this->DestroyXMLParser();
   }
   this->CloseStream();
+  this->ReleaseMappedBlocks();
   this->CellDataArraySelection->RemoveObserver(this->SelectionObserver);
   this->PointDataArraySelection->RemoveObserver(this->SelectionObserver);
   this->ColumnArraySelection->RemoveObserver(this->SelectionObserver);
@@ -230,6 +258,8 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Stream: (none)\n";
   }
+  os << indent << "MemoryMapAppendedData: "
+     << this->MemoryMapAppendedData << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << ","
@@ -703,8 +733,10 @@ int vtkXMLReader::RequestData(vtkInformation *vtkNotUsed(request),
   // We have finished reading.
   this->UpdateProgressDiscrete(1);
 
-  // Close the input stream to prevent resource leaks.
+  // Close the input stream to prevent resource leaks.  The arrays keep
+  // the mappings they use.
   this->CloseStream();
+  this->ReleaseMappedBlocks();
   if( this->TimeSteps )
   {
     // The SetupOutput should not reallocate this should be done only in a TimeStep case
@@ -857,6 +889,273 @@ int vtkXMLDataReaderReadArrayValues(
 
 }
 
+#ifdef VTK_XML_READER_USE_MMAP
+namespace
+{
+//----------------------------------------------------------------------------
+// A file mapping of an appended data block.  It is shared by the reader
+// that mapped it and the arrays using it, and is released by the last
+// of them.  The free function of an array only receives the data
+// pointer, so the mapping containing it is looked up by that pointer.
+struct vtkXMLReaderMapping
+{
+  void* Address;
+  size_t Length;
+  int References;
+};
+
+std::mutex& vtkXMLReaderMappingsMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<void*, vtkXMLReaderMapping>& vtkXMLReaderMappings()
+{
+  static std::map<void*, vtkXMLReaderMapping> mappings;
+  return mappings;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLReaderRegisterMapping(void* data)
+{
+  std::lock_guard<std::mutex> lock(vtkXMLReaderMappingsMutex());
+  std::map<void*, vtkXMLReaderMapping>::iterator i =
+    vtkXMLReaderMappings().find(data);
+  if (i != vtkXMLReaderMappings().end())
+  {
+    i->second.References++;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLReaderUnmapArray(void* data)
+{
+  vtkXMLReaderMapping mapping;
+  {
+    std::lock_guard<std::mutex> lock(vtkXMLReaderMappingsMutex());
+    std::map<void*, vtkXMLReaderMapping>::iterator i =
+      vtkXMLReaderMappings().find(data);
+    if (i == vtkXMLReaderMappings().end() || --i->second.References > 0)
+    {
+      return;
+    }
+    mapping = i->second;
+    vtkXMLReaderMappings().erase(i);
+  }
+  munmap(mapping.Address, mapping.Length);
+}
+
+//----------------------------------------------------------------------------
+// Map length bytes of the file starting at the given position.  The
+// mapping is private, so writes to it never reach the file.
+void* vtkXMLReaderMapArray(const char* fileName, vtkTypeInt64 position,
+                           size_t length)
+{
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+  {
+    return nullptr;
+  }
+
+  // Accessing a mapped page past the end of the file raises SIGBUS.
+  struct stat fs;
+  if (fstat(fd, &fs) != 0 ||
+      static_cast<vtkTypeInt64>(fs.st_size) < position ||
+      static_cast<vtkTypeUInt64>(fs.st_size - position) < length)
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  // The mapping must start on a page boundary.
+  vtkTypeInt64 pageSize = static_cast<vtkTypeInt64>(sysconf(_SC_PAGESIZE));
+  vtkTypeInt64 start = position - position % pageSize;
+  size_t lead = static_cast<size_t>(position - start);
+
+  void* address = mmap(nullptr, lead + length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE, fd, static_cast<off_t>(start));
+  close(fd);
+  if (address == MAP_FAILED)
+  {
+    return nullptr;
+  }
+
+  void* data = static_cast<char*>(address) + lead;
+  vtkXMLReaderMapping mapping = { address, lead + length, 1 };
+  std::lock_guard<std::mutex> lock(vtkXMLReaderMappingsMutex());
+  vtkXMLReaderMappings()[data] = mapping;
+  return data;
+}
+}
+#endif
+
+//----------------------------------------------------------------------------
+void* vtkXMLReader::MapAppendedBlock(vtkXMLDataElement* da,
+                                     vtkAbstractArray* array,
+                                     vtkIdType& numValues)
+{
+  numValues = 0;
+#ifdef VTK_XML_READER_USE_MMAP
+  // Only arrays stored contiguously in memory can use the file data.
+  vtkDataArray* dataArray = vtkArrayDownCast<vtkDataArray>(array);
+  vtkTypeInt64 offset = 0;
+  if (!this->MemoryMapAppendedData || !this->FileStream || !this->FileName ||
+      !dataArray || !dataArray->HasStandardMemoryLayout() ||
+      dataArray->GetDataType() == VTK_BIT ||
+      !da->GetScalarAttribute("offset", offset))
+  {
+    return nullptr;
+  }
+
+  MapOffsetToMappedBlock::iterator i = this->MappedBlocks->find(offset);
+  if (i != this->MappedBlocks->end())
+  {
+    numValues = i->second.NumberOfValues;
+    return i->second.Data;
+  }
+
+  // The block must be stored raw and be aligned for the value type.
+  // Blocks that cannot be mapped are remembered as well.
+  MappedBlock& block = (*this->MappedBlocks)[offset];
+  block.Data = nullptr;
+  block.NumberOfValues = 0;
+  size_t wordSize = static_cast<size_t>(dataArray->GetDataTypeSize());
+  vtkTypeInt64 position = 0;
+  vtkTypeUInt64 size = 0;
+  if (wordSize == 0 ||
+      !this->XMLParser->FindRawAppendedData(offset, position, size) ||
+      size < wordSize || position % static_cast<vtkTypeInt64>(wordSize) != 0)
+  {
+    return nullptr;
+  }
+  size_t n = static_cast<size_t>(size / wordSize);
+
+  void* data = vtkXMLReaderMapArray(this->FileName, position, n * wordSize);
+  if (!data)
+  {
+    return nullptr;
+  }
+
+  // Only data in a foreign byte order need to be touched now.
+  int byteOrder = this->XMLParser->GetByteOrder();
+#ifdef VTK_WORDS_BIGENDIAN
+  if (byteOrder != vtkXMLDataParser::BigEndian)
+#else
+  if (byteOrder != vtkXMLDataParser::LittleEndian)
+#endif
+  {
+    bool bigEndian = (byteOrder == vtkXMLDataParser::BigEndian);
+    switch (wordSize)
+    {
+      case 1: break;
+      case 2:
+        bigEndian ? vtkByteSwap::Swap2BERange(data, n)
+                  : vtkByteSwap::Swap2LERange(data, n);
+        break;
+      case 4:
+        bigEndian ? vtkByteSwap::Swap4BERange(data, n)
+                  : vtkByteSwap::Swap4LERange(data, n);
+        break;
+      case 8:
+        bigEndian ? vtkByteSwap::Swap8BERange(data, n)
+                  : vtkByteSwap::Swap8LERange(data, n);
+        break;
+      default:
+        vtkXMLReaderUnmapArray(data);
+        return nullptr;
+    }
+  }
+
+  block.Data = data;
+  block.NumberOfValues = static_cast<vtkIdType>(n);
+  numValues = block.NumberOfValues;
+  return data;
+#else
+  (void)da;
+  (void)array;
+  return nullptr;
+#endif
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLReader::MapArrayValues(vtkXMLDataElement* da,
+                                 vtkAbstractArray* array,
+                                 vtkIdType numValues)
+{
+#ifdef VTK_XML_READER_USE_MMAP
+  vtkIdType blockValues = 0;
+  void* data = this->MapAppendedBlock(da, array, blockValues);
+  if (!data || numValues == 0 || blockValues != numValues)
+  {
+    return 0;
+  }
+  if (array->GetNumberOfValues() == numValues &&
+      array->GetVoidPointer(0) == data)
+  {
+    return 1;
+  }
+
+  vtkXMLReaderRegisterMapping(data);
+  vtkDataArray* dataArray = vtkArrayDownCast<vtkDataArray>(array);
+  dataArray->SetVoidArray(data, numValues, 0,
+                          vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  dataArray->SetArrayFreeFunction(vtkXMLReaderUnmapArray);
+  return 1;
+#else
+  (void)da;
+  (void)array;
+  (void)numValues;
+  return 0;
+#endif
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLReader::ReadMappedArrayValues(
+  vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
+  vtkIdType startIndex, vtkIdType numValues)
+{
+  vtkIdType blockValues = 0;
+  char* data =
+    static_cast<char*>(this->MapAppendedBlock(da, array, blockValues));
+  if (!data || startIndex < 0 || startIndex + numValues > blockValues)
+  {
+    return 0;
+  }
+
+  // Arrays read as a whole use the mapping, other ranges are copied.
+  if (arrayIndex == 0 && startIndex == 0 &&
+      numValues == array->GetNumberOfValues())
+  {
+    return this->MapArrayValues(da, array, numValues);
+  }
+  size_t wordSize = static_cast<size_t>(array->GetDataTypeSize());
+  void* source = data + static_cast<size_t>(startIndex) * wordSize;
+  void* target = array->GetVoidPointer(arrayIndex);
+  if (target != source)
+  {
+    memcpy(target, source, static_cast<size_t>(numValues) * wordSize);
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLReader::ReleaseMappedBlocks()
+{
+#ifdef VTK_XML_READER_USE_MMAP
+  for (MapOffsetToMappedBlock::iterator i = this->MappedBlocks->begin();
+       i != this->MappedBlocks->end(); ++i)
+  {
+    if (i->second.Data)
+    {
+      vtkXMLReaderUnmapArray(i->second.Data);
+    }
+  }
+#endif
+  this->MappedBlocks->clear();
+}
+
+
 //----------------------------------------------------------------------------
 int vtkXMLReader::ReadArrayValues(
   vtkXMLDataElement* da, vtkIdType arrayIndex,
@@ -870,18 +1169,26 @@ int vtkXMLReader::ReadArrayValues(
   }
   this->InReadData = 1;
   int result;
-  vtkArrayIterator* iter = array->NewIterator();
-  switch (array->GetDataType())
+  if (this->ReadMappedArrayValues(da, arrayIndex, array, startIndex,
+                                  numValues))
   {
-    vtkArrayIteratorTemplateMacro(
-      result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-        arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-  default:
-    result = 0;
+    result = 1;
   }
-  if (iter)
+  else
   {
-    iter->Delete();
+    vtkArrayIterator* iter = array->NewIterator();
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(
+        result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
+          arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
+    default:
+      result = 0;
+    }
+    if (iter)
+    {
+      iter->Delete();
+    }
   }
 
   this->ConvertGhostLevelsToGhostType(fieldType, array, startIndex, numValues);
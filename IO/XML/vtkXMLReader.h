@@ -27,6 +27,7 @@
 #include "vtkIOXMLModule.h" // For export macro
 #include "vtkAlgorithm.h"
 
+#include <memory> // for std::unique_ptr
 #include <string> // for std::string
 
 class vtkAbstractArray;
@@ -72,6 +73,27 @@ public:
   void SetInputString(const std::string& s) { this->InputString = s; }
   //@}
 
+  //@{
+  /**
+   * Enable memory mapping of arrays stored raw in the appended data
+   * section, as written with EncodeAppendedData off and no compressor.
+   * The block of each array is then mapped once into a private
+   * read-write mapping of the file.  An array read as a whole points
+   * directly into the mapping and is never allocated, so only the pages
+   * actually accessed are read from disk; the mapping is released when
+   * the array releases its memory.  Parts of arrays, as read for
+   * sub-extents or several pieces, are copied from the mapping.  Arrays
+   * whose data are not aligned for their type in the file are read as
+   * usual.  Data in a foreign byte order are swapped in place, which
+   * touches the whole block.  The file must not be truncated while
+   * arrays still use it.  This is only supported on POSIX systems and
+   * is off by default.
+   */
+  vtkSetMacro(MemoryMapAppendedData, vtkTypeBool);
+  vtkGetMacro(MemoryMapAppendedData, vtkTypeBool);
+  vtkBooleanMacro(MemoryMapAppendedData, vtkTypeBool);
+  //@}
+
   /**
    * Test whether the file (type) with the given name can be read by this
    * reader. If the file has a newer version than the reader, we still say
@@ -284,6 +306,28 @@ protected:
     vtkXMLDataElement* da, vtkIdType arrayIndex, vtkAbstractArray* array,
     vtkIdType startIndex, vtkIdType numValues, FieldType type = OTHER);
 
+  // Map the raw appended data block of the array element, once per read.
+  // Returns the start of the block and its number of values, or nullptr
+  // if the block cannot be mapped.
+  void* MapAppendedBlock(vtkXMLDataElement* da, vtkAbstractArray* array,
+                         vtkIdType& numValues);
+
+  // Make the array use its mapped block directly if the block holds
+  // exactly numValues values.  This can be done before the array is allocated.  Returns
+  // 0 if the array must be allocated and read instead.
+  int MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array,
+                     vtkIdType numValues);
+
+  // Read a range of values of the array from its mapped block.  Returns
+  // 0 if the values must be read from the stream instead.
+  int ReadMappedArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
+                            vtkAbstractArray* array, vtkIdType startIndex,
+                            vtkIdType numValues);
+
+  // Release the blocks mapped during the read.  The arrays using them
+  // keep them mapped.
+  void ReleaseMappedBlocks();
+
   // Setup the data array selections for the input's set of arrays.
   void SetDataArraySelections(vtkXMLDataElement* eDSA,
                               vtkDataArraySelection* sel);
@@ -322,6 +366,9 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether raw appended arrays are memory mapped instead of read.
+  vtkTypeBool MemoryMapAppendedData;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
@@ -408,6 +455,11 @@ private:
   vtkDataObject* CurrentOutput;
   vtkInformation* CurrentOutputInformation;
 
+  // The appended data blocks mapped during the current read.
+  struct MappedBlock;
+  class MapOffsetToMappedBlock;
+  std::unique_ptr<MapOffsetToMappedBlock> MappedBlocks;
+
 private:
   vtkXMLReader(const vtkXMLReader&) = delete;
   void operator=(const vtkXMLReader&) = delete;
@@ -44,6 +44,7 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -62,9 +63,11 @@
 #include "vtkXMLReaderVersion.h"
 #include <memory>
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 # include <unistd.h> /* unlink */
@@ -75,6 +78,97 @@
 #include <cctype> // for isalnum
 #include <locale> // C++ locale
 
+//*****************************************************************************
+// Blocks waiting to be compressed together, and the buffers receiving
+// their compressed form.  A block either stays in the array being
+// written or, when it had to be converted, in a staging buffer of the
+// batch.  The buffers are kept between batches so that steady-state
+// writing does not allocate.
+class vtkXMLWriterCompressionBatch
+{
+public:
+  vtkXMLWriterCompressionBatch()
+    : NumberOfBlocks(0), MaximumNumberOfBlocks(0)
+  {
+  }
+
+  void Initialize(size_t maximumNumberOfBlocks)
+  {
+    this->MaximumNumberOfBlocks = maximumNumberOfBlocks;
+    this->Staging.resize(maximumNumberOfBlocks);
+    this->Uncompressed.resize(maximumNumberOfBlocks);
+    this->UncompressedSizes.resize(maximumNumberOfBlocks);
+    this->Compressed.resize(maximumNumberOfBlocks);
+    this->CompressedSizes.resize(maximumNumberOfBlocks);
+    this->NumberOfBlocks = 0;
+  }
+
+  // Buffer of at least the given size for the next block.  It is only
+  // grown, so data already staged for this block are kept.
+  unsigned char* GetStagingBuffer(size_t size)
+  {
+    std::vector<unsigned char>& buffer = this->Staging[this->NumberOfBlocks];
+    if (buffer.size() < size)
+    {
+      buffer.resize(size);
+    }
+    return buffer.data();
+  }
+
+  void AddBlock(const unsigned char* data, size_t size, size_t space)
+  {
+    size_t i = this->NumberOfBlocks++;
+    this->Uncompressed[i] = data;
+    this->UncompressedSizes[i] = size;
+    this->Compressed[i].resize(space);
+    this->CompressedSizes[i] = 0;
+  }
+
+  bool IsFull() const
+  {
+    return this->NumberOfBlocks >= this->MaximumNumberOfBlocks;
+  }
+
+  void Reset() { this->NumberOfBlocks = 0; }
+
+  std::vector<std::vector<unsigned char> > Staging;
+  std::vector<const unsigned char*> Uncompressed;
+  std::vector<size_t> UncompressedSizes;
+  std::vector<std::vector<unsigned char> > Compressed;
+  std::vector<size_t> CompressedSizes;
+  size_t NumberOfBlocks;
+  size_t MaximumNumberOfBlocks;
+};
+
+//*****************************************************************************
+// Compress the blocks of a batch.  This runs on several threads only
+// when vtkDataCompressor::IsThreadSafe allows it.
+class vtkXMLWriterCompressBlocks
+{
+public:
+  vtkXMLWriterCompressBlocks(vtkDataCompressor* compressor,
+                             vtkXMLWriterCompressionBatch* batch)
+    : Compressor(compressor), Batch(batch)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      std::vector<unsigned char>& out = this->Batch->Compressed[i];
+      this->Batch->CompressedSizes[i] =
+        this->Compressor->Compress(this->Batch->Uncompressed[i],
+                                   this->Batch->UncompressedSizes[i],
+                                   out.data(), out.size());
+    }
+  }
+
+private:
+  vtkDataCompressor* Compressor;
+  vtkXMLWriterCompressionBatch* Batch;
+};
+
 //*****************************************************************************
 // Friend class to enable access for template functions to the protected
 // writer methods.
@@ -98,6 +192,18 @@ public:
  {
    return writer->ByteSwapBuffer;
  }
+ // Buffer to fill with the next block.  A compressed block is only
+ // compressed once its batch is full, so it needs a buffer of its own;
+ // otherwise the given buffer is reused for every block.
+ static inline unsigned char* GetBlockBuffer(vtkXMLWriter* writer,
+   unsigned char* buffer, size_t size)
+ {
+   if (writer->Compressor && writer->CompressionBatch)
+   {
+     return writer->CompressionBatch->GetStagingBuffer(size);
+   }
+   return buffer;
+ }
 };
 
 namespace {
@@ -234,13 +340,15 @@ struct WriteBinaryDataBlockWorker
     while (this->Result && (wordsLeft >= blockWords))
     {
       // Copy data to contiguous buffer:
-      ValueType* bufferIter = reinterpret_cast<ValueType*>(&buffer[0]);
+      unsigned char* block = vtkXMLWriterHelper::GetBlockBuffer(
+        this->Writer, &buffer[0], buffer.size());
+      ValueType* bufferIter = reinterpret_cast<ValueType*>(block);
       for (size_t i = 0; i < blockWords; ++i, ++valueIdx)
       {
         *bufferIter++ = array->GetValue(valueIdx);
       }
 
-      if (!vtkXMLWriterHelper::WriteBinaryDataBlock(this->Writer, &buffer[0],
+      if (!vtkXMLWriterHelper::WriteBinaryDataBlock(this->Writer, block,
                                                     blockWords, this->WordType))
       {
         this->Result = false;
@@ -254,13 +362,15 @@ struct WriteBinaryDataBlockWorker
     // Do the last partial block if any.
     if (this->Result && (wordsLeft > 0))
     {
-      ValueType* bufferIter = reinterpret_cast<ValueType*>(&buffer[0]);
+      unsigned char* block = vtkXMLWriterHelper::GetBlockBuffer(
+        this->Writer, &buffer[0], buffer.size());
+      ValueType* bufferIter = reinterpret_cast<ValueType*>(block);
       for (size_t i = 0; i < wordsLeft; ++i, ++valueIdx)
       {
         *bufferIter++ = array->GetValue(valueIdx);
       }
 
-      if (!vtkXMLWriterHelper::WriteBinaryDataBlock(this->Writer, &buffer[0],
+      if (!vtkXMLWriterHelper::WriteBinaryDataBlock(this->Writer, block,
                                                     wordsLeft, this->WordType))
       {
         this->Result = false;
@@ -310,14 +420,16 @@ namespace
     while (worker.Result && (wordsLeft >= blockWords))
     {
       // Copy data to contiguous buffer:
-      ValueType* bufferIter = reinterpret_cast<ValueType*>(&buffer[0]);
+      unsigned char* block = vtkXMLWriterHelper::GetBlockBuffer(
+        worker.Writer, &buffer[0], buffer.size());
+      ValueType* bufferIter = reinterpret_cast<ValueType*>(block);
       for (size_t i = 0; i < blockWords; ++i, ++valueIdx)
       {
         *bufferIter++ = static_cast<ValueType>(
           array->GetComponent(valueIdx/nComponents,valueIdx%nComponents));
       }
 
-      if (!vtkXMLWriterHelper::WriteBinaryDataBlock(worker.Writer, &buffer[0],
+      if (!vtkXMLWriterHelper::WriteBinaryDataBlock(worker.Writer, block,
                                                     blockWords, worker.WordType))
       {
         worker.Result = false;
@@ -331,14 +443,16 @@ namespace
     // Do the last partial block if any.
     if (worker.Result && (wordsLeft > 0))
     {
-      ValueType* bufferIter = reinterpret_cast<ValueType*>(&buffer[0]);
+      unsigned char* block = vtkXMLWriterHelper::GetBlockBuffer(
+        worker.Writer, &buffer[0], buffer.size());
+      ValueType* bufferIter = reinterpret_cast<ValueType*>(block);
       for (size_t i = 0; i < wordsLeft; ++i, ++valueIdx)
       {
         *bufferIter++ = static_cast<ValueType>(
           array->GetComponent(valueIdx/nComponents,valueIdx%nComponents));
       }
 
-      if (!vtkXMLWriterHelper::WriteBinaryDataBlock(worker.Writer, &buffer[0],
+      if (!vtkXMLWriterHelper::WriteBinaryDataBlock(worker.Writer, block,
                                                     wordsLeft, worker.WordType))
       {
         worker.Result = false;
@@ -387,7 +501,11 @@ static int vtkXMLWriterWriteBinaryDataBlocks(
 
   while (result && index < numStrings) // write one block at a time.
   {
-    size_t cur_offset = 0; // offset into the temp_buffer.
+    vtkStdString::value_type* block_buffer =
+      reinterpret_cast<vtkStdString::value_type*>(
+        vtkXMLWriterHelper::GetBlockBuffer(writer,
+          reinterpret_cast<unsigned char*>(temp_buffer), maxCharsPerBlock));
+    size_t cur_offset = 0; // offset into the block_buffer.
     while (index < numStrings && cur_offset < maxCharsPerBlock)
     {
       vtkStdString &str = iter->GetValue(static_cast<vtkIdType>(index));
@@ -398,7 +516,7 @@ static int vtkXMLWriterWriteBinaryDataBlocks(
       if (length == 0)
       {
         // just write the string termination char.
-        temp_buffer[cur_offset++] = 0x0;
+        block_buffer[cur_offset++] = 0x0;
         stringOffset = 0;
         index++; // advance to the next string
       }
@@ -407,9 +525,9 @@ static int vtkXMLWriterWriteBinaryDataBlocks(
         size_t new_offset = cur_offset + length + 1; // (+1) for termination char.
         if (new_offset <= maxCharsPerBlock)
         {
-          memcpy(&temp_buffer[cur_offset], data, length);
+          memcpy(&block_buffer[cur_offset], data, length);
           cur_offset += length;
-          temp_buffer[cur_offset++] = 0x0;
+          block_buffer[cur_offset++] = 0x0;
           stringOffset = 0;
           index++; // advance to the next string
         }
@@ -417,7 +535,7 @@ static int vtkXMLWriterWriteBinaryDataBlocks(
         {
           size_t bytes_to_copy =  (maxCharsPerBlock - cur_offset);
           stringOffset += static_cast<vtkIdType>(bytes_to_copy);
-          memcpy(&temp_buffer[cur_offset], data, bytes_to_copy);
+          memcpy(&block_buffer[cur_offset], data, bytes_to_copy);
           cur_offset += bytes_to_copy;
           // do not advance, only partially written current string
         }
@@ -427,7 +545,7 @@ static int vtkXMLWriterWriteBinaryDataBlocks(
     {
       // We have a block of data to write.
       result = vtkXMLWriterHelper::WriteBinaryDataBlock(writer,
-        reinterpret_cast<unsigned char*>(temp_buffer),
+        reinterpret_cast<unsigned char*>(block_buffer),
         cur_offset, wordType);
       vtkXMLWriterHelper::SetProgressPartial(writer,
         static_cast<float>(index)/numStrings);
@@ -474,6 +592,7 @@ vtkXMLWriter::vtkXMLWriter()
   this->BlockSize = 32768; //2^15
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = nullptr;
+  this->CompressionBatch = nullptr;
   this->Int32IdTypeBuffer = nullptr;
   this->ByteSwapBuffer = nullptr;
 
@@ -510,6 +629,7 @@ vtkXMLWriter::~vtkXMLWriter()
   this->OutStringStream = nullptr;
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
+  delete this->CompressionBatch;
 }
 
 //----------------------------------------------------------------------------
@@ -1330,6 +1450,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the blocks still waiting in the batch.
+    if (result && !this->FlushCompressionBatch())
+    {
+      result = 0;
+    }
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1535,26 +1661,40 @@ int vtkXMLWriter::WriteBinaryDataBlock(unsigned char* in_data,
                                        size_t numWords, int wordType)
 {
   unsigned char* data = in_data;
+
+  // Get the word size of the data buffer.  This is now the size that
+  // will be written.
+  size_t wordSize = this->GetOutputWordTypeSize(wordType);
+
+  // A compressed block waits in the compression batch, so it is
+  // converted and swapped in its own staging buffer instead of the
+  // buffers shared by all blocks.  The data may already be there.
+  unsigned char* blockBuffer = nullptr;
+  if (this->Compressor && (this->Int32IdTypeBuffer || this->ByteSwapBuffer))
+  {
+    blockBuffer = this->CompressionBatch->GetStagingBuffer(numWords*wordSize);
+  }
+
 #ifdef VTK_USE_64BIT_IDS
   // If the type is vtkIdType, it may need to be converted to the type
   // requested for output.
   if ((wordType == VTK_ID_TYPE) && (this->IdType == vtkXMLWriter::Int32))
   {
     vtkIdType* idBuffer = reinterpret_cast<vtkIdType*>(in_data);
+    Int32IdType* outBuffer = blockBuffer ?
+      reinterpret_cast<Int32IdType*>(blockBuffer) : this->Int32IdTypeBuffer;
 
+    // This also works in place: each converted id is stored no later
+    // than the id it comes from.
     for (size_t i = 0; i < numWords; ++i)
     {
-      this->Int32IdTypeBuffer[i] = static_cast<Int32IdType>(idBuffer[i]);
+      outBuffer[i] = static_cast<Int32IdType>(idBuffer[i]);
     }
 
-    data = reinterpret_cast<unsigned char*>(this->Int32IdTypeBuffer);
+    data = reinterpret_cast<unsigned char*>(outBuffer);
   }
 #endif
 
-  // Get the word size of the data buffer.  This is now the size that
-  // will be written.
-  size_t wordSize = this->GetOutputWordTypeSize(wordType);
-
   // If we need to byte swap, do it now.
   if (this->ByteSwapBuffer)
   {
@@ -1562,12 +1702,14 @@ int vtkXMLWriter::WriteBinaryDataBlock(unsigned char* in_data,
     // are already in the byte swap buffer because we share the
     // conversion buffer.  Otherwise, we need to copy the data before
     // byte swapping.
-    if (data != this->ByteSwapBuffer)
+    unsigned char* swapBuffer =
+      blockBuffer ? blockBuffer : this->ByteSwapBuffer;
+    if (data != swapBuffer)
     {
-      memcpy(this->ByteSwapBuffer, data, numWords*wordSize);
-      data = this->ByteSwapBuffer;
+      memcpy(swapBuffer, data, numWords*wordSize);
+      data = swapBuffer;
     }
-    this->PerformByteSwap(this->ByteSwapBuffer, numWords, wordSize);
+    this->PerformByteSwap(swapBuffer, numWords, wordSize);
   }
 
   // Now pass the data to the next write phase.
@@ -1685,32 +1827,91 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
   // Initialize counter for block writing.
   this->CompressionBlockNumber = 0;
 
+  // Prepare the batch of blocks compressed together.  A few blocks per
+  // thread keep the threads busy when the blocks do not compress
+  // equally fast while bounding the memory used.  A compressor that is
+  // not thread safe compresses each block as soon as it is written.
+  if (!this->CompressionBatch)
+  {
+    this->CompressionBatch = new vtkXMLWriterCompressionBatch;
+  }
+  size_t batchSize = 1;
+  if (this->Compressor->IsThreadSafe())
+  {
+    batchSize = static_cast<size_t>(
+      4 * std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+  }
+  this->CompressionBatch->Initialize(batchSize);
+
   return result;
 }
 
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // The data stay either in the array being written or in the staging
+  // buffer of this block until the batch is compressed.
+  this->CompressionBatch->AddBlock(
+    data, size, this->Compressor->GetMaximumCompressionSpace(size));
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+  if (this->CompressionBatch->IsFull())
+  {
+    return this->FlushCompressionBatch();
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBatch()
+{
+  vtkXMLWriterCompressionBatch* batch = this->CompressionBatch;
+  if (!batch || batch->NumberOfBlocks == 0)
+  {
+    return 1;
+  }
+
+  // Compress the blocks of the batch, concurrently if the compressor
+  // allows it.
+  vtkXMLWriterCompressBlocks compressBlocks(this->Compressor, batch);
+  vtkIdType numberOfBlocks = static_cast<vtkIdType>(batch->NumberOfBlocks);
+  if (this->Compressor->IsThreadSafe())
+  {
+    vtkSMPTools::For(0, numberOfBlocks, 1, compressBlocks);
+  }
+  else
+  {
+    compressBlocks(0, numberOfBlocks);
+  }
+
+  // Write the compressed blocks in order.
+  int result = 1;
+  for (size_t i = 0; i < batch->NumberOfBlocks; ++i)
+  {
+    size_t outputSize = batch->CompressedSizes[i];
+    if (outputSize == 0)
+    {
+      vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber);
+      result = 0;
+      break;
+    }
+
+    if (!this->DataStream->Write(batch->Compressed[i].data(), outputSize))
+    {
+      result = 0;
+    }
+
+    // Store the resulting compressed size in the compression header.
+    this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
+  }
+  batch->Reset();
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
   this->Stream->flush();
   if (this->Stream->fail())
   {
     this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 0;
   }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
-
-  outputArray->Delete();
-
   return result;
 }
 
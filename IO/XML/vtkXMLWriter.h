@@ -50,6 +50,7 @@ class vtkPointData;
 class vtkPoints;
 class vtkFieldData;
 class vtkXMLDataHeader;
+class vtkXMLWriterCompressionBatch;
 
 class vtkStdString;
 class OffsetsManager;      // one per piece/per time
@@ -188,7 +189,11 @@ public:
    * Get/Set the block size used in compression.  When reading, this
    * controls the granularity of how much extra information must be
    * read when only part of the data are requested.  The value should
-   * be a multiple of the largest scalar data type.
+   * be a multiple of the largest scalar data type.  When writing
+   * with a compressor whose IsThreadSafe() returns true, a small
+   * number of consecutive blocks are compressed concurrently and then
+   * written in order, so the file contents do not depend on the
+   * number of threads.
    */
   virtual void SetBlockSize(size_t blockSize);
   vtkGetMacro(BlockSize, size_t);
@@ -337,6 +342,8 @@ protected:
   size_t CompressionBlockNumber;
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
+  // Blocks staged for compression on the SMP backend.
+  vtkXMLWriterCompressionBatch* CompressionBatch;
   // Compression Level for vtkDataCompressor objects
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
   int CompressionLevel = 5;
@@ -475,6 +482,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBatch();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
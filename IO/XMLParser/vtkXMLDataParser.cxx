@@ -20,6 +20,7 @@
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
@@ -667,6 +668,49 @@ size_t vtkXMLDataParser::ReadUncompressedData(unsigned char* data,
   return length/wordSize;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Location of one compressed block read as part of a batch.
+struct vtkXMLDataParserBlock
+{
+  size_t CompressedOffset;
+  size_t CompressedSize;
+  unsigned char* Output;
+  size_t OutputSize;
+  int Result;
+};
+
+// Uncompress the blocks of a batch.  This runs on several threads
+// only when vtkDataCompressor::IsThreadSafe allows it.
+class vtkXMLDataParserUncompressBlocks
+{
+public:
+  vtkXMLDataParserUncompressBlocks(vtkDataCompressor* compressor,
+                                   const unsigned char* compressed,
+                                   vtkXMLDataParserBlock* blocks)
+    : Compressor(compressor), Compressed(compressed), Blocks(blocks)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for(vtkIdType i = begin; i < end; ++i)
+    {
+      vtkXMLDataParserBlock& b = this->Blocks[i];
+      b.Result = this->Compressor->Uncompress(
+        this->Compressed+b.CompressedOffset, b.CompressedSize,
+        b.Output, b.OutputSize) > 0;
+    }
+  }
+
+private:
+  vtkDataCompressor* Compressor;
+  const unsigned char* Compressed;
+  vtkXMLDataParserBlock* Blocks;
+};
+}
+
 //----------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
                                             vtkTypeUInt64 startWord,
@@ -765,18 +809,71 @@ size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
     // Report progress.
     this->UpdateProgress(float(outputPointer-data)/length);
 
-    unsigned int currentBlock = firstBlock+1;
-    for(;currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in batches.  The compressed bytes of a
+    // batch are contiguous in the stream and are read at once, then
+    // the blocks are uncompressed straight into the output,
+    // concurrently when the compressor is thread safe.  A few blocks
+    // per thread bound the extra memory needed.
+    vtkTypeUInt64 batchSize = static_cast<vtkTypeUInt64>(
+      4 * std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+    std::vector<unsigned char> compressed;
+    std::vector<vtkXMLDataParserBlock> blocks;
+    vtkTypeUInt64 currentBlock = firstBlock+1;
+    while(currentBlock != lastBlock && !this->Abort)
     {
-      // Read this block.
-      if(!this->ReadBlock(currentBlock, outputPointer)) { return 0; }
+      vtkTypeUInt64 batchEnd = std::min(currentBlock+batchSize, lastBlock);
+
+      // Locate each block in the compressed and uncompressed buffers.
+      blocks.clear();
+      size_t compressedSize = 0;
+      size_t uncompressedSize = 0;
+      for(vtkTypeUInt64 block = currentBlock; block != batchEnd; ++block)
+      {
+        vtkXMLDataParserBlock b;
+        b.CompressedOffset = compressedSize;
+        b.CompressedSize = this->BlockCompressedSizes[block];
+        b.Output = outputPointer+uncompressedSize;
+        b.OutputSize = this->FindBlockSize(block);
+        b.Result = 0;
+        blocks.push_back(b);
+        compressedSize += b.CompressedSize;
+        uncompressedSize += b.OutputSize;
+      }
+
+      // Read the compressed bytes of the batch.
+      compressed.resize(compressedSize);
+      if(!this->DataStream->Seek(this->BlockStartOffsets[currentBlock]) ||
+         this->DataStream->Read(compressed.data(), compressedSize) <
+         compressedSize)
+      {
+        return 0;
+      }
+
+      // Uncompress the blocks of the batch.
+      vtkXMLDataParserUncompressBlocks uncompress(
+        this->Compressor, compressed.data(), blocks.data());
+      vtkIdType numberOfBlocks = static_cast<vtkIdType>(blocks.size());
+      if(this->Compressor->IsThreadSafe())
+      {
+        vtkSMPTools::For(0, numberOfBlocks, 1, uncompress);
+      }
+      else
+      {
+        uncompress(0, numberOfBlocks);
+      }
+      for(size_t i = 0; i < blocks.size(); ++i)
+      {
+        if(!blocks[i].Result) { return 0; }
+      }
 
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      // Byte swap the batch.  Note that uncompressedSize will always
+      // be an integer multiple of the word size.
+      this->PerformByteSwap(outputPointer, uncompressedSize / wordSize,
+                            wordSize);
 
-      // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      // Advance the pointer to the beginning of the next batch.
+      outputPointer += uncompressedSize;
+      currentBlock = batchEnd;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer-data)/length);
@@ -928,6 +1025,35 @@ size_t vtkXMLDataParser::ReadAppendedData(vtkTypeInt64 offset,
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::FindRawAppendedData(vtkTypeInt64 offset,
+                                          vtkTypeInt64& position,
+                                          vtkTypeUInt64& size)
+{
+  if(!this->Stream || this->Compressor ||
+     this->AppendedDataStream->IsA("vtkBase64InputStream"))
+  {
+    return 0;
+  }
+
+  // Read the length of the data.
+  std::unique_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  this->SeekG(this->AppendedDataPosition+offset);
+  this->Stream->read(reinterpret_cast<char*>(uh->Data()), headerSize);
+  if(this->Stream->gcount() < static_cast<std::streamsize>(headerSize))
+  {
+    this->Stream->clear();
+    return 0;
+  }
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+
+  position = this->AppendedDataPosition+offset+headerSize;
+  size = uh->Get(0);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
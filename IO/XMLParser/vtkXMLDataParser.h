@@ -79,6 +79,23 @@ public:
   { return this->ReadAppendedData(offset, buffer, startWord, numWords,
                                     VTK_CHAR); }
 
+  /**
+   * Find where an array stored in the appended data section starting
+   * at the given appended data offset lies in the file.  This is only
+   * possible when the appended data are neither encoded nor
+   * compressed.  On success, returns 1 and sets the file position of
+   * the first data byte (past the size header) and the number of data
+   * bytes stored.  Returns 0 otherwise.
+   */
+  int FindRawAppendedData(vtkTypeInt64 offset, vtkTypeInt64& position,
+                          vtkTypeUInt64& size);
+
+  /**
+   * Get the byte order of the binary data in the file.  Valid after
+   * the XML is parsed.
+   */
+  vtkGetMacro(ByteOrder, int);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
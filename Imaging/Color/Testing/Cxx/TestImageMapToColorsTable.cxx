@@ -0,0 +1,210 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMapToColorsTable.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the color tables of vtkImageMapToColors and
+// vtkImageMapToWindowLevelColors: large images, which are mapped through
+// the color table, must give the same colors as small pieces of the same
+// images, which are mapped directly, and the table must be recomputed when
+// the lookup table or the window/level change.
+
+#include "vtkDataArray.h"
+#include "vtkImageAppendComponents.h"
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkImageMapToColors.h"
+#include "vtkImageMapToWindowLevelColors.h"
+#include "vtkImageNoiseSource.h"
+#include "vtkLookupTable.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <cstring>
+
+namespace
+{
+
+// Random values over the range of the type, with a fixed seed so that the
+// test is repeatable.
+vtkSmartPointer<vtkImageData> MakeImage(int scalarType, int numberOfComponents)
+{
+  double range[2] = { vtkDataArray::GetDataTypeMin(scalarType),
+    vtkDataArray::GetDataTypeMax(scalarType) };
+  if (scalarType == VTK_FLOAT)
+  {
+    range[0] = -2000.0;
+    range[1] = 2000.0;
+  }
+
+  vtkMath::RandomSeed(1234);
+  vtkNew<vtkImageAppendComponents> append;
+  for (int c = 0; c < numberOfComponents; c++)
+  {
+    vtkNew<vtkImageNoiseSource> noise;
+    noise->SetWholeExtent(0, 299, 0, 249, 0, 1);
+    noise->SetMinimum(range[0]);
+    noise->SetMaximum(range[1]);
+    append->AddInputConnection(noise->GetOutputPort());
+  }
+
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputConnection(append->GetOutputPort());
+  cast->SetOutputScalarType(scalarType);
+  cast->ClampOverflowOn();
+  cast->Update();
+  return cast->GetOutput();
+}
+
+// Map small pieces of the image with new filters, which map them directly,
+// and compare them with the output of the filter.
+bool ComparePieces(vtkImageMapToColors* filter, vtkImageData* image, const char* name)
+{
+  vtkImageData* output = filter->GetOutput();
+  int numberOfComponents = output->GetNumberOfScalarComponents();
+  const int pieces[3][6] = { { 0, 9, 0, 9, 0, 0 }, { 290, 299, 100, 109, 1, 1 },
+    { 150, 159, 240, 249, 0, 0 } };
+  for (const auto& piece : pieces)
+  {
+    vtkSmartPointer<vtkImageMapToColors> direct;
+    if (vtkImageMapToWindowLevelColors::SafeDownCast(filter))
+    {
+      vtkNew<vtkImageMapToWindowLevelColors> windowLevel;
+      windowLevel->SetWindow(vtkImageMapToWindowLevelColors::SafeDownCast(filter)->GetWindow());
+      windowLevel->SetLevel(vtkImageMapToWindowLevelColors::SafeDownCast(filter)->GetLevel());
+      direct = windowLevel.GetPointer();
+    }
+    else
+    {
+      direct = vtkSmartPointer<vtkImageMapToColors>::New();
+    }
+    direct->SetInputData(image);
+    direct->SetLookupTable(filter->GetLookupTable());
+    direct->SetOutputFormat(filter->GetOutputFormat());
+    direct->SetActiveComponent(filter->GetActiveComponent());
+    direct->UpdateExtent(piece);
+
+    for (int z = piece[4]; z <= piece[5]; z++)
+    {
+      for (int y = piece[2]; y <= piece[3]; y++)
+      {
+        for (int x = piece[0]; x <= piece[1]; x++)
+        {
+          if (memcmp(output->GetScalarPointer(x, y, z),
+                direct->GetOutput()->GetScalarPointer(x, y, z), numberOfComponents) != 0)
+          {
+            cerr << name << ": the color of " << image->GetScalarTypeAsString() << " pixel (" << x
+                 << ", " << y << ", " << z << ") with " << numberOfComponents
+                 << " components differs from the directly mapped color." << endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TestMapToColors(int scalarType)
+{
+  vtkSmartPointer<vtkImageData> image = MakeImage(scalarType, 2);
+  double range[2];
+  image->GetPointData()->GetScalars()->GetDataTypeRange(range);
+
+  vtkNew<vtkLookupTable> table;
+  table->SetRange(range[0] + 0.2 * (range[1] - range[0]), range[1] - 0.3 * (range[1] - range[0]));
+  table->SetHueRange(0.0, 0.7);
+  table->SetAlphaRange(0.5, 1.0);
+  table->Build();
+
+  bool valid = true;
+  vtkNew<vtkImageMapToColors> filter;
+  filter->SetInputData(image);
+  filter->SetLookupTable(table);
+  filter->SetActiveComponent(1);
+  for (int format = VTK_LUMINANCE; format <= VTK_RGBA; format++)
+  {
+    filter->SetOutputFormat(format);
+    filter->Modified();
+    filter->Update();
+    valid &= ComparePieces(filter, image, "vtkImageMapToColors");
+  }
+
+  // the table must be recomputed when the lookup table changes
+  table->SetHueRange(0.5, 0.9);
+  table->Build();
+  filter->Update();
+  valid &= ComparePieces(filter, image, "vtkImageMapToColors");
+
+  return valid;
+}
+
+bool TestMapToWindowLevelColors(int scalarType)
+{
+  vtkSmartPointer<vtkImageData> image = MakeImage(scalarType, 1);
+  double range[2];
+  image->GetPointData()->GetScalars()->GetDataTypeRange(range);
+  if (scalarType == VTK_FLOAT)
+  {
+    range[0] = -2000.0;
+    range[1] = 2000.0;
+  }
+
+  vtkNew<vtkLookupTable> table;
+  table->SetRange(range);
+  table->SetHueRange(0.0, 0.7);
+  table->Build();
+
+  bool valid = true;
+  vtkNew<vtkImageMapToWindowLevelColors> filter;
+  filter->SetInputData(image);
+  filter->SetWindow(0.4 * (range[1] - range[0]));
+  filter->SetLevel(range[0] + 0.45 * (range[1] - range[0]));
+  for (int useTable = 0; useTable < 2; useTable++)
+  {
+    filter->SetLookupTable(useTable ? table.GetPointer() : nullptr);
+    for (int format = VTK_LUMINANCE; format <= VTK_RGBA; format++)
+    {
+      filter->SetOutputFormat(format);
+      filter->Modified();
+      filter->Update();
+      valid &= ComparePieces(filter, image, "vtkImageMapToWindowLevelColors");
+    }
+
+    // the table must be recomputed when the window/level changes, also
+    // for negative windows
+    filter->SetWindow(-0.1 * (range[1] - range[0]));
+    filter->Update();
+    valid &= ComparePieces(filter, image, "vtkImageMapToWindowLevelColors");
+    filter->SetWindow(0.4 * (range[1] - range[0]));
+  }
+
+  return valid;
+}
+
+} // anonymous namespace
+
+int TestImageMapToColorsTable(int, char*[])
+{
+  bool valid = true;
+  const int scalarTypes[5] = { VTK_UNSIGNED_CHAR, VTK_SIGNED_CHAR, VTK_SHORT, VTK_UNSIGNED_SHORT,
+    VTK_FLOAT };
+  for (int scalarType : scalarTypes)
+  {
+    valid &= TestMapToColors(scalarType);
+    valid &= TestMapToWindowLevelColors(scalarType);
+  }
+
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -20,8 +20,11 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkScalarsToColors.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkPointData.h"
 
+#include <functional>
+
 vtkStandardNewMacro(vtkImageMapToWindowLevelColors);
 
 // Constructor sets default values
@@ -74,6 +77,15 @@ int vtkImageMapToWindowLevelColors::RequestData(
       this->DataWasPassed = 0;
     }
 
+    int *outExt = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+    vtkIdType numberOfPixels = 1;
+    for (int i = 0; i < 3; i++)
+    {
+      numberOfPixels *= (outExt[2*i] <= outExt[2*i + 1] ?
+                         outExt[2*i + 1] - outExt[2*i] + 1 : 0);
+    }
+    this->UpdateColorTable(inData->GetScalarType(), numberOfPixels);
+
     return this->vtkThreadedImageAlgorithm::RequestData(request, inputVector,
                                                         outputVector);
   }
@@ -151,7 +163,7 @@ int vtkImageMapToWindowLevelColors::RequestInformation (
  * for a window of values of type T, lower and upper.
  */
 template <class T>
-void vtkImageMapToWindowLevelClamps ( vtkImageData *data, double w,
+void vtkImageMapToWindowLevelClamps ( int dataType, double w,
                                       double l, T& lower, T& upper,
                                       unsigned char &lower_val,
                                       unsigned char &upper_val)
@@ -160,7 +172,7 @@ void vtkImageMapToWindowLevelClamps ( vtkImageData *data, double w,
   double adjustedLower, adjustedUpper;
   double range[2];
 
-  data->GetPointData()->GetScalars()->GetDataTypeRange( range );
+  vtkDataArray::GetDataTypeRange( dataType, range );
 
   f_lower = l - fabs(w) / 2.0;
   f_upper = f_lower + fabs(w);
@@ -250,38 +262,161 @@ void vtkImageMapToWindowLevelClamps ( vtkImageData *data, double w,
 }
 
 //----------------------------------------------------------------------------
-// This non-templated function executes the filter for any type of data.
+// This class maps rows of values of type T through the lookup table and
+// the window/level. The rows are mapped by loops that are specialized for
+// the output format, so that the compiler can vectorize them.
+template <class T>
+class vtkImageMapToWindowLevelMapper
+{
+public:
+  vtkImageMapToWindowLevelMapper(vtkImageMapToWindowLevelColors *self,
+                                 int dataType)
+  {
+    this->LookupTable = self->GetLookupTable();
+    this->DataType = dataType;
+    this->OutputFormat = self->GetOutputFormat();
+    this->Shift = self->GetWindow() / 2.0 - self->GetLevel();
+    this->Scale = 255.0 / self->GetWindow();
+    vtkImageMapToWindowLevelClamps( dataType, self->GetWindow(),
+                                    self->GetLevel(),
+                                    this->Lower, this->Upper,
+                                    this->LowerVal, this->UpperVal );
+  }
+
+  void MapRow(T *inPtr, unsigned char *outPtr, int count, int inIncrement)
+  {
+    if (this->LookupTable)
+    {
+      this->LookupTable->MapScalarsThroughTable2(
+        inPtr, outPtr, this->DataType, count, inIncrement, this->OutputFormat);
+
+      switch (this->OutputFormat)
+      {
+        case VTK_RGBA:
+          this->Map<4, true>(inPtr, outPtr, count, inIncrement);
+          break;
+        case VTK_RGB:
+          this->Map<3, true>(inPtr, outPtr, count, inIncrement);
+          break;
+        case VTK_LUMINANCE_ALPHA:
+          this->Map<2, true>(inPtr, outPtr, count, inIncrement);
+          break;
+        case VTK_LUMINANCE:
+          this->Map<1, true>(inPtr, outPtr, count, inIncrement);
+          break;
+      }
+    }
+    else
+    {
+      switch (this->OutputFormat)
+      {
+        case VTK_RGBA:
+          this->Map<4, false>(inPtr, outPtr, count, inIncrement);
+          break;
+        case VTK_RGB:
+          this->Map<3, false>(inPtr, outPtr, count, inIncrement);
+          break;
+        case VTK_LUMINANCE_ALPHA:
+          this->Map<2, false>(inPtr, outPtr, count, inIncrement);
+          break;
+        case VTK_LUMINANCE:
+          this->Map<1, false>(inPtr, outPtr, count, inIncrement);
+          break;
+      }
+    }
+  }
+
+private:
+  // Compute the window/level of each value, and either use it as the
+  // luminance or modulate the color from the lookup table with it.
+  template <int N, bool Modulate>
+  void Map(const T *iptr, unsigned char *optr, int count, int inIncrement)
+  {
+    const T lower = this->Lower;
+    const T upper = this->Upper;
+    const double shift = this->Shift;
+    const double scale = this->Scale;
+
+    for (int idxX = 0; idxX < count; idxX++)
+    {
+      unsigned char result_val;
+      if (*iptr <= lower)
+      {
+        result_val = this->LowerVal;
+      }
+      else if (*iptr >= upper)
+      {
+        result_val = this->UpperVal;
+      }
+      else
+      {
+        result_val = static_cast<unsigned char>((*iptr + shift)*scale);
+      }
+
+      if (Modulate)
+      {
+        unsigned short ushort_val = result_val;
+        optr[0] = static_cast<unsigned char>((optr[0] * ushort_val) >> 8);
+        if (N >= 3)
+        {
+          optr[1] = static_cast<unsigned char>((optr[1] * ushort_val) >> 8);
+          optr[2] = static_cast<unsigned char>((optr[2] * ushort_val) >> 8);
+        }
+      }
+      else
+      {
+        optr[0] = result_val;
+        if (N >= 3)
+        {
+          optr[1] = result_val;
+          optr[2] = result_val;
+        }
+      }
+      if (N == 2 || N == 4)
+      {
+        optr[N - 1] = 255;
+      }
+
+      iptr += inIncrement;
+      optr += N;
+    }
+  }
+
+  vtkScalarsToColors *LookupTable;
+  int DataType;
+  int OutputFormat;
+  double Shift;
+  double Scale;
+  T Lower;
+  T Upper;
+  unsigned char LowerVal;
+  unsigned char UpperVal;
+};
+
+//----------------------------------------------------------------------------
+// This templated function executes the filter for any type of data.
+// If copyColors is set, it is used to map the rows instead.
 template <class T>
 void vtkImageMapToWindowLevelColorsExecute(
   vtkImageMapToWindowLevelColors *self,
   vtkImageData *inData, T *inPtr,
   vtkImageData *outData,
   unsigned char *outPtr,
-  int outExt[6], int id)
+  int outExt[6], int id,
+  const std::function<void(void *, unsigned char *, int, int)> &copyColors)
 {
-  int idxX, idxY, idxZ;
+  int idxY, idxZ;
   int extX, extY, extZ;
   vtkIdType inIncX, inIncY, inIncZ;
   vtkIdType outIncX, outIncY, outIncZ;
   unsigned long count = 0;
   unsigned long target;
-  int dataType = inData->GetScalarType();
-  int numberOfComponents,numberOfOutputComponents,outputFormat;
+  int numberOfComponents,numberOfOutputComponents;
   int rowLength;
-  vtkScalarsToColors *lookupTable = self->GetLookupTable();
   unsigned char *outPtr1;
   T *inPtr1;
-  unsigned char *optr;
-  T    *iptr;
-  double shift =  self->GetWindow() / 2.0 - self->GetLevel();
-  double scale = 255.0 / self->GetWindow();
-
-  T   lower, upper;
-  unsigned char lower_val, upper_val, result_val;
-  unsigned short ushort_val;
-  vtkImageMapToWindowLevelClamps( inData, self->GetWindow(),
-                                  self->GetLevel(),
-                                  lower, upper, lower_val, upper_val );
+
+  vtkImageMapToWindowLevelMapper<T> mapper(self, inData->GetScalarType());
 
   // find the region to loop over
   extX = outExt[1] - outExt[0] + 1;
@@ -297,7 +432,6 @@ void vtkImageMapToWindowLevelColorsExecute(
   outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
   numberOfComponents = inData->GetNumberOfScalarComponents();
   numberOfOutputComponents = outData->GetNumberOfScalarComponents();
-  outputFormat = self->GetOutputFormat();
 
   rowLength = extX*numberOfComponents;
 
@@ -317,91 +451,15 @@ void vtkImageMapToWindowLevelColorsExecute(
         count++;
       }
 
-      iptr = inPtr1;
-      optr = outPtr1;
-
-      if ( lookupTable )
+      if (copyColors)
       {
-        lookupTable->MapScalarsThroughTable2(
-          inPtr1,
-          static_cast<unsigned char *>(outPtr1),
-          dataType,extX,numberOfComponents,
-          outputFormat);
-
-        for (idxX = 0; idxX < extX; idxX++)
-        {
-          if (*iptr <= lower)
-          {
-            ushort_val = lower_val;
-          }
-          else if (*iptr >= upper)
-          {
-            ushort_val = upper_val;
-          }
-          else
-          {
-            ushort_val = static_cast<unsigned char>((*iptr + shift)*scale);
-          }
-          *optr = static_cast<unsigned char>((*optr * ushort_val) >> 8);
-          switch (outputFormat)
-          {
-            case VTK_RGBA:
-              *(optr+1) = static_cast<unsigned char>(
-                (*(optr+1) * ushort_val) >> 8);
-              *(optr+2) = static_cast<unsigned char>(
-                (*(optr+2) * ushort_val) >> 8);
-              *(optr+3) = 255;
-              break;
-            case VTK_RGB:
-              *(optr+1) = static_cast<unsigned char>(
-                (*(optr+1) * ushort_val) >> 8);
-              *(optr+2) = static_cast<unsigned char>(
-                (*(optr+2) * ushort_val) >> 8);
-              break;
-            case VTK_LUMINANCE_ALPHA:
-              *(optr+1) = 255;
-              break;
-          }
-          iptr += numberOfComponents;
-          optr += numberOfOutputComponents;
-        }
+        copyColors(inPtr1, outPtr1, extX, numberOfComponents);
       }
       else
       {
-        for (idxX = 0; idxX < extX; idxX++)
-        {
-          if (*iptr <= lower)
-          {
-            result_val = lower_val;
-          }
-          else if (*iptr >= upper)
-          {
-            result_val = upper_val;
-          }
-          else
-          {
-            result_val = static_cast<unsigned char>((*iptr + shift)*scale);
-          }
-          *optr = result_val;
-          switch (outputFormat)
-          {
-            case VTK_RGBA:
-              *(optr+1) = result_val;
-              *(optr+2) = result_val;
-              *(optr+3) = 255;
-              break;
-            case VTK_RGB:
-              *(optr+1) = result_val;
-              *(optr+2) = result_val;
-              break;
-            case VTK_LUMINANCE_ALPHA:
-              *(optr+1) = 255;
-              break;
-          }
-          iptr += numberOfComponents;
-          optr += numberOfOutputComponents;
-        }
+        mapper.MapRow(inPtr1, outPtr1, extX, numberOfComponents);
       }
+
       outPtr1 += outIncY + extX*numberOfOutputComponents;
       inPtr1 += inIncY + rowLength;
     }
@@ -424,8 +482,20 @@ void vtkImageMapToWindowLevelColors::ThreadedRequestData(
 {
   void *inPtr = inData[0][0]->GetScalarPointerForExtent(outExt);
   void *outPtr = outData[0]->GetScalarPointerForExtent(outExt);
+  int scalarType = inData[0][0]->GetScalarType();
+
+  // Use the color table if RequestData() computed it for this input
+  std::function<void(void *, unsigned char *, int, int)> copyColors;
+  if (this->ColorTableScalarType == scalarType)
+  {
+    copyColors = [this, scalarType](void *in, unsigned char *out,
+                                    int count, int inIncrement)
+    {
+      this->MapThroughColorTable(in, out, scalarType, count, inIncrement);
+    };
+  }
 
-  switch (inData[0][0]->GetScalarType())
+  switch (scalarType)
   {
     vtkTemplateMacro(
       vtkImageMapToWindowLevelColorsExecute(this,
@@ -434,13 +504,29 @@ void vtkImageMapToWindowLevelColors::ThreadedRequestData(
                                             outData[0],
                                             static_cast<unsigned char *>(outPtr),
                                             outExt,
-                                            id));
+                                            id,
+                                            copyColors));
     default:
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
       return;
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkImageMapToWindowLevelColors::MapValuesToColors(
+  void *input, unsigned char *output, int scalarType, int count)
+{
+  switch (scalarType)
+  {
+    vtkTemplateMacro(
+      vtkImageMapToWindowLevelMapper<VTK_TT>(this, scalarType).MapRow(
+        static_cast<VTK_TT *>(input), output, count, 1));
+    default:
+      vtkErrorMacro(<< "MapValuesToColors: Unknown ScalarType");
+      return;
+  }
+}
+
 void vtkImageMapToWindowLevelColors::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
@@ -35,6 +35,10 @@
  * See SetWindow() and SetLevel() for the equations used for modulation.
  * To map scalars through a lookup table without modulating the resulting
  * color, use vtkImageMapToColors instead of this filter.
+ * As for vtkImageMapToColors, 8-bit and 16-bit integer input is mapped by
+ * copying the modulated colors from a table that holds the colors of all
+ * the possible input values, and that is only recomputed when the
+ * Window/Level or the lookup table change.
  * @sa
  * vtkLookupTable vtkScalarsToColors
 */
@@ -87,6 +91,9 @@ protected:
                           vtkInformationVector **inputVector,
                           vtkInformationVector *outputVector) override;
 
+  void MapValuesToColors(void *input, unsigned char *output,
+                         int scalarType, int count) override;
+
   double Window;
   double Level;
 
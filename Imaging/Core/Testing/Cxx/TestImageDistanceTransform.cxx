@@ -0,0 +1,175 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageDistanceTransform.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests vtkImageDistanceTransform against the distances computed by brute
+// force, with and without signs and spacing.
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageAppendComponents.h"
+#include "vtkImageData.h"
+#include "vtkImageDistanceTransform.h"
+#include "vtkImageNoiseSource.h"
+#include "vtkImageThreshold.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+
+namespace
+{
+
+// Random blobs, with a fixed seed so that the test is repeatable.  The
+// second component, which must be ignored, is the complement of the blobs.
+void MakeImage(vtkImageData* image, int nx, int ny, int nz, int percent)
+{
+  vtkMath::RandomSeed(4321);
+  vtkNew<vtkImageNoiseSource> noise;
+  noise->SetWholeExtent(-2, nx - 3, 1, ny, 0, nz - 1);
+  noise->SetMinimum(0.0);
+  noise->SetMaximum(100.0);
+
+  vtkNew<vtkImageAppendComponents> append;
+  for (int c = 0; c < 2; ++c)
+  {
+    vtkNew<vtkImageThreshold> threshold;
+    threshold->SetInputConnection(noise->GetOutputPort());
+    threshold->ThresholdByLower(percent);
+    threshold->SetInValue(c == 0 ? 3 : 0);
+    threshold->SetOutValue(c == 0 ? 0 : 1);
+    threshold->SetOutputScalarTypeToShort();
+    append->AddInputConnection(threshold->GetOutputPort());
+  }
+  append->Update();
+
+  image->ShallowCopy(append->GetOutput());
+  image->SetSpacing(1.0, 0.7, 1.9);
+}
+
+// The squared distance between two points of the image.
+double Distance2(vtkImageData* image, vtkIdType a, vtkIdType b, bool anisotropic, int dim)
+{
+  int* dims = image->GetDimensions();
+  double* spacing = image->GetSpacing();
+  vtkIdType pa[3] = { a % dims[0], (a / dims[0]) % dims[1], a / dims[0] / dims[1] };
+  vtkIdType pb[3] = { b % dims[0], (b / dims[0]) % dims[1], b / dims[0] / dims[1] };
+  double d2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (i >= dim && pa[i] != pb[i])
+    {
+      return VTK_DOUBLE_MAX;
+    }
+    double d = (pa[i] - pb[i]) * (anisotropic ? spacing[i] : 1.0);
+    d2 += d * d;
+  }
+  return d2;
+}
+
+bool Check(vtkImageData* image, int dimensionality, bool signedDistance, bool anisotropic,
+  bool squared, int scalarType)
+{
+  vtkNew<vtkImageDistanceTransform> filter;
+  filter->SetInputData(image);
+  filter->SetDimensionality(dimensionality);
+  filter->SetSignedDistance(signedDistance);
+  filter->SetConsiderAnisotropy(anisotropic);
+  filter->SetSquaredDistance(squared);
+  filter->SetOutputScalarType(scalarType);
+  filter->GenerateNearestFeatureIdsOn();
+  filter->Update();
+
+  vtkImageData* output = filter->GetOutput();
+  vtkDataArray* distances = output->GetPointData()->GetScalars();
+  vtkIdTypeArray* ids =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("NearestFeatureIds"));
+  vtkDataArray* mask = image->GetPointData()->GetScalars();
+  if (!distances || distances->GetDataType() != scalarType || !ids)
+  {
+    cerr << "Missing output arrays." << endl;
+    return false;
+  }
+
+  const double tolerance = (scalarType == VTK_FLOAT ? 1e-4 : 1e-10);
+  vtkIdType n = image->GetNumberOfPoints();
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    bool inside = (mask->GetComponent(i, 0) != 0);
+    double best = VTK_DOUBLE_MAX;
+    for (vtkIdType j = 0; j < n; ++j)
+    {
+      if ((mask->GetComponent(j, 0) != 0) != (inside && signedDistance))
+      {
+        best = std::min(best, Distance2(image, i, j, anisotropic, dimensionality));
+      }
+    }
+    if (inside && !signedDistance)
+    {
+      best = 0.0;
+    }
+
+    double expected = (squared ? best : std::sqrt(best));
+    double value = distances->GetTuple1(i);
+    if (inside && signedDistance)
+    {
+      value = -value;
+    }
+    vtkIdType id = ids->GetValue(i);
+    if (best == VTK_DOUBLE_MAX)
+    {
+      if (value < (scalarType == VTK_FLOAT ? VTK_FLOAT_MAX : VTK_DOUBLE_MAX) || id != -1)
+      {
+        cerr << "Voxel " << i << " should not reach any feature." << endl;
+        return false;
+      }
+      continue;
+    }
+    if (std::fabs(value - expected) > tolerance * (1.0 + expected) || id < 0 || id >= n ||
+      std::fabs(Distance2(image, i, id, anisotropic, dimensionality) - best) > 1e-9 * (1.0 + best))
+    {
+      cerr << "Voxel " << i << " differs for dimensionality " << dimensionality << ", signed "
+           << signedDistance << ", anisotropic " << anisotropic << ", squared " << squared
+           << ": " << value << " != " << expected << ", nearest " << id << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int TestImageDistanceTransform(int, char*[])
+{
+  vtkNew<vtkImageData> volume;
+  MakeImage(volume, 13, 11, 9, 3);
+  vtkNew<vtkImageData> dense;
+  MakeImage(dense, 17, 6, 5, 60);
+  vtkNew<vtkImageData> slices;
+  MakeImage(slices, 21, 19, 3, 1);
+  vtkNew<vtkImageData> empty;
+  MakeImage(empty, 5, 4, 3, 0);
+
+  bool valid = true;
+  for (int signedDistance = 0; signedDistance < 2; ++signedDistance)
+  {
+    valid &= Check(volume, 3, signedDistance, true, false, VTK_FLOAT);
+    valid &= Check(volume, 3, signedDistance, false, true, VTK_DOUBLE);
+    valid &= Check(dense, 3, signedDistance, true, true, VTK_DOUBLE);
+    valid &= Check(slices, 2, signedDistance, true, false, VTK_DOUBLE);
+    valid &= Check(slices, 1, signedDistance, false, false, VTK_FLOAT);
+    valid &= Check(empty, 3, signedDistance, true, false, VTK_FLOAT);
+  }
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
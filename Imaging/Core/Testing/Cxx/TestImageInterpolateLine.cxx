@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageInterpolateLine.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that the line interpolation of vtkImageInterpolator gives the same
+// values as the interpolation of each sample, and that oblique reslicing
+// gives the values of the interpolator.
+
+#include "vtkImageAppendComponents.h"
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkImageInterpolator.h"
+#include "vtkImageNoiseSource.h"
+#include "vtkImageReslice.h"
+#include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+// Random values, with a fixed seed so that the test is repeatable.
+vtkSmartPointer<vtkImageData> MakeImage(int scalarType, int components, int nz)
+{
+  vtkMath::RandomSeed(777);
+  vtkNew<vtkImageAppendComponents> append;
+  for (int c = 0; c < components; ++c)
+  {
+    vtkNew<vtkImageNoiseSource> noise;
+    noise->SetWholeExtent(-3, 17, 2, 24, 0, nz - 1);
+    noise->SetMinimum(0.0);
+    noise->SetMaximum(120.0);
+    append->AddInputConnection(noise->GetOutputPort());
+  }
+
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputConnection(append->GetOutputPort());
+  cast->SetOutputScalarType(scalarType);
+  cast->Update();
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->ShallowCopy(cast->GetOutput());
+  image->SetSpacing(0.9, 1.1, 1.3);
+  image->SetOrigin(2.0, -1.0, 0.5);
+  return image;
+}
+
+template <class F>
+bool CompareLines(vtkImageInterpolator* interpolator, double tolerance)
+{
+  const int n = 61;
+  int components = interpolator->GetNumberOfComponents();
+  std::vector<F> line(n * components);
+  std::vector<F> values(components);
+
+  // lines in various directions, some starting out of bounds
+  const F bases[4][3] = { { -3.5f, 2.2f, 0.1f }, { 17.0f, 24.0f, 3.9f },
+    { 0.25f, 10.5f, 1.5f }, { 5.0f, 2.0f, 0.0f } };
+  const F steps[4][3] = { { 0.37f, 0.29f, 0.061f }, { -0.23f, -0.31f, -0.05f },
+    { 0.2f, 0.0f, 0.0f }, { 0.0f, 0.35f, 0.0f } };
+  for (int l = 0; l < 4; ++l)
+  {
+    const F* base = bases[l];
+    const F* step = steps[l];
+    const int first = l - 2;
+    // find the samples within bounds
+    int start = -1;
+    int end = -1;
+    for (int i = 0; i < n; ++i)
+    {
+      F point[3] = { base[0] + (first + i) * step[0], base[1] + (first + i) * step[1],
+        base[2] + (first + i) * step[2] };
+      if (interpolator->CheckBoundsIJK(point))
+      {
+        start = (start < 0 ? i : start);
+        end = i + 1;
+      }
+    }
+    if (start < 0)
+    {
+      continue;
+    }
+
+    interpolator->InterpolateLineIJK(base, step, first + start, end - start, line.data());
+    for (int i = start; i < end; ++i)
+    {
+      F point[3] = { base[0] + (first + i) * step[0], base[1] + (first + i) * step[1],
+        base[2] + (first + i) * step[2] };
+      interpolator->InterpolateIJK(point, values.data());
+      for (int c = 0; c < components; ++c)
+      {
+        F value = line[(i - start) * components + c];
+        if (std::fabs(value - values[c]) > tolerance)
+        {
+          cerr << interpolator->GetInterpolationModeAsString() << " line " << l << " differs at "
+               << i << ": " << value << " != " << values[c] << endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TestLines(int scalarType, int components, int nz, int mode, int border, int offset)
+{
+  vtkSmartPointer<vtkImageData> image = MakeImage(scalarType, components, nz);
+  vtkNew<vtkImageInterpolator> interpolator;
+  interpolator->SetInterpolationMode(mode);
+  interpolator->SetBorderMode(border);
+  interpolator->SetComponentOffset(offset);
+  interpolator->Initialize(image);
+  interpolator->Update();
+
+  bool valid = CompareLines<double>(interpolator, 1e-10);
+  valid &= CompareLines<float>(interpolator, 1e-3);
+  if (!valid)
+  {
+    cerr << "for " << image->GetScalarTypeAsString() << ", " << components << " components, "
+         << nz << " slices, border " << border << ", offset " << offset << endl;
+  }
+  return valid;
+}
+
+bool TestReslice(int mode)
+{
+  vtkSmartPointer<vtkImageData> image = MakeImage(VTK_FLOAT, 1, 19);
+
+  // rotate the slices around an oblique axis
+  vtkNew<vtkMatrix4x4> axes;
+  const double c = std::cos(0.4);
+  const double s = std::sin(0.4);
+  const double elements[16] = { c, 0.0, s, 10.0, s * s, c, -s * c, 11.0, -s * c, s, c * c, 12.0,
+    0.0, 0.0, 0.0, 1.0 };
+  axes->DeepCopy(elements);
+
+  vtkNew<vtkImageReslice> reslice;
+  reslice->SetInputData(image);
+  reslice->SetInterpolationMode(mode);
+  reslice->SetResliceAxes(axes);
+  reslice->SetOutputExtent(0, 39, 0, 29, 0, 2);
+  reslice->SetOutputSpacing(0.7, 0.8, 0.9);
+  reslice->SetOutputOrigin(-14.0, -12.0, -1.0);
+  reslice->SetBackgroundLevel(-1.0);
+  reslice->BorderOff();
+  reslice->Update();
+
+  vtkImageData* output = reslice->GetOutput();
+  vtkNew<vtkImageInterpolator> reference;
+  reference->SetInterpolationMode(mode);
+  reference->Initialize(image);
+  reference->SetOutValue(-1.0);
+  reference->Update();
+  int inside = 0;
+  for (int k = 0; k < 3; ++k)
+  {
+    for (int j = 0; j < 30; ++j)
+    {
+      for (int i = 0; i < 40; ++i)
+      {
+        double point[4] = { -14.0 + 0.7 * i, -12.0 + 0.8 * j, -1.0 + 0.9 * k, 1.0 };
+        axes->MultiplyPoint(point, point);
+        double expected;
+        bool inBounds = reference->Interpolate(point, &expected);
+        double value = output->GetScalarComponentAsDouble(i, j, k, 0);
+        // the reslice and reference coordinates are computed differently,
+        // so samples very close to the bounds are skipped
+        double p[3] = { (point[0] - 2.0) / 0.9, (point[1] + 1.0) / 1.1, (point[2] - 0.5) / 1.3 };
+        if (std::fabs(p[0] + 3) < 1e-3 || std::fabs(p[0] - 17) < 1e-3 ||
+          std::fabs(p[1] - 2) < 1e-3 || std::fabs(p[1] - 24) < 1e-3 || std::fabs(p[2]) < 1e-3 ||
+          std::fabs(p[2] - 18) < 1e-3)
+        {
+          continue;
+        }
+        inside += inBounds;
+        if (std::fabs(value - expected) > 1e-3)
+        {
+          cerr << "Reslice with " << reslice->GetInterpolationModeAsString()
+               << " interpolation differs at (" << i << ", " << j << ", " << k << "): " << value
+               << " != " << expected << endl;
+          return false;
+        }
+      }
+    }
+  }
+  if (inside < 1000)
+  {
+    cerr << "Too few samples within the input." << endl;
+    return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int TestImageInterpolateLine(int, char*[])
+{
+  const int scalarTypes[] = { VTK_UNSIGNED_CHAR, VTK_SHORT, VTK_UNSIGNED_SHORT, VTK_INT, VTK_FLOAT,
+    VTK_DOUBLE };
+  const int modes[] = { VTK_NEAREST_INTERPOLATION, VTK_LINEAR_INTERPOLATION,
+    VTK_CUBIC_INTERPOLATION };
+  const int borders[] = { VTK_IMAGE_BORDER_CLAMP, VTK_IMAGE_BORDER_REPEAT,
+    VTK_IMAGE_BORDER_MIRROR };
+
+  bool valid = true;
+  for (int mode : modes)
+  {
+    for (int scalarType : scalarTypes)
+    {
+      valid &= TestLines(scalarType, 1, 7, mode, VTK_IMAGE_BORDER_CLAMP, 0);
+      valid &= TestLines(scalarType, 3, 5, mode, VTK_IMAGE_BORDER_CLAMP, 0);
+      valid &= TestLines(scalarType, 3, 5, mode, VTK_IMAGE_BORDER_CLAMP, 1);
+    }
+    for (int border : borders)
+    {
+      valid &= TestLines(VTK_SHORT, 1, 1, mode, border, 0);
+      valid &= TestLines(VTK_UNSIGNED_CHAR, 2, 4, mode, border, 1);
+    }
+    valid &= TestReslice(mode);
+  }
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,385 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageLabelStencilData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests vtkImageLabelStencilData: the conversions to and from images and
+// stencils, the Boolean operations and the label statistics are compared
+// with the same computations on dense label images, and the stencil of
+// the label map is used with vtkImageStencil and vtkImageAccumulate.
+
+#include "vtkImageAccumulate.h"
+#include "vtkImageData.h"
+#include "vtkImageLabelStencilData.h"
+#include "vtkImageStencil.h"
+#include "vtkImageStencilData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// A label image with overlapping balls, labeled from firstLabel on.
+vtkSmartPointer<vtkImageData> MakeLabels(
+  const int extent[6], int numberOfBalls, int firstLabel, int seed)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(const_cast<int*>(extent));
+  image->SetSpacing(0.5, 0.75, 1.5);
+  image->SetOrigin(-3.0, 2.0, 1.0);
+  image->AllocateScalars(VTK_SHORT, 1);
+  short* ptr = static_cast<short*>(image->GetScalarPointer());
+  std::fill_n(ptr, image->GetNumberOfPoints(), 0);
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  for (int ball = 0; ball < numberOfBalls; ball++)
+  {
+    double center[3];
+    for (int i = 0; i < 3; i++)
+    {
+      center[i] = random->GetRangeValue(extent[2 * i], extent[2 * i + 1]);
+      random->Next();
+    }
+    double radius = random->GetRangeValue(2.0, 10.0);
+    random->Next();
+    for (int z = extent[4]; z <= extent[5]; z++)
+    {
+      for (int y = extent[2]; y <= extent[3]; y++)
+      {
+        for (int x = extent[0]; x <= extent[1]; x++)
+        {
+          double d[3] = { x - center[0], y - center[1], 2.0 * (z - center[2]) };
+          if (d[0] * d[0] + d[1] * d[1] + d[2] * d[2] <= radius * radius)
+          {
+            *static_cast<short*>(image->GetScalarPointer(x, y, z)) =
+              static_cast<short>(firstLabel + ball);
+          }
+        }
+      }
+    }
+  }
+  return image;
+}
+
+int GetLabel(vtkImageData* image, int x, int y, int z)
+{
+  int* extent = image->GetExtent();
+  if (x < extent[0] || x > extent[1] || y < extent[2] || y > extent[3] || z < extent[4] ||
+    z > extent[5])
+  {
+    return 0;
+  }
+  return static_cast<int>(image->GetScalarComponentAsDouble(x, y, z, 0));
+}
+
+// Compare a label map with a dense label image, voxel by voxel.
+bool CompareLabels(vtkImageLabelStencilData* labels, vtkImageData* image, const char* what)
+{
+  int* extent = image->GetExtent();
+  int* labelExtent = labels->GetExtent();
+  if (!std::equal(extent, extent + 6, labelExtent))
+  {
+    cerr << what << ": the extents differ." << endl;
+    return false;
+  }
+
+  vtkNew<vtkImageData> exported;
+  labels->ExportImage(exported, VTK_UNSIGNED_SHORT);
+  for (int z = extent[4]; z <= extent[5]; z++)
+  {
+    for (int y = extent[2]; y <= extent[3]; y++)
+    {
+      for (int x = extent[0]; x <= extent[1]; x++)
+      {
+        int expected = GetLabel(image, x, y, z);
+        if (labels->GetVoxelLabel(x, y, z) != expected ||
+          GetLabel(exported, x, y, z) != expected)
+        {
+          cerr << what << ": the label of (" << x << ", " << y << ", " << z << ") is "
+               << labels->GetVoxelLabel(x, y, z) << " instead of " << expected << endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool TestStatistics(vtkImageLabelStencilData* labels, vtkImageData* image)
+{
+  int* extent = image->GetExtent();
+  double* spacing = image->GetSpacing();
+  bool valid = true;
+  int numberOfLabels = 0;
+  for (int label = 1; label < 100; label++)
+  {
+    vtkIdType count = 0;
+    int labelExtent[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX,
+      VTK_INT_MIN };
+    for (int z = extent[4]; z <= extent[5]; z++)
+    {
+      for (int y = extent[2]; y <= extent[3]; y++)
+      {
+        for (int x = extent[0]; x <= extent[1]; x++)
+        {
+          if (GetLabel(image, x, y, z) == label)
+          {
+            count++;
+            int ijk[3] = { x, y, z };
+            for (int i = 0; i < 3; i++)
+            {
+              labelExtent[2 * i] = std::min(labelExtent[2 * i], ijk[i]);
+              labelExtent[2 * i + 1] = std::max(labelExtent[2 * i + 1], ijk[i]);
+            }
+          }
+        }
+      }
+    }
+
+    int computedExtent[6];
+    int found = labels->GetLabelExtent(label, computedExtent);
+    if (labels->GetNumberOfLabelVoxels(label) != count || found != (count > 0) ||
+      (count > 0 && !std::equal(labelExtent, labelExtent + 6, computedExtent)) ||
+      std::fabs(labels->GetLabelVolume(label) - count * spacing[0] * spacing[1] * spacing[2]) >
+        1e-9 * count)
+    {
+      cerr << "The statistics of label " << label << " are wrong: "
+           << labels->GetNumberOfLabelVoxels(label) << " voxels instead of " << count << endl;
+      valid = false;
+    }
+    if (count > 0)
+    {
+      if (labels->GetLabelValue(numberOfLabels) != label)
+      {
+        cerr << "Label " << numberOfLabels << " is " << labels->GetLabelValue(numberOfLabels)
+             << " instead of " << label << endl;
+        valid = false;
+      }
+      numberOfLabels++;
+    }
+  }
+  if (labels->GetNumberOfLabels() != numberOfLabels)
+  {
+    cerr << "There are " << labels->GetNumberOfLabels() << " labels instead of "
+         << numberOfLabels << endl;
+    valid = false;
+  }
+  return valid;
+}
+
+bool TestStencils(vtkImageLabelStencilData* labels, vtkImageData* image)
+{
+  int* extent = image->GetExtent();
+  bool valid = true;
+
+  // export each label as a stencil, and paint them back in reverse order
+  vtkNew<vtkImageLabelStencilData> painted;
+  for (int i = labels->GetNumberOfLabels() - 1; i >= 0; i--)
+  {
+    int label = labels->GetLabelValue(i);
+    vtkNew<vtkImageStencilData> stencil;
+    labels->ExportStencil(stencil, label);
+    for (int z = extent[4]; z <= extent[5]; z++)
+    {
+      for (int y = extent[2]; y <= extent[3]; y++)
+      {
+        for (int x = extent[0]; x <= extent[1]; x++)
+        {
+          if ((stencil->IsInside(x, y, z) != 0) != (GetLabel(image, x, y, z) == label))
+          {
+            cerr << "The stencil of label " << label << " is wrong at (" << x << ", " << y
+                 << ", " << z << ")" << endl;
+            return false;
+          }
+        }
+      }
+    }
+    painted->ImportStencil(stencil, label);
+  }
+  valid &= CompareLabels(painted, image, "ImportStencil");
+
+  // erase the voxels of one label
+  vtkNew<vtkImageStencilData> stencil;
+  labels->ExportStencil(stencil, labels->GetLabelValue(0));
+  painted->ImportStencil(stencil, 0);
+  if (painted->GetNumberOfLabelVoxels(labels->GetLabelValue(0)) != 0 ||
+    painted->GetNumberOfLabels() != labels->GetNumberOfLabels() - 1)
+  {
+    cerr << "Importing a stencil with label zero did not erase the label." << endl;
+    valid = false;
+  }
+
+  return valid;
+}
+
+bool TestBooleans(vtkImageData* imageA, vtkImageData* imageB)
+{
+  bool valid = true;
+  const char* names[3] = { "Union", "Intersection", "Difference" };
+  for (int operation = 0; operation < 3; operation++)
+  {
+    vtkNew<vtkImageLabelStencilData> a;
+    a->ImportImage(imageA);
+    vtkNew<vtkImageLabelStencilData> b;
+    b->ImportImage(imageB);
+
+    vtkNew<vtkImageData> expected;
+    expected->DeepCopy(imageA);
+    int* extent = expected->GetExtent();
+    for (int z = extent[4]; z <= extent[5]; z++)
+    {
+      for (int y = extent[2]; y <= extent[3]; y++)
+      {
+        for (int x = extent[0]; x <= extent[1]; x++)
+        {
+          int la = GetLabel(imageA, x, y, z);
+          int lb = GetLabel(imageB, x, y, z);
+          int label = (operation == 0 ? (la != 0 ? la : lb)
+                                      : (operation == 1 ? (lb != 0 ? la : 0) : (lb != 0 ? 0 : la)));
+          expected->SetScalarComponentFromDouble(x, y, z, 0, label);
+        }
+      }
+    }
+
+    if (operation == 0)
+    {
+      a->Union(b);
+    }
+    else if (operation == 1)
+    {
+      a->Intersection(b);
+    }
+    else
+    {
+      a->Difference(b);
+    }
+    valid &= CompareLabels(a, expected, names[operation]);
+  }
+  return valid;
+}
+
+// Use the stencil of the label map with the imaging filters.
+bool TestFilters(vtkImageLabelStencilData* labels, vtkImageData* labelImage)
+{
+  bool valid = true;
+  int* extent = labelImage->GetExtent();
+
+  vtkNew<vtkImageData> image;
+  image->SetExtent(extent);
+  image->SetSpacing(labelImage->GetSpacing());
+  image->SetOrigin(labelImage->GetOrigin());
+  image->AllocateScalars(VTK_FLOAT, 1);
+  for (int z = extent[4]; z <= extent[5]; z++)
+  {
+    for (int y = extent[2]; y <= extent[3]; y++)
+    {
+      for (int x = extent[0]; x <= extent[1]; x++)
+      {
+        image->SetScalarComponentFromDouble(x, y, z, 0, x + 2 * y + 3 * z);
+      }
+    }
+  }
+
+  // the stencil must follow the changes to the label range
+  for (int i = 0; i < 2; i++)
+  {
+    int label = labels->GetLabelValue((i + 1) * labels->GetNumberOfLabels() / 3);
+    labels->SetStencilLabel(label);
+
+    vtkNew<vtkImageAccumulate> accumulate;
+    accumulate->SetInputData(image);
+    accumulate->SetStencilData(labels->GetStencil());
+    accumulate->Update();
+
+    vtkNew<vtkImageStencil> stencil;
+    stencil->SetInputData(image);
+    stencil->SetStencilData(labels->GetStencil());
+    stencil->SetBackgroundValue(-1.0);
+    stencil->Update();
+
+    vtkIdType count = 0;
+    double sum = 0.0;
+    for (int z = extent[4]; z <= extent[5]; z++)
+    {
+      for (int y = extent[2]; y <= extent[3]; y++)
+      {
+        for (int x = extent[0]; x <= extent[1]; x++)
+        {
+          bool inside = (GetLabel(labelImage, x, y, z) == label);
+          double value = image->GetScalarComponentAsDouble(x, y, z, 0);
+          if (inside)
+          {
+            count++;
+            sum += value;
+          }
+          if (stencil->GetOutput()->GetScalarComponentAsDouble(x, y, z, 0) !=
+            (inside ? value : -1.0))
+          {
+            cerr << "vtkImageStencil is wrong at (" << x << ", " << y << ", " << z << ")" << endl;
+            return false;
+          }
+        }
+      }
+    }
+    if (accumulate->GetVoxelCount() != count ||
+      std::fabs(accumulate->GetMean()[0] - sum / count) > 1e-6 * std::fabs(sum / count))
+    {
+      cerr << "vtkImageAccumulate counted " << accumulate->GetVoxelCount() << " voxels instead of "
+           << count << endl;
+      valid = false;
+    }
+  }
+
+  labels->SetStencilLabelRange(VTK_INT_MIN, VTK_INT_MAX);
+  return valid;
+}
+
+} // anonymous namespace
+
+int TestImageLabelStencilData(int, char*[])
+{
+  bool valid = true;
+
+  const int extentA[6] = { -5, 58, 0, 47, 3, 22 };
+  vtkSmartPointer<vtkImageData> imageA = MakeLabels(extentA, 40, 1, 1234);
+
+  vtkNew<vtkImageLabelStencilData> labels;
+  labels->ImportImage(imageA);
+  valid &= CompareLabels(labels, imageA, "ImportImage");
+  valid &= TestStatistics(labels, imageA);
+  valid &= TestStencils(labels, imageA);
+  valid &= TestFilters(labels, imageA);
+
+  // the runs must be much smaller than the image
+  if (labels->GetActualMemorySize() * 1024 >=
+    static_cast<unsigned long>(imageA->GetNumberOfPoints() * sizeof(short)) / 2)
+  {
+    cerr << "The label map uses " << labels->GetActualMemorySize() << " KiB." << endl;
+    valid = false;
+  }
+
+  vtkNew<vtkImageLabelStencilData> copied;
+  copied->DeepCopy(labels);
+  valid &= CompareLabels(copied, imageA, "DeepCopy");
+
+  // the second map is shifted, so that it is partly outside of the first
+  const int extentB[6] = { 10, 70, -10, 30, 0, 15 };
+  vtkSmartPointer<vtkImageData> imageB = MakeLabels(extentB, 30, 60, 4321);
+  valid &= TestBooleans(imageA, imageB);
+
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,216 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageRankFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests vtkImageRankFilter against rank statistics computed by sorting each
+// neighborhood, for histograms of values and of indices, and compares the
+// median with vtkImageMedian3D.
+
+#include "vtkDataArray.h"
+#include "vtkImageAppendComponents.h"
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkImageMedian3D.h"
+#include "vtkImageNoiseSource.h"
+#include "vtkImageRankFilter.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+// Random values, with a fixed seed so that the test is repeatable.
+vtkSmartPointer<vtkImageData> MakeImage(int scalarType, int components, double range)
+{
+  // center the values for signed integer types
+  double minimum = 0.0;
+  if (scalarType != VTK_FLOAT && scalarType != VTK_DOUBLE &&
+    vtkDataArray::GetDataTypeMin(scalarType) < 0)
+  {
+    minimum = -range / 2;
+  }
+
+  vtkMath::RandomSeed(1234);
+  vtkNew<vtkImageAppendComponents> append;
+  for (int c = 0; c < components; c++)
+  {
+    vtkNew<vtkImageNoiseSource> noise;
+    noise->SetWholeExtent(-3, 14, 2, 13, 0, 6);
+    noise->SetMinimum(minimum);
+    noise->SetMaximum(minimum + range);
+    append->AddInputConnection(noise->GetOutputPort());
+  }
+
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputConnection(append->GetOutputPort());
+  cast->SetOutputScalarType(scalarType);
+  cast->Update();
+  return cast->GetOutput();
+}
+
+// Compute the statistic for one voxel by sorting its neighborhood.
+double BruteForce(vtkImageData* image, const int kernelSize[3], int mode, double percentile,
+  int x, int y, int z, int c)
+{
+  int* ext = image->GetExtent();
+  int ijk[3] = { x, y, z };
+  int range[6];
+  for (int i = 0; i < 3; i++)
+  {
+    range[2 * i] = std::max(ijk[i] - kernelSize[i] / 2, ext[2 * i]);
+    range[2 * i + 1] = std::min(ijk[i] - kernelSize[i] / 2 + kernelSize[i] - 1, ext[2 * i + 1]);
+  }
+  std::vector<double> values;
+  for (int k = range[4]; k <= range[5]; k++)
+  {
+    for (int j = range[2]; j <= range[3]; j++)
+    {
+      for (int i = range[0]; i <= range[1]; i++)
+      {
+        values.push_back(image->GetScalarComponentAsDouble(i, j, k, c));
+      }
+    }
+  }
+  std::sort(values.begin(), values.end());
+  size_t n = values.size();
+  bool isInteger = (image->GetScalarType() != VTK_FLOAT && image->GetScalarType() != VTK_DOUBLE);
+  switch (mode)
+  {
+    case vtkImageRankFilter::Median:
+    {
+      double low = values[(n - 1) / 2];
+      double high = values[n / 2];
+      double half = (high - low) / 2;
+      return low + (isInteger ? std::floor(half) : half);
+    }
+    case vtkImageRankFilter::Percentile:
+      return values[static_cast<size_t>(std::floor(percentile * (n - 1) / 100.0 + 0.5))];
+    case vtkImageRankFilter::Minimum:
+      return values[0];
+    case vtkImageRankFilter::Maximum:
+      return values[n - 1];
+  }
+  return std::min(values[n - 1] - values[0], image->GetScalarTypeMax());
+}
+
+bool Check(vtkImageData* image, const int kernelSize[3], int mode, double percentile)
+{
+  vtkNew<vtkImageRankFilter> filter;
+  filter->SetInputData(image);
+  filter->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+  filter->SetRankMode(mode);
+  filter->SetPercentileValue(percentile);
+  filter->Update();
+  vtkImageData* output = filter->GetOutput();
+
+  int* ext = image->GetExtent();
+  for (int z = ext[4]; z <= ext[5]; z++)
+  {
+    for (int y = ext[2]; y <= ext[3]; y++)
+    {
+      for (int x = ext[0]; x <= ext[1]; x++)
+      {
+        for (int c = 0; c < image->GetNumberOfScalarComponents(); c++)
+        {
+          double expected = BruteForce(image, kernelSize, mode, percentile, x, y, z, c);
+          double value = output->GetScalarComponentAsDouble(x, y, z, c);
+          if (std::fabs(value - expected) > 1e-6 * std::fabs(expected))
+          {
+            cerr << filter->GetRankModeAsString() << " of " << image->GetScalarTypeAsString()
+                 << " with kernel " << kernelSize[0] << "x" << kernelSize[1] << "x"
+                 << kernelSize[2] << " at (" << x << ", " << y << ", " << z << ", " << c
+                 << ") is " << value << " instead of " << expected << endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// The median must match vtkImageMedian3D exactly.
+bool CheckMedian3D(vtkImageData* image, const int kernelSize[3])
+{
+  vtkNew<vtkImageRankFilter> filter;
+  filter->SetInputData(image);
+  filter->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+  filter->Update();
+
+  vtkNew<vtkImageMedian3D> median;
+  median->SetInputData(image);
+  median->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+  median->Update();
+
+  vtkDataArray* a = filter->GetOutput()->GetPointData()->GetScalars();
+  vtkDataArray* b = median->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); c++)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        cerr << "Median of " << image->GetScalarTypeAsString()
+             << " differs from vtkImageMedian3D at point " << i << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int TestImageRankFilter(int, char*[])
+{
+  // unsigned char and short values go directly into a histogram, while int,
+  // float and double values are first replaced by indices
+  vtkSmartPointer<vtkImageData> images[5] = {
+    MakeImage(VTK_UNSIGNED_CHAR, 1, 8),
+    MakeImage(VTK_SHORT, 2, 3000),
+    MakeImage(VTK_INT, 1, 4.0e9),
+    MakeImage(VTK_FLOAT, 1, 100),
+    MakeImage(VTK_DOUBLE, 3, 100),
+  };
+
+  // odd and even sizes, and a 2D kernel
+  const int kernelSizes[3][3] = { { 3, 3, 3 }, { 4, 5, 2 }, { 7, 1, 5 } };
+
+  bool valid = true;
+  for (auto& image : images)
+  {
+    for (auto kernelSize : kernelSizes)
+    {
+      valid &= Check(image, kernelSize, vtkImageRankFilter::Median, 50.0);
+      valid &= Check(image, kernelSize, vtkImageRankFilter::Percentile, 10.0);
+      valid &= Check(image, kernelSize, vtkImageRankFilter::Percentile, 100.0);
+      valid &= Check(image, kernelSize, vtkImageRankFilter::Minimum, 50.0);
+      valid &= Check(image, kernelSize, vtkImageRankFilter::Maximum, 50.0);
+      valid &= Check(image, kernelSize, vtkImageRankFilter::Range, 50.0);
+      valid &= CheckMedian3D(image, kernelSize);
+    }
+  }
+
+  // a range that does not fit in a short is clamped
+  vtkSmartPointer<vtkImageData> wide = MakeImage(VTK_SHORT, 1, 65535);
+  const int kernelSize[3] = { 3, 3, 3 };
+  valid &= Check(wide, kernelSize, vtkImageRankFilter::Range, 50.0);
+
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
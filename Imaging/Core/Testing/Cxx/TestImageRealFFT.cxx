@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageRealFFT.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that vtkImageRealFFT computes the half spectrum given by vtkImageFFT,
+// and that its inverse gives the input back.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageFFT.h"
+#include "vtkImageRealFFT.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+
+namespace
+{
+
+void MakeImage(vtkImageData* image, int nx, int ny, int nz)
+{
+  image->SetExtent(2, nx + 1, -1, ny - 2, 0, nz - 1);
+  image->AllocateScalars(VTK_SHORT, 1);
+  short* ptr = static_cast<short*>(image->GetScalarPointer());
+  for (int k = 0; k < nz; ++k)
+  {
+    for (int j = 0; j < ny; ++j)
+    {
+      for (int i = 0; i < nx; ++i)
+      {
+        *ptr++ = static_cast<short>((i * 37 + j * 11 + k * 53 + i * j) % 101 - 50);
+      }
+    }
+  }
+}
+
+bool TestSize(int nx, int ny, int nz, int dimensionality, int scalarType)
+{
+  vtkNew<vtkImageData> image;
+  MakeImage(image, nx, ny, nz);
+  // The values of the spectrum are bounded by the sum of the absolute
+  // values of the image, which are at most 50.
+  const double tolerance = (scalarType == VTK_FLOAT) ? 1e-3 : 1e-8;
+  const double spectrumTolerance = 50.0 * image->GetNumberOfPoints() * tolerance * 1e-3;
+
+  vtkNew<vtkImageFFT> fft;
+  fft->SetDimensionality(dimensionality);
+  fft->SetInputData(image);
+  fft->Update();
+
+  vtkNew<vtkImageRealFFT> realFFT;
+  realFFT->SetDimensionality(dimensionality);
+  realFFT->SetOutputScalarType(scalarType);
+  realFFT->SetInputData(image);
+  realFFT->Update();
+
+  // The half spectrum along X.
+  vtkImageData* full = fft->GetOutput();
+  vtkImageData* half = realFFT->GetOutput();
+  int* extent = half->GetExtent();
+  if (half->GetScalarType() != scalarType || half->GetNumberOfScalarComponents() != 2 ||
+    extent[0] != 2 || extent[1] != 2 + nx / 2 || extent[2] != -1 || extent[5] != nz - 1)
+  {
+    cerr << "Wrong spectrum for " << nx << "x" << ny << "x" << nz << endl;
+    return false;
+  }
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+      {
+        for (int c = 0; c < 2; ++c)
+        {
+          double a = full->GetScalarComponentAsDouble(i, j, k, c);
+          double b = half->GetScalarComponentAsDouble(i, j, k, c);
+          if (std::fabs(a - b) > spectrumTolerance)
+          {
+            cerr << "Spectrum of " << nx << "x" << ny << "x" << nz << " differs at (" << i
+                 << ", " << j << ", " << k << "): " << a << " != " << b << endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+
+  // The inverse gives the input back.
+  vtkNew<vtkImageRealFFT> inverse;
+  inverse->InverseOn();
+  inverse->SetInverseXDimension(nx);
+  inverse->SetDimensionality(dimensionality);
+  inverse->SetOutputScalarType(scalarType);
+  inverse->SetInputConnection(realFFT->GetOutputPort());
+  inverse->Update();
+  vtkImageData* output = inverse->GetOutput();
+  if (output->GetNumberOfScalarComponents() != 1 || output->GetExtent()[1] != nx + 1)
+  {
+    cerr << "Wrong inverse for " << nx << "x" << ny << "x" << nz << endl;
+    return false;
+  }
+  vtkIdType n = image->GetNumberOfPoints();
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    double a = image->GetPointData()->GetScalars()->GetTuple1(i);
+    double b = output->GetPointData()->GetScalars()->GetTuple1(i);
+    if (std::fabs(a - b) > tolerance)
+    {
+      cerr << "Inverse of " << nx << "x" << ny << "x" << nz << " differs at " << i << ": " << a
+           << " != " << b << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int TestImageRealFFT(int, char*[])
+{
+  bool valid = TestSize(16, 8, 4, 3, VTK_DOUBLE);
+  valid &= TestSize(15, 7, 5, 3, VTK_DOUBLE);
+  valid &= TestSize(40, 21, 3, 2, VTK_DOUBLE);
+  valid &= TestSize(9, 18, 1, 1, VTK_FLOAT);
+  valid &= TestSize(24, 12, 6, 3, VTK_FLOAT);
+  valid &= TestSize(1, 4, 2, 3, VTK_DOUBLE);
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -97,6 +97,8 @@ vtkAbstractImageInterpolator::vtkAbstractImageInterpolator()
     &(vtkInterpolateNOP<double>::RowInterpolationFunc);
   this->RowInterpolationFuncFloat =
     &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+  this->LineInterpolationFuncDouble = nullptr;
+  this->LineInterpolationFuncFloat = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -731,6 +733,8 @@ void vtkAbstractImageInterpolator::Update()
       &(vtkInterpolateNOP<double>::RowInterpolationFunc);
     this->RowInterpolationFuncFloat =
       &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+    this->LineInterpolationFuncDouble = nullptr;
+    this->LineInterpolationFuncFloat = nullptr;
 
     return;
   }
@@ -803,6 +807,10 @@ void vtkAbstractImageInterpolator::Update()
   // get the functions that will perform the interpolation
   this->GetInterpolationFunc(&this->InterpolationFuncDouble);
   this->GetInterpolationFunc(&this->InterpolationFuncFloat);
+  this->LineInterpolationFuncDouble = nullptr;
+  this->LineInterpolationFuncFloat = nullptr;
+  this->GetLineInterpolationFunc(&this->LineInterpolationFuncDouble);
+  this->GetLineInterpolationFunc(&this->LineInterpolationFuncFloat);
 
   if (this->SlidingWindow)
   {
@@ -874,6 +882,63 @@ double vtkAbstractImageInterpolator::Interpolate(
   return value;
 }
 
+//----------------------------------------------------------------------------
+namespace {
+
+template<class F>
+void vtkInterpolateLineIJK(
+  void (*interpolate)(vtkInterpolationInfo *, const F [3], F *),
+  vtkInterpolationInfo *info, const F base[3], const F step[3],
+  int first, int n, F *value)
+{
+  int numscalars = info->NumberOfComponents;
+  for (int i = 0; i < n; i++)
+  {
+    F point[3];
+    point[0] = base[0] + (first + i)*step[0];
+    point[1] = base[1] + (first + i)*step[1];
+    point[2] = base[2] + (first + i)*step[2];
+    interpolate(info, point, value);
+    value += numscalars;
+  }
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::InterpolateLineIJK(
+  const double base[3], const double step[3], int first, int n,
+  double *value)
+{
+  if (this->LineInterpolationFuncDouble)
+  {
+    this->LineInterpolationFuncDouble(
+      this->InterpolationInfo, base, step, first, n, value);
+  }
+  else
+  {
+    vtkInterpolateLineIJK(this->InterpolationFuncDouble,
+      this->InterpolationInfo, base, step, first, n, value);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::InterpolateLineIJK(
+  const float base[3], const float step[3], int first, int n,
+  float *value)
+{
+  if (this->LineInterpolationFuncFloat)
+  {
+    this->LineInterpolationFuncFloat(
+      this->InterpolationInfo, base, step, first, n, value);
+  }
+  else
+  {
+    vtkInterpolateLineIJK(this->InterpolationFuncFloat,
+      this->InterpolationInfo, base, step, first, n, value);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkAbstractImageInterpolator::GetInterpolationFunc(
   void (**)(vtkInterpolationInfo *, const double [3], double *))
@@ -898,6 +963,20 @@ void vtkAbstractImageInterpolator::GetRowInterpolationFunc(
 {
 }
 
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetLineInterpolationFunc(
+  void (**)(vtkInterpolationInfo *, const double [3], const double [3],
+            int, int, double *))
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetLineInterpolationFunc(
+  void (**)(vtkInterpolationInfo *, const float [3], const float [3],
+            int, int, float *))
+{
+}
+
 //----------------------------------------------------------------------------
 void vtkAbstractImageInterpolator::GetSlidingWindowFunc(
   void (**)(vtkInterpolationWeights *, int, int, int, double *, int))
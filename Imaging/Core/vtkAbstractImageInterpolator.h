@@ -156,6 +156,20 @@ public:
   bool CheckBoundsIJK(const float x[3]);
   //@}
 
+  //@{
+  /**
+   * Interpolate n samples along a line of structured coords, where sample i
+   * is at base + (first + i)*step.  All the samples must be within the
+   * bounds checked by CheckBoundsIJK.  The result is the same as calling
+   * InterpolateIJK for each sample, but interpolators that provide line
+   * functions amortize the per-sample overhead over the whole line.
+   */
+  void InterpolateLineIJK(const double base[3], const double step[3],
+    int first, int n, double *value);
+  void InterpolateLineIJK(const float base[3], const float step[3],
+    int first, int n, float *value);
+  //@}
+
   //@{
   /**
    * The border mode (default: clamp).  This controls how out-of-bounds
@@ -310,6 +324,21 @@ protected:
       vtkInterpolationWeights *, int, int, int, float *, int));
   //@}
 
+  //@{
+  /**
+   * Get the line interpolation functions.  The default is nullptr, in which
+   * case InterpolateLineIJK calls the interpolation function per sample.
+   */
+  virtual void GetLineInterpolationFunc(
+    void (**doublefunc)(
+      vtkInterpolationInfo *, const double [3], const double [3], int, int,
+      double *));
+  virtual void GetLineInterpolationFunc(
+    void (**floatfunc)(
+      vtkInterpolationInfo *, const float [3], const float [3], int, int,
+      float *));
+  //@}
+
   //@{
   /**
    * Get the sliding window interpolation functions.
@@ -343,6 +372,13 @@ protected:
   void (*InterpolationFuncFloat)(
     vtkInterpolationInfo *info, const float point[3], float *outPtr);
 
+  void (*LineInterpolationFuncDouble)(
+    vtkInterpolationInfo *info, const double base[3], const double step[3],
+    int first, int n, double *outPtr);
+  void (*LineInterpolationFuncFloat)(
+    vtkInterpolationInfo *info, const float base[3], const float step[3],
+    int first, int n, float *outPtr);
+
   void (*RowInterpolationFuncDouble)(
     vtkInterpolationWeights *weights, int idX, int idY, int idZ,
     double *outPtr, int n);
@@ -505,6 +505,141 @@ void vtkImageInterpolatorGetInterpolationFunc(
   }
 }
 
+//----------------------------------------------------------------------------
+// Interpolation along lines of samples.  The samples of a line are processed
+// in blocks: the indices and offsets of the samples of a block are computed
+// in loops that the compiler can vectorize, then the values are loaded for
+// the whole block.  Only nearest-neighbor interpolation has a line function,
+// the other modes are interpolated one sample at a time.
+
+const int vtkImageNLCLineBlockSize = 16;
+
+//----------------------------------------------------------------------------
+// Limit the indices of a block to [minIdx, maxIdx], and subtract minIdx
+inline void vtkImageNLCLineBorder(
+  int borderMode, int *idx, int n, int minIdx, int maxIdx)
+{
+  switch (borderMode)
+  {
+    case VTK_IMAGE_BORDER_REPEAT:
+      for (int i = 0; i < n; i++)
+      {
+        idx[i] = vtkInterpolationMath::Wrap(idx[i], minIdx, maxIdx);
+      }
+      break;
+
+    case VTK_IMAGE_BORDER_MIRROR:
+      for (int i = 0; i < n; i++)
+      {
+        idx[i] = vtkInterpolationMath::Mirror(idx[i], minIdx, maxIdx);
+      }
+      break;
+
+    default:
+      for (int i = 0; i < n; i++)
+      {
+        idx[i] = vtkInterpolationMath::Clamp(idx[i], minIdx, maxIdx);
+      }
+      break;
+  }
+}
+
+//----------------------------------------------------------------------------
+template<class F, class T>
+struct vtkImageNLCLineInterpolate
+{
+  static void Nearest(
+    vtkInterpolationInfo *info, const F base[3], const F step[3],
+    int first, int n, F *outPtr);
+};
+
+//----------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageNLCLineInterpolate<F, T>::Nearest(
+  vtkInterpolationInfo *info, const F base[3], const F step[3],
+  int first, int n, F *outPtr)
+{
+  const T *inPtr = static_cast<const T *>(info->Pointer);
+  int *inExt = info->Extent;
+  vtkIdType *inInc = info->Increments;
+  int numscalars = info->NumberOfComponents;
+  int borderMode = info->BorderMode;
+
+  const int blockSize = vtkImageNLCLineBlockSize;
+  int inIdX[blockSize], inIdY[blockSize], inIdZ[blockSize];
+  vtkIdType offsets[blockSize];
+
+  for (int i0 = 0; i0 < n; i0 += blockSize)
+  {
+    int m = ((n - i0 < blockSize) ? n - i0 : blockSize);
+    for (int i = 0; i < m; i++)
+    {
+      int j = first + i0 + i;
+      F x = base[0] + j*step[0];
+      F y = base[1] + j*step[1];
+      F z = base[2] + j*step[2];
+      inIdX[i] = vtkInterpolationMath::Round(x);
+      inIdY[i] = vtkInterpolationMath::Round(y);
+      inIdZ[i] = vtkInterpolationMath::Round(z);
+    }
+
+    vtkImageNLCLineBorder(borderMode, inIdX, m, inExt[0], inExt[1]);
+    vtkImageNLCLineBorder(borderMode, inIdY, m, inExt[2], inExt[3]);
+    vtkImageNLCLineBorder(borderMode, inIdZ, m, inExt[4], inExt[5]);
+
+    for (int i = 0; i < m; i++)
+    {
+      offsets[i] = inIdX[i]*inInc[0] + inIdY[i]*inInc[1] + inIdZ[i]*inInc[2];
+    }
+
+    if (numscalars == 1)
+    {
+      for (int i = 0; i < m; i++)
+      {
+        *outPtr++ = static_cast<F>(inPtr[offsets[i]]);
+      }
+    }
+    else
+    {
+      for (int i = 0; i < m; i++)
+      {
+        const T *tmpPtr = inPtr + offsets[i];
+        for (int c = 0; c < numscalars; c++)
+        {
+          *outPtr++ = static_cast<F>(tmpPtr[c]);
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Get the line interpolation function for the specified data types
+template<class F>
+void vtkImageInterpolatorGetLineInterpolationFunc(
+  void (**interpolate)(vtkInterpolationInfo *, const F [3], const F [3],
+                       int, int, F *),
+  int dataType, int interpolationMode)
+{
+  switch (interpolationMode)
+  {
+    case VTK_NEAREST_INTERPOLATION:
+      switch (dataType)
+      {
+        vtkTemplateAliasMacro(
+          *interpolate =
+            &(vtkImageNLCLineInterpolate<F, VTK_TT>::Nearest)
+          );
+        default:
+          *interpolate = nullptr;
+      }
+      break;
+    default:
+      *interpolate = nullptr;
+      break;
+  }
+}
+
 //----------------------------------------------------------------------------
 // Interpolation for precomputed weights
 
@@ -1086,6 +1221,24 @@ void vtkImageInterpolator::GetRowInterpolationFunc(
     func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
 }
 
+//----------------------------------------------------------------------------
+void vtkImageInterpolator::GetLineInterpolationFunc(
+  void (**func)(vtkInterpolationInfo *, const double [3], const double [3],
+                int, int, double *))
+{
+  vtkImageInterpolatorGetLineInterpolationFunc(
+    func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageInterpolator::GetLineInterpolationFunc(
+  void (**func)(vtkInterpolationInfo *, const float [3], const float [3],
+                int, int, float *))
+{
+  vtkImageInterpolatorGetLineInterpolationFunc(
+    func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
+}
+
 //----------------------------------------------------------------------------
 void vtkImageInterpolator::PrecomputeWeightsForExtent(
   const double matrix[16], const int extent[6], int newExtent[6],
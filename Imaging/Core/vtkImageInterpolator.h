@@ -130,6 +130,22 @@ protected:
       vtkInterpolationWeights *, int, int, int, float *, int)) override;
   //@}
 
+  //@{
+  /**
+   * Get the line interpolation functions.  Only nearest-neighbor
+   * interpolation has a line function, which processes the samples of a
+   * line in blocks.
+   */
+  void GetLineInterpolationFunc(
+    void (**doublefunc)(
+      vtkInterpolationInfo *, const double [3], const double [3], int, int,
+      double *)) override;
+  void GetLineInterpolationFunc(
+    void (**floatfunc)(
+      vtkInterpolationInfo *, const float [3], const float [3], int, int,
+      float *)) override;
+  //@}
+
   int InterpolationMode;
 
 private:
@@ -0,0 +1,848 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageLabelStencilData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageLabelStencilData.h"
+
+#include "vtkImageData.h"
+#include "vtkImageStencilData.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimeStamp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <vector>
+
+vtkStandardNewMacro(vtkImageLabelStencilData);
+
+//----------------------------------------------------------------------------
+namespace
+{
+
+// A run of voxels [Begin, End] along x that have the same label.
+struct vtkLabelRun
+{
+  int Begin;
+  int End;
+  int Label;
+};
+
+typedef std::vector<std::vector<vtkLabelRun> > vtkLabelRows;
+
+// The number of voxels and the extent of one label.
+struct vtkLabelStatistics
+{
+  vtkIdType NumberOfVoxels;
+  int Extent[6];
+};
+
+typedef std::map<int, vtkLabelStatistics> vtkLabelStatisticsMap;
+
+// The ways in which two rows of runs can be combined.
+enum vtkLabelOperation
+{
+  LabelUnion,
+  LabelIntersection,
+  LabelDifference,
+  LabelPaint
+};
+
+// Append a run to a row after clipping it to [xMin, xMax], and merge it
+// with the previous run if they touch and have the same label.
+void vtkLabelRunAppend(
+  std::vector<vtkLabelRun>& row, int begin, int end, int label, int xMin, int xMax)
+{
+  begin = std::max(begin, xMin);
+  end = std::min(end, xMax);
+  if (begin > end || label == 0)
+  {
+    return;
+  }
+  if (!row.empty() && row.back().End + 1 == begin && row.back().Label == label)
+  {
+    row.back().End = end;
+  }
+  else
+  {
+    vtkLabelRun run = { begin, end, label };
+    row.push_back(run);
+  }
+}
+
+// Combine two sorted rows of runs, by walking through the pieces of the
+// row over which neither of the two labels changes.
+void vtkLabelRunCombine(const vtkLabelRun* a, const vtkLabelRun* aEnd, const vtkLabelRun* b,
+  const vtkLabelRun* bEnd, int xMin, int xMax, int operation, int paintLabel,
+  std::vector<vtkLabelRun>& row)
+{
+  int x = VTK_INT_MAX;
+  if (a != aEnd)
+  {
+    x = a->Begin;
+  }
+  if (b != bEnd)
+  {
+    x = std::min(x, b->Begin);
+  }
+
+  while (a != aEnd || b != bEnd)
+  {
+    int aLabel = 0;
+    int aLast = VTK_INT_MAX;
+    if (a != aEnd)
+    {
+      aLabel = (x < a->Begin ? 0 : a->Label);
+      aLast = (x < a->Begin ? a->Begin - 1 : a->End);
+    }
+    int bLabel = 0;
+    int bLast = VTK_INT_MAX;
+    if (b != bEnd)
+    {
+      bLabel = (x < b->Begin ? 0 : b->Label);
+      bLast = (x < b->Begin ? b->Begin - 1 : b->End);
+    }
+    int last = std::min(aLast, bLast);
+
+    int label = 0;
+    switch (operation)
+    {
+      case LabelUnion:
+        label = (aLabel != 0 ? aLabel : bLabel);
+        break;
+      case LabelIntersection:
+        label = (bLabel != 0 ? aLabel : 0);
+        break;
+      case LabelDifference:
+        label = (bLabel != 0 ? 0 : aLabel);
+        break;
+      case LabelPaint:
+        label = (bLabel != 0 ? paintLabel : aLabel);
+        break;
+    }
+    vtkLabelRunAppend(row, x, last, label, xMin, xMax);
+
+    x = last + 1;
+    if (a != aEnd && a->End < x)
+    {
+      ++a;
+    }
+    if (b != bEnd && b->End < x)
+    {
+      ++b;
+    }
+  }
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+// The runs are stored for all the rows together, in the same order as the
+// extent lists of vtkImageStencilData.
+class vtkImageLabelStencilDataInternals
+{
+public:
+  vtkImageLabelStencilDataInternals()
+  {
+    const int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    this->Clear(emptyExtent);
+  }
+
+  vtkIdType GetNumberOfRows() const
+  {
+    if (this->Extent[0] > this->Extent[1] || this->Extent[2] > this->Extent[3] ||
+      this->Extent[4] > this->Extent[5])
+    {
+      return 0;
+    }
+    return static_cast<vtkIdType>(this->Extent[3] - this->Extent[2] + 1) *
+      (this->Extent[5] - this->Extent[4] + 1);
+  }
+
+  // Get the row at (yIdx, zIdx), or -1 if it is outside of the extent.
+  vtkIdType GetRow(int yIdx, int zIdx) const
+  {
+    if (this->GetNumberOfRows() == 0 || yIdx < this->Extent[2] || yIdx > this->Extent[3] ||
+      zIdx < this->Extent[4] || zIdx > this->Extent[5])
+    {
+      return -1;
+    }
+    return static_cast<vtkIdType>(zIdx - this->Extent[4]) *
+      (this->Extent[3] - this->Extent[2] + 1) +
+      (yIdx - this->Extent[2]);
+  }
+
+  // Get the y and z indices of a row.
+  void GetRowIndices(vtkIdType row, int& yIdx, int& zIdx) const
+  {
+    vtkIdType ySize = this->Extent[3] - this->Extent[2] + 1;
+    yIdx = this->Extent[2] + static_cast<int>(row % ySize);
+    zIdx = this->Extent[4] + static_cast<int>(row / ySize);
+  }
+
+  const vtkLabelRun* RowBegin(vtkIdType row) const
+  {
+    return this->Runs.data() + this->RowStarts[row];
+  }
+
+  const vtkLabelRun* RowEnd(vtkIdType row) const
+  {
+    return this->Runs.data() + this->RowStarts[row + 1];
+  }
+
+  // Remove all the runs, and set the extent.
+  void Clear(const int extent[6])
+  {
+    std::copy(extent, extent + 6, this->Extent);
+    this->RowStarts.assign(this->GetNumberOfRows() + 1, 0);
+    this->Runs.clear();
+    this->LabelTime.Modified();
+  }
+
+  // Replace the runs with the given rows.
+  void SetRows(const vtkLabelRows& rows)
+  {
+    vtkIdType n = static_cast<vtkIdType>(rows.size());
+    this->RowStarts.resize(n + 1);
+    this->RowStarts[0] = 0;
+    for (vtkIdType i = 0; i < n; i++)
+    {
+      this->RowStarts[i + 1] = this->RowStarts[i] + static_cast<vtkIdType>(rows[i].size());
+    }
+    this->Runs.resize(this->RowStarts[n]);
+    for (vtkIdType i = 0; i < n; i++)
+    {
+      std::copy(rows[i].begin(), rows[i].end(), this->Runs.begin() + this->RowStarts[i]);
+    }
+    this->LabelTime.Modified();
+  }
+
+  int Extent[6];
+  std::vector<vtkIdType> RowStarts;
+  std::vector<vtkLabelRun> Runs;
+  vtkTimeStamp LabelTime;
+
+  vtkLabelStatisticsMap Statistics;
+  std::vector<int> Labels;
+  vtkTimeStamp StatisticsTime;
+
+  vtkSmartPointer<vtkImageStencilData> Stencil;
+  vtkTimeStamp StencilTime;
+};
+
+//----------------------------------------------------------------------------
+namespace
+{
+
+typedef vtkImageLabelStencilDataInternals vtkLabelInternals;
+
+// Find the runs of each row of an image.
+template <class T>
+struct vtkLabelImportFunctor
+{
+  const T* Input;
+  vtkIdType Increments[3];
+  const vtkLabelInternals* Internals;
+  vtkLabelRows* Rows;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const int* extent = this->Internals->Extent;
+    for (vtkIdType row = begin; row < end; row++)
+    {
+      int yIdx, zIdx;
+      this->Internals->GetRowIndices(row, yIdx, zIdx);
+      const T* inPtr = this->Input + (yIdx - extent[2]) * this->Increments[1] +
+        (zIdx - extent[4]) * this->Increments[2];
+      std::vector<vtkLabelRun>& runs = (*this->Rows)[row];
+      for (int xIdx = extent[0]; xIdx <= extent[1]; xIdx++)
+      {
+        vtkLabelRunAppend(
+          runs, xIdx, xIdx, static_cast<int>(*inPtr), extent[0], extent[1]);
+        inPtr += this->Increments[0];
+      }
+    }
+  }
+};
+
+// Write the labels of each row into an image that was filled with zeros.
+template <class T>
+struct vtkLabelExportFunctor
+{
+  T* Output;
+  const vtkLabelInternals* Internals;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const int* extent = this->Internals->Extent;
+    vtkIdType xSize = extent[1] - extent[0] + 1;
+    for (vtkIdType row = begin; row < end; row++)
+    {
+      T* outPtr = this->Output + row * xSize;
+      for (const vtkLabelRun* run = this->Internals->RowBegin(row);
+           run != this->Internals->RowEnd(row); ++run)
+      {
+        std::fill(outPtr + (run->Begin - extent[0]), outPtr + (run->End - extent[0] + 1),
+          static_cast<T>(run->Label));
+      }
+    }
+  }
+};
+
+template <class T>
+void vtkLabelImport(const T* inPtr, const vtkIdType increments[3],
+  const vtkLabelInternals* internals, vtkLabelRows* rows)
+{
+  vtkLabelImportFunctor<T> importer;
+  importer.Input = inPtr;
+  std::copy(increments, increments + 3, importer.Increments);
+  importer.Internals = internals;
+  importer.Rows = rows;
+  vtkSMPTools::For(0, internals->GetNumberOfRows(), importer);
+}
+
+template <class T>
+void vtkLabelExport(T* outPtr, const vtkLabelInternals* internals)
+{
+  vtkLabelExportFunctor<T> exporter;
+  exporter.Output = outPtr;
+  exporter.Internals = internals;
+  vtkSMPTools::For(0, internals->GetNumberOfRows(), exporter);
+}
+
+// Combine each row with the same row of another label map, or with the
+// same row of a stencil.
+struct vtkLabelCombineFunctor
+{
+  const vtkLabelInternals* Internals;
+  const vtkLabelInternals* Other;
+  vtkImageStencilData* Stencil;
+  int Operation;
+  int PaintLabel;
+  vtkLabelRows* Rows;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const int* extent = this->Internals->Extent;
+    std::vector<vtkLabelRun> stencilRuns;
+    for (vtkIdType row = begin; row < end; row++)
+    {
+      int yIdx, zIdx;
+      this->Internals->GetRowIndices(row, yIdx, zIdx);
+
+      const vtkLabelRun* b = nullptr;
+      const vtkLabelRun* bEnd = nullptr;
+      if (this->Stencil)
+      {
+        stencilRuns.clear();
+        int r1, r2;
+        int iter = 0;
+        while (this->Stencil->GetNextExtent(r1, r2, extent[0], extent[1], yIdx, zIdx, iter))
+        {
+          vtkLabelRunAppend(stencilRuns, r1, r2, 1, extent[0], extent[1]);
+        }
+        b = stencilRuns.data();
+        bEnd = b + stencilRuns.size();
+      }
+      else
+      {
+        vtkIdType otherRow = this->Other->GetRow(yIdx, zIdx);
+        if (otherRow >= 0)
+        {
+          b = this->Other->RowBegin(otherRow);
+          bEnd = this->Other->RowEnd(otherRow);
+        }
+      }
+
+      std::vector<vtkLabelRun>& runs = (*this->Rows)[row];
+      vtkLabelRunCombine(this->Internals->RowBegin(row), this->Internals->RowEnd(row), b, bEnd,
+        extent[0], extent[1], this->Operation, this->PaintLabel, runs);
+    }
+  }
+};
+
+// Insert the runs whose labels are within a range into a stencil, whose
+// extent lists must have been allocated with the extent of the labels.
+// Each row has its own extent list, so the rows can be filled in parallel.
+struct vtkLabelStencilFunctor
+{
+  const vtkLabelInternals* Internals;
+  vtkImageStencilData* Stencil;
+  int Range[2];
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType row = begin; row < end; row++)
+    {
+      int yIdx, zIdx;
+      this->Internals->GetRowIndices(row, yIdx, zIdx);
+      int r1 = 0;
+      int r2 = -1;
+      for (const vtkLabelRun* run = this->Internals->RowBegin(row);
+           run != this->Internals->RowEnd(row); ++run)
+      {
+        if (run->Label < this->Range[0] || run->Label > this->Range[1])
+        {
+          continue;
+        }
+        if (r1 <= r2 && run->Begin == r2 + 1)
+        {
+          r2 = run->End;
+          continue;
+        }
+        if (r1 <= r2)
+        {
+          this->Stencil->InsertNextExtent(r1, r2, yIdx, zIdx);
+        }
+        r1 = run->Begin;
+        r2 = run->End;
+      }
+      if (r1 <= r2)
+      {
+        this->Stencil->InsertNextExtent(r1, r2, yIdx, zIdx);
+      }
+    }
+  }
+};
+
+// Count the voxels and compute the extent of each label.
+struct vtkLabelStatisticsFunctor
+{
+  const vtkLabelInternals* Internals;
+  vtkSMPThreadLocal<vtkLabelStatisticsMap> LocalStatistics;
+  vtkLabelStatisticsMap Statistics;
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkLabelStatisticsMap& statistics = this->LocalStatistics.Local();
+    for (vtkIdType row = begin; row < end; row++)
+    {
+      int yIdx, zIdx;
+      this->Internals->GetRowIndices(row, yIdx, zIdx);
+      for (const vtkLabelRun* run = this->Internals->RowBegin(row);
+           run != this->Internals->RowEnd(row); ++run)
+      {
+        vtkLabelStatisticsMap::iterator iter = statistics.find(run->Label);
+        if (iter == statistics.end())
+        {
+          vtkLabelStatistics s = { 0, { run->Begin, run->End, yIdx, yIdx, zIdx, zIdx } };
+          iter = statistics.insert(std::make_pair(run->Label, s)).first;
+        }
+        vtkLabelStatistics& s = iter->second;
+        s.NumberOfVoxels += run->End - run->Begin + 1;
+        s.Extent[0] = std::min(s.Extent[0], run->Begin);
+        s.Extent[1] = std::max(s.Extent[1], run->End);
+        s.Extent[2] = std::min(s.Extent[2], yIdx);
+        s.Extent[3] = std::max(s.Extent[3], yIdx);
+        s.Extent[4] = std::min(s.Extent[4], zIdx);
+        s.Extent[5] = std::max(s.Extent[5], zIdx);
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->Statistics.clear();
+    for (vtkSMPThreadLocal<vtkLabelStatisticsMap>::iterator local =
+           this->LocalStatistics.begin();
+         local != this->LocalStatistics.end(); ++local)
+    {
+      for (const auto& item : *local)
+      {
+        vtkLabelStatisticsMap::iterator iter = this->Statistics.find(item.first);
+        if (iter == this->Statistics.end())
+        {
+          this->Statistics.insert(item);
+          continue;
+        }
+        vtkLabelStatistics& s = iter->second;
+        s.NumberOfVoxels += item.second.NumberOfVoxels;
+        for (int i = 0; i < 6; i += 2)
+        {
+          s.Extent[i] = std::min(s.Extent[i], item.second.Extent[i]);
+          s.Extent[i + 1] = std::max(s.Extent[i + 1], item.second.Extent[i + 1]);
+        }
+      }
+    }
+  }
+};
+
+// Set a stencil to the voxels whose labels are within [low, high].
+void vtkLabelFillStencil(const vtkLabelInternals* internals, const double spacing[3],
+  const double origin[3], int low, int high, vtkImageStencilData* stencil)
+{
+  stencil->SetExtent(const_cast<int*>(internals->Extent));
+  stencil->SetSpacing(const_cast<double*>(spacing));
+  stencil->SetOrigin(const_cast<double*>(origin));
+  stencil->AllocateExtents();
+
+  vtkLabelStencilFunctor inserter = { internals, stencil, { low, high } };
+  vtkSMPTools::For(0, internals->GetNumberOfRows(), inserter);
+  stencil->Modified();
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkImageLabelStencilData::vtkImageLabelStencilData()
+{
+  this->Internals = new vtkImageLabelStencilDataInternals;
+  for (int i = 0; i < 3; i++)
+  {
+    this->Spacing[i] = 1.0;
+    this->Origin[i] = 0.0;
+  }
+  this->StencilLabelRange[0] = VTK_INT_MIN;
+  this->StencilLabelRange[1] = VTK_INT_MAX;
+}
+
+//----------------------------------------------------------------------------
+vtkImageLabelStencilData::~vtkImageLabelStencilData()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::Initialize()
+{
+  this->Superclass::Initialize();
+  const int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  this->Internals->Clear(emptyExtent);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::DeepCopy(vtkDataObject* o)
+{
+  vtkImageLabelStencilData* labels = vtkImageLabelStencilData::SafeDownCast(o);
+
+  this->Superclass::DeepCopy(o);
+  if (labels)
+  {
+    std::copy(labels->Internals->Extent, labels->Internals->Extent + 6, this->Internals->Extent);
+    this->Internals->RowStarts = labels->Internals->RowStarts;
+    this->Internals->Runs = labels->Internals->Runs;
+    this->Internals->LabelTime.Modified();
+    std::copy(labels->Spacing, labels->Spacing + 3, this->Spacing);
+    std::copy(labels->Origin, labels->Origin + 3, this->Origin);
+    this->StencilLabelRange[0] = labels->StencilLabelRange[0];
+    this->StencilLabelRange[1] = labels->StencilLabelRange[1];
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::ShallowCopy(vtkDataObject* o)
+{
+  // the runs are not reference counted, so they are always copied
+  this->DeepCopy(o);
+}
+
+//----------------------------------------------------------------------------
+int* vtkImageLabelStencilData::GetExtent()
+{
+  return this->Internals->Extent;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::GetExtent(int extent[6])
+{
+  std::copy(this->Internals->Extent, this->Internals->Extent + 6, extent);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::ImportImage(vtkImageData* image)
+{
+  int extent[6];
+  image->GetExtent(extent);
+  this->SetSpacing(image->GetSpacing());
+  this->SetOrigin(image->GetOrigin());
+  this->Internals->Clear(extent);
+
+  vtkIdType numberOfRows = this->Internals->GetNumberOfRows();
+  vtkLabelRows rows(numberOfRows);
+  if (numberOfRows > 0 && image->GetPointData()->GetScalars())
+  {
+    void* inPtr = image->GetScalarPointer();
+    vtkIdType increments[3];
+    image->GetIncrements(increments);
+    switch (image->GetScalarType())
+    {
+      vtkTemplateMacro(
+        vtkLabelImport(static_cast<const VTK_TT*>(inPtr), increments, this->Internals, &rows));
+      default:
+        vtkErrorMacro("ImportImage: Unknown ScalarType");
+        break;
+    }
+  }
+  this->Internals->SetRows(rows);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::ExportImage(vtkImageData* image, int scalarType)
+{
+  const int* extent = this->Internals->Extent;
+  image->SetExtent(this->Internals->Extent);
+  image->SetSpacing(this->Spacing);
+  image->SetOrigin(this->Origin);
+  image->AllocateScalars(scalarType, 1);
+
+  vtkIdType numberOfRows = this->Internals->GetNumberOfRows();
+  if (numberOfRows == 0)
+  {
+    return;
+  }
+
+  void* outPtr = image->GetScalarPointer();
+  vtkIdType xSize = extent[1] - extent[0] + 1;
+  memset(outPtr, 0, numberOfRows * xSize * image->GetScalarSize());
+  switch (scalarType)
+  {
+    vtkTemplateMacro(vtkLabelExport(static_cast<VTK_TT*>(outPtr), this->Internals));
+    default:
+      vtkErrorMacro("ExportImage: Unknown ScalarType");
+      break;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::ImportStencil(vtkImageStencilData* stencil, int label)
+{
+  if (this->Internals->GetNumberOfRows() == 0)
+  {
+    this->Internals->Clear(stencil->GetExtent());
+    this->SetSpacing(stencil->GetSpacing());
+    this->SetOrigin(stencil->GetOrigin());
+  }
+
+  vtkIdType numberOfRows = this->Internals->GetNumberOfRows();
+  vtkLabelRows rows(numberOfRows);
+  vtkLabelCombineFunctor painter = { this->Internals, nullptr, stencil, LabelPaint, label, &rows };
+  vtkSMPTools::For(0, numberOfRows, painter);
+  this->Internals->SetRows(rows);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::ExportStencil(vtkImageStencilData* stencil, int label)
+{
+  vtkLabelFillStencil(this->Internals, this->Spacing, this->Origin, label, label, stencil);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::Union(vtkImageLabelStencilData* other)
+{
+  vtkIdType numberOfRows = this->Internals->GetNumberOfRows();
+  vtkLabelRows rows(numberOfRows);
+  vtkLabelCombineFunctor combiner = { this->Internals, other->Internals, nullptr, LabelUnion, 0,
+    &rows };
+  vtkSMPTools::For(0, numberOfRows, combiner);
+  this->Internals->SetRows(rows);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::Intersection(vtkImageLabelStencilData* other)
+{
+  vtkIdType numberOfRows = this->Internals->GetNumberOfRows();
+  vtkLabelRows rows(numberOfRows);
+  vtkLabelCombineFunctor combiner = { this->Internals, other->Internals, nullptr,
+    LabelIntersection, 0, &rows };
+  vtkSMPTools::For(0, numberOfRows, combiner);
+  this->Internals->SetRows(rows);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::Difference(vtkImageLabelStencilData* other)
+{
+  vtkIdType numberOfRows = this->Internals->GetNumberOfRows();
+  vtkLabelRows rows(numberOfRows);
+  vtkLabelCombineFunctor combiner = { this->Internals, other->Internals, nullptr,
+    LabelDifference, 0, &rows };
+  vtkSMPTools::For(0, numberOfRows, combiner);
+  this->Internals->SetRows(rows);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkImageLabelStencilData::GetVoxelLabel(int xIdx, int yIdx, int zIdx)
+{
+  vtkIdType row = this->Internals->GetRow(yIdx, zIdx);
+  if (row < 0)
+  {
+    return 0;
+  }
+
+  // find the first run that ends at or after xIdx
+  const vtkLabelRun* runEnd = this->Internals->RowEnd(row);
+  const vtkLabelRun* run = std::lower_bound(this->Internals->RowBegin(row), runEnd, xIdx,
+    [](const vtkLabelRun& r, int x) { return r.End < x; });
+  if (run != runEnd && run->Begin <= xIdx)
+  {
+    return run->Label;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::UpdateLabelStatistics()
+{
+  if (this->Internals->StatisticsTime > this->Internals->LabelTime)
+  {
+    return;
+  }
+
+  vtkLabelStatisticsFunctor counter;
+  counter.Internals = this->Internals;
+  vtkSMPTools::For(0, this->Internals->GetNumberOfRows(), counter);
+  this->Internals->Statistics.swap(counter.Statistics);
+
+  this->Internals->Labels.clear();
+  for (const auto& item : this->Internals->Statistics)
+  {
+    this->Internals->Labels.push_back(item.first);
+  }
+  this->Internals->StatisticsTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkImageLabelStencilData::GetNumberOfLabels()
+{
+  this->UpdateLabelStatistics();
+  return static_cast<int>(this->Internals->Labels.size());
+}
+
+//----------------------------------------------------------------------------
+int vtkImageLabelStencilData::GetLabelValue(int i)
+{
+  this->UpdateLabelStatistics();
+  if (i < 0 || i >= static_cast<int>(this->Internals->Labels.size()))
+  {
+    vtkErrorMacro("GetLabelValue: Index " << i << " is out of range.");
+    return 0;
+  }
+  return this->Internals->Labels[i];
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkImageLabelStencilData::GetNumberOfLabelVoxels(int label)
+{
+  this->UpdateLabelStatistics();
+  vtkLabelStatisticsMap::iterator iter = this->Internals->Statistics.find(label);
+  return (iter == this->Internals->Statistics.end() ? 0 : iter->second.NumberOfVoxels);
+}
+
+//----------------------------------------------------------------------------
+double vtkImageLabelStencilData::GetLabelVolume(int label)
+{
+  return this->GetNumberOfLabelVoxels(label) *
+    std::fabs(this->Spacing[0] * this->Spacing[1] * this->Spacing[2]);
+}
+
+//----------------------------------------------------------------------------
+int vtkImageLabelStencilData::GetLabelExtent(int label, int extent[6])
+{
+  this->UpdateLabelStatistics();
+  vtkLabelStatisticsMap::iterator iter = this->Internals->Statistics.find(label);
+  if (iter == this->Internals->Statistics.end())
+  {
+    const int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    std::copy(emptyExtent, emptyExtent + 6, extent);
+    return 0;
+  }
+  std::copy(iter->second.Extent, iter->second.Extent + 6, extent);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageLabelStencilData::GetLabelBounds(int label, double bounds[6])
+{
+  int extent[6];
+  if (!this->GetLabelExtent(label, extent))
+  {
+    return 0;
+  }
+  for (int i = 0; i < 3; i++)
+  {
+    double b1 = this->Origin[i] + extent[2 * i] * this->Spacing[i];
+    double b2 = this->Origin[i] + extent[2 * i + 1] * this->Spacing[i];
+    bounds[2 * i] = std::min(b1, b2);
+    bounds[2 * i + 1] = std::max(b1, b2);
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkImageLabelStencilData::GetNumberOfRuns()
+{
+  return static_cast<vtkIdType>(this->Internals->Runs.size());
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkImageLabelStencilData::GetActualMemorySize()
+{
+  size_t size = this->Internals->Runs.size() * sizeof(vtkLabelRun) +
+    this->Internals->RowStarts.size() * sizeof(vtkIdType);
+
+  unsigned long stencilSize = 0;
+  if (this->Internals->Stencil)
+  {
+    stencilSize = this->Internals->Stencil->GetActualMemorySize();
+  }
+
+  return this->Superclass::GetActualMemorySize() + static_cast<unsigned long>(size / 1024) +
+    stencilSize;
+}
+
+//----------------------------------------------------------------------------
+vtkImageStencilData* vtkImageLabelStencilData::GetStencil()
+{
+  if (!this->Internals->Stencil)
+  {
+    this->Internals->Stencil = vtkSmartPointer<vtkImageStencilData>::New();
+  }
+  else if (this->Internals->StencilTime > this->GetMTime())
+  {
+    return this->Internals->Stencil;
+  }
+
+  vtkLabelFillStencil(this->Internals, this->Spacing, this->Origin,
+    this->StencilLabelRange[0], this->StencilLabelRange[1], this->Internals->Stencil);
+  this->Internals->StencilTime.Modified();
+  return this->Internals->Stencil;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageLabelStencilData::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  const int* extent = this->Internals->Extent;
+  os << indent << "Extent: (" << extent[0] << ", " << extent[1] << ", " << extent[2] << ", "
+     << extent[3] << ", " << extent[4] << ", " << extent[5] << ")\n";
+  os << indent << "Spacing: (" << this->Spacing[0] << ", " << this->Spacing[1] << ", "
+     << this->Spacing[2] << ")\n";
+  os << indent << "Origin: (" << this->Origin[0] << ", " << this->Origin[1] << ", "
+     << this->Origin[2] << ")\n";
+  os << indent << "StencilLabelRange: (" << this->StencilLabelRange[0] << ", "
+     << this->StencilLabelRange[1] << ")\n";
+  os << indent << "NumberOfRuns: " << this->GetNumberOfRuns() << "\n";
+}
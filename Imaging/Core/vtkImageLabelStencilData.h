@@ -0,0 +1,223 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageLabelStencilData.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageLabelStencilData
+ * @brief   run-length encoded label map that can be used as a stencil
+ *
+ * vtkImageLabelStencilData stores a label map, such as a segmentation with
+ * many structures, as runs of voxels with the same label along each x row
+ * of the image, in the same way that vtkImageStencilData stores its
+ * extents. Label zero is the background and is not stored, so the size of
+ * the label map depends on the number of boundaries between structures
+ * rather than on the number of voxels, and is usually orders of magnitude
+ * smaller than that of the equivalent vtkImageData.
+ *
+ * The label map can be converted to and from an image, and each label can
+ * be converted to and from a vtkImageStencilData. The union, intersection
+ * and difference of two label maps are computed directly from the runs,
+ * and the rows are processed in parallel. The number of voxels and the
+ * extent of each label are computed on demand.
+ *
+ * To restrict vtkImageStencil, vtkImageAccumulate or any other filter that
+ * takes a stencil to some of the labels, give it the stencil returned by
+ * GetStencil(), which selects the voxels whose labels are within the
+ * StencilLabelRange, or a stencil filled by ExportStencil().
+ * @sa
+ * vtkImageStencilData vtkImageStencil vtkImageAccumulate
+ */
+
+#ifndef vtkImageLabelStencilData_h
+#define vtkImageLabelStencilData_h
+
+#include "vtkDataObject.h"
+#include "vtkImagingCoreModule.h" // For export macro
+
+class vtkImageData;
+class vtkImageStencilData;
+class vtkImageLabelStencilDataInternals;
+
+class VTKIMAGINGCORE_EXPORT vtkImageLabelStencilData : public vtkDataObject
+{
+public:
+  static vtkImageLabelStencilData* New();
+  vtkTypeMacro(vtkImageLabelStencilData, vtkDataObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Remove all the labels, and set the extent to an empty extent.
+   */
+  void Initialize() override;
+
+  /**
+   * The extent is given as a 3D extent, like that of vtkImageStencilData.
+   */
+  int GetExtentType() override { return VTK_3D_EXTENT; }
+
+  //@{
+  /**
+   * Copy the labels from another label map.
+   */
+  void DeepCopy(vtkDataObject* o) override;
+  void ShallowCopy(vtkDataObject* o) override;
+  //@}
+
+  //@{
+  /**
+   * Get the extent of the label map, which is set by ImportImage() or by
+   * the first ImportStencil().
+   */
+  int* GetExtent() VTK_SIZEHINT(6);
+  void GetExtent(int extent[6]);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the spacing and origin of the voxels.
+   */
+  vtkSetVector3Macro(Spacing, double);
+  vtkGetVector3Macro(Spacing, double);
+  vtkSetVector3Macro(Origin, double);
+  vtkGetVector3Macro(Origin, double);
+  //@}
+
+  /**
+   * Set the labels from the first component of the scalars of an image,
+   * whose extent, spacing and origin are also copied. The values are cast
+   * to int, and voxels with a value of zero are not labeled.
+   */
+  void ImportImage(vtkImageData* image);
+
+  /**
+   * Write the labels into an image of the given scalar type, which is
+   * allocated with the extent, spacing and origin of the label map.
+   * The voxels that are not labeled are set to zero.
+   */
+  void ExportImage(vtkImageData* image, int scalarType);
+
+  /**
+   * Give the label to all the voxels that are inside the stencil and
+   * within the extent of the label map, replacing their previous labels.
+   * A label of zero removes the labels of these voxels. If the label map
+   * is empty, the extent, spacing and origin are first copied from the
+   * stencil.
+   */
+  void ImportStencil(vtkImageStencilData* stencil, int label);
+
+  /**
+   * Set the stencil to the voxels that have the given label. The extent,
+   * spacing and origin of the stencil are set to those of the label map.
+   */
+  void ExportStencil(vtkImageStencilData* stencil, int label);
+
+  //@{
+  /**
+   * Combine the labels with those of another label map, within the extent
+   * of this label map. Union() labels the voxels that are only labeled in
+   * the other map with their label from the other map. Intersection()
+   * removes the labels of the voxels that are not labeled in the other
+   * map, and Difference() removes the labels of the voxels that are. The
+   * labels of the other map are otherwise ignored, so the voxels that are
+   * labeled in both maps keep their labels from this map.
+   */
+  void Union(vtkImageLabelStencilData* other);
+  void Intersection(vtkImageLabelStencilData* other);
+  void Difference(vtkImageLabelStencilData* other);
+  //@}
+
+  /**
+   * Get the label of a voxel, or zero if the voxel is not labeled.
+   */
+  int GetVoxelLabel(int xIdx, int yIdx, int zIdx);
+
+  //@{
+  /**
+   * Get the labels that are present, in increasing order.
+   */
+  int GetNumberOfLabels();
+  int GetLabelValue(int i);
+  //@}
+
+  /**
+   * Get the number of voxels that have the given label.
+   */
+  vtkIdType GetNumberOfLabelVoxels(int label);
+
+  /**
+   * Get the volume of the voxels that have the given label, in world units.
+   */
+  double GetLabelVolume(int label);
+
+  /**
+   * Get the extent of the voxels that have the given label. Returns zero
+   * and an empty extent if there are no such voxels.
+   */
+  int GetLabelExtent(int label, int extent[6]);
+
+  /**
+   * Get the bounds of the centers of the voxels that have the given label,
+   * in world coordinates. Returns zero if there are no such voxels.
+   */
+  int GetLabelBounds(int label, double bounds[6]);
+
+  /**
+   * Get the number of runs of labeled voxels.
+   */
+  vtkIdType GetNumberOfRuns();
+
+  /**
+   * Return the memory used by the runs and by the stencil returned by
+   * GetStencil(), in kibibytes.
+   */
+  unsigned long GetActualMemorySize() override;
+
+  /**
+   * Get a stencil of the voxels whose labels are within the
+   * StencilLabelRange. The stencil is owned by the label map, and is
+   * updated by each call if the labels, the range, the spacing or the
+   * origin have changed since the previous one.
+   */
+  vtkImageStencilData* GetStencil();
+
+  //@{
+  /**
+   * Set/Get the range of labels that are selected by GetStencil(). The
+   * default range includes all the labels.
+   */
+  vtkSetVector2Macro(StencilLabelRange, int);
+  void SetStencilLabel(int label) { this->SetStencilLabelRange(label, label); }
+  vtkGetVector2Macro(StencilLabelRange, int);
+  //@}
+
+protected:
+  vtkImageLabelStencilData();
+  ~vtkImageLabelStencilData() override;
+
+  /**
+   * Update the number of voxels and the extent of each label.
+   */
+  void UpdateLabelStatistics();
+
+  double Spacing[3];
+  double Origin[3];
+  int StencilLabelRange[2];
+
+private:
+  vtkImageLabelStencilData(const vtkImageLabelStencilData&) = delete;
+  void operator=(const vtkImageLabelStencilData&) = delete;
+
+  vtkImageLabelStencilDataInternals* Internals;
+};
+
+#endif
@@ -23,6 +23,10 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkScalarsToColors.h"
 #include "vtkPointData.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageMapToColors);
 vtkCxxSetObjectMacro(vtkImageMapToColors,LookupTable,vtkScalarsToColors);
@@ -36,6 +40,8 @@ vtkImageMapToColors::vtkImageMapToColors()
   this->PassAlphaToOutput = 0;
   this->LookupTable = nullptr;
   this->DataWasPassed = 0;
+  this->ColorTable = vtkUnsignedCharArray::New();
+  this->ColorTableScalarType = VTK_VOID;
 
   // Black color
   this->NaNColor[0] = this->NaNColor[1] = this->NaNColor[2] = this->NaNColor[3] = 0;
@@ -53,6 +59,7 @@ vtkImageMapToColors::~vtkImageMapToColors()
   {
     this->LookupTable->UnRegister(this);
   }
+  this->ColorTable->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -72,6 +79,207 @@ vtkMTimeType vtkImageMapToColors::GetMTime()
   return t1;
 }
 
+//----------------------------------------------------------------------------
+namespace {
+
+// The number of pixels in an extent.
+vtkIdType vtkImageMapToColorsNumberOfPixels(const int extent[6])
+{
+  vtkIdType n = 1;
+  for (int i = 0; i < 3; i++)
+  {
+    n *= (extent[2*i] <= extent[2*i + 1] ? extent[2*i + 1] - extent[2*i] + 1 : 0);
+  }
+  return n;
+}
+
+// The number of colors in the color table for the given scalar type, or
+// zero if the type has more than 16 bits.
+int vtkImageMapToColorsTableSize(int scalarType)
+{
+  switch (scalarType)
+  {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+      return 256;
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+      return 65536;
+  }
+  return 0;
+}
+
+// Fill the array with all the values of the type, from the lowest.
+template <class T>
+void vtkImageMapToColorsFillValues(T *values)
+{
+  int low = std::numeric_limits<T>::min();
+  int high = std::numeric_limits<T>::max();
+  for (int v = low; v <= high; v++)
+  {
+    *values++ = static_cast<T>(v);
+  }
+}
+
+// Copy the colors of a row of values from the table. The number of
+// components is a template parameter, so that each color is copied
+// with a single move.
+template <class T, int N>
+void vtkImageMapToColorsCopyColors(const T *in, unsigned char *out,
+                                   const unsigned char *table,
+                                   int count, int inIncrement)
+{
+  const int low = std::numeric_limits<T>::min();
+  for (int i = 0; i < count; i++)
+  {
+    const unsigned char *color = table + N*(static_cast<int>(*in) - low);
+    for (int j = 0; j < N; j++)
+    {
+      out[j] = color[j];
+    }
+    in += inIncrement;
+    out += N;
+  }
+}
+
+template <class T>
+void vtkImageMapToColorsCopyColors(const T *in, unsigned char *out,
+                                   const unsigned char *table,
+                                   int count, int inIncrement,
+                                   int numberOfOutputComponents)
+{
+  switch (numberOfOutputComponents)
+  {
+    case 1:
+      vtkImageMapToColorsCopyColors<T, 1>(in, out, table, count, inIncrement);
+      break;
+    case 2:
+      vtkImageMapToColorsCopyColors<T, 2>(in, out, table, count, inIncrement);
+      break;
+    case 3:
+      vtkImageMapToColorsCopyColors<T, 3>(in, out, table, count, inIncrement);
+      break;
+    case 4:
+      vtkImageMapToColorsCopyColors<T, 4>(in, out, table, count, inIncrement);
+      break;
+  }
+}
+
+void vtkImageMapToColorsCopyColors(void *in, unsigned char *out,
+                                   vtkUnsignedCharArray *table,
+                                   int scalarType, int count,
+                                   int inIncrement)
+{
+  const unsigned char *colors = table->GetPointer(0);
+  int n = table->GetNumberOfComponents();
+  switch (scalarType)
+  {
+    case VTK_CHAR:
+      vtkImageMapToColorsCopyColors(
+        static_cast<char *>(in), out, colors, count, inIncrement, n);
+      break;
+    case VTK_SIGNED_CHAR:
+      vtkImageMapToColorsCopyColors(
+        static_cast<signed char *>(in), out, colors, count, inIncrement, n);
+      break;
+    case VTK_UNSIGNED_CHAR:
+      vtkImageMapToColorsCopyColors(
+        static_cast<unsigned char *>(in), out, colors, count, inIncrement, n);
+      break;
+    case VTK_SHORT:
+      vtkImageMapToColorsCopyColors(
+        static_cast<short *>(in), out, colors, count, inIncrement, n);
+      break;
+    case VTK_UNSIGNED_SHORT:
+      vtkImageMapToColorsCopyColors(
+        static_cast<unsigned short *>(in), out, colors, count, inIncrement, n);
+      break;
+  }
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+bool vtkImageMapToColors::UpdateColorTable(int scalarType,
+                                           vtkIdType numberOfPixels)
+{
+  // the colors must only depend on the values, which is not the case for
+  // lookup tables that can disable individual values
+  int tableSize = vtkImageMapToColorsTableSize(scalarType);
+  if (tableSize == 0 ||
+      this->OutputFormat < VTK_LUMINANCE || this->OutputFormat > VTK_RGBA ||
+      (this->LookupTable &&
+       this->LookupTable->IsA("vtkLookupTableWithEnabling")))
+  {
+    this->ColorTableScalarType = VTK_VOID;
+    return false;
+  }
+
+  if (this->ColorTableScalarType == scalarType &&
+      this->ColorTable->GetNumberOfComponents() == this->OutputFormat &&
+      this->ColorTableTime > this->GetMTime())
+  {
+    return true;
+  }
+
+  // only compute the table if it costs less than mapping the pixels
+  if (numberOfPixels < tableSize)
+  {
+    this->ColorTableScalarType = VTK_VOID;
+    return false;
+  }
+
+  // 16 bits are enough for the values of any of the table types
+  std::vector<short> values(tableSize);
+  void *valuePtr = values.data();
+  switch (scalarType)
+  {
+    case VTK_CHAR:
+      vtkImageMapToColorsFillValues(static_cast<char *>(valuePtr));
+      break;
+    case VTK_SIGNED_CHAR:
+      vtkImageMapToColorsFillValues(static_cast<signed char *>(valuePtr));
+      break;
+    case VTK_UNSIGNED_CHAR:
+      vtkImageMapToColorsFillValues(static_cast<unsigned char *>(valuePtr));
+      break;
+    case VTK_SHORT:
+      vtkImageMapToColorsFillValues(static_cast<short *>(valuePtr));
+      break;
+    case VTK_UNSIGNED_SHORT:
+      vtkImageMapToColorsFillValues(static_cast<unsigned short *>(valuePtr));
+      break;
+  }
+
+  this->ColorTable->SetNumberOfComponents(this->OutputFormat);
+  this->ColorTable->SetNumberOfTuples(tableSize);
+  this->MapValuesToColors(valuePtr, this->ColorTable->GetPointer(0),
+                          scalarType, tableSize);
+  this->ColorTableScalarType = scalarType;
+  this->ColorTableTime.Modified();
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageMapToColors::MapValuesToColors(void *input, unsigned char *output,
+                                            int scalarType, int count)
+{
+  this->LookupTable->MapScalarsThroughTable2(input, output, scalarType,
+                                             count, 1, this->OutputFormat);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageMapToColors::MapThroughColorTable(void *input,
+                                               unsigned char *output,
+                                               int scalarType, int count,
+                                               int inputIncrement)
+{
+  vtkImageMapToColorsCopyColors(input, output, this->ColorTable,
+                                scalarType, count, inputIncrement);
+}
+
 //----------------------------------------------------------------------------
 // This method checks to see if we can simply reference the input data
 int vtkImageMapToColors::RequestData(vtkInformation *request,
@@ -106,6 +314,11 @@ int vtkImageMapToColors::RequestData(vtkInformation *request,
       this->DataWasPassed = 0;
     }
 
+    vtkDataArray *inArray = this->GetInputArrayToProcess(0, inputVector);
+    int *outExt = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+    this->UpdateColorTable(inArray ? inArray->GetDataType() : VTK_VOID,
+      vtkImageMapToColorsNumberOfPixels(outExt));
+
     return this->Superclass::RequestData(request, inputVector, outputVector);
   }
 
@@ -182,7 +395,8 @@ static void vtkImageMapToColorsExecute(vtkImageMapToColors *self,
                                        vtkImageData *outData,
                                        vtkDataArray *outArray,
                                        int outExt[6], int id,
-                                       unsigned char* nanColor)
+                                       unsigned char* nanColor,
+                                       vtkUnsignedCharArray *colorTable)
 {
   int idxY, idxZ;
   int extX, extY, extZ;
@@ -245,9 +459,17 @@ static void vtkImageMapToColorsExecute(vtkImageMapToColors *self,
         }
         count++;
       }
-      lookupTable->MapScalarsThroughTable2(inPtr1,outPtr1,
-                                           dataType,extX,numberOfComponents,
-                                           outputFormat);
+      if (colorTable)
+      {
+        vtkImageMapToColorsCopyColors(inPtr1,outPtr1,colorTable,
+                                      dataType,extX,numberOfComponents);
+      }
+      else
+      {
+        lookupTable->MapScalarsThroughTable2(inPtr1,outPtr1,
+                                             dataType,extX,numberOfComponents,
+                                             outputFormat);
+      }
       // Handle NaN color when mask
       if(inMask != nullptr)
       {
@@ -318,10 +540,17 @@ void vtkImageMapToColors::ThreadedRequestData(
   vtkCharArray *maskArray = vtkArrayDownCast<vtkCharArray>(inData[0][0]->GetPointData()->GetArray("vtkValidPointMask"));
   vtkDataArray* inArray = this->GetInputArrayToProcess(0, inputVector);
 
+  // Use the color table if RequestData() computed it for this input
+  vtkUnsignedCharArray *colorTable = nullptr;
+  if (this->ColorTableScalarType == inArray->GetDataType())
+  {
+    colorTable = this->ColorTable;
+  }
+
   // Working method
   vtkImageMapToColorsExecute(this, inData[0][0], inArray, maskArray,
                              outData[0], outArray,
-                             outExt, id, this->NaNColor);
+                             outExt, id, this->NaNColor, colorTable);
 }
 
 //----------------------------------------------------------------------------
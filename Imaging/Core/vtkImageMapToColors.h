@@ -22,6 +22,12 @@
  * If the lookup table is not set, or is set to nullptr, then the input
  * data will be passed through if it is already of type VTK_UNSIGNED_CHAR.
  *
+ * For 8-bit and 16-bit integer input, the colors of all the possible input
+ * values are computed once, and each pixel is then mapped by copying its
+ * color from this table. The table is kept until the filter or the lookup
+ * table are modified, so that mapping successive slices with the same
+ * lookup table only costs the copies.
+ *
  * @sa
  * vtkLookupTable vtkScalarsToColors
 */
@@ -32,8 +38,10 @@
 
 #include "vtkImagingCoreModule.h" // For export macro
 #include "vtkThreadedImageAlgorithm.h"
+#include "vtkTimeStamp.h" // For ColorTableTime
 
 class vtkScalarsToColors;
+class vtkUnsignedCharArray;
 
 class VTKIMAGINGCORE_EXPORT vtkImageMapToColors : public vtkThreadedImageAlgorithm
 {
@@ -112,6 +120,27 @@ protected:
                           vtkInformationVector **inputVector,
                           vtkInformationVector *outputVector) override;
 
+  /**
+   * Build the color table for input of the given scalar type, if the type
+   * has 8 or 16 bits and if there are enough pixels to map for the table
+   * to pay off, or check that it is up to date. Returns true if the pixels
+   * can be mapped with MapThroughColorTable().
+   */
+  bool UpdateColorTable(int scalarType, vtkIdType numberOfPixels);
+
+  /**
+   * Map the given values to colors in the output format, as the pixels
+   * are mapped. This is used to compute the color table.
+   */
+  virtual void MapValuesToColors(void *input, unsigned char *output,
+                                 int scalarType, int count);
+
+  /**
+   * Map a row of pixels by copying their colors from the color table.
+   */
+  void MapThroughColorTable(void *input, unsigned char *output,
+                            int scalarType, int count, int inputIncrement);
+
   vtkScalarsToColors *LookupTable;
   int OutputFormat;
 
@@ -121,6 +150,11 @@ protected:
   int DataWasPassed;
 
   unsigned char NaNColor[4];
+
+  vtkUnsignedCharArray *ColorTable;
+  int ColorTableScalarType;
+  vtkTimeStamp ColorTableTime;
+
 private:
   vtkImageMapToColors(const vtkImageMapToColors&) = delete;
   void operator=(const vtkImageMapToColors&) = delete;
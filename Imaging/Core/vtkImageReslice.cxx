@@ -1948,6 +1948,9 @@ void vtkImageResliceExecute(vtkImageReslice *self,
     optimizeNearest = 1;
   }
 
+  // can the samples of each row be interpolated together?
+  bool interpolateLines = (nsamples <= 1 && !(newtrans || perspective));
+
   // get pixel information
   int scalarType = outData->GetScalarType();
   int scalarSize = outData->GetScalarSize();
@@ -2104,7 +2107,10 @@ void vtkImageResliceExecute(vtkImageReslice *self,
                 // do the interpolation
                 sampleCount++;
                 isInBounds = 1;
-                interpolator->InterpolateIJK(inPoint, tmpPtr);
+                if (!interpolateLines)
+                {
+                  interpolator->InterpolateIJK(inPoint, tmpPtr);
+                }
                 tmpPtr += inComponents;
               }
             }
@@ -2126,6 +2132,12 @@ void vtkImageResliceExecute(vtkImageReslice *self,
 
           if (wasInBounds)
           {
+            if (interpolateLines)
+            {
+              interpolator->InterpolateLineIJK(inPoint1, xAxis, startIdX,
+                numpixels, tmpPtr - inComponents*(idX - startIdX));
+            }
+
             if (outputStencil)
             {
               outputStencil->InsertNextExtent(startIdX, endIdX, idY, idZ);
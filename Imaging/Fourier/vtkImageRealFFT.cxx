@@ -0,0 +1,537 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageRealFFT.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageRealFFT.h"
+
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include "vtkkissfft_fft.h"
+#include "tools/vtkkissfft_fftr.h"
+
+#include <algorithm>
+#include <vector>
+
+vtkStandardNewMacro(vtkImageRealFFT);
+
+namespace
+{
+
+// The number of neighboring lines along Y or Z that are transformed
+// together, so that each gather and scatter moves whole cache lines.
+const int vtkImageRealFFTBlockSize = 16;
+
+// The buffers of one thread for the transforms along X.
+struct vtkImageRealFFTRow
+{
+  kiss_fftr_cfg RealConfig;
+  std::vector<kiss_fft_scalar> Real;
+  std::vector<kiss_fft_cpx> Complex;
+  std::vector<kiss_fft_cpx> Spectrum;
+
+  vtkImageRealFFTRow()
+    : RealConfig(nullptr)
+  {
+  }
+};
+
+// Allocates the buffers of a row of n real samples. Even sizes use the
+// real transform of kissfft, which is about twice as fast as the complex
+// transform, odd sizes fall back to the complex transform.
+void vtkImageRealFFTAllocateRow(vtkImageRealFFTRow& row, int n, bool inverse)
+{
+  row.Real.resize(n);
+  if (n % 2 == 0)
+  {
+    row.RealConfig = kiss_fftr_alloc(n, inverse, nullptr, nullptr);
+  }
+  else
+  {
+    row.Complex.resize(n);
+    row.Spectrum.resize(n);
+  }
+}
+
+void vtkImageRealFFTFreeRows(vtkSMPThreadLocal<vtkImageRealFFTRow>& rows)
+{
+  for (vtkSMPThreadLocal<vtkImageRealFFTRow>::iterator it = rows.begin(); it != rows.end(); ++it)
+  {
+    if (it->RealConfig)
+    {
+      kiss_fftr_free(it->RealConfig);
+      it->RealConfig = nullptr;
+    }
+  }
+}
+
+// Transforms the rows along X of the first component of the input into
+// the half spectra of the complex volume. The configuration of the real
+// transform holds a scratch buffer, so each thread needs its own.
+template <class T>
+struct vtkImageRealFFTForwardRows
+{
+  const T* Input;
+  vtkIdType InIncrements[3];
+  kiss_fft_cpx* Output;
+  int N;
+  int M;
+  int NY;
+  kiss_fft_cfg ComplexConfig;
+  vtkSMPThreadLocal<vtkImageRealFFTRow> Rows;
+
+  void Initialize() { vtkImageRealFFTAllocateRow(this->Rows.Local(), this->N, false); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkImageRealFFTRow& row = this->Rows.Local();
+    for (vtkIdType r = begin; r < end; ++r)
+    {
+      const T* in = this->Input + (r % this->NY) * this->InIncrements[1] +
+        (r / this->NY) * this->InIncrements[2];
+      kiss_fft_cpx* out = this->Output + r * this->M;
+      if (row.RealConfig)
+      {
+        for (int i = 0; i < this->N; ++i)
+        {
+          row.Real[i] = static_cast<kiss_fft_scalar>(in[i * this->InIncrements[0]]);
+        }
+        kiss_fftr(row.RealConfig, row.Real.data(), out);
+      }
+      else
+      {
+        for (int i = 0; i < this->N; ++i)
+        {
+          row.Complex[i].r = static_cast<kiss_fft_scalar>(in[i * this->InIncrements[0]]);
+          row.Complex[i].i = 0;
+        }
+        kiss_fft(this->ComplexConfig, row.Complex.data(), row.Spectrum.data());
+        std::copy(row.Spectrum.begin(), row.Spectrum.begin() + this->M, out);
+      }
+    }
+  }
+
+  void Reduce() { vtkImageRealFFTFreeRows(this->Rows); }
+};
+
+// Transforms the half spectra of the complex volume back into the rows of
+// the real output, and applies the normalization of the inverse transform.
+template <class T>
+struct vtkImageRealFFTInverseRows
+{
+  const kiss_fft_cpx* Input;
+  T* Output;
+  int N;
+  int M;
+  double Scale;
+  kiss_fft_cfg ComplexConfig;
+  vtkSMPThreadLocal<vtkImageRealFFTRow> Rows;
+
+  void Initialize() { vtkImageRealFFTAllocateRow(this->Rows.Local(), this->N, true); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkImageRealFFTRow& row = this->Rows.Local();
+    for (vtkIdType r = begin; r < end; ++r)
+    {
+      const kiss_fft_cpx* in = this->Input + r * this->M;
+      T* out = this->Output + r * this->N;
+      if (row.RealConfig)
+      {
+        kiss_fftri(row.RealConfig, in, row.Real.data());
+        for (int i = 0; i < this->N; ++i)
+        {
+          out[i] = static_cast<T>(row.Real[i] * this->Scale);
+        }
+      }
+      else
+      {
+        // Rebuild the negative frequencies from the Hermitian symmetry.
+        row.Spectrum[0] = in[0];
+        for (int k = 1; k < this->M; ++k)
+        {
+          row.Spectrum[k] = in[k];
+          row.Spectrum[this->N - k].r = in[k].r;
+          row.Spectrum[this->N - k].i = -in[k].i;
+        }
+        kiss_fft(this->ComplexConfig, row.Spectrum.data(), row.Complex.data());
+        for (int i = 0; i < this->N; ++i)
+        {
+          out[i] = static_cast<T>(row.Complex[i].r * this->Scale);
+        }
+      }
+    }
+  }
+
+  void Reduce() { vtkImageRealFFTFreeRows(this->Rows); }
+};
+
+// Transforms the complex volume along Y or Z. The lines along the axis are
+// taken by blocks of neighboring X positions: each block is gathered into
+// a contiguous buffer, transformed, and scattered back. The configuration
+// of the complex transform is only read by kissfft when transforming out
+// of place, so it is shared by all threads.
+struct vtkImageRealFFTAxis
+{
+  kiss_fft_cpx* Data;
+  int M;
+  int N;
+  vtkIdType Stride;
+  vtkIdType OtherStride;
+  int NumberOfBlocks;
+  kiss_fft_cfg Config;
+  vtkSMPThreadLocal<std::vector<kiss_fft_cpx> > Buffers;
+
+  void Initialize() { this->Buffers.Local().resize(2 * vtkImageRealFFTBlockSize * this->N); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<kiss_fft_cpx>& buffer = this->Buffers.Local();
+    kiss_fft_cpx* lines = buffer.data();
+    kiss_fft_cpx* spectra = lines + vtkImageRealFFTBlockSize * this->N;
+    for (vtkIdType item = begin; item < end; ++item)
+    {
+      int x = static_cast<int>(item % this->NumberOfBlocks) * vtkImageRealFFTBlockSize;
+      int width = std::min(vtkImageRealFFTBlockSize, this->M - x);
+      kiss_fft_cpx* base = this->Data + (item / this->NumberOfBlocks) * this->OtherStride + x;
+      for (int j = 0; j < this->N; ++j)
+      {
+        const kiss_fft_cpx* src = base + j * this->Stride;
+        for (int b = 0; b < width; ++b)
+        {
+          lines[b * this->N + j] = src[b];
+        }
+      }
+      for (int b = 0; b < width; ++b)
+      {
+        kiss_fft(this->Config, lines + b * this->N, spectra + b * this->N);
+      }
+      for (int j = 0; j < this->N; ++j)
+      {
+        kiss_fft_cpx* dst = base + j * this->Stride;
+        for (int b = 0; b < width; ++b)
+        {
+          dst[b] = spectra[b * this->N + j];
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Copies a half spectrum, with the imaginary values in the second component
+// if there is one, into the complex volume.
+template <class T>
+struct vtkImageRealFFTLoadSpectrum
+{
+  const T* Input;
+  vtkIdType InIncrements[3];
+  bool HasImaginary;
+  kiss_fft_cpx* Output;
+  int M;
+  int NY;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType r = begin; r < end; ++r)
+    {
+      const T* in = this->Input + (r % this->NY) * this->InIncrements[1] +
+        (r / this->NY) * this->InIncrements[2];
+      kiss_fft_cpx* out = this->Output + r * this->M;
+      for (int i = 0; i < this->M; ++i, in += this->InIncrements[0])
+      {
+        out[i].r = static_cast<kiss_fft_scalar>(in[0]);
+        out[i].i = this->HasImaginary ? static_cast<kiss_fft_scalar>(in[1]) : 0;
+      }
+    }
+  }
+};
+
+// Stores the complex volume into an output of single precision.
+struct vtkImageRealFFTStoreSpectrum
+{
+  const kiss_fft_cpx* Input;
+  float* Output;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Output[2 * i] = static_cast<float>(this->Input[i].r);
+      this->Output[2 * i + 1] = static_cast<float>(this->Input[i].i);
+    }
+  }
+};
+
+// Transforms the complex volume of m x ny x nz values along Y and Z, for
+// the axes below the dimensionality.
+void vtkImageRealFFTTransformAxes(
+  kiss_fft_cpx* data, int m, int ny, int nz, int dimensionality, bool inverse)
+{
+  vtkImageRealFFTAxis axis;
+  axis.Data = data;
+  axis.M = m;
+  axis.NumberOfBlocks = (m + vtkImageRealFFTBlockSize - 1) / vtkImageRealFFTBlockSize;
+  if (dimensionality > 1 && ny > 1)
+  {
+    axis.N = ny;
+    axis.Stride = m;
+    axis.OtherStride = static_cast<vtkIdType>(m) * ny;
+    axis.Config = kiss_fft_alloc(ny, inverse, nullptr, nullptr);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(nz) * axis.NumberOfBlocks, 1, axis);
+    kiss_fft_free(axis.Config);
+  }
+  if (dimensionality > 2 && nz > 1)
+  {
+    axis.N = nz;
+    axis.Stride = static_cast<vtkIdType>(m) * ny;
+    axis.OtherStride = m;
+    axis.Config = kiss_fft_alloc(nz, inverse, nullptr, nullptr);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(ny) * axis.NumberOfBlocks, 1, axis);
+    kiss_fft_free(axis.Config);
+  }
+}
+
+template <class T>
+void vtkImageRealFFTForward(vtkImageRealFFT* self, vtkImageData* inData, const T* inPtr,
+  kiss_fft_cpx* outPtr, const int dims[3])
+{
+  vtkImageRealFFTForwardRows<T> rows;
+  rows.Input = inPtr;
+  inData->GetIncrements(rows.InIncrements);
+  rows.Output = outPtr;
+  rows.N = dims[0];
+  rows.M = dims[0] / 2 + 1;
+  rows.NY = dims[1];
+  rows.ComplexConfig =
+    (dims[0] % 2 == 0) ? nullptr : kiss_fft_alloc(dims[0], 0, nullptr, nullptr);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dims[1]) * dims[2], rows);
+  kiss_fft_free(rows.ComplexConfig);
+  self->UpdateProgress(0.5);
+
+  vtkImageRealFFTTransformAxes(outPtr, rows.M, dims[1], dims[2], self->GetDimensionality(), false);
+}
+
+template <class T>
+void vtkImageRealFFTLoad(
+  vtkImageData* inData, const T* inPtr, kiss_fft_cpx* outPtr, const int dims[3], int m)
+{
+  vtkImageRealFFTLoadSpectrum<T> load;
+  load.Input = inPtr;
+  inData->GetIncrements(load.InIncrements);
+  load.HasImaginary = (inData->GetNumberOfScalarComponents() > 1);
+  load.Output = outPtr;
+  load.M = m;
+  load.NY = dims[1];
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dims[1]) * dims[2], load);
+}
+
+template <class T>
+void vtkImageRealFFTInverse(vtkImageRealFFT* self, const kiss_fft_cpx* inPtr, T* outPtr,
+  const int dims[3], int m)
+{
+  vtkImageRealFFTInverseRows<T> rows;
+  rows.Input = inPtr;
+  rows.Output = outPtr;
+  rows.N = dims[0];
+  rows.M = m;
+  rows.Scale = 1.0 / dims[0];
+  if (self->GetDimensionality() > 1)
+  {
+    rows.Scale /= dims[1];
+  }
+  if (self->GetDimensionality() > 2)
+  {
+    rows.Scale /= dims[2];
+  }
+  rows.ComplexConfig =
+    (dims[0] % 2 == 0) ? nullptr : kiss_fft_alloc(dims[0], 1, nullptr, nullptr);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dims[1]) * dims[2], rows);
+  kiss_fft_free(rows.ComplexConfig);
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkImageRealFFT::vtkImageRealFFT()
+{
+  this->Dimensionality = 3;
+  this->Inverse = false;
+  this->InverseXDimension = 0;
+  this->OutputScalarType = VTK_DOUBLE;
+}
+
+//----------------------------------------------------------------------------
+vtkImageRealFFT::~vtkImageRealFFT() = default;
+
+//----------------------------------------------------------------------------
+// The output has the half spectrum along X for the forward transform, and
+// the real image for the inverse transform.
+int vtkImageRealFFT::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+
+  int extent[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
+  int size = extent[1] - extent[0] + 1;
+  if (this->Inverse)
+  {
+    int n = (this->InverseXDimension > 0) ? this->InverseXDimension : 2 * (size - 1);
+    if (n < 1 || n / 2 + 1 != size)
+    {
+      vtkErrorMacro("A half spectrum with " << size << " samples along X cannot give "
+                                            << n << " samples along X.");
+      return 0;
+    }
+    extent[1] = extent[0] + n - 1;
+  }
+  else
+  {
+    extent[1] = extent[0] + size / 2;
+  }
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+  vtkDataObject::SetPointDataActiveScalarInfo(
+    outInfo, this->OutputScalarType, this->Inverse ? 1 : 2);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Any output sample depends on all of the input.
+int vtkImageRealFFT::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()), 6);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageRealFFT::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* inData = vtkImageData::GetData(inInfo);
+  vtkImageData* outData = vtkImageData::GetData(outInfo);
+
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), outExt);
+  this->AllocateOutputData(outData, outInfo, outExt);
+  if (outData->GetNumberOfPoints() == 0)
+  {
+    return 1;
+  }
+
+  int inExt[6];
+  inData->GetExtent(inExt);
+  void* inPtr = inData->GetScalarPointerForExtent(inExt);
+  if (!inPtr || inData->GetNumberOfScalarComponents() < 1)
+  {
+    vtkErrorMacro("No input scalars to transform.");
+    return 0;
+  }
+
+  // The dimensions of the real image.
+  int dims[3];
+  (this->Inverse ? outData : inData)->GetDimensions(dims);
+  int m = dims[0] / 2 + 1;
+  std::vector<kiss_fft_cpx> workspace;
+  this->UpdateProgress(0.0);
+
+  if (!this->Inverse)
+  {
+    // A double output has the layout of the complex values of kissfft, so
+    // the transform is done in place in it.
+    static_assert(sizeof(kiss_fft_cpx) == 2 * sizeof(double),
+                  "kiss_fft_cpx must be a pair of doubles");
+    kiss_fft_cpx* spectrum;
+    if (this->OutputScalarType == VTK_DOUBLE)
+    {
+      spectrum = static_cast<kiss_fft_cpx*>(outData->GetScalarPointer());
+    }
+    else
+    {
+      workspace.resize(static_cast<size_t>(m) * dims[1] * dims[2]);
+      spectrum = workspace.data();
+    }
+
+    switch (inData->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImageRealFFTForward(
+        this, inData, static_cast<const VTK_TT*>(inPtr), spectrum, dims));
+      default:
+        vtkErrorMacro("Execute: Unknown ScalarType");
+        return 0;
+    }
+
+    if (!workspace.empty())
+    {
+      vtkImageRealFFTStoreSpectrum store;
+      store.Input = spectrum;
+      store.Output = static_cast<float*>(outData->GetScalarPointer());
+      vtkSMPTools::For(0, static_cast<vtkIdType>(workspace.size()), store);
+    }
+  }
+  else
+  {
+    // The transforms along Y and Z change the spectrum, which is copied
+    // from the input first.
+    workspace.resize(static_cast<size_t>(m) * dims[1] * dims[2]);
+    switch (inData->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImageRealFFTLoad(
+        inData, static_cast<const VTK_TT*>(inPtr), workspace.data(), dims, m));
+      default:
+        vtkErrorMacro("Execute: Unknown ScalarType");
+        return 0;
+    }
+
+    vtkImageRealFFTTransformAxes(
+      workspace.data(), m, dims[1], dims[2], this->Dimensionality, true);
+    this->UpdateProgress(0.5);
+
+    void* outPtr = outData->GetScalarPointer();
+    if (this->OutputScalarType == VTK_DOUBLE)
+    {
+      vtkImageRealFFTInverse(this, workspace.data(), static_cast<double*>(outPtr), dims, m);
+    }
+    else
+    {
+      vtkImageRealFFTInverse(this, workspace.data(), static_cast<float*>(outPtr), dims, m);
+    }
+  }
+
+  this->UpdateProgress(1.0);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageRealFFT::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Dimensionality: " << this->Dimensionality << "\n";
+  os << indent << "Inverse: " << (this->Inverse ? "On\n" : "Off\n");
+  os << indent << "InverseXDimension: " << this->InverseXDimension << "\n";
+  os << indent << "OutputScalarType: " << vtkImageScalarTypeNameMacro(this->OutputScalarType)
+     << "\n";
+}
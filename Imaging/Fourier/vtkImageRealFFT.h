@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageRealFFT.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageRealFFT
+ * @brief   Real to complex fast Fourier transform.
+ *
+ * vtkImageRealFFT computes the Fourier transform of the first component of
+ * a real image with kissfft. Since the spectrum of a real image is
+ * Hermitian, only its non-negative X frequencies are stored: an input with
+ * nx samples along X gives an output with nx/2+1 samples along X, with the
+ * real values in component 0 and the imaginary values in component 1. The
+ * other axes are not reduced, and frequencies are ordered like those of
+ * vtkImageFFT.
+ *
+ * With Inverse on, the filter takes such a half spectrum and produces the
+ * real image back. The inverse transform is normalized, so that the inverse
+ * of the forward transform reproduces the input.
+ *
+ * Unlike vtkImageFFT, all the axes are transformed in a single execution
+ * of the filter: rows along X are transformed in parallel, then blocks of
+ * neighboring lines along Y and Z are gathered into contiguous buffers and
+ * transformed together, which keeps the memory accesses cache friendly.
+ * The whole input is always needed to compute the output.
+ *
+ * @sa
+ * vtkImageFFT vtkImageRFFT
+ */
+
+#ifndef vtkImageRealFFT_h
+#define vtkImageRealFFT_h
+
+#include "vtkImageAlgorithm.h"
+#include "vtkImagingFourierModule.h" // For export macro
+
+class VTKIMAGINGFOURIER_EXPORT vtkImageRealFFT : public vtkImageAlgorithm
+{
+public:
+  static vtkImageRealFFT* New();
+  vtkTypeMacro(vtkImageRealFFT, vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the number of axes that are transformed, starting with X.
+   * The default is 3.
+   */
+  vtkSetClampMacro(Dimensionality, int, 1, 3);
+  vtkGetMacro(Dimensionality, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether the filter computes the inverse transform, from a half
+   * spectrum to a real image. The default is off.
+   */
+  vtkSetMacro(Inverse, bool);
+  vtkGetMacro(Inverse, bool);
+  vtkBooleanMacro(Inverse, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of samples along X of the real image produced by the
+   * inverse transform. A half spectrum with m samples along X comes from an
+   * image with either 2m-2 or 2m-1 samples. The default, 0, chooses 2m-2.
+   */
+  vtkSetClampMacro(InverseXDimension, int, 0, VTK_INT_MAX);
+  vtkGetMacro(InverseXDimension, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the scalar type of the output, either VTK_DOUBLE (the default)
+   * or VTK_FLOAT. Single precision halves the size of the output, the
+   * transforms themselves are always computed in double precision.
+   */
+  vtkSetClampMacro(OutputScalarType, int, VTK_FLOAT, VTK_DOUBLE);
+  vtkGetMacro(OutputScalarType, int);
+  void SetOutputScalarTypeToFloat() { this->SetOutputScalarType(VTK_FLOAT); }
+  void SetOutputScalarTypeToDouble() { this->SetOutputScalarType(VTK_DOUBLE); }
+  //@}
+
+protected:
+  vtkImageRealFFT();
+  ~vtkImageRealFFT() override;
+
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  int Dimensionality;
+  bool Inverse;
+  int InverseXDimension;
+  int OutputScalarType;
+
+private:
+  vtkImageRealFFT(const vtkImageRealFFT&) = delete;
+  void operator=(const vtkImageRealFFT&) = delete;
+};
+
+#endif
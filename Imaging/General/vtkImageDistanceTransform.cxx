@@ -0,0 +1,430 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageDistanceTransform.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageDistanceTransform.h"
+
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+vtkStandardNewMacro(vtkImageDistanceTransform);
+
+namespace
+{
+
+// Sets the squared distances of the feature voxels to zero and those of
+// the other voxels to infinity. The features are the foreground voxels, or
+// the background voxels when Foreground is false.
+template <class IT, class OT>
+struct vtkImageDistanceTransformInitialize
+{
+  const IT* Input;
+  vtkIdType InIncrements[3];
+  int Dims[3];
+  bool Foreground;
+  OT* Distances;
+  vtkIdType* Ids;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const OT infinity = std::numeric_limits<OT>::infinity();
+    for (vtkIdType r = begin; r < end; ++r)
+    {
+      const IT* in = this->Input + (r % this->Dims[1]) * this->InIncrements[1] +
+        (r / this->Dims[1]) * this->InIncrements[2];
+      vtkIdType id = r * this->Dims[0];
+      for (int i = 0; i < this->Dims[0]; ++i, ++id)
+      {
+        bool feature = ((in[i * this->InIncrements[0]] != 0) == this->Foreground);
+        this->Distances[id] = (feature ? 0 : infinity);
+        if (this->Ids)
+        {
+          this->Ids[id] = (feature ? id : -1);
+        }
+      }
+    }
+  }
+};
+
+// The buffers of one thread for the transform of a line.
+struct vtkImageDistanceTransformLine
+{
+  std::vector<double> F;
+  std::vector<vtkIdType> Ids;
+  // The lower envelope: the parabolas, their heights at the origin, and the
+  // positions where they start to be the lowest.
+  std::vector<int> V;
+  std::vector<double> H;
+  std::vector<double> Z;
+};
+
+// Transforms the squared distances along one axis. Each line is gathered,
+// the lower envelope of the parabolas rooted at its finite samples is
+// computed in a single sweep, and the envelope is sampled back into the
+// line, so that the cost is linear in the length of the line.
+template <class OT>
+struct vtkImageDistanceTransformAxis
+{
+  OT* Distances;
+  vtkIdType* Ids;
+  int N;
+  vtkIdType Stride;
+  // How the index of a line gives the position of its first sample.
+  vtkIdType LineModulo;
+  vtkIdType LineStride;
+  double Weight;
+  vtkSMPThreadLocal<vtkImageDistanceTransformLine> Lines;
+
+  void Initialize()
+  {
+    vtkImageDistanceTransformLine& line = this->Lines.Local();
+    line.F.resize(this->N);
+    line.Ids.resize(this->Ids ? this->N : 0);
+    line.V.resize(this->N);
+    line.H.resize(this->N);
+    line.Z.resize(this->N + 1);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkImageDistanceTransformLine& line = this->Lines.Local();
+    const double infinity = std::numeric_limits<double>::infinity();
+    const double w = this->Weight;
+    for (vtkIdType l = begin; l < end; ++l)
+    {
+      vtkIdType start = (l % this->LineModulo) + (l / this->LineModulo) * this->LineStride;
+      OT* d = this->Distances + start;
+      for (int i = 0; i < this->N; ++i)
+      {
+        line.F[i] = static_cast<double>(d[i * this->Stride]);
+      }
+
+      // Build the lower envelope.
+      int k = -1;
+      for (int q = 0; q < this->N; ++q)
+      {
+        if (line.F[q] == infinity)
+        {
+          continue;
+        }
+        double h = line.F[q] + w * q * q;
+        double s = -infinity;
+        while (k >= 0)
+        {
+          s = (h - line.H[k]) / (2.0 * w * (q - line.V[k]));
+          if (s > line.Z[k])
+          {
+            break;
+          }
+          --k;
+        }
+        ++k;
+        line.V[k] = q;
+        line.H[k] = h;
+        line.Z[k] = (k == 0 ? -infinity : s);
+      }
+      if (k < 0)
+      {
+        // No feature is reachable from this line.
+        continue;
+      }
+      line.Z[k + 1] = infinity;
+
+      if (this->Ids)
+      {
+        vtkIdType* ids = this->Ids + start;
+        for (int i = 0; i < this->N; ++i)
+        {
+          line.Ids[i] = ids[i * this->Stride];
+        }
+      }
+
+      // Sample the envelope.
+      int j = 0;
+      for (int p = 0; p < this->N; ++p)
+      {
+        while (line.Z[j + 1] < p)
+        {
+          ++j;
+        }
+        int v = line.V[j];
+        d[p * this->Stride] = static_cast<OT>(w * (p - v) * (p - v) + line.F[v]);
+        if (this->Ids)
+        {
+          this->Ids[start + p * this->Stride] = line.Ids[v];
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Computes the squared distances to the features along the transformed
+// axes of the image.
+template <class IT, class OT>
+void vtkImageDistanceTransformSquared(vtkImageDistanceTransform* self, vtkImageData* inData,
+  const IT* inPtr, const int dims[3], const double spacing[3], bool foreground, OT* distances,
+  vtkIdType* ids)
+{
+  vtkImageDistanceTransformInitialize<IT, OT> initialize;
+  initialize.Input = inPtr;
+  inData->GetIncrements(initialize.InIncrements);
+  initialize.Dims[0] = dims[0];
+  initialize.Dims[1] = dims[1];
+  initialize.Dims[2] = dims[2];
+  initialize.Foreground = foreground;
+  initialize.Distances = distances;
+  initialize.Ids = ids;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dims[1]) * dims[2], initialize);
+
+  const vtkIdType sliceSize = static_cast<vtkIdType>(dims[0]) * dims[1];
+  const vtkIdType numberOfPoints = sliceSize * dims[2];
+  const vtkIdType strides[3] = { 1, dims[0], sliceSize };
+  const vtkIdType modulos[3] = { 1, dims[0], sliceSize };
+  const vtkIdType lineStrides[3] = { dims[0], sliceSize, numberOfPoints };
+  for (int axis = 0; axis < self->GetDimensionality(); ++axis)
+  {
+    if (dims[axis] == 1)
+    {
+      continue;
+    }
+    vtkImageDistanceTransformAxis<OT> transform;
+    transform.Distances = distances;
+    transform.Ids = ids;
+    transform.N = dims[axis];
+    transform.Stride = strides[axis];
+    transform.LineModulo = modulos[axis];
+    transform.LineStride = lineStrides[axis];
+    transform.Weight = (self->GetConsiderAnisotropy() ? spacing[axis] * spacing[axis] : 1.0);
+    vtkSMPTools::For(0, numberOfPoints / dims[axis], transform);
+  }
+}
+
+// Takes the square roots of the squared distances, applies the sign of the
+// foreground voxels, and replaces infinite distances by the largest value
+// of the output type.
+template <class IT, class OT>
+struct vtkImageDistanceTransformFinish
+{
+  const IT* Input;
+  vtkIdType InIncrements[3];
+  int Dims[3];
+  bool Squared;
+  OT* Distances;
+  vtkIdType* Ids;
+  // The distances and ids of the foreground voxels, for signed distances.
+  const OT* Inside;
+  const vtkIdType* InsideIds;
+
+  OT Convert(OT d) const
+  {
+    if (d == std::numeric_limits<OT>::infinity())
+    {
+      return std::numeric_limits<OT>::max();
+    }
+    return (this->Squared ? d : static_cast<OT>(std::sqrt(d)));
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType r = begin; r < end; ++r)
+    {
+      const IT* in = this->Input + (r % this->Dims[1]) * this->InIncrements[1] +
+        (r / this->Dims[1]) * this->InIncrements[2];
+      vtkIdType id = r * this->Dims[0];
+      for (int i = 0; i < this->Dims[0]; ++i, ++id)
+      {
+        if (this->Inside && in[i * this->InIncrements[0]] != 0)
+        {
+          this->Distances[id] = -this->Convert(this->Inside[id]);
+          if (this->Ids)
+          {
+            this->Ids[id] = this->InsideIds[id];
+          }
+        }
+        else
+        {
+          this->Distances[id] = this->Convert(this->Distances[id]);
+        }
+      }
+    }
+  }
+};
+
+template <class IT, class OT>
+void vtkImageDistanceTransformExecute(vtkImageDistanceTransform* self, vtkImageData* inData,
+  const IT* inPtr, vtkImageData* outData, OT* outPtr, vtkIdType* ids)
+{
+  int dims[3];
+  double spacing[3];
+  outData->GetDimensions(dims);
+  inData->GetSpacing(spacing);
+  const size_t numberOfPoints = static_cast<size_t>(dims[0]) * dims[1] * dims[2];
+
+  // The distances to the foreground, computed in place in the output.
+  vtkImageDistanceTransformSquared(self, inData, inPtr, dims, spacing, true, outPtr, ids);
+
+  // The distances of the foreground voxels to the background.
+  std::vector<OT> inside;
+  std::vector<vtkIdType> insideIds;
+  if (self->GetSignedDistance())
+  {
+    self->UpdateProgress(0.5);
+    inside.resize(numberOfPoints);
+    insideIds.resize(ids ? numberOfPoints : 0);
+    vtkImageDistanceTransformSquared(self, inData, inPtr, dims, spacing, false, inside.data(),
+      ids ? insideIds.data() : nullptr);
+  }
+
+  vtkImageDistanceTransformFinish<IT, OT> finish;
+  finish.Input = inPtr;
+  inData->GetIncrements(finish.InIncrements);
+  finish.Dims[0] = dims[0];
+  finish.Dims[1] = dims[1];
+  finish.Dims[2] = dims[2];
+  finish.Squared = (self->GetSquaredDistance() != 0);
+  finish.Distances = outPtr;
+  finish.Ids = ids;
+  finish.Inside = (inside.empty() ? nullptr : inside.data());
+  finish.InsideIds = (insideIds.empty() ? nullptr : insideIds.data());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dims[1]) * dims[2], finish);
+}
+
+template <class IT>
+void vtkImageDistanceTransformDispatch(vtkImageDistanceTransform* self, vtkImageData* inData,
+  const IT* inPtr, vtkImageData* outData, vtkIdType* ids)
+{
+  void* outPtr = outData->GetScalarPointer();
+  if (outData->GetScalarType() == VTK_DOUBLE)
+  {
+    vtkImageDistanceTransformExecute(
+      self, inData, inPtr, outData, static_cast<double*>(outPtr), ids);
+  }
+  else
+  {
+    vtkImageDistanceTransformExecute(
+      self, inData, inPtr, outData, static_cast<float*>(outPtr), ids);
+  }
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkImageDistanceTransform::vtkImageDistanceTransform()
+{
+  this->Dimensionality = 3;
+  this->SignedDistance = 0;
+  this->ConsiderAnisotropy = 1;
+  this->SquaredDistance = 0;
+  this->GenerateNearestFeatureIds = 0;
+  this->OutputScalarType = VTK_FLOAT;
+}
+
+//----------------------------------------------------------------------------
+vtkImageDistanceTransform::~vtkImageDistanceTransform() = default;
+
+//----------------------------------------------------------------------------
+int vtkImageDistanceTransform::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject::SetPointDataActiveScalarInfo(outInfo, this->OutputScalarType, 1);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Any output voxel depends on all of the input.
+int vtkImageDistanceTransform::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector))
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()), 6);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageDistanceTransform::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* inData = vtkImageData::GetData(inInfo);
+  vtkImageData* outData = vtkImageData::GetData(outInfo);
+
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), outExt);
+  this->AllocateOutputData(outData, outInfo, outExt);
+  if (outData->GetNumberOfPoints() == 0)
+  {
+    return 1;
+  }
+
+  void* inPtr = inData->GetScalarPointerForExtent(outExt);
+  if (!inPtr || inData->GetNumberOfScalarComponents() < 1)
+  {
+    vtkErrorMacro("No input scalars to transform.");
+    return 0;
+  }
+
+  vtkIdType* ids = nullptr;
+  if (this->GenerateNearestFeatureIds)
+  {
+    vtkIdTypeArray* idArray = vtkIdTypeArray::New();
+    idArray->SetName("NearestFeatureIds");
+    idArray->SetNumberOfValues(outData->GetNumberOfPoints());
+    outData->GetPointData()->AddArray(idArray);
+    idArray->Delete();
+    ids = idArray->GetPointer(0);
+  }
+
+  this->UpdateProgress(0.0);
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkImageDistanceTransformDispatch(
+      this, inData, static_cast<const VTK_TT*>(inPtr), outData, ids));
+    default:
+      vtkErrorMacro("Execute: Unknown ScalarType");
+      return 0;
+  }
+  this->UpdateProgress(1.0);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageDistanceTransform::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Dimensionality: " << this->Dimensionality << "\n";
+  os << indent << "SignedDistance: " << (this->SignedDistance ? "On\n" : "Off\n");
+  os << indent << "ConsiderAnisotropy: " << (this->ConsiderAnisotropy ? "On\n" : "Off\n");
+  os << indent << "SquaredDistance: " << (this->SquaredDistance ? "On\n" : "Off\n");
+  os << indent << "GenerateNearestFeatureIds: "
+     << (this->GenerateNearestFeatureIds ? "On\n" : "Off\n");
+  os << indent << "OutputScalarType: " << vtkImageScalarTypeNameMacro(this->OutputScalarType)
+     << "\n";
+}
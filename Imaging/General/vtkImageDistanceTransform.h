@@ -0,0 +1,148 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageDistanceTransform.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageDistanceTransform
+ * @brief   Exact Euclidean distance transform in linear time.
+ *
+ * vtkImageDistanceTransform computes the exact Euclidean distance from each
+ * voxel to the nearest foreground voxel of a binary mask, where the
+ * foreground is made of the voxels whose first scalar component is not
+ * zero. Foreground voxels have a distance of zero.
+ *
+ * With SignedDistance on, the filter produces a signed distance field
+ * instead: background voxels get their distance to the foreground, and
+ * foreground voxels get minus their distance to the background, so that the
+ * zero level set lies halfway between the two. Such fields can be contoured
+ * or used as implicit functions.
+ *
+ * The distances are computed with the separable algorithm of Felzenszwalb
+ * and Huttenlocher, which computes the lower envelope of parabolas along
+ * each axis in turn. Its cost is linear in the number of voxels, whatever
+ * the shape of the mask, unlike vtkImageEuclideanDistance whose cost grows
+ * with the distances. The lines along each axis are transformed in
+ * parallel. The whole input is always needed to compute the output.
+ *
+ * Optionally, the point id of the nearest foreground voxel (or of the
+ * nearest background voxel, for the foreground voxels of a signed distance)
+ * is stored in a vtkIdTypeArray named "NearestFeatureIds" in the point data
+ * of the output.
+ *
+ * @sa
+ * vtkImageEuclideanDistance
+ */
+
+#ifndef vtkImageDistanceTransform_h
+#define vtkImageDistanceTransform_h
+
+#include "vtkImageAlgorithm.h"
+#include "vtkImagingGeneralModule.h" // For export macro
+
+class VTKIMAGINGGENERAL_EXPORT vtkImageDistanceTransform : public vtkImageAlgorithm
+{
+public:
+  static vtkImageDistanceTransform* New();
+  vtkTypeMacro(vtkImageDistanceTransform, vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the number of axes along which distances are measured, starting
+   * with X. With a dimensionality of 2, the slices are transformed
+   * independently. The default is 3.
+   */
+  vtkSetClampMacro(Dimensionality, int, 1, 3);
+  vtkGetMacro(Dimensionality, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether the foreground voxels get minus their distance to the
+   * background. The default is off.
+   */
+  vtkSetMacro(SignedDistance, vtkTypeBool);
+  vtkGetMacro(SignedDistance, vtkTypeBool);
+  vtkBooleanMacro(SignedDistance, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether the spacing of the input is used, so that distances are
+   * in world units even for anisotropic voxels. When off, distances are
+   * measured in voxels. The default is on.
+   */
+  vtkSetMacro(ConsiderAnisotropy, vtkTypeBool);
+  vtkGetMacro(ConsiderAnisotropy, vtkTypeBool);
+  vtkBooleanMacro(ConsiderAnisotropy, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether the output is the square of the distance, which saves
+   * a square root per voxel. The sign of a signed distance is kept. The
+   * default is off.
+   */
+  vtkSetMacro(SquaredDistance, vtkTypeBool);
+  vtkGetMacro(SquaredDistance, vtkTypeBool);
+  vtkBooleanMacro(SquaredDistance, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether the ids of the nearest feature voxels are stored in the
+   * "NearestFeatureIds" point data array of the output. The ids are those of
+   * the points of the output, -1 for voxels that cannot reach any feature.
+   * The default is off.
+   */
+  vtkSetMacro(GenerateNearestFeatureIds, vtkTypeBool);
+  vtkGetMacro(GenerateNearestFeatureIds, vtkTypeBool);
+  vtkBooleanMacro(GenerateNearestFeatureIds, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the scalar type of the output, either VTK_FLOAT (the default)
+   * or VTK_DOUBLE. Voxels that cannot reach any feature, for instance all
+   * the voxels of an empty mask, get the largest magnitude of this type.
+   */
+  vtkSetClampMacro(OutputScalarType, int, VTK_FLOAT, VTK_DOUBLE);
+  vtkGetMacro(OutputScalarType, int);
+  void SetOutputScalarTypeToFloat() { this->SetOutputScalarType(VTK_FLOAT); }
+  void SetOutputScalarTypeToDouble() { this->SetOutputScalarType(VTK_DOUBLE); }
+  //@}
+
+protected:
+  vtkImageDistanceTransform();
+  ~vtkImageDistanceTransform() override;
+
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  int Dimensionality;
+  vtkTypeBool SignedDistance;
+  vtkTypeBool ConsiderAnisotropy;
+  vtkTypeBool SquaredDistance;
+  vtkTypeBool GenerateNearestFeatureIds;
+  int OutputScalarType;
+
+private:
+  vtkImageDistanceTransform(const vtkImageDistanceTransform&) = delete;
+  void operator=(const vtkImageDistanceTransform&) = delete;
+};
+
+#endif
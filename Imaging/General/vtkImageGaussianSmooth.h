@@ -18,6 +18,9 @@
  *
  * vtkImageGaussianSmooth implements a convolution of the input image
  * with a gaussian. Supports from one to three dimensional convolutions.
+ *
+ * @sa
+ * vtkImageRecursiveGaussian
 */
 
 #ifndef vtkImageGaussianSmooth_h
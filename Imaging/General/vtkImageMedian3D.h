@@ -21,6 +21,9 @@
  * Neighborhoods can be no more than 3 dimensional.  Setting one
  * axis of the neighborhood kernelSize to 1 changes the filter
  * into a 2D median.
+ *
+ * @sa
+ * vtkImageRankFilter
 */
 
 #ifndef vtkImageMedian3D_h
@@ -0,0 +1,450 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageRankFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageRankFilter.h"
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkTypeTraits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+vtkStandardNewMacro(vtkImageRankFilter);
+
+//-----------------------------------------------------------------------------
+vtkImageRankFilter::vtkImageRankFilter()
+{
+  this->NumberOfElements = 0;
+  this->RankMode = Median;
+  this->PercentileValue = 50.0;
+  this->SetKernelSize(1, 1, 1);
+  this->HandleBoundaries = 1;
+}
+
+//-----------------------------------------------------------------------------
+vtkImageRankFilter::~vtkImageRankFilter() = default;
+
+//-----------------------------------------------------------------------------
+void vtkImageRankFilter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfElements: " << this->NumberOfElements << endl;
+  os << indent << "RankMode: " << this->GetRankModeAsString() << endl;
+  os << indent << "PercentileValue: " << this->PercentileValue << endl;
+}
+
+//-----------------------------------------------------------------------------
+void vtkImageRankFilter::SetKernelSize(int size0, int size1, int size2)
+{
+  if (this->KernelSize[0] != size0 || this->KernelSize[1] != size1 ||
+    this->KernelSize[2] != size2)
+  {
+    this->KernelSize[0] = size0;
+    this->KernelSize[1] = size1;
+    this->KernelSize[2] = size2;
+    this->KernelMiddle[0] = size0 / 2;
+    this->KernelMiddle[1] = size1 / 2;
+    this->KernelMiddle[2] = size2 / 2;
+    this->NumberOfElements = size0 * size1 * size2;
+    this->Modified();
+  }
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkImageRankFilter::GetRankModeAsString()
+{
+  switch (this->RankMode)
+  {
+    case Median:
+      return "Median";
+    case Percentile:
+      return "Percentile";
+    case Minimum:
+      return "Minimum";
+    case Maximum:
+      return "Maximum";
+    case Range:
+      return "Range";
+  }
+  return "";
+}
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+// Find the bin that holds a given rank within a histogram. The search starts
+// from the bin found by the previous search, which is usually close, since
+// the histogram only changes a little from one voxel to the next.
+struct vtkImageRankTracker
+{
+  int Bin = 0;
+  // the number of values in the bins below Bin
+  vtkIdType Below = 0;
+
+  void Add(int bin) { this->Below += (bin < this->Bin); }
+  void Remove(int bin) { this->Below -= (bin < this->Bin); }
+
+  int Find(const int* counts, vtkIdType rank)
+  {
+    while (this->Below > rank)
+    {
+      this->Below -= counts[--this->Bin];
+    }
+    while (this->Below + counts[this->Bin] <= rank)
+    {
+      this->Below += counts[this->Bin++];
+    }
+    return this->Bin;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// A neighborhood of integer values, kept as a histogram.
+template <class T>
+class vtkImageRankHistogram
+{
+public:
+  vtkImageRankHistogram(vtkTypeInt64 minValue, vtkTypeInt64 maxValue)
+    : Offset(minValue)
+    , Counts(static_cast<size_t>(maxValue - minValue + 1), 0)
+  {
+  }
+
+  void Add(T value)
+  {
+    int bin = static_cast<int>(value - this->Offset);
+    this->Counts[bin]++;
+    this->Lower.Add(bin);
+    this->Upper.Add(bin);
+  }
+
+  void Remove(T value)
+  {
+    int bin = static_cast<int>(value - this->Offset);
+    this->Counts[bin]--;
+    this->Lower.Remove(bin);
+    this->Upper.Remove(bin);
+  }
+
+  void Query(vtkIdType rank0, vtkIdType rank1, T& value0, T& value1)
+  {
+    value0 = static_cast<T>(this->Offset + this->Lower.Find(this->Counts.data(), rank0));
+    value1 = static_cast<T>(this->Offset + this->Upper.Find(this->Counts.data(), rank1));
+  }
+
+private:
+  vtkTypeInt64 Offset;
+  std::vector<int> Counts;
+  vtkImageRankTracker Lower;
+  vtkImageRankTracker Upper;
+};
+
+//-----------------------------------------------------------------------------
+// A neighborhood of values that have been replaced by their index within a
+// sorted table of all the distinct values, kept as a histogram of indices.
+template <class T>
+class vtkImageRankTableHistogram
+{
+public:
+  vtkImageRankTableHistogram(const std::vector<T>& table)
+    : Table(table)
+    , Histogram(0, static_cast<vtkTypeInt64>(table.size()) - 1)
+  {
+  }
+
+  void Add(int index) { this->Histogram.Add(index); }
+  void Remove(int index) { this->Histogram.Remove(index); }
+
+  void Query(vtkIdType rank0, vtkIdType rank1, T& value0, T& value1)
+  {
+    int index0, index1;
+    this->Histogram.Query(rank0, rank1, index0, index1);
+    value0 = this->Table[index0];
+    value1 = this->Table[index1];
+  }
+
+private:
+  const std::vector<T>& Table;
+  vtkImageRankHistogram<int> Histogram;
+};
+
+//-----------------------------------------------------------------------------
+// The value halfway between two sorted values, rounded down for integers as
+// in vtkImageMedian3D. The difference is computed without overflow.
+template <class T>
+T vtkImageRankMidpoint(T value0, T value1, std::true_type)
+{
+  typedef typename std::make_unsigned<T>::type UnsignedT;
+  UnsignedT half = static_cast<UnsignedT>(
+    static_cast<UnsignedT>(value1) - static_cast<UnsignedT>(value0)) / 2;
+  return static_cast<T>(value0 + static_cast<T>(half));
+}
+
+template <class T>
+T vtkImageRankMidpoint(T value0, T value1, std::false_type)
+{
+  return value0 + (value1 - value0) / 2;
+}
+
+//-----------------------------------------------------------------------------
+// Compute the statistic from the values of the two ranks.
+template <class T>
+T vtkImageRankCombine(int mode, T value0, T value1)
+{
+  if (mode == vtkImageRankFilter::Median)
+  {
+    return vtkImageRankMidpoint(value0, value1, std::is_integral<T>());
+  }
+  else if (mode == vtkImageRankFilter::Range)
+  {
+    double range = static_cast<double>(value1) - static_cast<double>(value0);
+    return static_cast<T>(std::min(range, static_cast<double>(vtkTypeTraits<T>::Max())));
+  }
+  return value0;
+}
+
+//-----------------------------------------------------------------------------
+// Slide the neighborhood along each row of the output extent. The input
+// values are added to and removed from the window, which gives back values
+// of the output type.
+template <class TIn, class T, class W>
+void vtkImageRankFilterSweep(vtkImageRankFilter* self, W& window, const TIn* inPtr,
+  const int inExt[6], const vtkIdType inInc[3], T* outPtr, const int outExt[6],
+  const vtkIdType outInc[3], int numComp, int id)
+{
+  const int* kernelSize = self->GetKernelSize();
+  const int* kernelMiddle = self->GetKernelMiddle();
+  int mode = self->GetRankMode();
+  double percentile = self->GetPercentileValue();
+
+  unsigned long count = 0;
+  unsigned long target =
+    static_cast<unsigned long>((outExt[5] - outExt[4] + 1) * (outExt[3] - outExt[2] + 1) / 50.0);
+  target++;
+
+  for (int z = outExt[4]; z <= outExt[5]; z++)
+  {
+    int z0 = std::max(z - kernelMiddle[2], inExt[4]);
+    int z1 = std::min(z - kernelMiddle[2] + kernelSize[2] - 1, inExt[5]);
+    for (int y = outExt[2]; !self->AbortExecute && y <= outExt[3]; y++)
+    {
+      if (!id)
+      {
+        if (!(count % target))
+        {
+          self->UpdateProgress(count / (50.0 * target));
+        }
+        count++;
+      }
+      int y0 = std::max(y - kernelMiddle[1], inExt[2]);
+      int y1 = std::min(y - kernelMiddle[1] + kernelSize[1] - 1, inExt[3]);
+      vtkIdType area = static_cast<vtkIdType>(y1 - y0 + 1) * (z1 - z0 + 1);
+
+      for (int c = 0; c < numComp; c++)
+      {
+        // the first voxel of the neighborhood, for x = inExt[0]
+        const TIn* hoodPtr =
+          inPtr + (y0 - inExt[2]) * inInc[1] + (z0 - inExt[4]) * inInc[2] + c;
+        T* outPtr0 = outPtr + (y - outExt[2]) * outInc[1] + (z - outExt[4]) * outInc[2] + c;
+
+        // add or remove the column of the neighborhood at a given x
+        auto column = [&](int x, bool add) {
+          const TIn* ptr2 = hoodPtr + (x - inExt[0]) * inInc[0];
+          for (int k = z0; k <= z1; k++)
+          {
+            const TIn* ptr1 = ptr2;
+            for (int j = y0; j <= y1; j++)
+            {
+              if (add)
+              {
+                window.Add(*ptr1);
+              }
+              else
+              {
+                window.Remove(*ptr1);
+              }
+              ptr1 += inInc[1];
+            }
+            ptr2 += inInc[2];
+          }
+        };
+
+        // the columns that are currently in the window
+        int first = std::max(outExt[0] - kernelMiddle[0], inExt[0]);
+        int last = first - 1;
+        for (int x = outExt[0]; x <= outExt[1]; x++)
+        {
+          int x0 = std::max(x - kernelMiddle[0], inExt[0]);
+          int x1 = std::min(x - kernelMiddle[0] + kernelSize[0] - 1, inExt[1]);
+          while (first < x0)
+          {
+            column(first++, false);
+          }
+          while (last < x1)
+          {
+            column(++last, true);
+          }
+
+          vtkIdType n = (x1 - x0 + 1) * area;
+          vtkIdType rank0 = 0;
+          vtkIdType rank1 = n - 1;
+          switch (mode)
+          {
+            case vtkImageRankFilter::Median:
+              rank0 = (n - 1) / 2;
+              rank1 = n / 2;
+              break;
+            case vtkImageRankFilter::Percentile:
+              rank0 = static_cast<vtkIdType>(std::floor(percentile * (n - 1) / 100.0 + 0.5));
+              rank1 = rank0;
+              break;
+            case vtkImageRankFilter::Minimum:
+              rank1 = 0;
+              break;
+            case vtkImageRankFilter::Maximum:
+              rank0 = n - 1;
+              break;
+          }
+          T value0, value1;
+          window.Query(rank0, rank1, value0, value1);
+          *outPtr0 = vtkImageRankCombine(mode, value0, value1);
+          outPtr0 += numComp;
+        }
+
+        // empty the window for the next row
+        while (first <= last)
+        {
+          column(first++, false);
+        }
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Types with at most 2^16 values are put directly into a histogram. Values
+// of other types are first replaced by their index among the distinct values
+// of the input region, so that a histogram of indices can be used instead.
+template <class T>
+void vtkImageRankFilterExecute(vtkImageRankFilter* self, vtkImageData* inData, const T* inPtr,
+  vtkImageData* outData, T* outPtr, const int outExt[6], int numComp, int id)
+{
+  const int* inExt = inData->GetExtent();
+  vtkIdType inInc[3];
+  inData->GetIncrements(inInc);
+  vtkIdType outInc[3];
+  outData->GetIncrements(outInc);
+
+  if (std::is_integral<T>::value && sizeof(T) <= 2)
+  {
+    vtkImageRankHistogram<T> histogram(vtkTypeTraits<T>::Min(), vtkTypeTraits<T>::Max());
+    vtkImageRankFilterSweep(
+      self, histogram, inPtr, inExt, inInc, outPtr, outExt, outInc, numComp, id);
+    return;
+  }
+
+  // the part of the input that is covered by the neighborhoods
+  const int* kernelSize = self->GetKernelSize();
+  const int* kernelMiddle = self->GetKernelMiddle();
+  int ext[6];
+  for (int i = 0; i < 3; i++)
+  {
+    ext[2 * i] = std::max(outExt[2 * i] - kernelMiddle[i], inExt[2 * i]);
+    ext[2 * i + 1] =
+      std::min(outExt[2 * i + 1] - kernelMiddle[i] + kernelSize[i] - 1, inExt[2 * i + 1]);
+    if (ext[2 * i] > ext[2 * i + 1])
+    {
+      return;
+    }
+  }
+  vtkIdType rowSize = static_cast<vtkIdType>(ext[1] - ext[0] + 1) * numComp;
+  vtkIdType regionInc[3] = { numComp, rowSize, rowSize * (ext[3] - ext[2] + 1) };
+
+  std::vector<T> values(regionInc[2] * (ext[5] - ext[4] + 1));
+  auto valueIter = values.begin();
+  for (int z = ext[4]; z <= ext[5]; z++)
+  {
+    for (int y = ext[2]; y <= ext[3]; y++)
+    {
+      const T* rowPtr = inPtr + (ext[0] - inExt[0]) * inInc[0] + (y - inExt[2]) * inInc[1] +
+        (z - inExt[4]) * inInc[2];
+      valueIter = std::copy(rowPtr, rowPtr + rowSize, valueIter);
+    }
+  }
+
+  std::vector<T> table(values);
+  std::sort(table.begin(), table.end());
+  table.erase(std::unique(table.begin(), table.end()), table.end());
+
+  std::vector<int> indices(values.size());
+  for (size_t i = 0; i < values.size(); i++)
+  {
+    indices[i] = static_cast<int>(
+      std::lower_bound(table.begin(), table.end(), values[i]) - table.begin());
+  }
+  std::vector<T>().swap(values);
+
+  vtkImageRankTableHistogram<T> histogram(table);
+  vtkImageRankFilterSweep(
+    self, histogram, indices.data(), ext, regionInc, outPtr, outExt, outInc, numComp, id);
+}
+
+} // end anonymous namespace
+
+//-----------------------------------------------------------------------------
+void vtkImageRankFilter::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector),
+  vtkImageData*** inData, vtkImageData** outData, int outExt[6], int id)
+{
+  vtkDataArray* inArray = this->GetInputArrayToProcess(0, inputVector);
+  if (!inArray)
+  {
+    return;
+  }
+  if (id == 0)
+  {
+    outData[0]->GetPointData()->GetScalars()->SetName(inArray->GetName());
+  }
+
+  // this filter expects that input is the same type as output.
+  if (inArray->GetDataType() != outData[0]->GetScalarType())
+  {
+    vtkErrorMacro(<< "Execute: input data type, " << inArray->GetDataType()
+                  << ", must match out ScalarType " << outData[0]->GetScalarType());
+    return;
+  }
+
+  void* inPtr = inArray->GetVoidPointer(0);
+  void* outPtr = outData[0]->GetScalarPointerForExtent(outExt);
+  int numComp = inArray->GetNumberOfComponents();
+
+  switch (inArray->GetDataType())
+  {
+    vtkTemplateMacro(vtkImageRankFilterExecute(this, inData[0][0],
+      static_cast<const VTK_TT*>(inPtr), outData[0], static_cast<VTK_TT*>(outPtr), outExt,
+      numComp, id));
+    default:
+      vtkErrorMacro(<< "Execute: Unknown input ScalarType");
+      return;
+  }
+}
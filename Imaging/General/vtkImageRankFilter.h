@@ -0,0 +1,114 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageRankFilter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageRankFilter
+ * @brief   Median, percentile, minimum, maximum and range filters.
+ *
+ * vtkImageRankFilter replaces each voxel with a rank statistic of the
+ * values in a rectangular neighborhood around it: the median, a percentile,
+ * the minimum, the maximum, or the range (maximum minus minimum). Like
+ * vtkImageMedian3D, the neighborhood is clipped at the boundaries of the
+ * input, and the median of an even number of values is the mean of the two
+ * middle values.
+ *
+ * Instead of sorting the whole neighborhood of each voxel, the filter slides
+ * the neighborhood along each row and keeps it as a histogram, only adding
+ * and removing the values that enter and leave it. The cost per voxel grows
+ * with the area of the kernel rather than with its volume, so kernels of
+ * 15x15x15 and larger are practical. Types with more than 16 bits, including
+ * float and double, are first replaced by the index of each value among the
+ * sorted values of the input, which gives exact results for any data. The
+ * pieces of the output are processed in parallel.
+ *
+ * @sa
+ * vtkImageMedian3D vtkImageContinuousErode3D vtkImageContinuousDilate3D
+ */
+
+#ifndef vtkImageRankFilter_h
+#define vtkImageRankFilter_h
+
+#include "vtkImageSpatialAlgorithm.h"
+#include "vtkImagingGeneralModule.h" // For export macro
+
+class VTKIMAGINGGENERAL_EXPORT vtkImageRankFilter : public vtkImageSpatialAlgorithm
+{
+public:
+  static vtkImageRankFilter* New();
+  vtkTypeMacro(vtkImageRankFilter, vtkImageSpatialAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum RankModes
+  {
+    Median = 0,
+    Percentile = 1,
+    Minimum = 2,
+    Maximum = 3,
+    Range = 4
+  };
+
+  /**
+   * Set the size of the neighborhood, which is centered on each voxel. A
+   * size of 1 along an axis gives a 2D or 1D filter.
+   */
+  void SetKernelSize(int size0, int size1, int size2);
+
+  /**
+   * Get the number of voxels in the neighborhood.
+   */
+  vtkGetMacro(NumberOfElements, int);
+
+  //@{
+  /**
+   * Set/Get the statistic that is computed. The range is clamped to the
+   * largest value of the scalar type. The default is Median.
+   */
+  vtkSetClampMacro(RankMode, int, Median, Range);
+  vtkGetMacro(RankMode, int);
+  void SetRankModeToMedian() { this->SetRankMode(Median); }
+  void SetRankModeToPercentile() { this->SetRankMode(Percentile); }
+  void SetRankModeToMinimum() { this->SetRankMode(Minimum); }
+  void SetRankModeToMaximum() { this->SetRankMode(Maximum); }
+  void SetRankModeToRange() { this->SetRankMode(Range); }
+  const char* GetRankModeAsString();
+  //@}
+
+  //@{
+  /**
+   * Set/Get the percentile for the Percentile mode, between 0 and 100. For
+   * a neighborhood of n values, the percentile p gives the value of rank
+   * p*(n-1)/100, rounded to the nearest rank. The default is 50.
+   */
+  vtkSetClampMacro(PercentileValue, double, 0.0, 100.0);
+  vtkGetMacro(PercentileValue, double);
+  //@}
+
+protected:
+  vtkImageRankFilter();
+  ~vtkImageRankFilter() override;
+
+  void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
+    int extent[6], int id) override;
+
+  int NumberOfElements;
+  int RankMode;
+  double PercentileValue;
+
+private:
+  vtkImageRankFilter(const vtkImageRankFilter&) = delete;
+  void operator=(const vtkImageRankFilter&) = delete;
+};
+
+#endif
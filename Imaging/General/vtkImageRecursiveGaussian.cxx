@@ -0,0 +1,523 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageRecursiveGaussian.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageRecursiveGaussian.h"
+
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+vtkStandardNewMacro(vtkImageRecursiveGaussian);
+
+namespace
+{
+
+// The number of lines that are filtered together.
+const int vtkImageRecursiveGaussianLanes = 8;
+
+// The approximations of the gaussian and of its first derivative by sums of
+// damped cosines and sines, from Deriche (1993): for x >= 0 and in units of
+// the standard deviation, the kernel is
+//   (a0 cos(w0 x) + b0 sin(w0 x)) exp(-l0 x) + (a1 cos(w1 x) + b1 sin(w1 x)) exp(-l1 x)
+// and the values are a0, b0, a1, b1, then w0, w1, then l0, l1. Second
+// derivatives are computed with two first derivatives, which is more
+// accurate than the approximation of the second derivative.
+const double vtkImageRecursiveGaussianWeights[2][4] = {
+  { 1.68, 3.735, -0.6803, -0.2598 },
+  { -0.6472, -4.531, 0.6494, 0.9557 },
+};
+const double vtkImageRecursiveGaussianFrequencies[2][2] = {
+  { 0.6318, 1.997 },
+  { 0.6719, 2.072 },
+};
+const double vtkImageRecursiveGaussianDampings[2][2] = {
+  { 1.783, 1.723 },
+  { 1.527, 1.516 },
+};
+
+typedef std::complex<double> vtkImageRecursiveGaussianComplex;
+
+// The kernel of a given order as a sum of four geometric sequences c p^n,
+// for the samples n >= 0 of the even kernel and n > 0 of the odd kernel.
+// The samples n < 0 are the mirror image, with the sign of the symmetry of
+// the kernel.
+struct vtkImageRecursiveGaussianKernel
+{
+  vtkImageRecursiveGaussianComplex Poles[4];
+  vtkImageRecursiveGaussianComplex Weights[4];
+  double Symmetry;
+
+  vtkImageRecursiveGaussianKernel(int order, double sigma)
+  {
+    const double* w = vtkImageRecursiveGaussianWeights[order];
+    for (int i = 0; i < 2; i++)
+    {
+      vtkImageRecursiveGaussianComplex p =
+        std::exp(vtkImageRecursiveGaussianComplex(-vtkImageRecursiveGaussianDampings[order][i],
+                   vtkImageRecursiveGaussianFrequencies[order][i]) /
+          sigma);
+      this->Poles[2 * i] = p;
+      this->Poles[2 * i + 1] = std::conj(p);
+      this->Weights[2 * i] = vtkImageRecursiveGaussianComplex(w[2 * i], -w[2 * i + 1]) * 0.5;
+      this->Weights[2 * i + 1] = std::conj(this->Weights[2 * i]);
+    }
+    this->Symmetry = (order == 1 ? -1.0 : 1.0);
+  }
+
+  // The sum of the samples n^k h[n] over all n, for k = 0, 1.
+  void GetMoments(double moments[2]) const
+  {
+    vtkImageRecursiveGaussianComplex sums[2];
+    for (int j = 0; j < 4; j++)
+    {
+      vtkImageRecursiveGaussianComplex p = this->Poles[j];
+      vtkImageRecursiveGaussianComplex c = this->Weights[j];
+      vtkImageRecursiveGaussianComplex q = 1.0 - p;
+      if (this->Symmetry > 0)
+      {
+        sums[0] += c * (1.0 + p) / q;
+      }
+      sums[1] += c * (1.0 - this->Symmetry) * p / (q * q);
+    }
+    for (int k = 0; k < 2; k++)
+    {
+      moments[k] = sums[k].real();
+    }
+  }
+
+  void Scale(double s)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      this->Weights[j] *= s;
+    }
+  }
+};
+
+// The coefficients of the causal filter
+//   y[i] = N0 x[i] + ... + N4 x[i-4] - D0 y[i-1] - ... - D3 y[i-4]
+// and of the anticausal filter
+//   y[i] = M0 x[i+1] + ... + M3 x[i+4] - D0 y[i+1] - ... - D3 y[i+4]
+// whose sum is the convolution with the kernel.
+struct vtkImageRecursiveGaussianCoefficients
+{
+  double N[5];
+  double M[4];
+  double D[4];
+  // The outputs of both filters for a constant input of one.
+  double CausalGain;
+  double AntiCausalGain;
+
+  // Compute the coefficients for the gaussian (order 0) or its derivative
+  // (order 1) along an axis, where the output is multiplied by scale.
+  void Compute(int order, double sigma, double scale)
+  {
+    // Normalize the kernel so that the smoothing of a constant, or the
+    // derivative of a ramp, is exact.
+    vtkImageRecursiveGaussianKernel kernel(order, sigma);
+    double moments[2];
+    kernel.GetMoments(moments);
+    kernel.Scale(order == 0 ? scale / moments[0] : -scale / moments[1]);
+
+    // Expand the transfer functions, whose denominator is the product of
+    // (1 - p u) for the four poles p.
+    vtkImageRecursiveGaussianComplex d[5] = { 1.0, 0.0, 0.0, 0.0, 0.0 };
+    vtkImageRecursiveGaussianComplex n[5] = {};
+    vtkImageRecursiveGaussianComplex m[4] = {};
+    for (int j = 0; j < 4; j++)
+    {
+      for (int k = j + 1; k > 0; k--)
+      {
+        d[k] -= kernel.Poles[j] * d[k - 1];
+      }
+
+      vtkImageRecursiveGaussianComplex t[4] = { 1.0, 0.0, 0.0, 0.0 };
+      int degree = 0;
+      for (int k = 0; k < 4; k++)
+      {
+        if (k != j)
+        {
+          degree++;
+          for (int i = degree; i > 0; i--)
+          {
+            t[i] -= kernel.Poles[k] * t[i - 1];
+          }
+        }
+      }
+      for (int i = 0; i < 4; i++)
+      {
+        vtkImageRecursiveGaussianComplex shifted = kernel.Weights[j] * kernel.Poles[j] * t[i];
+        if (kernel.Symmetry > 0)
+        {
+          n[i] += kernel.Weights[j] * t[i];
+        }
+        else
+        {
+          n[i + 1] += shifted;
+        }
+        m[i] += kernel.Symmetry * shifted;
+      }
+    }
+
+    double sumN = 0.0;
+    double sumM = 0.0;
+    double sumD = 1.0;
+    for (int i = 0; i < 5; i++)
+    {
+      this->N[i] = n[i].real();
+      sumN += this->N[i];
+    }
+    for (int i = 0; i < 4; i++)
+    {
+      this->M[i] = m[i].real();
+      this->D[i] = d[i + 1].real();
+      sumM += this->M[i];
+      sumD += this->D[i];
+    }
+    this->CausalGain = sumN / sumD;
+    this->AntiCausalGain = sumM / sumD;
+  }
+};
+
+// Copies the input into the output, where it is filtered in place.
+template <class IT, class OT>
+struct vtkImageRecursiveGaussianCopy
+{
+  const IT* Input;
+  vtkIdType InIncrements[3];
+  int Dims[3];
+  int NumberOfComponents;
+  OT* Output;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType rowSize = static_cast<vtkIdType>(this->Dims[0]) * this->NumberOfComponents;
+    for (vtkIdType r = begin; r < end; ++r)
+    {
+      const IT* in = this->Input + (r % this->Dims[1]) * this->InIncrements[1] +
+        (r / this->Dims[1]) * this->InIncrements[2];
+      OT* out = this->Output + r * rowSize;
+      for (vtkIdType i = 0; i < rowSize; ++i)
+      {
+        out[i] = static_cast<OT>(in[i]);
+      }
+    }
+  }
+};
+
+// Filters the lines along one axis, in blocks of neighboring lines. The
+// samples of a block are interleaved, so that each step of the recursions
+// is done for all the lines of the block at once.
+template <class OT>
+struct vtkImageRecursiveGaussianAxis
+{
+  OT* Data;
+  int N;
+  vtkIdType Stride;
+  // How the index of a line gives the position of its first sample.
+  vtkIdType LineModulo;
+  vtkIdType LineStride;
+  vtkIdType NumberOfLines;
+  vtkImageRecursiveGaussianCoefficients Coefficients;
+  // The input, causal and anticausal samples, with four samples of padding
+  // at both ends.
+  vtkSMPThreadLocal<std::vector<double> > Buffers;
+
+  void Initialize()
+  {
+    this->Buffers.Local().resize(3 * (this->N + 8) * vtkImageRecursiveGaussianLanes);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const int L = vtkImageRecursiveGaussianLanes;
+    const int n = this->N;
+    const vtkImageRecursiveGaussianCoefficients& c = this->Coefficients;
+    std::vector<double>& buffer = this->Buffers.Local();
+    double* x = buffer.data();
+    double* yc = x + (n + 8) * L;
+    double* ya = yc + (n + 8) * L;
+
+    for (vtkIdType block = begin; block < end; ++block)
+    {
+      vtkIdType firstLine = block * L;
+      int count = static_cast<int>(std::min<vtkIdType>(L, this->NumberOfLines - firstLine));
+      OT* lines[L];
+      for (int k = 0; k < count; ++k)
+      {
+        vtkIdType l = firstLine + k;
+        lines[k] = this->Data + (l % this->LineModulo) + (l / this->LineModulo) * this->LineStride;
+      }
+
+      // Gather the lines, and repeat the boundary samples in the padding.
+      for (int i = 0; i < n; ++i)
+      {
+        double* xi = x + (i + 4) * L;
+        for (int k = 0; k < count; ++k)
+        {
+          xi[k] = static_cast<double>(lines[k][i * this->Stride]);
+        }
+        for (int k = count; k < L; ++k)
+        {
+          xi[k] = 0.0;
+        }
+      }
+      for (int i = 0; i < 4; ++i)
+      {
+        for (int k = 0; k < L; ++k)
+        {
+          x[i * L + k] = x[4 * L + k];
+          x[(n + 4 + i) * L + k] = x[(n + 3) * L + k];
+          yc[i * L + k] = c.CausalGain * x[4 * L + k];
+          ya[(n + 4 + i) * L + k] = c.AntiCausalGain * x[(n + 3) * L + k];
+        }
+      }
+
+      for (int i = 4; i < n + 4; ++i)
+      {
+        const double* xi = x + i * L;
+        double* yi = yc + i * L;
+        for (int k = 0; k < L; ++k)
+        {
+          yi[k] = c.N[0] * xi[k] + c.N[1] * xi[k - L] + c.N[2] * xi[k - 2 * L] +
+            c.N[3] * xi[k - 3 * L] + c.N[4] * xi[k - 4 * L] - c.D[0] * yi[k - L] -
+            c.D[1] * yi[k - 2 * L] - c.D[2] * yi[k - 3 * L] - c.D[3] * yi[k - 4 * L];
+        }
+      }
+      for (int i = n + 3; i >= 4; --i)
+      {
+        const double* xi = x + i * L;
+        double* yi = ya + i * L;
+        for (int k = 0; k < L; ++k)
+        {
+          yi[k] = c.M[0] * xi[k + L] + c.M[1] * xi[k + 2 * L] + c.M[2] * xi[k + 3 * L] +
+            c.M[3] * xi[k + 4 * L] - c.D[0] * yi[k + L] - c.D[1] * yi[k + 2 * L] -
+            c.D[2] * yi[k + 3 * L] - c.D[3] * yi[k + 4 * L];
+        }
+      }
+
+      for (int i = 0; i < n; ++i)
+      {
+        const double* yci = yc + (i + 4) * L;
+        const double* yai = ya + (i + 4) * L;
+        for (int k = 0; k < count; ++k)
+        {
+          lines[k][i * this->Stride] = static_cast<OT>(yci[k] + yai[k]);
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+template <class IT, class OT>
+void vtkImageRecursiveGaussianExecute(vtkImageRecursiveGaussian* self, vtkImageData* inData,
+  const IT* inPtr, vtkImageData* outData, OT* outPtr)
+{
+  int dims[3];
+  double spacing[3];
+  outData->GetDimensions(dims);
+  inData->GetSpacing(spacing);
+  const int numComp = outData->GetNumberOfScalarComponents();
+
+  vtkImageRecursiveGaussianCopy<IT, OT> copy;
+  copy.Input = inPtr;
+  inData->GetIncrements(copy.InIncrements);
+  copy.Dims[0] = dims[0];
+  copy.Dims[1] = dims[1];
+  copy.Dims[2] = dims[2];
+  copy.NumberOfComponents = numComp;
+  copy.Output = outPtr;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dims[1]) * dims[2], copy);
+
+  // The components are treated as an extra axis, before the X axis.
+  const vtkIdType strides[3] = { numComp, static_cast<vtkIdType>(numComp) * dims[0],
+    static_cast<vtkIdType>(numComp) * dims[0] * dims[1] };
+  const vtkIdType size = strides[2] * dims[2];
+  const double* sigmas = self->GetStandardDeviations();
+  const int* orders = self->GetDerivativeOrders();
+  int dimensionality = self->GetDimensionality();
+  for (int axis = 0; axis < dimensionality && !self->GetAbortExecute(); ++axis)
+  {
+    if (sigmas[axis] <= 0)
+    {
+      continue;
+    }
+    int order = std::min(std::max(orders[axis], 0), 2);
+    double scale = (self->GetNormalizeAcrossScale() ? std::pow(sigmas[axis], order)
+                                                    : std::pow(spacing[axis], -order));
+
+    // The second derivative for a standard deviation s is the first
+    // derivative for s/sqrt(2), applied twice.
+    for (int pass = 0; pass < std::max(order, 1); ++pass)
+    {
+      vtkImageRecursiveGaussianAxis<OT> filter;
+      filter.Data = outPtr;
+      filter.N = dims[axis];
+      filter.Stride = strides[axis];
+      filter.LineModulo = strides[axis];
+      filter.LineStride = strides[axis] * dims[axis];
+      filter.NumberOfLines = size / dims[axis];
+      if (order == 2)
+      {
+        filter.Coefficients.Compute(1, sigmas[axis] / std::sqrt(2.0), pass == 0 ? scale : 1.0);
+      }
+      else
+      {
+        filter.Coefficients.Compute(order, sigmas[axis], scale);
+      }
+      vtkIdType numberOfBlocks = (filter.NumberOfLines + vtkImageRecursiveGaussianLanes - 1) /
+        vtkImageRecursiveGaussianLanes;
+      vtkSMPTools::For(0, numberOfBlocks, filter);
+    }
+    self->UpdateProgress((axis + 1.0) / dimensionality);
+  }
+}
+
+template <class IT>
+void vtkImageRecursiveGaussianDispatch(
+  vtkImageRecursiveGaussian* self, vtkImageData* inData, const IT* inPtr, vtkImageData* outData)
+{
+  void* outPtr = outData->GetScalarPointer();
+  if (outData->GetScalarType() == VTK_DOUBLE)
+  {
+    vtkImageRecursiveGaussianExecute(self, inData, inPtr, outData, static_cast<double*>(outPtr));
+  }
+  else
+  {
+    vtkImageRecursiveGaussianExecute(self, inData, inPtr, outData, static_cast<float*>(outPtr));
+  }
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkImageRecursiveGaussian::vtkImageRecursiveGaussian()
+{
+  this->StandardDeviations[0] = 2.0;
+  this->StandardDeviations[1] = 2.0;
+  this->StandardDeviations[2] = 2.0;
+  this->DerivativeOrders[0] = 0;
+  this->DerivativeOrders[1] = 0;
+  this->DerivativeOrders[2] = 0;
+  this->Dimensionality = 3;
+  this->NormalizeAcrossScale = 0;
+  this->OutputScalarType = VTK_FLOAT;
+}
+
+//----------------------------------------------------------------------------
+vtkImageRecursiveGaussian::~vtkImageRecursiveGaussian() = default;
+
+//----------------------------------------------------------------------------
+void vtkImageRecursiveGaussian::SetHessianComponent(int i, int j)
+{
+  int orders[3] = { 0, 0, 0 };
+  orders[std::min(std::max(i, 0), 2)]++;
+  orders[std::min(std::max(j, 0), 2)]++;
+  this->SetDerivativeOrders(orders);
+}
+
+//----------------------------------------------------------------------------
+int vtkImageRecursiveGaussian::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject::SetPointDataActiveScalarInfo(outInfo, this->OutputScalarType, -1);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// The whole input is needed along the filtered axes.
+int vtkImageRecursiveGaussian::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  int inExt[6];
+  int wholeExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  for (int axis = 0; axis < this->Dimensionality; ++axis)
+  {
+    inExt[2 * axis] = wholeExt[2 * axis];
+    inExt[2 * axis + 1] = wholeExt[2 * axis + 1];
+  }
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt, 6);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageRecursiveGaussian::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* inData = vtkImageData::GetData(inInfo);
+  vtkImageData* outData = vtkImageData::GetData(outInfo);
+
+  // The output is computed for the whole extent along the filtered axes.
+  int outExt[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  outData->SetExtent(outExt);
+  outData->AllocateScalars(this->OutputScalarType, inData->GetNumberOfScalarComponents());
+  if (outData->GetNumberOfPoints() == 0)
+  {
+    return 1;
+  }
+
+  void* inPtr = inData->GetScalarPointerForExtent(outExt);
+  if (!inPtr || inData->GetNumberOfScalarComponents() < 1)
+  {
+    vtkErrorMacro("No input scalars to filter.");
+    return 0;
+  }
+
+  this->UpdateProgress(0.0);
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkImageRecursiveGaussianDispatch(
+      this, inData, static_cast<const VTK_TT*>(inPtr), outData));
+    default:
+      vtkErrorMacro("Execute: Unknown ScalarType");
+      return 0;
+  }
+  this->UpdateProgress(1.0);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageRecursiveGaussian::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "StandardDeviations: (" << this->StandardDeviations[0] << ", "
+     << this->StandardDeviations[1] << ", " << this->StandardDeviations[2] << ")\n";
+  os << indent << "DerivativeOrders: (" << this->DerivativeOrders[0] << ", "
+     << this->DerivativeOrders[1] << ", " << this->DerivativeOrders[2] << ")\n";
+  os << indent << "Dimensionality: " << this->Dimensionality << "\n";
+  os << indent << "NormalizeAcrossScale: " << (this->NormalizeAcrossScale ? "On\n" : "Off\n");
+  os << indent << "OutputScalarType: " << vtkImageScalarTypeNameMacro(this->OutputScalarType)
+     << "\n";
+}
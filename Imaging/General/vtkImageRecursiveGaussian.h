@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageRecursiveGaussian.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageRecursiveGaussian
+ * @brief   Gaussian smoothing and derivatives with recursive filters.
+ *
+ * vtkImageRecursiveGaussian convolves the input with a gaussian, or with
+ * one of its first or second derivatives along each axis, so that it can
+ * compute smoothed images, gradient components and Hessian components.
+ *
+ * Unlike vtkImageGaussianSmooth, which convolves with a truncated kernel,
+ * each axis is filtered with the fourth order recursive filters of Deriche,
+ * which run forward and backward along each line. Their cost per voxel does
+ * not depend on the standard deviation, which makes large standard
+ * deviations, for instance for multiscale vesselness or blob detection,
+ * as fast as small ones. Second derivatives take two passes along their
+ * axis. The approximation is accurate for standard deviations of about 1.5
+ * voxels and more. Outside of the input, the values of the boundary voxels
+ * are repeated.
+ *
+ * Blocks of neighboring lines are filtered together, so that the
+ * recursions are vectorized across lines, and the blocks are processed in
+ * parallel. The whole extent of the input along the filtered axes is needed
+ * to compute the output. Each component of the input is filtered
+ * separately.
+ *
+ * @sa
+ * vtkImageGaussianSmooth vtkImageGradient vtkImageSeparableConvolution
+ */
+
+#ifndef vtkImageRecursiveGaussian_h
+#define vtkImageRecursiveGaussian_h
+
+#include "vtkImageAlgorithm.h"
+#include "vtkImagingGeneralModule.h" // For export macro
+
+class VTKIMAGINGGENERAL_EXPORT vtkImageRecursiveGaussian : public vtkImageAlgorithm
+{
+public:
+  static vtkImageRecursiveGaussian* New();
+  vtkTypeMacro(vtkImageRecursiveGaussian, vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the standard deviations of the gaussian in voxels, as for
+   * vtkImageGaussianSmooth. Axes with a standard deviation of zero are not
+   * filtered. The default is 2 along each axis.
+   */
+  vtkSetVector3Macro(StandardDeviations, double);
+  void SetStandardDeviation(double s) { this->SetStandardDeviations(s, s, s); }
+  vtkGetVector3Macro(StandardDeviations, double);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the order of the derivative along each axis: 0 for smoothing,
+   * 1 for the first derivative and 2 for the second derivative. Larger
+   * orders are treated as 2. Derivatives are taken with respect to world
+   * coordinates, using the spacing of the input. The default is 0 along
+   * each axis.
+   */
+  vtkSetVector3Macro(DerivativeOrders, int);
+  vtkGetVector3Macro(DerivativeOrders, int);
+  //@}
+
+  /**
+   * Set the derivative orders for the component (i, j) of the Hessian
+   * matrix, where i and j are axes between 0 and 2.
+   */
+  void SetHessianComponent(int i, int j);
+
+  //@{
+  /**
+   * Set/Get the number of axes that are filtered, starting with X. With a
+   * dimensionality of 2, the slices are filtered independently. The
+   * default is 3.
+   */
+  vtkSetClampMacro(Dimensionality, int, 1, 3);
+  vtkGetMacro(Dimensionality, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether derivatives are multiplied by the standard deviation in
+   * world units to the power of the order of the derivative, so that
+   * responses can be compared across scales. The default is off.
+   */
+  vtkSetMacro(NormalizeAcrossScale, vtkTypeBool);
+  vtkGetMacro(NormalizeAcrossScale, vtkTypeBool);
+  vtkBooleanMacro(NormalizeAcrossScale, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the scalar type of the output, either VTK_FLOAT (the default)
+   * or VTK_DOUBLE. The computations are always done in double precision.
+   */
+  vtkSetClampMacro(OutputScalarType, int, VTK_FLOAT, VTK_DOUBLE);
+  vtkGetMacro(OutputScalarType, int);
+  void SetOutputScalarTypeToFloat() { this->SetOutputScalarType(VTK_FLOAT); }
+  void SetOutputScalarTypeToDouble() { this->SetOutputScalarType(VTK_DOUBLE); }
+  //@}
+
+protected:
+  vtkImageRecursiveGaussian();
+  ~vtkImageRecursiveGaussian() override;
+
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  double StandardDeviations[3];
+  int DerivativeOrders[3];
+  int Dimensionality;
+  vtkTypeBool NormalizeAcrossScale;
+  int OutputScalarType;
+
+private:
+  vtkImageRecursiveGaussian(const vtkImageRecursiveGaussian&) = delete;
+  void operator=(const vtkImageRecursiveGaussian&) = delete;
+};
+
+#endif
@@ -0,0 +1,161 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageConnectivityFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the parallel labeling of vtkImageConnectivityFilter gives the
+// same output as the serial flood fill.
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageConnectivityFilter.h"
+#include "vtkImageData.h"
+#include "vtkImageNoiseSource.h"
+#include "vtkImageThreshold.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+
+// Random blobs, with a fixed seed so that the test is repeatable.
+vtkSmartPointer<vtkImageData> MakeImage(int nx, int ny, int nz, int percent)
+{
+  vtkMath::RandomSeed(12345);
+  vtkNew<vtkImageNoiseSource> noise;
+  noise->SetWholeExtent(-3, nx - 4, 0, ny - 1, 5, nz + 4);
+  noise->SetMinimum(0.0);
+  noise->SetMaximum(100.0);
+
+  vtkNew<vtkImageThreshold> threshold;
+  threshold->SetInputConnection(noise->GetOutputPort());
+  threshold->ThresholdByLower(percent);
+  threshold->SetInValue(1);
+  threshold->SetOutValue(0);
+  threshold->SetOutputScalarTypeToUnsignedChar();
+  threshold->Update();
+  return threshold->GetOutput();
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool Compare(vtkImageData* image, vtkPolyData* seeds, int connectivity, int labelMode,
+  int extractionMode, int scalarType, vtkIdType minSize, bool extents)
+{
+  vtkNew<vtkImageConnectivityFilter> filter[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    filter[i]->SetInputData(image);
+    if (seeds)
+    {
+      filter[i]->SetSeedData(seeds);
+    }
+    filter[i]->SetScalarRange(1, 255);
+    filter[i]->SetConnectivity(connectivity);
+    filter[i]->SetLabelMode(labelMode);
+    filter[i]->SetExtractionMode(extractionMode);
+    filter[i]->SetLabelScalarType(scalarType);
+    filter[i]->SetSizeRange(minSize, VTK_ID_MAX);
+    filter[i]->SetGenerateRegionExtents(extents);
+    filter[i]->SetParallelLabeling(i);
+    filter[i]->Update();
+  }
+
+  vtkImageConnectivityFilter* serial = filter[0];
+  vtkImageConnectivityFilter* parallel = filter[1];
+  if (!SameArrays(serial->GetOutput()->GetPointData()->GetScalars(),
+        parallel->GetOutput()->GetPointData()->GetScalars()) ||
+    !SameArrays(serial->GetExtractedRegionLabels(), parallel->GetExtractedRegionLabels()) ||
+    !SameArrays(serial->GetExtractedRegionSizes(), parallel->GetExtractedRegionSizes()) ||
+    !SameArrays(serial->GetExtractedRegionSeedIds(), parallel->GetExtractedRegionSeedIds()) ||
+    !SameArrays(serial->GetExtractedRegionExtents(), parallel->GetExtractedRegionExtents()))
+  {
+    cerr << "Parallel labeling differs for connectivity " << connectivity << ", "
+         << serial->GetLabelModeAsString() << ", " << serial->GetExtractionModeAsString()
+         << ", " << serial->GetLabelScalarTypeAsString() << ", seeds " << (seeds != nullptr)
+         << ", size " << minSize << ", extents " << extents << endl;
+    return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int TestImageConnectivityFilterParallel(int, char*[])
+{
+  vtkSmartPointer<vtkImageData> volume = MakeImage(37, 29, 23, 35);
+  vtkSmartPointer<vtkImageData> slice = MakeImage(101, 67, 1, 45);
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIntArray> scalars;
+  for (int i = 0; i < 40; ++i)
+  {
+    points->InsertNextPoint(-3 + (i * 7) % 37, (i * 5) % 29, 5 + (i * 3) % 23);
+    scalars->InsertNextValue(i % 5);
+  }
+  vtkNew<vtkPolyData> seeds;
+  seeds->SetPoints(points);
+  seeds->GetPointData()->SetScalars(scalars);
+
+  const int connectivities[] = { 6, 18, 26 };
+  bool valid = true;
+  for (int c = 0; c < 3; ++c)
+  {
+    int connectivity = connectivities[c];
+    for (int image = 0; image < 2; ++image)
+    {
+      vtkImageData* data = (image == 0 ? volume.Get() : slice.Get());
+      valid &= Compare(data, nullptr, connectivity, vtkImageConnectivityFilter::SizeRank,
+        vtkImageConnectivityFilter::AllRegions, VTK_INT, 1, true);
+      valid &= Compare(data, nullptr, connectivity, vtkImageConnectivityFilter::SeedScalar,
+        vtkImageConnectivityFilter::AllRegions, VTK_UNSIGNED_SHORT, 3, false);
+      valid &= Compare(data, nullptr, connectivity, vtkImageConnectivityFilter::SizeRank,
+        vtkImageConnectivityFilter::LargestRegion, VTK_SHORT, 1, true);
+      // too many regions for the labels, so that regions are pruned
+      valid &= Compare(data, nullptr, connectivity, vtkImageConnectivityFilter::SizeRank,
+        vtkImageConnectivityFilter::AllRegions, VTK_UNSIGNED_CHAR, 1, false);
+      valid &= Compare(data, nullptr, connectivity, vtkImageConnectivityFilter::SeedScalar,
+        vtkImageConnectivityFilter::LargestRegion, VTK_UNSIGNED_CHAR, 2, true);
+    }
+    valid &= Compare(volume, seeds, connectivity, vtkImageConnectivityFilter::SeedScalar,
+      vtkImageConnectivityFilter::SeededRegions, VTK_UNSIGNED_CHAR, 1, true);
+    valid &= Compare(volume, seeds, connectivity, vtkImageConnectivityFilter::SizeRank,
+      vtkImageConnectivityFilter::AllRegions, VTK_UNSIGNED_CHAR, 1, false);
+    valid &= Compare(volume, seeds, connectivity, vtkImageConnectivityFilter::ConstantValue,
+      vtkImageConnectivityFilter::LargestRegion, VTK_SHORT, 2, true);
+  }
+
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,385 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMorphology3D.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests vtkImageMorphology3D against a maximum or a minimum over every
+// voxel of the kernel, for grayscale and binary images, and checks that the
+// ball is close to the ellipsoid of vtkImageContinuousDilate3D.
+
+#include "vtkImageAppendComponents.h"
+#include "vtkImageCast.h"
+#include "vtkImageContinuousDilate3D.h"
+#include "vtkImageData.h"
+#include "vtkImageMorphology3D.h"
+#include "vtkImageNoiseSource.h"
+#include "vtkImageThreshold.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+// Random values, with a fixed seed so that the test is repeatable.
+vtkSmartPointer<vtkImageData> MakeImage(int scalarType, int components, bool binary)
+{
+  vtkMath::RandomSeed(1234);
+  vtkNew<vtkImageAppendComponents> append;
+  for (int c = 0; c < components; c++)
+  {
+    vtkNew<vtkImageNoiseSource> noise;
+    noise->SetWholeExtent(-3, 14, 2, 16, 0, 8);
+    noise->SetMinimum(0.0);
+    noise->SetMaximum(64.0);
+    append->AddInputConnection(noise->GetOutputPort());
+  }
+
+  vtkSmartPointer<vtkImageData> image;
+  if (binary)
+  {
+    // a sparse foreground
+    vtkNew<vtkImageThreshold> threshold;
+    threshold->SetInputConnection(append->GetOutputPort());
+    threshold->ThresholdByLower(6.0);
+    threshold->SetInValue(100);
+    threshold->SetOutValue(0);
+    threshold->SetOutputScalarType(scalarType);
+    threshold->Update();
+    image = threshold->GetOutput();
+  }
+  else
+  {
+    vtkNew<vtkImageCast> cast;
+    cast->SetInputConnection(append->GetOutputPort());
+    cast->SetOutputScalarType(scalarType);
+    cast->Update();
+    image = cast->GetOutput();
+  }
+  return image;
+}
+
+// The offsets of the voxels of a box, as for vtkImageContinuousDilate3D.
+std::vector<int> BoxOffsets(const int kernelSize[3], bool reflect)
+{
+  std::vector<int> offsets;
+  for (int k = 0; k < kernelSize[2]; k++)
+  {
+    for (int j = 0; j < kernelSize[1]; j++)
+    {
+      for (int i = 0; i < kernelSize[0]; i++)
+      {
+        int o[3] = { i - kernelSize[0] / 2, j - kernelSize[1] / 2, k - kernelSize[2] / 2 };
+        for (int a = 0; a < 3; a++)
+        {
+          offsets.push_back(reflect ? -o[a] : o[a]);
+        }
+      }
+    }
+  }
+  return offsets;
+}
+
+// The maximum or the minimum over the offsets, clipped at the boundaries.
+vtkSmartPointer<vtkImageData> BruteForce(
+  vtkImageData* image, const std::vector<int>& offsets, bool maximum)
+{
+  vtkSmartPointer<vtkImageData> output = vtkSmartPointer<vtkImageData>::New();
+  output->CopyStructure(image);
+  output->AllocateScalars(image->GetScalarType(), image->GetNumberOfScalarComponents());
+  int* ext = image->GetExtent();
+  for (int z = ext[4]; z <= ext[5]; z++)
+  {
+    for (int y = ext[2]; y <= ext[3]; y++)
+    {
+      for (int x = ext[0]; x <= ext[1]; x++)
+      {
+        for (int c = 0; c < image->GetNumberOfScalarComponents(); c++)
+        {
+          double result = (maximum ? -VTK_DOUBLE_MAX : VTK_DOUBLE_MAX);
+          for (size_t o = 0; o < offsets.size(); o += 3)
+          {
+            int p[3] = { x + offsets[o], y + offsets[o + 1], z + offsets[o + 2] };
+            if (p[0] >= ext[0] && p[0] <= ext[1] && p[1] >= ext[2] && p[1] <= ext[3] &&
+              p[2] >= ext[4] && p[2] <= ext[5])
+            {
+              double value = image->GetScalarComponentAsDouble(p[0], p[1], p[2], c);
+              result = (maximum ? std::max(result, value) : std::min(result, value));
+            }
+          }
+          output->SetScalarComponentFromDouble(x, y, z, c, result);
+        }
+      }
+    }
+  }
+  return output;
+}
+
+vtkSmartPointer<vtkImageData> Expected(vtkImageData* image, int operation,
+  const std::vector<int>& offsets, const std::vector<int>& reflected)
+{
+  switch (operation)
+  {
+    case vtkImageMorphology3D::Dilate:
+      return BruteForce(image, offsets, true);
+    case vtkImageMorphology3D::Erode:
+      return BruteForce(image, offsets, false);
+    case vtkImageMorphology3D::Open:
+      return BruteForce(BruteForce(image, offsets, false), reflected, true);
+  }
+  return BruteForce(BruteForce(image, offsets, true), reflected, false);
+}
+
+bool Compare(vtkImageMorphology3D* filter, vtkImageData* output, vtkImageData* expected)
+{
+  int* ext = output->GetExtent();
+  for (int z = ext[4]; z <= ext[5]; z++)
+  {
+    for (int y = ext[2]; y <= ext[3]; y++)
+    {
+      for (int x = ext[0]; x <= ext[1]; x++)
+      {
+        for (int c = 0; c < output->GetNumberOfScalarComponents(); c++)
+        {
+          double value = output->GetScalarComponentAsDouble(x, y, z, c);
+          double e = expected->GetScalarComponentAsDouble(x, y, z, c);
+          if (value != e)
+          {
+            int* size = filter->GetKernelSize();
+            cerr << filter->GetOperationAsString() << " of " << output->GetScalarTypeAsString()
+                 << " with " << filter->GetKernelShapeAsString() << " " << size[0] << "x"
+                 << size[1] << "x" << size[2] << " at (" << x << ", " << y << ", " << z << ", "
+                 << c << ") is " << value << " instead of " << e << endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool CheckBox(vtkImageData* image, const int kernelSize[3], int operation)
+{
+  vtkNew<vtkImageMorphology3D> filter;
+  filter->SetInputData(image);
+  filter->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+  filter->SetOperation(operation);
+  filter->Update();
+  vtkSmartPointer<vtkImageData> expected =
+    Expected(image, operation, BoxOffsets(kernelSize, false), BoxOffsets(kernelSize, true));
+  return Compare(filter, filter->GetOutput(), expected);
+}
+
+// The offsets of the ball, from the dilation of an impulse. A third value
+// far from the impulse makes the image grayscale.
+std::vector<int> BallOffsets(const int kernelSize[3], bool grayscale)
+{
+  vtkNew<vtkImageData> impulse;
+  impulse->SetExtent(0, 40, 0, 40, 0, 40);
+  impulse->AllocateScalars(VTK_SHORT, 1);
+  std::fill_n(static_cast<short*>(impulse->GetScalarPointer()), impulse->GetNumberOfPoints(), 0);
+  impulse->SetScalarComponentFromDouble(20, 20, 20, 0, 2);
+  if (grayscale)
+  {
+    impulse->SetScalarComponentFromDouble(0, 0, 0, 0, 1);
+  }
+
+  vtkNew<vtkImageMorphology3D> filter;
+  filter->SetInputData(impulse);
+  filter->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+  filter->SetKernelShapeToBall();
+  filter->Update();
+
+  std::vector<int> offsets;
+  for (int z = 0; z <= 40; z++)
+  {
+    for (int y = 0; y <= 40; y++)
+    {
+      for (int x = 0; x <= 40; x++)
+      {
+        if (filter->GetOutput()->GetScalarComponentAsDouble(x, y, z, 0) == 2)
+        {
+          offsets.push_back(20 - x);
+          offsets.push_back(20 - y);
+          offsets.push_back(20 - z);
+        }
+      }
+    }
+  }
+  return offsets;
+}
+
+// The ball must not depend on whether the image is binary, must have the
+// exact size along the axes, and must be close to the ellipsoid used by
+// vtkImageContinuousDilate3D.
+bool CheckBallShape(const int kernelSize[3], double tolerance)
+{
+  std::vector<int> offsets = BallOffsets(kernelSize, false);
+  if (offsets != BallOffsets(kernelSize, true))
+  {
+    cerr << "The binary and grayscale balls differ." << endl;
+    return false;
+  }
+
+  vtkNew<vtkImageData> impulse;
+  impulse->SetExtent(-20, 20, -20, 20, -20, 20);
+  impulse->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  std::fill_n(
+    static_cast<unsigned char*>(impulse->GetScalarPointer()), impulse->GetNumberOfPoints(), 0);
+  impulse->SetScalarComponentFromDouble(0, 0, 0, 0, 1);
+  vtkNew<vtkImageContinuousDilate3D> dilate;
+  dilate->SetInputData(impulse);
+  dilate->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+  dilate->Update();
+
+  int count = 0;
+  int mismatches = 0;
+  int extent[6] = { 0, 0, 0, 0, 0, 0 };
+  for (size_t o = 0; o < offsets.size(); o += 3)
+  {
+    for (int a = 0; a < 3; a++)
+    {
+      extent[2 * a] = std::min(extent[2 * a], offsets[o + a]);
+      extent[2 * a + 1] = std::max(extent[2 * a + 1], offsets[o + a]);
+    }
+    vtkImageData* ellipsoid = dilate->GetOutput();
+    mismatches +=
+      (ellipsoid->GetScalarComponentAsDouble(offsets[o], offsets[o + 1], offsets[o + 2], 0) == 0);
+  }
+  for (int z = -20; z <= 20; z++)
+  {
+    for (int y = -20; y <= 20; y++)
+    {
+      for (int x = -20; x <= 20; x++)
+      {
+        count += (dilate->GetOutput()->GetScalarComponentAsDouble(x, y, z, 0) != 0);
+      }
+    }
+  }
+  // the voxels of the ellipsoid that are not in the ball
+  mismatches += count - static_cast<int>(offsets.size() / 3 - mismatches);
+
+  for (int a = 0; a < 3; a++)
+  {
+    if (extent[2 * a + 1] - extent[2 * a] + 1 != kernelSize[a] ||
+      extent[2 * a] != -kernelSize[a] / 2)
+    {
+      cerr << "The ball for kernel size " << kernelSize[0] << "x" << kernelSize[1] << "x"
+           << kernelSize[2] << " has the extent (" << extent[2 * a] << ", "
+           << extent[2 * a + 1] << ") along axis " << a << endl;
+      return false;
+    }
+  }
+  if (mismatches > tolerance * count)
+  {
+    cerr << "The ball for kernel size " << kernelSize[0] << "x" << kernelSize[1] << "x"
+         << kernelSize[2] << " differs from the ellipsoid at " << mismatches << " of " << count
+         << " voxels." << endl;
+    return false;
+  }
+  return true;
+}
+
+bool CheckBall(vtkImageData* image, const int kernelSize[3], int operation)
+{
+  vtkNew<vtkImageMorphology3D> filter;
+  filter->SetInputData(image);
+  filter->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+  filter->SetKernelShapeToBall();
+  filter->SetOperation(operation);
+  filter->Update();
+
+  std::vector<int> offsets = BallOffsets(kernelSize, false);
+  std::vector<int> reflected(offsets.size());
+  std::transform(offsets.begin(), offsets.end(), reflected.begin(), [](int o) { return -o; });
+  vtkSmartPointer<vtkImageData> expected = Expected(image, operation, offsets, reflected);
+  return Compare(filter, filter->GetOutput(), expected);
+}
+
+// A piece of the output must be the same as when the whole image is
+// computed.
+bool CheckStreaming(vtkImageData* image)
+{
+  vtkNew<vtkImageMorphology3D> filter;
+  filter->SetInputData(image);
+  filter->SetKernelSize(5, 4, 3);
+  filter->SetKernelShapeToBall();
+  filter->SetOperationToClose();
+  filter->Update();
+
+  vtkNew<vtkImageMorphology3D> streamed;
+  streamed->SetInputData(image);
+  streamed->SetKernelSize(5, 4, 3);
+  streamed->SetKernelShapeToBall();
+  streamed->SetOperationToClose();
+  int extent[6] = { 2, 6, 7, 9, 3, 4 };
+  streamed->UpdateExtent(extent);
+
+  int* ext = streamed->GetOutput()->GetExtent();
+  if (!std::equal(extent, extent + 6, ext))
+  {
+    cerr << "The streamed output has the wrong extent." << endl;
+    return false;
+  }
+  return Compare(streamed, streamed->GetOutput(), filter->GetOutput());
+}
+
+} // anonymous namespace
+
+int TestImageMorphology3D(int, char*[])
+{
+  // grayscale images, and a binary image that uses runs
+  vtkSmartPointer<vtkImageData> images[4] = {
+    MakeImage(VTK_UNSIGNED_CHAR, 1, false),
+    MakeImage(VTK_SHORT, 2, false),
+    MakeImage(VTK_FLOAT, 1, false),
+    MakeImage(VTK_UNSIGNED_CHAR, 1, true),
+  };
+
+  // odd and even sizes, and a 2D kernel
+  const int kernelSizes[3][3] = { { 3, 3, 3 }, { 4, 5, 2 }, { 7, 1, 5 } };
+  const int ballSizes[3][3] = { { 9, 9, 9 }, { 6, 7, 1 }, { 9, 11, 7 } };
+
+  bool valid = true;
+  for (auto& image : images)
+  {
+    for (int operation = vtkImageMorphology3D::Dilate; operation <= vtkImageMorphology3D::Close;
+         operation++)
+    {
+      for (auto kernelSize : kernelSizes)
+      {
+        valid &= CheckBox(image, kernelSize, operation);
+      }
+      for (auto ballSize : ballSizes)
+      {
+        valid &= CheckBall(image, ballSize, operation);
+      }
+    }
+    valid &= CheckStreaming(image);
+  }
+
+  // the approximation is coarse for small radii, and the kernel with unequal
+  // sizes is a rounded box, so only its size is checked
+  const int shapeSizes[4][3] = { { 13, 13, 13 }, { 21, 21, 21 }, { 17, 17, 1 }, { 9, 11, 7 } };
+  const double tolerances[4] = { 0.15, 0.1, 0.15, 1.0 };
+  for (int i = 0; i < 4; i++)
+  {
+    valid &= CheckBallShape(shapeSizes[i], tolerances[i]);
+  }
+
+  return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
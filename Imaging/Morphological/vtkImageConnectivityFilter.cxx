@@ -56,6 +56,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkIdTypeArray.h"
+#include "vtkSMPTools.h"
 #include "vtkIntArray.h"
 #include "vtkImageStencilData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -93,6 +94,10 @@ vtkImageConnectivityFilter::vtkImageConnectivityFilter()
 
   this->GenerateRegionExtents = 0;
 
+  this->Connectivity = FaceConnectivity;
+
+  this->ParallelLabeling = 0;
+
   this->ExtractedRegionLabels = vtkIdTypeArray::New();
   this->ExtractedRegionSizes = vtkIdTypeArray::New();
   this->ExtractedRegionSeedIds = vtkIdTypeArray::New();
@@ -182,6 +187,31 @@ void vtkImageConnectivityFilter::SetSeedData(vtkDataSet *seeds)
   this->SetInputData(2, seeds);
 }
 
+//----------------------------------------------------------------------------
+void vtkImageConnectivityFilter::SetConnectivity(int connectivity)
+{
+  // The code paths test the connectivity against different thresholds,
+  // so only the three valid values are stored.
+  if (connectivity >= VertexConnectivity)
+  {
+    connectivity = VertexConnectivity;
+  }
+  else if (connectivity >= EdgeConnectivity)
+  {
+    connectivity = EdgeConnectivity;
+  }
+  else
+  {
+    connectivity = FaceConnectivity;
+  }
+
+  if (this->Connectivity != connectivity)
+  {
+    this->Connectivity = connectivity;
+    this->Modified();
+  }
+}
+
 //----------------------------------------------------------------------------
 const char *vtkImageConnectivityFilter::GetLabelScalarTypeAsString()
 {
@@ -288,12 +318,18 @@ protected:
     vtkImageData *outData, OT *outPtr, vtkImageStencilData *stencil,
     int extent[6], vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo);
 
+  // Remove the regions that aren't in the given range of sizes from the
+  // list of regions, and give the new index of each region in newlabels.
+  static void SelectBySize(
+    vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo,
+    std::vector<vtkIdType>& newlabels);
+
   // This is the function that grows a region from a seed.
   template<class OT>
   static vtkIdType Fill(
     OT *outPtr, vtkIdType outInc[3], int outLimits[6],
     unsigned char *maskPtr, int maxIdx[3], int fillExtent[6],
-    std::stack<vtkICF::Seed> &seedStack);
+    int connectivity, std::stack<vtkICF::Seed> &seedStack);
 
   // Add a region to the list of regions.
   template<class OT>
@@ -303,6 +339,14 @@ protected:
     vtkIdType voxelCount, vtkIdType regionId, int regionExtent[6],
     int extractionMode);
 
+  // Do what AddRegion does, but on the list of regions only.  The
+  // "members" hold the component for each region in the list.
+  static void AddRegionToList(
+    vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo,
+    std::vector<vtkIdType>& members, vtkIdType component, int maxLabel,
+    vtkIdType voxelCount, vtkIdType regionId, int regionExtent[6],
+    int extractionMode);
+
   // Fill the ExtractedRegionSizes and ExtractedRegionLabels arrays.
   static void GenerateRegionArrays(
     vtkImageConnectivityFilter *self, vtkICF::RegionVector& regionInfo,
@@ -346,6 +390,14 @@ protected:
     OT *outPtr, unsigned char *maskPtr, int extent[6],
     vtkICF::RegionVector& regionInfo);
 
+  // Execute method for the parallel labeling, with or without seeds.
+  // Returns false if the image is too large for the parallel labeling.
+  template <class OT>
+  static bool ParallelExecute(
+    vtkImageConnectivityFilter *self,
+    vtkImageData *outData, vtkDataSet *seedData,
+    OT *outPtr, unsigned char *maskPtr, int extent[6]);
+
 public:
   // Create a bit mask from the input
   template<class IT>
@@ -663,14 +715,13 @@ void vtkICF::PruneSmallestRegion(
 }
 
 //----------------------------------------------------------------------------
-template<class OT>
-void vtkICF::PruneBySize(
-  vtkImageData *outData, OT *outPtr, vtkImageStencilData *stencil,
-  int extent[6], vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo)
+void vtkICF::SelectBySize(
+  vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo,
+  std::vector<vtkIdType>& newlabels)
 {
   // find all the regions in the allowed size range
   size_t n = regionInfo.size();
-  std::vector<OT> newlabels(n);
+  newlabels.resize(n);
   newlabels[0] = 0;
   size_t m = 1;
   for (size_t i = 1; i < n; i++)
@@ -685,15 +736,27 @@ void vtkICF::PruneBySize(
         regionInfo[l] = regionInfo[i];
       }
     }
-    newlabels[i] = static_cast<OT>(l);
+    newlabels[i] = static_cast<vtkIdType>(l);
   }
 
+  // resize regionInfo
+  regionInfo.resize(m);
+}
+
+//----------------------------------------------------------------------------
+template<class OT>
+void vtkICF::PruneBySize(
+  vtkImageData *outData, OT *outPtr, vtkImageStencilData *stencil,
+  int extent[6], vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo)
+{
+  // find all the regions in the allowed size range
+  size_t n = regionInfo.size();
+  std::vector<vtkIdType> newlabels;
+  vtkICF::SelectBySize(sizeRange, regionInfo, newlabels);
+
   // were any regions outside of the range?
-  if (m < n)
+  if (regionInfo.size() < n)
   {
-    // resize regionInfo
-    regionInfo.resize(m);
-
     // clip the extent with the output extent
     int outExt[6];
     outData->GetExtent(outExt);
@@ -715,7 +778,7 @@ void vtkICF::PruneBySize(
           OT v = *outPtr;
           if (v != 0)
           {
-            *outPtr = newlabels[v];
+            *outPtr = static_cast<OT>(newlabels[v]);
           }
         }
       }
@@ -729,7 +792,7 @@ template<class OT>
 vtkIdType vtkICF::Fill(
   OT *outPtr, vtkIdType outInc[3], int outLimits[6],
   unsigned char *maskPtr, int maxIdx[3], int fillExtent[6],
-  std::stack<vtkICF::Seed> &seedStack)
+  int connectivity, std::stack<vtkICF::Seed> &seedStack)
 {
   vtkIdType counter = 0;
 
@@ -789,6 +852,35 @@ vtkIdType vtkICF::Fill(
       outPtr[outOffset] = static_cast<OT>(*seed);
     }
 
+    // push the neighbors that share only an edge or a vertex
+    if (connectivity > vtkImageConnectivityFilter::FaceConnectivity)
+    {
+      for (int dz = -1; dz <= 1; dz++)
+      {
+        for (int dy = -1; dy <= 1; dy++)
+        {
+          for (int dx = -1; dx <= 1; dx++)
+          {
+            int d = (dx != 0) + (dy != 0) + (dz != 0);
+            if (d < 2 ||
+                (d == 3 &&
+                 connectivity < vtkImageConnectivityFilter::VertexConnectivity))
+            {
+              continue;
+            }
+            vtkICF::Seed neighbor(seed[0] + dx, seed[1] + dy, seed[2] + dz,
+                                  *seed);
+            if (neighbor[0] >= 0 && neighbor[0] <= maxIdx[0] &&
+                neighbor[1] >= 0 && neighbor[1] <= maxIdx[1] &&
+                neighbor[2] >= 0 && neighbor[2] <= maxIdx[2])
+            {
+              seedStack.push(neighbor);
+            }
+          }
+        }
+      }
+    }
+
     // push the new seeds for the six neighbors, make sure offsets in X are
     // pushed last so that they will be popped first (we want to raster X,
     // Y, and Z in that order).
@@ -849,6 +941,51 @@ void vtkICF::AddRegion(
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkICF::AddRegionToList(
+  vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo,
+  std::vector<vtkIdType>& members, vtkIdType component, int maxLabel,
+  vtkIdType voxelCount, vtkIdType regionId, int regionExtent[6],
+  int extractionMode)
+{
+  regionInfo.push_back(vtkICF::Region(voxelCount, regionId, regionExtent));
+  members.push_back(component);
+  // prune the list exactly like AddRegion prunes the output image
+  if (regionInfo.size() > static_cast<size_t>(maxLabel))
+  {
+    std::vector<vtkIdType> newlabels;
+    vtkICF::SelectBySize(sizeRange, regionInfo, newlabels);
+    for (size_t i = 1; i < newlabels.size(); i++)
+    {
+      if (newlabels[i] != 0)
+      {
+        members[newlabels[i]] = members[i];
+      }
+    }
+    members.resize(regionInfo.size());
+
+    if (regionInfo.size() > static_cast<size_t>(maxLabel))
+    {
+      if (extractionMode == vtkImageConnectivityFilter::LargestRegion)
+      {
+        vtkICF::RegionVector::iterator largest = regionInfo.largest();
+        size_t t = std::distance(regionInfo.begin(), largest);
+        regionInfo[1] = *largest;
+        regionInfo.erase(regionInfo.begin()+2, regionInfo.end());
+        members[1] = members[t];
+        members.resize(2);
+      }
+      else
+      {
+        vtkICF::RegionVector::iterator smallest = regionInfo.smallest();
+        size_t t = std::distance(regionInfo.begin(), smallest);
+        regionInfo.erase(smallest);
+        members.erase(members.begin() + t);
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 // a functor to sort region indices by region size
 struct vtkICF::CompareSize
@@ -1237,7 +1374,7 @@ void vtkICF::SeededExecute(
     // find all voxels that are connected to the seed
     vtkIdType voxelCount = vtkICF::Fill(
       outPtr, outInc, outLimits, maskPtr, maxIdx,
-      fillExtent, seedStack);
+      fillExtent, self->GetConnectivity(), seedStack);
 
     if (voxelCount != 0)
     {
@@ -1317,7 +1454,7 @@ void vtkICF::SeedlessExecute(
         // find all voxels that are connected to the seed
         vtkIdType voxelCount = vtkICF::Fill(
           outPtr, outInc, outLimits, maskPtr, maxIdx,
-          fillExtent, seedStack);
+          fillExtent, self->GetConnectivity(), seedStack);
 
         if (voxelCount != 0)
         {
@@ -1342,6 +1479,617 @@ void vtkICF::SeedlessExecute(
   }
 }
 
+//----------------------------------------------------------------------------
+// The parallel labeling.  The image is cut into slabs along Z (along Y for
+// 2D images), and the voxels of each slab are labeled concurrently with a
+// union-find, which also gathers the size, extent and first voxel of each
+// region of the slab.  The regions that touch across the slab boundaries
+// are then merged, and the output is written in parallel.
+
+// The size, the extent, and the index of the first voxel of a region.
+struct vtkICFStatistics
+{
+  vtkIdType Size;
+  vtkIdType First;
+  int Extent[6];
+};
+
+// A range of slices that is labeled by a single thread.
+struct vtkICFSlab
+{
+  int Begin;
+  int End;
+  // the statistics for each label of the slab, starting at label 1
+  std::vector<vtkICFStatistics> Regions;
+  // pairs of labels that touch across the boundary with the previous slab
+  std::vector<std::pair<vtkTypeUInt32, vtkTypeUInt32> > Links;
+};
+
+// The state shared by the labeling functors.
+struct vtkICFLabeling
+{
+  const unsigned char *Mask;
+  vtkTypeUInt32 *Labels;
+  // the dimensions, with the slabs along the last axis
+  int Dims[3];
+  // the neighbors that come before a voxel in raster order
+  std::vector<int> Neighbors;
+  std::vector<vtkICFSlab> Slabs;
+
+  bool IsForeground(vtkIdType idx) const
+  {
+    return ((this->Mask[idx >> 3] >> (idx & 0x7)) & 1) == 0;
+  }
+};
+
+// Find the root label with path halving.
+inline vtkTypeUInt32 vtkICFFindRoot(
+  std::vector<vtkTypeUInt32>& parent, vtkTypeUInt32 label)
+{
+  while (parent[label] != label)
+  {
+    parent[label] = parent[parent[label]];
+    label = parent[label];
+  }
+  return label;
+}
+
+// Label the voxels of each slab, with labels that are consecutive within
+// the slab and ordered by the first voxel of each region.
+struct vtkICFLabelSlabs
+{
+  vtkICFLabeling *Labeling;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType s = begin; s < end; s++)
+    {
+      this->LabelSlab(this->Labeling->Slabs[s]);
+    }
+  }
+
+  void LabelSlab(vtkICFSlab& slab)
+  {
+    const vtkICFLabeling *L = this->Labeling;
+    vtkTypeUInt32 *labels = L->Labels;
+    const int nx = L->Dims[0];
+    const int ny = L->Dims[1];
+    const size_t nn = L->Neighbors.size() / 3;
+    std::vector<vtkIdType> offsets(nn);
+    for (size_t k = 0; k < nn; k++)
+    {
+      const int *d = &L->Neighbors[3*k];
+      offsets[k] = d[0] + static_cast<vtkIdType>(nx)*(d[1] + ny*d[2]);
+    }
+
+    // first pass: provisional labels, with the union of labels that meet
+    // (the root of each set of labels is its smallest label)
+    std::vector<vtkTypeUInt32> parent(1, 0);
+    vtkIdType idx = static_cast<vtkIdType>(slab.Begin)*nx*ny;
+    for (int z = slab.Begin; z < slab.End; z++)
+    {
+      for (int y = 0; y < ny; y++)
+      {
+        for (int x = 0; x < nx; x++, idx++)
+        {
+          if (!L->IsForeground(idx))
+          {
+            labels[idx] = 0;
+            continue;
+          }
+          vtkTypeUInt32 label = 0;
+          for (size_t k = 0; k < nn; k++)
+          {
+            const int *d = &L->Neighbors[3*k];
+            if (x + d[0] < 0 || x + d[0] >= nx || y + d[1] < 0 ||
+                y + d[1] >= ny || z + d[2] < slab.Begin)
+            {
+              continue;
+            }
+            vtkTypeUInt32 n = labels[idx + offsets[k]];
+            if (n == 0)
+            {
+              continue;
+            }
+            n = vtkICFFindRoot(parent, n);
+            if (label == 0)
+            {
+              label = n;
+            }
+            else if (n < label)
+            {
+              parent[label] = n;
+              label = n;
+            }
+            else if (n > label)
+            {
+              parent[n] = label;
+            }
+          }
+          if (label == 0)
+          {
+            label = static_cast<vtkTypeUInt32>(parent.size());
+            parent.push_back(label);
+          }
+          labels[idx] = label;
+        }
+      }
+    }
+
+    // number the roots consecutively, every label is greater than its root
+    std::vector<vtkTypeUInt32> compact(parent.size(), 0);
+    vtkTypeUInt32 count = 0;
+    for (size_t l = 1; l < parent.size(); l++)
+    {
+      vtkTypeUInt32 root = vtkICFFindRoot(parent, static_cast<vtkTypeUInt32>(l));
+      compact[l] = (root == l ? ++count : compact[root]);
+    }
+
+    // second pass: final labels and statistics
+    slab.Regions.assign(count + 1, vtkICFStatistics());
+    idx = static_cast<vtkIdType>(slab.Begin)*nx*ny;
+    for (int z = slab.Begin; z < slab.End; z++)
+    {
+      for (int y = 0; y < ny; y++)
+      {
+        for (int x = 0; x < nx; x++, idx++)
+        {
+          vtkTypeUInt32 label = labels[idx];
+          if (label == 0)
+          {
+            continue;
+          }
+          label = compact[label];
+          labels[idx] = label;
+          vtkICFStatistics& r = slab.Regions[label];
+          if (r.Size++ == 0)
+          {
+            r.First = idx;
+            r.Extent[0] = r.Extent[1] = x;
+            r.Extent[2] = r.Extent[3] = y;
+            r.Extent[4] = r.Extent[5] = z;
+          }
+          else
+          {
+            r.Extent[0] = (x < r.Extent[0] ? x : r.Extent[0]);
+            r.Extent[1] = (x > r.Extent[1] ? x : r.Extent[1]);
+            r.Extent[2] = (y < r.Extent[2] ? y : r.Extent[2]);
+            r.Extent[3] = (y > r.Extent[3] ? y : r.Extent[3]);
+            r.Extent[5] = z;
+          }
+        }
+      }
+    }
+  }
+};
+
+// Find the labels that touch across the boundary between each slab and
+// the previous slab.
+struct vtkICFLinkSlabs
+{
+  vtkICFLabeling *Labeling;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkICFLabeling *L = this->Labeling;
+    const vtkTypeUInt32 *labels = L->Labels;
+    const int nx = L->Dims[0];
+    const int ny = L->Dims[1];
+    const size_t nn = L->Neighbors.size() / 3;
+    for (vtkIdType s = (begin > 0 ? begin : 1); s < end; s++)
+    {
+      vtkICFSlab& slab = this->Labeling->Slabs[s];
+      slab.Links.clear();
+      vtkIdType idx = static_cast<vtkIdType>(slab.Begin)*nx*ny;
+      for (int y = 0; y < ny; y++)
+      {
+        for (int x = 0; x < nx; x++, idx++)
+        {
+          vtkTypeUInt32 label = labels[idx];
+          if (label == 0)
+          {
+            continue;
+          }
+          for (size_t k = 0; k < nn; k++)
+          {
+            const int *d = &L->Neighbors[3*k];
+            if (d[2] == 0 || x + d[0] < 0 || x + d[0] >= nx ||
+                y + d[1] < 0 || y + d[1] >= ny)
+            {
+              continue;
+            }
+            vtkTypeUInt32 n = labels[
+              idx + d[0] + static_cast<vtkIdType>(nx)*(d[1] - ny)];
+            if (n != 0 && (slab.Links.empty() ||
+                           slab.Links.back().first != label ||
+                           slab.Links.back().second != n))
+            {
+              slab.Links.push_back(std::make_pair(label, n));
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+// Write the output labels from the slab labels.
+template<class OT>
+struct vtkICFWriteLabels
+{
+  const vtkTypeUInt32 *Labels;
+  const OT *Values;
+  const vtkIdType *SliceOffsets;
+  vtkIdType SliceSize;
+  int Dims[3];
+  // the part of the output to write, relative to the labeled extent
+  int Extent[6];
+  OT *OutPtr;
+  vtkIdType OutInc[3];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int rows = this->Extent[3] - this->Extent[2] + 1;
+    for (vtkIdType r = begin; r < end; r++)
+    {
+      int y = static_cast<int>(r % rows);
+      int z = static_cast<int>(r / rows);
+      OT *outPtr = this->OutPtr + y*this->OutInc[1] + z*this->OutInc[2];
+      vtkIdType idx = this->Extent[0] +
+        static_cast<vtkIdType>(this->Dims[0])*(this->Extent[2] + y +
+        static_cast<vtkIdType>(this->Dims[1])*(this->Extent[4] + z));
+      const vtkTypeUInt32 *labels = this->Labels + idx;
+      const OT *values = this->Values + this->SliceOffsets[idx/this->SliceSize];
+      for (int x = this->Extent[0]; x <= this->Extent[1]; x++)
+      {
+        vtkTypeUInt32 label = *labels++;
+        *outPtr = (label != 0 ? values[label] : 0);
+        outPtr += this->OutInc[0];
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+template <class OT>
+bool vtkICF::ParallelExecute(
+  vtkImageConnectivityFilter *self,
+  vtkImageData *outData, vtkDataSet *seedData,
+  OT *outPtr, unsigned char *maskPtr, int extent[6])
+{
+  int dims[3];
+  dims[0] = extent[1] - extent[0] + 1;
+  dims[1] = extent[3] - extent[2] + 1;
+  dims[2] = extent[5] - extent[4] + 1;
+
+  // for 2D images, use slabs of rows instead of slabs of slices (this
+  // does not change the index of the voxels)
+  vtkICFLabeling labeling;
+  labeling.Mask = maskPtr;
+  labeling.Dims[0] = dims[0];
+  labeling.Dims[1] = (dims[2] == 1 ? 1 : dims[1]);
+  labeling.Dims[2] = (dims[2] == 1 ? dims[1] : dims[2]);
+
+  // the labels within a slab have 32 bits
+  vtkIdType sliceSize =
+    static_cast<vtkIdType>(labeling.Dims[0])*labeling.Dims[1];
+  if (sliceSize >= static_cast<vtkIdType>(VTK_UNSIGNED_INT_MAX))
+  {
+    return false;
+  }
+  int nslices = labeling.Dims[2];
+  int thickness = (nslices + 127)/128;
+  thickness = (thickness > 4 ? thickness : 4);
+  while (thickness > 1 &&
+         sliceSize*thickness >= static_cast<vtkIdType>(VTK_UNSIGNED_INT_MAX))
+  {
+    thickness /= 2;
+  }
+  for (int z = 0; z < nslices; z += thickness)
+  {
+    vtkICFSlab slab;
+    slab.Begin = z;
+    slab.End = (z + thickness < nslices ? z + thickness : nslices);
+    labeling.Slabs.push_back(slab);
+  }
+
+  // the neighbors that come before each voxel in raster order, for slabs
+  // of rows the Y offset of the neighbor becomes its Z offset
+  bool slabsOfRows = (labeling.Dims[1] != dims[1]);
+  int connectivity = self->GetConnectivity();
+  for (int dz = -1; dz <= 0; dz++)
+  {
+    for (int dy = -1; dy <= 1; dy++)
+    {
+      for (int dx = -1; dx <= 1; dx++)
+      {
+        int d = (dx != 0) + (dy != 0) + (dz != 0);
+        bool before = (dz < 0 || dy < 0 || (dy == 0 && dx < 0));
+        if (!before ||
+            (d > 1 &&
+             connectivity < vtkImageConnectivityFilter::EdgeConnectivity) ||
+            (d > 2 &&
+             connectivity < vtkImageConnectivityFilter::VertexConnectivity))
+        {
+          continue;
+        }
+        if (slabsOfRows && dz != 0)
+        {
+          continue;
+        }
+        labeling.Neighbors.push_back(dx);
+        labeling.Neighbors.push_back(slabsOfRows ? 0 : dy);
+        labeling.Neighbors.push_back(slabsOfRows ? dy : dz);
+      }
+    }
+  }
+
+  // label the slabs, and link them to each other
+  std::vector<vtkTypeUInt32> labels(static_cast<size_t>(sliceSize)*nslices);
+  labeling.Labels = labels.data();
+  vtkIdType nslabs = static_cast<vtkIdType>(labeling.Slabs.size());
+  vtkICFLabelSlabs labelSlabs = { &labeling };
+  vtkSMPTools::For(0, nslabs, 1, labelSlabs);
+  vtkICFLinkSlabs linkSlabs = { &labeling };
+  vtkSMPTools::For(0, nslabs, 1, linkSlabs);
+
+  // give each slab an offset, so that labels are unique across slabs
+  std::vector<vtkIdType> slabOffsets(nslabs + 1, 0);
+  for (vtkIdType s = 0; s < nslabs; s++)
+  {
+    slabOffsets[s + 1] = slabOffsets[s] +
+      static_cast<vtkIdType>(labeling.Slabs[s].Regions.size()) - 1;
+  }
+  vtkIdType nlabels = slabOffsets[nslabs];
+
+  // merge the labels that touch across the slabs, the root label is the
+  // smallest one, which is the one with the first voxel in raster order
+  std::vector<vtkIdType> parent(nlabels + 1);
+  for (vtkIdType l = 0; l <= nlabels; l++)
+  {
+    parent[l] = l;
+  }
+  for (vtkIdType s = 1; s < nslabs; s++)
+  {
+    const vtkICFSlab& slab = labeling.Slabs[s];
+    for (size_t k = 0; k < slab.Links.size(); k++)
+    {
+      vtkIdType a = slabOffsets[s] + slab.Links[k].first;
+      vtkIdType b = slabOffsets[s - 1] + slab.Links[k].second;
+      while (parent[a] != a) { a = parent[a] = parent[parent[a]]; }
+      while (parent[b] != b) { b = parent[b] = parent[parent[b]]; }
+      if (a < b)
+      {
+        parent[b] = a;
+      }
+      else if (b < a)
+      {
+        parent[a] = b;
+      }
+    }
+  }
+
+  // gather the statistics of the connected components, in the raster
+  // order of their first voxels
+  std::vector<vtkIdType> componentOfLabel(nlabels + 1, -1);
+  std::vector<vtkICFStatistics> components;
+  for (vtkIdType s = 0; s < nslabs; s++)
+  {
+    const vtkICFSlab& slab = labeling.Slabs[s];
+    for (size_t i = 1; i < slab.Regions.size(); i++)
+    {
+      const vtkICFStatistics& r = slab.Regions[i];
+      vtkIdType l = slabOffsets[s] + static_cast<vtkIdType>(i);
+      vtkIdType root = parent[l];
+      while (parent[root] != root) { root = parent[root]; }
+      if (root == l)
+      {
+        componentOfLabel[l] = static_cast<vtkIdType>(components.size());
+        components.push_back(r);
+        continue;
+      }
+      vtkIdType c = componentOfLabel[root];
+      componentOfLabel[l] = c;
+      vtkICFStatistics& t = components[c];
+      t.Size += r.Size;
+      for (int k = 0; k < 6; k += 2)
+      {
+        t.Extent[k] = (r.Extent[k] < t.Extent[k] ? r.Extent[k] : t.Extent[k]);
+        t.Extent[k+1] =
+          (r.Extent[k+1] > t.Extent[k+1] ? r.Extent[k+1] : t.Extent[k+1]);
+      }
+    }
+  }
+  if (slabsOfRows)
+  {
+    // back from slabs of rows to slabs of slices
+    for (size_t c = 0; c < components.size(); c++)
+    {
+      int *e = components[c].Extent;
+      e[2] = e[4];
+      e[3] = e[5];
+      e[4] = e[5] = 0;
+    }
+  }
+
+  // build the list of regions like the seeded and the seedless fills do
+  int extractionMode = self->GetExtractionMode();
+  bool generateExtents = (self->GetGenerateRegionExtents() != 0);
+  vtkIdType sizeRange[2];
+  self->GetSizeRange(sizeRange);
+  int maxLabel = vtkTypeTraits<OT>::Max();
+
+  vtkICF::RegionVector regionInfo;
+  regionInfo.push_back(vtkICF::Region(0, 0, extent));
+  std::vector<vtkIdType> members(1, -1);
+  std::vector<char> used(components.size(), 0);
+  int regionExtent[6];
+
+  vtkDataArray *seedScalars = nullptr;
+  if (seedData)
+  {
+    seedScalars = seedData->GetPointData()->GetScalars();
+    double spacing[3];
+    double origin[3];
+    outData->GetOrigin(origin);
+    outData->GetSpacing(spacing);
+
+    vtkIdType nPoints = seedData->GetNumberOfPoints();
+    for (vtkIdType i = 0; i < nPoints; i++)
+    {
+      if (seedScalars && seedScalars->GetComponent(i, 0) == 0)
+      {
+        continue;
+      }
+
+      double point[3];
+      seedData->GetPoint(i, point);
+      int idx[3];
+      bool outOfBounds = false;
+
+      // convert point from data coords to image index
+      for (int j = 0; j < 3; j++)
+      {
+        idx[j] = vtkMath::Floor((point[j] - origin[j])/spacing[j] + 0.5);
+        idx[j] -= extent[2*j];
+        outOfBounds |= (idx[j] < 0 || idx[j] >= dims[j]);
+      }
+
+      vtkIdType voxel = idx[0] + static_cast<vtkIdType>(dims[0])*(
+        idx[1] + static_cast<vtkIdType>(dims[1])*idx[2]);
+      if (outOfBounds || labels[voxel] == 0)
+      {
+        continue;
+      }
+      vtkIdType s = (voxel/sliceSize)/thickness;
+      vtkIdType c = componentOfLabel[slabOffsets[s] + labels[voxel]];
+      if (used[c])
+      {
+        continue;
+      }
+      used[c] = 1;
+
+      const vtkICFStatistics& r = components[c];
+      for (int k = 0; k < 6; k++)
+      {
+        regionExtent[k] = (generateExtents ? r.Extent[k] : idx[k/2]);
+      }
+      vtkICF::AddRegionToList(
+        sizeRange, regionInfo, members, c, maxLabel,
+        r.Size, i, regionExtent, extractionMode);
+    }
+  }
+
+  if (!seedData ||
+      extractionMode == vtkImageConnectivityFilter::AllRegions)
+  {
+    for (size_t c = 0; c < components.size(); c++)
+    {
+      const vtkICFStatistics& r = components[c];
+      if (used[c] ||
+          (r.Size == 1 && regionInfo.size() == static_cast<size_t>(maxLabel)))
+      {
+        continue;
+      }
+      vtkIdType first = r.First;
+      for (int k = 0; k < 3; k++)
+      {
+        int j = static_cast<int>(first % dims[k]);
+        first /= dims[k];
+        regionExtent[2*k] = (generateExtents ? r.Extent[2*k] : j);
+        regionExtent[2*k+1] = (generateExtents ? r.Extent[2*k+1] : j);
+      }
+      vtkICF::AddRegionToList(
+        sizeRange, regionInfo, members, static_cast<vtkIdType>(c), maxLabel,
+        r.Size, -1, regionExtent, extractionMode);
+    }
+  }
+
+  // do the same bookkeeping as Finish(), but compute the label of each
+  // component instead of relabeling the output
+  std::vector<vtkIdType> newlabels;
+  vtkICF::SelectBySize(sizeRange, regionInfo, newlabels);
+  for (size_t i = 1; i < newlabels.size(); i++)
+  {
+    if (newlabels[i] != 0)
+    {
+      members[newlabels[i]] = members[i];
+    }
+  }
+  members.resize(regionInfo.size());
+
+  vtkICF::GenerateRegionArrays(
+    self, regionInfo, seedScalars, extent,
+    vtkTypeTraits<OT>::Min(), vtkTypeTraits<OT>::Max());
+
+  std::vector<OT> componentValues(components.size(), 0);
+  vtkIdTypeArray *labelArray = self->GetExtractedRegionLabels();
+  if (labelArray->GetNumberOfTuples() > 0)
+  {
+    int labelMode = self->GetLabelMode();
+    if (extractionMode == vtkImageConnectivityFilter::LargestRegion)
+    {
+      size_t t = std::distance(regionInfo.begin(), regionInfo.largest());
+      componentValues[members[t]] = static_cast<OT>(labelArray->GetValue(0));
+    }
+    else
+    {
+      bool relabel = (labelMode != vtkImageConnectivityFilter::SeedScalar ||
+                      seedScalars != nullptr);
+      for (size_t i = 1; i < members.size(); i++)
+      {
+        componentValues[members[i]] = static_cast<OT>(
+          relabel ? labelArray->GetValue(i - 1) : static_cast<vtkIdType>(i));
+      }
+    }
+
+    // sort the three region info arrays
+    vtkICF::SortRegionArrays(self);
+  }
+
+  // the output value for each label of each slab
+  std::vector<OT> values(nlabels + 1, 0);
+  for (vtkIdType l = 1; l <= nlabels; l++)
+  {
+    values[l] = componentValues[componentOfLabel[l]];
+  }
+  std::vector<vtkIdType> sliceOffsets(nslices);
+  for (int z = 0; z < nslices; z++)
+  {
+    sliceOffsets[z] = slabOffsets[z/thickness];
+  }
+
+  // write the part of the output that is within the labeled extent
+  int outExt[6];
+  outData->GetExtent(outExt);
+  int writeExt[6];
+  if (vtkICF::IntersectExtents(outExt, extent, writeExt))
+  {
+    vtkICFWriteLabels<OT> write;
+    write.Labels = labels.data();
+    write.Values = values.data();
+    write.SliceOffsets = sliceOffsets.data();
+    write.SliceSize = sliceSize;
+    outData->GetIncrements(write.OutInc);
+    write.OutPtr = outPtr +
+      (writeExt[0] - outExt[0])*write.OutInc[0] +
+      (writeExt[2] - outExt[2])*write.OutInc[1] +
+      (writeExt[4] - outExt[4])*write.OutInc[2];
+    for (int k = 0; k < 3; k++)
+    {
+      write.Dims[k] = dims[k];
+      write.Extent[2*k] = writeExt[2*k] - extent[2*k];
+      write.Extent[2*k+1] = writeExt[2*k+1] - extent[2*k];
+    }
+    vtkIdType rows =
+      static_cast<vtkIdType>(writeExt[3] - writeExt[2] + 1)*
+      (writeExt[5] - writeExt[4] + 1);
+    vtkSMPTools::For(0, rows, write);
+  }
+
+  return true;
+}
+
 //----------------------------------------------------------------------------
 // This templated function executes the filter for any type of data.
 template <class OT>
@@ -1350,6 +2098,13 @@ void vtkICF::ExecuteOutput(
   vtkImageData *outData, vtkDataSet *seedData, vtkImageStencilData *stencil,
   OT *outPtr, unsigned char *maskPtr, int extent[6])
 {
+  // the parallel labeling does the work of all of the methods below
+  if (self->GetParallelLabeling() &&
+      vtkICF::ParallelExecute(self, outData, seedData, outPtr, maskPtr, extent))
+  {
+    return;
+  }
+
   // push the "background" onto the region vector
   vtkICF::RegionVector regionInfo;
   regionInfo.push_back(vtkICF::Region(0, 0, extent));
@@ -1583,6 +2338,12 @@ void vtkImageConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "GenerateRegionExtents: "
      << (this->GenerateRegionExtents ? "On\n" : "Off\n");
 
+  os << indent << "Connectivity: "
+     << this->Connectivity << "\n";
+
+  os << indent << "ParallelLabeling: "
+     << (this->ParallelLabeling ? "On\n" : "Off\n");
+
   os << indent << "SeedConnection: "
      << this->GetSeedConnection() << "\n";
 
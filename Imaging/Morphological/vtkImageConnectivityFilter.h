@@ -54,8 +54,9 @@
  * within the prescribed scalar range are considered to be connected
  * if a path exists between the points that does not traverse any
  * points that are not within the prescribed scalar range.
- * Adjacency of points is governed by 4-connectivity for 2D images, and
- * 6-connectivity for 3D images.
+ * Adjacency of points is governed by 6-connectivity by default, i.e.
+ * 4-connectivity for 2D images, but 18-connectivity or 26-connectivity
+ * (8-connectivity for 2D images) can be chosen with SetConnectivity().
  *
  * The output of this filter is a label image.  By default, each region
  * is assigned a different label, where the labels are integer values
@@ -86,6 +87,12 @@
  * is called.  These extents can be useful for cropping the output
  * of the filter.
  *
+ * Large images can be labeled in parallel with ParallelLabelingOn().
+ * The image is then cut into slabs that are labeled concurrently with
+ * a union-find, the regions that touch across slabs are merged, and
+ * the final labels are written in parallel.  The output is identical
+ * to the output of the serial flood fill.
+ *
  * @sa
  * vtkConnectivityFilter, vtkPolyDataConnectivityFilter
 */
@@ -119,6 +126,15 @@ public:
     SizeRank = 2
   };
 
+  /**
+   * Enum constants for SetConnectivity().
+   */
+  enum ConnectivityEnum {
+    FaceConnectivity = 6,
+    EdgeConnectivity = 18,
+    VertexConnectivity = 26
+  };
+
   /**
    * Enum constants for SetExtractionMode().
    */
@@ -293,6 +309,33 @@ public:
   vtkGetMacro(ActiveComponent, int);
   //@}
 
+  //@{
+  /**
+   * Set the connectivity of the voxels: 6 connects the voxels that share
+   * a face, 18 those that share a face or an edge, and 26 those that
+   * share a face, an edge or a vertex.  For 2D images, 6 gives
+   * 4-connectivity and both 18 and 26 give 8-connectivity.
+   * Other values are rounded down to 6, 18 or 26, and values outside
+   * of that range are clamped.  The default is 6.
+   */
+  void SetConnectivityTo6() { this->SetConnectivity(FaceConnectivity); }
+  void SetConnectivityTo18() { this->SetConnectivity(EdgeConnectivity); }
+  void SetConnectivityTo26() { this->SetConnectivity(VertexConnectivity); }
+  void SetConnectivity(int connectivity);
+  vtkGetMacro(Connectivity, int);
+  //@}
+
+  //@{
+  /**
+   * Label the regions in parallel.  This needs a temporary label image
+   * of four bytes per input voxel, but is much faster for large images
+   * on multi-core machines.  The default is Off.
+   */
+  vtkSetMacro(ParallelLabeling, vtkTypeBool);
+  vtkBooleanMacro(ParallelLabeling, vtkTypeBool);
+  vtkGetMacro(ParallelLabeling, vtkTypeBool);
+  //@}
+
 protected:
   vtkImageConnectivityFilter();
   ~vtkImageConnectivityFilter() override;
@@ -306,6 +349,8 @@ protected:
   int ActiveComponent;
   int LabelScalarType;
   vtkTypeBool GenerateRegionExtents;
+  int Connectivity;
+  vtkTypeBool ParallelLabeling;
 
   vtkIdTypeArray *ExtractedRegionLabels;
   vtkIdTypeArray *ExtractedRegionSizes;
@@ -19,6 +19,9 @@
  * vtkImageContinuousDilate3D replaces a pixel with the maximum over
  * an ellipsoidal neighborhood.  If KernelSize of an axis is 1, no processing
  * is done on that axis.
+ *
+ * @sa
+ * vtkImageMorphology3D
 */
 
 #ifndef vtkImageContinuousDilate3D_h
@@ -19,6 +19,9 @@
  * vtkImageContinuousErode3D replaces a pixel with the minimum over
  * an ellipsoidal neighborhood.  If KernelSize of an axis is 1, no processing
  * is done on that axis.
+ *
+ * @sa
+ * vtkImageMorphology3D
 */
 
 #ifndef vtkImageContinuousErode3D_h
@@ -0,0 +1,700 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageMorphology3D.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageMorphology3D.h"
+
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+vtkStandardNewMacro(vtkImageMorphology3D);
+
+namespace
+{
+
+// A line segment of the kernel: the maximum or the minimum is taken over
+// the voxels at x + s*Direction, for s from -Before to After.
+struct vtkImageMorphology3DSegment
+{
+  int Direction[3];
+  int Before;
+  int After;
+  bool Maximum;
+};
+
+void vtkImageMorphology3DAddSegment(std::vector<vtkImageMorphology3DSegment>& segments,
+  int d0, int d1, int d2, int before, int after, bool maximum)
+{
+  if (before + after > 0)
+  {
+    vtkImageMorphology3DSegment segment = { { d0, d1, d2 }, before, after, maximum };
+    segments.push_back(segment);
+  }
+}
+
+// Decompose the kernel of one step of the operation into segments. The
+// box needs the three axes. For the ball, segments along the face
+// diagonals of half-length b and, in 3D, along the body diagonals of
+// half-length c are added, and the axis segments are shortened so that the
+// size along the axes stays exact. Then b and c are chosen so that the
+// support of the polyhedron is as close as possible to the radius of the
+// ellipsoid of vtkImageContinuousDilate3D in a set of directions. The face
+// diagonals only reach every other voxel, so they need either the axis
+// segments or the body diagonals.
+void vtkImageMorphology3DAddStep(std::vector<vtkImageMorphology3DSegment>& segments,
+  const int kernelSize[3], int shape, bool maximum, bool reflect)
+{
+  int before[3];
+  int after[3];
+  int active[3];
+  int numberOfActive = 0;
+  int radius = VTK_INT_MAX;
+  for (int i = 0; i < 3; ++i)
+  {
+    int size = std::max(kernelSize[i], 1);
+    before[i] = size / 2;
+    after[i] = size - 1 - size / 2;
+    if (reflect)
+    {
+      std::swap(before[i], after[i]);
+    }
+    if (size > 1)
+    {
+      active[numberOfActive++] = i;
+      radius = std::min(radius, (size - 1) / 2);
+    }
+  }
+
+  // the face diagonals within the active axes, and the body diagonals
+  std::vector<std::array<int, 3> > faces;
+  std::vector<std::array<int, 3> > bodies;
+  for (int k = 0; k < numberOfActive; ++k)
+  {
+    for (int l = k + 1; l < numberOfActive; ++l)
+    {
+      for (int sign = 1; sign >= -1; sign -= 2)
+      {
+        std::array<int, 3> d = { { 0, 0, 0 } };
+        d[active[k]] = 1;
+        d[active[l]] = sign;
+        faces.push_back(d);
+      }
+    }
+  }
+  if (numberOfActive == 3)
+  {
+    for (int j = 1; j >= -1; j -= 2)
+    {
+      for (int k = 1; k >= -1; k -= 2)
+      {
+        std::array<int, 3> d = { { 1, j, k } };
+        bodies.push_back(d);
+      }
+    }
+  }
+
+  int b = 0;
+  int c = 0;
+  if (shape == vtkImageMorphology3D::Ball && numberOfActive >= 2)
+  {
+    // each face diagonal adds one to the size along two of the axes, and
+    // each body diagonal adds one along all three
+    const int faceReach = static_cast<int>(faces.size()) * 2 / numberOfActive;
+    const int bodyReach = static_cast<int>(bodies.size());
+    double bestError = VTK_DOUBLE_MAX;
+    for (int tc = 0; tc == 0 || (bodyReach > 0 && bodyReach * tc <= radius); ++tc)
+    {
+      for (int tb = 0; faceReach * tb + bodyReach * tc <= radius; ++tb)
+      {
+        int a = radius - faceReach * tb - bodyReach * tc;
+        if (a == 0 && tc == 0)
+        {
+          continue;
+        }
+        // the support along the directions with components from 0 to 3
+        // along the active axes
+        double error = 0.0;
+        for (int n = 1; n < (1 << (2 * numberOfActive)); ++n)
+        {
+          int u[3] = { 0, 0, 0 };
+          double support = 0.0;
+          for (int k = 0; k < numberOfActive; ++k)
+          {
+            u[active[k]] = (n >> (2 * k)) & 3;
+            support += a * u[active[k]];
+          }
+          for (const std::array<int, 3>& d : faces)
+          {
+            support += tb * std::abs(u[0] * d[0] + u[1] * d[1] + u[2] * d[2]);
+          }
+          for (const std::array<int, 3>& d : bodies)
+          {
+            support += tc * std::abs(u[0] * d[0] + u[1] * d[1] + u[2] * d[2]);
+          }
+          support /= std::sqrt(static_cast<double>(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]));
+          error = std::max(error, std::fabs(support - (radius + 0.5)));
+        }
+        if (error < bestError)
+        {
+          bestError = error;
+          b = tb;
+          c = tc;
+        }
+      }
+    }
+  }
+
+  int reach = static_cast<int>(faces.size()) * 2 / std::max(numberOfActive, 1) * b +
+    static_cast<int>(bodies.size()) * c;
+  for (int i = 0; i < 3; ++i)
+  {
+    int d[3] = { 0, 0, 0 };
+    d[i] = 1;
+    if (kernelSize[i] > 1)
+    {
+      vtkImageMorphology3DAddSegment(
+        segments, d[0], d[1], d[2], before[i] - reach, after[i] - reach, maximum);
+    }
+  }
+  for (int k = 0; b > 0 && k < static_cast<int>(faces.size()); ++k)
+  {
+    vtkImageMorphology3DAddSegment(segments, faces[k][0], faces[k][1], faces[k][2], b, b, maximum);
+  }
+  for (int k = 0; c > 0 && k < static_cast<int>(bodies.size()); ++k)
+  {
+    vtkImageMorphology3DAddSegment(
+      segments, bodies[k][0], bodies[k][1], bodies[k][2], c, c, maximum);
+  }
+}
+
+void vtkImageMorphology3DGetSegments(
+  vtkImageMorphology3D* self, std::vector<vtkImageMorphology3DSegment>& segments)
+{
+  const int* kernelSize = self->GetKernelSize();
+  int shape = self->GetKernelShape();
+  switch (self->GetOperation())
+  {
+    case vtkImageMorphology3D::Dilate:
+      vtkImageMorphology3DAddStep(segments, kernelSize, shape, true, false);
+      break;
+    case vtkImageMorphology3D::Erode:
+      vtkImageMorphology3DAddStep(segments, kernelSize, shape, false, false);
+      break;
+    case vtkImageMorphology3D::Open:
+      vtkImageMorphology3DAddStep(segments, kernelSize, shape, false, false);
+      vtkImageMorphology3DAddStep(segments, kernelSize, shape, true, true);
+      break;
+    case vtkImageMorphology3D::Close:
+      vtkImageMorphology3DAddStep(segments, kernelSize, shape, true, false);
+      vtkImageMorphology3DAddStep(segments, kernelSize, shape, false, true);
+      break;
+  }
+}
+
+// The value that does not change the maximum or the minimum.
+template <class T>
+T vtkImageMorphology3DIdentity(bool maximum)
+{
+  if (std::numeric_limits<T>::has_infinity)
+  {
+    return (maximum ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity());
+  }
+  return (maximum ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max());
+}
+
+struct vtkImageMorphology3DMaximum
+{
+  template <class T>
+  static T Apply(T a, T b)
+  {
+    return (a < b ? b : a);
+  }
+};
+
+struct vtkImageMorphology3DMinimum
+{
+  template <class T>
+  static T Apply(T a, T b)
+  {
+    return (b < a ? b : a);
+  }
+};
+
+// The van Herk/Gil-Werman algorithm. The padded line w, of length m, is
+// split into blocks of k samples. Within each block, g holds the running
+// maximum from the start of the block and h the running maximum from the
+// end of the block, so that the maximum over any k consecutive samples,
+// which span at most two blocks, is that of one value from each array.
+template <class Op, class T>
+void vtkImageMorphology3DVanHerk(const T* w, int m, int k, T* g, T* h, T* out, vtkIdType stride)
+{
+  for (int start = 0; start < m; start += k)
+  {
+    int end = std::min(start + k, m) - 1;
+    g[start] = w[start];
+    for (int i = start + 1; i <= end; ++i)
+    {
+      g[i] = Op::Apply(g[i - 1], w[i]);
+    }
+    h[end] = w[end];
+    for (int i = end - 1; i >= start; --i)
+    {
+      h[i] = Op::Apply(h[i + 1], w[i]);
+    }
+  }
+  for (int x = 0; x + k <= m; ++x)
+  {
+    out[x * stride] = Op::Apply(h[x], g[x + k - 1]);
+  }
+}
+
+// Computes the maximum or the minimum over one segment for all the lines
+// along its direction. Each line is identified by its first voxel.
+template <class T>
+struct vtkImageMorphology3DLines
+{
+  T* Data;
+  int Dims[3];
+  vtkIdType Increments[3];
+  int NumberOfComponents;
+  vtkImageMorphology3DSegment Segment;
+  const int* Starts;
+  // For inputs with at most two values.
+  bool Binary;
+  T Low;
+  T High;
+  // The padded line, and the two arrays of the van Herk/Gil-Werman algorithm.
+  vtkSMPThreadLocal<std::vector<T> > Buffers;
+
+  void Initialize()
+  {
+    int n = std::max(std::max(this->Dims[0], this->Dims[1]), this->Dims[2]);
+    this->Buffers.Local().resize(3 * (n + this->Segment.Before + this->Segment.After));
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const int* d = this->Segment.Direction;
+    const int before = this->Segment.Before;
+    const int after = this->Segment.After;
+    const bool maximum = this->Segment.Maximum;
+    const vtkIdType step =
+      d[0] * this->Increments[0] + d[1] * this->Increments[1] + d[2] * this->Increments[2];
+    const T identity = vtkImageMorphology3DIdentity<T>(maximum);
+    std::vector<T>& buffer = this->Buffers.Local();
+    int size = static_cast<int>(buffer.size() / 3);
+    T* w = buffer.data();
+    T* g = w + size;
+    T* h = g + size;
+
+    for (vtkIdType line = begin; line < end; ++line)
+    {
+      const int* p = this->Starts + 3 * line;
+      int n = VTK_INT_MAX;
+      for (int i = 0; i < 3; ++i)
+      {
+        if (d[i] != 0)
+        {
+          n = std::min(n, (d[i] > 0 ? this->Dims[i] - p[i] : p[i] + 1));
+        }
+      }
+      T* first = this->Data + p[0] * this->Increments[0] + p[1] * this->Increments[1] +
+        p[2] * this->Increments[2];
+
+      for (int c = 0; c < this->NumberOfComponents; ++c)
+      {
+        T* out = first + c;
+        for (int i = 0; i < n; ++i)
+        {
+          w[before + i] = out[i * step];
+        }
+
+        if (this->Binary)
+        {
+          // Each run of the value that wins spreads over the voxels whose
+          // kernel overlaps it, and the other voxels are left untouched.
+          const T spread = (maximum ? this->High : this->Low);
+          const T* in = w + before;
+          int filled = 0;
+          int i = 0;
+          while (i < n)
+          {
+            if (in[i] != spread)
+            {
+              ++i;
+              continue;
+            }
+            int runStart = i;
+            while (i < n && in[i] == spread)
+            {
+              ++i;
+            }
+            for (int j = std::max(runStart - after, filled); j < runStart; ++j)
+            {
+              out[j * step] = spread;
+            }
+            filled = std::min(i + before, n);
+            for (int j = i; j < filled; ++j)
+            {
+              out[j * step] = spread;
+            }
+          }
+          continue;
+        }
+
+        // Pad with the identity, so that the kernel is clipped at the
+        // boundaries.
+        int m = n + before + after;
+        std::fill(w, w + before, identity);
+        std::fill(w + before + n, w + m, identity);
+        if (maximum)
+        {
+          vtkImageMorphology3DVanHerk<vtkImageMorphology3DMaximum>(
+            w, m, before + after + 1, g, h, out, step);
+        }
+        else
+        {
+          vtkImageMorphology3DVanHerk<vtkImageMorphology3DMinimum>(
+            w, m, before + after + 1, g, h, out, step);
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Find the first voxel of every line along a direction: the voxels whose
+// predecessor along the line is outside of the image. Each one is on the
+// face of the image where the lines enter along one of the axes.
+void vtkImageMorphology3DGetStarts(const int dims[3], const int d[3], std::vector<int>& starts)
+{
+  starts.clear();
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (d[axis] == 0)
+    {
+      continue;
+    }
+    // the two other axes, which span the face
+    int u = (axis + 1) % 3;
+    int v = (axis + 2) % 3;
+    int p[3];
+    p[axis] = (d[axis] > 0 ? 0 : dims[axis] - 1);
+    for (p[v] = 0; p[v] < dims[v]; ++p[v])
+    {
+      for (p[u] = 0; p[u] < dims[u]; ++p[u])
+      {
+        // skip the voxels on the faces of the previous axes
+        bool duplicate = false;
+        for (int i = 0; i < axis; ++i)
+        {
+          duplicate |= (d[i] != 0 && p[i] == (d[i] > 0 ? 0 : dims[i] - 1));
+        }
+        if (!duplicate)
+        {
+          starts.push_back(p[0]);
+          starts.push_back(p[1]);
+          starts.push_back(p[2]);
+        }
+      }
+    }
+  }
+}
+
+// Set the voxels of the padding around the image.
+template <class T>
+void vtkImageMorphology3DFillPadding(
+  T* work, const int dims[3], const int pad[3], int numComp, T value)
+{
+  const vtkIdType rowSize = static_cast<vtkIdType>(dims[0]) * numComp;
+  for (int k = 0; k < dims[2]; ++k)
+  {
+    for (int j = 0; j < dims[1]; ++j)
+    {
+      T* row = work + (static_cast<vtkIdType>(k) * dims[1] + j) * rowSize;
+      if (k < pad[2] || k >= dims[2] - pad[2] || j < pad[1] || j >= dims[1] - pad[1])
+      {
+        std::fill(row, row + rowSize, value);
+      }
+      else
+      {
+        std::fill(row, row + pad[0] * numComp, value);
+        std::fill(row + rowSize - pad[0] * numComp, row + rowSize, value);
+      }
+    }
+  }
+}
+
+template <class T>
+void vtkImageMorphology3DExecute(vtkImageMorphology3D* self, vtkImageData* inData,
+  const int inExt[6], T* inPtr, vtkImageData* outData, const int outExt[6], T* outPtr)
+{
+  std::vector<vtkImageMorphology3DSegment> segments;
+  vtkImageMorphology3DGetSegments(self, segments);
+
+  // A kernel decomposed along the diagonals reaches voxels through voxels
+  // that are outside of the image, so the image is padded by the reach of
+  // each step of the operation.
+  int pad[3] = { 0, 0, 0 };
+  int reach[3] = { 0, 0, 0 };
+  bool diagonal = false;
+  for (size_t s = 0; s < segments.size(); ++s)
+  {
+    const vtkImageMorphology3DSegment& segment = segments[s];
+    if (s > 0 && segment.Maximum != segments[s - 1].Maximum)
+    {
+      std::fill(reach, reach + 3, 0);
+    }
+    int nonzero = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+      reach[i] += std::abs(segment.Direction[i]) * std::max(segment.Before, segment.After);
+      pad[i] = std::max(pad[i], reach[i]);
+      nonzero += (segment.Direction[i] != 0);
+    }
+    diagonal |= (nonzero > 1);
+  }
+  if (!diagonal)
+  {
+    std::fill(pad, pad + 3, 0);
+  }
+
+  const int numComp = inData->GetNumberOfScalarComponents();
+  int dims[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    dims[i] = inExt[2 * i + 1] - inExt[2 * i] + 1 + 2 * pad[i];
+  }
+  const vtkIdType increments[3] = { numComp, static_cast<vtkIdType>(numComp) * dims[0],
+    static_cast<vtkIdType>(numComp) * dims[0] * dims[1] };
+
+  // Copy the input, it is filtered in place.
+  vtkIdType inIncrements[3];
+  inData->GetIncrements(inIncrements);
+  std::vector<T> work(increments[2] * dims[2]);
+  T* origin =
+    work.data() + pad[0] * increments[0] + pad[1] * increments[1] + pad[2] * increments[2];
+  const vtkIdType inRowSize = static_cast<vtkIdType>(inExt[1] - inExt[0] + 1) * numComp;
+  for (int k = 0; k <= inExt[5] - inExt[4]; ++k)
+  {
+    for (int j = 0; j <= inExt[3] - inExt[2]; ++j)
+    {
+      const T* in = inPtr + j * inIncrements[1] + k * inIncrements[2];
+      std::copy(in, in + inRowSize, origin + j * increments[1] + k * increments[2]);
+    }
+  }
+
+  // Look for a binary image: there is nothing to do for a constant image.
+  bool binary = true;
+  T low = *inPtr;
+  T high = *inPtr;
+  for (int k = 0; k <= inExt[5] - inExt[4] && binary; ++k)
+  {
+    for (int j = 0; j <= inExt[3] - inExt[2] && binary; ++j)
+    {
+      const T* in = origin + j * increments[1] + k * increments[2];
+      for (vtkIdType i = 0; i < inRowSize; ++i)
+      {
+        if (in[i] != low && in[i] != high)
+        {
+          if (low != high)
+          {
+            binary = false;
+            break;
+          }
+          low = std::min(low, in[i]);
+          high = std::max(high, in[i]);
+        }
+      }
+    }
+  }
+
+  std::vector<int> starts;
+  for (size_t s = 0; s < segments.size() && low != high && !self->GetAbortExecute(); ++s)
+  {
+    if (diagonal && (s == 0 || segments[s].Maximum != segments[s - 1].Maximum))
+    {
+      vtkImageMorphology3DFillPadding(work.data(), dims, pad, numComp,
+        vtkImageMorphology3DIdentity<T>(segments[s].Maximum));
+    }
+    vtkImageMorphology3DGetStarts(dims, segments[s].Direction, starts);
+    vtkImageMorphology3DLines<T> lines;
+    lines.Data = work.data();
+    std::copy(dims, dims + 3, lines.Dims);
+    std::copy(increments, increments + 3, lines.Increments);
+    lines.NumberOfComponents = numComp;
+    lines.Segment = segments[s];
+    lines.Starts = starts.data();
+    lines.Binary = binary;
+    lines.Low = low;
+    lines.High = high;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(starts.size() / 3), lines);
+    self->UpdateProgress((s + 1.0) / segments.size());
+  }
+
+  // Copy the requested extent to the output.
+  vtkIdType outIncrements[3];
+  outData->GetIncrements(outIncrements);
+  const vtkIdType rowSize = static_cast<vtkIdType>(outExt[1] - outExt[0] + 1) * numComp;
+  for (int k = outExt[4]; k <= outExt[5]; ++k)
+  {
+    for (int j = outExt[2]; j <= outExt[3]; ++j)
+    {
+      const T* in = origin + (outExt[0] - inExt[0]) * increments[0] +
+        (j - inExt[2]) * increments[1] + (k - inExt[4]) * increments[2];
+      std::copy(in, in + rowSize,
+        outPtr + (j - outExt[2]) * outIncrements[1] + (k - outExt[4]) * outIncrements[2]);
+    }
+  }
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkImageMorphology3D::vtkImageMorphology3D()
+{
+  this->Operation = Dilate;
+  this->KernelShape = Box;
+  this->KernelSize[0] = 3;
+  this->KernelSize[1] = 3;
+  this->KernelSize[2] = 3;
+}
+
+//----------------------------------------------------------------------------
+vtkImageMorphology3D::~vtkImageMorphology3D() = default;
+
+//----------------------------------------------------------------------------
+const char* vtkImageMorphology3D::GetOperationAsString()
+{
+  switch (this->Operation)
+  {
+    case Dilate:
+      return "Dilate";
+    case Erode:
+      return "Erode";
+    case Open:
+      return "Open";
+    case Close:
+      return "Close";
+  }
+  return "Unknown";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkImageMorphology3D::GetKernelShapeAsString()
+{
+  return (this->KernelShape == Ball ? "Ball" : "Box");
+}
+
+//----------------------------------------------------------------------------
+// The input extent is grown by the reach of every segment.
+int vtkImageMorphology3D::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  int inExt[6];
+  int wholeExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+
+  std::vector<vtkImageMorphology3DSegment> segments;
+  vtkImageMorphology3DGetSegments(this, segments);
+  for (const vtkImageMorphology3DSegment& segment : segments)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      int d = segment.Direction[i];
+      inExt[2 * i] -= (d > 0 ? segment.Before * d : -segment.After * d);
+      inExt[2 * i + 1] += (d > 0 ? segment.After * d : -segment.Before * d);
+    }
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    inExt[2 * i] = std::max(inExt[2 * i], wholeExt[2 * i]);
+    inExt[2 * i + 1] = std::min(inExt[2 * i + 1], wholeExt[2 * i + 1]);
+  }
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt, 6);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageMorphology3D::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* inData = vtkImageData::GetData(inInfo);
+  vtkImageData* outData = vtkImageData::GetData(outInfo);
+
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  this->AllocateOutputData(outData, outInfo, outExt);
+  if (outData->GetNumberOfPoints() == 0)
+  {
+    return 1;
+  }
+
+  int inExt[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
+  void* inPtr = inData->GetScalarPointerForExtent(inExt);
+  if (!inPtr || inData->GetNumberOfScalarComponents() < 1)
+  {
+    vtkErrorMacro("No input scalars to filter.");
+    return 0;
+  }
+  if (inData->GetScalarType() != outData->GetScalarType())
+  {
+    vtkErrorMacro("Execute: input ScalarType, " << inData->GetScalarType()
+                                                << ", must match out ScalarType "
+                                                << outData->GetScalarType());
+    return 0;
+  }
+
+  this->UpdateProgress(0.0);
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkImageMorphology3DExecute(this, inData, inExt,
+      static_cast<VTK_TT*>(inPtr), outData, outExt,
+      static_cast<VTK_TT*>(outData->GetScalarPointerForExtent(outExt))));
+    default:
+      vtkErrorMacro("Execute: Unknown ScalarType");
+      return 0;
+  }
+  this->UpdateProgress(1.0);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageMorphology3D::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Operation: " << this->GetOperationAsString() << "\n";
+  os << indent << "KernelShape: " << this->GetKernelShapeAsString() << "\n";
+  os << indent << "KernelSize: (" << this->KernelSize[0] << ", " << this->KernelSize[1] << ", "
+     << this->KernelSize[2] << ")\n";
+}
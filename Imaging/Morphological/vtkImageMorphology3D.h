@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageMorphology3D.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageMorphology3D
+ * @brief   Dilation, erosion, opening and closing with large kernels.
+ *
+ * vtkImageMorphology3D computes the grayscale dilation (maximum), erosion
+ * (minimum), opening or closing of an image with a box or a ball shaped
+ * kernel. Unlike vtkImageContinuousDilate3D and vtkImageContinuousErode3D,
+ * which visit every voxel of the kernel, the kernel is decomposed into line
+ * segments, and the maximum or the minimum along each segment is computed
+ * with the algorithm of van Herk and Gil-Werman, whose cost per voxel does
+ * not depend on the length of the segment. This makes large kernels, for
+ * instance to open or close segmentation masks, as fast as small ones.
+ *
+ * A box is decomposed into segments along the axes. A ball is approximated
+ * by adding segments along the diagonals, which gives a polyhedron in 3D,
+ * or an octagon when one of the kernel sizes is 1. The size of the
+ * polyhedron along each axis is always exact, and its size in the other
+ * directions is as close as possible to that of the ball. The approximation
+ * is coarse for kernel sizes below about 11 voxels, and improves as the
+ * kernel grows. When the kernel sizes are not equal, the diagonal segments
+ * are sized for the smallest kernel size, so that the kernel is a rounded
+ * box rather than an ellipsoid. While a ball is computed, the image is
+ * padded by the radius of the ball.
+ *
+ * When the input contains at most two distinct values, as for binary masks,
+ * the maximum or the minimum along each line is computed by extending the
+ * runs of the foreground or of the background instead. As for the other
+ * morphological filters, the kernel is clipped at the boundaries of the
+ * input, and each component is processed separately. The lines along each
+ * direction are processed in parallel.
+ *
+ * @sa
+ * vtkImageContinuousDilate3D vtkImageContinuousErode3D vtkImageOpenClose3D
+ */
+
+#ifndef vtkImageMorphology3D_h
+#define vtkImageMorphology3D_h
+
+#include "vtkImageAlgorithm.h"
+#include "vtkImagingMorphologicalModule.h" // For export macro
+
+class VTKIMAGINGMORPHOLOGICAL_EXPORT vtkImageMorphology3D : public vtkImageAlgorithm
+{
+public:
+  static vtkImageMorphology3D* New();
+  vtkTypeMacro(vtkImageMorphology3D, vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum OperationEnum
+  {
+    Dilate = 0,
+    Erode = 1,
+    Open = 2,
+    Close = 3
+  };
+
+  enum KernelShapeEnum
+  {
+    Box = 0,
+    Ball = 1
+  };
+
+  //@{
+  /**
+   * Set/Get the operation. An opening is an erosion followed by a dilation,
+   * and a closing is a dilation followed by an erosion. For even kernel
+   * sizes, the second step uses the reflected kernel. The default is Dilate.
+   */
+  vtkSetClampMacro(Operation, int, Dilate, Close);
+  void SetOperationToDilate() { this->SetOperation(Dilate); }
+  void SetOperationToErode() { this->SetOperation(Erode); }
+  void SetOperationToOpen() { this->SetOperation(Open); }
+  void SetOperationToClose() { this->SetOperation(Close); }
+  vtkGetMacro(Operation, int);
+  const char* GetOperationAsString();
+  //@}
+
+  //@{
+  /**
+   * Set/Get the shape of the kernel. The default is Box.
+   */
+  vtkSetClampMacro(KernelShape, int, Box, Ball);
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  void SetKernelShapeToBall() { this->SetKernelShape(Ball); }
+  vtkGetMacro(KernelShape, int);
+  const char* GetKernelShapeAsString();
+  //@}
+
+  //@{
+  /**
+   * Set/Get the size of the kernel in voxels along each axis, as for
+   * vtkImageContinuousDilate3D. A size of 1 leaves the axis untouched. For
+   * even sizes, the kernel extends one voxel further towards the lower
+   * indices. The default is 3 along each axis.
+   */
+  vtkSetVector3Macro(KernelSize, int);
+  vtkGetVector3Macro(KernelSize, int);
+  //@}
+
+protected:
+  vtkImageMorphology3D();
+  ~vtkImageMorphology3D() override;
+
+  int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  int Operation;
+  int KernelShape;
+  int KernelSize[3];
+
+private:
+  vtkImageMorphology3D(const vtkImageMorphology3D&) = delete;
+  void operator=(const vtkImageMorphology3D&) = delete;
+};
+
+#endif